@@ -0,0 +1,289 @@
+#include "BenchSupport.h"
+#include <chrono>
+#include <new>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// ALLOCATION COUNTING
+// =============================================================================
+
+// The benchmark is single threaded, so plain counters are enough
+static uint64_t allocationTotal = 0;
+static uint64_t allocationBytes = 0;
+
+static void* countedAllocate(size_t size) {
+    allocationTotal++;
+    allocationBytes += size;
+    void* block = malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void* operator new(size_t size) { return countedAllocate(size); }
+void* operator new[](size_t size) { return countedAllocate(size); }
+void operator delete(void* block) noexcept { free(block); }
+void operator delete[](void* block) noexcept { free(block); }
+void operator delete(void* block, size_t) noexcept { free(block); }
+void operator delete[](void* block, size_t) noexcept { free(block); }
+
+namespace bench {
+
+AllocationCount allocationCount() {
+    return {allocationTotal, allocationBytes};
+}
+
+uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// =============================================================================
+// NOISE
+// =============================================================================
+
+NoiseSource::NoiseSource(uint64_t seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+float NoiseSource::uniform() {
+    // xorshift64*
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (float)((state * 0x2545F4914F6CDD1Dull) >> 40) / (float)(1ull << 24);
+}
+
+float NoiseSource::gaussian() {
+    // Box-Muller, one value per call
+    float u1 = fmaxf(uniform(), 1e-7f);
+    float u2 = uniform();
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+// =============================================================================
+// CSV TRACES
+// =============================================================================
+
+// Splits line in place at commas; returns the number of fields
+static int splitFields(char* line, char** fields, int maxFields) {
+    int count = 0;
+    char* cursor = line;
+    while (count < maxFields) {
+        fields[count++] = cursor;
+        char* comma = strchr(cursor, ',');
+        if (!comma) break;
+        *comma = '\0';
+        cursor = comma + 1;
+    }
+    return count;
+}
+
+// Comments, blank lines and a header row don't start with a digit
+static bool isDataLine(const char* line) {
+    while (*line == ' ' || *line == '\t') line++;
+    return (*line >= '0' && *line <= '9') || *line == '-';
+}
+
+static void trimLineEnd(char* line) {
+    size_t length = strlen(line);
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+        line[--length] = '\0';
+    }
+}
+
+static std::string traceName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    std::string name = slash ? slash + 1 : path;
+    size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+bool loadPulseTrace(const char* path, PulseTrace& trace) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open pulse trace %s\n", path);
+        return false;
+    }
+
+    trace.name = traceName(path);
+    trace.samples.clear();
+    trace.hasReference = false;
+
+    char line[256];
+    char* fields[5];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        trimLineEnd(line);
+        if (!isDataLine(line)) continue;
+
+        int count = splitFields(line, fields, 5);
+        if (count < 3) {
+            fprintf(stderr, "%s:%d: expected timestamp_ms,red,ir\n", path, lineNumber);
+            fclose(file);
+            return false;
+        }
+
+        PulseSample sample = {};
+        sample.timestamp = (uint32_t)strtoul(fields[0], nullptr, 10);
+        sample.red = (uint32_t)strtoul(fields[1], nullptr, 10);
+        sample.ir = (uint32_t)strtoul(fields[2], nullptr, 10);
+        if (count >= 5) {
+            sample.referenceHeartRate = strtof(fields[3], nullptr);
+            sample.referenceSpO2 = strtof(fields[4], nullptr);
+            trace.hasReference = true;
+        }
+        trace.samples.push_back(sample);
+    }
+
+    fclose(file);
+    return !trace.samples.empty();
+}
+
+bool loadMovementTrace(const char* path, MovementTrace& trace) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open movement trace %s\n", path);
+        return false;
+    }
+
+    trace.name = traceName(path);
+    trace.movements.clear();
+
+    char line[256];
+    char* fields[10];
+    int lineNumber = 0;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        trimLineEnd(line);
+
+        // Rows start with the session id, so only the header is skipped by content
+        if (line[0] == '\0' || line[0] == '#' || strncmp(line, "session", 7) == 0) continue;
+
+        int count = splitFields(line, fields, 10);
+        if (count < 9) {
+            fprintf(stderr, "%s:%d: expected 9 or 10 fields\n", path, lineNumber);
+            fclose(file);
+            return false;
+        }
+
+        MovementAnalytics movement = {};
+        movement.sessionId.set(fields[0]);
+        movement.servoIndex = (uint8_t)atoi(fields[1]);
+        movement.startTime = strtoul(fields[2], nullptr, 10);
+        movement.duration = strtoul(fields[3], nullptr, 10);
+        movement.startAngle = (int16_t)atoi(fields[4]);
+        movement.targetAngle = (int16_t)atoi(fields[5]);
+        movement.actualAngle = (int16_t)atoi(fields[6]);
+        movement.successful = atoi(fields[7]) != 0;
+        movement.smoothness = strtof(fields[8], nullptr);
+        strncpy(movement.movementType, count >= 10 ? fields[9] : "individual",
+                sizeof(movement.movementType) - 1);
+        trace.movements.push_back(movement);
+    }
+
+    fclose(file);
+    return !trace.movements.empty();
+}
+
+// =============================================================================
+// SYNTHETIC TRACES
+// =============================================================================
+
+// Normalized pulse at beat phase 0..1: systolic upstroke and a smaller
+// reflected wave after the dicrotic notch
+static float pulseShape(float phase) {
+    float systolic = (phase - 0.25f) / 0.10f;
+    float diastolic = (phase - 0.55f) / 0.15f;
+    return expf(-systolic * systolic) + 0.5f * expf(-diastolic * diastolic);
+}
+
+// Inverse of PulseSignalProcessor's calibration curve
+static float ratioForSpO2(float spO2) {
+    return spO2 >= 85.0f ? (110.0f - spO2) / 25.0f : (100.0f - spO2) / 15.0f;
+}
+
+PulseTrace synthesizePulseTrace(const char* name, float heartRate, float spO2, uint32_t seconds,
+                                uint64_t seed) {
+    const uint32_t SAMPLE_INTERVAL_MS = 10;      // PULSE_SAMPLING_RATE_HZ
+    const float IR_DC = 120000.0f;               // Finger well placed
+    const float RED_DC = 90000.0f;
+    const float IR_PERFUSION = 0.02f;            // AC/DC of the IR channel
+    const float WANDER = 0.001f;                 // Respiration, same on both channels
+    const float RESPIRATION_HZ = 0.25f;
+    const float VARIABILITY_BPM = 2.0f;          // Slow heart rate variability
+    const float VARIABILITY_HZ = 0.1f;
+    const float NOISE_COUNTS = 20.0f;
+
+    PulseTrace trace;
+    trace.name = name;
+    trace.hasReference = true;
+
+    NoiseSource noise(seed);
+    float redPerfusion = IR_PERFUSION * ratioForSpO2(spO2);
+    float phase = 0.0f;
+    uint32_t sampleTotal = seconds * 1000 / SAMPLE_INTERVAL_MS;
+    trace.samples.reserve(sampleTotal);
+
+    for (uint32_t i = 0; i < sampleTotal; i++) {
+        float t = i * SAMPLE_INTERVAL_MS / 1000.0f;
+        float rate = heartRate + VARIABILITY_BPM * sinf(2.0f * (float)M_PI * VARIABILITY_HZ * t);
+        float pulse = pulseShape(phase);
+        float wander = 1.0f + WANDER * sinf(2.0f * (float)M_PI * RESPIRATION_HZ * t);
+
+        // Arterial blood absorbs more of both wavelengths at systole
+        PulseSample sample;
+        sample.timestamp = i * SAMPLE_INTERVAL_MS;
+        sample.ir = (uint32_t)lroundf(IR_DC * wander * (1.0f - IR_PERFUSION * pulse) + NOISE_COUNTS * noise.gaussian());
+        sample.red = (uint32_t)lroundf(RED_DC * wander * (1.0f - redPerfusion * pulse) + NOISE_COUNTS * noise.gaussian());
+        sample.referenceHeartRate = rate;
+        sample.referenceSpO2 = spO2;
+        trace.samples.push_back(sample);
+
+        phase += rate / 60.0f * SAMPLE_INTERVAL_MS / 1000.0f;
+        if (phase >= 1.0f) phase -= 1.0f;
+    }
+
+    return trace;
+}
+
+static const int SYNTHETIC_SERVO_COUNT = 3;  // ServoController::SERVO_COUNT
+
+MovementTrace synthesizeMovementTrace(const char* name, int sessions, int movementsPerSession,
+                                      float successProbability, float smoothnessMean,
+                                      float smoothnessSpread, uint64_t seed) {
+    MovementTrace trace;
+    trace.name = name;
+    trace.movements.reserve((size_t)sessions * movementsPerSession);
+
+    NoiseSource noise(seed);
+    unsigned long time = 0;
+
+    for (int s = 0; s < sessions; s++) {
+        char sessionId[ANALYTICS_SESSION_ID_SIZE];
+        snprintf(sessionId, sizeof(sessionId), "SES_BENCH_%03d", (s + 1) % 1000);
+
+        for (int m = 0; m < movementsPerSession; m++) {
+            MovementAnalytics movement = {};
+            movement.sessionId.set(sessionId);
+            movement.servoIndex = (uint8_t)(m % SYNTHETIC_SERVO_COUNT);
+            movement.startTime = time;
+            movement.duration = 400 + (unsigned long)(noise.uniform() * 2000.0f);
+            movement.startAngle = 0;
+            movement.targetAngle = (int16_t)(45 + (m % 4) * 30);
+            movement.successful = noise.uniform() < successProbability;
+            movement.actualAngle = movement.successful ? movement.targetAngle : (int16_t)(movement.targetAngle - 15);
+            float smoothness = smoothnessMean + smoothnessSpread * noise.gaussian();
+            movement.smoothness = smoothness < 0.0f ? 0.0f : (smoothness > 100.0f ? 100.0f : smoothness);
+            strncpy(movement.movementType, "individual", sizeof(movement.movementType) - 1);
+            trace.movements.push_back(movement);
+
+            time += movement.duration + 500;
+        }
+    }
+
+    return trace;
+}
+
+}  // namespace bench
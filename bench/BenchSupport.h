@@ -0,0 +1,81 @@
+#ifndef BENCH_SUPPORT_H
+#define BENCH_SUPPORT_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../src/analytics/SessionAnalyticsManager.h"
+
+// =============================================================================
+// MEASUREMENT
+// =============================================================================
+
+namespace bench {
+
+// Heap calls since the program started (global operator new/delete)
+struct AllocationCount {
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+AllocationCount allocationCount();
+
+// Monotonic host time
+uint64_t nowNs();
+
+// Deterministic noise, identical on every host and compiler
+class NoiseSource {
+public:
+    explicit NoiseSource(uint64_t seed);
+    float uniform();   // [0, 1)
+    float gaussian();  // Mean 0, standard deviation 1
+
+private:
+    uint64_t state;
+};
+
+// =============================================================================
+// TRACES
+// =============================================================================
+
+// One MAX30102 FIFO sample; references are 0 where the trace has none
+struct PulseSample {
+    uint32_t timestamp;  // ms
+    uint32_t red;
+    uint32_t ir;
+    float referenceHeartRate;  // BPM
+    float referenceSpO2;       // %
+};
+
+struct PulseTrace {
+    std::string name;
+    std::vector<PulseSample> samples;
+    bool hasReference;
+};
+
+// Movement summaries in log order; a session's movements are contiguous
+struct MovementTrace {
+    std::string name;
+    std::vector<MovementAnalytics> movements;
+};
+
+// CSV: timestamp_ms,red,ir[,reference_hr,reference_spo2]
+bool loadPulseTrace(const char* path, PulseTrace& trace);
+
+// CSV: session,servo,start_ms,duration_ms,start_angle,target_angle,actual_angle,successful,smoothness[,type]
+bool loadMovementTrace(const char* path, MovementTrace& trace);
+
+// Finger on the sensor at 100Hz: a two-wave pulse at heartRate (with slow
+// variability) whose red/IR perfusion ratio gives spO2 on the firmware's
+// calibration curve, plus respiration wander and sensor noise
+PulseTrace synthesizePulseTrace(const char* name, float heartRate, float spO2, uint32_t seconds,
+                                uint64_t seed);
+
+// Sessions of repetitions with the given success probability and smoothness spread
+MovementTrace synthesizeMovementTrace(const char* name, int sessions, int movementsPerSession,
+                                      float successProbability, float smoothnessMean,
+                                      float smoothnessSpread, uint64_t seed);
+
+}  // namespace bench
+
+#endif
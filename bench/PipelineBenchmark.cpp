@@ -0,0 +1,481 @@
+/**
+ * Host benchmark of the firmware's DSP and analytics hot paths.
+ *
+ * Recorded traces (or built-in synthetic ones) are replayed through the
+ * unmodified firmware sources:
+ *  - pulse:      PulseSignalProcessor, gated like PulseMonitorManager
+ *  - smoothness: SmoothnessEstimator on commanded and gyro-measured movements
+ *  - analytics:  SessionAnalyticsManager through its event queue
+ *
+ * Each pipeline reports ns per sample (best of several timed passes), heap
+ * allocations per sample in steady state, and accuracy against the trace's
+ * reference values. Exits non-zero if a hot path allocates or a synthetic
+ * trace, whose true values are known exactly, misses its accuracy bound.
+ *
+ *   .pio/build/native/program [--pulse trace.csv]... [--movements log.csv]...
+ *                             [--no-synthetic] [--min-time-ms N]
+ */
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include "BenchSupport.h"
+#include "../src/sensors/PulseSignalProcessor.h"
+#include "../src/hardware/SmoothnessEstimator.h"
+#include "../src/analytics/SessionAnalyticsManager.h"
+
+using bench::AllocationCount;
+using bench::MovementTrace;
+using bench::PulseSample;
+using bench::PulseTrace;
+
+// Same gating as PulseMonitorManager::processSample
+static const uint32_t FINGER_IR_THRESHOLD = 50000;
+static const uint32_t SPO2_RED_THRESHOLD = 20000;
+
+// Beat averaging and the SpO2 window need a few seconds after placement
+static const uint32_t PULSE_WARMUP_MS = 8000;
+
+// Accuracy bounds for synthetic traces
+static const float PULSE_MAX_HEART_RATE_MAE = 3.0f;     // BPM
+static const float PULSE_MAX_SPO2_MAE = 2.0f;           // %
+static const float PULSE_MIN_COVERAGE = 0.95f;          // Evaluated samples with a reading
+static const float SMOOTHNESS_MAX_CLEAN_ERROR = 5.0f;   // Points below 100 for minimum-jerk
+static const float SMOOTHNESS_MAX_GYRO_ERROR = 5.0f;    // Same, with gyro noise
+static const float ANALYTICS_MAX_RATE_ERROR = 1e-4f;
+static const float ANALYTICS_MAX_MEAN_ERROR = 0.01f;    // Smoothness points
+static const float ANALYTICS_MAX_STDDEV_ERROR = 0.05f;
+
+static uint32_t minimumTimeMs = 200;
+static int failureCount = 0;
+static volatile float resultSink;  // Keeps timed results observable
+
+static void fail(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("FAIL: ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    failureCount++;
+}
+
+// =============================================================================
+// TIMING
+// =============================================================================
+
+struct Measurement {
+    double nsPerSample;        // Best pass
+    double allocationsPerSample;
+    uint64_t allocatedBytes;   // In one pass
+    uint32_t passes;
+};
+
+// Runs pass() until minimumTimeMs has been spent (at least three times) and
+// keeps the fastest - the pass least disturbed by the host
+template <typename Pass>
+static Measurement measure(size_t samplesPerPass, Pass pass) {
+    Measurement result = {};
+    if (samplesPerPass == 0) return result;
+
+    pass();  // Warm caches and any one-time allocations
+
+    AllocationCount before = bench::allocationCount();
+    uint64_t best = UINT64_MAX;
+    uint64_t total = 0;
+
+    while (result.passes < 3 || total < (uint64_t)minimumTimeMs * 1000000ull) {
+        uint64_t start = bench::nowNs();
+        pass();
+        uint64_t elapsed = bench::nowNs() - start;
+
+        if (elapsed < best) best = elapsed;
+        total += elapsed;
+        result.passes++;
+    }
+
+    AllocationCount after = bench::allocationCount();
+    result.nsPerSample = (double)best / samplesPerPass;
+    result.allocationsPerSample = (double)(after.allocations - before.allocations) / result.passes / samplesPerPass;
+    result.allocatedBytes = (after.bytes - before.bytes) / result.passes;
+    return result;
+}
+
+static void printRow(const char* pipeline, const std::string& trace, size_t samples,
+                     const Measurement& measurement, const char* accuracy) {
+    printf("%-11s %-24s %8zu %10.1f %12.3f  %s\n", pipeline, trace.c_str(), samples,
+           measurement.nsPerSample, measurement.allocationsPerSample, accuracy);
+}
+
+static void checkAllocations(const char* pipeline, const std::string& trace, const Measurement& measurement) {
+    if (measurement.allocationsPerSample > 0.0) {
+        fail("%s/%s allocates %.3f times per sample (%llu bytes per pass)", pipeline, trace.c_str(),
+             measurement.allocationsPerSample, (unsigned long long)measurement.allocatedBytes);
+    }
+}
+
+// =============================================================================
+// PULSE
+// =============================================================================
+
+struct PulseAccuracy {
+    uint32_t evaluated;       // Samples past warm-up with a reference
+    uint32_t heartRateCount;  // ... of which had a heart rate
+    uint32_t spO2Count;
+    double heartRateErrorSum;
+    double heartRateErrorMax;
+    double spO2ErrorSum;
+    double spO2ErrorMax;
+};
+
+static PulseSignalProcessor pulseProcessor;
+
+// One pass over the trace; accuracy is collected when given
+static void replayPulse(const PulseTrace& trace, PulseAccuracy* accuracy) {
+    pulseProcessor.reset();
+    bool fingerDetected = false;
+    uint32_t placementTime = 0;
+    float sink = 0.0f;
+
+    for (const PulseSample& sample : trace.samples) {
+        float heartRate = 0.0f;
+        float spO2 = 0.0f;
+
+        if (sample.ir > FINGER_IR_THRESHOLD) {
+            if (!fingerDetected) placementTime = sample.timestamp;
+            fingerDetected = true;
+
+            pulseProcessor.addSample(sample.red, sample.ir, sample.timestamp);
+            heartRate = pulseProcessor.getHeartRate();
+            spO2 = sample.red >= SPO2_RED_THRESHOLD ? pulseProcessor.getSpO2() : 0.0f;
+        } else if (fingerDetected) {
+            fingerDetected = false;
+            pulseProcessor.reset();
+        }
+        sink += heartRate + spO2;
+
+        if (!accuracy || !fingerDetected || sample.timestamp - placementTime < PULSE_WARMUP_MS) continue;
+        if (sample.referenceHeartRate <= 0.0f) continue;
+
+        accuracy->evaluated++;
+        if (heartRate > 0.0f) {
+            double error = fabs(heartRate - sample.referenceHeartRate);
+            accuracy->heartRateCount++;
+            accuracy->heartRateErrorSum += error;
+            if (error > accuracy->heartRateErrorMax) accuracy->heartRateErrorMax = error;
+        }
+        if (spO2 > 0.0f && sample.referenceSpO2 > 0.0f) {
+            double error = fabs(spO2 - sample.referenceSpO2);
+            accuracy->spO2Count++;
+            accuracy->spO2ErrorSum += error;
+            if (error > accuracy->spO2ErrorMax) accuracy->spO2ErrorMax = error;
+        }
+    }
+
+    resultSink = sink;
+}
+
+static void benchmarkPulse(const PulseTrace& trace, bool synthetic) {
+    PulseAccuracy accuracy = {};
+    replayPulse(trace, &accuracy);
+
+    Measurement measurement = measure(trace.samples.size(), [&]() { replayPulse(trace, nullptr); });
+
+    char text[160];
+    float coverage = accuracy.evaluated ? (float)accuracy.heartRateCount / accuracy.evaluated : 0.0f;
+    float heartRateMae = accuracy.heartRateCount ? (float)(accuracy.heartRateErrorSum / accuracy.heartRateCount) : 0.0f;
+    float spO2Mae = accuracy.spO2Count ? (float)(accuracy.spO2ErrorSum / accuracy.spO2Count) : 0.0f;
+
+    if (!trace.hasReference) {
+        snprintf(text, sizeof(text), "no reference columns");
+    } else {
+        snprintf(text, sizeof(text), "HR MAE %.2f bpm (max %.1f), SpO2 MAE %.2f%% (max %.1f), coverage %.0f%%",
+                 heartRateMae, accuracy.heartRateErrorMax, spO2Mae, accuracy.spO2ErrorMax, coverage * 100.0f);
+    }
+    printRow("pulse", trace.name, trace.samples.size(), measurement, text);
+    checkAllocations("pulse", trace.name, measurement);
+
+    if (!synthetic) return;
+
+    if (coverage < PULSE_MIN_COVERAGE) {
+        fail("pulse/%s heart rate on only %.0f%% of samples", trace.name.c_str(), coverage * 100.0f);
+    }
+    if (heartRateMae > PULSE_MAX_HEART_RATE_MAE) {
+        fail("pulse/%s heart rate MAE %.2f bpm above %.1f", trace.name.c_str(), heartRateMae, PULSE_MAX_HEART_RATE_MAE);
+    }
+    if (accuracy.spO2Count == 0 || spO2Mae > PULSE_MAX_SPO2_MAE) {
+        fail("pulse/%s SpO2 MAE %.2f%% above %.1f", trace.name.c_str(), spO2Mae, PULSE_MAX_SPO2_MAE);
+    }
+}
+
+// =============================================================================
+// SMOOTHNESS
+// =============================================================================
+
+struct SmoothnessCase {
+    float amplitude;         // degrees
+    unsigned long duration;  // ms
+};
+
+static const SmoothnessCase SMOOTHNESS_CASES[] = {
+    {20.0f, 500}, {45.0f, 800}, {90.0f, 1200}, {90.0f, 2000}, {60.0f, 3000},
+};
+static const size_t SMOOTHNESS_CASE_COUNT = sizeof(SMOOTHNESS_CASES) / sizeof(SMOOTHNESS_CASES[0]);
+
+// Minimum-jerk profile, normalized time 0..1
+static float minimumJerkPosition(float tau) {
+    return tau * tau * tau * (10.0f + tau * (-15.0f + tau * 6.0f));
+}
+
+static float minimumJerkVelocity(float tau) {
+    return 30.0f * tau * tau * (1.0f - tau) * (1.0f - tau);
+}
+
+// Per-movement samples, built once so the timed loop only runs the estimator
+struct SmoothnessSamples {
+    std::vector<float> values;
+    std::vector<unsigned long> timestamps;
+    std::vector<size_t> movementEnds;  // One past each movement's last sample
+};
+
+// Commanded: setpoint positions at the servo control rate. Measured: gyro
+// velocity at the motion sampling rate with sensor noise.
+static SmoothnessSamples buildSmoothnessSamples(bool measured) {
+    SmoothnessSamples samples;
+    bench::NoiseSource noise(0x5300);
+    unsigned long interval = measured ? 1000 / MOTION_SAMPLING_RATE_HZ : SERVO_CONTROL_PERIOD_MS;
+    const float GYRO_NOISE_DPS = 0.05f;  // MPU6050 rate noise at the configured filter bandwidth
+
+    for (size_t c = 0; c < SMOOTHNESS_CASE_COUNT; c++) {
+        const SmoothnessCase& movement = SMOOTHNESS_CASES[c];
+        for (unsigned long t = 0; t <= movement.duration; t += interval) {
+            float tau = (float)t / movement.duration;
+            float value = measured
+                ? movement.amplitude * 1000.0f / movement.duration * minimumJerkVelocity(tau) + GYRO_NOISE_DPS * noise.gaussian()
+                : movement.amplitude * minimumJerkPosition(tau);
+            samples.values.push_back(value);
+            samples.timestamps.push_back(t);
+        }
+        samples.movementEnds.push_back(samples.values.size());
+    }
+    return samples;
+}
+
+static SmoothnessEstimator smoothnessEstimator;
+
+// One pass; returns the mean shortfall from 100 and the worst one
+static float replaySmoothness(const SmoothnessSamples& samples, bool measured, float* worstError) {
+    size_t index = 0;
+    float errorSum = 0.0f;
+    float worst = 0.0f;
+
+    for (size_t end : samples.movementEnds) {
+        smoothnessEstimator.reset();
+        for (; index < end; index++) {
+            if (measured) {
+                smoothnessEstimator.addVelocity(samples.values[index], samples.timestamps[index]);
+            } else {
+                smoothnessEstimator.addPosition(samples.values[index], samples.timestamps[index]);
+            }
+        }
+
+        float error = 100.0f - smoothnessEstimator.getScore();
+        errorSum += error;
+        if (error > worst) worst = error;
+    }
+
+    resultSink = errorSum;
+    if (worstError) *worstError = worst;
+    return errorSum / samples.movementEnds.size();
+}
+
+static void benchmarkSmoothness(bool measured) {
+    SmoothnessSamples samples = buildSmoothnessSamples(measured);
+    std::string name = measured ? "minimum_jerk_gyro" : "minimum_jerk_setpoints";
+
+    float worstError = 0.0f;
+    float meanError = replaySmoothness(samples, measured, &worstError);
+
+    Measurement measurement = measure(samples.values.size(), [&]() { replaySmoothness(samples, measured, nullptr); });
+
+    char text[160];
+    snprintf(text, sizeof(text), "score error %.2f points (max %.2f) over %zu movements",
+             meanError, worstError, samples.movementEnds.size());
+    printRow("smoothness", name, samples.values.size(), measurement, text);
+    checkAllocations("smoothness", name, measurement);
+
+    float maxError = measured ? SMOOTHNESS_MAX_GYRO_ERROR : SMOOTHNESS_MAX_CLEAN_ERROR;
+    if (worstError > maxError) {
+        fail("smoothness/%s scores a minimum-jerk movement %.2f points low", name.c_str(), worstError);
+    }
+}
+
+// =============================================================================
+// ANALYTICS
+// =============================================================================
+
+// Zero-initialized like the firmware's global instance
+static SessionAnalyticsManager analytics;
+
+// A session's contiguous run of movements in the trace
+struct SessionRun {
+    String sessionId;
+    size_t first;
+    size_t end;
+};
+
+struct AnalyticsAccuracy {
+    float rateError;
+    float meanError;
+    float stdDevError;
+    uint32_t countMismatches;
+};
+
+static std::vector<SessionRun> splitSessions(const MovementTrace& trace) {
+    std::vector<SessionRun> runs;
+    for (size_t i = 0; i < trace.movements.size(); i++) {
+        if (runs.empty() || !trace.movements[i].sessionId.equals(trace.movements[runs.back().first].sessionId)) {
+            if (!runs.empty()) runs.back().end = i;
+            runs.push_back({String(trace.movements[i].sessionId.c_str()), i, i});
+        }
+    }
+    if (!runs.empty()) runs.back().end = trace.movements.size();
+    return runs;
+}
+
+// Double precision, two-pass statistics of one session
+static void checkSession(const MovementTrace& trace, const SessionRun& run, AnalyticsAccuracy& accuracy) {
+    size_t count = run.end - run.first;
+    double successes = 0.0, smoothnessSum = 0.0, durationSum = 0.0;
+    for (size_t i = run.first; i < run.end; i++) {
+        successes += trace.movements[i].successful ? 1.0 : 0.0;
+        smoothnessSum += trace.movements[i].smoothness;
+        durationSum += trace.movements[i].duration;
+    }
+    double mean = smoothnessSum / count;
+    double squares = 0.0;
+    for (size_t i = run.first; i < run.end; i++) {
+        double deviation = trace.movements[i].smoothness - mean;
+        squares += deviation * deviation;
+    }
+    double stdDev = count > 1 ? sqrt(squares / (count - 1)) : 0.0;
+
+    analytics.generateSessionQuality(run.sessionId);
+    SessionQualityMetrics quality = analytics.getSessionQuality(run.sessionId);
+
+    accuracy.rateError = fmaxf(accuracy.rateError, (float)fabs(quality.successRate - successes / count));
+    accuracy.meanError = fmaxf(accuracy.meanError, (float)fabs(quality.averageSmoothness - mean));
+    accuracy.stdDevError = fmaxf(accuracy.stdDevError, (float)fabs(quality.smoothnessStdDev - stdDev));
+    if (quality.totalMovements != (int)count || quality.successfulMovements != (int)successes ||
+        quality.averageMovementTime != (unsigned long)(durationSum / count)) {
+        accuracy.countMismatches++;
+    }
+}
+
+// One pass: every session started, its movements queued and processed one
+// at a time as the analytics task would, then ended
+static void replayAnalytics(const MovementTrace& trace, const std::vector<SessionRun>& runs,
+                            AnalyticsAccuracy* accuracy) {
+    for (const SessionRun& run : runs) {
+        analytics.processSessionStart(run.sessionId);
+        analytics.processAnalyticsQueue();
+
+        for (size_t i = run.first; i < run.end; i++) {
+            analytics.processMovementData(trace.movements[i]);
+            analytics.processAnalyticsQueue();
+        }
+
+        if (accuracy) checkSession(trace, run, *accuracy);
+
+        const MovementAnalytics& last = trace.movements[run.end - 1];
+        analytics.processSessionEnd(run.sessionId, last.startTime + last.duration - trace.movements[run.first].startTime);
+        analytics.processAnalyticsQueue();
+    }
+}
+
+static void benchmarkAnalytics(const MovementTrace& trace, bool synthetic) {
+    std::vector<SessionRun> runs = splitSessions(trace);
+
+    AnalyticsAccuracy accuracy = {};
+    replayAnalytics(trace, runs, &accuracy);
+
+    Measurement measurement = measure(trace.movements.size(), [&]() { replayAnalytics(trace, runs, nullptr); });
+
+    char text[160];
+    snprintf(text, sizeof(text), "max error rate %.1e, mean %.4f, stddev %.4f, %u count mismatches (%zu sessions)",
+             accuracy.rateError, accuracy.meanError, accuracy.stdDevError, accuracy.countMismatches, runs.size());
+    printRow("analytics", trace.name, trace.movements.size(), measurement, text);
+    checkAllocations("analytics", trace.name, measurement);
+
+    // Running float aggregates against exact statistics of the log
+    if (accuracy.countMismatches > 0) {
+        fail("analytics/%s movement counts or durations differ in %u sessions", trace.name.c_str(), accuracy.countMismatches);
+    }
+    if (synthetic && (accuracy.rateError > ANALYTICS_MAX_RATE_ERROR || accuracy.meanError > ANALYTICS_MAX_MEAN_ERROR ||
+                      accuracy.stdDevError > ANALYTICS_MAX_STDDEV_ERROR)) {
+        fail("analytics/%s running statistics drift from the exact values", trace.name.c_str());
+    }
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void printUsage(const char* program) {
+    printf("Usage: %s [--pulse trace.csv]... [--movements log.csv]... [--no-synthetic] [--min-time-ms N]\n"
+           "  pulse trace:  timestamp_ms,red,ir[,reference_hr,reference_spo2]\n"
+           "  movement log: session,servo,start_ms,duration_ms,start_angle,target_angle,actual_angle,"
+           "successful,smoothness[,type]\n",
+           program);
+}
+
+int main(int argc, char** argv) {
+    std::vector<PulseTrace> pulseTraces;
+    std::vector<MovementTrace> movementTraces;
+    bool synthetic = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pulse") == 0 && i + 1 < argc) {
+            PulseTrace trace;
+            if (!bench::loadPulseTrace(argv[++i], trace)) return 2;
+            pulseTraces.push_back(trace);
+        } else if (strcmp(argv[i], "--movements") == 0 && i + 1 < argc) {
+            MovementTrace trace;
+            if (!bench::loadMovementTrace(argv[++i], trace)) return 2;
+            movementTraces.push_back(trace);
+        } else if (strcmp(argv[i], "--no-synthetic") == 0) {
+            synthetic = false;
+        } else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            minimumTimeMs = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else {
+            printUsage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    analytics.initialize();
+
+    printf("%-11s %-24s %8s %10s %12s  %s\n", "pipeline", "trace", "samples", "ns/sample", "allocs/sample", "accuracy");
+
+    if (synthetic) {
+        benchmarkPulse(bench::synthesizePulseTrace("synthetic_rest", 72.0f, 97.0f, 60, 1), true);
+        benchmarkPulse(bench::synthesizePulseTrace("synthetic_exercise", 110.0f, 95.0f, 60, 2), true);
+        benchmarkPulse(bench::synthesizePulseTrace("synthetic_hypoxic", 55.0f, 90.0f, 60, 3), true);
+    }
+    for (const PulseTrace& trace : pulseTraces) benchmarkPulse(trace, false);
+
+    benchmarkSmoothness(false);
+    benchmarkSmoothness(true);
+
+    if (synthetic) {
+        benchmarkAnalytics(bench::synthesizeMovementTrace("synthetic_sessions", 4, 500, 0.8f, 75.0f, 12.0f, 4), true);
+    }
+    for (const MovementTrace& trace : movementTraces) benchmarkAnalytics(trace, false);
+
+    analytics.shutdown();
+
+    if (failureCount > 0) {
+        printf("%d check(s) failed\n", failureCount);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include "../../src/utils/Logger.h"
+#include "../../src/hardware/TaskTracer.h"
+#include "../../src/hardware/ResourceProfiler.h"
+
+// =============================================================================
+// ARDUINO CORE
+// =============================================================================
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long millis() {
+    return (unsigned long)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)esp_timer_get_time();
+}
+
+void delay(unsigned long ms) {
+    // Single threaded - nothing else could run while we waited
+}
+
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) {
+    randomState = seed ? (uint32_t)seed : 1;
+}
+
+long random(long max) {
+    if (max <= 0) return 0;
+    // xorshift32 - deterministic across hosts, unlike rand()
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (long)(randomState % (uint32_t)max);
+}
+
+long random(long min, long max) {
+    if (max <= min) return min;
+    return min + random(max - min);
+}
+
+// =============================================================================
+// FREERTOS
+// =============================================================================
+
+struct QueueDefinition {
+    std::vector<uint8_t> storage;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+static uint8_t taskHandleToken;
+
+BaseType_t xPortGetCoreID() {
+    return 1;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t coreId) {
+    if (handle) *handle = (TaskHandle_t)&taskHandleToken;
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {}
+
+void vTaskDelay(TickType_t ticks) {}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return (TaskHandle_t)&taskHandleToken;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    return 0;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    if (length == 0) return nullptr;
+
+    QueueDefinition* queue = new QueueDefinition();
+    queue->storage.resize((size_t)length * (itemSize ? itemSize : 1));
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->head = 0;
+    queue->count = 0;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    if (!queue || queue->count == queue->length) return errQUEUE_FULL;
+
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    if (queue->itemSize && item) memcpy(&queue->storage[(size_t)tail * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void* item, TickType_t ticksToWait) {
+    return xQueueSend(queue, item, ticksToWait);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticksToWait) {
+    if (!queue || queue->count == 0) return pdFAIL;
+
+    if (queue->itemSize && buffer) memcpy(buffer, &queue->storage[(size_t)queue->head * queue->itemSize], queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    return queue ? queue->count : 0;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    return queue ? queue->length - queue->count : 0;
+}
+
+// Binary semaphores and mutexes are one-slot queues; with a single thread
+// a take never has to wait
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+    xSemaphoreGive(mutex);
+    return mutex;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* buffer) {
+    return xSemaphoreCreateMutex();
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xQueueCreate(1, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+    return xQueueReceive(semaphore, nullptr, ticksToWait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return xQueueSend(semaphore, nullptr, 0);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    vQueueDelete(semaphore);
+}
+
+// =============================================================================
+// LOGGER
+// =============================================================================
+
+// Never "initialized", so LOG_DEBUG and friends stay off in the timed loops.
+// Warnings and errors still reach stderr - they mean a replay went wrong.
+LogLevel Logger::currentLevel = LogLevel::WARNING;
+bool Logger::initialized = false;
+
+static void writeLog(LogLevel level, const char* format, va_list args) {
+    if (level < LogLevel::WARNING) return;
+
+    fputs(level == LogLevel::ERROR ? "[ERROR] " : "[WARN] ", stderr);
+    vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+}
+
+static void writeLogf(LogLevel level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeLog(level, format, args);
+    va_end(args);
+}
+
+void Logger::debug(const String& message) { writeLogf(LogLevel::DEBUG, "%s", message.c_str()); }
+void Logger::info(const String& message) { writeLogf(LogLevel::INFO, "%s", message.c_str()); }
+void Logger::warning(const String& message) { writeLogf(LogLevel::WARNING, "%s", message.c_str()); }
+void Logger::error(const String& message) { writeLogf(LogLevel::ERROR, "%s", message.c_str()); }
+
+void Logger::debugf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeLog(LogLevel::DEBUG, format, args);
+    va_end(args);
+}
+
+void Logger::infof(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeLog(LogLevel::INFO, format, args);
+    va_end(args);
+}
+
+void Logger::warningf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeLog(LogLevel::WARNING, format, args);
+    va_end(args);
+}
+
+void Logger::errorf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    writeLog(LogLevel::ERROR, format, args);
+    va_end(args);
+}
+
+// =============================================================================
+// TASK TRACER
+// =============================================================================
+
+// Task loops don't run on the host; the benchmark times the work itself
+TraceId TaskTracer::registerTask(const char* name, uint32_t periodUs) {
+    return TRACE_ID_NONE;
+}
+
+int64_t TaskTracer::begin(TraceId id) {
+    return 0;
+}
+
+void TaskTracer::end(TraceId id, int64_t startUs) {}
+
+// =============================================================================
+// RESOURCE PROFILER
+// =============================================================================
+
+// No tasks are created on the host
+uint32_t ResourceProfiler::getStackSize(ProfiledTask task) {
+    return 0;
+}
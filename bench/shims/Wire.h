@@ -0,0 +1,21 @@
+#ifndef BENCH_SHIM_WIRE_H
+#define BENCH_SHIM_WIRE_H
+
+#include <Arduino.h>
+
+// Declared only so I2C-facing headers parse - no benchmarked code talks to the bus
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    void setClock(uint32_t frequency);
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+    size_t write(uint8_t data);
+    int available();
+    int read();
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef BENCH_SHIM_ESP_TIMER_H
+#define BENCH_SHIM_ESP_TIMER_H
+
+#include <stdint.h>
+
+// Microseconds since the benchmark started
+int64_t esp_timer_get_time();
+
+#endif
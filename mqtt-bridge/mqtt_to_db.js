@@ -20,31 +20,102 @@ const DB_CONFIG = {
     database: process.env.DB_NAME || 'rehab_exoskeleton'
 };
 
-// MQTT Topics to subscribe to
+// MQTT Topics to subscribe to - one wildcard per stream covers every device,
+// the device ID is taken from the second topic level
 const TOPICS = [
-    'rehab_exo/ESP32_001/movement/command',
-    'rehab_exo/ESP32_001/system/status',
-    'rehab_exo/ESP32_001/connection/wifi',
-    'rehab_exo/ESP32_001/connection/ble',
-    'rehab_exo/ESP32_001/session/start',
-    'rehab_exo/ESP32_001/session/end',
-    'rehab_exo/ESP32_001/session/progress',
+    'rehab_exo/+/movement/command',
+    'rehab_exo/+/system/status',
+    'rehab_exo/+/connection/wifi',
+    'rehab_exo/+/connection/ble',
+    'rehab_exo/+/session/start',
+    'rehab_exo/+/session/end',
+    'rehab_exo/+/session/progress',
     // Enhanced Analytics Topics
-    'rehab_exo/ESP32_001/movement/individual',
-    'rehab_exo/ESP32_001/movement/quality',
-    'rehab_exo/ESP32_001/performance/timing',
-    'rehab_exo/ESP32_001/performance/memory',
-    'rehab_exo/ESP32_001/clinical/progress',
-    'rehab_exo/ESP32_001/clinical/quality',
+    'rehab_exo/+/movement/individual',
+    'rehab_exo/+/movement/quality',
+    'rehab_exo/+/performance/timing',
+    'rehab_exo/+/performance/memory',
+    'rehab_exo/+/clinical/progress',
+    'rehab_exo/+/clinical/quality',
     // Biometric Topics
-    'rehab_exo/ESP32_001/sensors/heart_rate',
-    'rehab_exo/pulse_metrics'
+    'rehab_exo/+/sensors/heart_rate',
+    'rehab_exo/pulse_metrics',
+    // Batched Telemetry (binary frames)
+    'rehab_exo/+/telemetry/batch'
 ];
 
+// Batched telemetry frame layout (must match src/network/TelemetryBatch.h)
+const TELEMETRY_FRAME = {
+    MAGIC: 'RT',
+    // Header size by frame version - version 1 firmware had a 16 byte session ID
+    HEADER_SIZES: { 1: 32, 2: 36 },
+    SESSION_ID_OFFSET: 16,
+    TYPE_HEART_RATE: 1,
+    TYPE_MOVEMENT: 2
+};
+
+const TELEMETRY_QUALITY_NAMES = ['unknown', 'good', 'fair', 'poor', 'no_signal'];
+const TELEMETRY_MOVEMENT_NAMES = ['unknown', 'sequential', 'simultaneous', 'home', 'profile', 'exercise'];
+
+// Row batching: rows are buffered per table and written as one multi-row
+// INSERT once DB_BATCH.MAX_ROWS are waiting or DB_BATCH.FLUSH_MS after the first
+const DB_BATCH = {
+    MAX_ROWS: parseInt(process.env.DB_BATCH_MAX_ROWS, 10) || 200,
+    FLUSH_MS: parseInt(process.env.DB_BATCH_FLUSH_MS, 10) || 1000,
+    MAX_PENDING: parseInt(process.env.DB_BATCH_MAX_PENDING, 10) || 5000,  // Kept across a database outage
+    RETRY_MAX_MS: parseInt(process.env.DB_BATCH_RETRY_MAX_MS, 10) || 30000  // Backoff cap after a failed flush
+};
+
+const BATCH_TABLES = {
+    events: {
+        columns: ['session_id', 'timestamp', 'event_type', 'command',
+                  'response_time_ms', 'servo_data', 'movement_successful', 'created_at'],
+        suffix: ''
+    },
+    system_status: {
+        columns: ['device_id', 'status', 'last_seen', 'ip_address',
+                  'firmware_version', 'uptime_seconds', 'created_at'],
+        // One row per device - later rows in a batch win
+        suffix: `ON DUPLICATE KEY UPDATE
+                status = VALUES(status),
+                last_seen = VALUES(last_seen),
+                ip_address = VALUES(ip_address),
+                uptime_seconds = VALUES(uptime_seconds),
+                firmware_version = VALUES(firmware_version)`
+    }
+};
+
+// events columns written by the handlers; the rest take their table default
+const EVENT_FIELDS_MOVEMENT = ['session_id', 'timestamp', 'event_type', 'command',
+                               'response_time_ms', 'servo_data', 'movement_successful'];
+const EVENT_FIELDS_DATA = ['session_id', 'timestamp', 'event_type', 'servo_data'];
+
+// Errors worth retrying the whole batch for; anything else is a bad row
+const TRANSIENT_DB_ERRORS = new Set([
+    'ECONNREFUSED', 'ECONNRESET', 'ETIMEDOUT', 'PROTOCOL_CONNECTION_LOST',
+    'ER_LOCK_DEADLOCK', 'ER_LOCK_WAIT_TIMEOUT', 'ER_CON_COUNT_ERROR'
+]);
+
+// Report-by-exception status topics (must match src/network/TelemetryDeadband.h)
+const STATUS_DELTA_EVENTS = new Set(['system_status', 'performance_timing', 'performance_memory']);
+
 let dbPool;
 let mqttClient;
 let socketClient;
 
+// Last full state per device and status event, reconstructed from deltas
+const statusState = new Map();
+
+// Pending rows per table ({ sql, params } each) and the pending flush
+const rowBuffers = Object.fromEntries(Object.keys(BATCH_TABLES).map(table => [table, []]));
+let flushTimer = null;
+
+// Rows dropped per table because the buffer hit DB_BATCH.MAX_PENDING
+const droppedRows = Object.fromEntries(Object.keys(BATCH_TABLES).map(table => [table, 0]));
+
+// Flush backoff while the database is unavailable: no flush before retryAt
+const dbRetry = { delayMs: 0, retryAt: 0 };
+
 // Initialize database connection
 async function initDatabase() {
     try {
@@ -118,8 +189,21 @@ function initMQTT() {
 
 // Handle incoming MQTT messages
 async function handleMQTTMessage(topic, message) {
+    // Binary telemetry frames are not JSON
+    if (topic.endsWith('telemetry/batch')) {
+        await handleTelemetryBatch(topic, message);
+        return;
+    }
+
     try {
         const data = JSON.parse(message.toString());
+
+        // The topic is authoritative once many devices share one subscription
+        const topicDeviceId = deviceIdFromTopic(topic);
+        if (topicDeviceId) {
+            data.device_id = topicDeviceId;
+        }
+
         console.log(`📨 Received: ${topic}`);
         console.log(`📄 Data:`, JSON.stringify(data, null, 2));
 
@@ -131,10 +215,20 @@ async function handleMQTTMessage(topic, message) {
     }
 }
 
+// rehab_exo/<device_id>/<stream...> - null for topics without a device level
+function deviceIdFromTopic(topic) {
+    const levels = topic.split('/');
+    return levels.length > 2 && levels[0] === 'rehab_exo' ? levels[1] : null;
+}
+
 // Process and store message in database
 async function processMessage(topic, data) {
     const { device_id, timestamp, event_type } = data;
 
+    if (STATUS_DELTA_EVENTS.has(event_type)) {
+        data = mergeStatusDelta(data);
+    }
+
     if (event_type === 'movement_command') {
         await handleMovementCommand(data);
     } else if (event_type === 'system_status') {
@@ -155,6 +249,10 @@ async function processMessage(topic, data) {
         await handlePerformanceTiming(data);
     } else if (event_type === 'performance_memory') {
         await handlePerformanceMemory(data);
+    } else if (event_type === 'performance_tasks') {
+        await handlePerformanceTasks(data);
+    } else if (event_type === 'boot_timing') {
+        await handleBootTiming(data);
     } else if (event_type === 'clinical_progress') {
         await handleClinicalProgress(data);
     } else if (event_type === 'clinical_quality') {
@@ -168,6 +266,168 @@ async function processMessage(topic, data) {
     }
 }
 
+// A full report replaces the stored state; a delta ("delta": true) carries only
+// the fields that left their deadband and is merged into it. Handlers always
+// see the full state. Every field is resent at least once per heartbeat, so a
+// bridge that starts mid-stream converges within TELEMETRY_MAX_SILENCE.
+function mergeStatusDelta(message) {
+    const key = `${message.device_id}/${message.event_type}`;
+    const previous = statusState.get(key);
+
+    if (message.delta && !previous) {
+        console.log(`ℹ️  Delta for ${key} before any full report - partial state until the next heartbeat`);
+    }
+
+    const fields = message.delta && previous
+        ? { ...previous, ...message.data }
+        : { ...message.data };
+    statusState.set(key, fields);
+
+    const { delta, ...full } = message;
+    return { ...full, data: fields };
+}
+
+// =============================================================================
+// BATCHED INSERTS
+// =============================================================================
+
+// Queue one events row - fields lists the columns given in values, in order
+function queueEvent(fields, values) {
+    const placeholders = [];
+    const params = [];
+
+    BATCH_TABLES.events.columns.forEach(column => {
+        const index = fields.indexOf(column);
+        if (column === 'created_at') {
+            placeholders.push('NOW()');
+        } else if (index < 0) {
+            placeholders.push('DEFAULT');
+        } else {
+            placeholders.push(column === 'timestamp' ? 'FROM_UNIXTIME(?)' : '?');
+            params.push(values[index]);
+        }
+    });
+
+    return queueRow('events', `(${placeholders.join(', ')})`, params);
+}
+
+// Resolves once the row is buffered, or written when it filled the batch
+function queueRow(table, sql, params) {
+    const buffer = rowBuffers[table];
+    buffer.push({ sql, params });
+    trimBuffer(table);
+
+    // While backing off, a full batch waits for the retry timer like any other
+    if (buffer.length >= DB_BATCH.MAX_ROWS && Date.now() >= dbRetry.retryAt) {
+        return flushTable(table);
+    }
+
+    scheduleFlush();
+    return Promise.resolve();
+}
+
+// Drops the oldest rows beyond DB_BATCH.MAX_PENDING
+function trimBuffer(table) {
+    const buffer = rowBuffers[table];
+    const excess = buffer.length - DB_BATCH.MAX_PENDING;
+    if (excess <= 0) return;
+
+    buffer.splice(0, excess);
+    if (droppedRows[table] === 0) {
+        console.error(`❌ ${table} buffer full (${DB_BATCH.MAX_PENDING} rows) - dropping oldest rows until the database is back`);
+    }
+    droppedRows[table] += excess;
+}
+
+function scheduleFlush() {
+    if (flushTimer) return;
+
+    const delay = Math.max(DB_BATCH.FLUSH_MS, dbRetry.retryAt - Date.now());
+    flushTimer = setTimeout(() => {
+        flushTimer = null;
+        if (Date.now() < dbRetry.retryAt) {
+            scheduleFlush();
+            return;
+        }
+        flushAll();
+    }, delay);
+}
+
+function flushAll() {
+    return Promise.all(Object.keys(rowBuffers).map(flushTable));
+}
+
+function buildInsert(table, rows) {
+    const { columns, suffix } = BATCH_TABLES[table];
+    return {
+        sql: `INSERT INTO ${table} (${columns.join(', ')}) VALUES ${rows.map(row => row.sql).join(', ')} ${suffix}`,
+        params: rows.flatMap(row => row.params)
+    };
+}
+
+async function flushTable(table) {
+    const buffer = rowBuffers[table];
+
+    while (buffer.length > 0) {
+        const rows = buffer.splice(0, DB_BATCH.MAX_ROWS);
+        const { sql, params } = buildInsert(table, rows);
+
+        try {
+            // query rather than execute: each batch size would be another prepared statement
+            await dbPool.query(sql, params);
+            console.log(`✅ Flushed ${rows.length} ${table} rows`);
+            clearBackoff(table);
+        } catch (error) {
+            if (TRANSIENT_DB_ERRORS.has(error.code)) {
+                requeueRows(table, rows, error);
+                return;
+            }
+
+            // One bad row must not take the rest of the batch with it
+            console.error(`❌ Batch insert into ${table} failed (${error.code}), retrying row by row`);
+            await insertRowsIndividually(table, rows);
+        }
+    }
+}
+
+// Puts the failed batch back in front and doubles the wait before the next flush
+function requeueRows(table, rows, error) {
+    const buffer = rowBuffers[table];
+    buffer.unshift(...rows);
+    trimBuffer(table);
+
+    dbRetry.delayMs = Math.min(Math.max(dbRetry.delayMs * 2, DB_BATCH.FLUSH_MS), DB_BATCH.RETRY_MAX_MS);
+    dbRetry.retryAt = Date.now() + dbRetry.delayMs;
+
+    console.error(`❌ Database unavailable (${error.code}) - keeping ${buffer.length} ${table} rows, retrying in ${dbRetry.delayMs} ms`);
+    scheduleFlush();
+}
+
+function clearBackoff(table) {
+    dbRetry.delayMs = 0;
+    dbRetry.retryAt = 0;
+
+    if (droppedRows[table] > 0) {
+        console.error(`❌ Dropped ${droppedRows[table]} ${table} rows while the database was unavailable`);
+        droppedRows[table] = 0;
+    }
+}
+
+async function insertRowsIndividually(table, rows) {
+    for (const row of rows) {
+        const { sql, params } = buildInsert(table, [row]);
+        try {
+            await dbPool.query(sql, params);
+        } catch (error) {
+            console.error(`❌ Dropped ${table} row (${error.code}):`, error.message);
+        }
+    }
+}
+
+// =============================================================================
+// MESSAGE HANDLERS
+// =============================================================================
+
 // Handle movement command events
 async function handleMovementCommand(data) {
     try {
@@ -175,12 +435,7 @@ async function handleMovementCommand(data) {
         const { command, response_time_ms, ble_connected, session_id } = eventData;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, command,
-                response_time_ms, servo_data, movement_successful, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, ?, ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_MOVEMENT, [
             session_id || null,
             timestamp,
             'movement_command',
@@ -213,18 +468,7 @@ async function handleSystemStatus(data) {
         } = eventData;
 
         // Update system_status table (UPDATE only, don't insert duplicates)
-        await dbPool.execute(`
-            INSERT INTO system_status (
-                device_id, status, last_seen, ip_address,
-                firmware_version, uptime_seconds, created_at
-            ) VALUES (?, ?, FROM_UNIXTIME(?), ?, ?, ?, NOW())
-            ON DUPLICATE KEY UPDATE
-                status = VALUES(status),
-                last_seen = VALUES(last_seen),
-                ip_address = VALUES(ip_address),
-                uptime_seconds = VALUES(uptime_seconds),
-                firmware_version = VALUES(firmware_version)
-        `, [
+        await queueRow('system_status', '(?, ?, FROM_UNIXTIME(?), ?, ?, ?, NOW())', [
             device_id,
             status,
             timestamp,
@@ -252,11 +496,7 @@ async function handleConnectionEvent(data) {
         const { status } = eventData;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             null,
             timestamp,
             event_type === 'ble_status' ? 'ble_connect' : 'wifi_connect',
@@ -291,11 +531,7 @@ async function handleSessionStart(data) {
         ]);
 
         // Insert session start event
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id,
             timestamp,
             'session_start',
@@ -346,11 +582,7 @@ async function handleSessionEnd(data) {
         ]);
 
         // Insert session end event
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id,
             timestamp,
             'session_end',
@@ -416,12 +648,7 @@ async function handleMovementIndividual(data) {
         } = eventData;
 
         // Insert into events table with enhanced movement data
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, command,
-                response_time_ms, servo_data, movement_successful, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, ?, ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_MOVEMENT, [
             session_id || null,
             timestamp,
             'movement_individual',
@@ -453,11 +680,7 @@ async function handleMovementQuality(data) {
         const { session_id, overall_quality, average_smoothness, success_rate } = eventData;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id || null,
             timestamp,
             'movement_quality',
@@ -480,18 +703,15 @@ async function handleMovementQuality(data) {
 async function handlePerformanceTiming(data) {
     try {
         const { device_id, timestamp, data: eventData } = data;
-        const { loop_time, average_loop_time, max_loop_time } = eventData;
+        const { average_loop_time, max_loop_time, core0_load, core1_load } = eventData;
+        const loop_time = eventData.current_loop_time ?? eventData.loop_time;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             null, // Performance events are not session-specific
             timestamp,
             'performance_timing',
-            JSON.stringify({ loop_time, average_loop_time, max_loop_time })
+            JSON.stringify({ loop_time, average_loop_time, max_loop_time, core0_load, core1_load })
         ]);
 
         console.log(`✅ Stored performance timing: Loop ${loop_time}ms, Avg ${average_loop_time}ms`);
@@ -501,6 +721,58 @@ async function handlePerformanceTiming(data) {
     }
 }
 
+// Handle per-task CPU and stack tables. Rows follow data.columns; cpu_percent
+// is -1 when the firmware was built without FreeRTOS run-time stats.
+async function handlePerformanceTasks(data) {
+    try {
+        const { timestamp, data: eventData } = data;
+        const { window_ms, per_task_cpu, columns = [], tasks: rows = [], omitted = 0 } = eventData;
+
+        const tasks = rows.map(row =>
+            Object.fromEntries(columns.map((column, index) => [column, row[index]])));
+
+        await queueEvent(EVENT_FIELDS_DATA, [
+            null, // Performance events are not session-specific
+            timestamp,
+            'performance_tasks',
+            JSON.stringify({ window_ms, per_task_cpu, tasks, omitted })
+        ]);
+
+        const tightest = tasks.reduce((min, task) =>
+            (min === null || task.stack_free < min.stack_free) ? task : min, null);
+        console.log(`✅ Stored task usage: ${tasks.length} tasks` +
+            (tightest ? `, tightest stack ${tightest.name} (${tightest.stack_free} bytes free)` : ''));
+
+    } catch (error) {
+        console.error('❌ Error storing task usage:', error);
+    }
+}
+
+// Handle the once-per-boot stage timings; rows follow data.columns
+async function handleBootTiming(data) {
+    try {
+        const { timestamp, data: eventData } = data;
+        const { ready_ms, complete_ms, columns = [], stages: rows = [] } = eventData;
+
+        const stages = rows.map(row =>
+            Object.fromEntries(columns.map((column, index) => [column, row[index]])));
+
+        await queueEvent(EVENT_FIELDS_DATA, [
+            null, // Performance events are not session-specific
+            timestamp,
+            'boot_timing',
+            JSON.stringify({ ready_ms, complete_ms, stages })
+        ]);
+
+        const failed = stages.filter(stage => stage.result !== 'ok').map(stage => stage.name);
+        console.log(`✅ Stored boot timing: ready ${ready_ms}ms, complete ${complete_ms}ms` +
+            (failed.length ? `, not ok: ${failed.join(', ')}` : ''));
+
+    } catch (error) {
+        console.error('❌ Error storing boot timing:', error);
+    }
+}
+
 // Handle performance memory events
 async function handlePerformanceMemory(data) {
     try {
@@ -508,11 +780,7 @@ async function handlePerformanceMemory(data) {
         const { free_heap, min_free_heap, memory_usage_percent } = eventData;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             null, // Performance events are not session-specific
             timestamp,
             'performance_memory',
@@ -533,11 +801,7 @@ async function handleClinicalProgress(data) {
         const { session_id, progress_score, progress_indicators } = eventData;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id || null,
             timestamp,
             'clinical_progress',
@@ -563,11 +827,7 @@ async function handleClinicalQuality(data) {
         const { session_id, quality_score, quality_metrics } = eventData;
 
         // Insert into events table
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id || null,
             timestamp,
             'clinical_quality',
@@ -592,11 +852,7 @@ async function handleHeartRate(data) {
         const { device_id, timestamp, heart_rate, spo2, signal_quality, finger_detected, session_id } = data;
 
         // Insert into events table as biometric data
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id || null,
             timestamp / 1000, // Convert milliseconds to seconds
             'heart_rate',
@@ -631,11 +887,7 @@ async function handlePulseMetrics(data) {
         const { device_id, timestamp, session_id, avg_heart_rate, min_heart_rate, max_heart_rate, avg_spo2, data_quality } = data;
 
         // Insert into events table as pulse metrics
-        await dbPool.execute(`
-            INSERT INTO events (
-                session_id, timestamp, event_type, servo_data, created_at
-            ) VALUES (?, FROM_UNIXTIME(?), ?, ?, NOW())
-        `, [
+        await queueEvent(EVENT_FIELDS_DATA, [
             session_id || null,
             timestamp / 1000, // Convert milliseconds to seconds
             'pulse_metrics',
@@ -661,20 +913,182 @@ async function handlePulseMetrics(data) {
     }
 }
 
-// Graceful shutdown
-process.on('SIGINT', () => {
+// Decode a batched telemetry frame into plain records
+function decodeTelemetryFrame(buffer) {
+    if (buffer.length < 3 || buffer.toString('ascii', 0, 2) !== TELEMETRY_FRAME.MAGIC) {
+        throw new Error('Not a telemetry frame');
+    }
+
+    const version = buffer.readUInt8(2);
+    const headerSize = TELEMETRY_FRAME.HEADER_SIZES[version];
+    if (!headerSize) {
+        throw new Error(`Unsupported telemetry frame version ${version}`);
+    }
+    if (buffer.length < headerSize) {
+        throw new Error(`Truncated telemetry frame header (${buffer.length}/${headerSize} bytes)`);
+    }
+
+    const frame = {
+        frame_type: buffer.readUInt8(3),
+        record_count: buffer.readUInt8(4),
+        record_size: buffer.readUInt8(5),
+        sequence: buffer.readUInt16LE(6),
+        base_timestamp: buffer.readUInt32LE(8),
+        base_millis: buffer.readUInt32LE(12),
+        session_id: buffer.toString('ascii', TELEMETRY_FRAME.SESSION_ID_OFFSET, headerSize).replace(/\0+$/, ''),
+        records: []
+    };
+
+    const expectedLength = headerSize + frame.record_count * frame.record_size;
+    if (buffer.length < expectedLength) {
+        throw new Error(`Truncated telemetry frame (${buffer.length}/${expectedLength} bytes)`);
+    }
+
+    for (let i = 0; i < frame.record_count; i++) {
+        const offset = headerSize + i * frame.record_size;
+
+        if (frame.frame_type === TELEMETRY_FRAME.TYPE_HEART_RATE) {
+            const offsetMs = buffer.readUInt16LE(offset);
+            frame.records.push({
+                timestamp_ms: frame.base_timestamp * 1000 + offsetMs,
+                heart_rate: buffer.readUInt16LE(offset + 2) / 10,
+                spo2: buffer.readUInt16LE(offset + 4) / 10,
+                signal_quality: TELEMETRY_QUALITY_NAMES[buffer.readUInt8(offset + 6)] || 'unknown',
+                finger_detected: (buffer.readUInt8(offset + 7) & 0x01) !== 0
+            });
+        } else if (frame.frame_type === TELEMETRY_FRAME.TYPE_MOVEMENT) {
+            const endOffsetMs = buffer.readUInt16LE(offset);
+            const durationMs = buffer.readUInt16LE(offset + 2);
+            frame.records.push({
+                timestamp_ms: frame.base_timestamp * 1000 + endOffsetMs,
+                servo_index: buffer.readUInt8(offset + 4),
+                successful: (buffer.readUInt8(offset + 5) & 0x01) !== 0,
+                start_angle: buffer.readUInt8(offset + 6),
+                target_angle: buffer.readUInt8(offset + 7),
+                actual_angle: buffer.readUInt8(offset + 8),
+                movement_type: TELEMETRY_MOVEMENT_NAMES[buffer.readUInt8(offset + 9)] || 'unknown',
+                smoothness: buffer.readUInt16LE(offset + 10) / 100,
+                start_time: frame.base_millis + endOffsetMs - durationMs,
+                duration_ms: durationMs
+            });
+        }
+    }
+
+    return frame;
+}
+
+// Handle batched telemetry frames (records go to the events row buffer)
+async function handleTelemetryBatch(topic, message) {
+    try {
+        const frame = decodeTelemetryFrame(message);
+        const deviceId = deviceIdFromTopic(topic);
+        const sessionId = frame.session_id || null;
+        const rows = [];
+
+        if (frame.records.length === 0) {
+            return;
+        }
+
+        if (frame.frame_type === TELEMETRY_FRAME.TYPE_HEART_RATE) {
+            frame.records.forEach(record => {
+                rows.push(queueEvent(EVENT_FIELDS_MOVEMENT, [
+                    sessionId,
+                    record.timestamp_ms / 1000,
+                    'heart_rate',
+                    null,
+                    null,
+                    JSON.stringify({
+                        heart_rate: record.heart_rate,
+                        spo2: record.spo2,
+                        signal_quality: record.signal_quality,
+                        finger_detected: record.finger_detected,
+                        device_id: deviceId
+                    }),
+                    null
+                ]));
+            });
+        } else if (frame.frame_type === TELEMETRY_FRAME.TYPE_MOVEMENT) {
+            frame.records.forEach(record => {
+                rows.push(queueEvent(EVENT_FIELDS_MOVEMENT, [
+                    sessionId,
+                    record.timestamp_ms / 1000,
+                    'movement_individual',
+                    `servo_${record.servo_index}`,
+                    record.duration_ms,
+                    JSON.stringify({
+                        servo_index: record.servo_index,
+                        start_time: record.start_time,
+                        start_angle: record.start_angle,
+                        target_angle: record.target_angle,
+                        actual_angle: record.actual_angle,
+                        smoothness: record.smoothness,
+                        movement_type: record.movement_type
+                    }),
+                    record.successful
+                ]));
+            });
+        } else {
+            console.log(`ℹ️  Unhandled telemetry frame type: ${frame.frame_type}`);
+            return;
+        }
+
+        // Records join rows from every other device in the next events batch
+        await Promise.all(rows);
+
+        console.log(`✅ Queued telemetry frame #${frame.sequence} from ${deviceId}: ${frame.records.length} records (${message.length} bytes)`);
+
+        // Emit real-time updates in the same shape as the per-reading JSON messages
+        if (socketClient && socketClient.connected) {
+            frame.records.forEach(record => {
+                if (frame.frame_type === TELEMETRY_FRAME.TYPE_HEART_RATE) {
+                    socketClient.emit('heart_rate', {
+                        device_id: deviceId,
+                        timestamp: record.timestamp_ms,
+                        heart_rate: record.heart_rate,
+                        spo2: record.spo2,
+                        signal_quality: record.signal_quality,
+                        finger_detected: record.finger_detected,
+                        session_id: frame.session_id
+                    });
+                } else {
+                    socketClient.emit('movement_individual', {
+                        device_id: deviceId,
+                        timestamp: Math.floor(record.timestamp_ms / 1000),
+                        event_type: 'movement_individual',
+                        data: { ...record, session_id: frame.session_id }
+                    });
+                }
+            });
+        }
+
+    } catch (error) {
+        console.error('❌ Error processing telemetry frame:', error);
+    }
+}
+
+// Graceful shutdown - buffered rows are written before the pool closes
+async function shutdown() {
     console.log('\n🛑 Shutting down MQTT bridge...');
 
     if (mqttClient) {
         mqttClient.end();
     }
 
+    if (flushTimer) {
+        clearTimeout(flushTimer);
+        flushTimer = null;
+    }
+
     if (dbPool) {
-        dbPool.end();
+        await flushAll();
+        await dbPool.end();
     }
 
     process.exit(0);
-});
+}
+
+process.on('SIGINT', shutdown);
+process.on('SIGTERM', shutdown);  // docker stop
 
 // Start the bridge
 async function start() {
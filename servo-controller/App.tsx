@@ -15,6 +15,16 @@ const SERVICE_UUID = '4fafc201-1fb5-459e-8fcc-c5c9c331914b';
 const CHARACTERISTIC_UUID = 'beb5483e-36e1-4688-b7f5-ea07361b26a8';
 const DEVICE_NAME = 'ESP32_Servo';
 
+// Binary command frames: [0xFE, opcode, sequence], acked by notification
+const COMMAND_FRAME_MARKER = 0xFE;
+const FRAME_OPCODES: { [command: string]: number } = { '0': 0x00, '1': 0x01, '2': 0x02 };
+let commandSequence = 0;
+
+const encodeCommandFrame = (opcode: number): string => {
+  commandSequence = (commandSequence + 1) & 0xFF;
+  return btoa(String.fromCharCode(COMMAND_FRAME_MARKER, opcode, commandSequence));
+};
+
 // Session management types
 interface SessionState {
   isActive: boolean;
@@ -354,10 +364,17 @@ export default function App() {
       }
 
       if (characteristic) {
-        // Convert string to base64 without Buffer
-        const base64Command = btoa(command);
-        console.log(`Sending command: "${command}" as base64: "${base64Command}"`);
-        await characteristic.writeWithResponse(base64Command);
+        if (command in FRAME_OPCODES) {
+          // Movement commands go as a binary frame without a write response
+          const frame = encodeCommandFrame(FRAME_OPCODES[command]);
+          console.log(`Sending command: "${command}" as frame #${commandSequence}: "${frame}"`);
+          await characteristic.writeWithoutResponse(frame);
+        } else {
+          // Convert string to base64 without Buffer
+          const base64Command = btoa(command);
+          console.log(`Sending command: "${command}" as base64: "${base64Command}"`);
+          await characteristic.writeWithResponse(base64Command);
+        }
         console.log(`Command sent successfully: ${command}`);
 
         // Track movement commands in session
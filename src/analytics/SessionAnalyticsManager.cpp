@@ -1,6 +1,9 @@
 #include "SessionAnalyticsManager.h"
 #include "../utils/Logger.h"
 #include "../utils/ErrorHandler.h"
+#include "../hardware/TaskTracer.h"
+#include "../hardware/I2CManager.h"
+#include "../hardware/ResourceProfiler.h"
 
 void SessionAnalyticsManager::initialize() {
     if (initialized) return;
@@ -10,7 +13,11 @@ void SessionAnalyticsManager::initialize() {
     taskRunning = false;
     taskHandle = nullptr;
     analyticsQueue = nullptr;
-    currentSessionId = "";
+    currentSessionId.clear();
+    currentSessionMetrics = {};
+    currentProgressData = {};
+    currentProgressData.progressIndicators = "";
+    currentProgressData.qualityTrend = "";
     newAnalyticsAvailable = false;
     processedEvents = 0;
     queuedEvents = 0;
@@ -18,18 +25,10 @@ void SessionAnalyticsManager::initialize() {
     processingTimeTotal = 0;
     processingCount = 0;
     activeSessionCount = 0;
-    movementHistoryIndex = 0;
     analyticsCallback = nullptr;
     
-    // Initialize session data
-    for (int i = 0; i < 5; i++) {
-        activeSessions[i] = {};
-    }
-    
-    // Initialize movement history
-    for (int i = 0; i < 50; i++) {
-        recentMovements[i] = {};
-    }
+    // Initialize session table
+    memset(&sessions, 0, sizeof(sessions));
     
     // Create analytics queue
     analyticsQueue = xQueueCreate(ANALYTICS_QUEUE_SIZE, sizeof(AnalyticsEvent));
@@ -72,7 +71,7 @@ void SessionAnalyticsManager::startTask() {
     BaseType_t result = xTaskCreatePinnedToCore(
         sessionAnalyticsTask,
         "SessionAnalytics",
-        TASK_STACK_SESSION_ANALYTICS,
+        ResourceProfiler::getStackSize(ProfiledTask::SESSION_ANALYTICS),
         this,
         PRIORITY_SESSION_ANALYTICS,
         &taskHandle,
@@ -104,15 +103,20 @@ bool SessionAnalyticsManager::isTaskRunning() {
 void SessionAnalyticsManager::sessionAnalyticsTask(void* parameter) {
     SessionAnalyticsManager* manager = (SessionAnalyticsManager*)parameter;
     Logger::info("Session Analytics task started");
+
+    TraceId traceId = TaskTracer::registerTask("Analytics", ANALYTICS_PROCESSING_INTERVAL * 1000);
     
     while (manager->taskRunning) {
+        int64_t traceStart = TaskTracer::begin(traceId);
+
         // Process analytics queue
         manager->processAnalyticsQueue();
         
         // Update real-time metrics
-        if (manager->currentSessionId.length() > 0) {
-            manager->generateSessionQuality(manager->currentSessionId);
-            manager->generateClinicalProgress(manager->currentSessionId);
+        int slot = manager->findSession(manager->currentSessionId);
+        if (slot >= 0) {
+            manager->updateSessionQuality(slot);
+            manager->updateClinicalProgress(slot);
         }
         
         // Publish analytics if new data available
@@ -123,6 +127,7 @@ void SessionAnalyticsManager::sessionAnalyticsTask(void* parameter) {
         
         // Feed watchdog (when FreeRTOS Manager is re-enabled)
         // FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
+        TaskTracer::end(traceId, traceStart);
         
         // Analytics processing runs every 100ms for responsiveness
         vTaskDelay(pdMS_TO_TICKS(ANALYTICS_PROCESSING_INTERVAL));
@@ -141,7 +146,7 @@ void SessionAnalyticsManager::processMovementData(const MovementAnalytics& movem
     event.type = AnalyticsEventType::MOVEMENT_INDIVIDUAL;
     event.sessionId = movement.sessionId;
     event.timestamp = millis();
-    event.movement = new MovementAnalytics(movement);
+    event.data.movement = movement;
 
     queueAnalyticsEvent(event);
 }
@@ -149,7 +154,7 @@ void SessionAnalyticsManager::processMovementData(const MovementAnalytics& movem
 void SessionAnalyticsManager::processSessionStart(const String& sessionId) {
     AnalyticsEvent event;
     event.type = AnalyticsEventType::SESSION_START;
-    event.sessionId = sessionId;
+    event.sessionId.set(sessionId.c_str());
     event.timestamp = millis();
     // No additional data needed for session start
 
@@ -159,9 +164,33 @@ void SessionAnalyticsManager::processSessionStart(const String& sessionId) {
 void SessionAnalyticsManager::processSessionEnd(const String& sessionId, unsigned long duration) {
     AnalyticsEvent event;
     event.type = AnalyticsEventType::SESSION_END;
-    event.sessionId = sessionId;
+    event.sessionId.set(sessionId.c_str());
     event.timestamp = millis();
-    // Duration could be stored in a simple field if needed
+    event.data.sessionDuration = duration;
+
+    queueAnalyticsEvent(event);
+}
+
+void SessionAnalyticsManager::processFusedData(const FusedSensorData& frame, const String& sessionId) {
+    AnalyticsEvent event;
+    event.type = AnalyticsEventType::SENSOR_FUSION;
+    event.sessionId.set(sessionId.c_str());
+    event.timestamp = frame.timestamp;
+
+    FusedSensorSummary& sensors = event.data.sensors;
+    sensors.pulseValid = frame.pulse.valid;
+    sensors.heartRate = frame.pulse.heartRate;
+    sensors.motionValid = frame.motion.valid;
+    sensors.movementIntensity = frame.motion.movementIntensity;
+    sensors.pressureValid = false;
+    sensors.gripForce = 0.0f;
+    for (int i = 0; i < SENSOR_FUSION_PRESSURE_CHANNELS; i++) {
+        if (frame.pressure[i].valid) {
+            sensors.pressureValid = true;
+            sensors.gripForce += frame.pressure[i].force;
+        }
+    }
+    sensors.overallQuality = frame.overallQuality;
 
     queueAnalyticsEvent(event);
 }
@@ -217,6 +246,10 @@ void SessionAnalyticsManager::processEvent(const AnalyticsEvent& event) {
         case AnalyticsEventType::CLINICAL_PROGRESS:
             handleProgressUpdate(event);
             break;
+
+        case AnalyticsEventType::SENSOR_FUSION:
+            handleSensorFusion(event);
+            break;
             
         default:
             Logger::warningf("Unknown analytics event type: %d", (int)event.type);
@@ -265,31 +298,55 @@ ClinicalProgressData SessionAnalyticsManager::getClinicalProgress(const String&
 }
 
 void SessionAnalyticsManager::generateSessionQuality(const String& sessionId) {
-    SessionData* session = findSession(sessionId);
-    if (!session || !session->active) return;
-    
-    currentSessionMetrics.sessionId = sessionId;
-    currentSessionMetrics.overallQuality = calculateOverallQuality(sessionId);
-    currentSessionMetrics.averageSmoothness = calculateAverageSmoothness(sessionId);
-    currentSessionMetrics.successRate = calculateSuccessRate(sessionId);
-    currentSessionMetrics.totalMovements = session->totalMovements;
-    currentSessionMetrics.successfulMovements = session->successfulMovements;
-    currentSessionMetrics.totalDuration = session->totalDuration;
+    AnalyticsSessionId id;
+    id.set(sessionId.c_str());
+
+    int slot = findSession(id);
+    if (slot >= 0) {
+        updateSessionQuality(slot);
+    }
+}
+
+void SessionAnalyticsManager::generateClinicalProgress(const String& sessionId) {
+    AnalyticsSessionId id;
+    id.set(sessionId.c_str());
+
+    int slot = findSession(id);
+    if (slot >= 0) {
+        updateClinicalProgress(slot);
+    }
+}
+
+void SessionAnalyticsManager::updateSessionQuality(int slot) {
+    int totalMovements = sessions.totalMovements[slot];
+
+    currentSessionMetrics.sessionId = sessions.sessionId[slot];
+    currentSessionMetrics.overallQuality = calculateOverallQuality(slot);
+    currentSessionMetrics.averageSmoothness = calculateAverageSmoothness(slot);
+    currentSessionMetrics.smoothnessStdDev = calculateSmoothnessStdDev(slot);
+    currentSessionMetrics.successRate = calculateSuccessRate(slot);
+    currentSessionMetrics.totalMovements = totalMovements;
+    currentSessionMetrics.successfulMovements = sessions.successfulMovements[slot];
+    currentSessionMetrics.totalDuration = sessions.totalDuration[slot];
     
-    if (session->totalMovements > 0) {
-        currentSessionMetrics.averageMovementTime = session->totalDuration / session->totalMovements;
+    if (totalMovements > 0) {
+        currentSessionMetrics.averageMovementTime = sessions.totalDuration[slot] / totalMovements;
     } else {
         currentSessionMetrics.averageMovementTime = 0;
     }
+
+    currentSessionMetrics.averageHeartRate = sessions.heartRateMean[slot];
+    currentSessionMetrics.averageMotionIntensity = sessions.motionIntensityMean[slot];
+    currentSessionMetrics.peakGripForce = sessions.peakGripForce[slot];
     
     newAnalyticsAvailable = true;
 }
 
-void SessionAnalyticsManager::generateClinicalProgress(const String& sessionId) {
-    currentProgressData.sessionId = sessionId;
-    currentProgressData.progressScore = calculateProgressScore(sessionId);
-    currentProgressData.progressIndicators = generateProgressIndicators(sessionId);
-    currentProgressData.qualityTrend = analyzeQualityTrend(sessionId);
+void SessionAnalyticsManager::updateClinicalProgress(int slot) {
+    currentProgressData.sessionId = sessions.sessionId[slot];
+    currentProgressData.progressScore = calculateProgressScore(slot);
+    currentProgressData.progressIndicators = generateProgressIndicators(slot);
+    currentProgressData.qualityTrend = analyzeQualityTrend(slot);
     
     // Calculate improvement (simplified)
     currentProgressData.improvementPercent = currentProgressData.progressScore * 100.0f;
@@ -329,128 +386,162 @@ void SessionAnalyticsManager::setAnalyticsCallback(void (*callback)(const Analyt
 void SessionAnalyticsManager::handleSessionStart(const AnalyticsEvent& event) {
     Logger::infof("Analytics: Session started - %s", event.sessionId.c_str());
 
-    SessionData* session = createSession(event.sessionId);
-    if (session) {
-        session->startTime = event.timestamp;
-        session->active = true;
+    int slot = createSession(event.sessionId);
+    if (slot >= 0) {
+        sessions.startTime[slot] = event.timestamp;
         currentSessionId = event.sessionId;
     }
 }
 
 void SessionAnalyticsManager::handleSessionEnd(const AnalyticsEvent& event) {
-    Logger::infof("Analytics: Session ended - %s", event.sessionId.c_str());
+    Logger::infof("Analytics: Session ended - %s (%lu ms)",
+                  event.sessionId.c_str(), event.data.sessionDuration);
 
-    SessionData* session = findSession(event.sessionId);
-    if (session) {
-        session->endTime = event.timestamp;
-        session->active = false;
+    int slot = findSession(event.sessionId);
+    if (slot >= 0) {
+        sessions.endTime[slot] = event.timestamp;
 
         // Generate final analytics
-        generateSessionQuality(event.sessionId);
-        generateClinicalProgress(event.sessionId);
+        updateSessionQuality(slot);
+        updateClinicalProgress(slot);
 
         // Remove from active sessions
-        removeSession(event.sessionId);
+        removeSession(slot);
     }
 
-    if (currentSessionId == event.sessionId) {
-        currentSessionId = "";
+    if (currentSessionId.equals(event.sessionId)) {
+        currentSessionId.clear();
     }
 }
 
 void SessionAnalyticsManager::handleMovementData(const AnalyticsEvent& event) {
-    if (!event.movement) return;
-
-    const MovementAnalytics& movement = *event.movement;
+    const MovementAnalytics& movement = event.data.movement;
+    int slot = findSession(movement.sessionId);
 
     // Update session metrics
-    updateSessionMetrics(movement.sessionId, movement);
-
-    // Add to movement history
-    addMovementToHistory(movement);
+    updateSessionMetrics(slot, movement);
 
     // Calculate and update real-time quality
     updateRealTimeMetrics(movement);
 
-    Logger::debugf("Analytics: Movement processed - Servo %d, Quality %.2f",
+    LOG_DEBUGF("Analytics: Movement processed - Servo %d, Quality %.2f",
                   movement.servoIndex, calculateMovementQuality(movement));
 }
 
 void SessionAnalyticsManager::handleQualityUpdate(const AnalyticsEvent& event) {
     // Handle quality update events
-    Logger::debug("Analytics: Quality update processed");
+    LOG_DEBUG("Analytics: Quality update processed");
 }
 
 void SessionAnalyticsManager::handleProgressUpdate(const AnalyticsEvent& event) {
     // Handle progress update events
-    Logger::debug("Analytics: Progress update processed");
+    LOG_DEBUG("Analytics: Progress update processed");
+}
+
+void SessionAnalyticsManager::handleSensorFusion(const AnalyticsEvent& event) {
+    int slot = findSession(event.sessionId);
+    if (slot < 0) return;
+
+    const FusedSensorSummary& sensors = event.data.sensors;
+
+    // Running means, same cost for any session length
+    if (sensors.pulseValid && sensors.heartRate > 0) {
+        uint32_t n = ++sessions.heartRateSamples[slot];
+        sessions.heartRateMean[slot] += (sensors.heartRate - sessions.heartRateMean[slot]) / n;
+    }
+
+    if (sensors.motionValid) {
+        uint32_t n = ++sessions.motionSamples[slot];
+        sessions.motionIntensityMean[slot] += (sensors.movementIntensity - sessions.motionIntensityMean[slot]) / n;
+    }
+
+    if (sensors.pressureValid && sensors.gripForce > sessions.peakGripForce[slot]) {
+        sessions.peakGripForce[slot] = sensors.gripForce;
+    }
 }
 
 // =============================================================================
 // SESSION MANAGEMENT
 // =============================================================================
 
-SessionAnalyticsManager::SessionData* SessionAnalyticsManager::findSession(const String& sessionId) {
-    for (int i = 0; i < 5; i++) {
-        if (activeSessions[i].sessionId == sessionId && activeSessions[i].active) {
-            return &activeSessions[i];
+int SessionAnalyticsManager::findSession(const AnalyticsSessionId& sessionId) {
+    if (sessionId.isEmpty()) return -1;
+
+    for (int i = 0; i < ANALYTICS_MAX_SESSIONS; i++) {
+        if ((sessions.activeMask & (1 << i)) && sessions.sessionId[i].equals(sessionId)) {
+            return i;
         }
     }
-    return nullptr;
+    return -1;
 }
 
-SessionAnalyticsManager::SessionData* SessionAnalyticsManager::createSession(const String& sessionId) {
+int SessionAnalyticsManager::createSession(const AnalyticsSessionId& sessionId) {
     // Find empty slot
-    for (int i = 0; i < 5; i++) {
-        if (!activeSessions[i].active) {
-            activeSessions[i] = {};
-            activeSessions[i].sessionId = sessionId;
-            activeSessions[i].active = true;
+    for (int i = 0; i < ANALYTICS_MAX_SESSIONS; i++) {
+        if (!(sessions.activeMask & (1 << i))) {
+            sessions.sessionId[i] = sessionId;
+            sessions.startTime[i] = 0;
+            sessions.endTime[i] = 0;
+            sessions.totalDuration[i] = 0;
+            sessions.totalMovements[i] = 0;
+            sessions.successfulMovements[i] = 0;
+            sessions.smoothnessMean[i] = 0.0f;
+            sessions.smoothnessM2[i] = 0.0f;
+            sessions.qualityMean[i] = 0.0f;
+            sessions.qualityEwma[i] = 0.0f;
+            sessions.heartRateSamples[i] = 0;
+            sessions.heartRateMean[i] = 0.0f;
+            sessions.motionSamples[i] = 0;
+            sessions.motionIntensityMean[i] = 0.0f;
+            sessions.peakGripForce[i] = 0.0f;
+            sessions.activeMask |= (1 << i);
             activeSessionCount++;
-            return &activeSessions[i];
+            return i;
         }
     }
 
     Logger::warning("No available session slots");
-    return nullptr;
+    return -1;
 }
 
-void SessionAnalyticsManager::removeSession(const String& sessionId) {
-    for (int i = 0; i < 5; i++) {
-        if (activeSessions[i].sessionId == sessionId) {
-            activeSessions[i] = {};
-            activeSessionCount--;
-            break;
-        }
-    }
+void SessionAnalyticsManager::removeSession(int slot) {
+    if (!(sessions.activeMask & (1 << slot))) return;
+
+    sessions.activeMask &= ~(1 << slot);
+    sessions.sessionId[slot].clear();
+    activeSessionCount--;
 }
 
-void SessionAnalyticsManager::updateSessionMetrics(const String& sessionId, const MovementAnalytics& movement) {
-    SessionData* session = findSession(sessionId);
-    if (!session) return;
+void SessionAnalyticsManager::updateSessionMetrics(int slot, const MovementAnalytics& movement) {
+    if (slot < 0) return;
 
-    session->totalMovements++;
+    uint16_t count = ++sessions.totalMovements[slot];
     if (movement.successful) {
-        session->successfulMovements++;
+        sessions.successfulMovements[slot]++;
     }
-    session->totalSmoothness += movement.smoothness;
-    session->totalDuration += movement.duration;
-}
+    sessions.totalDuration[slot] += movement.duration;
 
-void SessionAnalyticsManager::addMovementToHistory(const MovementAnalytics& movement) {
-    MovementHistory& history = recentMovements[movementHistoryIndex];
-    history.timestamp = millis();
-    history.quality = calculateMovementQuality(movement);
-    history.smoothness = movement.smoothness;
-    history.successful = movement.successful;
-    history.sessionId = movement.sessionId;
+    // Welford update of smoothness mean and variance
+    float delta = movement.smoothness - sessions.smoothnessMean[slot];
+    sessions.smoothnessMean[slot] += delta / count;
+    sessions.smoothnessM2[slot] += delta * (movement.smoothness - sessions.smoothnessMean[slot]);
 
-    movementHistoryIndex = (movementHistoryIndex + 1) % 50;
+    // Quality: session mean plus an EWMA of recent movements for the trend
+    float quality = calculateMovementQuality(movement);
+    sessions.qualityMean[slot] += (quality - sessions.qualityMean[slot]) / count;
+    if (count == 1) {
+        sessions.qualityEwma[slot] = quality;
+    } else {
+        sessions.qualityEwma[slot] += QUALITY_TREND_ALPHA * (quality - sessions.qualityEwma[slot]);
+    }
 }
 
 void SessionAnalyticsManager::updateRealTimeMetrics(const MovementAnalytics& movement) {
     // Update real-time session metrics
-    generateSessionQuality(movement.sessionId);
+    int slot = findSession(movement.sessionId);
+    if (slot >= 0) {
+        updateSessionQuality(slot);
+    }
     newAnalyticsAvailable = true;
 }
 
@@ -458,38 +549,41 @@ void SessionAnalyticsManager::updateRealTimeMetrics(const MovementAnalytics& mov
 // ANALYTICS CALCULATIONS
 // =============================================================================
 
-float SessionAnalyticsManager::calculateOverallQuality(const String& sessionId) {
-    SessionData* session = findSession(sessionId);
-    if (!session || session->totalMovements == 0) return 0.0f;
+float SessionAnalyticsManager::calculateOverallQuality(int slot) {
+    int totalMovements = sessions.totalMovements[slot];
+    if (totalMovements == 0) return 0.0f;
 
-    float successRate = (float)session->successfulMovements / session->totalMovements;
-    float averageSmoothness = session->totalSmoothness / session->totalMovements;
+    float successRate = (float)sessions.successfulMovements[slot] / totalMovements;
 
     // Combine success rate (60%) and smoothness (40%)
-    return (successRate * 0.6f) + (averageSmoothness * 0.4f);
+    return (successRate * 0.6f) + (sessions.smoothnessMean[slot] * 0.4f);
+}
+
+float SessionAnalyticsManager::calculateAverageSmoothness(int slot) {
+    return sessions.smoothnessMean[slot];
 }
 
-float SessionAnalyticsManager::calculateAverageSmoothness(const String& sessionId) {
-    SessionData* session = findSession(sessionId);
-    if (!session || session->totalMovements == 0) return 0.0f;
+float SessionAnalyticsManager::calculateSmoothnessStdDev(int slot) {
+    int totalMovements = sessions.totalMovements[slot];
+    if (totalMovements < 2) return 0.0f;
 
-    return session->totalSmoothness / session->totalMovements;
+    return sqrtf(sessions.smoothnessM2[slot] / (totalMovements - 1));
 }
 
-float SessionAnalyticsManager::calculateSuccessRate(const String& sessionId) {
-    SessionData* session = findSession(sessionId);
-    if (!session || session->totalMovements == 0) return 0.0f;
+float SessionAnalyticsManager::calculateSuccessRate(int slot) {
+    int totalMovements = sessions.totalMovements[slot];
+    if (totalMovements == 0) return 0.0f;
 
-    return (float)session->successfulMovements / session->totalMovements;
+    return (float)sessions.successfulMovements[slot] / totalMovements;
 }
 
-float SessionAnalyticsManager::calculateProgressScore(const String& sessionId) {
+float SessionAnalyticsManager::calculateProgressScore(int slot) {
     // Simplified progress calculation based on current session quality
-    return calculateOverallQuality(sessionId);
+    return calculateOverallQuality(slot);
 }
 
-String SessionAnalyticsManager::generateProgressIndicators(const String& sessionId) {
-    float quality = calculateOverallQuality(sessionId);
+const char* SessionAnalyticsManager::generateProgressIndicators(int slot) {
+    float quality = calculateOverallQuality(slot);
 
     if (quality >= QUALITY_EXCELLENT_THRESHOLD) {
         return "Excellent progress, maintaining high quality";
@@ -500,43 +594,34 @@ String SessionAnalyticsManager::generateProgressIndicators(const String& session
     }
 }
 
-String SessionAnalyticsManager::analyzeQualityTrend(const String& sessionId) {
-    // Simplified trend analysis
-    float recentTrend = getRecentQualityTrend(sessionId);
+const char* SessionAnalyticsManager::analyzeQualityTrend(int slot) {
+    float recentTrend = getRecentQualityTrend(slot);
 
-    if (recentTrend > 0.1f) {
+    if (recentTrend > QUALITY_TREND_THRESHOLD) {
         return "Improving";
-    } else if (recentTrend < -0.1f) {
+    } else if (recentTrend < -QUALITY_TREND_THRESHOLD) {
         return "Declining";
     } else {
         return "Stable";
     }
 }
 
-float SessionAnalyticsManager::getRecentQualityTrend(const String& sessionId) {
-    // Calculate trend from recent movements
-    float totalQuality = 0.0f;
-    int count = 0;
-
-    for (int i = 0; i < 50; i++) {
-        if (recentMovements[i].sessionId == sessionId) {
-            totalQuality += recentMovements[i].quality;
-            count++;
-        }
-    }
+float SessionAnalyticsManager::getRecentQualityTrend(int slot) {
+    // Recent movements compared with the session as a whole
+    if (sessions.totalMovements[slot] == 0) return 0.0f;
 
-    return count > 0 ? totalQuality / count : 0.0f;
+    return sessions.qualityEwma[slot] - sessions.qualityMean[slot];
 }
 
-void SessionAnalyticsManager::publishAnalytics(const String& sessionId) {
+void SessionAnalyticsManager::publishAnalytics(const AnalyticsSessionId& sessionId) {
     // Publish session quality metrics
     publishSessionQuality(currentSessionMetrics);
 
     // Publish clinical progress data
     publishClinicalProgress(currentProgressData);
 
-    Logger::debugf("Published analytics for session: %s", sessionId.c_str());
-    Logger::debugf("Quality: %.2f, Success Rate: %.2f, Progress: %.2f",
+    LOG_DEBUGF("Published analytics for session: %s", sessionId.c_str());
+    LOG_DEBUGF("Quality: %.2f, Success Rate: %.2f, Progress: %.2f",
                   currentSessionMetrics.overallQuality,
                   currentSessionMetrics.successRate,
                   currentProgressData.progressScore);
@@ -545,22 +630,25 @@ void SessionAnalyticsManager::publishAnalytics(const String& sessionId) {
 void SessionAnalyticsManager::publishSessionQuality(const SessionQualityMetrics& quality) {
     // This would integrate with MQTT Manager to publish session quality
     // For now, just log the quality metrics
-    Logger::debugf("Session Quality - Overall: %.2f, Smoothness: %.2f, Success Rate: %.2f",
-                  quality.overallQuality, quality.averageSmoothness, quality.successRate);
+    LOG_DEBUGF("Session Quality - Overall: %.2f, Smoothness: %.2f (sd %.2f), Success Rate: %.2f",
+                  quality.overallQuality, quality.averageSmoothness, quality.smoothnessStdDev,
+                  quality.successRate);
+    LOG_DEBUGF("Session Sensors - Heart Rate: %.1f, Motion: %.2f, Peak Grip: %.1f N",
+                  quality.averageHeartRate, quality.averageMotionIntensity, quality.peakGripForce);
 }
 
 void SessionAnalyticsManager::publishClinicalProgress(const ClinicalProgressData& progress) {
     // This would integrate with MQTT Manager to publish clinical progress
     // For now, just log the progress data
-    Logger::debugf("Clinical Progress - Score: %.2f, Trend: %s, Indicators: %s",
-                  progress.progressScore, progress.qualityTrend.c_str(), progress.progressIndicators.c_str());
+    LOG_DEBUGF("Clinical Progress - Score: %.2f, Trend: %s, Indicators: %s",
+                  progress.progressScore, progress.qualityTrend, progress.progressIndicators);
 }
 
 void SessionAnalyticsManager::publishMovementQuality(const MovementAnalytics& movement) {
     // This would integrate with MQTT Manager to publish movement quality
     // For now, just log the movement quality
     float quality = calculateMovementQuality(movement);
-    Logger::debugf("Movement Quality - Servo %d: %.2f (Smoothness: %.2f, Success: %s)",
+    LOG_DEBUGF("Movement Quality - Servo %d: %.2f (Smoothness: %.2f, Success: %s)",
                   movement.servoIndex, quality, movement.smoothness,
                   movement.successful ? "Yes" : "No");
 }
@@ -5,6 +5,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/queue.h>
+#include <type_traits>
 #include "../config/Config.h"
 
 enum class AnalyticsEventType {
@@ -14,64 +15,114 @@ enum class AnalyticsEventType {
     MOVEMENT_INDIVIDUAL,
     MOVEMENT_QUALITY,
     CLINICAL_PROGRESS,
-    PERFORMANCE_UPDATE
+    PERFORMANCE_UPDATE,
+    SENSOR_FUSION
+};
+
+struct FusedSensorData;
+
+const size_t ANALYTICS_MOVEMENT_TYPE_SIZE = 16;
+const int ANALYTICS_MAX_SESSIONS = 5;            // Concurrently tracked sessions
+
+// Fixed-size session identifier, so analytics events stay trivially copyable
+struct AnalyticsSessionId {
+    char value[ANALYTICS_SESSION_ID_SIZE];
+
+    void set(const char* id) {
+        // strnlen + memcpy rather than strncpy, which warns about the truncation it exists to do
+        const char* source = id ? id : "";
+        size_t length = strnlen(source, sizeof(value) - 1);
+        memcpy(value, source, length);
+        value[length] = '\0';
+    }
+
+    void clear() {
+        value[0] = '\0';
+    }
+
+    bool isEmpty() const {
+        return value[0] == '\0';
+    }
+
+    bool equals(const AnalyticsSessionId& other) const {
+        return strncmp(value, other.value, sizeof(value)) == 0;
+    }
+
+    const char* c_str() const {
+        return value;
+    }
 };
 
 struct MovementAnalytics {
-    int servoIndex;
     unsigned long startTime;
     unsigned long duration;
+    int16_t startAngle;
+    int16_t targetAngle;
+    int16_t actualAngle;
+    uint8_t servoIndex;
     bool successful;
-    int startAngle;
-    int targetAngle;
-    int actualAngle;
     float smoothness;
-    String movementType;
-    String sessionId;
+    char movementType[ANALYTICS_MOVEMENT_TYPE_SIZE];
+    AnalyticsSessionId sessionId;
 };
 
 struct SessionQualityMetrics {
-    String sessionId;
+    AnalyticsSessionId sessionId;
     float overallQuality;
     float averageSmoothness;
+    float smoothnessStdDev;
     float successRate;
     int totalMovements;
     int successfulMovements;
     unsigned long totalDuration;
     unsigned long averageMovementTime;
+    float averageHeartRate;        // From fused sensor frames, 0 without pulse data
+    float averageMotionIntensity;
+    float peakGripForce;           // Newtons, summed over pressure channels
+};
+
+// The parts of a FusedSensorData frame session analytics keeps
+struct FusedSensorSummary {
+    float heartRate;          // Valid when pulseValid
+    float movementIntensity;  // Valid when motionValid
+    float gripForce;          // Valid when pressureValid
+    float overallQuality;
+    bool pulseValid;
+    bool motionValid;
+    bool pressureValid;
 };
 
 struct ClinicalProgressData {
-    String sessionId;
+    AnalyticsSessionId sessionId;
     float progressScore;
-    String progressIndicators;
+    const char* progressIndicators;  // Static text
     float improvementPercent;
     int consecutiveSuccessfulSessions;
     unsigned long sessionDuration;
-    String qualityTrend;
+    const char* qualityTrend;        // Static text
 };
 
+/**
+ * Analytics queue item. Plain data with the payload selected by type, so the
+ * FreeRTOS queue's byte copy is the whole ownership story - nothing to free.
+ */
 struct AnalyticsEvent {
     AnalyticsEventType type;
-    String sessionId;
+    AnalyticsSessionId sessionId;
     unsigned long timestamp;
 
-    // Use separate optional fields instead of union
-    MovementAnalytics* movement;
-    SessionQualityMetrics* quality;
-    ClinicalProgressData* progress;
-
-    // Constructor
-    AnalyticsEvent() : movement(nullptr), quality(nullptr), progress(nullptr) {}
-
-    // Destructor
-    ~AnalyticsEvent() {
-        delete movement;
-        delete quality;
-        delete progress;
-    }
+    union {
+        MovementAnalytics movement;      // MOVEMENT_INDIVIDUAL
+        SessionQualityMetrics quality;   // MOVEMENT_QUALITY
+        ClinicalProgressData progress;   // CLINICAL_PROGRESS
+        unsigned long sessionDuration;   // SESSION_END
+        FusedSensorSummary sensors;      // SENSOR_FUSION
+    } data;
 };
 
+static_assert(std::is_trivially_copyable<AnalyticsEvent>::value,
+              "AnalyticsEvent is passed through a FreeRTOS queue by value");
+
 class SessionAnalyticsManager {
 public:
     // Initialization and lifecycle
@@ -89,6 +140,7 @@ public:
     void processSessionEnd(const String& sessionId, unsigned long duration);
     void generateSessionQuality(const String& sessionId);
     void generateClinicalProgress(const String& sessionId);
+    void processFusedData(const FusedSensorData& frame, const String& sessionId);
     
     // Queue-based event processing
     bool queueAnalyticsEvent(const AnalyticsEvent& event);
@@ -102,7 +154,7 @@ public:
     
     // Real-time analytics
     void updateRealTimeMetrics(const MovementAnalytics& movement);
-    void publishAnalytics(const String& sessionId);
+    void publishAnalytics(const AnalyticsSessionId& sessionId);
     bool hasNewAnalytics();
     void clearNewAnalytics();
     
@@ -121,7 +173,7 @@ private:
     QueueHandle_t analyticsQueue;
     
     // Analytics state
-    String currentSessionId;
+    AnalyticsSessionId currentSessionId;
     SessionQualityMetrics currentSessionMetrics;
     ClinicalProgressData currentProgressData;
     bool newAnalyticsAvailable;
@@ -133,33 +185,31 @@ private:
     uint32_t processingTimeTotal;
     uint32_t processingCount;
     
-    // Session tracking
-    struct SessionData {
-        String sessionId;
-        unsigned long startTime;
-        unsigned long endTime;
-        int totalMovements;
-        int successfulMovements;
-        float totalSmoothness;
-        unsigned long totalDuration;
-        bool active;
+    // Session tracking - one column per field, indexed by session slot.
+    // Every aggregate is a running value updated once per movement, so
+    // quality and progress reads cost the same for any session length.
+    struct SessionTable {
+        AnalyticsSessionId sessionId[ANALYTICS_MAX_SESSIONS];
+        unsigned long startTime[ANALYTICS_MAX_SESSIONS];
+        unsigned long endTime[ANALYTICS_MAX_SESSIONS];
+        unsigned long totalDuration[ANALYTICS_MAX_SESSIONS];
+        uint16_t totalMovements[ANALYTICS_MAX_SESSIONS];
+        uint16_t successfulMovements[ANALYTICS_MAX_SESSIONS];
+        float smoothnessMean[ANALYTICS_MAX_SESSIONS];    // Welford running mean
+        float smoothnessM2[ANALYTICS_MAX_SESSIONS];      // Welford sum of squared deviations
+        float qualityMean[ANALYTICS_MAX_SESSIONS];       // Mean movement quality
+        float qualityEwma[ANALYTICS_MAX_SESSIONS];       // Recent movement quality
+        uint32_t heartRateSamples[ANALYTICS_MAX_SESSIONS];
+        float heartRateMean[ANALYTICS_MAX_SESSIONS];     // Over fused frames with valid pulse
+        uint32_t motionSamples[ANALYTICS_MAX_SESSIONS];
+        float motionIntensityMean[ANALYTICS_MAX_SESSIONS];
+        float peakGripForce[ANALYTICS_MAX_SESSIONS];
+        uint8_t activeMask;  // Bit n = slot n in use
     };
     
-    SessionData activeSessions[5]; // Support up to 5 concurrent sessions
+    SessionTable sessions;
     int activeSessionCount;
     
-    // Movement history for trend analysis
-    struct MovementHistory {
-        unsigned long timestamp;
-        float quality;
-        float smoothness;
-        bool successful;
-        String sessionId;
-    };
-    
-    MovementHistory recentMovements[50]; // Keep last 50 movements
-    int movementHistoryIndex;
-    
     // Task function
     static void sessionAnalyticsTask(void* parameter);
     
@@ -173,25 +223,26 @@ private:
     void handleMovementData(const AnalyticsEvent& event);
     void handleQualityUpdate(const AnalyticsEvent& event);
     void handleProgressUpdate(const AnalyticsEvent& event);
+    void handleSensorFusion(const AnalyticsEvent& event);
     
-    // Analytics calculations
-    float calculateOverallQuality(const String& sessionId);
-    float calculateAverageSmoothness(const String& sessionId);
-    float calculateSuccessRate(const String& sessionId);
-    float calculateProgressScore(const String& sessionId);
-    String generateProgressIndicators(const String& sessionId);
-    String analyzeQualityTrend(const String& sessionId);
+    // Analytics calculations (by session slot)
+    float calculateOverallQuality(int slot);
+    float calculateAverageSmoothness(int slot);
+    float calculateSuccessRate(int slot);
+    float calculateProgressScore(int slot);
+    const char* generateProgressIndicators(int slot);
+    const char* analyzeQualityTrend(int slot);
+    void updateSessionQuality(int slot);
+    void updateClinicalProgress(int slot);
     
     // Session management
-    SessionData* findSession(const String& sessionId);
-    SessionData* createSession(const String& sessionId);
-    void removeSession(const String& sessionId);
-    void updateSessionMetrics(const String& sessionId, const MovementAnalytics& movement);
+    int findSession(const AnalyticsSessionId& sessionId);
+    int createSession(const AnalyticsSessionId& sessionId);
+    void removeSession(int slot);
+    void updateSessionMetrics(int slot, const MovementAnalytics& movement);
     
-    // Movement history management
-    void addMovementToHistory(const MovementAnalytics& movement);
-    float getRecentQualityTrend(const String& sessionId);
-    int getRecentSuccessCount(const String& sessionId);
+    float calculateSmoothnessStdDev(int slot);
+    float getRecentQualityTrend(int slot);
     
     // Publishing helpers
     void publishSessionQuality(const SessionQualityMetrics& quality);
@@ -205,6 +256,8 @@ private:
     static constexpr float QUALITY_GOOD_THRESHOLD = 0.7f;
     static constexpr float SMOOTHNESS_EXCELLENT_THRESHOLD = 0.85f;
     static constexpr float SUCCESS_RATE_EXCELLENT_THRESHOLD = 0.95f;
+    static constexpr float QUALITY_TREND_ALPHA = 0.2f;      // EWMA weight of the newest movement
+    static constexpr float QUALITY_TREND_THRESHOLD = 0.1f;  // Recent vs session mean quality
 };
 
 #endif
@@ -0,0 +1,81 @@
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include "../config/Config.h"
+
+// =============================================================================
+// COMMAND REPRESENTATION
+// =============================================================================
+
+enum class CommandSource : uint8_t {
+    BLE,
+    MQTT,
+    SERIAL_PORT,
+    INTERNAL
+};
+
+enum class CommandType : uint8_t {
+    MOVEMENT,
+    SYSTEM,
+    CONFIGURATION,
+    DIAGNOSTIC,
+    UNKNOWN
+};
+
+enum class CommandOpcode : uint8_t {
+    NONE,           // Empty, unknown keyword or out-of-range movement code
+    HOME,           // "0"
+    SEQUENTIAL,     // "1"
+    SIMULTANEOUS,   // "2"
+    FINGER_TAPPING, // "3" - exercise library (ExerciseLibrary.h)
+    GRADED_GRASP,   // "4"
+    WAVE,           // "5"
+    STATUS,
+    INFO,
+    STATS,
+    RESTART,
+    RESET,
+    RECOVER,
+    END_SESSION,
+    CONFIG,
+    SET,
+    TEST,
+    DIAG,
+    RESOURCE_PROFILE  // "profile [on|off|apply|revert|reset|report]" (ResourceProfiler.h)
+};
+
+/**
+ * A text command parsed once where it arrives (BLE write, serial line)
+ * and handed on by value from there: no String members, so it copies with
+ * memcpy through FreeRTOS queues and ring buffers and never touches the
+ * heap. The keyword becomes the opcode; up to COMMAND_MAX_ARGUMENTS
+ * integer tokens after it ("set rate 10" -> 10) are kept in arguments.
+ * text keeps the trimmed original for logs and telemetry.
+ */
+struct Command {
+    CommandType type;
+    CommandOpcode opcode;
+    CommandSource source;
+    bool isValid;
+    int8_t commandCode;     // Movement code (0-MOVEMENT_COMMAND_MAX), -1 for other commands
+    uint8_t argumentCount;
+    int32_t arguments[COMMAND_MAX_ARGUMENTS];
+    uint32_t timestamp;     // millis() when parsed
+    char text[DEVICE_COMMAND_MAX_LENGTH];
+};
+
+static_assert(std::is_trivially_copyable<Command>::value, "Command must be copyable with memcpy");
+static_assert((uint8_t)CommandOpcode::WAVE - (uint8_t)CommandOpcode::HOME == MOVEMENT_COMMAND_MAX,
+              "Movement opcodes must run in movement code order");
+
+// One executed command in the history ring - the text is not kept
+struct __attribute__((packed)) CommandHistoryEntry {
+    uint32_t timestamp;     // millis() when parsed
+    CommandOpcode opcode;
+    CommandSource source;
+    bool success;
+};
+
+#endif
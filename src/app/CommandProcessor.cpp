@@ -37,43 +37,110 @@ void CommandProcessor::initialize() {
     Logger::info("Command Processor initialized");
 }
 
-Command CommandProcessor::parseCommand(const String& rawCommand, CommandSource source) {
-    Command cmd;
-    cmd.rawCommand = rawCommand;
-    cmd.source = source;
-    cmd.timestamp = TimeManager::getCurrentTimestamp();
-    cmd.isValid = false;
-    cmd.parameters = "";
-
-    // Trim whitespace
-    String trimmed = rawCommand;
-    trimmed.trim();
-
-    if (trimmed.length() == 0) {
-        cmd.type = CommandType::UNKNOWN;
-        cmd.commandCode = -1;
-        return cmd;
+struct CommandKeyword {
+    const char* keyword;
+    CommandOpcode opcode;
+    CommandType type;
+};
+
+static const CommandKeyword COMMAND_KEYWORDS[] = {
+    {"status", CommandOpcode::STATUS, CommandType::SYSTEM},
+    {"info", CommandOpcode::INFO, CommandType::SYSTEM},
+    {"stats", CommandOpcode::STATS, CommandType::SYSTEM},
+    {"restart", CommandOpcode::RESTART, CommandType::SYSTEM},
+    {"reset", CommandOpcode::RESET, CommandType::SYSTEM},
+    {"recover", CommandOpcode::RECOVER, CommandType::SYSTEM},
+    {"end_session", CommandOpcode::END_SESSION, CommandType::SYSTEM},
+    {"profile", CommandOpcode::RESOURCE_PROFILE, CommandType::SYSTEM},
+    {"config", CommandOpcode::CONFIG, CommandType::CONFIGURATION},
+    {"set", CommandOpcode::SET, CommandType::CONFIGURATION},
+    {"test", CommandOpcode::TEST, CommandType::DIAGNOSTIC},
+    {"diag", CommandOpcode::DIAG, CommandType::DIAGNOSTIC}
+};
+
+static bool isArgumentSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == ':' || c == '=';
+}
+
+bool CommandProcessor::parseCommand(const char* text, CommandSource source, Command& command) {
+    memset(&command, 0, sizeof(command));
+    command.type = CommandType::UNKNOWN;
+    command.opcode = CommandOpcode::NONE;
+    command.source = source;
+    command.commandCode = -1;
+    command.timestamp = millis();
+
+    if (!text) return false;
+
+    // Trimmed copy into the fixed buffer - the only copy of the text there is
+    while (isspace((unsigned char)*text)) text++;
+    size_t length = 0;
+    while (text[length] && length < sizeof(command.text) - 1) {
+        command.text[length] = text[length];
+        length++;
     }
+    bool truncated = text[length] != '\0';
+    while (length > 0 && isspace((unsigned char)command.text[length - 1])) length--;
+    command.text[length] = '\0';
+
+    if (length == 0 || truncated) return false;
+
+    if (length == 1 && isDigit(command.text[0])) {
+        // Single digit movement command
+        command.type = CommandType::MOVEMENT;
+        command.commandCode = (int8_t)(command.text[0] - '0');
+        command.isValid = validateMovementCommand(command.commandCode);
+        if (command.isValid) {
+            command.opcode = (CommandOpcode)((uint8_t)CommandOpcode::HOME + command.commandCode);
+        }
+    } else {
+        size_t keywordLength = 0;
+        while (keywordLength < length && !isArgumentSeparator(command.text[keywordLength])) keywordLength++;
 
-    // Determine command type
-    cmd.type = determineCommandType(trimmed);
+        if (lookupKeyword(command.text, keywordLength, command.opcode, command.type)) {
+            parseArguments(command.text + keywordLength, command);
+        }
+        command.isValid = validateCommand(command);
+    }
 
-    // Parse command code for movement commands
-    if (cmd.type == CommandType::MOVEMENT) {
-        cmd.commandCode = trimmed.toInt();
-        cmd.isValid = validateMovementCommand(cmd.commandCode);
-    } else {
-        cmd.commandCode = -1;
-        cmd.isValid = validateCommand(cmd);
+    LOG_DEBUGF("Parsed command: '%s' -> Type: %s, Opcode: %u, Code: %d, Args: %u, Valid: %s",
+               command.text,
+               commandTypeToString(command.type),
+               (unsigned)command.opcode,
+               command.commandCode,
+               (unsigned)command.argumentCount,
+               command.isValid ? "Yes" : "No");
+
+    return command.isValid;
+}
+
+bool CommandProcessor::lookupKeyword(const char* keyword, size_t length, CommandOpcode& opcode,
+                                     CommandType& type) {
+    for (const CommandKeyword& entry : COMMAND_KEYWORDS) {
+        if (strncasecmp(keyword, entry.keyword, length) == 0 && entry.keyword[length] == '\0') {
+            opcode = entry.opcode;
+            type = entry.type;
+            return true;
+        }
     }
+    return false;
+}
 
-    Logger::debugf("Parsed command: '%s' -> Type: %s, Code: %d, Valid: %s",
-                  rawCommand.c_str(),
-                  commandTypeToString(cmd.type).c_str(),
-                  cmd.commandCode,
-                  cmd.isValid ? "Yes" : "No");
+void CommandProcessor::parseArguments(const char* cursor, Command& command) {
+    // Integer tokens only; anything else stays readable in text
+    while (*cursor && command.argumentCount < COMMAND_MAX_ARGUMENTS) {
+        while (isArgumentSeparator(*cursor)) cursor++;
+        if (!*cursor) break;
 
-    return cmd;
+        char* end = nullptr;
+        long value = strtol(cursor, &end, 10);
+        if (end != cursor && (*end == '\0' || isArgumentSeparator(*end))) {
+            command.arguments[command.argumentCount++] = (int32_t)value;
+            cursor = end;
+        } else {
+            while (*cursor && !isArgumentSeparator(*cursor)) cursor++;
+        }
+    }
 }
 
 bool CommandProcessor::validateCommand(const Command& command) {
@@ -81,7 +148,7 @@ bool CommandProcessor::validateCommand(const Command& command) {
         case CommandType::MOVEMENT:
             return validateMovementCommand(command.commandCode);
         case CommandType::SYSTEM:
-            return validateSystemCommand(command.rawCommand);
+            return validateSystemCommand(command);
         case CommandType::CONFIGURATION:
         case CommandType::DIAGNOSTIC:
             return true;  // Basic validation for now
@@ -132,9 +199,9 @@ bool CommandProcessor::executeCommand(const Command& command) {
 
         if (success) {
             Logger::infof("Command executed successfully in %lu ms: %s",
-                         executionTime, command.rawCommand.c_str());
+                         executionTime, command.text);
         } else {
-            Logger::warningf("Command execution failed: %s", command.rawCommand.c_str());
+            Logger::warningf("Command execution failed: %s", command.text);
         }
 
         // Notify via callback
@@ -151,20 +218,19 @@ bool CommandProcessor::executeCommand(const Command& command) {
     return success;
 }
 
-bool CommandProcessor::queueCommand(const String& rawCommand, CommandSource source) {
+bool CommandProcessor::queueCommand(const Command& command) {
     if (isQueueFull()) {
         Logger::warning("Command queue full - dropping command");
         return false;
     }
 
-    Command cmd = parseCommand(rawCommand, source);
-    if (!cmd.isValid) {
-        logError(cmd, "Invalid command - not queued");
+    if (!command.isValid) {
+        logError(command, "Invalid command - not queued");
         return false;
     }
 
-    addToQueue(cmd);
-    Logger::debugf("Command queued: %s (Queue size: %d)", rawCommand.c_str(), queueSize);
+    addToQueue(command);
+    LOG_DEBUGF("Command queued: %s (Queue size: %d)", command.text, queueSize);
 
     return true;
 }
@@ -173,12 +239,13 @@ bool CommandProcessor::hasQueuedCommands() {
     return !isQueueEmpty();
 }
 
-Command CommandProcessor::getNextCommand() {
+bool CommandProcessor::getNextCommand(Command& command) {
     if (isQueueEmpty()) {
-        return {};  // Return empty command
+        return false;
     }
 
-    return removeFromQueue();
+    removeFromQueue(command);
+    return true;
 }
 
 void CommandProcessor::clearCommandQueue() {
@@ -206,13 +273,14 @@ void CommandProcessor::recordCommand(const Command& command, bool success) {
     logCommand(command, success);
 }
 
-Command CommandProcessor::getLastCommand() {
+bool CommandProcessor::getLastCommand(CommandHistoryEntry& entry) {
     if (historyCount > 0) {
         int lastIndex = (historyIndex - 1 + MAX_HISTORY_SIZE) % MAX_HISTORY_SIZE;
-        return commandHistory[lastIndex];
+        entry = commandHistory[lastIndex];
+        return true;
     }
 
-    return {};  // Return empty command
+    return false;
 }
 
 int CommandProcessor::getCommandCount() {
@@ -244,7 +312,7 @@ void CommandProcessor::setCommandCallback(void (*callback)(const Command& comman
     commandCallback = callback;
 }
 
-void CommandProcessor::setErrorCallback(void (*callback)(const Command& command, const String& error)) {
+void CommandProcessor::setErrorCallback(void (*callback)(const Command& command, const char* error)) {
     errorCallback = callback;
 }
 
@@ -266,40 +334,13 @@ void CommandProcessor::logStatistics() {
     Logger::infof("  Queue Size: %d", queueSize);
 }
 
-CommandType CommandProcessor::determineCommandType(const String& command) {
-    // Check if it's a numeric movement command
-    if (command.length() == 1 && isDigit(command.charAt(0))) {
-        return CommandType::MOVEMENT;
-    }
-
-    // Check for system commands
-    String lower = command;
-    lower.toLowerCase();
-
-    if (lower.startsWith("status") || lower.startsWith("info") ||
-        lower.startsWith("restart") || lower.startsWith("reset") ||
-        lower.startsWith("end_session") || lower == "end_session") {
-        return CommandType::SYSTEM;
-    }
-
-    if (lower.startsWith("config") || lower.startsWith("set")) {
-        return CommandType::CONFIGURATION;
-    }
-
-    if (lower.startsWith("test") || lower.startsWith("diag")) {
-        return CommandType::DIAGNOSTIC;
-    }
-
-    return CommandType::UNKNOWN;
-}
-
 bool CommandProcessor::validateMovementCommand(int commandCode) {
-    return (commandCode >= 0 && commandCode <= 2);
+    return (commandCode >= 0 && commandCode <= MOVEMENT_COMMAND_MAX);
 }
 
-bool CommandProcessor::validateSystemCommand(const String& command) {
-    // Basic validation for system commands
-    return command.length() > 0 && command.length() < 50;
+bool CommandProcessor::validateSystemCommand(const Command& command) {
+    // Only known keywords get a system opcode
+    return command.opcode != CommandOpcode::NONE;
 }
 
 bool CommandProcessor::executeMovementCommand(const Command& command) {
@@ -310,30 +351,28 @@ bool CommandProcessor::executeMovementCommand(const Command& command) {
 }
 
 bool CommandProcessor::executeSystemCommand(const Command& command) {
-    String lower = command.rawCommand;
-    lower.toLowerCase();
-
-    if (lower == "status") {
-        Logger::info("System status requested");
-        return true;
-    } else if (lower == "restart") {
-        Logger::warning("System restart requested");
-        return true;
-    } else if (lower == "end_session") {
-        Logger::info("Session end requested");
-        return true;
+    switch (command.opcode) {
+        case CommandOpcode::STATUS:
+            Logger::info("System status requested");
+            return true;
+        case CommandOpcode::RESTART:
+            Logger::warning("System restart requested");
+            return true;
+        case CommandOpcode::END_SESSION:
+            Logger::info("Session end requested");
+            return true;
+        default:
+            return false;
     }
-
-    return false;
 }
 
 bool CommandProcessor::executeConfigurationCommand(const Command& command) {
-    Logger::infof("Configuration command: %s", command.rawCommand.c_str());
+    Logger::infof("Configuration command: %s", command.text);
     return true;
 }
 
 bool CommandProcessor::executeDiagnosticCommand(const Command& command) {
-    Logger::infof("Diagnostic command: %s", command.rawCommand.c_str());
+    Logger::infof("Diagnostic command: %s", command.text);
     return true;
 }
 
@@ -353,23 +392,23 @@ void CommandProcessor::addToQueue(const Command& command) {
     }
 }
 
-Command CommandProcessor::removeFromQueue() {
+void CommandProcessor::removeFromQueue(Command& command) {
     if (isQueueEmpty()) {
-        return {};
+        return;
     }
 
-    Command cmd = commandQueue[queueHead];
+    command = commandQueue[queueHead];
     queueHead = (queueHead + 1) % MAX_QUEUE_SIZE;
     queueSize--;
-
-    return cmd;
 }
 
 void CommandProcessor::addToHistory(const Command& command, bool success) {
-    Command historyEntry = command;
-    // Add success flag to history entry (we could extend Command struct for this)
+    CommandHistoryEntry& entry = commandHistory[historyIndex];
+    entry.timestamp = command.timestamp;
+    entry.opcode = command.opcode;
+    entry.source = command.source;
+    entry.success = success;
 
-    commandHistory[historyIndex] = historyEntry;
     historyIndex = (historyIndex + 1) % MAX_HISTORY_SIZE;
 
     if (historyCount < MAX_HISTORY_SIZE) {
@@ -400,21 +439,21 @@ void CommandProcessor::updateRateLimit(CommandSource source) {
 
 void CommandProcessor::logCommand(const Command& command, bool success) {
     Logger::infof("Command %s: %s [%s] -> %s",
-                 commandSourceToString(command.source).c_str(),
-                 command.rawCommand.c_str(),
-                 commandTypeToString(command.type).c_str(),
+                 commandSourceToString(command.source),
+                 command.text,
+                 commandTypeToString(command.type),
                  success ? "SUCCESS" : "FAILED");
 }
 
-void CommandProcessor::logError(const Command& command, const String& error) {
-    Logger::errorf("Command error: %s - %s", command.rawCommand.c_str(), error.c_str());
+void CommandProcessor::logError(const Command& command, const char* error) {
+    Logger::errorf("Command error: %s - %s", command.text, error);
 
     if (errorCallback) {
         errorCallback(command, error);
     }
 }
 
-String CommandProcessor::commandSourceToString(CommandSource source) {
+const char* CommandProcessor::commandSourceToString(CommandSource source) {
     switch (source) {
         case CommandSource::BLE: return "BLE";
         case CommandSource::MQTT: return "MQTT";
@@ -424,7 +463,7 @@ String CommandProcessor::commandSourceToString(CommandSource source) {
     }
 }
 
-String CommandProcessor::commandTypeToString(CommandType type) {
+const char* CommandProcessor::commandTypeToString(CommandType type) {
     switch (type) {
         case CommandType::MOVEMENT: return "MOVEMENT";
         case CommandType::SYSTEM: return "SYSTEM";
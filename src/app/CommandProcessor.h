@@ -2,52 +2,28 @@
 #define COMMAND_PROCESSOR_H
 
 #include <Arduino.h>
-
-enum class CommandSource {
-    BLE,
-    MQTT,
-    SERIAL_PORT,
-    INTERNAL
-};
-
-enum class CommandType {
-    MOVEMENT,
-    SYSTEM,
-    CONFIGURATION,
-    DIAGNOSTIC,
-    UNKNOWN
-};
-
-struct Command {
-    String rawCommand;
-    CommandType type;
-    CommandSource source;
-    int commandCode;
-    String parameters;
-    unsigned long timestamp;
-    bool isValid;
-};
+#include "Command.h"
 
 class CommandProcessor {
 public:
     // Initialization
     void initialize();
 
-    // Command processing
-    Command parseCommand(const String& rawCommand, CommandSource source);
-    bool validateCommand(const Command& command);
+    // Command processing - parseCommand is reentrant, so producers on any task can call it
+    static bool parseCommand(const char* text, CommandSource source, Command& command);
+    static bool validateCommand(const Command& command);
     bool executeCommand(const Command& command);
 
     // Command queue management
-    bool queueCommand(const String& rawCommand, CommandSource source);
+    bool queueCommand(const Command& command);
     bool hasQueuedCommands();
-    Command getNextCommand();
+    bool getNextCommand(Command& command);
     void clearCommandQueue();
     int getQueueSize();
 
     // Command history
     void recordCommand(const Command& command, bool success);
-    Command getLastCommand();
+    bool getLastCommand(CommandHistoryEntry& entry);
     int getCommandCount();
     int getSuccessfulCommandCount();
     int getFailedCommandCount();
@@ -58,7 +34,7 @@ public:
 
     // Callbacks
     void setCommandCallback(void (*callback)(const Command& command, bool success));
-    void setErrorCallback(void (*callback)(const Command& command, const String& error));
+    void setErrorCallback(void (*callback)(const Command& command, const char* error));
 
     // Statistics
     unsigned long getLastCommandTime();
@@ -66,8 +42,8 @@ public:
     void logStatistics();
 
     // Utility methods (public for DeviceManager access)
-    String commandSourceToString(CommandSource source);
-    String commandTypeToString(CommandType type);
+    static const char* commandSourceToString(CommandSource source);
+    static const char* commandTypeToString(CommandType type);
 
 private:
     bool initialized;
@@ -79,9 +55,9 @@ private:
     int queueTail;
     int queueSize;
 
-    // Command history
+    // Command history (packed ring, opcode and outcome only)
     static const int MAX_HISTORY_SIZE = 20;
-    Command commandHistory[MAX_HISTORY_SIZE];
+    CommandHistoryEntry commandHistory[MAX_HISTORY_SIZE];
     int historyIndex;
     int historyCount;
 
@@ -97,12 +73,13 @@ private:
 
     // Callbacks
     void (*commandCallback)(const Command& command, bool success);
-    void (*errorCallback)(const Command& command, const String& error);
+    void (*errorCallback)(const Command& command, const char* error);
 
     // Internal methods
-    CommandType determineCommandType(const String& command);
-    bool validateMovementCommand(int commandCode);
-    bool validateSystemCommand(const String& command);
+    static bool lookupKeyword(const char* keyword, size_t length, CommandOpcode& opcode, CommandType& type);
+    static void parseArguments(const char* cursor, Command& command);
+    static bool validateMovementCommand(int commandCode);
+    static bool validateSystemCommand(const Command& command);
     bool executeMovementCommand(const Command& command);
     bool executeSystemCommand(const Command& command);
     bool executeConfigurationCommand(const Command& command);
@@ -112,7 +89,7 @@ private:
     bool isQueueFull();
     bool isQueueEmpty();
     void addToQueue(const Command& command);
-    Command removeFromQueue();
+    void removeFromQueue(Command& command);
 
     // History management
     void addToHistory(const Command& command, bool success);
@@ -121,13 +98,9 @@ private:
     bool checkRateLimit(CommandSource source);
     void updateRateLimit(CommandSource source);
 
-    // Validation helpers
-    bool isValidCommandCode(int code);
-    bool isValidParameter(const String& param);
-
     // Logging
     void logCommand(const Command& command, bool success);
-    void logError(const Command& command, const String& error);
+    void logError(const Command& command, const char* error);
 
     // Utility (moved to public section above)
 };
@@ -1,6 +1,8 @@
 #include "DeviceManager.h"
+#include <esp_timer.h>
 #include "../config/Config.h"
 #include "CommandProcessor.h"
+#include "../hardware/ResourceProfiler.h"
 
 // Static instance for callbacks
 DeviceManager* DeviceManager::instance = nullptr;
@@ -18,79 +20,57 @@ void DeviceManager::initialize() {
     lastStatusReport = 0;
     statusReportInterval = DEFAULT_STATUS_INTERVAL;
     lastUpdate = 0;
+    lastFusedPublish = 0;
     loopStartTime = 0;
     totalLoopTime = 0;
     loopCount = 0;
+    streamVitals.store(0);
+    pendingCycles.store(0);
+    pendingBLEConnected.store(false);
+    serialLineLength = 0;
     stateChangeCallback = nullptr;
     taskHandle = nullptr;
     taskRunning = false;
 
-    // Initialize in phases
+    bootCompletePending.store(false);
+    bootTimingPending = false;
+    bootReadyUs = 0;
+
+    // Queues and utilities every stage relies on
     if (!initializeFoundation()) {
         setState(DeviceState::ERROR);
         return;
     }
 
-    // Communication initialization (WiFi/MQTT) is optional for basic operation
-    initializeCommunication();  // Don't fail if this doesn't work
-
-    if (!initializeHardware()) {
-        setState(DeviceState::ERROR);
-        return;
-    }
+    startBootStages();
 
-    if (!initializeApplication()) {
+    // Commands are accepted once servos, the command path and BLE are up;
+    // the I2C sensors and WiFi/MQTT keep initializing behind the running system
+    bool ready = bootScheduler.waitFor(BOOT_COMMAND_PATH, pdMS_TO_TICKS(BOOT_READY_TIMEOUT_MS));
+    if (!ready || !bootScheduler.succeeded(BOOT_REQUIRED_FOR_COMMANDS)) {
+        Logger::error(ready ? "Servo or command initialization failed"
+                            : "Command path not up within BOOT_READY_TIMEOUT_MS");
         setState(DeviceState::ERROR);
         return;
     }
 
     initialized = true;
+    bootReadyUs = (uint32_t)esp_timer_get_time();
     setState(DeviceState::READY);
 
-    Logger::info("Device ready for BLE commands (WiFi/MQTT optional)");
-
     // Start the DeviceManager coordination task
     startTask();
 
+    Logger::infof("Device ready for BLE commands after %u ms (sensors and WiFi/MQTT still starting)",
+                  (unsigned)(bootReadyUs / 1000));
     Logger::info("=== Device Manager Initialization Complete ===");
-    logSystemSummary();
 }
 
 void DeviceManager::update() {
     if (!initialized) return;
 
-    loopStartTime = millis();
-
-    // Update all components
-    updateCommunication();
-    updateHardware();
-    updateApplication();
-    updateMonitoring();
-
-    // Process any queued commands
-    processQueuedCommands();
-
-    // Periodic status reporting
-    unsigned long now = millis();
-    if (now - lastStatusReport >= statusReportInterval) {
-        publishSystemStatus();
-        lastStatusReport = now;
-    }
-
-    // Check system health
-    checkSystemHealth();
-
-    // Record performance metrics
-    unsigned long loopTime = millis() - loopStartTime;
-    totalLoopTime += loopTime;
-    loopCount++;
-    systemMonitor.recordLoopTime(loopTime);
-
-    if (loopTime > MAX_LOOP_TIME) {
-        Logger::warningf("Long loop time detected: %lu ms", loopTime);
-    }
-
-    lastUpdate = now;
+    // The task only handles what woke it; a direct call checks every source
+    processEvents(EVENT_ALL);
 }
 
 void DeviceManager::shutdown() {
@@ -101,6 +81,10 @@ void DeviceManager::shutdown() {
     setState(DeviceState::MAINTENANCE);
 
     // Shutdown components in reverse order
+    sessionRecorder.shutdown();
+    pressureSensorManager.shutdown();
+    motionSensorManager.shutdown();
+    sensorFusion.shutdown();
     servoController.shutdown();
     bleManager.shutdown();
     mqttManager.disconnect();
@@ -157,10 +141,26 @@ SessionAnalyticsManager& DeviceManager::getSessionAnalyticsManager() {
     return sessionAnalyticsManager;
 }
 
+SessionRecorder& DeviceManager::getSessionRecorder() {
+    return sessionRecorder;
+}
+
 PulseMonitorManager& DeviceManager::getPulseMonitorManager() {
     return pulseMonitorManager;
 }
 
+MotionSensorManager& DeviceManager::getMotionSensorManager() {
+    return motionSensorManager;
+}
+
+PressureSensorManager& DeviceManager::getPressureSensorManager() {
+    return pressureSensorManager;
+}
+
+SensorFusion& DeviceManager::getSensorFusion() {
+    return sensorFusion;
+}
+
 CommandProcessor& DeviceManager::getCommandProcessor() {
     return commandProcessor;
 }
@@ -169,9 +169,15 @@ SessionManager& DeviceManager::getSessionManager() {
     return sessionManager;
 }
 
-bool DeviceManager::handleCommand(const String& command, CommandSource source) {
-    Logger::infof("DeviceManager::handleCommand called - Command: '%s', Source: %d, State: %d",
-                 command.c_str(), (int)source, (int)currentState);
+bool DeviceManager::handleCommand(const char* text, CommandSource source) {
+    Command command;
+    CommandProcessor::parseCommand(text, source, command);
+    return dispatchCommand(command);
+}
+
+bool DeviceManager::dispatchCommand(const Command& command) {
+    Logger::infof("DeviceManager::dispatchCommand called - Command: '%s', Source: %d, State: %d",
+                 command.text, (int)command.source, (int)currentState);
 
     // Allow BLE commands even if WiFi/MQTT not ready, but require basic initialization
     if (currentState == DeviceState::INITIALIZING) {
@@ -181,10 +187,7 @@ bool DeviceManager::handleCommand(const String& command, CommandSource source) {
 
     if (currentState == DeviceState::ERROR) {
         // Allow RESET command even in error state for recovery
-        String trimmedCommand = command;
-        trimmedCommand.trim();
-
-        if (trimmedCommand.equalsIgnoreCase("RESET") || trimmedCommand.equalsIgnoreCase("RECOVER")) {
+        if (command.opcode == CommandOpcode::RESET || command.opcode == CommandOpcode::RECOVER) {
             Logger::info("Recovery command received - attempting to exit error state");
 
             // Clear any critical errors that might be stuck
@@ -207,52 +210,77 @@ bool DeviceManager::handleCommand(const String& command, CommandSource source) {
     }
 
     Logger::infof("Received command from %s: %s",
-                 commandProcessor.commandSourceToString(source).c_str(),
-                 command.c_str());
-
-    // Parse and validate command
-    Logger::info("Parsing command...");
-    Command cmd = commandProcessor.parseCommand(command, source);
-    Logger::infof("Command parsed - Valid: %s, Type: %d, Code: %d",
-                 cmd.isValid ? "YES" : "NO", (int)cmd.type, cmd.commandCode);
+                 CommandProcessor::commandSourceToString(command.source), command.text);
+    Logger::infof("Command parsed - Valid: %s, Type: %d, Opcode: %u, Code: %d",
+                 command.isValid ? "YES" : "NO", (int)command.type, (unsigned)command.opcode,
+                 command.commandCode);
 
-    if (!cmd.isValid) {
-        Logger::warningf("Invalid command: %s", command.c_str());
+    if (!command.isValid) {
+        Logger::warningf("Invalid command: %s", command.text);
         return false;
     }
 
     // Execute command immediately or queue it
-    if (cmd.type == CommandType::MOVEMENT && servoController.isBusy()) {
-        // Queue movement commands if servo is busy
-        return commandProcessor.queueCommand(command, source);
+    if (command.type == CommandType::MOVEMENT && !servoController.acceptsCommand(command.commandCode)) {
+        // Queue movement commands if servo is busy (homing interrupts instead)
+        return commandProcessor.queueCommand(command);
     } else {
         // Execute immediately based on command type
         bool success = false;
-        if (cmd.type == CommandType::MOVEMENT) {
-            success = executeMovementCommand(cmd);
-        } else if (cmd.type == CommandType::SYSTEM) {
-            success = executeSystemCommand(cmd);
+        if (command.type == CommandType::MOVEMENT) {
+            success = executeMovementCommand(command);
+        } else if (command.type == CommandType::SYSTEM) {
+            success = executeSystemCommand(command);
         } else {
-            success = commandProcessor.executeCommand(cmd);
+            success = commandProcessor.executeCommand(command);
         }
         return success;
     }
 }
 
 void DeviceManager::processQueuedCommands() {
-    // Process one queued command per update cycle to avoid blocking
-    if (commandProcessor.hasQueuedCommands() && !servoController.isBusy()) {
-        Command cmd = commandProcessor.getNextCommand();
-        if (cmd.isValid) {
-            if (cmd.type == CommandType::MOVEMENT) {
-                executeMovementCommand(cmd);
-            } else {
-                commandProcessor.executeCommand(cmd);
-            }
+    // Process one queued command per pass to avoid blocking
+    Command command;
+    if (!servoController.isBusy() && commandProcessor.getNextCommand(command) && command.isValid) {
+        if (command.type == CommandType::MOVEMENT) {
+            executeMovementCommand(command);
+        } else {
+            commandProcessor.executeCommand(command);
         }
     }
 }
 
+bool DeviceManager::postCommand(const char* text, CommandSource source) {
+    QueueHandle_t queue = FreeRTOSManager::getDeviceCommandQueue();
+    if (!queue || !text) return false;
+
+    size_t length = strnlen(text, DEVICE_COMMAND_MAX_LENGTH);
+    if (length >= DEVICE_COMMAND_MAX_LENGTH) {
+        Logger::warning("Command too long - ignored");
+        return false;
+    }
+
+    // Parsed here, once - the DeviceManager task only dispatches
+    Command command;
+    CommandProcessor::parseCommand(text, source, command);
+    if (command.text[0] == '\0') return false;
+
+    bool sent = xQueueSend(queue, &command, 0) == pdTRUE;
+    ResourceProfiler::recordQueueSend(ProfiledQueue::DEVICE_COMMANDS, sent);
+    if (!sent) {
+        Logger::warningf("Command queue full - '%s' dropped", command.text);
+        return false;
+    }
+
+    notifyEvents(EVENT_COMMAND);
+    return true;
+}
+
+void DeviceManager::onSerialReceive() {
+    // Runs on the UART event task - the bytes are read on ours
+    notifyEvents(EVENT_SERIAL);
+}
+
 void DeviceManager::publishSystemStatus() {
     if (!mqttManager.isConnected()) return;
 
@@ -282,7 +310,7 @@ void DeviceManager::publishSystemStatus() {
     );
 
     if (success) {
-        Logger::debug("System status published");
+        LOG_DEBUG("System status published");
     }
 
     // Publish enhanced system health data
@@ -316,22 +344,16 @@ void DeviceManager::setStateChangeCallback(void (*callback)(DeviceState oldState
 }
 
 bool DeviceManager::initializeFoundation() {
-    Logger::info("Phase 1: Initializing Foundation...");
+    Logger::info("Initializing Foundation...");
 
     // Initialize FreeRTOS infrastructure first
+    ResourceProfiler::logStatus();
     Logger::info("Initializing FreeRTOS Manager with memory optimization...");
     if (!FreeRTOSManager::initialize()) {
         Logger::error("Failed to initialize FreeRTOS Manager");
         return false;
     }
 
-    // Initialize I2C Manager for sensor communication
-    Logger::info("Initializing I2C Manager...");
-    if (!I2CManager::initialize()) {
-        Logger::error("Failed to initialize I2C Manager");
-        return false;
-    }
-
     // Initialize core utilities
     TimeManager::initialize();
     ErrorHandler::initialize();
@@ -341,47 +363,86 @@ bool DeviceManager::initializeFoundation() {
     return true;
 }
 
-bool DeviceManager::initializeCommunication() {
-    Logger::info("Phase 2: Initializing Communication...");
+void DeviceManager::startBootStages() {
+    // Stage ids are the order of addition (BootStageId). Each core runs its
+    // stages in that order: core 1 brings up servos and the command path
+    // before the I2C bus scan and sensor resets, core 0 starts BLE as soon
+    // as the servos it commands exist and the WiFi/MQTT drivers after it
+    bootScheduler.addStage("servos", [](void* context) {
+        return static_cast<DeviceManager*>(context)->initializeHardware();
+    }, this, 0, CORE_APPLICATION);
 
-    // CRITICAL: Check heap before communication initialization
-    size_t heapBefore = ESP.getFreeHeap();
-    Logger::infof("Free heap before communication init: %u bytes", heapBefore);
+    bootScheduler.addStage("application", [](void* context) {
+        return static_cast<DeviceManager*>(context)->initializeApplication();
+    }, this, 0, CORE_APPLICATION);
 
-    // Initialize WiFi
-    Logger::info("Initializing WiFi Manager...");
-    wifiManager.initialize();
-    wifiManager.setConnectionCallback(onWiFiConnectionChange);
+    bootScheduler.addStage("i2c", [](void* context) {
+        return I2CManager::initialize();
+    }, this, 0, CORE_APPLICATION);
 
-    // Initialize MQTT
-    Logger::info("Initializing MQTT Manager...");
-    mqttManager.initialize();
-    mqttManager.setConnectionCallback(onMQTTConnectionChange);
+    bootScheduler.addStage("sensors", [](void* context) {
+        return static_cast<DeviceManager*>(context)->initializeSensors();
+    }, this, BootScheduler::maskOf(BOOT_I2C) | BootScheduler::maskOf(BOOT_SERVOS), CORE_APPLICATION);
+
+    bootScheduler.addStage("ble", [](void* context) {
+        return static_cast<DeviceManager*>(context)->initializeBLE();
+    }, this, BootScheduler::maskOf(BOOT_SERVOS), CORE_PROTOCOL);
+
+    // No dependency on BLE, so a BLE failure doesn't keep the network down
+    bootScheduler.addStage("network", [](void* context) {
+        return static_cast<DeviceManager*>(context)->initializeNetwork();
+    }, this, 0, CORE_PROTOCOL);
 
-    // CRITICAL: Initialize BLE with Static Memory (must be last for optimal memory layout)
+    bootScheduler.setCompletionCallback(onBootComplete, this);
+
+    if (!bootScheduler.start()) {
+        Logger::warning("Boot stages partly ran inline - boot is slower than usual");
+    }
+}
+
+bool DeviceManager::initializeBLE() {
+    // CRITICAL: BLE with static memory; its controller comes up before WiFi's
+    // so the two radio drivers never initialize at the same time
     Logger::info("Initializing BLE Manager with Static Memory...");
     size_t heapBeforeBLE = ESP.getFreeHeap();
-    Logger::infof("Free heap before BLE init: %u bytes", heapBeforeBLE);
 
     bleManager.initialize();
     bleManager.setConnectionCallback(onBLEConnectionChange);
     bleManager.setCommandCallback(onBLECommandReceived);
+    bleManager.setFastCommandCallback(onBLEFastCommand);
+    bleManager.setStreamSampleProvider(onStreamSample);
 
-    // Verify BLE static memory health after initialization
+    // Approximate - the core 1 stages allocate at the same time
     size_t heapAfterBLE = ESP.getFreeHeap();
     Logger::infof("Free heap after BLE init: %u bytes", heapAfterBLE);
-    Logger::infof("Heap used by BLE: %u bytes", heapBeforeBLE - heapAfterBLE);
+    Logger::infof("Heap used by BLE: ~%d bytes", (int)heapBeforeBLE - (int)heapAfterBLE);
 
-    Logger::info("Communication initialization complete");
+    Logger::info("BLE initialization complete");
+    return true;
+}
+
+bool DeviceManager::initializeNetwork() {
+    // WiFi/MQTT are optional for basic operation, so this stage never fails
+    Logger::info("Initializing WiFi Manager...");
+    wifiManager.initialize();
+    wifiManager.setConnectionCallback(onWiFiConnectionChange);
+
+    Logger::info("Initializing MQTT Manager...");
+    mqttManager.initialize();
+    mqttManager.setConnectionCallback(onMQTTConnectionChange);
+
+    Logger::info("Network initialization complete");
     return true;
 }
 
 bool DeviceManager::initializeHardware() {
-    Logger::info("Phase 3: Initializing Hardware...");
+    Logger::info("Initializing Hardware...");
 
     // Initialize servo controller
     servoController.initialize();
     servoController.setMovementCompleteCallback(onServoMovementComplete);
+    servoController.setAnalyticsCallback(onServoAnalytics);
+    servoController.setCommandStartedCallback(onServoCommandStarted);
 
     // Initialize system monitor
     systemMonitor.initialize();
@@ -395,11 +456,14 @@ bool DeviceManager::initializeHardware() {
 }
 
 bool DeviceManager::initializeApplication() {
-    Logger::info("Phase 4: Initializing Application...");
+    Logger::info("Initializing Application...");
 
     // Initialize command processor
     commandProcessor.initialize();
 
+    // Initialize session recorder (keeps session telemetry on flash while offline)
+    sessionRecorder.initialize();
+
     // Initialize session manager
     sessionManager.initialize();
     sessionManager.setSessionStartCallback(onSessionStart);
@@ -409,67 +473,309 @@ bool DeviceManager::initializeApplication() {
     // Initialize session analytics manager
     sessionAnalyticsManager.initialize();
 
+    Logger::info("Application initialization complete");
+    return true;
+}
+
+bool DeviceManager::initializeSensors() {
+    Logger::info("Initializing Sensors...");
+
     // Initialize pulse monitor manager
     Logger::info("About to initialize Pulse Monitor Manager...");
     pulseMonitorManager.initialize();
-    pulseMonitorManager.setReadingCallback(onPulseReading);
+    pulseMonitorManager.setReadingCallback(onPulseReadingQueued);
     Logger::info("Pulse Monitor Manager initialization call completed");
 
-    Logger::info("Application initialization complete");
+    // Initialize sensor fusion (pulse readings are forwarded from onPulseReading)
+    sensorFusion.setFrameCallback(onFusedFrame);
+    sensorFusion.initialize();
+
+    // Initialize motion sensor - feeds fusion and closes the loop on the instrumented joint
+    motionSensorManager.setReadingCallback(onMotionReading);
+    motionSensorManager.initialize();
+    servoController.setAngleFeedbackProvider(onJointAngleFeedback);
+    servoController.setMotionFeedbackStream(&motionSensorManager.getRawStream());
+
+    // Initialize fingertip pressure sensors (ADC DMA, every decimated reading goes to fusion)
+    pressureSensorManager.setReadingCallback(onPressureReading);
+    pressureSensorManager.initialize();
+
+    Logger::info("Sensor initialization complete");
     return true;
 }
 
-void DeviceManager::updateCommunication() {
-    // WiFi Manager now runs in its own FreeRTOS task
-    // wifiManager.update();  // Removed - handled by wifiManagerTask
+void DeviceManager::onBootComplete(void* context) {
+    // Runs on the last boot worker - the summary is logged on the DeviceManager task
+    DeviceManager* manager = static_cast<DeviceManager*>(context);
+    manager->bootCompletePending.store(true);
+    manager->notifyEvents(EVENT_BOOT);
+}
 
-    // MQTT Manager now runs in its own FreeRTOS tasks
-    // mqttManager.update();  // Removed - handled by mqttPublisherTask and mqttSubscriberTask
+void DeviceManager::handleBootComplete() {
+    bootScheduler.logTimings();
+    Logger::infof("Ready for commands at %u ms, all subsystems at %u ms",
+                  (unsigned)(bootReadyUs / 1000),
+                  (unsigned)(bootScheduler.getFinishUs() / 1000));
+
+    // The sensors share the I2C bus; without it the device can't monitor the patient
+    if (!bootScheduler.succeeded(BootScheduler::maskOf(BOOT_I2C))) {
+        Logger::error("Failed to initialize I2C Manager");
+        setState(DeviceState::ERROR);
+    }
 
-    // BLE Manager now runs in its own FreeRTOS task
-    // bleManager.update();  // Removed - handled by bleServerTask
+    bootTimingPending = true;  // Published once MQTT is connected
+    logSystemSummary();
 }
 
-void DeviceManager::updateHardware() {
-    // ServoController now runs in its own FreeRTOS task
-    // servoController.update();  // Removed - handled by servoTask
+// =============================================================================
+// EVENT HANDLING
+// =============================================================================
+
+void DeviceManager::notifyEvents(uint32_t events) {
+    // Bits accumulate until the task wakes, so bursts cost a single pass
+    if (taskHandle) {
+        xTaskNotify(taskHandle, events, eSetBits);
+    }
 }
 
-void DeviceManager::updateApplication() {
-    // SessionManager now runs in its own FreeRTOS task (if needed)
-    // sessionManager.update();  // Removed - minimal timeout checking can be event-driven
+void DeviceManager::processEvents(uint32_t events) {
+    loopStartTime = millis();
+
+    if (events & EVENT_SERIAL) {
+        readSerialInput();
+    }
+
+    if ((events & EVENT_BOOT) && bootCompletePending.exchange(false)) {
+        handleBootComplete();
+    }
+
+    if (events & EVENT_COMMAND) {
+        drainCommandQueue();
+    }
+
+    if (events & EVENT_BLE_CONNECTION) {
+        handleBLEConnection();
+    }
+
+    if (events & EVENT_SERVO_COMPLETE) {
+        handleServoComplete();
+    }
+
+    if (events & EVENT_SESSION) {
+        // Short BLE intervals while a session runs, power saving otherwise
+        SessionState state = sessionManager.getCurrentState();
+        bleManager.setSessionActive(state == SessionState::ACTIVE || state == SessionState::ENDING);
+    }
+
+    if (events & EVENT_PULSE_READING) {
+        drainPulseReadings();
+    }
+
+    if (events & EVENT_FUSED_DATA) {
+        drainFusedData();
+    }
+
+    if (events & EVENT_FAST_COMMAND) {
+        drainFastCommands();
+    }
 
-    // Check for new servo analytics and publish them
-    if (servoController.hasNewAnalytics()) {
+    // Drains every queued segment - metrics landing during the drain raise a new event
+    if (events & EVENT_SERVO_ANALYTICS) {
         publishServoAnalytics();
-        servoController.clearNewAnalytics();
     }
-}
 
-void DeviceManager::updateMonitoring() {
-    // SystemMonitor now event-driven - no polling needed
-    // systemMonitor.update();  // Removed - monitoring is now task-based
+    // Movements that arrived while the servos were busy
+    processQueuedCommands();
 
-    // Record loop performance for system monitoring
-    unsigned long currentTime = millis();
-    unsigned long currentLoopTime = currentTime - loopStartTime;
-    systemMonitor.recordLoopTime(currentLoopTime);
+    // Stream the offline backlog (rate limited) once MQTT is back
+    if (sessionRecorder.needsService(mqttManager)) {
+        sessionRecorder.update(mqttManager);
+    }
 
-    // Update performance tracking
-    totalLoopTime += currentLoopTime;
+    unsigned long now = millis();
+    if (now - lastStatusReport >= statusReportInterval) {
+        runHousekeeping(now);
+    }
+
+    // Record pass duration for system monitoring
+    unsigned long loopTime = millis() - loopStartTime;
+    totalLoopTime += loopTime;
     loopCount++;
+    systemMonitor.recordLoopTime(loopTime);
+
+    if (loopTime > MAX_LOOP_TIME) {
+        Logger::warningf("Long coordination pass detected: %lu ms", loopTime);
+    }
+
+    lastUpdate = now;
+}
+
+TickType_t DeviceManager::nextWakeTimeout() {
+    unsigned long elapsed = millis() - lastStatusReport;
+    unsigned long wait = elapsed >= statusReportInterval ? 0 : statusReportInterval - elapsed;
+
+    // Page flushes and backlog replay run on the recorder's own rate limit
+    if (sessionRecorder.needsService(mqttManager) && wait > SESSION_RECORDER_REPLAY_INTERVAL) {
+        wait = SESSION_RECORDER_REPLAY_INTERVAL;
+    }
+
+    return pdMS_TO_TICKS(wait);
+}
+
+void DeviceManager::runHousekeeping(unsigned long now) {
+    lastStatusReport = now;
+
+    publishSystemStatus();
+
+    // Boot stage timings once per boot, as soon as there is a broker to take them
+    if (bootTimingPending && mqttManager.isConnected() &&
+        mqttManager.publishBootTiming(bootScheduler, bootReadyUs)) {
+        bootTimingPending = false;
+    }
+
+    // Critical alerts arrive through onSystemAlert; this catches gradual degradation
+    checkSystemHealth();
+
+    ResourceProfiler::update(now);
+}
+
+void DeviceManager::drainCommandQueue() {
+    QueueHandle_t queue = FreeRTOSManager::getDeviceCommandQueue();
+    if (!queue) return;
+
+    Command command;
+    while (xQueueReceive(queue, &command, 0) == pdTRUE) {
+        LOG_DEBUGF("Dispatching queued command '%s' after %lu ms",
+                   command.text, millis() - command.timestamp);
+        dispatchCommand(command);
+    }
+}
 
-    // Update next loop start time
-    loopStartTime = currentTime;
+void DeviceManager::readSerialInput() {
+    while (Serial.available()) {
+        char c = (char)Serial.read();
 
-    // Check for performance alerts
-    if (currentLoopTime > MAX_LOOP_TIME) {
-        Logger::warningf("Long loop time detected: %lu ms", currentLoopTime);
+        if (c != '\n' && c != '\r') {
+            // Overlong lines are cut short rather than split into two commands
+            if (serialLineLength < sizeof(serialLine) - 1) {
+                serialLine[serialLineLength++] = c;
+            }
+            continue;
+        }
+
+        if (serialLineLength == 0) continue;
+
+        serialLine[serialLineLength] = '\0';
+        serialLineLength = 0;
+
+        // Trimmed in place - no String per line
+        char* line = serialLine;
+        while (isspace((unsigned char)*line)) line++;
+        char* end = line + strlen(line);
+        while (end > line && isspace((unsigned char)end[-1])) *--end = '\0';
+
+        if (*line) {
+            handleSerialLine(line);
+        }
+    }
+}
+
+void DeviceManager::handleSerialLine(const char* line) {
+    Logger::infof("Serial debug: %s", line);
+
+    // Debug commands - everything else goes through the command path
+    if (strcmp(line, "status") == 0) {
+        logComponentStatus();
+    } else if (strcmp(line, "freertos") == 0) {
+        logFreeRTOSStatus();
+    } else if (strcmp(line, "tasks") == 0) {
+        Logger::infof("FreeRTOS Tasks: %u", uxTaskGetNumberOfTasks());
+        Logger::infof("Free Heap: %u bytes", ESP.getFreeHeap());
+        Logger::infof("Min Free Heap: %u bytes", ESP.getMinFreeHeap());
+    } else if (strcmp(line, "trace") == 0) {
+        // The dump writes Serial directly - drain queued log lines first so they don't interleave
+        Logger::flush();
+        TaskTracer::dumpToSerial();
+    } else {
+        handleCommand(line, CommandSource::SERIAL_PORT);
+    }
+}
+
+void DeviceManager::handleBLEConnection() {
+    static bool lastBLEState = false;
+    static unsigned long lastBLEChange = 0;
+
+    bool connected = pendingBLEConnected.load();
+
+    // Debounce BLE connection changes (only report if state actually changed and enough time passed)
+    if (connected == lastBLEState || millis() - lastBLEChange <= 1000) return;
+
+    Logger::infof("BLE connection changed: %s", connected ? "Connected" : "Disconnected");
+    publishConnectionStatus();
+
+    // Handle session lifecycle based on BLE connection
+    if (connected) {
+        // Auto-start session on BLE connection
+        if (!sessionManager.isSessionActive()) {
+            sessionManager.startSession(true);
+        }
+    } else {
+        // Handle disconnection - mark session as interrupted if active
+        if (sessionManager.isSessionActive()) {
+            sessionManager.endSession("ble_disconnection");
+        }
+    }
+
+    lastBLEState = connected;
+    lastBLEChange = millis();
+}
+
+void DeviceManager::handleServoComplete() {
+    // Record completed cycles in session
+    int cycles = pendingCycles.exchange(0);
+    if (cycles > 0) {
+        sessionManager.recordMovementComplete(cycles);
+    }
+
+    if (currentState == DeviceState::RUNNING && !servoController.isBusy()) {
+        setState(DeviceState::READY);
+    }
+}
+
+void DeviceManager::drainPulseReadings() {
+    // Drain heart rate readings handed over by the pulse monitor task
+    HeartRateReading reading;
+    while (pulseMonitorManager.popReading(reading)) {
+        onPulseReading(reading);
+    }
+}
+
+void DeviceManager::drainFusedData() {
+    FusedDataStream& stream = sensorFusion.getFusedStream();
+    bool sessionActive = sessionManager.isSessionActive();
+    String sessionId = sessionActive ? sessionManager.getCurrentSessionId() : "";
+
+    const FusedSensorData* frame;
+    while ((frame = stream.front()) != nullptr) {
+        // Every frame feeds session analytics; MQTT gets the newest one at a lower rate
+        if (sessionActive) {
+            sessionAnalyticsManager.processFusedData(*frame, sessionId);
+        }
+
+        unsigned long now = millis();
+        if (stream.size() == 1 && now - lastFusedPublish >= SENSOR_FUSION_PUBLISH_INTERVAL &&
+            canPublishLive()) {
+            if (mqttManager.publishFusedData(*frame, sessionId)) {
+                lastFusedPublish = now;
+            }
+        }
+
+        stream.popFront();
     }
 }
 
 bool DeviceManager::executeMovementCommand(const Command& command) {
-    if (servoController.isBusy()) {
+    if (!servoController.acceptsCommand(command.commandCode)) {
         Logger::warning("Servo controller busy");
         return false;
     }
@@ -483,39 +789,59 @@ bool DeviceManager::executeMovementCommand(const Command& command) {
         publishMovementStatus(command, responseTime);
 
         // Record movement in session
-        sessionManager.recordMovementCommand(command.rawCommand, success);
+        sessionManager.recordMovementCommand(command.opcode, success);
     }
 
     return success;
 }
 
 bool DeviceManager::executeSystemCommand(const Command& command) {
-    String lower = command.rawCommand;
-    lower.toLowerCase();
-
-    if (lower == "status") {
-        logSystemSummary();
-        return true;
-    } else if (lower == "restart") {
-        Logger::warning("System restart requested");
-        ESP.restart();
-        return true;
-    } else if (lower == "stats") {
-        commandProcessor.logStatistics();
-        logPerformanceMetrics();
-        return true;
-    } else if (lower == "end_session") {
-        // Handle manual session end request
-        if (sessionManager.isSessionActive()) {
-            sessionManager.endSession("user_requested");
-            Logger::info("Session ended by user request");
+    switch (command.opcode) {
+        case CommandOpcode::STATUS:
+            logSystemSummary();
             return true;
-        } else {
+        case CommandOpcode::RESTART:
+            Logger::warning("System restart requested");
+            Logger::flush();
+            ESP.restart();
+            return true;
+        case CommandOpcode::STATS:
+            commandProcessor.logStatistics();
+            logPerformanceMetrics();
+            return true;
+        case CommandOpcode::END_SESSION:
+            // Handle manual session end request
+            if (sessionManager.isSessionActive()) {
+                sessionManager.endSession("user_requested");
+                Logger::info("Session ended by user request");
+                return true;
+            }
             Logger::warning("No active session to end");
             return false;
-        }
+        case CommandOpcode::RESOURCE_PROFILE:
+            return executeProfileCommand(command);
+        default:
+            return false;
     }
+}
+
+bool DeviceManager::executeProfileCommand(const Command& command) {
+    // "profile [on|off|apply|revert|reset|report]" - a bare "profile" reports
+    const char* action = command.text;
+    while (*action && !isspace((unsigned char)*action)) action++;
+    while (isspace((unsigned char)*action)) action++;
 
+    if (*action == '\0' || strcasecmp(action, "report") == 0) {
+        ResourceProfiler::logRecommendation();
+        return true;
+    }
+    if (strcasecmp(action, "on") == 0) return ResourceProfiler::setProfiling(true);
+    if (strcasecmp(action, "off") == 0) return ResourceProfiler::setProfiling(false);
+    if (strcasecmp(action, "apply") == 0) return ResourceProfiler::setApplyOnBoot(true);
+    if (strcasecmp(action, "revert") == 0) return ResourceProfiler::setApplyOnBoot(false);
+    if (strcasecmp(action, "reset") == 0) return ResourceProfiler::reset();
+
+    Logger::warningf("Unknown profile action '%s' (on, off, apply, revert, reset, report)", action);
     return false;
 }
 
@@ -576,12 +902,11 @@ void DeviceManager::checkSystemHealth() {
 
 void DeviceManager::publishMovementStatus(const Command& command, unsigned long responseTime) {
     if (mqttManager.isConnected()) {
-        String sessionId = sessionManager.isSessionActive() ? sessionManager.getCurrentSessionId() : "";
         mqttManager.publishMovementCommand(
-            command.rawCommand,
+            command.text,
             responseTime,
             bleManager.isConnected(),
-            sessionId
+            sessionManager.getCurrentSessionId().c_str()
         );
     }
 }
@@ -603,11 +928,13 @@ void DeviceManager::publishSystemHealthData() {
     bool success = mqttManager.publishPerformanceTiming(
         metrics.averageLoopTime,
         metrics.averageLoopTime,
-        metrics.maxLoopTime
+        metrics.maxLoopTime,
+        metrics.coreLoad[0],
+        metrics.coreLoad[1]
     );
 
     if (success) {
-        Logger::debug("Published system performance data");
+        LOG_DEBUG("Published system performance data");
     }
 
     // Publish memory usage data
@@ -618,41 +945,44 @@ void DeviceManager::publishSystemHealthData() {
     );
 
     if (success) {
-        Logger::debug("Published memory usage data");
+        LOG_DEBUG("Published memory usage data");
     }
 
+    // BLE link parameters and measured throughput
+    mqttManager.publishPerformanceBLE(bleManager.getLinkManager().getStats());
 
+    // Task latency histograms, less often - each frame is close to a full message
+    static unsigned long lastTracePublish = 0;
+    if (millis() - lastTracePublish >= TASK_TRACE_PUBLISH_INTERVAL &&
+        mqttManager.publishTaskTrace()) {
+        lastTracePublish = millis();
+    }
+
+    // Per-task CPU share and stack headroom, on the same slow cadence
+    static unsigned long lastTaskUsagePublish = 0;
+    if (millis() - lastTaskUsagePublish >= CPU_TASK_USAGE_PUBLISH_INTERVAL &&
+        mqttManager.publishTaskUsage(systemMonitor.getTaskUsage(), systemMonitor.getTaskUsageCount(),
+                                     systemMonitor.getCpuWindow(), systemMonitor.hasPerTaskCpu())) {
+        lastTaskUsagePublish = millis();
+    }
 }
 
 void DeviceManager::publishServoAnalytics() {
-    if (!mqttManager.isConnected()) return;
-
-    // Get the latest movement metrics from servo controller
-    auto metrics = servoController.getLastMovementMetrics();
-
     // Get current session ID if active
     String sessionId = sessionManager.isSessionActive() ? sessionManager.getCurrentSessionId() : "";
 
-    // Publish individual movement data
-    bool success = mqttManager.publishMovementIndividual(
-        metrics.servoIndex,
-        metrics.startTime,
-        metrics.duration,
-        metrics.successful,
-        metrics.startAngle,
-        metrics.targetAngle,
-        metrics.actualAngle,
-        metrics.smoothness,
-        metrics.movementType,
-        sessionId
-    );
-
-    if (success) {
-        Logger::debugf("Published servo analytics: Servo %d, Duration %lu ms, Quality %.2f",
-                      metrics.servoIndex, metrics.duration, metrics.smoothness);
+    // Every joint segment finished since the last drain
+    ServoController::MovementMetrics metrics;
+    while (servoController.popMovementMetrics(metrics)) {
+        publishMovementMetrics(metrics, sessionId);
+    }
+}
 
-        // Also send to session analytics manager for processing
-        sessionAnalyticsManager.processMovementData({
+void DeviceManager::publishMovementMetrics(const ServoController::MovementMetrics& metrics, const String& sessionId) {
+    // Publish individual movement data (queued behind any recorded backlog)
+    bool success = false;
+    if (canPublishLive()) {
+        success = mqttManager.publishMovementIndividual(
             metrics.servoIndex,
             metrics.startTime,
             metrics.duration,
@@ -663,10 +993,39 @@ void DeviceManager::publishServoAnalytics() {
             metrics.smoothness,
             metrics.movementType,
             sessionId
-        });
+        );
+    }
+
+    if (success) {
+        LOG_DEBUGF("Published servo analytics: Servo %d, Duration %lu ms, Quality %.2f",
+                      metrics.servoIndex, metrics.duration, metrics.smoothness);
+    } else if (sessionRecorder.recordMovement(metrics.servoIndex, metrics.startTime, metrics.duration,
+                                              metrics.successful, metrics.startAngle, metrics.targetAngle,
+                                              metrics.actualAngle, metrics.smoothness,
+                                              metrics.movementType, sessionId)) {
+        LOG_DEBUGF("Recorded servo analytics for later upload: Servo %d", metrics.servoIndex);
     } else {
         Logger::warning("Failed to publish servo analytics");
     }
+
+    // Also send to session analytics manager for processing
+    MovementAnalytics movement = {};
+    movement.startTime = metrics.startTime;
+    movement.duration = metrics.duration;
+    movement.startAngle = metrics.startAngle;
+    movement.targetAngle = metrics.targetAngle;
+    movement.actualAngle = metrics.actualAngle;
+    movement.servoIndex = metrics.servoIndex;
+    movement.successful = metrics.successful;
+    movement.smoothness = metrics.smoothness;
+    strncpy(movement.movementType, metrics.movementType, sizeof(movement.movementType) - 1);
+    movement.sessionId.set(sessionId.c_str());
+    sessionAnalyticsManager.processMovementData(movement);
+}
+
+bool DeviceManager::canPublishLive() {
+    // While a backlog is replaying, new data is recorded behind it to keep the server's view in order
+    return mqttManager.isConnected() && !sessionRecorder.hasBacklog();
 }
 
 void DeviceManager::logPerformanceMetrics() {
@@ -678,6 +1037,8 @@ void DeviceManager::logPerformanceMetrics() {
         Logger::infof("  Max Loop Time: %lu ms", systemMonitor.getMaxLoopTime());
         Logger::infof("  Uptime: %s", systemMonitor.getUptimeString().c_str());
     }
+
+    bleManager.getLinkManager().logStatistics();
 }
 
 // Static callback implementations
@@ -687,7 +1048,8 @@ void DeviceManager::onWiFiConnectionChange(bool connected) {
         instance->publishConnectionStatus();
 
         if (connected) {
-            TimeManager::syncWithNTP();
+            // NTP was started by the WiFi manager; bring MQTT up alongside it
+            instance->mqttManager.requestConnection();
         }
     }
 }
@@ -704,58 +1066,142 @@ void DeviceManager::onMQTTConnectionChange(bool connected) {
 
 void DeviceManager::onBLEConnectionChange(bool connected) {
     if (instance) {
-        static bool lastBLEState = false;
-        static unsigned long lastBLEChange = 0;
-
-        // Debounce BLE connection changes (only report if state actually changed and enough time passed)
-        if (connected != lastBLEState && (millis() - lastBLEChange > 1000)) {
-            Logger::infof("BLE connection changed: %s", connected ? "Connected" : "Disconnected");
-            instance->publishConnectionStatus();
-
-            // Handle session lifecycle based on BLE connection
-            if (connected) {
-                // Auto-start session on BLE connection
-                if (!instance->sessionManager.isSessionActive()) {
-                    instance->sessionManager.startSession(true);
-                }
-            } else {
-                // Handle disconnection - mark session as interrupted if active
-                if (instance->sessionManager.isSessionActive()) {
-                    instance->sessionManager.endSession("ble_disconnection");
-                }
-            }
-
-            lastBLEState = connected;
-            lastBLEChange = millis();
-        }
+        // Session lifecycle follows on the DeviceManager task
+        instance->pendingBLEConnected.store(connected);
+        instance->notifyEvents(EVENT_BLE_CONNECTION);
     }
 }
 
 void DeviceManager::onBLECommandReceived(const String& command) {
-    Logger::infof("DeviceManager::onBLECommandReceived called with: '%s'", command.c_str());
-
     if (instance) {
-        Logger::info("DeviceManager instance exists, calling handleCommand...");
-        bool result = instance->handleCommand(command, CommandSource::BLE);
-        Logger::infof("DeviceManager::handleCommand result: %s", result ? "SUCCESS" : "FAILED");
+        // Keep the NimBLE host task short - the command runs on the DeviceManager task
+        instance->postCommand(command.c_str(), CommandSource::BLE);
     } else {
         Logger::error("DeviceManager instance is null!");
     }
 }
 
+BLECommandStatus DeviceManager::onBLEFastCommand(const BLECommandFrame& frame) {
+    if (!instance) return BLECommandStatus::REJECTED;
+
+    // Stops act at once and are never refused
+    if (frame.opcode == BLECommandOpcode::EMERGENCY_STOP) {
+        instance->servoController.emergencyStop();
+        return BLECommandStatus::ACCEPTED;
+    }
+    if (frame.opcode == BLECommandOpcode::STOP) {
+        instance->servoController.stopAllMovement();
+        return BLECommandStatus::ACCEPTED;
+    }
+
+    if (instance->currentState == DeviceState::INITIALIZING ||
+        instance->currentState == DeviceState::ERROR) {
+        Logger::warning("Device not ready - command frame rejected");
+        return BLECommandStatus::REJECTED;
+    }
+
+    ServoCommand command;
+    command.receivedUs = frame.receivedUs;
+    command.commandCode = (uint8_t)frame.opcode;
+    command.sequence = frame.sequence;
+
+    // Counted once the servo task starts it (onServoCommandStarted) - it may
+    // still drop or reject the command
+    if (!instance->servoController.submitCommand(command)) {
+        return BLECommandStatus::BUSY;
+    }
+    return BLECommandStatus::ACCEPTED;
+}
+
+void DeviceManager::drainFastCommands() {
+    ServoCommand accepted;
+    while (acceptedFastCommands.pop(accepted)) {
+        const char text[2] = {(char)('0' + accepted.commandCode), '\0'};
+        Command command;
+        CommandProcessor::parseCommand(text, CommandSource::BLE, command);
+        unsigned long queueTime = (unsigned long)((esp_timer_get_time() - accepted.receivedUs) / 1000);
+
+        setState(DeviceState::RUNNING);
+        publishMovementStatus(command, queueTime);
+        sessionManager.recordMovementCommand(command.opcode, true);
+    }
+}
+
+void DeviceManager::onStreamSample(BLEStreamSample& sample) {
+    if (!instance) return;
+
+    // Runs on the BLE stream task - plain snapshots of the owners' state
+    uint32_t vitals = instance->streamVitals.load();
+    sample.heartRateX10 = vitals & 0xFFFF;
+    sample.spO2 = (vitals >> 16) & 0xFF;
+    sample.flags = (vitals >> 24) ? STREAM_FLAG_FINGER_DETECTED : 0;
+
+    ServoController& servo = instance->servoController;
+    if (servo.isBusy()) sample.flags |= STREAM_FLAG_MOVING;
+    if (instance->sessionManager.isSessionActive()) sample.flags |= STREAM_FLAG_SESSION_ACTIVE;
+
+    sample.servoState = (uint8_t)servo.getCurrentState();
+    sample.progress = (uint8_t)constrain(servo.getMovementProgress() * 100.0f, 0.0f, 100.0f);
+
+    for (uint8_t i = 0; i < BLE_STREAM_SERVO_COUNT && i < servo.getServoCount(); i++) {
+        sample.angles[i] = (uint8_t)constrain(servo.getServoStatus(i).currentAngle, 0, 180);
+    }
+}
+
 void DeviceManager::onServoMovementComplete(ServoState state, int cycles) {
     if (instance) {
         Logger::infof("Servo movement complete: State %d, Cycles %d", (int)state, cycles);
 
-        // Record completed cycles in session
-        instance->sessionManager.recordMovementComplete(cycles);
+        // Runs on the servo task - session bookkeeping happens on ours
+        instance->pendingCycles.fetch_add(cycles);
+        instance->notifyEvents(EVENT_SERVO_COMPLETE);
+    }
+}
 
-        if (instance->currentState == DeviceState::RUNNING) {
-            instance->setState(DeviceState::READY);
-        }
+void DeviceManager::onServoCommandStarted(const ServoCommand& command) {
+    if (!instance) return;
+
+    // Runs on the servo task - session and MQTT state belong to ours. The
+    // movement itself is already running if the log entry is lost.
+    if (!instance->acceptedFastCommands.push(command)) {
+        Logger::warning("Fast command log full - movement not recorded");
+    }
+    instance->notifyEvents(EVENT_FAST_COMMAND);
+}
 
-        // Servo movement completed successfully
-        Logger::debug("Servo movement complete - no additional coordination needed");
+void DeviceManager::onServoAnalytics() {
+    if (instance) {
+        instance->notifyEvents(EVENT_SERVO_ANALYTICS);
+    }
+}
+
+void DeviceManager::onPulseReadingQueued(const HeartRateReading& reading) {
+    if (instance) {
+        instance->notifyEvents(EVENT_PULSE_READING);
+    }
+}
+
+void DeviceManager::onMotionReading(const MotionReading& reading) {
+    if (instance) {
+        instance->sensorFusion.pushMotion(reading);
+    }
+}
+
+bool DeviceManager::onJointAngleFeedback(int servoIndex, float& angle) {
+    return instance && instance->motionSensorManager.getJointAngle(servoIndex, angle);
+}
+
+void DeviceManager::onPressureReading(const PressureReading& reading) {
+    if (instance) {
+        instance->servoController.getSafetySupervisor().reportForce(reading.sensorIndex, reading.force,
+                                                                   reading.timestamp);
+        instance->sensorFusion.pushPressure(reading);
+    }
+}
+
+void DeviceManager::onFusedFrame() {
+    if (instance) {
+        instance->notifyEvents(EVENT_FUSED_DATA);
     }
 }
 
@@ -791,7 +1237,13 @@ void DeviceManager::onSessionStart(const String& sessionId) {
             default: sessionType = "unknown"; break;
         }
 
-        instance->mqttManager.publishSessionStart(sessionId, sessionType, instance->bleManager.isConnected());
+        bool bleConnected = instance->bleManager.isConnected();
+        bool autoStarted = true;  // Sessions only start on BLE connection (handleBLEConnection)
+        bool published = instance->canPublishLive() &&
+                         instance->mqttManager.publishSessionStart(sessionId, sessionType, bleConnected, autoStarted);
+        if (!published) {
+            instance->sessionRecorder.recordSessionStart(sessionId, sessionType, bleConnected, autoStarted);
+        }
     }
 }
 
@@ -812,6 +1264,9 @@ void DeviceManager::onSessionEnd(const String& sessionId, const SessionStats& st
         // End pulse monitoring session
         instance->pulseMonitorManager.endSession();
 
+        // Sessions are what a resource profile has to cover before it can apply
+        ResourceProfiler::recordSessionEnd();
+
         // Publish session end to MQTT
         String sessionType = "";
         switch (stats.detectedType) {
@@ -822,61 +1277,110 @@ void DeviceManager::onSessionEnd(const String& sessionId, const SessionStats& st
             default: sessionType = "unknown"; break;
         }
 
-        instance->mqttManager.publishSessionEnd(sessionId, sessionType, stats.endReason,
-                                               stats.duration, stats.totalMovements,
-                                               stats.successfulMovements, stats.completedCycles);
+        bool published = instance->canPublishLive() &&
+                         instance->mqttManager.publishSessionEnd(sessionId, sessionType, stats.endReason,
+                                                                 stats.duration, stats.totalMovements,
+                                                                 stats.successfulMovements, stats.completedCycles);
+        if (!published) {
+            instance->sessionRecorder.recordSessionEnd(sessionId, sessionType, stats.endReason,
+                                                       stats.duration, stats.totalMovements,
+                                                       stats.successfulMovements, stats.completedCycles);
+        }
     }
 }
 
 void DeviceManager::onSessionStateChange(SessionState oldState, SessionState newState) {
     if (instance) {
         Logger::infof("Session state changed: %d -> %d", (int)oldState, (int)newState);
+
+        // BLE link profile follows on the DeviceManager task
+        instance->notifyEvents(EVENT_SESSION);
         // Future: Publish session state changes to MQTT
     }
 }
 
 void DeviceManager::onPulseReading(const HeartRateReading& reading) {
-    if (instance && instance->mqttManager.isConnected()) {
-        // Publish all readings to show sensor status and SpO2
-        String qualityStr;
-        switch (reading.quality) {
-            case PulseQuality::GOOD: qualityStr = "good"; break;
-            case PulseQuality::FAIR: qualityStr = "fair"; break;
-            case PulseQuality::POOR: qualityStr = "poor"; break;
-            case PulseQuality::NO_SIGNAL: qualityStr = "no_signal"; break;
-            default: qualityStr = "unknown"; break;
-        }
+    if (!instance) return;
+
+    // The BLE stream picks the newest vitals up from its own task
+    uint32_t heartRate = (uint32_t)constrain(reading.heartRate * 10.0f, 0.0f, 65535.0f);
+    uint32_t spO2 = (uint32_t)constrain(reading.spO2, 0.0f, 100.0f);
+    instance->streamVitals.store(heartRate | (spO2 << 16) |
+                                 ((reading.fingerDetected ? 1UL : 0UL) << 24));
+
+    // Fusion aligns pulse with motion and pressure on its own task
+    PulseReading pulse = {};
+    pulse.timestamp = reading.timestamp;
+    pulse.valid = reading.fingerDetected && reading.quality != PulseQuality::NO_SIGNAL;
+    pulse.sensorId = I2C_ADDR_MAX30102;
+    pulse.heartRate = (uint16_t)constrain(reading.heartRate + 0.5f, 0.0f, 65535.0f);
+    pulse.spO2 = (uint8_t)spO2;
+    pulse.redValue = reading.redValue;
+    pulse.irValue = reading.irValue;
+    pulse.signalStrength = reading.signalStrength;
+    switch (reading.quality) {
+        case PulseQuality::EXCELLENT: pulse.quality = 1.0f; break;
+        case PulseQuality::GOOD: pulse.quality = 0.8f; break;
+        case PulseQuality::FAIR: pulse.quality = 0.5f; break;
+        case PulseQuality::POOR: pulse.quality = 0.2f; break;
+        default: pulse.quality = 0.0f; break;
+    }
+    instance->sensorFusion.pushPulse(pulse);
 
-        String sessionId = instance->sessionManager.isSessionActive() ?
-                          instance->sessionManager.getCurrentSessionId() : "";
+    // Only a trustworthy rate may stop an exercise
+    if (pulse.valid && pulse.heartRate > 0 && pulse.quality >= 0.5f) {
+        instance->servoController.getSafetySupervisor().reportHeartRate(reading.heartRate, reading.timestamp);
+    }
 
-        instance->mqttManager.publishHeartRate(
-            reading.heartRate,
-            reading.spO2,
-            qualityStr,
-            reading.fingerDetected, // Use actual finger detection
-            sessionId
-        );
+    bool sessionActive = instance->sessionManager.isSessionActive();
+    bool live = instance->canPublishLive();
+
+    // Offline readings are only worth keeping as part of a session
+    if (!live && !sessionActive) return;
+
+    // Publish all readings to show sensor status and SpO2
+    String qualityStr;
+    switch (reading.quality) {
+        case PulseQuality::GOOD: qualityStr = "good"; break;
+        case PulseQuality::FAIR: qualityStr = "fair"; break;
+        case PulseQuality::POOR: qualityStr = "poor"; break;
+        case PulseQuality::NO_SIGNAL: qualityStr = "no_signal"; break;
+        default: qualityStr = "unknown"; break;
+    }
+
+    String sessionId = sessionActive ? instance->sessionManager.getCurrentSessionId() : "";
+
+    bool published = live && instance->mqttManager.publishHeartRate(
+        reading.heartRate,
+        reading.spO2,
+        qualityStr,
+        reading.fingerDetected, // Use actual finger detection
+        sessionId
+    );
+
+    if (!published && sessionActive) {
+        instance->sessionRecorder.recordHeartRate(reading.heartRate, reading.spO2, qualityStr,
+                                                  reading.fingerDetected, sessionId);
     }
 }
 
 // Missing method implementations
 void DeviceManager::onCommandComplete(const Command& command, bool success) {
     Logger::infof("Command completed: %s (Success: %s)",
-                 command.rawCommand.c_str(), success ? "Yes" : "No");
+                 command.text, success ? "Yes" : "No");
 
     // Record command completion in session if active
     if (sessionManager.isSessionActive() && command.type == CommandType::MOVEMENT) {
-        sessionManager.recordMovementCommand(command.rawCommand, success);
+        sessionManager.recordMovementCommand(command.opcode, success);
     }
 }
 
-void DeviceManager::onCommandError(const Command& command, const String& error) {
-    Logger::errorf("Command error: %s - %s", command.rawCommand.c_str(), error.c_str());
+void DeviceManager::onCommandError(const Command& command, const char* error) {
+    Logger::errorf("Command error: %s - %s", command.text, error);
 
     // Record failed command in session if active
     if (sessionManager.isSessionActive() && command.type == CommandType::MOVEMENT) {
-        sessionManager.recordMovementCommand(command.rawCommand, false);
+        sessionManager.recordMovementCommand(command.opcode, false);
     }
 }
 
@@ -900,11 +1404,19 @@ void DeviceManager::logComponentStatus() {
     Logger::infof("MQTT Manager: %s (Tasks: %s)",
                  mqttManager.isConnected() ? "Connected" : "Disconnected",
                  mqttManager.areTasksRunning() ? "Running" : "Stopped");
+    Logger::infof("MQTT Connect: last %lu ms, avg %lu ms, max %lu ms, %lu failures, retry %lu ms",
+                 mqttManager.getLastConnectLatency(), mqttManager.getAverageConnectLatency(),
+                 mqttManager.getMaxConnectLatency(), (unsigned long)mqttManager.getConnectFailureCount(),
+                 mqttManager.getRetryDelay());
 
     Logger::infof("BLE Manager: %s (Task: %s)",
                  bleManager.isConnected() ? "Connected" : "Advertising",
                  bleManager.isTaskRunning() ? "Running" : "Stopped");
     Logger::infof("Servo Controller: %s", servoController.isBusy() ? "Busy" : "Ready");
+    Logger::infof("Safety Supervisor: %s (Trips: %lu, Last: %s)",
+                 servoController.isOutputCut() ? "OUTPUT CUT" : "Armed",
+                 (unsigned long)servoController.getSafetySupervisor().getTripCount(),
+                 SafetySupervisor::getFaultName(servoController.getSafetySupervisor().getLastFault()));
     Logger::infof("System Monitor: %s", systemMonitor.isSystemHealthy() ? "Healthy" : "Warning");
     // SystemHealthManager removed - using SystemMonitor instead
     Logger::infof("Session Analytics Manager: %s (Task: %s)",
@@ -913,7 +1425,26 @@ void DeviceManager::logComponentStatus() {
     Logger::infof("Pulse Monitor Manager: %s (Task: %s)",
                  pulseMonitorManager.isSensorConnected() ? "Connected" : "Disconnected",
                  pulseMonitorManager.isTaskRunning() ? "Running" : "Stopped");
+    Logger::infof("Motion Sensor Manager: %s (Task: %s, Overflows: %lu)",
+                 motionSensorManager.isSensorConnected() ?
+                     (motionSensorManager.isCalibrated() ? "Calibrated" : "Calibrating") : "Disconnected",
+                 motionSensorManager.isTaskRunning() ? "Running" : "Stopped",
+                 (unsigned long)motionSensorManager.getFIFOOverflowCount());
+    Logger::infof("Pressure Sensor Manager: %s (Task: %s, Grip: %.1f N, Overruns: %lu)",
+                 pressureSensorManager.isSampling() ?
+                     (pressureSensorManager.isCalibrated() ? "Sampling" : "Taring") : "Stopped",
+                 pressureSensorManager.isTaskRunning() ? "Running" : "Stopped",
+                 pressureSensorManager.getGripForce(),
+                 (unsigned long)pressureSensorManager.getOverrunCount());
+    Logger::infof("Sensor Fusion: %lu frames (Task: %s)",
+                 (unsigned long)sensorFusion.getFrameCount(),
+                 sensorFusion.isTaskRunning() ? "Running" : "Stopped");
     Logger::infof("Session Manager: %s", sessionManager.isSessionActive() ? "Active Session" : "Idle");
+    Logger::infof("Session Recorder: %s (Backlog: %lu, Replayed: %lu, Dropped: %lu)",
+                 sessionRecorder.isAvailable() ? "Ready" : "Unavailable",
+                 (unsigned long)sessionRecorder.getBacklogRecords(),
+                 (unsigned long)sessionRecorder.getReplayedCount(),
+                 (unsigned long)sessionRecorder.getDroppedCount());
     Logger::info("========================");
 }
 
@@ -963,11 +1494,11 @@ void DeviceManager::startTask() {
     BaseType_t result = xTaskCreatePinnedToCore(
         deviceManagerTask,
         "DeviceManager",
-        4096,  // 4KB stack
+        ResourceProfiler::getStackSize(ProfiledTask::DEVICE_MANAGER),
         this,
-        3,     // Priority 3 - coordination task
+        PRIORITY_DEVICE_MANAGER,
         &taskHandle,
-        1      // Core 1 - Application CPU
+        CORE_APPLICATION
     );
 
     if (result == pdPASS) {
@@ -996,12 +1527,20 @@ void DeviceManager::deviceManagerTask(void* parameter) {
 
     Logger::info("DeviceManager task started");
 
+    // Event driven, so no period to check deadlines against
+    TraceId traceId = TaskTracer::registerTask("DeviceManager");
+
+    // First pass picks up anything that arrived before the task existed
+    uint32_t events = EVENT_ALL;
+
     while (manager->taskRunning) {
-        // Run the main update cycle in FreeRTOS task context
-        manager->update();
+        int64_t traceStart = TaskTracer::begin(traceId);
+        manager->processEvents(events);
+        TaskTracer::end(traceId, traceStart);
 
-        // Task runs at 10Hz (100ms cycle) - appropriate for coordination
-        vTaskDelay(pdMS_TO_TICKS(100));
+        // Sleep until a producer has work or housekeeping is due
+        events = 0;
+        xTaskNotifyWait(0, EVENT_ALL, &events, manager->nextWakeTimeout());
     }
 
     Logger::info("DeviceManager task ended");
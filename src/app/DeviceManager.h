@@ -2,6 +2,8 @@
 #define DEVICE_MANAGER_H
 
 #include <Arduino.h>
+#include <atomic>
+#include "../config/Config.h"
 
 // Include all component managers
 #include "../network/WiFiManager.h"
@@ -12,12 +14,18 @@
 #include "../hardware/SystemMonitor.h"
 #include "../hardware/FreeRTOSManager.h"
 #include "../hardware/I2CManager.h"
+#include "../memory/SPSCRingBuffer.h"
 // SystemHealthManager removed - using SystemMonitor instead
 #include "../analytics/SessionAnalyticsManager.h"
 #include "../sensors/PulseMonitorManager.h"
+#include "../sensors/MotionSensorManager.h"
+#include "../sensors/PressureSensorManager.h"
+#include "../sensors/SensorFusion.h"
+#include "../storage/SessionRecorder.h"
 #include "../utils/TimeManager.h"
 #include "../utils/Logger.h"
 #include "../utils/ErrorHandler.h"
+#include "../utils/BootScheduler.h"
 #include "CommandProcessor.h"
 #include "SessionManager.h"
 
@@ -33,7 +41,7 @@ class DeviceManager {
 public:
     // Lifecycle management
     void initialize();
-    void update();  // Legacy - will be replaced by FreeRTOS task
+    void update();  // One coordination pass over every event source
     void shutdown();
 
     // FreeRTOS Task Management
@@ -56,6 +64,10 @@ public:
     // SystemHealthManager removed - using SystemMonitor instead
     SessionAnalyticsManager& getSessionAnalyticsManager();
     PulseMonitorManager& getPulseMonitorManager();
+    MotionSensorManager& getMotionSensorManager();
+    PressureSensorManager& getPressureSensorManager();
+    SensorFusion& getSensorFusion();
+    SessionRecorder& getSessionRecorder();
     CommandProcessor& getCommandProcessor();
     SessionManager& getSessionManager();
 
@@ -64,9 +76,14 @@ public:
     static void logFreeRTOSStatus();
 
     // Command handling
-    bool handleCommand(const String& command, CommandSource source);
+    bool handleCommand(const char* text, CommandSource source);
+    bool dispatchCommand(const Command& command);
     void processQueuedCommands();
 
+    // Event delivery - safe from any task, handled on the DeviceManager task
+    bool postCommand(const char* text, CommandSource source);
+    void onSerialReceive();
+
     // Status reporting
     void publishSystemStatus();
     void logSystemSummary();
@@ -90,6 +107,10 @@ private:
     // SystemHealthManager removed - using SystemMonitor instead
     SessionAnalyticsManager sessionAnalyticsManager;
     PulseMonitorManager pulseMonitorManager;
+    MotionSensorManager motionSensorManager;
+    PressureSensorManager pressureSensorManager;
+    SensorFusion sensorFusion;
+    SessionRecorder sessionRecorder;
     CommandProcessor commandProcessor;
     SessionManager sessionManager;
 
@@ -99,6 +120,20 @@ private:
     unsigned long lastStatusReport;
     unsigned long statusReportInterval;
     unsigned long lastUpdate;
+    unsigned long lastFusedPublish;
+
+    // Latest vitals for the BLE stream: heart rate x10 | SpO2 << 16 | finger << 24
+    std::atomic<uint32_t> streamVitals;
+
+    // Fast-path commands the servo task started - pushed by the servo task,
+    // state/session/MQTT bookkeeping done on ours
+    SPSCRingBuffer<ServoCommand, FAST_COMMAND_LOG_SIZE> acceptedFastCommands;
+
+    // Staged boot
+    BootScheduler bootScheduler;
+    std::atomic<bool> bootCompletePending;  // Set by the last boot worker
+    bool bootTimingPending;                 // Stage timings not yet published
+    uint32_t bootReadyUs;                   // esp_timer time commands were first accepted
 
     // Performance tracking
     unsigned long loopStartTime;
@@ -110,33 +145,63 @@ private:
     bool taskRunning;
     static void deviceManagerTask(void* parameter);
 
+    // Event state handed over by producer tasks
+    std::atomic<int> pendingCycles;        // Completed servo cycles not yet recorded
+    std::atomic<bool> pendingBLEConnected; // Latest BLE connection state
+
+    // Serial line assembly (DeviceManager task only)
+    char serialLine[DEVICE_COMMAND_MAX_LENGTH];
+    size_t serialLineLength;
+
     // Callbacks
     void (*stateChangeCallback)(DeviceState oldState, DeviceState newState);
 
-    // Initialization phases
+    // Initialization - the foundation inline, the rest as boot stages
     bool initializeFoundation();
-    bool initializeCommunication();
+    void startBootStages();
     bool initializeHardware();
     bool initializeApplication();
+    bool initializeBLE();
+    bool initializeSensors();
+    bool initializeNetwork();
+    static void onBootComplete(void* context);
+    void handleBootComplete();
 
-    // Update phases
-    void updateCommunication();
-    void updateHardware();
-    void updateApplication();
-    void updateMonitoring();
+    // Event handling
+    void notifyEvents(uint32_t events);
+    void processEvents(uint32_t events);
+    TickType_t nextWakeTimeout();
+    void drainCommandQueue();
+    void readSerialInput();
+    void handleSerialLine(const char* line);
+    void handleBLEConnection();
+    void handleServoComplete();
+    void drainPulseReadings();
+    void drainFusedData();
+    void drainFastCommands();
+    void runHousekeeping(unsigned long now);
 
     // Command handling
     bool executeMovementCommand(const Command& command);
     bool executeSystemCommand(const Command& command);
+    bool executeProfileCommand(const Command& command);
     void onCommandComplete(const Command& command, bool success);
-    void onCommandError(const Command& command, const String& error);
+    void onCommandError(const Command& command, const char* error);
 
     // Connection callbacks
     static void onWiFiConnectionChange(bool connected);
     static void onMQTTConnectionChange(bool connected);
     static void onBLEConnectionChange(bool connected);
     static void onBLECommandReceived(const String& command);
+    static BLECommandStatus onBLEFastCommand(const BLECommandFrame& frame);
     static void onServoMovementComplete(ServoState state, int cycles);
+    static void onServoCommandStarted(const ServoCommand& command);
+    static void onServoAnalytics();
+    static void onPulseReadingQueued(const HeartRateReading& reading);
+    static void onMotionReading(const MotionReading& reading);
+    static bool onJointAngleFeedback(int servoIndex, float& angle);
+    static void onPressureReading(const PressureReading& reading);
+    static void onFusedFrame();
     static void onSystemAlert(SystemHealth health, const String& message);
 
     // Session callbacks
@@ -144,6 +209,7 @@ private:
     static void onSessionEnd(const String& sessionId, const SessionStats& stats);
     static void onSessionStateChange(SessionState oldState, SessionState newState);
     static void onPulseReading(const HeartRateReading& reading);
+    static void onStreamSample(BLEStreamSample& sample);
 
     // State management
     void setState(DeviceState newState);
@@ -153,7 +219,9 @@ private:
     // Status publishing
     void publishMovementStatus(const Command& command, unsigned long responseTime);
     void publishConnectionStatus();
-    void publishServoAnalytics();
+    void publishServoAnalytics();  // Drains ServoController::popMovementMetrics()
+    void publishMovementMetrics(const ServoController::MovementMetrics& metrics, const String& sessionId);
+    bool canPublishLive();
     void publishSystemHealthData();
 
     // Logging and diagnostics
@@ -165,6 +233,24 @@ private:
     // Configuration
     static const unsigned long DEFAULT_STATUS_INTERVAL = 2000;  // 2 seconds
     static const unsigned long MAX_LOOP_TIME = 100;  // 100ms warning threshold
+
+    // Task notification bits - why the DeviceManager task woke up
+    static const uint32_t EVENT_COMMAND = 1 << 0;          // Text command queued
+    static const uint32_t EVENT_SERIAL = 1 << 1;           // Serial bytes received
+    static const uint32_t EVENT_SERVO_COMPLETE = 1 << 2;
+    static const uint32_t EVENT_SERVO_ANALYTICS = 1 << 3;
+    static const uint32_t EVENT_PULSE_READING = 1 << 4;
+    static const uint32_t EVENT_BLE_CONNECTION = 1 << 5;
+    static const uint32_t EVENT_SESSION = 1 << 6;
+    static const uint32_t EVENT_FUSED_DATA = 1 << 7;       // Sensor fusion frame ready
+    static const uint32_t EVENT_BOOT = 1 << 8;             // Last boot stage finished
+    static const uint32_t EVENT_FAST_COMMAND = 1 << 9;     // BLE command frame accepted
+    static const uint32_t EVENT_ALL = 0x3FF;
+
+    // Boot stages, in the order startBootStages() adds them
+    enum BootStageId : uint8_t { BOOT_SERVOS, BOOT_APPLICATION, BOOT_I2C, BOOT_SENSORS, BOOT_BLE, BOOT_NETWORK };
+    static const BootStageMask BOOT_REQUIRED_FOR_COMMANDS = (1 << BOOT_SERVOS) | (1 << BOOT_APPLICATION);
+    static const BootStageMask BOOT_COMMAND_PATH = BOOT_REQUIRED_FOR_COMMANDS | (1 << BOOT_BLE);
 };
 
 #endif
@@ -151,8 +151,9 @@ bool SessionManager::isSessionActive() {
     return (currentState == SessionState::ACTIVE || currentState == SessionState::ENDING);
 }
 
-String SessionManager::getCurrentSessionId() {
-    return isSessionActive() ? currentSession.sessionId : "";
+const String& SessionManager::getCurrentSessionId() {
+    static const String NO_SESSION;
+    return isSessionActive() ? currentSession.sessionId : NO_SESSION;
 }
 
 SessionState SessionManager::getCurrentState() {
@@ -188,10 +189,10 @@ SessionStats SessionManager::getSessionStats() {
     return stats;
 }
 
-void SessionManager::recordMovementCommand(const String& command, bool successful) {
+void SessionManager::recordMovementCommand(CommandOpcode opcode, bool successful) {
     if (!isSessionActive()) return;
 
-    if (isValidMovementCommand(command)) {
+    if (isValidMovementCommand(opcode)) {
         currentSession.totalMovements++;
 
         if (successful) {
@@ -199,19 +200,19 @@ void SessionManager::recordMovementCommand(const String& command, bool successfu
         }
 
         // Track command types for session type detection
-        if (command == "1") {
+        if (opcode == CommandOpcode::SEQUENTIAL) {
             currentSession.sequentialCommands++;
-        } else if (command == "2") {
+        } else if (opcode == CommandOpcode::SIMULTANEOUS) {
             currentSession.simultaneousCommands++;
-        } else if (command == "TEST") {
+        } else if (opcode == CommandOpcode::TEST) {
             currentSession.testCommands++;
         }
 
         // Update activity time
         lastActivityTime = millis();
 
-        Logger::debugf("Movement recorded: %s (Success: %s, Total: %d)",
-                      command.c_str(), successful ? "Yes" : "No", currentSession.totalMovements);
+        LOG_DEBUGF("Movement recorded: opcode %u (Success: %s, Total: %d)",
+                      (unsigned)opcode, successful ? "Yes" : "No", currentSession.totalMovements);
     }
 }
 
@@ -222,7 +223,7 @@ void SessionManager::recordMovementComplete(int cycles) {
     currentSession.totalCycles += cycles;
     lastActivityTime = millis();
 
-    Logger::debugf("Movement cycles completed: %d (Total: %d)", cycles, currentSession.totalCycles);
+    LOG_DEBUGF("Movement cycles completed: %d (Total: %d)", cycles, currentSession.totalCycles);
 }
 
 // Configuration methods
@@ -371,8 +372,11 @@ void SessionManager::updateSessionActivity() {
     // Currently just maintains the activity timestamp
 }
 
-bool SessionManager::isValidMovementCommand(const String& command) {
-    return (command == "0" || command == "1" || command == "2" || command == "TEST");
+bool SessionManager::isValidMovementCommand(CommandOpcode opcode) {
+    return opcode == CommandOpcode::HOME || opcode == CommandOpcode::SEQUENTIAL ||
+           opcode == CommandOpcode::SIMULTANEOUS || opcode == CommandOpcode::FINGER_TAPPING ||
+           opcode == CommandOpcode::GRADED_GRASP || opcode == CommandOpcode::WAVE ||
+           opcode == CommandOpcode::TEST;
 }
 
 void SessionManager::logSessionStart() {
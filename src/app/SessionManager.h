@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "../utils/Logger.h"
 #include "../utils/TimeManager.h"
+#include "Command.h"
 
 enum class SessionState {
     IDLE,           // No active session
@@ -57,14 +58,14 @@ public:
     bool isSessionActive();
 
     // Session information
-    String getCurrentSessionId();
+    const String& getCurrentSessionId();  // Empty when no session is active
     SessionState getCurrentState();
     SessionType getCurrentType();
     SessionInfo getCurrentSessionInfo();
     SessionStats getSessionStats();
 
     // Movement tracking
-    void recordMovementCommand(const String& command, bool successful);
+    void recordMovementCommand(CommandOpcode opcode, bool successful);
     void recordMovementComplete(int cycles);
 
     // Configuration
@@ -117,7 +118,7 @@ private:
     void updateSessionActivity();
 
     // Validation
-    bool isValidMovementCommand(const String& command);
+    bool isValidMovementCommand(CommandOpcode opcode);
 
     // Logging
     void logSessionStart();
@@ -0,0 +1,220 @@
+#include "BLELinkManager.h"
+#include <NimBLEDevice.h>
+#include "../utils/Logger.h"
+
+BLELinkManager::BLELinkManager()
+    : server(nullptr),
+      advertising(nullptr),
+      sessionActive(false),
+      pendingConnect(false),
+      connected(false),
+      idleSince(0),
+      lastRequestTime(0),
+      requestedProfile(BLELinkProfile::ACTIVE),
+      parameterUpdates(0),
+      intervalUnits(0),
+      peripheralLatency(0),
+      timeoutUnits(0),
+      advertisingStart(0),
+      advertisingSlow(false),
+      windowStartBytes(0),
+      windowStartTime(0),
+      notifyBytesPerSecond(0),
+      ackLatencyAvgUs(0),
+      ackLatencyMaxUs(0) {
+}
+
+// =============================================================================
+// SETUP AND EVENTS
+// =============================================================================
+
+void BLELinkManager::attach(NimBLEServer* server, NimBLEAdvertising* advertising) {
+    this->server = server;
+    this->advertising = advertising;
+}
+
+void BLELinkManager::setSessionActive(bool active) {
+    if (active == sessionActive) return;
+
+    if (!active) {
+        idleSince = millis();  // Written before the flag the BLE task keys on
+    }
+    sessionActive = active;
+
+    LOG_DEBUGF("BLE link: session %s", active ? "active" : "ended");
+}
+
+void BLELinkManager::onConnect() {
+    pendingConnect = true;
+    connected = true;
+}
+
+void BLELinkManager::onDisconnect() {
+    connected = false;
+    pendingConnect = false;
+    intervalUnits = 0;
+    peripheralLatency = 0;
+    timeoutUnits = 0;
+}
+
+void BLELinkManager::onAdvertisingStarted() {
+    advertisingStart = millis();
+    advertisingSlow = false;
+}
+
+void BLELinkManager::recordAckLatency(uint32_t latencyUs) {
+    if (ackLatencyAvgUs == 0) {
+        ackLatencyAvgUs = latencyUs;
+    } else {
+        ackLatencyAvgUs = ackLatencyAvgUs - ackLatencyAvgUs / 8 + latencyUs / 8;
+    }
+
+    if (latencyUs > ackLatencyMaxUs) {
+        ackLatencyMaxUs = latencyUs;
+    }
+}
+
+// =============================================================================
+// PERIODIC WORK
+// =============================================================================
+
+void BLELinkManager::update(uint32_t notifiedBytes) {
+    unsigned long now = millis();
+    updateThroughput(now, notifiedBytes);
+
+    if (!server) return;
+
+    if (!connected || server->getConnectedCount() == 0) {
+        updateAdvertising(now);
+        return;
+    }
+
+    if (pendingConnect) {
+        // Fast first, so the app can start a session without waiting
+        pendingConnect = false;
+        idleSince = now;
+        requestProfile(BLELinkProfile::ACTIVE, now);
+    } else {
+        bool responsive = sessionActive || now - idleSince < BLE_LINK_IDLE_DELAY;
+        BLELinkProfile desired = responsive ? BLELinkProfile::ACTIVE : BLELinkProfile::IDLE;
+
+        if (desired != requestedProfile && now - lastRequestTime >= BLE_LINK_UPDATE_SPACING) {
+            requestProfile(desired, now);
+        }
+    }
+
+    readParameters();
+}
+
+void BLELinkManager::requestProfile(BLELinkProfile profile, unsigned long now) {
+    NimBLEConnInfo info = server->getPeerInfo(0);
+
+    if (profile == BLELinkProfile::ACTIVE) {
+        server->updateConnParams(info.getConnHandle(),
+                                 BLE_LINK_ACTIVE_INTERVAL_MIN, BLE_LINK_ACTIVE_INTERVAL_MAX,
+                                 BLE_LINK_ACTIVE_LATENCY, BLE_LINK_ACTIVE_TIMEOUT);
+    } else {
+        server->updateConnParams(info.getConnHandle(),
+                                 BLE_LINK_IDLE_INTERVAL_MIN, BLE_LINK_IDLE_INTERVAL_MAX,
+                                 BLE_LINK_IDLE_LATENCY, BLE_LINK_IDLE_TIMEOUT);
+    }
+
+    requestedProfile = profile;
+    lastRequestTime = now;
+    parameterUpdates++;
+
+    Logger::infof("BLE link: requested %s connection parameters", profileName(profile));
+}
+
+void BLELinkManager::readParameters() {
+    NimBLEConnInfo info = server->getPeerInfo(0);
+    intervalUnits = info.getConnInterval();
+    peripheralLatency = info.getConnLatency();
+    timeoutUnits = info.getConnTimeout();
+}
+
+void BLELinkManager::updateAdvertising(unsigned long now) {
+    if (!advertising || !advertising->isAdvertising()) return;
+
+    // A session cut short by a disconnect wants the app back quickly
+    bool wantSlow = !sessionActive && now - advertisingStart >= BLE_ADVERTISING_FAST_TIMEOUT;
+    if (wantSlow == advertisingSlow) return;
+
+    uint16_t interval = advertisingUnits(wantSlow ? BLE_ADVERTISING_SLOW_INTERVAL
+                                                  : BLE_ADVERTISING_FAST_INTERVAL);
+
+    // Interval changes only take effect on a restart
+    NimBLEDevice::stopAdvertising();
+    advertising->setMinInterval(interval);
+    advertising->setMaxInterval(interval);
+    NimBLEDevice::startAdvertising();
+
+    advertisingSlow = wantSlow;
+    if (!wantSlow) {
+        advertisingStart = now;
+    }
+
+    Logger::infof("BLE advertising %s (%lu ms)", wantSlow ? "slowed down" : "sped up",
+                 wantSlow ? BLE_ADVERTISING_SLOW_INTERVAL : BLE_ADVERTISING_FAST_INTERVAL);
+}
+
+void BLELinkManager::updateThroughput(unsigned long now, uint32_t notifiedBytes) {
+    unsigned long elapsed = now - windowStartTime;
+    if (elapsed < THROUGHPUT_WINDOW) return;
+
+    notifyBytesPerSecond = (uint32_t)((uint64_t)(notifiedBytes - windowStartBytes) * 1000 / elapsed);
+    windowStartBytes = notifiedBytes;
+    windowStartTime = now;
+}
+
+uint16_t BLELinkManager::getAdvertisingInterval() {
+    return advertisingUnits(BLE_ADVERTISING_FAST_INTERVAL);
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+BLELinkStats BLELinkManager::getStats() {
+    BLELinkStats stats;
+    stats.profile = requestedProfile;
+    stats.connected = connected;
+    stats.intervalMs = intervalUnits * 1.25f;
+    stats.peripheralLatency = peripheralLatency;
+    stats.supervisionTimeoutMs = timeoutUnits * 10;
+    stats.worstDeliveryMs = (uint32_t)(stats.intervalMs * (peripheralLatency + 1));
+    stats.notifyBytesPerSecond = notifyBytesPerSecond;
+    stats.ackLatencyAvgUs = ackLatencyAvgUs;
+    stats.ackLatencyMaxUs = ackLatencyMaxUs;
+    stats.parameterUpdates = parameterUpdates;
+    stats.advertisingSlow = advertisingSlow;
+    return stats;
+}
+
+void BLELinkManager::logStatistics() {
+    BLELinkStats stats = getStats();
+
+    if (!stats.connected) {
+        Logger::infof("BLE link: not connected, advertising %s",
+                     stats.advertisingSlow ? "slow" : "fast");
+        return;
+    }
+
+    Logger::infof("BLE link: %s, interval %.2f ms, latency %u, worst delivery %lu ms",
+                 profileName(stats.profile), stats.intervalMs, stats.peripheralLatency,
+                 stats.worstDeliveryMs);
+    Logger::infof("BLE link: notify %lu B/s, ack latency avg %lu us (max %lu us)",
+                 stats.notifyBytesPerSecond, stats.ackLatencyAvgUs, stats.ackLatencyMaxUs);
+}
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+uint16_t BLELinkManager::advertisingUnits(unsigned long intervalMs) {
+    return (uint16_t)(intervalMs * 8 / 5);  // 0.625 ms units
+}
+
+const char* BLELinkManager::profileName(BLELinkProfile profile) {
+    return profile == BLELinkProfile::ACTIVE ? "active" : "idle";
+}
@@ -0,0 +1,113 @@
+#ifndef BLE_LINK_MANAGER_H
+#define BLE_LINK_MANAGER_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+
+class NimBLEServer;
+class NimBLEAdvertising;
+
+enum class BLELinkProfile {
+    ACTIVE,     // Short interval, no peripheral latency - sessions
+    IDLE        // Long interval with peripheral latency - saves radio power
+};
+
+struct BLELinkStats {
+    BLELinkProfile profile;          // Last profile requested from the central
+    bool connected;
+    float intervalMs;                // Negotiated connection interval
+    uint16_t peripheralLatency;      // Connection events the peripheral may skip
+    uint16_t supervisionTimeoutMs;
+    uint32_t worstDeliveryMs;        // interval * (latency + 1)
+    uint32_t notifyBytesPerSecond;   // Measured over the last window
+    uint32_t ackLatencyAvgUs;        // Command write received -> ack queued
+    uint32_t ackLatencyMaxUs;
+    uint32_t parameterUpdates;
+    bool advertisingSlow;
+};
+
+// =============================================================================
+// BLE LINK MANAGER
+// =============================================================================
+
+/**
+ * Trades radio power for responsiveness on the BLE link.
+ *
+ * While a session is active (and for BLE_LINK_IDLE_DELAY after it, and right
+ * after connecting) the central is asked for the 7.5-15 ms ACTIVE profile.
+ * Otherwise the link drops to the IDLE profile with a long interval and
+ * peripheral latency. Requests are spaced by BLE_LINK_UPDATE_SPACING; the
+ * central has the final word, so the statistics report what was negotiated.
+ *
+ * Advertising starts fast and slows to BLE_ADVERTISING_SLOW_INTERVAL after
+ * BLE_ADVERTISING_FAST_TIMEOUT, unless a session is waiting for a reconnect.
+ *
+ * update() runs on the BLE server task; setSessionActive() may be called from
+ * any task and recordAckLatency() from the NimBLE host task.
+ */
+class BLELinkManager {
+public:
+    BLELinkManager();
+
+    // Setup
+    void attach(NimBLEServer* server, NimBLEAdvertising* advertising);
+
+    // Events
+    void setSessionActive(bool active);
+    void onConnect();
+    void onDisconnect();
+    void onAdvertisingStarted();
+    void recordAckLatency(uint32_t latencyUs);
+
+    // Periodic work - notifiedBytes is the running total sent by notification
+    void update(uint32_t notifiedBytes);
+
+    // Advertising interval to start with, in 0.625 ms units
+    uint16_t getAdvertisingInterval();
+
+    // Statistics
+    BLELinkStats getStats();
+    void logStatistics();
+
+private:
+    NimBLEServer* server;
+    NimBLEAdvertising* advertising;
+
+    // Profile selection
+    volatile bool sessionActive;
+    volatile bool pendingConnect;
+    volatile bool connected;
+    unsigned long idleSince;
+    unsigned long lastRequestTime;
+    BLELinkProfile requestedProfile;
+    uint32_t parameterUpdates;
+
+    // Negotiated parameters (raw units)
+    uint16_t intervalUnits;          // 1.25 ms
+    uint16_t peripheralLatency;
+    uint16_t timeoutUnits;           // 10 ms
+
+    // Advertising
+    unsigned long advertisingStart;
+    bool advertisingSlow;
+
+    // Throughput and latency
+    uint32_t windowStartBytes;
+    unsigned long windowStartTime;
+    uint32_t notifyBytesPerSecond;
+    uint32_t ackLatencyAvgUs;        // Moving average, 1/8 weight per sample
+    uint32_t ackLatencyMaxUs;
+
+    // Helpers
+    void requestProfile(BLELinkProfile profile, unsigned long now);
+    void readParameters();
+    void updateAdvertising(unsigned long now);
+    void updateThroughput(unsigned long now, uint32_t notifiedBytes);
+
+    static uint16_t advertisingUnits(unsigned long intervalMs);
+    static const char* profileName(BLELinkProfile profile);
+
+    static const unsigned long THROUGHPUT_WINDOW = 1000;  // ms
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "../utils/Logger.h"
 #include "../utils/ErrorHandler.h"
 #include "../hardware/FreeRTOSManager.h"
+#include "../hardware/ResourceProfiler.h"
 #include "../memory/StaticBLEMemory.h"
 #include "../memory/NimBLEStaticConfig.h"
 
@@ -23,9 +24,12 @@ void BLEManager::initialize() {
     connectionStartTime = 0;
     connectionCount = 0;
     commandCount = 0;
+    fastCommandCount = 0;
     lastCommandTime = 0;
     connectionCallback = nullptr;
     commandCallback = nullptr;
+    fastCommandCallback = nullptr;
+    notifiedBytes = 0;
     taskHandle = nullptr;
     taskRunning = false;
 
@@ -70,17 +74,26 @@ void BLEManager::initialize() {
         // Create BLE Characteristic
         pCharacteristic = pService->createCharacteristic(
             BLE_CHARACTERISTIC_UUID,
-            NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::NOTIFY
+            NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR |
+            NIMBLE_PROPERTY::NOTIFY
         );
 
         Logger::infof("BLE Characteristic created with UUID: %s", BLE_CHARACTERISTIC_UUID);
-        Logger::infof("BLE Characteristic properties: READ | WRITE | NOTIFY");
+        Logger::infof("BLE Characteristic properties: READ | WRITE | WRITE_NR | NOTIFY");
 
         pCharacteristic->setCallbacks(new CharacteristicCallbacks(this));
         pCharacteristic->setValue("Ready");
 
         Logger::info("BLE Characteristic callbacks set and initial value set to 'Ready'");
 
+        // Live data stream (notify only)
+        pStreamCharacteristic = pService->createCharacteristic(
+            BLE_STREAM_CHARACTERISTIC_UUID,
+            NIMBLE_PROPERTY::NOTIFY
+        );
+        streamer.attach(pServer, pStreamCharacteristic);
+        Logger::infof("BLE stream characteristic created with UUID: %s", BLE_STREAM_CHARACTERISTIC_UUID);
+
         // Start the service
         pService->start();
 
@@ -89,14 +102,16 @@ void BLEManager::initialize() {
         pAdvertising->addServiceUUID(BLE_SERVICE_UUID);
         pAdvertising->setScanResponse(false);
         pAdvertising->setMinPreferred(0x0);  // Set value to 0x00 to not advertise this parameter
+        linkManager.attach(pServer, pAdvertising);
 
         initialized = true;
         currentStatus = BLEStatus::DISCONNECTED;
 
         startAdvertising();
 
-        // Start the BLE management task
+        // Start the BLE management and stream tasks
         startTask();
+        streamer.startTask();
 
         Logger::info("BLE Manager initialized successfully with Static Memory and FreeRTOS task");
 
@@ -140,6 +155,7 @@ void BLEManager::shutdown() {
 
     Logger::info("Shutting down BLE Manager...");
 
+    streamer.stopTask();
     stopTask();
     stopAdvertising();
 
@@ -171,10 +187,11 @@ void BLEManager::startAdvertising() {
 
         // Configure advertising parameters
         pAdvertising->setAdvertisementType(BLE_GAP_CONN_MODE_UND);
-        pAdvertising->setMinInterval(ADVERTISING_INTERVAL);
-        pAdvertising->setMaxInterval(ADVERTISING_INTERVAL);
+        pAdvertising->setMinInterval(linkManager.getAdvertisingInterval());
+        pAdvertising->setMaxInterval(linkManager.getAdvertisingInterval());
 
         NimBLEDevice::startAdvertising();
+        linkManager.onAdvertisingStarted();
 
         currentStatus = BLEStatus::ADVERTISING;
         Logger::infof("BLE advertising started with improved parameters (Device: %s)", BLE_DEVICE_NAME);
@@ -241,6 +258,26 @@ void BLEManager::setCommandCallback(void (*callback)(const String& command)) {
     commandCallback = callback;
 }
 
+void BLEManager::setFastCommandCallback(BLECommandStatus (*callback)(const BLECommandFrame& frame)) {
+    fastCommandCallback = callback;
+}
+
+void BLEManager::setStreamSampleProvider(void (*provider)(BLEStreamSample& sample)) {
+    streamer.setSampleProvider(provider);
+}
+
+BLEStreamer& BLEManager::getStreamer() {
+    return streamer;
+}
+
+void BLEManager::setSessionActive(bool active) {
+    linkManager.setSessionActive(active);
+}
+
+BLELinkManager& BLEManager::getLinkManager() {
+    return linkManager;
+}
+
 unsigned long BLEManager::getConnectionTime() {
     if (isConnected() && connectionStartTime > 0) {
         return millis() - connectionStartTime;
@@ -256,6 +293,10 @@ int BLEManager::getCommandCount() {
     return commandCount;
 }
 
+int BLEManager::getFastCommandCount() {
+    return fastCommandCount;
+}
+
 unsigned long BLEManager::getLastCommandTime() {
     return lastCommandTime;
 }
@@ -293,9 +334,9 @@ void BLEManager::processIncomingCommand(const String& command) {
 
     // Notify via callback if set
     if (commandCallback) {
-        Logger::info("BLE calling command callback...");
+        LOG_DEBUG("BLE calling command callback...");
         commandCallback(command);
-        Logger::info("BLE command callback completed");
+        LOG_DEBUG("BLE command callback completed");
     } else {
         Logger::warning("BLE command callback is not set!");
     }
@@ -335,6 +376,7 @@ void BLEManager::sendTestNotification(const String& message) {
         Logger::infof("BLE sending test notification: %s", message.c_str());
         pCharacteristic->setValue(message.c_str());
         pCharacteristic->notify();
+        notifiedBytes += message.length();
     } else {
         Logger::warning("BLE cannot send notification - not connected or not initialized");
     }
@@ -348,13 +390,13 @@ void BLEManager::simulateCommand(const String& command) {
 String BLEManager::decodeBase64Command(const String& encodedCommand) {
     // Handle empty input
     if (encodedCommand.length() == 0) {
-        Logger::debug("BLE Base64 decode: empty input");
+        LOG_DEBUG("BLE Base64 decode: empty input");
         return "";
     }
 
     // Quick check: if it's a simple command (single digit or known command), it's probably plain text
     if (encodedCommand.length() <= 2 && (encodedCommand == "0" || encodedCommand == "1" || encodedCommand == "2")) {
-        Logger::debugf("BLE Base64 decode: '%s' appears to be plain text, skipping decode", encodedCommand.c_str());
+        LOG_DEBUGF("BLE Base64 decode: '%s' appears to be plain text, skipping decode", encodedCommand.c_str());
         return "";  // Return empty to indicate no Base64 decoding needed
     }
 
@@ -369,7 +411,7 @@ String BLEManager::decodeBase64Command(const String& encodedCommand) {
                                    encodedCommand.length(), &decoded_length);
 
         if (decoded_data == nullptr || decoded_length == 0) {
-            Logger::debugf("BLE Base64 decode: failed for '%s' (probably plain text)", encodedCommand.c_str());
+            LOG_DEBUGF("BLE Base64 decode: failed for '%s' (probably plain text)", encodedCommand.c_str());
             if (decoded_data) free(decoded_data);
             return "";
         }
@@ -388,50 +430,168 @@ String BLEManager::decodeBase64Command(const String& encodedCommand) {
 
         // Validate that the decoded result makes sense
         if (decoded.length() == 0 || decoded.length() > 20) {
-            Logger::debugf("BLE Base64 decode: invalid result length for '%s'", encodedCommand.c_str());
+            LOG_DEBUGF("BLE Base64 decode: invalid result length for '%s'", encodedCommand.c_str());
             return "";
         }
 
-        Logger::debugf("BLE Base64 decode successful: '%s' -> '%s'",
+        LOG_DEBUGF("BLE Base64 decode successful: '%s' -> '%s'",
                       encodedCommand.c_str(), decoded.c_str());
 
         return decoded;
 
     } catch (const std::exception& e) {
-        Logger::debugf("BLE Base64 decode exception: %s (probably plain text)", e.what());
+        LOG_DEBUGF("BLE Base64 decode exception: %s (probably plain text)", e.what());
         return "";
     } catch (...) {
-        Logger::debugf("BLE Base64 decode unknown exception for: '%s' (probably plain text)", encodedCommand.c_str());
+        LOG_DEBUGF("BLE Base64 decode unknown exception for: '%s' (probably plain text)", encodedCommand.c_str());
         return "";
     }
 }
 
+// =============================================================================
+// BINARY COMMAND FRAMES
+// =============================================================================
+
+bool BLEManager::handleCommandFrame(const uint8_t* data, size_t length, int64_t receivedUs) {
+    if (!data || length == 0) return false;
+
+    // Raw frames start with the marker, base64 encoded ones with '/'
+    uint8_t decoded[BLE_COMMAND_FRAME_SIZE + 3];
+    if (data[0] != BLE_COMMAND_FRAME_MARKER) {
+        if (data[0] != '/' || length > 8) return false;
+
+        length = decodeBase64(data, length, decoded, sizeof(decoded));
+        if (length == 0 || decoded[0] != BLE_COMMAND_FRAME_MARKER) return false;
+        data = decoded;
+    }
+
+    BLECommandFrame frame;
+    frame.receivedUs = receivedUs;
+    if (!parseCommandFrame(data, length, frame)) {
+        Logger::warningf("BLE malformed command frame (%d bytes)", (int)length);
+        sendCommandAck(length > 1 ? (BLECommandOpcode)data[1] : BLECommandOpcode::HOME,
+                       length > 2 ? data[2] : 0, BLECommandStatus::INVALID);
+        return true;
+    }
+
+    fastCommandCount++;
+    lastCommandTime = millis();
+
+    BLECommandStatus status = BLECommandStatus::REJECTED;
+    if (fastCommandCallback) {
+        status = fastCommandCallback(frame);
+    } else {
+        Logger::warning("BLE fast command callback is not set!");
+    }
+
+    sendCommandAck(frame.opcode, frame.sequence, status);
+    linkManager.recordAckLatency((uint32_t)(esp_timer_get_time() - receivedUs));
+    LOG_DEBUGF("BLE command frame 0x%02x #%d -> %d", (uint8_t)frame.opcode, frame.sequence, (int)status);
+    return true;
+}
+
+bool BLEManager::parseCommandFrame(const uint8_t* data, size_t length, BLECommandFrame& frame) {
+    if (length != BLE_COMMAND_FRAME_SIZE || data[0] != BLE_COMMAND_FRAME_MARKER) return false;
+
+    switch ((BLECommandOpcode)data[1]) {
+        case BLECommandOpcode::HOME:
+        case BLECommandOpcode::SEQUENTIAL:
+        case BLECommandOpcode::SIMULTANEOUS:
+        case BLECommandOpcode::FINGER_TAPPING:
+        case BLECommandOpcode::GRADED_GRASP:
+        case BLECommandOpcode::WAVE:
+        case BLECommandOpcode::STOP:
+        case BLECommandOpcode::EMERGENCY_STOP:
+            break;
+        default:
+            return false;
+    }
+
+    frame.opcode = (BLECommandOpcode)data[1];
+    frame.sequence = data[2];
+    return true;
+}
+
+size_t BLEManager::decodeBase64(const uint8_t* input, size_t length, uint8_t* output, size_t outputSize) {
+    uint32_t accumulator = 0;
+    uint8_t bits = 0;
+    size_t written = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = input[i];
+        uint8_t value;
+
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') value = c - '0' + 52;
+        else if (c == '+') value = 62;
+        else if (c == '/') value = 63;
+        else if (c == '=') break;
+        else return 0;
+
+        accumulator = (accumulator << 6) | value;
+        bits += 6;
+
+        if (bits >= 8) {
+            bits -= 8;
+            if (written >= outputSize) return 0;
+            output[written++] = (uint8_t)(accumulator >> bits);
+        }
+    }
+
+    return written;
+}
+
+void BLEManager::sendCommandAck(BLECommandOpcode opcode, uint8_t sequence, BLECommandStatus status) {
+    if (!pCharacteristic || !deviceConnected) return;
+
+    uint8_t ack[4] = {
+        BLE_COMMAND_FRAME_MARKER,
+        (uint8_t)((uint8_t)opcode | BLE_COMMAND_ACK_FLAG),
+        sequence,
+        (uint8_t)status
+    };
+    pCharacteristic->setValue(ack, sizeof(ack));
+    pCharacteristic->notify();
+    notifiedBytes += sizeof(ack);
+}
+
 // ServerCallbacks implementation
 void BLEManager::ServerCallbacks::onConnect(BLEServer* pServer) {
     Logger::info("BLE ServerCallbacks::onConnect called");
     bleManager->deviceConnected = true;
 
-    // Set connection parameters for better performance
-    pServer->updateConnParams(0,  // Connection ID 0 for first connection
-                             BLEManager::CONNECTION_INTERVAL_MIN,
-                             BLEManager::CONNECTION_INTERVAL_MAX,
-                             0, 400);
-
-    Logger::info("BLE connection parameters updated");
+    // Connection parameters are requested by the link manager from the BLE task
+    bleManager->linkManager.onConnect();
+    bleManager->streamer.onConnect();
 }
 
 void BLEManager::ServerCallbacks::onDisconnect(BLEServer* pServer) {
     Logger::info("BLE ServerCallbacks::onDisconnect called");
     bleManager->deviceConnected = false;
+    bleManager->linkManager.onDisconnect();
+    bleManager->streamer.onDisconnect();
+}
+
+void BLEManager::ServerCallbacks::onMTUChange(uint16_t MTU, ble_gap_conn_desc* desc) {
+    Logger::infof("BLE MTU changed to %u", MTU);
+    bleManager->streamer.onConnect();  // Re-read the link and resize frames
 }
 
 // CharacteristicCallbacks implementation
 void BLEManager::CharacteristicCallbacks::onWrite(BLECharacteristic* pCharacteristic) {
-    std::string stdValue = pCharacteristic->getValue();
-    String rawValue = stdValue.c_str();
+    int64_t receivedUs = esp_timer_get_time();
+
+    // Binary frames are parsed straight out of the attribute buffer
+    NimBLEAttValue value = pCharacteristic->getValue();
+    if (bleManager->handleCommandFrame(value.data(), value.length(), receivedUs)) {
+        return;
+    }
+
+    String rawValue = value.c_str();
 
-    Logger::infof("BLE onWrite called - Raw data length: %d", stdValue.length());
-    Logger::infof("BLE onWrite called - Raw value: '%s'", rawValue.c_str());
+    LOG_DEBUGF("BLE onWrite called - Raw data length: %d", value.length());
+    LOG_DEBUGF("BLE onWrite called - Raw value: '%s'", rawValue.c_str());
 
     if (rawValue.length() > 0) {
         String commandToProcess = rawValue;
@@ -441,16 +601,16 @@ void BLEManager::CharacteristicCallbacks::onWrite(BLECharacteristic* pCharacteri
 
         if (decodedCommand.length() > 0) {
             // Base64 decoding successful
-            Logger::infof("BLE decoded Base64 command: '%s' (from: '%s')",
+            LOG_DEBUGF("BLE decoded Base64 command: '%s' (from: '%s')",
                          decodedCommand.c_str(), rawValue.c_str());
             commandToProcess = decodedCommand;
         } else {
             // Base64 decoding failed, assume plain text
-            Logger::infof("BLE using plain text command: '%s'", rawValue.c_str());
+            LOG_DEBUGF("BLE using plain text command: '%s'", rawValue.c_str());
             commandToProcess = rawValue;
         }
 
-        Logger::infof("BLE processing command: '%s'", commandToProcess.c_str());
+        LOG_DEBUGF("BLE processing command: '%s'", commandToProcess.c_str());
         bleManager->processIncomingCommand(commandToProcess);
     } else {
         Logger::warning("BLE onWrite called but value is empty");
@@ -467,7 +627,7 @@ void BLEManager::startTask() {
     BaseType_t result = xTaskCreatePinnedToCore(
         bleServerTask,
         "BLEServer",
-        TASK_STACK_BLE_SERVER,
+        ResourceProfiler::getStackSize(ProfiledTask::BLE_SERVER),
         this,
         PRIORITY_BLE_SERVER,
         &taskHandle,
@@ -509,6 +669,9 @@ void BLEManager::bleServerTask(void* parameter) {
             manager->startAdvertising();
         }
 
+        // Connection parameters, advertising interval and throughput window
+        manager->linkManager.update(manager->notifiedBytes + manager->streamer.getBytesSent());
+
         // Feed watchdog - now that FreeRTOS Manager is re-enabled
         FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
 
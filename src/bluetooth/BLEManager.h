@@ -8,7 +8,10 @@
 #include <NimBLECharacteristic.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <esp_timer.h>
 #include "../config/Config.h"
+#include "BLEStreamer.h"
+#include "BLELinkManager.h"
 
 enum class BLEStatus {
     UNINITIALIZED,
@@ -19,6 +22,48 @@ enum class BLEStatus {
     ERROR
 };
 
+// =============================================================================
+// BINARY COMMAND FRAMES
+// =============================================================================
+
+/**
+ * Fast command path. A write starting with BLE_COMMAND_FRAME_MARKER is a
+ * frame [marker, opcode, sequence] that is parsed in place from the
+ * characteristic value and handed to the fast command callback, without
+ * the String text path. Frames may also arrive base64 encoded; the marker
+ * makes the encoded form start with '/', which no text command does.
+ * Every frame is answered with a notification
+ * [marker, opcode | BLE_COMMAND_ACK_FLAG, sequence, BLECommandStatus].
+ */
+
+const uint8_t BLE_COMMAND_FRAME_MARKER = 0xFE;
+const uint8_t BLE_COMMAND_ACK_FLAG = 0x80;
+const size_t BLE_COMMAND_FRAME_SIZE = 3;
+
+enum class BLECommandOpcode : uint8_t {
+    HOME = 0x00,            // Same codes as the text movement commands
+    SEQUENTIAL = 0x01,
+    SIMULTANEOUS = 0x02,
+    FINGER_TAPPING = 0x03,  // Exercise library
+    GRADED_GRASP = 0x04,
+    WAVE = 0x05,
+    STOP = 0x10,
+    EMERGENCY_STOP = 0x11
+};
+
+enum class BLECommandStatus : uint8_t {
+    ACCEPTED = 0,
+    REJECTED = 1,           // Device state does not allow the command
+    BUSY = 2,               // Command queue full
+    INVALID = 3             // Malformed frame or unknown opcode
+};
+
+struct BLECommandFrame {
+    int64_t receivedUs;     // esp_timer_get_time() when the write arrived
+    BLECommandOpcode opcode;
+    uint8_t sequence;
+};
+
 class BLEManager {
 public:
     // Initialization and lifecycle
@@ -50,6 +95,15 @@ public:
     // Connection callbacks
     void setConnectionCallback(void (*callback)(bool connected));
     void setCommandCallback(void (*callback)(const String& command));
+    void setFastCommandCallback(BLECommandStatus (*callback)(const BLECommandFrame& frame));
+
+    // Link power management
+    void setSessionActive(bool active);
+    BLELinkManager& getLinkManager();
+
+    // Live data stream
+    void setStreamSampleProvider(void (*provider)(BLEStreamSample& sample));
+    BLEStreamer& getStreamer();
 
     // Testing and debugging
     void sendTestNotification(const String& message);
@@ -62,13 +116,18 @@ public:
     unsigned long getConnectionTime();
     int getConnectionCount();
     int getCommandCount();
+    int getFastCommandCount();
     unsigned long getLastCommandTime();
 
 private:
     BLEServer* pServer;
     BLEService* pService;
     BLECharacteristic* pCharacteristic;
+    BLECharacteristic* pStreamCharacteristic;
     BLEAdvertising* pAdvertising;
+    BLEStreamer streamer;
+    BLELinkManager linkManager;
+    volatile uint32_t notifiedBytes;  // Command channel notifications
     
     BLEStatus currentStatus;
     bool initialized;
@@ -79,10 +138,12 @@ private:
     unsigned long connectionStartTime;
     int connectionCount;
     int commandCount;
+    int fastCommandCount;
     unsigned long lastCommandTime;
     
     void (*connectionCallback)(bool connected);
     void (*commandCallback)(const String& command);
+    BLECommandStatus (*fastCommandCallback)(const BLECommandFrame& frame);
 
     // FreeRTOS task management
     TaskHandle_t taskHandle;
@@ -96,13 +157,12 @@ private:
     // Helper methods
     void handleConnectionEvents();
     void processIncomingCommand(const String& command);
+    bool handleCommandFrame(const uint8_t* data, size_t length, int64_t receivedUs);
+    void sendCommandAck(BLECommandOpcode opcode, uint8_t sequence, BLECommandStatus status);
+    static bool parseCommandFrame(const uint8_t* data, size_t length, BLECommandFrame& frame);
+    static size_t decodeBase64(const uint8_t* input, size_t length, uint8_t* output, size_t outputSize);
     void logConnectionStatus();
     void notifyConnectionChange(bool connected);
-    
-    // Configuration
-    static const uint32_t ADVERTISING_INTERVAL = 100;  // milliseconds
-    static const uint16_t CONNECTION_INTERVAL_MIN = 6;   // 7.5ms
-    static const uint16_t CONNECTION_INTERVAL_MAX = 12;  // 15ms
 };
 
 // Callback class declarations
@@ -112,6 +172,7 @@ public:
     
     void onConnect(BLEServer* pServer) override;
     void onDisconnect(BLEServer* pServer) override;
+    void onMTUChange(uint16_t MTU, ble_gap_conn_desc* desc) override;
     
 private:
     BLEManager* bleManager;
@@ -0,0 +1,283 @@
+#include "BLEStreamer.h"
+#include "../utils/Logger.h"
+#include "../hardware/ResourceProfiler.h"
+
+// Free blocks in the NimBLE msys pools
+extern "C" {
+    int os_msys_num_free(void);
+}
+
+BLEStreamer::BLEStreamer()
+    : server(nullptr),
+      characteristic(nullptr),
+      sampleProvider(nullptr),
+      taskHandle(nullptr),
+      taskRunning(false),
+      sampleCount(0),
+      sequence(0),
+      linkDirty(true),
+      mtu(DEFAULT_MTU),
+      connectionIntervalMs(0),
+      frameIntervalMs(BLE_STREAM_MIN_FRAME_INTERVAL),
+      sampleIntervalMs(BLE_STREAM_SAMPLE_INTERVAL),
+      samplesPerFrame(1),
+      backoff(0),
+      lastLinkRefresh(0),
+      notifyFailures(0),
+      framesSent(0),
+      framesSkipped(0),
+      framesFailed(0),
+      bytesSent(0) {
+}
+
+// =============================================================================
+// SETUP
+// =============================================================================
+
+void BLEStreamer::attach(NimBLEServer* server, NimBLECharacteristic* characteristic) {
+    this->server = server;
+    this->characteristic = characteristic;
+
+    if (characteristic) {
+        characteristic->setCallbacks(new StreamCallbacks(this));
+    }
+}
+
+void BLEStreamer::setSampleProvider(void (*provider)(BLEStreamSample& sample)) {
+    sampleProvider = provider;
+}
+
+// =============================================================================
+// FREERTOS TASK MANAGEMENT
+// =============================================================================
+
+void BLEStreamer::startTask() {
+    if (!BLE_STREAM_ENABLED || taskRunning || taskHandle || !characteristic) return;
+
+    taskRunning = true;
+    BaseType_t result = xTaskCreatePinnedToCore(
+        streamTask,
+        "BLEStream",
+        ResourceProfiler::getStackSize(ProfiledTask::BLE_STREAM),
+        this,
+        PRIORITY_BLE_STREAM,
+        &taskHandle,
+        CORE_PROTOCOL  // Same core as the NimBLE host
+    );
+
+    if (result == pdPASS) {
+        Logger::info("BLE stream task started on Core 0");
+    } else {
+        taskRunning = false;
+        Logger::error("Failed to create BLE stream task");
+    }
+}
+
+void BLEStreamer::stopTask() {
+    if (!taskRunning || !taskHandle) return;
+
+    taskRunning = false;
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+
+    Logger::info("BLE stream task stopped");
+}
+
+bool BLEStreamer::isTaskRunning() {
+    return taskRunning;
+}
+
+void BLEStreamer::streamTask(void* parameter) {
+    BLEStreamer* streamer = (BLEStreamer*)parameter;
+    TickType_t lastWakeTime = xTaskGetTickCount();
+
+    while (streamer->taskRunning) {
+        if (!streamer->isSubscribed()) {
+            streamer->resetFrame();
+            vTaskDelay(pdMS_TO_TICKS(IDLE_POLL_INTERVAL));
+            lastWakeTime = xTaskGetTickCount();
+            continue;
+        }
+
+        unsigned long now = millis();
+        if (streamer->linkDirty || now - streamer->lastLinkRefresh >= BLE_STREAM_LINK_REFRESH_INTERVAL) {
+            streamer->refreshLink(now);
+        }
+
+        streamer->addSample(now);
+        if (streamer->sampleCount >= streamer->samplesPerFrame) {
+            streamer->sendFrame();
+        }
+
+        vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(streamer->sampleIntervalMs));
+    }
+
+    vTaskDelete(nullptr);  // Delete self
+}
+
+// =============================================================================
+// LINK STATE
+// =============================================================================
+
+void BLEStreamer::onConnect() {
+    linkDirty = true;
+}
+
+void BLEStreamer::onDisconnect() {
+    linkDirty = true;
+}
+
+bool BLEStreamer::isSubscribed() {
+    return characteristic && characteristic->getSubscribedCount() > 0;
+}
+
+void BLEStreamer::refreshLink(unsigned long now) {
+    if (linkDirty) {
+        // New link or MTU - start over without backoff
+        backoff = 0;
+        notifyFailures.store(0);
+        resetFrame();
+    }
+
+    if (server && server->getConnectedCount() > 0) {
+        NimBLEConnInfo info = server->getPeerInfo(0);
+        mtu = min((uint16_t)info.getMTU(), (uint16_t)NimBLEConfig::ATT_MTU_SIZE);
+        connectionIntervalMs = (info.getConnInterval() * 5) / 4;  // 1.25 ms units
+    }
+
+    linkDirty = false;
+    lastLinkRefresh = now;
+    recalculateRates();
+}
+
+void BLEStreamer::recalculateRates() {
+    uint16_t payload = mtu > NOTIFY_HEADER_SIZE + sizeof(BLEStreamFrameHeader)
+                     ? mtu - NOTIFY_HEADER_SIZE - sizeof(BLEStreamFrameHeader) : 0;
+    unsigned long capacity = max(1UL, (unsigned long)(payload / sizeof(BLEStreamSample)));
+    capacity = min(capacity, 255UL);
+
+    unsigned long interval = max(BLE_STREAM_MIN_FRAME_INTERVAL,
+                                 (unsigned long)connectionIntervalMs * BLE_STREAM_EVENTS_PER_FRAME);
+    interval <<= backoff;
+
+    // Sample slower when one frame cannot hold a whole interval
+    sampleIntervalMs = max(BLE_STREAM_SAMPLE_INTERVAL, (interval + capacity - 1) / capacity);
+    sampleIntervalMs = min(sampleIntervalMs, 255UL);  // Header field is one byte
+
+    samplesPerFrame = (uint8_t)constrain(interval / sampleIntervalMs, 1UL, capacity);
+    frameIntervalMs = samplesPerFrame * sampleIntervalMs;
+
+    LOG_DEBUGF("BLE stream: MTU %u, conn interval %u ms -> %u samples every %lu ms",
+               mtu, connectionIntervalMs, samplesPerFrame, frameIntervalMs);
+}
+
+void BLEStreamer::adjustBackoff(bool congested) {
+    if (congested && backoff < BLE_STREAM_MAX_BACKOFF) {
+        backoff++;
+        recalculateRates();
+    } else if (!congested && backoff > 0) {
+        backoff--;
+        recalculateRates();
+    }
+}
+
+// =============================================================================
+// FRAME BUILDING
+// =============================================================================
+
+void BLEStreamer::addSample(unsigned long now) {
+    if (sampleCount == 0) {
+        BLEStreamFrameHeader* header = (BLEStreamFrameHeader*)frame;
+        header->baseTimeMs = now;
+    }
+
+    BLEStreamSample sample = {};
+    if (sampleProvider) {
+        sampleProvider(sample);
+    }
+
+    memcpy(frame + sizeof(BLEStreamFrameHeader) + sampleCount * sizeof(BLEStreamSample),
+           &sample, sizeof(sample));
+    sampleCount++;
+}
+
+void BLEStreamer::sendFrame() {
+    if (sampleCount == 0) return;
+
+    uint32_t failures = notifyFailures.exchange(0);
+    framesFailed += failures;
+
+    BLEStreamFrameHeader* header = (BLEStreamFrameHeader*)frame;
+    header->magic = BLE_STREAM_FRAME_MAGIC;
+    header->version = BLE_STREAM_FRAME_VERSION;
+    header->sequence = sequence++;
+    header->sampleIntervalMs = (uint8_t)sampleIntervalMs;
+    header->sampleCount = sampleCount;
+
+    size_t length = sizeof(BLEStreamFrameHeader) + sampleCount * sizeof(BLEStreamSample);
+    resetFrame();
+
+    // Leave the buffer reserve to command traffic - the frame is dropped
+    if (os_msys_num_free() <= BLE_STREAM_MSYS_RESERVE) {
+        framesSkipped++;
+        adjustBackoff(true);
+        return;
+    }
+
+    characteristic->notify(frame, length);
+    framesSent++;
+    bytesSent += length;
+
+    adjustBackoff(failures > 0);
+}
+
+void BLEStreamer::resetFrame() {
+    sampleCount = 0;
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+bool BLEStreamer::isStreaming() {
+    return taskRunning && isSubscribed();
+}
+
+uint32_t BLEStreamer::getFramesSent() {
+    return framesSent;
+}
+
+uint32_t BLEStreamer::getFramesSkipped() {
+    return framesSkipped;
+}
+
+uint32_t BLEStreamer::getFramesFailed() {
+    return framesFailed;
+}
+
+uint32_t BLEStreamer::getBytesSent() {
+    return bytesSent;
+}
+
+unsigned long BLEStreamer::getFrameInterval() {
+    return frameIntervalMs;
+}
+
+unsigned long BLEStreamer::getSampleInterval() {
+    return sampleIntervalMs;
+}
+
+uint16_t BLEStreamer::getMTU() {
+    return mtu;
+}
+
+// =============================================================================
+// NOTIFICATION STATUS
+// =============================================================================
+
+void BLEStreamer::StreamCallbacks::onStatus(NimBLECharacteristic* pCharacteristic, Status status, int code) {
+    // Called from the NimBLE host task; failures are picked up by the next frame
+    if (status == Status::ERROR_GATT) {
+        streamer->notifyFailures++;
+    }
+}
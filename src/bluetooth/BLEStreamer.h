@@ -0,0 +1,153 @@
+#ifndef BLE_STREAMER_H
+#define BLE_STREAMER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <NimBLEServer.h>
+#include <NimBLECharacteristic.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config/Config.h"
+#include "../memory/NimBLEStaticConfig.h"
+
+// =============================================================================
+// LIVE STREAM FRAME LAYOUT
+// =============================================================================
+
+/**
+ * Notification frames on BLE_STREAM_CHARACTERISTIC_UUID. A frame is a
+ * BLEStreamFrameHeader followed by sampleCount BLEStreamSample entries taken
+ * sampleIntervalMs apart, the first at baseTimeMs. A frame never exceeds
+ * the negotiated ATT MTU minus the 3 byte notification header. All fields
+ * are little-endian.
+ */
+
+const uint8_t BLE_STREAM_FRAME_MAGIC = 'L';
+const uint8_t BLE_STREAM_FRAME_VERSION = 1;
+const uint8_t BLE_STREAM_SERVO_COUNT = 3;
+
+const uint8_t STREAM_FLAG_FINGER_DETECTED = 0x01;
+const uint8_t STREAM_FLAG_MOVING = 0x02;
+const uint8_t STREAM_FLAG_SESSION_ACTIVE = 0x04;
+
+struct __attribute__((packed)) BLEStreamFrameHeader {
+    uint8_t magic;             // BLE_STREAM_FRAME_MAGIC
+    uint8_t version;           // BLE_STREAM_FRAME_VERSION
+    uint16_t sequence;         // Increments per frame, gaps are dropped frames
+    uint32_t baseTimeMs;       // millis() of the first sample
+    uint8_t sampleIntervalMs;
+    uint8_t sampleCount;
+};
+
+struct __attribute__((packed)) BLEStreamSample {
+    uint16_t heartRateX10;     // BPM * 10, 0 without a reading
+    uint8_t spO2;              // Percent, 0 without a reading
+    uint8_t flags;             // STREAM_FLAG_*
+    uint8_t servoState;        // ServoState
+    uint8_t progress;          // Movement progress in percent
+    uint8_t angles[BLE_STREAM_SERVO_COUNT];  // Degrees
+};
+
+// =============================================================================
+// BLE STREAMER
+// =============================================================================
+
+/**
+ * Live sensor and servo feed for the mobile app.
+ *
+ * While a client is subscribed, the stream task samples the state through
+ * the sample provider and packs the samples into one MTU-sized notification
+ * per frame interval. The frame interval follows the negotiated connection
+ * interval (BLE_STREAM_EVENTS_PER_FRAME events per frame), and the sample
+ * interval is stretched when a frame could not hold every sample of an
+ * interval.
+ *
+ * Backpressure: a frame is only sent while more than BLE_STREAM_MSYS_RESERVE
+ * NimBLE msys blocks are free, so command writes and acks always find
+ * buffers. A skipped or failed notification doubles the frame interval (up
+ * to BLE_STREAM_MAX_BACKOFF times); every clean frame halves it again.
+ */
+class BLEStreamer {
+public:
+    BLEStreamer();
+
+    // Setup - the characteristic is created by BLEManager
+    void attach(NimBLEServer* server, NimBLECharacteristic* characteristic);
+    void setSampleProvider(void (*provider)(BLEStreamSample& sample));
+
+    // FreeRTOS task management
+    void startTask();
+    void stopTask();
+    bool isTaskRunning();
+
+    // Link state from the server callbacks
+    void onConnect();
+    void onDisconnect();
+
+    // Statistics
+    bool isStreaming();
+    uint32_t getFramesSent();
+    uint32_t getFramesSkipped();
+    uint32_t getFramesFailed();
+    uint32_t getBytesSent();
+    unsigned long getFrameInterval();
+    unsigned long getSampleInterval();
+    uint16_t getMTU();
+
+private:
+    NimBLEServer* server;
+    NimBLECharacteristic* characteristic;
+    void (*sampleProvider)(BLEStreamSample& sample);
+
+    // FreeRTOS task management
+    TaskHandle_t taskHandle;
+    volatile bool taskRunning;
+    static void streamTask(void* parameter);
+
+    // Frame being built (stream task only)
+    uint8_t frame[NimBLEConfig::ATT_MTU_SIZE];
+    uint8_t sampleCount;
+    uint16_t sequence;
+
+    // Link adaptation
+    volatile bool linkDirty;
+    uint16_t mtu;
+    uint16_t connectionIntervalMs;
+    unsigned long frameIntervalMs;
+    unsigned long sampleIntervalMs;
+    uint8_t samplesPerFrame;
+    uint8_t backoff;
+    unsigned long lastLinkRefresh;
+    std::atomic<uint32_t> notifyFailures;
+
+    // Statistics
+    uint32_t framesSent;
+    uint32_t framesSkipped;
+    uint32_t framesFailed;
+    uint32_t bytesSent;
+
+    // Helpers
+    bool isSubscribed();
+    void refreshLink(unsigned long now);
+    void recalculateRates();
+    void adjustBackoff(bool congested);
+    void addSample(unsigned long now);
+    void sendFrame();
+    void resetFrame();
+
+    // Notification status, used to detect buffer exhaustion
+    class StreamCallbacks : public NimBLECharacteristicCallbacks {
+    public:
+        StreamCallbacks(BLEStreamer* streamer) : streamer(streamer) {}
+        void onStatus(NimBLECharacteristic* pCharacteristic, Status status, int code) override;
+
+    private:
+        BLEStreamer* streamer;
+    };
+
+    static const uint16_t DEFAULT_MTU = 23;
+    static const uint8_t NOTIFY_HEADER_SIZE = 3;               // ATT opcode + handle
+    static const unsigned long IDLE_POLL_INTERVAL = 200;       // ms - unsubscribed
+};
+
+#endif
@@ -16,6 +16,8 @@
 // WiFi Configuration
 extern const char* WIFI_SSID;
 extern const char* WIFI_PASSWORD;
+const bool WIFI_FAST_RECONNECT_ENABLED = true;  // Associate to the BSSID/channel cached in NVS, skipping the scan
+const bool WIFI_CACHE_STATIC_IP = false;        // Reuse the cached DHCP lease as a static IP/DNS config (skips DHCP)
 
 // MQTT Configuration
 extern const char* MQTT_SERVER;
@@ -45,16 +47,35 @@ extern const char* TOPIC_PERFORMANCE_MEMORY;
 extern const char* TOPIC_CLINICAL_PROGRESS;
 extern const char* TOPIC_CLINICAL_QUALITY;
 
+// Batched Telemetry Topic (binary frames, see network/TelemetryBatch.h)
+extern const char* TOPIC_TELEMETRY_BATCH;
+
+// Task Trace Topic (binary frames, see hardware/TaskTracer.h)
+extern const char* TOPIC_PERFORMANCE_TRACE;
+
+// BLE Link Topic (connection parameters, notify throughput and latency)
+extern const char* TOPIC_PERFORMANCE_BLE;
+
 // Future Sensor Topics (InfluxDB Ready)
 extern const char* TOPIC_SENSOR_HEART_RATE;
 extern const char* TOPIC_SENSOR_MOTION;
 extern const char* TOPIC_SENSOR_PRESSURE;
 extern const char* TOPIC_SENSOR_ANALYTICS;
+extern const char* TOPIC_SENSOR_FUSED;  // One frame per SENSOR_FUSION_PUBLISH_INTERVAL, see sensors/SensorFusion.h
 
 // Timing Configuration
 const unsigned long WIFI_RECONNECT_INTERVAL = 30000;  // 30 seconds
-const unsigned long MQTT_RECONNECT_INTERVAL = 5000;   // 5 seconds
+const unsigned long WIFI_FAST_CONNECT_TIMEOUT = 3000; // Cached BSSID/channel attempt before a full connect
+const unsigned long MQTT_RECONNECT_INTERVAL = 1000;   // First retry delay, doubled per failed attempt (jittered)
+const unsigned long MQTT_RECONNECT_MAX_INTERVAL = 60000;  // Backoff ceiling
+const unsigned long MQTT_DNS_LOOKUP_TIMEOUT = 5000;   // Asynchronous broker name lookup
+const unsigned long MQTT_TCP_CONNECT_TIMEOUT = 5000;  // Non-blocking TCP connect to the broker
+const unsigned long MQTT_STABLE_CONNECTION_TIME = 30000;  // Connection held this long resets the backoff
+const int MQTT_RERESOLVE_FAILURES = 4;                // Consecutive failed connects before the broker name is looked up again
+const uint16_t MQTT_SOCKET_TIMEOUT = 2;               // seconds - CONNACK wait and packet reads
 const unsigned long STATUS_REPORT_INTERVAL = 2000;    // 2 seconds
+const bool TELEMETRY_DELTA_ENABLED = true;            // Status/performance topics report by exception (see network/TelemetryDeadband.h)
+const unsigned long TELEMETRY_MAX_SILENCE = 60000;    // Heartbeat - every field resent at least this often
 
 // Servo Configuration
 const int SERVO_PINS[3] = {19, 22, 23};
@@ -62,17 +83,64 @@ const int SERVO_MIN_ANGLE = 0;
 const int SERVO_MAX_ANGLE = 90;
 const int SERVO_MOVEMENT_DELAY = 1000;  // milliseconds
 const int SERVO_CYCLES = 3;
+const unsigned long SERVO_CONTROL_PERIOD_MS = 20;  // 50Hz trajectory updates (one servo PWM frame)
+const int SERVO_PWM_FREQUENCY = 50;                // Hz
+const int SERVO_PULSE_MIN_US = 544;                // 0 degrees (ESP32Servo default)
+const int SERVO_PULSE_MAX_US = 2400;               // 180 degrees (ESP32Servo default)
+const bool SERVO_MCPWM_OUTPUT_ENABLED = false;     // Hardware-latched MCPWM output instead of ESP32Servo
+const size_t SERVO_COMMAND_QUEUE_SIZE = 8;         // Fast-path movement commands waiting for the servo task (power of two)
+const size_t MOVEMENT_METRICS_QUEUE_SIZE = 8;      // Finished joint segments waiting for DeviceManager analytics (power of two)
+const size_t FAST_COMMAND_LOG_SIZE = 8;            // Started fast-path commands waiting for DeviceManager bookkeeping
+const int SERVO_FEEDBACK_TOLERANCE = 10;           // Degrees a measured joint may miss its target and still count as reached
+
+// Exercise library (see hardware/ExerciseLibrary.h) - tables built at compile time
+const int EXERCISE_COMMAND_BASE = 3;               // Movement codes 3, 4, 5: finger tapping, graded grasp, wave
+const int MOVEMENT_COMMAND_MAX = 5;                // Highest movement code (0 home, 1 sequential, 2 simultaneous)
+const unsigned long EXERCISE_LEAD_IN_MS = 600;     // Joints ease onto the first table row from wherever they are
+const int EXERCISE_MAX_JOINT_SPEED = 360;          // deg/s any table may command over SERVO_MIN..MAX_ANGLE (checked at compile time)
 
 // BLE Configuration
 extern const char* BLE_SERVICE_UUID;
 extern const char* BLE_CHARACTERISTIC_UUID;
+extern const char* BLE_STREAM_CHARACTERISTIC_UUID;
 extern const char* BLE_DEVICE_NAME;
 
+// BLE Live Stream
+const bool BLE_STREAM_ENABLED = true;
+const unsigned long BLE_STREAM_SAMPLE_INTERVAL = 20;       // ms - fastest sampling (servo control period)
+const unsigned long BLE_STREAM_MIN_FRAME_INTERVAL = 40;    // ms - at most 25 notifications per second
+const uint8_t BLE_STREAM_EVENTS_PER_FRAME = 2;             // Connection events between frames
+const uint8_t BLE_STREAM_MAX_BACKOFF = 3;                  // Frame interval doubles per level under backpressure
+const int BLE_STREAM_MSYS_RESERVE = 12;                    // msys blocks left free for commands and acks
+const unsigned long BLE_STREAM_LINK_REFRESH_INTERVAL = 1000;  // ms - connection interval and MTU re-read
+
+// BLE Link Power Management (intervals in 1.25 ms units, timeouts in 10 ms units)
+const uint16_t BLE_LINK_ACTIVE_INTERVAL_MIN = 6;           // 7.5 ms
+const uint16_t BLE_LINK_ACTIVE_INTERVAL_MAX = 12;          // 15 ms
+const uint16_t BLE_LINK_ACTIVE_LATENCY = 0;
+const uint16_t BLE_LINK_ACTIVE_TIMEOUT = 400;              // 4 s
+const uint16_t BLE_LINK_IDLE_INTERVAL_MIN = 80;            // 100 ms
+const uint16_t BLE_LINK_IDLE_INTERVAL_MAX = 160;           // 200 ms
+const uint16_t BLE_LINK_IDLE_LATENCY = 4;                  // Peripheral may skip 4 events (1 s worst case)
+const uint16_t BLE_LINK_IDLE_TIMEOUT = 600;                // 6 s - above 2 * (latency + 1) * interval
+const unsigned long BLE_LINK_IDLE_DELAY = 10000;           // ms without a session before going idle
+const unsigned long BLE_LINK_UPDATE_SPACING = 2000;        // ms between parameter requests
+const unsigned long BLE_ADVERTISING_FAST_INTERVAL = 100;   // ms
+const unsigned long BLE_ADVERTISING_SLOW_INTERVAL = 1000;  // ms
+const unsigned long BLE_ADVERTISING_FAST_TIMEOUT = 30000;  // ms of fast advertising before slowing down
+
 // System Configuration
 const int SERIAL_BAUD_RATE = 115200;
+const unsigned long SERIAL_HOST_WAIT_MS = 0;  // Raise to keep early boot logs on a USB-CDC console (delays boot)
 const int MQTT_BUFFER_SIZE = 8192;  // Increased to 8KB to fix persistent corruption
 const size_t MIN_FREE_HEAP = 10000;  // Minimum free heap in bytes
 
+// Logging
+const bool LOG_ASYNC_ENABLED = true;              // Deferred serial output through the log drain task
+const size_t LOG_RING_SIZE = 32;                  // Pending log records (power of two)
+const size_t LOG_RECORD_TEXT_SIZE = 120;          // Longer messages are truncated
+const unsigned long LOG_DRAIN_IDLE_TIMEOUT = 50;  // ms - drain task wakes at least this often
+
 // Error Handling
 const int MAX_WIFI_RETRIES = 5;
 const int MAX_MQTT_RETRIES = 3;
@@ -85,20 +153,25 @@ const int DEEP_SLEEP_DURATION = 60;  // seconds (for future use)
 // FREERTOS TASK CONFIGURATION
 // =============================================================================
 
-// Task Stack Sizes (in words, not bytes) - Optimized for memory efficiency
+// Task Stack Sizes (bytes - ESP32 FreeRTOS counts stacks in bytes) - Optimized for memory efficiency
+// Created through ResourceProfiler::getStackSize(), which may apply profiled sizes instead
 const uint32_t TASK_STACK_WIFI_MANAGER = 3072;      // Reduced from 4096
 const uint32_t TASK_STACK_MQTT_PUBLISHER = 4096;    // Reduced from 6144
 const uint32_t TASK_STACK_MQTT_SUBSCRIBER = 3072;   // Reduced from 4096
 const uint32_t TASK_STACK_BLE_SERVER = 6144;        // Reduced from 8192 - Critical for BLE stability
+const uint32_t TASK_STACK_LOG_DRAIN = 2560;         // Formats timestamps and writes to Serial
+const uint32_t TASK_STACK_BLE_STREAM = 3072;        // Frame packing and notify
 
 const uint32_t TASK_STACK_SERVO_CONTROL = 3072;     // Reduced from 4096
 const uint32_t TASK_STACK_I2C_MANAGER = 3072;       // Reduced from 4096
 const uint32_t TASK_STACK_PULSE_MONITOR = 3072;     // Reduced from 4096
 const uint32_t TASK_STACK_MOTION_SENSOR = 3072;     // Reduced from 4096
-const uint32_t TASK_STACK_PRESSURE_SENSOR = 2048;   // Reduced from 4096
+const uint32_t TASK_STACK_PRESSURE_SENSOR = 3072;   // DMA frame processing, calibration and the fusion callback
 const uint32_t TASK_STACK_DATA_FUSION = 4096;       // Reduced from 5120
 const uint32_t TASK_STACK_SESSION_ANALYTICS = 3072; // Reduced from 4096
 const uint32_t TASK_STACK_SYSTEM_HEALTH = 4096;     // CRITICAL: Increased back - needs space for logging
+const uint32_t TASK_STACK_DEVICE_MANAGER = 4096;    // Command dispatch and MQTT publishing
+const uint32_t TASK_STACK_BOOT_WORKER = 8192;       // Runs BLE and WiFi bring-up (as loopTask did), freed after boot
 
 // Task Priorities (0 = lowest, configMAX_PRIORITIES-1 = highest)
 // Core 0 (Protocol CPU) - Communication Tasks
@@ -106,6 +179,8 @@ const UBaseType_t PRIORITY_WIFI_MANAGER = 5;
 const UBaseType_t PRIORITY_MQTT_PUBLISHER = 4;
 const UBaseType_t PRIORITY_MQTT_SUBSCRIBER = 4;
 const UBaseType_t PRIORITY_BLE_SERVER = 3;
+const UBaseType_t PRIORITY_BLE_STREAM = 2;         // Below command handling
+const UBaseType_t PRIORITY_LOG_DRAIN = 1;          // Lowest - serial output only
 
 
 // Core 1 (Application CPU) - Control & Sensing Tasks
@@ -117,42 +192,114 @@ const UBaseType_t PRIORITY_PRESSURE_SENSOR = 3;    // Force feedback
 const UBaseType_t PRIORITY_DATA_FUSION = 3;        // Sensor correlation
 const UBaseType_t PRIORITY_SESSION_ANALYTICS = 2;  // Clinical analysis
 const UBaseType_t PRIORITY_SYSTEM_HEALTH = 1;      // Background monitoring
+const UBaseType_t PRIORITY_DEVICE_MANAGER = 3;     // Event-driven coordination
+const UBaseType_t PRIORITY_BOOT_WORKER = 2;        // Below the tasks the stages start
 
 // Core Assignment
 const BaseType_t CORE_PROTOCOL = 0;     // WiFi, MQTT, BLE
 const BaseType_t CORE_APPLICATION = 1;  // Sensors, Control, Analytics
 
-// Queue Sizes - Optimized for memory efficiency
-const UBaseType_t QUEUE_SIZE_PULSE_RAW = 50;         // Reduced: 25Hz * 2 seconds
-const UBaseType_t QUEUE_SIZE_MOTION_RAW = 100;       // Reduced: 100Hz * 1 second
-const UBaseType_t QUEUE_SIZE_PRESSURE_RAW = 25;      // Reduced: 10Hz * 2.5 seconds
-const UBaseType_t QUEUE_SIZE_PULSE_PROCESSED = 10;   // Reduced: 1Hz * 10 seconds
-const UBaseType_t QUEUE_SIZE_MOTION_PROCESSED = 25;  // Reduced: 10Hz * 2.5 seconds
-const UBaseType_t QUEUE_SIZE_PRESSURE_PROCESSED = 5; // Reduced: 1Hz * 5 seconds
+// Staged Boot (see utils/BootScheduler.h)
+const uint8_t BOOT_MAX_STAGES = 12;                 // One event group bit each
+const unsigned long BOOT_READY_TIMEOUT_MS = 5000;   // Longest setup() waits for servos, BLE and commands
+
+// Queue Sizes - Optimized for memory efficiency (ResourceProfiler::getQueueDepth() may apply smaller ones)
 const UBaseType_t QUEUE_SIZE_SERVO_COMMANDS = 5;     // Reduced: Movement commands
 const UBaseType_t QUEUE_SIZE_I2C_REQUESTS = 10;      // Reduced: I2C bus requests
-const UBaseType_t QUEUE_SIZE_MQTT_PUBLISH = 25;      // Reduced: MQTT messages
+const UBaseType_t QUEUE_SIZE_MQTT_PUBLISH = 20;      // Reduced: MQTT messages (normal/low priority)
+const UBaseType_t QUEUE_SIZE_MQTT_PRIORITY = 5;      // High priority MQTT messages (session/command events)
 const UBaseType_t QUEUE_SIZE_SESSION_EVENTS = 10;    // Reduced: Session events
 const UBaseType_t QUEUE_SIZE_SYSTEM_ALERTS = 8;      // Reduced: System alerts
-const UBaseType_t QUEUE_SIZE_FUSED_DATA = 15;        // Reduced: Combined sensor data
 const UBaseType_t QUEUE_SIZE_MOVEMENT_ANALYTICS = 12; // Reduced: Movement analysis
 const UBaseType_t QUEUE_SIZE_CLINICAL_DATA = 8;      // Reduced: Clinical metrics
 const UBaseType_t QUEUE_SIZE_PERFORMANCE_METRICS = 10; // Reduced: Performance data
+const UBaseType_t QUEUE_SIZE_DEVICE_COMMANDS = 8;    // Text commands waiting for the coordinator
+const size_t DEVICE_COMMAND_MAX_LENGTH = 64;         // Longer text commands are rejected
+const uint8_t COMMAND_MAX_ARGUMENTS = 4;             // Integer arguments kept per parsed command
+
+// Sensor Stream Sizes - SPSC ring buffers owned by each producer (powers of two)
+const size_t STREAM_SIZE_MOTION_RAW = 128;        // 100Hz * 1.28 seconds
+const size_t STREAM_SIZE_PRESSURE_RAW = 128;      // 4 channels * 100Hz * 0.32 seconds
+const size_t STREAM_SIZE_PULSE_PROCESSED = 8;     // 1Hz * 8 seconds
+const size_t STREAM_SIZE_MOTION_PROCESSED = 32;   // 10Hz * 3.2 seconds
+const size_t STREAM_SIZE_PRESSURE_PROCESSED = 8;  // 1Hz * 8 seconds
+const size_t STREAM_SIZE_FUSED_DATA = 16;         // Combined sensor data
+
+// MQTT Publish Priorities (MQTTMessage::priority, 0 = low, 255 = high)
+const uint8_t MQTT_PRIORITY_LOW = 64;        // Periodic status/performance telemetry - dropped first
+const uint8_t MQTT_PRIORITY_NORMAL = 128;    // Sensor and analytics data
+const uint8_t MQTT_PRIORITY_HIGH = 192;      // Session lifecycle and commands - published first
+const UBaseType_t MQTT_LOW_PRIORITY_RESERVE = 5;  // Queue slots kept free for normal priority messages
+
+// Batched Telemetry (opt-in binary frames instead of one JSON message per reading)
+const bool TELEMETRY_BATCH_ENABLED = false;                // Default mode - can be switched at runtime
+const uint8_t TELEMETRY_BATCH_MAX_RECORDS = 32;            // Size threshold: flush when a frame holds this many readings
+const unsigned long TELEMETRY_BATCH_FLUSH_INTERVAL = 5000; // Time threshold: flush frames older than 5 seconds
+
+// Session IDs - "SES_XXXXXXXX_NNN", with room for the counter past 999
+const size_t ANALYTICS_SESSION_ID_SIZE = 20;     // Terminated in analytics events, zero padded on flash
+
+// Session Recorder (flash backlog while MQTT is unreachable, see storage/SessionRecorder.h)
+const bool SESSION_RECORDER_ENABLED = true;
+const size_t SESSION_RECORDER_PAGE_SIZE = 256;             // Flash page - records are written a page at a time
+const uint32_t SESSION_RECORDER_SEGMENT_SIZE = 16384;      // Bytes per log segment file
+const uint16_t SESSION_RECORDER_MAX_SEGMENTS = 48;         // Ring size (768KB) - oldest segment dropped beyond this
+const unsigned long SESSION_RECORDER_FLUSH_INTERVAL = 5000; // Max time a record waits in RAM
+const uint8_t SESSION_RECORDER_STAGED_RECORDS = 8;         // Held in RAM while replay has the recorder locked
+const uint8_t SESSION_RECORDER_REPLAY_BATCH = 4;           // Records replayed per interval
+const unsigned long SESSION_RECORDER_REPLAY_INTERVAL = 200; // Replay rate limit (20 records/s)
 
 // Sensor Sampling Configuration
 const uint32_t PULSE_SAMPLING_RATE_HZ = 25;          // 25Hz for heart rate
 const uint32_t MOTION_SAMPLING_RATE_HZ = 100;        // 100Hz for motion
-const uint32_t PRESSURE_SAMPLING_RATE_HZ = 10;       // 10Hz for pressure
+const uint32_t PRESSURE_SAMPLING_RATE_HZ = 100;      // 100Hz per channel after decimation (grip control)
 const uint32_t PULSE_REPORTING_RATE_HZ = 1;          // 1Hz reporting
 const uint32_t MOTION_REPORTING_RATE_HZ = 10;        // 10Hz reporting
 const uint32_t PRESSURE_REPORTING_RATE_HZ = 1;       // 1Hz reporting
 
+// Motion Sensor (see sensors/MotionSensorManager.h)
+const uint8_t MOTION_FIFO_BATCH = 4;                   // Data-ready edges per task wake-up (25 wake-ups/s at 100Hz)
+const int MOTION_SENSOR_JOINT = 0;                     // Servo joint the MPU6050 rides on
+const float MOTION_JOINT_AXIS_SIGN = 1.0f;             // Sensor pitch direction relative to servo flexion
+const unsigned long MOTION_FEEDBACK_MAX_AGE = 100;     // Older joint angles are not used as servo feedback
+
+// Pressure Sensors (see sensors/PressureSensorManager.h)
+const uint8_t PRESSURE_SENSOR_COUNT = 4;                        // Fingertip force sensors, one per FusedSensorData::pressure slot
+const uint8_t PRESSURE_ADC_CHANNELS[PRESSURE_SENSOR_COUNT] = {0, 3, 6, 7};          // ADC1 channels: GPIO36, 39, 34, 35 (ADC2 is unusable with WiFi)
+const uint32_t PRESSURE_ADC_SAMPLE_RATE_HZ = 20000;             // DMA conversions/s over all channels (ESP32 minimum)
+const float PRESSURE_DIVIDER_RESISTOR_OHMS = 10000.0f;          // 3.3V - sensor - ADC pin - resistor - GND
+const float PRESSURE_NEWTONS_PER_MICROSIEMENS = 0.02f;          // Thin-film sensor force/conductance slope (20g-2kg type)
+const float PRESSURE_SENSOR_AREA_MM2 = 78.5f;                   // 10mm sensing disc
+const float PRESSURE_CONTACT_THRESHOLD = 0.3f;                  // N - fingertip contact begins
+const float PRESSURE_RELEASE_THRESHOLD = 0.15f;                 // N - contact ends (hysteresis)
+
+// Safety Supervisor (see hardware/SafetySupervisor.h) - checked on every servo control tick
+const float SAFETY_MAX_FINGERTIP_FORCE = 15.0f;           // N on any one pressure sensor
+const float SAFETY_HEART_RATE_MIN = 40.0f;                // BPM
+const float SAFETY_HEART_RATE_MAX = 170.0f;               // BPM
+const int SAFETY_ANGLE_MARGIN = 10;                       // Degrees a measured joint may pass SERVO_MIN/MAX_ANGLE
+const int SAFETY_MAX_TRACKING_ERROR = 30;                 // Degrees between setpoint and measured angle
+const unsigned long SAFETY_MAX_AGE_FORCE = 100;           // Older inputs are not checked
+const unsigned long SAFETY_MAX_AGE_HEART_RATE = 2500;
+const unsigned long SAFETY_MAX_AGE_JOINT_ANGLE = MOTION_FEEDBACK_MAX_AGE;
+
+// Sensor Fusion (see sensors/SensorFusion.h)
+const unsigned long SENSOR_FUSION_LATENCY = 50;             // Frames describe now - 50ms so fast sensors bracket the instant
+const unsigned long SENSOR_FUSION_MAX_AGE_PULSE = 2500;     // Hold a 1Hz pulse reading across one missed report
+const unsigned long SENSOR_FUSION_MAX_AGE_MOTION = 100;     // Motion older than 100ms no longer describes the hand
+const unsigned long SENSOR_FUSION_MAX_AGE_PRESSURE = 100;   // Ten 100Hz pressure samples
+const uint8_t SENSOR_FUSION_PRESSURE_CHANNELS = PRESSURE_SENSOR_COUNT;  // FusedSensorData::pressure slots
+const unsigned long SENSOR_FUSION_PUBLISH_INTERVAL = 1000;  // Newest fused frame over MQTT once a second
+
 // I2C Configuration (Updated for servo compatibility)
 const uint8_t I2C_SDA_PIN = 18;  // SDA pin for heart rate sensor
 const uint8_t I2C_SCL_PIN = 21;  // SCL pin for heart rate sensor
 const uint8_t I2C_INT_PIN = 4;   // Interrupt pin for heart rate sensor
+const uint8_t I2C_MOTION_INT_PIN = 25;  // MPU6050 data-ready interrupt (active high)
 const uint32_t I2C_CLOCK_SPEED = 400000;  // 400kHz fast mode
 const uint32_t I2C_TIMEOUT_MS = 1000;
+const size_t I2C_MAX_TRANSFER_SIZE = 128;   // Matches the Wire library buffer
+const int I2C_TRANSACTION_SLOTS = 4;        // Concurrent in-flight transactions across all drivers
 
 // Sensor I2C Addresses
 const uint8_t I2C_ADDR_MAX30102 = 0x57;   // Pulse oximeter
@@ -185,11 +332,44 @@ const TickType_t TASK_DELAY_SYSTEM_HEALTH = pdMS_TO_TICKS(5000); // 5 second hea
 
 // Memory Management - Optimized for BLE compatibility
 const size_t SENSOR_DATA_POOL_SIZE = 4096;   // Reduced to 4KB pool for sensor data
-const size_t SENSOR_DATA_POOL_ITEMS = 32;    // Reduced: Number of allocatable items
+const size_t SENSOR_POOL_CLASS_COUNT = 4;    // Block size classes carved out of the pool
+constexpr size_t SENSOR_POOL_BLOCK_SIZES[SENSOR_POOL_CLASS_COUNT] = {32, 64, 128, 256};  // Powers of two, ascending
+constexpr size_t SENSOR_POOL_BLOCK_COUNTS[SENSOR_POOL_CLASS_COUNT] = {32, 16, 8, 4};     // 1KB per class
+const size_t SENSOR_POOL_TOTAL_BLOCKS = 60;  // Sum of SENSOR_POOL_BLOCK_COUNTS
 const size_t MAX_MQTT_MESSAGE_SIZE = 1024;   // Maximum MQTT message size
+const size_t MQTT_JSON_ARENA_SIZE = 3072;   // Static arena for building MQTT JSON documents
 
 // Performance Monitoring
 const uint32_t MAX_TASK_EXECUTION_TIME_MS = 100;  // Maximum task execution time
 const uint32_t WATCHDOG_FEED_INTERVAL_MS = 1000;  // Watchdog feed interval
 
+// Task Tracing (see hardware/TaskTracer.h)
+const bool TASK_TRACE_ENABLED = true;                   // Scoped timers become no-ops when false
+const uint8_t TASK_TRACE_MAX_TASKS = 12;                // Traced task slots
+const uint8_t TASK_TRACE_BUCKET_COUNT = 48;             // Half-octave latency buckets, 1us .. ~16s
+const uint8_t TASK_TRACE_DEADLINE_TOLERANCE_PERCENT = 25;  // Activation later than period + 25% is a miss
+const unsigned long TASK_TRACE_PUBLISH_INTERVAL = 60000;   // Binary trace dump over MQTT every minute
+
+// CPU Load and Stack Monitoring (see hardware/SystemMonitor.h)
+const unsigned long CPU_MONITOR_WINDOW_MS = 1000;       // Shortest window core and task loads cover
+const uint8_t CPU_MONITOR_MAX_TASKS = 32;               // All FreeRTOS tasks, system ones included
+const float CPU_LOAD_WARNING_PERCENT = 85.0f;           // Less headroom than this on a core is logged
+const uint32_t TASK_STACK_HEADROOM_WARNING = 256;       // Bytes of never-used stack below which a task is logged
+const unsigned long CPU_TASK_USAGE_PUBLISH_INTERVAL = 60000;  // Per-task table on TOPIC_PERFORMANCE_TIMING
+const uint8_t CPU_TASK_USAGE_MAX_ROWS = 20;             // Busiest tasks per table (fits MAX_MQTT_MESSAGE_SIZE)
+
+// Resource Profiling (see hardware/ResourceProfiler.h) - stack and queue right-sizing
+const bool RESOURCE_PROFILING_DEFAULT = false;               // Until 'profile on/off' is saved to NVS
+const unsigned long RESOURCE_PROFILE_SAVE_INTERVAL = 600000; // New peaks reach NVS at most every 10 minutes (and at session end)
+const uint32_t RESOURCE_PROFILE_STACK_MARGIN_PERCENT = 25;   // Added to the deepest stack use seen
+const uint32_t RESOURCE_PROFILE_STACK_RESERVE = 512;         // Plus bytes for paths profiling never reached (error logging, ISRs)
+const uint32_t RESOURCE_PROFILE_STACK_GRANULARITY = 256;     // Recommended stacks are multiples of this
+const uint32_t RESOURCE_PROFILE_MIN_STACK = 2048;
+const uint32_t RESOURCE_PROFILE_MAX_STACK = 16384;
+const uint32_t RESOURCE_PROFILE_QUEUE_MARGIN_PERCENT = 50;   // Added to the peak queue occupancy seen...
+const uint32_t RESOURCE_PROFILE_QUEUE_RESERVE = 2;           // ...or at least this many slots
+const uint32_t RESOURCE_PROFILE_MIN_QUEUE_DEPTH = 2;
+const uint16_t RESOURCE_PROFILE_MIN_SESSIONS = 3;            // Profiled sessions before 'profile apply' takes effect
+const uint32_t RESOURCE_PROFILE_MIN_SECONDS = 3600;          // And profiled time
+
 #endif
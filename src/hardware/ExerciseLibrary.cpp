@@ -0,0 +1,212 @@
+#include "ExerciseLibrary.h"
+
+static_assert(MOTION_MAX_JOINTS == 3, "Exercise rows are generated for three joints");
+static_assert(MOVEMENT_COMMAND_MAX == EXERCISE_COMMAND_BASE + EXERCISE_COUNT - 1,
+              "MOVEMENT_COMMAND_MAX must cover every exercise code");
+
+// =============================================================================
+// COMPILE-TIME MATH
+// =============================================================================
+
+static constexpr double PI = 3.14159265358979323846;
+static constexpr unsigned long ROW_MS = SERVO_CONTROL_PERIOD_MS;  // One row per control tick
+
+// cos(x) for |x| <= pi - thirteen Taylor terms are exact to double precision there
+static constexpr double cosineSeries(double x2, double term, int n) {
+    return n > 12 ? 0.0 : term + cosineSeries(x2, -term * x2 / ((2 * n + 1) * (2 * n + 2)), n + 1);
+}
+
+static constexpr double cosine(double x) {
+    return cosineSeries(x * x, 1.0, 0);
+}
+
+// 0 -> 1 -> 0 over u = 0..1, zero velocity at both ends; 0 outside
+static constexpr double raisedCosine(double u) {
+    return (u <= 0.0 || u >= 1.0) ? 0.0 : 0.5 + 0.5 * cosine(2.0 * PI * u - PI);
+}
+
+// Same curve as MotionPlanner's minimum-jerk segments
+static constexpr double minimumJerk(double t) {
+    return t <= 0.0 ? 0.0 : (t >= 1.0 ? 1.0 : t * t * t * (10.0 + t * (-15.0 + 6.0 * t)));
+}
+
+static constexpr uint16_t toQ15(double fraction) {
+    return fraction <= 0.0 ? 0
+         : (fraction >= 1.0 ? EXERCISE_FULL_FLEXION : (uint16_t)(fraction * EXERCISE_FULL_FLEXION + 0.5));
+}
+
+// =============================================================================
+// EXERCISE SHAPES
+// =============================================================================
+
+// Fraction of the joint range for every joint at every row of one cycle
+
+struct FingerTapping {
+    static constexpr size_t ROWS = 2700 / ROW_MS;  // 0.9 s per finger, one after another
+
+    static constexpr double at(size_t row, size_t joint) {
+        return raisedCosine((double)row * MOTION_MAX_JOINTS / ROWS - (double)joint);
+    }
+};
+
+struct GradedGrasp {
+    static constexpr size_t ROWS = 5400 / ROW_MS;
+    static constexpr double STEP_MS = 1200.0;     // Close a third of the range, then hold
+    static constexpr double CLOSE_MS = 600.0;
+    static constexpr double GRASP_MS = 3 * STEP_MS;
+    static constexpr double RELEASE_MS = 1200.0;  // Fully open again, then rest for the remainder
+
+    static constexpr double closing(double ms, int step) {
+        return (step + minimumJerk((ms - step * STEP_MS) / CLOSE_MS)) / 3.0;
+    }
+
+    static constexpr double at(size_t row, size_t joint) {
+        return row * (double)ROW_MS < GRASP_MS ? closing(row * (double)ROW_MS, (int)(row * (double)ROW_MS / STEP_MS))
+             : 1.0 - minimumJerk((row * (double)ROW_MS - GRASP_MS) / RELEASE_MS);
+    }
+};
+
+struct Wave {
+    static constexpr size_t ROWS = 2400 / ROW_MS;
+    static constexpr double SPREAD = 0.25;  // Cycle fraction between neighbouring fingers
+
+    // Each finger's bump lasts half a cycle, so two fingers are always moving
+    static constexpr double at(size_t row, size_t joint) {
+        return raisedCosine(((double)row / ROWS - SPREAD * joint) * 2.0);
+    }
+};
+
+// =============================================================================
+// TABLE GENERATION
+// =============================================================================
+
+template <size_t... I> struct RowIndices {};
+template <size_t N, size_t... I> struct MakeRowIndices : MakeRowIndices<N - 1, N - 1, I...> {};
+template <size_t... I> struct MakeRowIndices<0, I...> { typedef RowIndices<I...> type; };
+
+template <size_t N> struct SampleRows {
+    uint16_t rows[N][MOTION_MAX_JOINTS];
+};
+
+template <size_t N> struct EaseRows {
+    uint16_t values[N];
+};
+
+template <typename Shape, size_t... I>
+static constexpr SampleRows<sizeof...(I)> buildRows(RowIndices<I...>) {
+    return {{ {toQ15(Shape::at(I, 0)), toQ15(Shape::at(I, 1)), toQ15(Shape::at(I, 2))}... }};
+}
+
+template <typename Shape>
+static constexpr SampleRows<Shape::ROWS> buildTable() {
+    return buildRows<Shape>(typename MakeRowIndices<Shape::ROWS>::type());
+}
+
+template <size_t... I>
+static constexpr EaseRows<sizeof...(I)> buildEase(RowIndices<I...>) {
+    return {{ toQ15(minimumJerk((double)I / (sizeof...(I) - 1)))... }};
+}
+
+template <size_t N>
+static constexpr uint16_t peakRow(const SampleRows<N>& table, size_t joint, size_t row = 0, size_t best = 0) {
+    return row >= N ? (uint16_t)best
+         : peakRow(table, joint, row + 1, table.rows[row][joint] > table.rows[best][joint] ? row : best);
+}
+
+template <size_t N>
+static constexpr uint16_t riseRow(const SampleRows<N>& table, size_t joint, size_t row) {
+    return row == 0 || table.rows[row][joint] == table.rows[0][joint] ? (uint16_t)row
+         : riseRow(table, joint, row - 1);
+}
+
+template <size_t N>
+static constexpr uint16_t riseRow(const SampleRows<N>& table, size_t joint) {
+    return riseRow(table, joint, peakRow(table, joint));
+}
+
+static constexpr uint32_t larger(uint32_t a, uint32_t b) {
+    return a > b ? a : b;
+}
+
+template <size_t N>
+static constexpr uint32_t rowStep(const SampleRows<N>& table, size_t row, size_t joint) {
+    return table.rows[row][joint] > table.rows[(row + 1) % N][joint]
+         ? table.rows[row][joint] - table.rows[(row + 1) % N][joint]
+         : table.rows[(row + 1) % N][joint] - table.rows[row][joint];
+}
+
+// Largest change between neighbouring rows of any joint, including the wrap to row 0
+template <size_t N>
+static constexpr uint32_t maxRowStep(const SampleRows<N>& table, size_t row = 0) {
+    return row >= N ? 0
+         : larger(larger(rowStep(table, row, 0), rowStep(table, row, 1)),
+                  larger(rowStep(table, row, 2), maxRowStep(table, row + 1)));
+}
+
+template <size_t N>
+static constexpr bool startsAtRest(const SampleRows<N>& table) {
+    return table.rows[0][0] == 0 && table.rows[0][1] == 0 && table.rows[0][2] == 0;
+}
+
+template <size_t N>
+static constexpr bool withinSpeedLimit(const SampleRows<N>& table) {
+    return (unsigned long long)maxRowStep(table) * (SERVO_MAX_ANGLE - SERVO_MIN_ANGLE) * 1000 <=
+           (unsigned long long)EXERCISE_MAX_JOINT_SPEED * EXERCISE_FULL_FLEXION * ROW_MS;
+}
+
+// =============================================================================
+// TABLES
+// =============================================================================
+
+static constexpr SampleRows<FingerTapping::ROWS> FINGER_TAPPING_ROWS = buildTable<FingerTapping>();
+static constexpr SampleRows<GradedGrasp::ROWS> GRADED_GRASP_ROWS = buildTable<GradedGrasp>();
+static constexpr SampleRows<Wave::ROWS> WAVE_ROWS = buildTable<Wave>();
+
+static const size_t EASE_ROW_COUNT = 33;
+static constexpr EaseRows<EASE_ROW_COUNT> EASE_ROWS = buildEase(MakeRowIndices<EASE_ROW_COUNT>::type());
+
+static_assert(startsAtRest(FINGER_TAPPING_ROWS) && startsAtRest(GRADED_GRASP_ROWS) && startsAtRest(WAVE_ROWS),
+              "Exercise tables must start from rest");
+static_assert(withinSpeedLimit(FINGER_TAPPING_ROWS), "Finger tapping exceeds EXERCISE_MAX_JOINT_SPEED");
+static_assert(withinSpeedLimit(GRADED_GRASP_ROWS), "Graded grasp exceeds EXERCISE_MAX_JOINT_SPEED");
+static_assert(withinSpeedLimit(WAVE_ROWS), "Wave exceeds EXERCISE_MAX_JOINT_SPEED");
+static_assert(EASE_ROWS.values[0] == 0 && EASE_ROWS.values[EASE_ROW_COUNT - 1] == EXERCISE_FULL_FLEXION,
+              "Ease table must run from 0 to full scale");
+
+// Indexed by ExerciseId
+static const ExerciseTable EXERCISE_TABLES[EXERCISE_COUNT] = {
+    {"finger_tapping", FINGER_TAPPING_ROWS.rows, FingerTapping::ROWS, ROW_MS,
+     {riseRow(FINGER_TAPPING_ROWS, 0), riseRow(FINGER_TAPPING_ROWS, 1), riseRow(FINGER_TAPPING_ROWS, 2)},
+     {peakRow(FINGER_TAPPING_ROWS, 0), peakRow(FINGER_TAPPING_ROWS, 1), peakRow(FINGER_TAPPING_ROWS, 2)}},
+    {"graded_grasp", GRADED_GRASP_ROWS.rows, GradedGrasp::ROWS, ROW_MS,
+     {riseRow(GRADED_GRASP_ROWS, 0), riseRow(GRADED_GRASP_ROWS, 1), riseRow(GRADED_GRASP_ROWS, 2)},
+     {peakRow(GRADED_GRASP_ROWS, 0), peakRow(GRADED_GRASP_ROWS, 1), peakRow(GRADED_GRASP_ROWS, 2)}},
+    {"wave", WAVE_ROWS.rows, Wave::ROWS, ROW_MS,
+     {riseRow(WAVE_ROWS, 0), riseRow(WAVE_ROWS, 1), riseRow(WAVE_ROWS, 2)},
+     {peakRow(WAVE_ROWS, 0), peakRow(WAVE_ROWS, 1), peakRow(WAVE_ROWS, 2)}}
+};
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
+const ExerciseTable* ExerciseLibrary::getTable(ExerciseId id) {
+    if ((uint8_t)id >= EXERCISE_COUNT) return nullptr;
+    return &EXERCISE_TABLES[(uint8_t)id];
+}
+
+const ExerciseTable* ExerciseLibrary::getTableForCommand(int commandCode) {
+    int index = commandCode - EXERCISE_COMMAND_BASE;
+    if (index < 0 || index >= EXERCISE_COUNT) return nullptr;
+    return &EXERCISE_TABLES[index];
+}
+
+uint16_t ExerciseLibrary::ease(uint32_t elapsedMs, uint32_t durationMs) {
+    if (durationMs == 0 || elapsedMs >= durationMs) return EXERCISE_FULL_FLEXION;
+
+    uint32_t position = elapsedMs * (EASE_ROW_COUNT - 1);
+    uint32_t row = position / durationMs;
+    int32_t from = EASE_ROWS.values[row];
+    int32_t to = EASE_ROWS.values[row + 1];
+    return (uint16_t)(from + (to - from) * (int32_t)(position % durationMs) / (int32_t)durationMs);
+}
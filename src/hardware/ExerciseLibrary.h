@@ -0,0 +1,60 @@
+#ifndef EXERCISE_LIBRARY_H
+#define EXERCISE_LIBRARY_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+#include "MotionPlanner.h"
+
+// =============================================================================
+// EXERCISE TABLES
+// =============================================================================
+
+enum class ExerciseId : uint8_t {
+    FINGER_TAPPING,  // Each finger flexes and extends in turn
+    GRADED_GRASP,    // All fingers close in three steps, hold, then open
+    WAVE             // Overlapping flexion rolling across the fingers
+};
+
+const uint8_t EXERCISE_COUNT = 3;
+const uint16_t EXERCISE_FULL_FLEXION = 32767;  // Q15 - a row value at the top of the angle range
+
+/**
+ * One cycle of an exercise as per-joint setpoints, one row every
+ * samplePeriodMs. Values are Q15 fractions of the joint range (0 = minAngle,
+ * EXERCISE_FULL_FLEXION = maxAngle), so the same table plays at whatever
+ * range the controller is set to. Rows wrap back to row 0, and row 0 is
+ * the rest position every table starts and ends at.
+ */
+struct ExerciseTable {
+    const char* name;
+    const uint16_t (*rows)[MOTION_MAX_JOINTS];
+    uint16_t rowCount;
+    uint16_t samplePeriodMs;
+    uint16_t riseRow[MOTION_MAX_JOINTS];  // Last row at rest before each joint's peak
+    uint16_t peakRow[MOTION_MAX_JOINTS];  // First row where each joint is flexed furthest
+};
+
+// =============================================================================
+// EXERCISE LIBRARY
+// =============================================================================
+
+/**
+ * Fixed-point exercise trajectories generated entirely at compile time.
+ *
+ * The shapes (raised-cosine bumps, minimum-jerk steps) are evaluated by
+ * constexpr code when the firmware is built and land in flash as Q15
+ * tables, together with each joint's rise and peak rows; static_asserts
+ * reject any table that does not start from rest or that would drive a
+ * joint faster than EXERCISE_MAX_JOINT_SPEED. At run time MotionPlanner only indexes
+ * and linearly interpolates rows with integer arithmetic.
+ */
+class ExerciseLibrary {
+public:
+    static const ExerciseTable* getTable(ExerciseId id);
+    static const ExerciseTable* getTableForCommand(int commandCode);  // nullptr unless an exercise code
+
+    // Minimum-jerk ease (Q15, 0 -> EXERCISE_FULL_FLEXION) at elapsedMs of durationMs
+    static uint16_t ease(uint32_t elapsedMs, uint32_t durationMs);
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "FreeRTOSManager.h"
+#include "TaskTracer.h"
 
 // =============================================================================
 // STATIC MEMBER INITIALIZATION
@@ -12,21 +13,16 @@ bool FreeRTOSManager::eventGroupsCreated = false;
 bool FreeRTOSManager::tasksCreated = false;
 
 // Queue handles
-QueueHandle_t FreeRTOSManager::pulseRawDataQueue = nullptr;
-QueueHandle_t FreeRTOSManager::motionRawDataQueue = nullptr;
-QueueHandle_t FreeRTOSManager::pressureRawDataQueue = nullptr;
-QueueHandle_t FreeRTOSManager::pulseProcessedQueue = nullptr;
-QueueHandle_t FreeRTOSManager::motionProcessedQueue = nullptr;
-QueueHandle_t FreeRTOSManager::pressureProcessedQueue = nullptr;
 QueueHandle_t FreeRTOSManager::servoCommandQueue = nullptr;
 QueueHandle_t FreeRTOSManager::i2cRequestQueue = nullptr;
 QueueHandle_t FreeRTOSManager::mqttPublishQueue = nullptr;
+QueueHandle_t FreeRTOSManager::mqttPriorityQueue = nullptr;
 QueueHandle_t FreeRTOSManager::sessionEventQueue = nullptr;
 QueueHandle_t FreeRTOSManager::systemAlertQueue = nullptr;
-QueueHandle_t FreeRTOSManager::fusedDataQueue = nullptr;
 QueueHandle_t FreeRTOSManager::movementAnalyticsQueue = nullptr;
 QueueHandle_t FreeRTOSManager::clinicalDataQueue = nullptr;
 QueueHandle_t FreeRTOSManager::performanceMetricsQueue = nullptr;
+QueueHandle_t FreeRTOSManager::deviceCommandQueue = nullptr;
 
 // Semaphore handles
 SemaphoreHandle_t FreeRTOSManager::i2cBusMutex = nullptr;
@@ -39,7 +35,6 @@ SemaphoreHandle_t FreeRTOSManager::motionDataReady = nullptr;
 SemaphoreHandle_t FreeRTOSManager::sessionStarted = nullptr;
 SemaphoreHandle_t FreeRTOSManager::emergencyStop = nullptr;
 SemaphoreHandle_t FreeRTOSManager::calibrationComplete = nullptr;
-SemaphoreHandle_t FreeRTOSManager::sensorDataPoolMutex = nullptr;
 
 // Event group handles
 EventGroupHandle_t FreeRTOSManager::sensorStatusEvents = nullptr;
@@ -65,8 +60,6 @@ TaskPerformanceMetrics FreeRTOSManager::taskMetrics[20];
 uint8_t FreeRTOSManager::taskMetricsCount = 0;
 
 // Memory pool
-uint8_t FreeRTOSManager::sensorDataPool[SENSOR_DATA_POOL_SIZE];
-bool FreeRTOSManager::sensorDataPoolAllocated[SENSOR_DATA_POOL_ITEMS];
 
 // =============================================================================
 // PUBLIC METHODS
@@ -90,8 +83,7 @@ bool FreeRTOSManager::initialize() {
     }
 
     // Initialize memory pool
-    memset(sensorDataPool, 0, SENSOR_DATA_POOL_SIZE);
-    memset(sensorDataPoolAllocated, false, SENSOR_DATA_POOL_ITEMS);
+    SensorDataPool::initialize();
     memset(taskMetrics, 0, sizeof(taskMetrics));
 
     // Create FreeRTOS objects in order
@@ -154,28 +146,23 @@ bool FreeRTOSManager::createQueues() {
 
     Logger::info("Creating FreeRTOS queues...");
 
-    // High-frequency sensor data queues
-    pulseRawDataQueue = xQueueCreate(QUEUE_SIZE_PULSE_RAW, sizeof(uint32_t));  // Placeholder size
-    motionRawDataQueue = xQueueCreate(QUEUE_SIZE_MOTION_RAW, sizeof(uint32_t));
-    pressureRawDataQueue = xQueueCreate(QUEUE_SIZE_PRESSURE_RAW, sizeof(uint32_t));
-
-    // Processed sensor data queues
-    pulseProcessedQueue = xQueueCreate(QUEUE_SIZE_PULSE_PROCESSED, sizeof(uint32_t));
-    motionProcessedQueue = xQueueCreate(QUEUE_SIZE_MOTION_PROCESSED, sizeof(uint32_t));
-    pressureProcessedQueue = xQueueCreate(QUEUE_SIZE_PRESSURE_PROCESSED, sizeof(uint32_t));
+    // Sensor data streams are SPSC ring buffers owned by their producers
+    // (see SPSCRingBuffer.h), so only command and event queues live here
 
     // Command and control queues
-    servoCommandQueue = xQueueCreate(QUEUE_SIZE_SERVO_COMMANDS, sizeof(uint32_t));
-    i2cRequestQueue = xQueueCreate(QUEUE_SIZE_I2C_REQUESTS, sizeof(I2CRequest));
-    mqttPublishQueue = xQueueCreate(QUEUE_SIZE_MQTT_PUBLISH, sizeof(MQTTMessage));
-    sessionEventQueue = xQueueCreate(QUEUE_SIZE_SESSION_EVENTS, sizeof(uint32_t));
-    systemAlertQueue = xQueueCreate(QUEUE_SIZE_SYSTEM_ALERTS, sizeof(SystemAlert));
-
-    // Analytics and fusion queues
-    fusedDataQueue = xQueueCreate(QUEUE_SIZE_FUSED_DATA, sizeof(uint32_t));
-    movementAnalyticsQueue = xQueueCreate(QUEUE_SIZE_MOVEMENT_ANALYTICS, sizeof(uint32_t));
-    clinicalDataQueue = xQueueCreate(QUEUE_SIZE_CLINICAL_DATA, sizeof(uint32_t));
-    performanceMetricsQueue = xQueueCreate(QUEUE_SIZE_PERFORMANCE_METRICS, sizeof(TaskPerformanceMetrics));
+    // Depths are the QUEUE_SIZE_* constants unless a resource profile is applied
+    servoCommandQueue = createProfiledQueue(ProfiledQueue::SERVO_COMMANDS, sizeof(uint32_t));
+    i2cRequestQueue = createProfiledQueue(ProfiledQueue::I2C_REQUESTS, sizeof(I2CRequest));
+    mqttPublishQueue = createProfiledQueue(ProfiledQueue::MQTT_PUBLISH, sizeof(MQTTMessage));
+    mqttPriorityQueue = createProfiledQueue(ProfiledQueue::MQTT_PRIORITY, sizeof(MQTTMessage));
+    sessionEventQueue = createProfiledQueue(ProfiledQueue::SESSION_EVENTS, sizeof(uint32_t));
+    systemAlertQueue = createProfiledQueue(ProfiledQueue::SYSTEM_ALERTS, sizeof(SystemAlert));
+    deviceCommandQueue = createProfiledQueue(ProfiledQueue::DEVICE_COMMANDS, sizeof(Command));
+
+    // Analytics queues
+    movementAnalyticsQueue = createProfiledQueue(ProfiledQueue::MOVEMENT_ANALYTICS, sizeof(uint32_t));
+    clinicalDataQueue = createProfiledQueue(ProfiledQueue::CLINICAL_DATA, sizeof(uint32_t));
+    performanceMetricsQueue = createProfiledQueue(ProfiledQueue::PERFORMANCE_METRICS, sizeof(TaskPerformanceMetrics));
 
     if (!validateQueueCreation()) {
         Logger::error("Queue creation validation failed");
@@ -187,6 +174,12 @@ bool FreeRTOSManager::createQueues() {
     return true;
 }
 
+QueueHandle_t FreeRTOSManager::createProfiledQueue(ProfiledQueue queue, size_t itemSize) {
+    QueueHandle_t handle = xQueueCreate(ResourceProfiler::getQueueDepth(queue), itemSize);
+    if (handle) ResourceProfiler::registerQueue(queue, handle, itemSize);
+    return handle;
+}
+
 bool FreeRTOSManager::createSemaphores() {
     if (semaphoresCreated) return true;
 
@@ -198,7 +191,6 @@ bool FreeRTOSManager::createSemaphores() {
     sessionDataMutex = xSemaphoreCreateMutex();
     configMutex = xSemaphoreCreateMutex();
     mqttClientMutex = xSemaphoreCreateMutex();
-    sensorDataPoolMutex = xSemaphoreCreateMutex();
 
     // Binary semaphores for event signaling
     pulseDataReady = xSemaphoreCreateBinary();
@@ -239,23 +231,19 @@ void FreeRTOSManager::destroyQueues() {
     if (!queuesCreated) return;
 
     Logger::info("Destroying FreeRTOS queues...");
+    ResourceProfiler::unregisterQueues();
 
     // Delete all queues
-    if (pulseRawDataQueue) { vQueueDelete(pulseRawDataQueue); pulseRawDataQueue = nullptr; }
-    if (motionRawDataQueue) { vQueueDelete(motionRawDataQueue); motionRawDataQueue = nullptr; }
-    if (pressureRawDataQueue) { vQueueDelete(pressureRawDataQueue); pressureRawDataQueue = nullptr; }
-    if (pulseProcessedQueue) { vQueueDelete(pulseProcessedQueue); pulseProcessedQueue = nullptr; }
-    if (motionProcessedQueue) { vQueueDelete(motionProcessedQueue); motionProcessedQueue = nullptr; }
-    if (pressureProcessedQueue) { vQueueDelete(pressureProcessedQueue); pressureProcessedQueue = nullptr; }
     if (servoCommandQueue) { vQueueDelete(servoCommandQueue); servoCommandQueue = nullptr; }
     if (i2cRequestQueue) { vQueueDelete(i2cRequestQueue); i2cRequestQueue = nullptr; }
     if (mqttPublishQueue) { vQueueDelete(mqttPublishQueue); mqttPublishQueue = nullptr; }
+    if (mqttPriorityQueue) { vQueueDelete(mqttPriorityQueue); mqttPriorityQueue = nullptr; }
     if (sessionEventQueue) { vQueueDelete(sessionEventQueue); sessionEventQueue = nullptr; }
     if (systemAlertQueue) { vQueueDelete(systemAlertQueue); systemAlertQueue = nullptr; }
-    if (fusedDataQueue) { vQueueDelete(fusedDataQueue); fusedDataQueue = nullptr; }
     if (movementAnalyticsQueue) { vQueueDelete(movementAnalyticsQueue); movementAnalyticsQueue = nullptr; }
     if (clinicalDataQueue) { vQueueDelete(clinicalDataQueue); clinicalDataQueue = nullptr; }
     if (performanceMetricsQueue) { vQueueDelete(performanceMetricsQueue); performanceMetricsQueue = nullptr; }
+    if (deviceCommandQueue) { vQueueDelete(deviceCommandQueue); deviceCommandQueue = nullptr; }
 
     queuesCreated = false;
     Logger::info("All queues destroyed");
@@ -272,7 +260,6 @@ void FreeRTOSManager::destroySemaphores() {
     if (sessionDataMutex) { vSemaphoreDelete(sessionDataMutex); sessionDataMutex = nullptr; }
     if (configMutex) { vSemaphoreDelete(configMutex); configMutex = nullptr; }
     if (mqttClientMutex) { vSemaphoreDelete(mqttClientMutex); mqttClientMutex = nullptr; }
-    if (sensorDataPoolMutex) { vSemaphoreDelete(sensorDataPoolMutex); sensorDataPoolMutex = nullptr; }
     if (pulseDataReady) { vSemaphoreDelete(pulseDataReady); pulseDataReady = nullptr; }
     if (motionDataReady) { vSemaphoreDelete(motionDataReady); motionDataReady = nullptr; }
     if (sessionStarted) { vSemaphoreDelete(sessionStarted); sessionStarted = nullptr; }
@@ -299,21 +286,16 @@ void FreeRTOSManager::destroyEventGroups() {
 // QUEUE ACCESS METHODS
 // =============================================================================
 
-QueueHandle_t FreeRTOSManager::getPulseRawDataQueue() { return pulseRawDataQueue; }
-QueueHandle_t FreeRTOSManager::getMotionRawDataQueue() { return motionRawDataQueue; }
-QueueHandle_t FreeRTOSManager::getPressureRawDataQueue() { return pressureRawDataQueue; }
-QueueHandle_t FreeRTOSManager::getPulseProcessedQueue() { return pulseProcessedQueue; }
-QueueHandle_t FreeRTOSManager::getMotionProcessedQueue() { return motionProcessedQueue; }
-QueueHandle_t FreeRTOSManager::getPressureProcessedQueue() { return pressureProcessedQueue; }
 QueueHandle_t FreeRTOSManager::getServoCommandQueue() { return servoCommandQueue; }
 QueueHandle_t FreeRTOSManager::getI2CRequestQueue() { return i2cRequestQueue; }
 QueueHandle_t FreeRTOSManager::getMQTTPublishQueue() { return mqttPublishQueue; }
+QueueHandle_t FreeRTOSManager::getMQTTPriorityQueue() { return mqttPriorityQueue; }
 QueueHandle_t FreeRTOSManager::getSessionEventQueue() { return sessionEventQueue; }
 QueueHandle_t FreeRTOSManager::getSystemAlertQueue() { return systemAlertQueue; }
-QueueHandle_t FreeRTOSManager::getFusedDataQueue() { return fusedDataQueue; }
 QueueHandle_t FreeRTOSManager::getMovementAnalyticsQueue() { return movementAnalyticsQueue; }
 QueueHandle_t FreeRTOSManager::getClinicalDataQueue() { return clinicalDataQueue; }
 QueueHandle_t FreeRTOSManager::getPerformanceMetricsQueue() { return performanceMetricsQueue; }
+QueueHandle_t FreeRTOSManager::getDeviceCommandQueue() { return deviceCommandQueue; }
 
 // =============================================================================
 // SEMAPHORE ACCESS METHODS
@@ -530,6 +512,8 @@ void FreeRTOSManager::logSystemPerformance() {
                          metrics->stackHighWaterMark);
         }
     }
+    TaskTracer::logStatistics();
+    SensorDataPool::logStatistics();
     Logger::info("================================");
 }
 
@@ -549,6 +533,7 @@ void FreeRTOSManager::reportSystemAlert(uint8_t level, uint32_t errorCode, const
     alert.description[sizeof(alert.description) - 1] = '\0';
 
     BaseType_t result = xQueueSend(systemAlertQueue, &alert, pdMS_TO_TICKS(100));
+    ResourceProfiler::recordQueueSend(ProfiledQueue::SYSTEM_ALERTS, result == pdTRUE);
     if (result != pdTRUE) {
         Logger::error("Failed to queue system alert - queue full");
     }
@@ -566,37 +551,11 @@ bool FreeRTOSManager::handleSystemAlert(SystemAlert* alert) {
 // =============================================================================
 
 void* FreeRTOSManager::allocateSensorData(size_t size) {
-    if (!sensorDataPoolMutex || size > (SENSOR_DATA_POOL_SIZE / SENSOR_DATA_POOL_ITEMS)) {
-        return nullptr;
-    }
-
-    if (xSemaphoreTake(sensorDataPoolMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        for (size_t i = 0; i < SENSOR_DATA_POOL_ITEMS; i++) {
-            if (!sensorDataPoolAllocated[i]) {
-                sensorDataPoolAllocated[i] = true;
-                xSemaphoreGive(sensorDataPoolMutex);
-                return &sensorDataPool[i * (SENSOR_DATA_POOL_SIZE / SENSOR_DATA_POOL_ITEMS)];
-            }
-        }
-        xSemaphoreGive(sensorDataPoolMutex);
-    }
-
-    return nullptr;  // Pool exhausted
+    return SensorDataPool::allocate(size);
 }
 
 void FreeRTOSManager::freeSensorData(void* ptr) {
-    if (!ptr || !sensorDataPoolMutex) return;
-
-    if (xSemaphoreTake(sensorDataPoolMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        size_t itemSize = SENSOR_DATA_POOL_SIZE / SENSOR_DATA_POOL_ITEMS;
-        size_t index = ((uint8_t*)ptr - sensorDataPool) / itemSize;
-
-        if (index < SENSOR_DATA_POOL_ITEMS) {
-            sensorDataPoolAllocated[index] = false;
-        }
-
-        xSemaphoreGive(sensorDataPoolMutex);
-    }
+    SensorDataPool::free(ptr);
 }
 
 size_t FreeRTOSManager::getAvailableHeap() {
@@ -622,7 +581,8 @@ bool FreeRTOSManager::checkSystemHealth() {
     }
 
     // Check queue usage
-    if (systemAlertQueue && uxQueueMessagesWaiting(systemAlertQueue) > (QUEUE_SIZE_SYSTEM_ALERTS * 0.8)) {
+    UBaseType_t alertDepth = ResourceProfiler::getQueueDepth(ProfiledQueue::SYSTEM_ALERTS);
+    if (systemAlertQueue && uxQueueMessagesWaiting(systemAlertQueue) > (alertDepth * 0.8)) {
         Logger::warning("System alert queue nearly full");
         healthy = false;
     }
@@ -643,7 +603,7 @@ void FreeRTOSManager::feedTaskWatchdog(TaskHandle_t task) {
     // Implementation depends on ESP32 watchdog configuration
     // For now, just log the watchdog feed
     if (task) {
-        Logger::debugf("Watchdog fed by task: %s", pcTaskGetName(task));
+        LOG_DEBUGF("Watchdog fed by task: %s", pcTaskGetName(task));
     }
 }
 
@@ -697,21 +657,16 @@ void FreeRTOSManager::destroyTasks() {
 bool FreeRTOSManager::validateQueueCreation() {
     bool valid = true;
 
-    if (!pulseRawDataQueue) { Logger::error("Failed to create pulseRawDataQueue"); valid = false; }
-    if (!motionRawDataQueue) { Logger::error("Failed to create motionRawDataQueue"); valid = false; }
-    if (!pressureRawDataQueue) { Logger::error("Failed to create pressureRawDataQueue"); valid = false; }
-    if (!pulseProcessedQueue) { Logger::error("Failed to create pulseProcessedQueue"); valid = false; }
-    if (!motionProcessedQueue) { Logger::error("Failed to create motionProcessedQueue"); valid = false; }
-    if (!pressureProcessedQueue) { Logger::error("Failed to create pressureProcessedQueue"); valid = false; }
     if (!servoCommandQueue) { Logger::error("Failed to create servoCommandQueue"); valid = false; }
     if (!i2cRequestQueue) { Logger::error("Failed to create i2cRequestQueue"); valid = false; }
     if (!mqttPublishQueue) { Logger::error("Failed to create mqttPublishQueue"); valid = false; }
+    if (!mqttPriorityQueue) { Logger::error("Failed to create mqttPriorityQueue"); valid = false; }
     if (!sessionEventQueue) { Logger::error("Failed to create sessionEventQueue"); valid = false; }
     if (!systemAlertQueue) { Logger::error("Failed to create systemAlertQueue"); valid = false; }
-    if (!fusedDataQueue) { Logger::error("Failed to create fusedDataQueue"); valid = false; }
     if (!movementAnalyticsQueue) { Logger::error("Failed to create movementAnalyticsQueue"); valid = false; }
     if (!clinicalDataQueue) { Logger::error("Failed to create clinicalDataQueue"); valid = false; }
     if (!performanceMetricsQueue) { Logger::error("Failed to create performanceMetricsQueue"); valid = false; }
+    if (!deviceCommandQueue) { Logger::error("Failed to create deviceCommandQueue"); valid = false; }
 
     return valid;
 }
@@ -724,7 +679,6 @@ bool FreeRTOSManager::validateSemaphoreCreation() {
     if (!sessionDataMutex) { Logger::error("Failed to create sessionDataMutex"); valid = false; }
     if (!configMutex) { Logger::error("Failed to create configMutex"); valid = false; }
     if (!mqttClientMutex) { Logger::error("Failed to create mqttClientMutex"); valid = false; }
-    if (!sensorDataPoolMutex) { Logger::error("Failed to create sensorDataPoolMutex"); valid = false; }
     if (!pulseDataReady) { Logger::error("Failed to create pulseDataReady"); valid = false; }
     if (!motionDataReady) { Logger::error("Failed to create motionDataReady"); valid = false; }
     if (!sessionStarted) { Logger::error("Failed to create sessionStarted"); valid = false; }
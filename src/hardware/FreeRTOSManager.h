@@ -9,6 +9,9 @@
 #include <freertos/event_groups.h>
 #include "../config/Config.h"
 #include "../utils/Logger.h"
+#include "../memory/SensorDataPool.h"
+#include "../app/Command.h"
+#include "ResourceProfiler.h"
 
 // Forward declarations
 class DeviceManager;
@@ -28,12 +31,14 @@ struct I2CRequest {
     bool* successFlag;
     TickType_t timeout;
     uint32_t requestId;
+    int8_t transactionSlot;  // I2CManager slot owning the buffers, -1 if the caller owns them
 };
 
 // MQTT Message Structure
 struct MQTTMessage {
     char topic[128];
     char payload[MAX_MQTT_MESSAGE_SIZE];
+    uint16_t payloadLength;  // Binary payloads are not null-terminated
     bool retain;
     uint8_t qos;
     uint32_t timestamp;
@@ -49,6 +54,8 @@ struct SystemAlert {
     uint32_t timestamp;
 };
 
+// Device command queue items are Commands (app/Command.h), parsed where the text arrived
+
 // Task Performance Metrics
 struct TaskPerformanceMetrics {
     uint32_t executionTime;
@@ -87,21 +94,16 @@ public:
     static void destroyTasks();
     
     // Queue Access Methods
-    static QueueHandle_t getPulseRawDataQueue();
-    static QueueHandle_t getMotionRawDataQueue();
-    static QueueHandle_t getPressureRawDataQueue();
-    static QueueHandle_t getPulseProcessedQueue();
-    static QueueHandle_t getMotionProcessedQueue();
-    static QueueHandle_t getPressureProcessedQueue();
     static QueueHandle_t getServoCommandQueue();
     static QueueHandle_t getI2CRequestQueue();
     static QueueHandle_t getMQTTPublishQueue();
+    static QueueHandle_t getMQTTPriorityQueue();
     static QueueHandle_t getSessionEventQueue();
     static QueueHandle_t getSystemAlertQueue();
-    static QueueHandle_t getFusedDataQueue();
     static QueueHandle_t getMovementAnalyticsQueue();
     static QueueHandle_t getClinicalDataQueue();
     static QueueHandle_t getPerformanceMetricsQueue();
+    static QueueHandle_t getDeviceCommandQueue();
 
     // Semaphore Access Methods
     static SemaphoreHandle_t getI2CBusMutex();
@@ -163,7 +165,7 @@ public:
     static void reportSystemAlert(uint8_t level, uint32_t errorCode, const char* description);
     static bool handleSystemAlert(SystemAlert* alert);
 
-    // Memory Management
+    // Memory Management (fixed-block pool, safe from ISRs)
     static void* allocateSensorData(size_t size);
     static void freeSensorData(void* ptr);
     static size_t getAvailableHeap();
@@ -183,21 +185,16 @@ private:
     static bool tasksCreated;
 
     // Queue handles
-    static QueueHandle_t pulseRawDataQueue;
-    static QueueHandle_t motionRawDataQueue;
-    static QueueHandle_t pressureRawDataQueue;
-    static QueueHandle_t pulseProcessedQueue;
-    static QueueHandle_t motionProcessedQueue;
-    static QueueHandle_t pressureProcessedQueue;
     static QueueHandle_t servoCommandQueue;
     static QueueHandle_t i2cRequestQueue;
     static QueueHandle_t mqttPublishQueue;
+    static QueueHandle_t mqttPriorityQueue;
     static QueueHandle_t sessionEventQueue;
     static QueueHandle_t systemAlertQueue;
-    static QueueHandle_t fusedDataQueue;
     static QueueHandle_t movementAnalyticsQueue;
     static QueueHandle_t clinicalDataQueue;
     static QueueHandle_t performanceMetricsQueue;
+    static QueueHandle_t deviceCommandQueue;
 
     // Semaphore handles
     static SemaphoreHandle_t i2cBusMutex;
@@ -234,12 +231,8 @@ private:
     static TaskPerformanceMetrics taskMetrics[20];  // Support up to 20 tasks
     static uint8_t taskMetricsCount;
 
-    // Memory pool for sensor data
-    static uint8_t sensorDataPool[SENSOR_DATA_POOL_SIZE];
-    static bool sensorDataPoolAllocated[SENSOR_DATA_POOL_ITEMS];
-    static SemaphoreHandle_t sensorDataPoolMutex;
-
     // Internal helper methods
+    static QueueHandle_t createProfiledQueue(ProfiledQueue queue, size_t itemSize);
     static bool validateQueueCreation();
     static bool validateSemaphoreCreation();
     static bool validateEventGroupCreation();
@@ -1,4 +1,6 @@
 #include "I2CManager.h"
+#include "ResourceProfiler.h"
+#include "TaskTracer.h"
 
 // =============================================================================
 // STATIC MEMBER INITIALIZATION
@@ -9,12 +11,16 @@ bool I2CManager::taskRunning = false;
 TaskHandle_t I2CManager::taskHandle = nullptr;
 uint32_t I2CManager::transactionCount = 0;
 uint32_t I2CManager::errorCount = 0;
+uint32_t I2CManager::timeoutCount = 0;
+uint32_t I2CManager::nextRequestId = 0;
 uint32_t I2CManager::lastScanTime = 0;
 uint8_t I2CManager::connectedDevices[128] = {0};
 uint8_t I2CManager::connectedDeviceCount = 0;
 bool I2CManager::busRecoveryInProgress = false;
 uint32_t I2CManager::lastRecoveryTime = 0;
 uint8_t I2CManager::recoveryAttempts = 0;
+I2CManager::TransactionSlot I2CManager::slots[I2C_TRANSACTION_SLOTS];
+portMUX_TYPE I2CManager::slotLock = portMUX_INITIALIZER_UNLOCKED;
 
 // =============================================================================
 // PUBLIC METHODS
@@ -28,6 +34,11 @@ bool I2CManager::initialize() {
 
     Logger::info("Initializing I2C Manager...");
 
+    if (!initializeSlots()) {
+        Logger::error("Failed to create I2C transaction slots");
+        return false;
+    }
+
     // Initialize I2C bus
     if (!initializeBus()) {
         Logger::error("Failed to initialize I2C bus");
@@ -37,6 +48,7 @@ bool I2CManager::initialize() {
     // Reset statistics
     transactionCount = 0;
     errorCount = 0;
+    timeoutCount = 0;
     connectedDeviceCount = 0;
     memset(connectedDevices, 0, sizeof(connectedDevices));
 
@@ -70,124 +82,221 @@ bool I2CManager::isInitialized() {
 }
 
 bool I2CManager::writeRegister(uint8_t deviceAddress, uint8_t registerAddress, uint8_t value) {
-    if (!initialized) return false;
-
     uint8_t data[2] = {registerAddress, value};
-    
-    I2CRequest request;
-    request.deviceAddress = deviceAddress;
-    request.writeData = data;
-    request.writeLength = 2;
-    request.readBuffer = nullptr;
-    request.readLength = 0;
-    request.completionSemaphore = xSemaphoreCreateBinary();
-    request.timeout = pdMS_TO_TICKS(I2C_TIMEOUT_MS);
-    request.requestId = millis();
+    return transfer(deviceAddress, data, sizeof(data), nullptr, 0);
+}
 
-    bool success = false;
-    request.successFlag = &success;
+bool I2CManager::writeRegister16(uint8_t deviceAddress, uint8_t registerAddress, uint16_t value) {
+    uint8_t data[3] = {registerAddress, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF)};
+    return transfer(deviceAddress, data, sizeof(data), nullptr, 0);
+}
 
-    if (queueRequest(request)) {
-        // Wait for completion
-        if (xSemaphoreTake(request.completionSemaphore, request.timeout) == pdTRUE) {
-            vSemaphoreDelete(request.completionSemaphore);
-            return success;
-        }
+bool I2CManager::writeData(uint8_t deviceAddress, uint8_t* data, size_t length) {
+    if (!data || length == 0) return false;
+    return transfer(deviceAddress, data, length, nullptr, 0);
+}
+
+bool I2CManager::readRegister(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* value) {
+    if (!value) return false;
+    return transfer(deviceAddress, &registerAddress, 1, value, 1);
+}
+
+bool I2CManager::readRegister16(uint8_t deviceAddress, uint8_t registerAddress, uint16_t* value) {
+    if (!value) return false;
+
+    uint8_t readData[2];
+    if (!transfer(deviceAddress, &registerAddress, 1, readData, sizeof(readData))) {
+        return false;
     }
 
-    vSemaphoreDelete(request.completionSemaphore);
-    return false;
+    *value = (readData[0] << 8) | readData[1];
+    return true;
 }
 
-bool I2CManager::writeRegister16(uint8_t deviceAddress, uint8_t registerAddress, uint16_t value) {
-    if (!initialized) return false;
+bool I2CManager::readData(uint8_t deviceAddress, uint8_t* buffer, size_t length) {
+    if (!buffer || length == 0) return false;
+    return transfer(deviceAddress, nullptr, 0, buffer, length);
+}
+
+bool I2CManager::readRegisterData(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* buffer, size_t length) {
+    if (!buffer || length == 0) return false;
+    return transfer(deviceAddress, &registerAddress, 1, buffer, length);
+}
+
+// =============================================================================
+// TRANSACTION ENGINE
+// =============================================================================
+
+int I2CManager::beginTransaction(uint8_t deviceAddress, const uint8_t* writeData, size_t writeLength,
+                                 size_t readLength) {
+    if (!initialized || !taskRunning) return -1;
+    if (writeLength > I2C_MAX_TRANSFER_SIZE || readLength > I2C_MAX_TRANSFER_SIZE) return -1;
+    if (writeLength > 0 && !writeData) return -1;
+
+    int index = acquireSlot();
+    if (index < 0) {
+        Logger::warningf("I2C transaction slots exhausted (device 0x%02X)", deviceAddress);
+        return -1;
+    }
+
+    TransactionSlot& slot = slots[index];
+    if (writeLength > 0) {
+        memcpy(slot.buffer, writeData, writeLength);
+    }
+    slot.readLength = readLength;
+    slot.success = false;
 
-    uint8_t data[3] = {registerAddress, (uint8_t)(value >> 8), (uint8_t)(value & 0xFF)};
-    
     I2CRequest request;
     request.deviceAddress = deviceAddress;
-    request.writeData = data;
-    request.writeLength = 3;
-    request.readBuffer = nullptr;
-    request.readLength = 0;
-    request.completionSemaphore = xSemaphoreCreateBinary();
-    request.timeout = pdMS_TO_TICKS(I2C_TIMEOUT_MS);
-    request.requestId = millis();
+    request.writeData = slot.buffer;
+    request.writeLength = writeLength;
+    request.readBuffer = slot.buffer;  // Read data replaces the already-sent write data
+    request.readLength = readLength;
+    request.completionSemaphore = nullptr;  // The engine signals slot.completion itself
+    request.successFlag = &slot.success;
+    request.timeout = pdMS_TO_TICKS(calculateTimeout(writeLength + readLength));
+    request.requestId = nextRequestId++;
+    request.transactionSlot = index;
+
+    if (!queueRequest(request)) {
+        releaseSlot(index);
+        return -1;
+    }
 
-    bool success = false;
-    request.successFlag = &success;
+    return index;
+}
 
-    if (queueRequest(request)) {
-        if (xSemaphoreTake(request.completionSemaphore, request.timeout) == pdTRUE) {
-            vSemaphoreDelete(request.completionSemaphore);
-            return success;
+bool I2CManager::waitForTransaction(int transaction, uint8_t* readBuffer, TickType_t timeout) {
+    if (transaction < 0 || transaction >= I2C_TRANSACTION_SLOTS) return false;
+
+    TransactionSlot& slot = slots[transaction];
+
+    if (xSemaphoreTake(slot.completion, timeout) != pdTRUE) {
+        // Still queued or on the bus - hand the slot back to the engine
+        bool abandoned = false;
+        portENTER_CRITICAL(&slotLock);
+        if (slot.state == SlotState::QUEUED) {
+            slot.state = SlotState::ABANDONED;
+            abandoned = true;
+        }
+        portEXIT_CRITICAL(&slotLock);
+
+        if (abandoned) {
+            timeoutCount++;
+            return false;
         }
+        // Completed right after the timeout expired - fall through and collect it
+    }
+
+    bool success = slot.success;
+    if (success && readBuffer && slot.readLength > 0) {
+        memcpy(readBuffer, slot.buffer, slot.readLength);
     }
 
-    vSemaphoreDelete(request.completionSemaphore);
-    return false;
+    releaseSlot(transaction);
+    return success;
 }
 
-bool I2CManager::readRegister(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* value) {
-    if (!initialized || !value) return false;
+bool I2CManager::transfer(uint8_t deviceAddress, const uint8_t* writeData, size_t writeLength,
+                          uint8_t* readBuffer, size_t readLength) {
+    if (!initialized) return false;
 
-    uint8_t writeData = registerAddress;
-    
-    I2CRequest request;
-    request.deviceAddress = deviceAddress;
-    request.writeData = &writeData;
-    request.writeLength = 1;
-    request.readBuffer = value;
-    request.readLength = 1;
-    request.completionSemaphore = xSemaphoreCreateBinary();
-    request.timeout = pdMS_TO_TICKS(I2C_TIMEOUT_MS);
-    request.requestId = millis();
+    // Already on the bus owner (or no owner yet) - run the job in place
+    if (!taskRunning || isEngineTask()) {
+        I2CRequest request = {};
+        request.deviceAddress = deviceAddress;
+        request.writeData = (uint8_t*)writeData;
+        request.writeLength = writeLength;
+        request.readBuffer = readBuffer;
+        request.readLength = readLength;
+        request.transactionSlot = -1;
+        return executeRequest(request);
+    }
 
-    bool success = false;
-    request.successFlag = &success;
+    int transaction = beginTransaction(deviceAddress, writeData, writeLength, readLength);
+    if (transaction < 0) return false;
+
+    return waitForTransaction(transaction, readBuffer,
+                              pdMS_TO_TICKS(calculateTimeout(writeLength + readLength)));
+}
+
+bool I2CManager::probeDevice(uint8_t deviceAddress) {
+    // A zero-length write only checks for an ACK
+    return transfer(deviceAddress, nullptr, 0, nullptr, 0);
+}
 
-    if (queueRequest(request)) {
-        if (xSemaphoreTake(request.completionSemaphore, request.timeout) == pdTRUE) {
-            vSemaphoreDelete(request.completionSemaphore);
-            return success;
+bool I2CManager::initializeSlots() {
+    for (int i = 0; i < I2C_TRANSACTION_SLOTS; i++) {
+        if (!slots[i].completion) {
+            slots[i].completion = xSemaphoreCreateBinaryStatic(&slots[i].completionStorage);
+            if (!slots[i].completion) return false;
         }
+        slots[i].state = SlotState::FREE;
     }
+    return true;
+}
 
-    vSemaphoreDelete(request.completionSemaphore);
-    return false;
+int I2CManager::acquireSlot() {
+    int index = -1;
+
+    portENTER_CRITICAL(&slotLock);
+    for (int i = 0; i < I2C_TRANSACTION_SLOTS; i++) {
+        if (slots[i].state == SlotState::FREE) {
+            slots[i].state = SlotState::QUEUED;
+            index = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&slotLock);
+
+    return index;
 }
 
-bool I2CManager::readRegister16(uint8_t deviceAddress, uint8_t registerAddress, uint16_t* value) {
-    if (!initialized || !value) return false;
+void I2CManager::releaseSlot(int index) {
+    // Drop a completion that raced with a timeout so the next owner starts clean
+    xSemaphoreTake(slots[index].completion, 0);
 
-    uint8_t writeData = registerAddress;
-    uint8_t readData[2];
-    
-    I2CRequest request;
-    request.deviceAddress = deviceAddress;
-    request.writeData = &writeData;
-    request.writeLength = 1;
-    request.readBuffer = readData;
-    request.readLength = 2;
-    request.completionSemaphore = xSemaphoreCreateBinary();
-    request.timeout = pdMS_TO_TICKS(I2C_TIMEOUT_MS);
-    request.requestId = millis();
+    portENTER_CRITICAL(&slotLock);
+    slots[index].state = SlotState::FREE;
+    portEXIT_CRITICAL(&slotLock);
+}
 
-    bool success = false;
-    request.successFlag = &success;
-
-    if (queueRequest(request)) {
-        if (xSemaphoreTake(request.completionSemaphore, request.timeout) == pdTRUE) {
-            if (success) {
-                *value = (readData[0] << 8) | readData[1];
-            }
-            vSemaphoreDelete(request.completionSemaphore);
-            return success;
-        }
+void I2CManager::processRequest(I2CRequest& request) {
+    int index = request.transactionSlot;
+    if (index < 0 || index >= I2C_TRANSACTION_SLOTS) {
+        // Caller-managed request (queueRequest)
+        executeRequest(request);
+        return;
+    }
+
+    TransactionSlot& slot = slots[index];
+
+    // Skip work nobody is waiting for any more
+    if (slot.state == SlotState::ABANDONED) {
+        releaseSlot(index);
+        return;
     }
 
-    vSemaphoreDelete(request.completionSemaphore);
-    return false;
+    executeRequest(request);
+
+    bool abandoned = false;
+    portENTER_CRITICAL(&slotLock);
+    if (slot.state == SlotState::ABANDONED) {
+        abandoned = true;
+    } else {
+        slot.state = SlotState::COMPLETE;
+    }
+    portEXIT_CRITICAL(&slotLock);
+
+    if (abandoned) {
+        releaseSlot(index);
+    } else {
+        xSemaphoreGive(slot.completion);
+    }
+}
+
+bool I2CManager::isEngineTask() {
+    return taskHandle != nullptr && xTaskGetCurrentTaskHandle() == taskHandle;
 }
 
 bool I2CManager::scanDevices() {
@@ -236,6 +345,10 @@ uint32_t I2CManager::getErrorCount() {
     return errorCount;
 }
 
+uint32_t I2CManager::getTimeoutCount() {
+    return timeoutCount;
+}
+
 float I2CManager::getSuccessRate() {
     if (transactionCount == 0) return 1.0f;
     return (float)(transactionCount - errorCount) / transactionCount;
@@ -247,7 +360,7 @@ void I2CManager::startTask() {
     BaseType_t result = xTaskCreatePinnedToCore(
         i2cManagerTask,
         "I2CManager",
-        TASK_STACK_I2C_MANAGER,
+        ResourceProfiler::getStackSize(ProfiledTask::I2C_MANAGER),
         nullptr,
         PRIORITY_I2C_MANAGER,
         &taskHandle,
@@ -279,8 +392,9 @@ bool I2CManager::queueRequest(const I2CRequest& request) {
     QueueHandle_t queue = FreeRTOSManager::getI2CRequestQueue();
     if (!queue) return false;
 
-    BaseType_t result = xQueueSend(queue, &request, pdMS_TO_TICKS(100));
-    return (result == pdTRUE);
+    bool sent = xQueueSend(queue, &request, pdMS_TO_TICKS(100)) == pdTRUE;
+    ResourceProfiler::recordQueueSend(ProfiledQueue::I2C_REQUESTS, sent);
+    return sent;
 }
 
 bool I2CManager::executeRequest(const I2CRequest& request) {
@@ -299,9 +413,14 @@ bool I2CManager::executeRequest(const I2CRequest& request) {
     } else if (request.readLength > 0) {
         // Read-only operation
         success = performRead(request.deviceAddress, request.readBuffer, request.readLength);
+    } else {
+        // Address-only probe
+        Wire.beginTransmission(request.deviceAddress);
+        success = (Wire.endTransmission() == 0);
     }
 
-    if (!success) {
+    // A failed probe just means the device is absent
+    if (!success && (request.writeLength > 0 || request.readLength > 0)) {
         errorCount++;
         handleI2CError(request.deviceAddress, "transaction");
     }
@@ -331,10 +450,14 @@ void I2CManager::i2cManagerTask(void* parameter) {
     uint32_t lastHealthCheck = 0;
     uint32_t lastDeviceScan = 0;
 
+    // Request driven - traces how long each bus transaction takes
+    TraceId traceId = TaskTracer::registerTask("I2CManager");
+
     while (true) {
         // Process I2C requests
         if (xQueueReceive(requestQueue, &request, pdMS_TO_TICKS(100)) == pdTRUE) {
-            executeRequest(request);
+            TaskTracer::ScopedTimer timer(traceId);
+            processRequest(request);
         }
 
         uint32_t now = millis();
@@ -412,14 +535,18 @@ bool I2CManager::performRead(uint8_t deviceAddress, uint8_t* buffer, size_t leng
 
 bool I2CManager::performWriteRead(uint8_t deviceAddress, uint8_t* writeData, size_t writeLength,
                                 uint8_t* readBuffer, size_t readLength) {
-    // First perform write
-    if (!performWrite(deviceAddress, writeData, writeLength)) {
+    if (!writeData || writeLength == 0) return false;
+
+    // Write without a stop condition so the read follows as a repeated start
+    Wire.beginTransmission(deviceAddress);
+    size_t written = Wire.write(writeData, writeLength);
+    uint8_t error = Wire.endTransmission(false);
+
+    if (error != 0 || written != writeLength) {
+        logI2COperation(deviceAddress, "write", false);
         return false;
     }
 
-    // Small delay between write and read
-    vTaskDelay(pdMS_TO_TICKS(1));
-
     // Then perform read
     return performRead(deviceAddress, readBuffer, readLength);
 }
@@ -506,7 +633,7 @@ void I2CManager::handleI2CError(uint8_t deviceAddress, const char* operation) {
 }
 
 void I2CManager::logI2COperation(uint8_t deviceAddress, const char* operation, bool success) {
-    Logger::debugf("I2C %s to 0x%02X: %s", operation, deviceAddress, success ? "OK" : "FAIL");
+    LOG_DEBUGF("I2C %s to 0x%02X: %s", operation, deviceAddress, success ? "OK" : "FAIL");
 }
 
 uint32_t I2CManager::calculateTimeout(size_t dataLength) {
@@ -566,6 +693,12 @@ bool I2CDevice::readRegister16(uint8_t registerAddress, uint16_t* value) {
     return success;
 }
 
+bool I2CDevice::readRegisters(uint8_t registerAddress, uint8_t* buffer, size_t length) {
+    bool success = I2CManager::readRegisterData(deviceAddress, registerAddress, buffer, length);
+    recordCommunication(success);
+    return success;
+}
+
 bool I2CDevice::readData(uint8_t* buffer, size_t length) {
     bool success = I2CManager::readData(deviceAddress, buffer, length);
     recordCommunication(success);
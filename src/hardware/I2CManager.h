@@ -32,15 +32,25 @@ public:
     static bool readData(uint8_t deviceAddress, uint8_t* buffer, size_t length);
     static bool readRegisterData(uint8_t deviceAddress, uint8_t registerAddress, uint8_t* buffer, size_t length);
 
+    // Asynchronous transactions - the write and the repeated-start read run
+    // as one job on the I2C task, so drivers never interleave on the bus
+    static int beginTransaction(uint8_t deviceAddress, const uint8_t* writeData, size_t writeLength,
+                                size_t readLength);
+    static bool waitForTransaction(int transaction, uint8_t* readBuffer, TickType_t timeout);
+    static bool transfer(uint8_t deviceAddress, const uint8_t* writeData, size_t writeLength,
+                         uint8_t* readBuffer, size_t readLength);
+
     // Device Management
     static bool scanDevices();
     static bool isDevicePresent(uint8_t deviceAddress);
+    static bool probeDevice(uint8_t deviceAddress);
     static void logConnectedDevices();
 
     // Bus Health
     static bool isBusHealthy();
     static uint32_t getTransactionCount();
     static uint32_t getErrorCount();
+    static uint32_t getTimeoutCount();
     static float getSuccessRate();
 
     // Task Management
@@ -61,6 +71,8 @@ private:
     // Bus statistics
     static uint32_t transactionCount;
     static uint32_t errorCount;
+    static uint32_t timeoutCount;
+    static uint32_t nextRequestId;
     static uint32_t lastScanTime;
     static uint8_t connectedDevices[128];  // Bit array for device presence
     static uint8_t connectedDeviceCount;
@@ -70,9 +82,37 @@ private:
     static uint32_t lastRecoveryTime;
     static uint8_t recoveryAttempts;
 
+    // Transaction slots - buffers live here rather than on the caller's
+    // stack, so a caller that times out can't be written to afterwards
+    enum class SlotState : uint8_t {
+        FREE,
+        QUEUED,
+        COMPLETE,
+        ABANDONED
+    };
+
+    struct TransactionSlot {
+        uint8_t buffer[I2C_MAX_TRANSFER_SIZE];  // Write data, then read data
+        size_t readLength;
+        bool success;
+        volatile SlotState state;
+        SemaphoreHandle_t completion;
+        StaticSemaphore_t completionStorage;
+    };
+
+    static TransactionSlot slots[I2C_TRANSACTION_SLOTS];
+    static portMUX_TYPE slotLock;
+
     // Task function
     static void i2cManagerTask(void* parameter);
 
+    // Transaction engine
+    static bool initializeSlots();
+    static int acquireSlot();
+    static void releaseSlot(int index);
+    static void processRequest(I2CRequest& request);
+    static bool isEngineTask();
+
     // Internal I2C operations (not thread-safe, use within task only)
     static bool performWrite(uint8_t deviceAddress, uint8_t* data, size_t length);
     static bool performRead(uint8_t deviceAddress, uint8_t* buffer, size_t length);
@@ -118,6 +158,7 @@ public:
     bool writeRegister16(uint8_t registerAddress, uint16_t value);
     bool readRegister(uint8_t registerAddress, uint8_t* value);
     bool readRegister16(uint8_t registerAddress, uint16_t* value);
+    bool readRegisters(uint8_t registerAddress, uint8_t* buffer, size_t length);  // Burst read
     bool readData(uint8_t* buffer, size_t length);
     bool writeData(uint8_t* data, size_t length);
 
@@ -175,6 +216,7 @@ struct PressureReading : public SensorReading {
     float pressure;         // kPa
     uint16_t rawValue;      // ADC reading
     uint8_t sensorIndex;    // Which pressure sensor (0-3)
+    bool contact;           // Fingertip touching (force above the contact threshold)
 };
 
 // Fused sensor data
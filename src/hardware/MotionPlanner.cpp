@@ -0,0 +1,349 @@
+#include "MotionPlanner.h"
+#include "ExerciseLibrary.h"
+#include <string.h>
+
+MotionPlanner::MotionPlanner()
+    : finishedJoints(0), active(false), waypointIndex(0), completedRepetitions(0),
+      waypointStartTime(0), table(nullptr), tableRepetitions(0), tableBaseQ8(0), tableSpan(0),
+      tableLeadIn(false), leadInMs(0), leadInStartTime(0), cycleStartTime(0), risingJoints(0) {
+    memset(&profile, 0, sizeof(profile));
+    memset(leadInOffsetQ8, 0, sizeof(leadInOffsetQ8));
+    memset(segments, 0, sizeof(segments));
+    memset(results, 0, sizeof(results));
+    memset(positions, 0, sizeof(positions));
+}
+
+void MotionPlanner::setPositions(const int* angles) {
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        positions[i] = (float)angles[i];
+        segments[i].moving = false;
+    }
+}
+
+// =============================================================================
+// PROFILE CONTROL
+// =============================================================================
+
+bool MotionPlanner::start(const ExerciseProfile& newProfile, unsigned long now) {
+    if (!validateProfile(newProfile)) return false;
+
+    // A replaced profile ends where the joints currently are
+    if (active) {
+        stop(now);
+    }
+
+    profile = newProfile;
+    table = nullptr;
+    waypointIndex = 0;
+    completedRepetitions = 0;
+    active = true;
+    beginWaypoint(now);
+
+    return true;
+}
+
+bool MotionPlanner::startTable(const ExerciseTable& newTable, uint8_t repetitions, int minAngle, int maxAngle,
+                               unsigned long now) {
+    if (newTable.rowCount == 0 || newTable.samplePeriodMs == 0 || repetitions == 0) return false;
+    if (minAngle < 0 || maxAngle > 180 || minAngle >= maxAngle) return false;
+
+    if (active) {
+        stop(now);
+    }
+
+    table = &newTable;
+    tableRepetitions = repetitions;
+    tableBaseQ8 = (int32_t)minAngle * 256;
+    tableSpan = maxAngle - minAngle;
+    completedRepetitions = 0;
+    active = true;
+
+    // Joints away from row 0 ease onto it before the first cycle
+    leadInMs = 0;
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        leadInOffsetQ8[i] = (int32_t)lroundf(positions[i] * 256.0f) - tableAngleQ8(i, 0);
+        if (leadInOffsetQ8[i] != 0) {
+            leadInMs = EXERCISE_LEAD_IN_MS;
+        }
+    }
+    leadInStartTime = now;
+    tableLeadIn = leadInMs > 0;
+    if (!tableLeadIn) {
+        beginTableCycle(now);
+    }
+
+    return true;
+}
+
+void MotionPlanner::stop(unsigned long now) {
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        if (segments[i].moving) {
+            finishSegment(i, now, false);
+        }
+    }
+    active = false;
+    tableLeadIn = false;
+}
+
+bool MotionPlanner::step(unsigned long now) {
+    if (!active) return false;
+    if (table) return stepTable(now);
+
+    // Catch up on every segment end and waypoint transition up to now
+    while (active) {
+        const MotionWaypoint& waypoint = profile.waypoints[waypointIndex];
+
+        for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+            JointSegment& segment = segments[i];
+            if (segment.moving && now - segment.startTime >= segment.durationMs) {
+                positions[i] = segment.targetAngle;
+                finishSegment(i, segment.startTime + segment.durationMs, true);
+            }
+        }
+
+        unsigned long waypointLength = (unsigned long)waypoint.moveMs + waypoint.holdMs;
+        if (now - waypointStartTime < waypointLength) break;
+
+        unsigned long nextStart = waypointStartTime + waypointLength;
+        if (++waypointIndex >= profile.waypointCount) {
+            waypointIndex = 0;
+            if (++completedRepetitions >= profile.repetitions) {
+                active = false;
+                break;
+            }
+        }
+        beginWaypoint(nextStart);
+    }
+
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        const JointSegment& segment = segments[i];
+        if (segment.moving) {
+            float t = (float)(now - segment.startTime) / (float)segment.durationMs;
+            positions[i] = segment.startAngle + (segment.targetAngle - segment.startAngle) * evaluate(t);
+        }
+    }
+
+    return active;
+}
+
+// =============================================================================
+// STATE QUERIES
+// =============================================================================
+
+bool MotionPlanner::isActive() const {
+    return active;
+}
+
+float MotionPlanner::getPosition(int joint) const {
+    if (joint < 0 || joint >= MOTION_MAX_JOINTS) return 0.0f;
+    return positions[joint];
+}
+
+int MotionPlanner::getTargetAngle(int joint) const {
+    if (joint < 0 || joint >= MOTION_MAX_JOINTS) return 0;
+    if (segments[joint].moving) {
+        return (int)lroundf(segments[joint].targetAngle);
+    }
+    return (int)lroundf(positions[joint]);
+}
+
+bool MotionPlanner::isJointMoving(int joint) const {
+    if (joint < 0 || joint >= MOTION_MAX_JOINTS) return false;
+    return segments[joint].moving;
+}
+
+uint8_t MotionPlanner::getCompletedRepetitions() const {
+    return completedRepetitions;
+}
+
+uint8_t MotionPlanner::getRepetitions() const {
+    return table ? tableRepetitions : profile.repetitions;
+}
+
+uint8_t MotionPlanner::takeFinishedJoints() {
+    uint8_t finished = finishedJoints;
+    finishedJoints = 0;
+    return finished;
+}
+
+const JointSegmentResult& MotionPlanner::getSegmentResult(int joint) const {
+    if (joint < 0 || joint >= MOTION_MAX_JOINTS) joint = 0;
+    return results[joint];
+}
+
+bool MotionPlanner::validateProfile(const ExerciseProfile& profile) {
+    if (profile.waypointCount == 0 || profile.waypointCount > MOTION_MAX_WAYPOINTS) return false;
+    if (profile.repetitions == 0) return false;
+
+    const uint8_t allJoints = (1 << MOTION_MAX_JOINTS) - 1;
+    for (int w = 0; w < profile.waypointCount; w++) {
+        const MotionWaypoint& waypoint = profile.waypoints[w];
+
+        if (waypoint.jointMask & ~allJoints) return false;
+        if (waypoint.jointMask != 0 && waypoint.moveMs == 0) return false;
+        if ((unsigned long)waypoint.moveMs + waypoint.holdMs == 0) return false;
+
+        for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+            if (waypoint.angles[i] > 180) return false;  // Standard servo range
+        }
+    }
+
+    return true;
+}
+
+// =============================================================================
+// TRAJECTORY GENERATION
+// =============================================================================
+
+void MotionPlanner::beginWaypoint(unsigned long startTime) {
+    const MotionWaypoint& waypoint = profile.waypoints[waypointIndex];
+    waypointStartTime = startTime;
+
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        if (waypoint.jointMask & (1 << i)) {
+            JointSegment& segment = segments[i];
+            segment.startAngle = positions[i];
+            segment.targetAngle = (float)waypoint.angles[i];
+            segment.startTime = startTime;
+            segment.durationMs = waypoint.moveMs;
+            segment.moving = true;
+        }
+    }
+}
+
+// =============================================================================
+// TABLE PLAYBACK
+// =============================================================================
+
+bool MotionPlanner::stepTable(unsigned long now) {
+    if (tableLeadIn) {
+        unsigned long elapsed = now - leadInStartTime;
+        if (elapsed < leadInMs) {
+            int32_t remaining = EXERCISE_FULL_FLEXION - ExerciseLibrary::ease(elapsed, leadInMs);
+            for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+                setPositionQ8(i, tableAngleQ8(i, 0) + leadInOffsetQ8[i] * remaining / EXERCISE_FULL_FLEXION);
+            }
+            return true;
+        }
+
+        tableLeadIn = false;
+        beginTableCycle(leadInStartTime + leadInMs);
+    }
+
+    const unsigned long cycleLength = (unsigned long)table->rowCount * table->samplePeriodMs;
+
+    // Catch up on every rise row, peak row and cycle end up to now
+    while (active) {
+        for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+            JointSegment& segment = segments[i];
+            unsigned long riseMs = (unsigned long)table->riseRow[i] * table->samplePeriodMs;
+            if ((risingJoints & (1 << i)) && now - cycleStartTime >= riseMs) {
+                beginTableSegment(i, riseMs);
+            }
+            if (segment.moving && now - segment.startTime >= segment.durationMs) {
+                setPositionQ8(i, tableAngleQ8(i, (unsigned long)table->peakRow[i] * table->samplePeriodMs));
+                finishSegment(i, segment.startTime + segment.durationMs, true);
+            }
+        }
+
+        if (now - cycleStartTime < cycleLength) break;
+
+        unsigned long nextStart = cycleStartTime + cycleLength;
+        if (++completedRepetitions >= tableRepetitions) {
+            // Row 0 is the rest position every table ends at
+            for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+                setPositionQ8(i, tableAngleQ8(i, 0));
+            }
+            active = false;
+            break;
+        }
+        beginTableCycle(nextStart);
+    }
+
+    if (active) {
+        for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+            setPositionQ8(i, tableAngleQ8(i, now - cycleStartTime));
+        }
+    }
+
+    return active;
+}
+
+void MotionPlanner::beginTableCycle(unsigned long startTime) {
+    cycleStartTime = startTime;
+    risingJoints = 0;
+
+    // A joint the table never flexes has nothing to report
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        if (table->rows[table->peakRow[i]][i] != table->rows[0][i]) {
+            risingJoints |= (1 << i);
+        }
+    }
+}
+
+void MotionPlanner::beginTableSegment(int joint, unsigned long riseMs) {
+    unsigned long peakMs = (unsigned long)table->peakRow[joint] * table->samplePeriodMs;
+
+    JointSegment& segment = segments[joint];
+    segment.startAngle = (float)tableAngleQ8(joint, riseMs) * (1.0f / 256.0f);
+    segment.targetAngle = (float)tableAngleQ8(joint, peakMs) * (1.0f / 256.0f);
+    segment.startTime = cycleStartTime + riseMs;
+    segment.durationMs = (uint16_t)(peakMs - riseMs);
+    segment.moving = true;
+    risingJoints &= ~(1 << joint);
+}
+
+int32_t MotionPlanner::tableAngleQ8(int joint, unsigned long cycleMs) const {
+    // Linear interpolation between the two rows around cycleMs, in Q15
+    uint32_t row = (cycleMs / table->samplePeriodMs) % table->rowCount;
+    int32_t fraction = (int32_t)(cycleMs % table->samplePeriodMs);
+    int32_t from = table->rows[row][joint];
+    int32_t to = table->rows[(row + 1) % table->rowCount][joint];
+    int32_t value = from + (to - from) * fraction / table->samplePeriodMs;
+
+    // Q15 fraction of the span -> 1/256 degree
+    return tableBaseQ8 + ((tableSpan * value) >> 7);
+}
+
+void MotionPlanner::setPositionQ8(int joint, int32_t angleQ8) {
+    // Degrees as float only at the output boundary (ServoOutput, safety checks)
+    positions[joint] = (float)angleQ8 * (1.0f / 256.0f);
+}
+
+void MotionPlanner::finishSegment(int joint, unsigned long endTime, bool reachedTarget) {
+    JointSegment& segment = segments[joint];
+    JointSegmentResult& result = results[joint];
+
+    result.startTime = segment.startTime;
+    result.duration = endTime - segment.startTime;
+    result.startAngle = (int)lroundf(segment.startAngle);
+    result.targetAngle = (int)lroundf(segment.targetAngle);
+    result.actualAngle = (int)lroundf(positions[joint]);
+    result.reachedTarget = reachedTarget;
+
+    segment.moving = false;
+    finishedJoints |= (1 << joint);
+}
+
+float MotionPlanner::evaluate(float t) const {
+    // Normalized position (0..1) along the segment at normalized time t
+    if (t <= 0.0f) return 0.0f;
+    if (t >= 1.0f) return 1.0f;
+
+    if (profile.shape == TrajectoryShape::TRAPEZOIDAL) {
+        const float ramp = TRAPEZOID_RAMP_FRACTION;
+        const float cruiseVelocity = 1.0f / (1.0f - ramp);
+
+        if (t < ramp) {
+            return cruiseVelocity * t * t / (2.0f * ramp);
+        }
+        if (t <= 1.0f - ramp) {
+            return cruiseVelocity * (t - ramp / 2.0f);
+        }
+        float remaining = 1.0f - t;
+        return 1.0f - cruiseVelocity * remaining * remaining / (2.0f * ramp);
+    }
+
+    // Minimum jerk: 10t^3 - 15t^4 + 6t^5
+    return t * t * t * (10.0f + t * (-15.0f + 6.0f * t));
+}
@@ -0,0 +1,149 @@
+#ifndef MOTION_PLANNER_H
+#define MOTION_PLANNER_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+
+// =============================================================================
+// EXERCISE PROFILES
+// =============================================================================
+
+const uint8_t MOTION_MAX_JOINTS = 3;      // One per servo
+const uint8_t MOTION_MAX_WAYPOINTS = 16;
+
+enum class TrajectoryShape : uint8_t {
+    MINIMUM_JERK,  // Smooth start and stop, zero acceleration at both ends
+    TRAPEZOIDAL    // Constant acceleration, cruise, constant deceleration
+};
+
+/**
+ * One step of an exercise: the joints in jointMask move to their angles over
+ * moveMs, then everything holds for holdMs. Joints outside the mask keep
+ * their current position.
+ */
+struct MotionWaypoint {
+    uint8_t angles[MOTION_MAX_JOINTS];
+    uint8_t jointMask;   // Bit n = joint n moves in this step
+    uint16_t moveMs;
+    uint16_t holdMs;
+};
+
+struct ExerciseProfile {
+    MotionWaypoint waypoints[MOTION_MAX_WAYPOINTS];
+    uint8_t waypointCount;
+    uint8_t repetitions;  // Times the waypoint list is run
+    TrajectoryShape shape;
+};
+
+struct ExerciseTable;  // ExerciseLibrary.h
+
+// Result of a finished (or interrupted) joint segment, for movement analytics
+struct JointSegmentResult {
+    unsigned long startTime;
+    unsigned long duration;
+    int startAngle;
+    int targetAngle;
+    int actualAngle;
+    bool reachedTarget;
+};
+
+// =============================================================================
+// MOTION PLANNER
+// =============================================================================
+
+/**
+ * Tick-driven trajectory generator for the exoskeleton joints.
+ *
+ * step() is called at a fixed control rate and returns the setpoint for every
+ * joint at that instant, so a new profile or a stop takes effect on the next
+ * tick. Waypoint times are accumulated from the profile start rather than
+ * from the tick that noticed the transition, so late ticks do not stretch
+ * the exercise. Not thread-safe - ServoController only touches it from the
+ * servo task.
+ *
+ * startTable() plays a precomputed exercise table instead of waypoints:
+ * each tick interpolates between two table rows and scales the Q15 value
+ * onto the angle range with integer arithmetic only. Every joint reports
+ * one segment per repetition, from its rise row to its peak row.
+ */
+class MotionPlanner {
+public:
+    MotionPlanner();
+
+    // Current joint positions (used as the start of the next profile)
+    void setPositions(const int* angles);
+
+    // Starts a profile from the current positions, replacing any active one
+    bool start(const ExerciseProfile& profile, unsigned long now);
+
+    // Starts a table exercise, eased in from the current positions
+    bool startTable(const ExerciseTable& table, uint8_t repetitions, int minAngle, int maxAngle,
+                    unsigned long now);
+
+    // Freezes every joint where it is. Moving joints report an interrupted
+    // segment through takeFinishedJoints().
+    void stop(unsigned long now);
+
+    // Advances to the given time. Returns true while the profile is running.
+    bool step(unsigned long now);
+
+    // Setpoints and state
+    bool isActive() const;
+    float getPosition(int joint) const;
+    int getTargetAngle(int joint) const;
+    bool isJointMoving(int joint) const;
+    uint8_t getCompletedRepetitions() const;
+    uint8_t getRepetitions() const;
+
+    // Joints whose segment ended since the last call (bit n = joint n)
+    uint8_t takeFinishedJoints();
+    const JointSegmentResult& getSegmentResult(int joint) const;
+
+    static bool validateProfile(const ExerciseProfile& profile);
+
+private:
+    struct JointSegment {
+        float startAngle;
+        float targetAngle;
+        unsigned long startTime;
+        uint16_t durationMs;
+        bool moving;
+    };
+
+    ExerciseProfile profile;
+    JointSegment segments[MOTION_MAX_JOINTS];
+    JointSegmentResult results[MOTION_MAX_JOINTS];
+    float positions[MOTION_MAX_JOINTS];
+    uint8_t finishedJoints;
+
+    bool active;
+    uint8_t waypointIndex;
+    uint8_t completedRepetitions;
+    unsigned long waypointStartTime;
+
+    // Table playback (table is nullptr while waypoints are played)
+    const ExerciseTable* table;
+    uint8_t tableRepetitions;
+    int32_t tableBaseQ8;             // minAngle in 1/256 degree
+    int32_t tableSpan;               // maxAngle - minAngle, degrees
+    bool tableLeadIn;
+    int32_t leadInOffsetQ8[MOTION_MAX_JOINTS];  // Start position minus row 0, eased away
+    unsigned long leadInMs;
+    unsigned long leadInStartTime;
+    unsigned long cycleStartTime;
+    uint8_t risingJoints;            // Joints whose segment of this cycle has not begun yet
+
+    void beginWaypoint(unsigned long startTime);
+    bool stepTable(unsigned long now);
+    void beginTableCycle(unsigned long startTime);
+    void beginTableSegment(int joint, unsigned long riseMs);
+    int32_t tableAngleQ8(int joint, unsigned long cycleMs) const;
+    void setPositionQ8(int joint, int32_t angleQ8);
+    void finishSegment(int joint, unsigned long endTime, bool reachedTarget);
+    float evaluate(float t) const;
+
+    // Fraction of a trapezoidal move spent accelerating (and decelerating)
+    static constexpr float TRAPEZOID_RAMP_FRACTION = 0.25f;
+};
+
+#endif
@@ -0,0 +1,473 @@
+#include "ResourceProfiler.h"
+#include <Preferences.h>
+#include <esp_system.h>
+#include "../utils/Logger.h"
+
+static_assert(PROFILED_QUEUE_COUNT <= 16, "Queue bitmasks are 16 bits");
+
+// =============================================================================
+// SIZING TABLES
+// =============================================================================
+
+struct TaskSizing {
+    const char* name;      // As passed to xTaskCreatePinnedToCore
+    const char* constant;
+    uint32_t configured;
+};
+
+struct QueueSizing {
+    const char* name;
+    const char* constant;
+    UBaseType_t configured;
+};
+
+// Indexed by ProfiledTask
+static const TaskSizing TASK_SIZING[PROFILED_TASK_COUNT] = {
+    {"WiFiManager", "TASK_STACK_WIFI_MANAGER", TASK_STACK_WIFI_MANAGER},
+    {"MQTTPublisher", "TASK_STACK_MQTT_PUBLISHER", TASK_STACK_MQTT_PUBLISHER},
+    {"MQTTSubscriber", "TASK_STACK_MQTT_SUBSCRIBER", TASK_STACK_MQTT_SUBSCRIBER},
+    {"BLEServer", "TASK_STACK_BLE_SERVER", TASK_STACK_BLE_SERVER},
+    {"BLEStream", "TASK_STACK_BLE_STREAM", TASK_STACK_BLE_STREAM},
+    {"LogDrain", "TASK_STACK_LOG_DRAIN", TASK_STACK_LOG_DRAIN},
+    {"ServoControl", "TASK_STACK_SERVO_CONTROL", TASK_STACK_SERVO_CONTROL},
+    {"I2CManager", "TASK_STACK_I2C_MANAGER", TASK_STACK_I2C_MANAGER},
+    {"PulseMonitor", "TASK_STACK_PULSE_MONITOR", TASK_STACK_PULSE_MONITOR},
+    {"MotionSensor", "TASK_STACK_MOTION_SENSOR", TASK_STACK_MOTION_SENSOR},
+    {"PressureSensor", "TASK_STACK_PRESSURE_SENSOR", TASK_STACK_PRESSURE_SENSOR},
+    {"DataFusion", "TASK_STACK_DATA_FUSION", TASK_STACK_DATA_FUSION},
+    {"SessionAnalytics", "TASK_STACK_SESSION_ANALYTICS", TASK_STACK_SESSION_ANALYTICS},
+    {"DeviceManager", "TASK_STACK_DEVICE_MANAGER", TASK_STACK_DEVICE_MANAGER},
+    {"BootWorker", "TASK_STACK_BOOT_WORKER", TASK_STACK_BOOT_WORKER}  // Boot0/Boot1, recorded on exit
+};
+
+// Indexed by ProfiledQueue
+static const QueueSizing QUEUE_SIZING[PROFILED_QUEUE_COUNT] = {
+    {"servo commands", "QUEUE_SIZE_SERVO_COMMANDS", QUEUE_SIZE_SERVO_COMMANDS},
+    {"I2C requests", "QUEUE_SIZE_I2C_REQUESTS", QUEUE_SIZE_I2C_REQUESTS},
+    {"MQTT publish", "QUEUE_SIZE_MQTT_PUBLISH", QUEUE_SIZE_MQTT_PUBLISH},
+    {"MQTT priority", "QUEUE_SIZE_MQTT_PRIORITY", QUEUE_SIZE_MQTT_PRIORITY},
+    {"session events", "QUEUE_SIZE_SESSION_EVENTS", QUEUE_SIZE_SESSION_EVENTS},
+    {"system alerts", "QUEUE_SIZE_SYSTEM_ALERTS", QUEUE_SIZE_SYSTEM_ALERTS},
+    {"movement analytics", "QUEUE_SIZE_MOVEMENT_ANALYTICS", QUEUE_SIZE_MOVEMENT_ANALYTICS},
+    {"clinical data", "QUEUE_SIZE_CLINICAL_DATA", QUEUE_SIZE_CLINICAL_DATA},
+    {"performance metrics", "QUEUE_SIZE_PERFORMANCE_METRICS", QUEUE_SIZE_PERFORMANCE_METRICS},
+    {"device commands", "QUEUE_SIZE_DEVICE_COMMANDS", QUEUE_SIZE_DEVICE_COMMANDS}
+};
+
+static const char* NVS_NAMESPACE = "resprofile";
+
+// Static member definitions
+ResourceProfiler::ProfileData ResourceProfiler::data;
+bool ResourceProfiler::profiling = RESOURCE_PROFILING_DEFAULT;
+bool ResourceProfiler::applyOnBoot = false;
+bool ResourceProfiler::applied = false;
+bool ResourceProfiler::loaded = false;
+bool ResourceProfiler::dirty = false;
+bool ResourceProfiler::revertedAfterCrash = false;
+uint32_t ResourceProfiler::stackSizes[PROFILED_TASK_COUNT];
+UBaseType_t ResourceProfiler::queueDepths[PROFILED_QUEUE_COUNT];
+QueueHandle_t ResourceProfiler::queues[PROFILED_QUEUE_COUNT];
+size_t ResourceProfiler::queueItemSizes[PROFILED_QUEUE_COUNT];
+portMUX_TYPE ResourceProfiler::dataLock = portMUX_INITIALIZER_UNLOCKED;
+unsigned long ResourceProfiler::lastUpdateTime = 0;
+unsigned long ResourceProfiler::lastSaveTime = 0;
+uint32_t ResourceProfiler::pendingMs = 0;
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+static bool isCrashReset(esp_reset_reason_t reason) {
+    return reason == ESP_RST_PANIC || reason == ESP_RST_INT_WDT ||
+           reason == ESP_RST_TASK_WDT || reason == ESP_RST_WDT;
+}
+
+void ResourceProfiler::initialize() {
+    for (uint8_t i = 0; i < PROFILED_TASK_COUNT; i++) {
+        stackSizes[i] = TASK_SIZING[i].configured;
+    }
+    for (uint8_t i = 0; i < PROFILED_QUEUE_COUNT; i++) {
+        queueDepths[i] = QUEUE_SIZING[i].configured;
+    }
+    clearData();
+
+    // Read-only open fails until the namespace has been written once
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) return;
+
+    profiling = prefs.getBool("profiling", RESOURCE_PROFILING_DEFAULT);
+    applyOnBoot = prefs.getBool("apply", false);
+
+    ProfileData stored;
+    if (prefs.getBytes("data", &stored, sizeof(stored)) == sizeof(stored) &&
+        stored.version == DATA_VERSION && stored.taskCount == PROFILED_TASK_COUNT &&
+        stored.queueCount == PROFILED_QUEUE_COUNT) {
+        data = stored;
+        loaded = true;
+    }
+    prefs.end();
+
+    if (!applyOnBoot || !hasEnoughData()) return;
+
+    // A crash may be a stack the recommendation made too small - back to Config.h
+    if (isCrashReset(esp_reset_reason())) {
+        applyOnBoot = false;
+        revertedAfterCrash = true;
+        if (prefs.begin(NVS_NAMESPACE, false)) {
+            prefs.putBool("apply", false);
+            prefs.end();
+        }
+        return;
+    }
+
+    for (uint8_t i = 0; i < PROFILED_TASK_COUNT; i++) {
+        stackSizes[i] = recommendStack(i);
+    }
+    for (uint8_t i = 0; i < PROFILED_QUEUE_COUNT; i++) {
+        queueDepths[i] = recommendQueue(i);
+    }
+    applied = true;
+}
+
+void ResourceProfiler::logStatus() {
+    if (revertedAfterCrash) {
+        Logger::warningf("Resource profile: reset reason %d - back to Config.h sizes, apply switched off",
+                         (int)esp_reset_reason());
+    } else if (applied) {
+        Logger::infof("Resource profile applied - tasks and queues sized from %u sessions (%lu s)",
+                      data.sessions, data.seconds);
+    } else if (applyOnBoot) {
+        Logger::infof("Resource profile apply pending - %u/%u sessions, %lu/%lu s profiled",
+                      data.sessions, RESOURCE_PROFILE_MIN_SESSIONS, data.seconds, RESOURCE_PROFILE_MIN_SECONDS);
+    }
+
+    if (profiling) {
+        Logger::infof("Resource profiling on - %u sessions, %lu s recorded%s",
+                      data.sessions, data.seconds, loaded ? "" : " (new record)");
+    }
+}
+
+void ResourceProfiler::clearData() {
+    portENTER_CRITICAL(&dataLock);
+    memset(&data, 0, sizeof(data));
+    data.version = DATA_VERSION;
+    data.taskCount = PROFILED_TASK_COUNT;
+    data.queueCount = PROFILED_QUEUE_COUNT;
+    dirty = false;
+    portEXIT_CRITICAL(&dataLock);
+}
+
+bool ResourceProfiler::save() {
+    ProfileData snapshot;
+    portENTER_CRITICAL(&dataLock);
+    snapshot = data;
+    dirty = false;
+    portEXIT_CRITICAL(&dataLock);
+
+    lastSaveTime = millis();
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        Logger::warning("Resource profile: NVS unavailable - not saved");
+        return false;
+    }
+    bool saved = prefs.putBytes("data", &snapshot, sizeof(snapshot)) == sizeof(snapshot);
+    prefs.end();
+
+    LOG_DEBUGF("Resource profile saved (%u sessions, %lu s)", snapshot.sessions, snapshot.seconds);
+    return saved;
+}
+
+static bool saveFlag(const char* key, bool value) {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        Logger::warning("Resource profile: NVS unavailable - setting not saved");
+        return false;
+    }
+    if (prefs.getBool(key, !value) != value) {
+        prefs.putBool(key, value);
+    }
+    prefs.end();
+    return true;
+}
+
+bool ResourceProfiler::hasEnoughData() {
+    return data.sessions >= RESOURCE_PROFILE_MIN_SESSIONS && data.seconds >= RESOURCE_PROFILE_MIN_SECONDS;
+}
+
+// =============================================================================
+// SIZES
+// =============================================================================
+
+uint32_t ResourceProfiler::getStackSize(ProfiledTask task) {
+    uint8_t index = (uint8_t)task;
+    return index < PROFILED_TASK_COUNT ? stackSizes[index] : 0;
+}
+
+UBaseType_t ResourceProfiler::getQueueDepth(ProfiledQueue queue) {
+    uint8_t index = (uint8_t)queue;
+    return index < PROFILED_QUEUE_COUNT ? queueDepths[index] : 0;
+}
+
+uint32_t ResourceProfiler::recommendStack(uint8_t index) {
+    uint32_t used = data.stackUsed[index];
+    if (used == 0) return TASK_SIZING[index].configured;
+
+    uint32_t size = used + used * RESOURCE_PROFILE_STACK_MARGIN_PERCENT / 100 + RESOURCE_PROFILE_STACK_RESERVE;
+    size = (size + RESOURCE_PROFILE_STACK_GRANULARITY - 1) / RESOURCE_PROFILE_STACK_GRANULARITY *
+           RESOURCE_PROFILE_STACK_GRANULARITY;
+    if (size < RESOURCE_PROFILE_MIN_STACK) size = RESOURCE_PROFILE_MIN_STACK;
+    if (size > RESOURCE_PROFILE_MAX_STACK) size = RESOURCE_PROFILE_MAX_STACK;
+    return size;
+}
+
+UBaseType_t ResourceProfiler::recommendQueue(uint8_t index) {
+    UBaseType_t configured = QUEUE_SIZING[index].configured;
+    if (!(data.sampledQueues & (1u << index))) return configured;
+
+    uint32_t peak = data.queuePeak[index];
+    uint32_t withMargin = (peak * (100 + RESOURCE_PROFILE_QUEUE_MARGIN_PERCENT) + 99) / 100;
+    uint32_t depth = peak + RESOURCE_PROFILE_QUEUE_RESERVE;
+    if (withMargin > depth) depth = withMargin;
+    if (depth < RESOURCE_PROFILE_MIN_QUEUE_DEPTH) depth = RESOURCE_PROFILE_MIN_QUEUE_DEPTH;
+
+    // Growing a queue costs RAM for every slot; a full one is reported instead
+    return depth < configured ? (UBaseType_t)depth : configured;
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+void ResourceProfiler::registerQueue(ProfiledQueue queue, QueueHandle_t handle, size_t itemSize) {
+    uint8_t index = (uint8_t)queue;
+    if (index >= PROFILED_QUEUE_COUNT) return;
+
+    portENTER_CRITICAL(&dataLock);
+    queues[index] = handle;
+    queueItemSizes[index] = itemSize;
+    portEXIT_CRITICAL(&dataLock);
+}
+
+void ResourceProfiler::unregisterQueues() {
+    portENTER_CRITICAL(&dataLock);
+    memset(queues, 0, sizeof(queues));
+    portEXIT_CRITICAL(&dataLock);
+}
+
+void ResourceProfiler::recordTaskHeadroom(const char* taskName, uint32_t headroomBytes) {
+    if (!profiling || !taskName) return;
+
+    // Names as FreeRTOS keeps them, i.e. cut at configMAX_TASK_NAME_LEN
+    for (uint8_t i = 0; i < PROFILED_TASK_COUNT; i++) {
+        if (strncmp(taskName, TASK_SIZING[i].name, configMAX_TASK_NAME_LEN - 1) == 0) {
+            recordTaskHeadroom((ProfiledTask)i, headroomBytes);
+            return;
+        }
+    }
+}
+
+void ResourceProfiler::recordTaskHeadroom(ProfiledTask task, uint32_t headroomBytes) {
+    uint8_t index = (uint8_t)task;
+    if (!profiling || index >= PROFILED_TASK_COUNT || headroomBytes >= stackSizes[index]) return;
+
+    uint32_t used = stackSizes[index] - headroomBytes;
+    portENTER_CRITICAL(&dataLock);
+    if (used > data.stackUsed[index]) {
+        data.stackUsed[index] = used;
+        dirty = true;
+    }
+    portEXIT_CRITICAL(&dataLock);
+}
+
+void ResourceProfiler::recordQueueSend(ProfiledQueue queue, bool sent) {
+    uint8_t index = (uint8_t)queue;
+    if (!profiling || index >= PROFILED_QUEUE_COUNT || !queues[index]) return;
+
+    // Occupancy only grows on a send, so the count right after one catches
+    // every peak; the FreeRTOS call stays outside the lock
+    UBaseType_t waiting = sent ? uxQueueMessagesWaiting(queues[index]) : queueDepths[index];
+
+    uint16_t bit = (uint16_t)(1u << index);
+    portENTER_CRITICAL(&dataLock);
+    if (!(data.sampledQueues & bit)) {
+        data.sampledQueues |= bit;
+        dirty = true;
+    }
+    if (waiting > data.queuePeak[index]) {
+        data.queuePeak[index] = (uint16_t)waiting;
+        dirty = true;
+    }
+    if (waiting >= queueDepths[index] && !(data.saturatedQueues & bit)) {
+        data.saturatedQueues |= bit;
+        dirty = true;
+    }
+    portEXIT_CRITICAL(&dataLock);
+}
+
+void ResourceProfiler::recordSessionEnd() {
+    if (!profiling) return;
+
+    portENTER_CRITICAL(&dataLock);
+    if (data.sessions < UINT16_MAX) data.sessions++;
+    dirty = true;
+    portEXIT_CRITICAL(&dataLock);
+
+    save();  // A session end is the natural checkpoint
+}
+
+void ResourceProfiler::update(unsigned long now) {
+    if (!profiling) {
+        lastUpdateTime = now;
+        return;
+    }
+
+    if (lastUpdateTime != 0) {
+        pendingMs += now - lastUpdateTime;
+        portENTER_CRITICAL(&dataLock);
+        data.seconds += pendingMs / 1000;
+        portEXIT_CRITICAL(&dataLock);
+        pendingMs %= 1000;
+    }
+    lastUpdateTime = now;
+
+    // Profiled time alone is not worth a flash write; it rides along with new peaks
+    if (dirty && now - lastSaveTime >= RESOURCE_PROFILE_SAVE_INTERVAL) {
+        save();
+    }
+}
+
+// =============================================================================
+// CONTROL
+// =============================================================================
+
+bool ResourceProfiler::setProfiling(bool enabled) {
+    if (!saveFlag("profiling", enabled)) return false;
+
+    profiling = enabled;
+    if (enabled) {
+        lastUpdateTime = millis();
+        Logger::infof("Resource profiling on - %u sessions, %lu s recorded so far", data.sessions, data.seconds);
+    } else {
+        if (dirty) save();
+        Logger::info("Resource profiling off - the record is kept");
+    }
+    return true;
+}
+
+bool ResourceProfiler::setApplyOnBoot(bool apply) {
+    if (!saveFlag("apply", apply)) return false;
+
+    applyOnBoot = apply;
+    if (!apply) {
+        Logger::infof("Resource profile apply off - Config.h sizes from the next boot%s",
+                      applied ? " (this boot still runs at recommended sizes)" : "");
+    } else if (hasEnoughData()) {
+        Logger::info("Resource profile apply on - recommended sizes from the next boot");
+    } else {
+        Logger::infof("Resource profile apply on - waits for %u sessions and %lu s of profiling (have %u, %lu s)",
+                      RESOURCE_PROFILE_MIN_SESSIONS, RESOURCE_PROFILE_MIN_SECONDS, data.sessions, data.seconds);
+    }
+    return true;
+}
+
+bool ResourceProfiler::reset() {
+    clearData();
+    pendingMs = 0;
+    if (!save()) return false;
+
+    Logger::info("Resource profile cleared");
+    return applyOnBoot ? setApplyOnBoot(false) : true;
+}
+
+bool ResourceProfiler::isProfiling() {
+    return profiling;
+}
+
+bool ResourceProfiler::isApplied() {
+    return applied;
+}
+
+// =============================================================================
+// RECOMMENDATION
+// =============================================================================
+
+bool ResourceProfiler::getStackRecommendation(ProfiledTask task, ResourceRecommendation& recommendation) {
+    uint8_t index = (uint8_t)task;
+    if (index >= PROFILED_TASK_COUNT) return false;
+
+    portENTER_CRITICAL(&dataLock);
+    uint32_t used = data.stackUsed[index];
+    uint32_t recommended = recommendStack(index);
+    portEXIT_CRITICAL(&dataLock);
+
+    recommendation.name = TASK_SIZING[index].name;
+    recommendation.constant = TASK_SIZING[index].constant;
+    recommendation.configured = TASK_SIZING[index].configured;
+    recommendation.observed = used;
+    recommendation.recommended = recommended;
+    recommendation.measured = used > 0;
+    recommendation.saturated = false;
+    return true;
+}
+
+bool ResourceProfiler::getQueueRecommendation(ProfiledQueue queue, ResourceRecommendation& recommendation) {
+    uint8_t index = (uint8_t)queue;
+    if (index >= PROFILED_QUEUE_COUNT) return false;
+
+    uint16_t bit = (uint16_t)(1u << index);
+    portENTER_CRITICAL(&dataLock);
+    uint32_t peak = data.queuePeak[index];
+    bool sampled = (data.sampledQueues & bit) != 0;
+    bool saturated = (data.saturatedQueues & bit) != 0;
+    UBaseType_t recommended = recommendQueue(index);
+    portEXIT_CRITICAL(&dataLock);
+
+    recommendation.name = QUEUE_SIZING[index].name;
+    recommendation.constant = QUEUE_SIZING[index].constant;
+    recommendation.configured = QUEUE_SIZING[index].configured;
+    recommendation.observed = peak;
+    recommendation.recommended = recommended;
+    recommendation.measured = sampled;
+    recommendation.saturated = saturated;
+    return true;
+}
+
+void ResourceProfiler::logRecommendation() {
+    Logger::infof("Resource profile: %u sessions, %lu s profiled%s", data.sessions, data.seconds,
+                  hasEnoughData() ? "" : " - not enough to apply yet");
+
+    ResourceRecommendation recommendation;
+    int32_t stackSaving = 0;
+    uint8_t unseen = 0;
+    for (uint8_t i = 0; i < PROFILED_TASK_COUNT; i++) {
+        getStackRecommendation((ProfiledTask)i, recommendation);
+        if (!recommendation.measured) {
+            unseen++;
+            continue;
+        }
+        Logger::infof("const uint32_t %s = %lu;  // deepest use %lu of %lu",
+                      recommendation.constant, recommendation.recommended,
+                      recommendation.observed, recommendation.configured);
+        stackSaving += (int32_t)recommendation.configured - (int32_t)recommendation.recommended;
+    }
+    Logger::flush();  // A full report outruns the log ring
+
+    int32_t queueSaving = 0;
+    for (uint8_t i = 0; i < PROFILED_QUEUE_COUNT; i++) {
+        getQueueRecommendation((ProfiledQueue)i, recommendation);
+        if (!recommendation.measured) {
+            unseen++;
+            continue;
+        }
+        Logger::infof("const UBaseType_t %s = %lu;  // peak %lu of %lu%s",
+                      recommendation.constant, recommendation.recommended,
+                      recommendation.observed, recommendation.configured,
+                      recommendation.saturated ? " - seen full, consider raising it" : "");
+        queueSaving += ((int32_t)recommendation.configured - (int32_t)recommendation.recommended) *
+                       (int32_t)queueItemSizes[i];
+    }
+
+    Logger::infof("Resource profile: %ld stack and %ld queue bytes freed, %u resources not seen (keep Config.h)",
+                  (long)stackSaving, (long)queueSaving, unseen);
+}
@@ -0,0 +1,158 @@
+#ifndef RESOURCE_PROFILER_H
+#define RESOURCE_PROFILER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "../config/Config.h"
+
+// =============================================================================
+// PROFILED RESOURCES
+// =============================================================================
+
+// Every task created with a TASK_STACK_* size
+enum class ProfiledTask : uint8_t {
+    WIFI_MANAGER,
+    MQTT_PUBLISHER,
+    MQTT_SUBSCRIBER,
+    BLE_SERVER,
+    BLE_STREAM,
+    LOG_DRAIN,
+    SERVO_CONTROL,
+    I2C_MANAGER,
+    PULSE_MONITOR,
+    MOTION_SENSOR,
+    PRESSURE_SENSOR,
+    DATA_FUSION,
+    SESSION_ANALYTICS,
+    DEVICE_MANAGER,
+    BOOT_WORKER
+};
+
+// Every FreeRTOSManager queue, sized by a QUEUE_SIZE_* constant
+enum class ProfiledQueue : uint8_t {
+    SERVO_COMMANDS,
+    I2C_REQUESTS,
+    MQTT_PUBLISH,
+    MQTT_PRIORITY,
+    SESSION_EVENTS,
+    SYSTEM_ALERTS,
+    MOVEMENT_ANALYTICS,
+    CLINICAL_DATA,
+    PERFORMANCE_METRICS,
+    DEVICE_COMMANDS
+};
+
+const uint8_t PROFILED_TASK_COUNT = 15;
+const uint8_t PROFILED_QUEUE_COUNT = 10;
+
+// One stack or queue as profiled so far
+struct ResourceRecommendation {
+    const char* name;        // Task name or queue
+    const char* constant;    // The Config.h constant it replaces
+    uint32_t configured;     // Config.h value - bytes or queue slots
+    uint32_t observed;       // Deepest stack use (bytes) or peak occupancy (slots)
+    uint32_t recommended;    // configured when nothing was observed
+    bool measured;
+    bool saturated;          // Queue was seen full - demand may be higher than observed
+};
+
+// =============================================================================
+// RESOURCE PROFILER
+// =============================================================================
+
+/**
+ * Task stack and queue right-sizing from what real sessions use.
+ *
+ * While profiling is on, every task's stack high-water mark (from
+ * SystemMonitor's task scan) and every queue's peak occupancy (read by the
+ * sender right after each send, so bursts are not missed) are folded into
+ * a record kept in NVS, so the peaks accumulate across boots and sessions.
+ * Queues nothing sends to are never measured and keep their Config.h depth.
+ * From that record each resource gets a recommended size: the deepest
+ * stack use plus RESOURCE_PROFILE_STACK_MARGIN_PERCENT and a fixed reserve,
+ * the peak queue occupancy plus RESOURCE_PROFILE_QUEUE_MARGIN_PERCENT.
+ * Queues are never grown past their Config.h depth automatically; a queue
+ * seen full is reported instead.
+ *
+ * logRecommendation() prints the result as Config.h lines. With apply on,
+ * the next boot creates its tasks and queues at the recommended sizes
+ * through getStackSize()/getQueueDepth() - but only once the record covers
+ * RESOURCE_PROFILE_MIN_SESSIONS sessions and RESOURCE_PROFILE_MIN_SECONDS
+ * of profiling, and apply is switched off again by any panic or watchdog
+ * reset so a bad recommendation costs one reboot.
+ */
+class ResourceProfiler {
+public:
+    // Lifecycle - initialize() runs before the logger's task exists and
+    // only loads NVS; logStatus() reports what it found
+    static void initialize();
+    static void logStatus();
+
+    // Sizes to create with - the applied recommendation, otherwise Config.h
+    static uint32_t getStackSize(ProfiledTask task);
+    static UBaseType_t getQueueDepth(ProfiledQueue queue);
+
+    // Recording
+    static void registerQueue(ProfiledQueue queue, QueueHandle_t handle, size_t itemSize);
+    static void unregisterQueues();  // Before the queues are deleted
+    static void recordTaskHeadroom(const char* taskName, uint32_t headroomBytes);
+    static void recordTaskHeadroom(ProfiledTask task, uint32_t headroomBytes);
+    static void recordQueueSend(ProfiledQueue queue, bool sent);  // After every xQueueSend, false if it failed
+    static void recordSessionEnd();
+    static void update(unsigned long now);  // Housekeeping - counts profiled time, saves new peaks
+
+    // Control (the 'profile' command)
+    static bool setProfiling(bool enabled);
+    static bool setApplyOnBoot(bool apply);
+    static bool reset();
+    static bool isProfiling();
+    static bool isApplied();  // This boot runs at recommended sizes
+
+    // Recommendation
+    static bool getStackRecommendation(ProfiledTask task, ResourceRecommendation& recommendation);
+    static bool getQueueRecommendation(ProfiledQueue queue, ResourceRecommendation& recommendation);
+    static void logRecommendation();
+
+private:
+    // The NVS record - a layout change discards it
+    struct ProfileData {
+        uint8_t version;
+        uint8_t taskCount;
+        uint8_t queueCount;
+        uint8_t reserved;
+        uint16_t sessions;
+        uint16_t saturatedQueues;                 // Bit per ProfiledQueue
+        uint16_t sampledQueues;                   // Bit per ProfiledQueue sent to
+        uint16_t padding;
+        uint32_t seconds;                         // Time spent profiling
+        uint32_t stackUsed[PROFILED_TASK_COUNT];  // Deepest use in bytes, 0 = never seen
+        uint16_t queuePeak[PROFILED_QUEUE_COUNT];
+    };
+
+    static ProfileData data;
+    static bool profiling;
+    static bool applyOnBoot;
+    static bool applied;
+    static bool loaded;
+    static bool dirty;
+    static bool revertedAfterCrash;
+    static uint32_t stackSizes[PROFILED_TASK_COUNT];   // What this boot creates tasks with
+    static UBaseType_t queueDepths[PROFILED_QUEUE_COUNT];
+    static QueueHandle_t queues[PROFILED_QUEUE_COUNT];
+    static size_t queueItemSizes[PROFILED_QUEUE_COUNT];
+    static portMUX_TYPE dataLock;
+    static unsigned long lastUpdateTime;
+    static unsigned long lastSaveTime;
+    static uint32_t pendingMs;
+
+    static void clearData();
+    static bool save();
+    static bool hasEnoughData();
+    static uint32_t recommendStack(uint8_t index);
+    static UBaseType_t recommendQueue(uint8_t index);
+
+    static const uint8_t DATA_VERSION = 2;  // 1 held polled queue peaks, which miss bursts
+};
+
+#endif
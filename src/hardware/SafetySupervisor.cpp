@@ -0,0 +1,130 @@
+#include "SafetySupervisor.h"
+#include <math.h>
+
+SafetySupervisor::SafetySupervisor()
+    : heartRate(0), heartRateTime(0), reportedMask(0),
+      maxForce((int32_t)lroundf(SAFETY_MAX_FINGERTIP_FORCE * FORCE_SCALE)),
+      minHeartRate((int32_t)lroundf(SAFETY_HEART_RATE_MIN * HEART_RATE_SCALE)),
+      maxHeartRate((int32_t)lroundf(SAFETY_HEART_RATE_MAX * HEART_RATE_SCALE)),
+      minAngle((SERVO_MIN_ANGLE - SAFETY_ANGLE_MARGIN) * ANGLE_SCALE),
+      maxAngle((SERVO_MAX_ANGLE + SAFETY_ANGLE_MARGIN) * ANGLE_SCALE),
+      maxTrackingError(SAFETY_MAX_TRACKING_ERROR * ANGLE_SCALE),
+      lastFault((uint8_t)SafetyFault::NONE), lastFaultChannel(-1), lastFaultValue(0), tripCount(0) {
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        forces[i].store(0);
+        forceTimes[i].store(0);
+    }
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        jointAngles[i].store(0);
+        jointAngleTimes[i].store(0);
+    }
+}
+
+// =============================================================================
+// PRODUCERS
+// =============================================================================
+
+void SafetySupervisor::reportForce(int sensorIndex, float newtons, uint32_t timestamp) {
+    if (sensorIndex < 0 || sensorIndex >= PRESSURE_SENSOR_COUNT) return;
+
+    forces[sensorIndex].store((int32_t)lroundf(newtons * FORCE_SCALE));
+    forceTimes[sensorIndex].store(timestamp);
+    reportedMask.fetch_or(REPORTED_FORCE_FIRST << sensorIndex);
+}
+
+void SafetySupervisor::reportHeartRate(float bpm, uint32_t timestamp) {
+    heartRate.store((int32_t)lroundf(bpm * HEART_RATE_SCALE));
+    heartRateTime.store(timestamp);
+    reportedMask.fetch_or(REPORTED_HEART_RATE);
+}
+
+void SafetySupervisor::reportJointAngle(int joint, float degrees, uint32_t timestamp) {
+    if (joint < 0 || joint >= MOTION_MAX_JOINTS) return;
+
+    jointAngles[joint].store((int32_t)lroundf(degrees * ANGLE_SCALE));
+    jointAngleTimes[joint].store(timestamp);
+    reportedMask.fetch_or(REPORTED_JOINT_FIRST << joint);
+}
+
+// =============================================================================
+// ENVELOPE CHECK
+// =============================================================================
+
+SafetyFault SafetySupervisor::check(const float* setpoints, uint32_t now) {
+    uint8_t reported = reportedMask.load();
+
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        if (!(reported & (REPORTED_FORCE_FIRST << i))) continue;
+        if (!isFresh(forceTimes[i].load(), now, SAFETY_MAX_AGE_FORCE)) continue;
+
+        int32_t force = forces[i].load();
+        if (force > maxForce) return trip(SafetyFault::FINGERTIP_FORCE, i, force);
+    }
+
+    if ((reported & REPORTED_HEART_RATE) && isFresh(heartRateTime.load(), now, SAFETY_MAX_AGE_HEART_RATE)) {
+        int32_t rate = heartRate.load();
+        if (rate < minHeartRate || rate > maxHeartRate) return trip(SafetyFault::HEART_RATE, 0, rate);
+    }
+
+    for (int i = 0; i < MOTION_MAX_JOINTS; i++) {
+        // The commanded trajectory itself must stay inside the joint range
+        int32_t setpoint = (int32_t)(setpoints[i] * ANGLE_SCALE);
+        if (setpoint < minAngle || setpoint > maxAngle) return trip(SafetyFault::JOINT_ANGLE, i, setpoint);
+
+        if (!(reported & (REPORTED_JOINT_FIRST << i))) continue;
+        if (!isFresh(jointAngleTimes[i].load(), now, SAFETY_MAX_AGE_JOINT_ANGLE)) continue;
+
+        int32_t measured = jointAngles[i].load();
+        if (measured < minAngle || measured > maxAngle) return trip(SafetyFault::JOINT_ANGLE, i, measured);
+
+        int32_t error = measured - setpoint;
+        if (error < 0) error = -error;
+        if (error > maxTrackingError) return trip(SafetyFault::TRACKING_ERROR, i, error);
+    }
+
+    return SafetyFault::NONE;
+}
+
+SafetyFault SafetySupervisor::trip(SafetyFault fault, int channel, int32_t value) {
+    lastFault.store((uint8_t)fault);
+    lastFaultChannel.store((int8_t)channel);
+    lastFaultValue.store(value);
+    tripCount.fetch_add(1);
+    return fault;
+}
+
+bool SafetySupervisor::isFresh(uint32_t timestamp, uint32_t now, uint32_t maxAge) {
+    // A timestamp slightly ahead of now (reported after now was read) is fresh
+    return (int32_t)(now - timestamp) <= (int32_t)maxAge;
+}
+
+// =============================================================================
+// TRIP RECORD
+// =============================================================================
+
+SafetyFault SafetySupervisor::getLastFault() {
+    return (SafetyFault)lastFault.load();
+}
+
+int SafetySupervisor::getLastFaultChannel() {
+    return lastFaultChannel.load();
+}
+
+int32_t SafetySupervisor::getLastFaultValue() {
+    return lastFaultValue.load();
+}
+
+uint32_t SafetySupervisor::getTripCount() {
+    return tripCount.load();
+}
+
+const char* SafetySupervisor::getFaultName(SafetyFault fault) {
+    switch (fault) {
+        case SafetyFault::NONE: return "none";
+        case SafetyFault::FINGERTIP_FORCE: return "fingertip_force";
+        case SafetyFault::HEART_RATE: return "heart_rate";
+        case SafetyFault::JOINT_ANGLE: return "joint_angle";
+        case SafetyFault::TRACKING_ERROR: return "tracking_error";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef SAFETY_SUPERVISOR_H
+#define SAFETY_SUPERVISOR_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../config/Config.h"
+#include "MotionPlanner.h"
+
+enum class SafetyFault : uint8_t {
+    NONE = 0,
+    FINGERTIP_FORCE,   // A pressure sensor above SAFETY_MAX_FINGERTIP_FORCE
+    HEART_RATE,        // Heart rate outside SAFETY_HEART_RATE_MIN..MAX
+    JOINT_ANGLE,       // Setpoint or measured angle outside the joint range
+    TRACKING_ERROR     // Measured angle too far from the setpoint (jam or slip)
+};
+
+// =============================================================================
+// SAFETY SUPERVISOR
+// =============================================================================
+
+/**
+ * Patient safety envelope, evaluated by the servo task on every control tick.
+ *
+ * Sensor tasks report their newest values through lock-free atomics,
+ * converted once to fixed point (mN, deci-BPM, centi-degrees); check()
+ * then only compares integers against limits precomputed at construction,
+ * so its cost is constant and independent of any other task. Values older
+ * than their sensor's maximum age are not trusted and not checked - an
+ * absent sensor cannot trip the interlock.
+ */
+class SafetySupervisor {
+public:
+    SafetySupervisor();
+
+    // Producers - any task
+    void reportForce(int sensorIndex, float newtons, uint32_t timestamp);
+    void reportHeartRate(float bpm, uint32_t timestamp);
+    void reportJointAngle(int joint, float degrees, uint32_t timestamp);
+
+    // Servo task: first violated envelope at this tick, NONE if all hold
+    SafetyFault check(const float* setpoints, uint32_t now);
+
+    // Last trip
+    SafetyFault getLastFault();
+    int getLastFaultChannel();   // Sensor or joint index of the last trip
+    int32_t getLastFaultValue(); // Fixed-point value that tripped (units of the fault)
+    uint32_t getTripCount();
+    static const char* getFaultName(SafetyFault fault);
+
+    // Fixed-point scales
+    static const int32_t FORCE_SCALE = 1000;      // mN
+    static const int32_t HEART_RATE_SCALE = 10;   // deci-BPM
+    static const int32_t ANGLE_SCALE = 100;       // centi-degrees
+
+private:
+    // Latest inputs
+    std::atomic<int32_t> forces[PRESSURE_SENSOR_COUNT];
+    std::atomic<uint32_t> forceTimes[PRESSURE_SENSOR_COUNT];
+    std::atomic<int32_t> heartRate;
+    std::atomic<uint32_t> heartRateTime;
+    std::atomic<int32_t> jointAngles[MOTION_MAX_JOINTS];
+    std::atomic<uint32_t> jointAngleTimes[MOTION_MAX_JOINTS];
+    std::atomic<uint8_t> reportedMask;  // Bit 0 heart rate, 1-4 pressure, 5+ joints
+
+    // Limits (fixed point, computed once)
+    const int32_t maxForce;
+    const int32_t minHeartRate;
+    const int32_t maxHeartRate;
+    const int32_t minAngle;
+    const int32_t maxAngle;
+    const int32_t maxTrackingError;
+
+    // Trip record (servo task writes, anyone reads)
+    std::atomic<uint8_t> lastFault;
+    std::atomic<int8_t> lastFaultChannel;
+    std::atomic<int32_t> lastFaultValue;
+    std::atomic<uint32_t> tripCount;
+
+    SafetyFault trip(SafetyFault fault, int channel, int32_t value);
+    static bool isFresh(uint32_t timestamp, uint32_t now, uint32_t maxAge);
+
+    static const uint8_t REPORTED_HEART_RATE = 1 << 0;
+    static const uint8_t REPORTED_FORCE_FIRST = 1 << 1;
+    static const uint8_t REPORTED_JOINT_FIRST = REPORTED_FORCE_FIRST << PRESSURE_SENSOR_COUNT;
+};
+
+#endif
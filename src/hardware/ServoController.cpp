@@ -3,6 +3,9 @@
 #include "../utils/Logger.h"
 #include "../utils/ErrorHandler.h"
 #include "FreeRTOSManager.h"
+#include "ResourceProfiler.h"
+#include "TaskTracer.h"
+#include <string.h>
 
 void ServoController::initialize() {
     if (initialized) return;
@@ -22,7 +25,14 @@ void ServoController::initialize() {
     movementCount = 0;
     movementCompleteCallback = nullptr;
     stateChangeCallback = nullptr;
-    hasNewMetrics = false;
+    analyticsCallback = nullptr;
+    commandStartedCallback = nullptr;
+    angleFeedbackProvider = nullptr;
+    outputCut = false;
+    motionFeedbackStream = nullptr;
+    lastCommandLatencyUs = 0;
+    homingsTaken = homingsQueued.load(std::memory_order_relaxed);
+    commandLatencyTraceId = TRACE_ID_NONE;
 
     // Initialize servo status
     for (int i = 0; i < SERVO_COUNT; i++) {
@@ -33,26 +43,40 @@ void ServoController::initialize() {
     resetPerformanceMetrics();
     for (int i = 0; i < SERVO_COUNT; i++) {
         previousServoAngles[i] = minAngle; // Start with home position
+        smoothnessTracking[i] = false;
+        smoothnessStartTimes[i] = 0;
+        lastSetpoints[i] = (float)minAngle;
     }
+    lastSetpointTime = millis();
 
     try {
+        servoOutput = SERVO_MCPWM_OUTPUT_ENABLED ? (ServoOutput*)&mcpwmOutput : (ServoOutput*)&libraryOutput;
+        Logger::infof("Servo output backend: %s", servoOutput->getName());
+
         // Attach servos to pins
         for (int i = 0; i < SERVO_COUNT; i++) {
-            int channel = servos[i].attach(SERVO_PINS[i]);
-            if (channel < 0) {
+            if (!servoOutput->attach(i, SERVO_PINS[i])) {
                 Logger::errorf("Failed to attach servo %d to pin %d", i, SERVO_PINS[i]);
                 REPORT_ERROR(ErrorCode::SERVO_INITIALIZATION_FAILED,
                            "Servo attachment failed");
                 return;
             }
 
-            // Set initial position
-            servos[i].write(minAngle);
             updateServoStatus(i, minAngle, false);
+            commandedAngles[i] = minAngle;
 
-            Logger::infof("Servo %d attached to pin %d (channel %d)", i, SERVO_PINS[i], channel);
+            Logger::infof("Servo %d attached to pin %d", i, SERVO_PINS[i]);
         }
 
+        // Set initial position
+        motionPlanner.setPositions(commandedAngles);
+        applySetpoints(millis());
+
+        portENTER_CRITICAL(&requestLock);
+        pendingRequest = MotionRequest::NONE;
+        pendingExercise = nullptr;
+        portEXIT_CRITICAL(&requestLock);
+
         // Create servo task through FreeRTOS Manager for proper coordination
         if (!createTaskThroughManager()) {
             Logger::error("Failed to create servo task through FreeRTOS Manager");
@@ -72,15 +96,7 @@ void ServoController::initialize() {
 void ServoController::update() {
     if (!initialized) return;
 
-    // Update servo status timestamps
-    for (int i = 0; i < SERVO_COUNT; i++) {
-        if (servoStatus[i].isMoving) {
-            // Check if movement should be considered complete
-            if (millis() - servoStatus[i].lastMoveTime > movementDelayMs + 100) {
-                updateServoStatus(i, servoStatus[i].targetAngle, false);
-            }
-        }
-    }
+    // Servo status is kept current by the control loop in the servo task
 }
 
 void ServoController::shutdown() {
@@ -95,9 +111,7 @@ void ServoController::shutdown() {
 
     // Detach servos
     for (int i = 0; i < SERVO_COUNT; i++) {
-        if (servos[i].attached()) {
-            servos[i].detach();
-        }
+        servoOutput->detach(i);
     }
 
     initialized = false;
@@ -115,7 +129,7 @@ bool ServoController::executeCommand(const String& command) {
 }
 
 bool ServoController::executeCommand(int commandCode) {
-    if (!initialized || movementInProgress) {
+    if (!acceptsCommand(commandCode)) {
         Logger::warning("Cannot execute command - servo controller busy or not initialized");
         return false;
     }
@@ -124,106 +138,160 @@ bool ServoController::executeCommand(int commandCode) {
 
     switch (commandCode) {
         case 0:
-            returnToHome();
-            return true;
+            return returnToHome();
 
         case 1:
-            executeSequentialMovement();
-            return true;
+            return executeSequentialMovement();
 
         case 2:
-            executeSimultaneousMovement();
-            return true;
+            return executeSimultaneousMovement();
+
+        default: {
+            const ExerciseTable* exercise = ExerciseLibrary::getTableForCommand(commandCode);
+            if (exercise) {
+                return executeExercise(*exercise);
+            }
 
-        default:
             Logger::warningf("Unknown servo command: %d", commandCode);
             REPORT_WARNING(ErrorCode::INVALID_COMMAND, "Unknown command code");
             return false;
+        }
     }
 }
 
-void ServoController::stopAllMovement() {
-    if (!initialized) return;
+bool ServoController::acceptsCommand(int commandCode) {
+    if (!initialized) return false;
 
-    Logger::info("Stopping all servo movement");
+    // Homing replaces whatever is running (and clears an emergency stop),
+    // exercises wait for the previous one to finish
+    if (commandCode == 0) return true;
 
-    movementInProgress = false;
-    setState(ServoState::IDLE);
+    return !isBusy();
+}
 
-    // Mark all servos as not moving
-    for (int i = 0; i < SERVO_COUNT; i++) {
-        updateServoStatus(i, servoStatus[i].currentAngle, false);
+bool ServoController::submitCommand(const ServoCommand& command) {
+    if (!initialized || servoTaskHandle == nullptr) return false;
+
+    if (command.commandCode > MOVEMENT_COMMAND_MAX) {
+        Logger::warningf("Unknown servo command: %d", command.commandCode);
+        return false;
+    }
+
+    if (!commandQueue.push(command)) {
+        Logger::warning("Servo command queue full - command dropped");
+        return false;
+    }
+
+    // Counted after the push, so a homing the servo task knows about is always in the queue
+    if (command.commandCode == 0) {
+        homingsQueued.fetch_add(1, std::memory_order_release);
     }
+
+    xTaskNotifyGive(servoTaskHandle);
+    return true;
+}
+
+uint32_t ServoController::getLastCommandLatencyUs() {
+    return lastCommandLatencyUs;
+}
+
+void ServoController::stopAllMovement() {
+    if (!initialized) return;
+
+    Logger::info("Stopping all servo movement");
+    postRequest(MotionRequest::STOP);
 }
 
 void ServoController::emergencyStop() {
     Logger::warning("EMERGENCY STOP - All servo movement halted");
 
-    stopAllMovement();
-
-    // Move all servos to safe position (home)
-    for (int i = 0; i < SERVO_COUNT; i++) {
-        servos[i].write(minAngle);
-        updateServoStatus(i, minAngle, false);
+    if (servoTaskHandle == nullptr) {
+        // No control loop to hand the stop to
+        haltAtHome();
+        setState(ServoState::ERROR);
+        return;
     }
 
-    setState(ServoState::ERROR);
+    postRequest(MotionRequest::EMERGENCY_STOP);
 }
 
-void ServoController::executeSequentialMovement() {
-    if (!initialized || movementInProgress) return;
+SafetySupervisor& ServoController::getSafetySupervisor() {
+    return safetySupervisor;
+}
+
+bool ServoController::isOutputCut() {
+    return outputCut;
+}
+
+bool ServoController::executeSequentialMovement() {
+    if (!initialized || movementInProgress) return false;
 
     Logger::info("Starting sequential movement");
     logMovementStart(MovementType::SEQUENTIAL);
 
-    currentMovementType = MovementType::SEQUENTIAL;
-    setState(ServoState::SEQUENTIAL_MOVEMENT);
-    movementInProgress = true;
-    currentCycle = 0;
-    movementStartTime = millis();
-    movementCount++;
+    ExerciseProfile profile;
+    buildSequentialProfile(profile);
 
-    // Notify task to start movement using FreeRTOS Manager coordination
-    if (servoTaskHandle != nullptr) {
-        // Notify servo task to start movement
-        xTaskNotifyGive(servoTaskHandle);
-        Logger::debug("Servo task notified for sequential movement");
+    if (!startMovement(profile, MovementType::SEQUENTIAL, ServoState::SEQUENTIAL_MOVEMENT)) {
+        return false;
     }
+    LOG_DEBUG("Servo task notified for sequential movement");
+    return true;
 }
 
-void ServoController::executeSimultaneousMovement() {
-    if (!initialized || movementInProgress) return;
+bool ServoController::executeSimultaneousMovement() {
+    if (!initialized || movementInProgress) return false;
 
     Logger::info("Starting simultaneous movement");
     logMovementStart(MovementType::SIMULTANEOUS);
 
-    currentMovementType = MovementType::SIMULTANEOUS;
-    setState(ServoState::SIMULTANEOUS_MOVEMENT);
-    movementInProgress = true;
-    currentCycle = 0;
-    movementStartTime = millis();
-    movementCount++;
+    ExerciseProfile profile;
+    buildSimultaneousProfile(profile);
 
-    // Notify task to start movement using FreeRTOS Manager coordination
-    if (servoTaskHandle != nullptr) {
-        // Notify servo task to start movement
-        xTaskNotifyGive(servoTaskHandle);
-        Logger::debug("Servo task notified for simultaneous movement");
+    if (!startMovement(profile, MovementType::SIMULTANEOUS, ServoState::SIMULTANEOUS_MOVEMENT)) {
+        return false;
     }
+    LOG_DEBUG("Servo task notified for simultaneous movement");
+    return true;
 }
 
-void ServoController::returnToHome() {
-    if (!initialized) return;
+bool ServoController::returnToHome() {
+    if (!initialized) return false;
 
     Logger::info("Returning servos to home position");
+    logMovementStart(MovementType::HOME);
 
-    currentMovementType = MovementType::HOME;
-    setState(ServoState::HOMING);
+    ExerciseProfile profile;
+    buildHomeProfile(profile);
 
-    moveAllServosTo(minAngle, movementDelayMs);
+    return startMovement(profile, MovementType::HOME, ServoState::HOMING);
+}
 
-    setState(ServoState::IDLE);
-    currentMovementType = MovementType::NONE;
+bool ServoController::executeProfile(const ExerciseProfile& profile) {
+    if (!initialized || isBusy()) {
+        Logger::warning("Cannot start exercise profile - servo controller busy or not initialized");
+        return false;
+    }
+
+    Logger::infof("Starting exercise profile (%d waypoints, %d repetitions)",
+                  profile.waypointCount, profile.repetitions);
+    logMovementStart(MovementType::PROFILE);
+
+    return startMovement(profile, MovementType::PROFILE, ServoState::PROFILE_MOVEMENT);
+}
+
+bool ServoController::executeExercise(const ExerciseTable& exercise) {
+    if (!initialized || isBusy()) {
+        Logger::warning("Cannot start exercise - servo controller busy or not initialized");
+        return false;
+    }
+
+    Logger::infof("Starting exercise %s (%d repetitions of %lu ms)", exercise.name, totalCycles,
+                  (unsigned long)exercise.rowCount * exercise.samplePeriodMs);
+    logMovementStart(MovementType::EXERCISE);
+
+    return queueMovement(MotionRequest::EXERCISE, nullptr, &exercise, MovementType::EXERCISE,
+                         ServoState::EXERCISE_MOVEMENT);
 }
 
 bool ServoController::isBusy() {
@@ -268,7 +336,7 @@ int ServoController::getServoCount() {
 
 bool ServoController::isServoAttached(int servoIndex) {
     if (isValidServoIndex(servoIndex)) {
-        return servos[servoIndex].attached();
+        return servoOutput != nullptr && servoOutput->isAttached(servoIndex);
     }
     return false;
 }
@@ -309,6 +377,22 @@ void ServoController::setStateChangeCallback(void (*callback)(ServoState oldStat
     stateChangeCallback = callback;
 }
 
+void ServoController::setAnalyticsCallback(void (*callback)()) {
+    analyticsCallback = callback;
+}
+
+void ServoController::setCommandStartedCallback(void (*callback)(const ServoCommand& command)) {
+    commandStartedCallback = callback;
+}
+
+void ServoController::setAngleFeedbackProvider(bool (*provider)(int servoIndex, float& angle)) {
+    angleFeedbackProvider = provider;
+}
+
+void ServoController::setMotionFeedbackStream(MotionRawStream* stream) {
+    motionFeedbackStream = stream;
+}
+
 unsigned long ServoController::getMovementStartTime() {
     return movementStartTime;
 }
@@ -338,7 +422,7 @@ bool ServoController::createTaskThroughManager() {
     BaseType_t result = xTaskCreatePinnedToCore(
         servoTask,
         "ServoControl",  // Use consistent naming with FreeRTOS Manager
-        TASK_STACK_SERVO_CONTROL,  // Use FreeRTOS Manager stack size
+        ResourceProfiler::getStackSize(ProfiledTask::SERVO_CONTROL),
         this,
         PRIORITY_SERVO_CONTROL,    // Use FreeRTOS Manager priority
         &servoTaskHandle,
@@ -378,143 +462,453 @@ void ServoController::servoTask(void* parameter) {
 
     Logger::info("Servo task started with FreeRTOS Manager coordination");
 
+    const TickType_t controlPeriod = pdMS_TO_TICKS(SERVO_CONTROL_PERIOD_MS);
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    TraceId traceId = TaskTracer::registerTask("ServoControl", SERVO_CONTROL_PERIOD_MS * 1000);
+    controller->commandLatencyTraceId = TaskTracer::registerTask("CmdLatency");  // Arrival to movement start
+
     while (true) {
-        // Wait for notification to start movement
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        Logger::debug("Servo task received movement notification");
-
-        // Perform movement based on type
-        if (controller->currentMovementType == MovementType::SEQUENTIAL) {
-            Logger::debug("Executing sequential movement cycles");
-            controller->performSequentialCycles();
-        } else if (controller->currentMovementType == MovementType::SIMULTANEOUS) {
-            Logger::debug("Executing simultaneous movement cycles");
-            controller->performSimultaneousCycles();
+        // Nothing to track - sleep until a command or stop request arrives
+        if (!controller->motionPlanner.isActive() && controller->commandQueue.isEmpty()) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            lastWakeTime = xTaskGetTickCount();
+            TaskTracer::resetPeriod(traceId);  // Idle time is not a missed tick
         }
 
-        // Movement completed successfully
-        Logger::debug("Servo movement cycles completed");
+        {
+            TaskTracer::ScopedTimer timer(traceId);
+            controller->controlTick(millis());
+        }
 
-        // Feed watchdog to indicate task is healthy
-        FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
+        // Fixed control rate while a trajectory is running
+        vTaskDelayUntil(&lastWakeTime, controlPeriod);
+    }
+}
 
-        // Movement complete
-        controller->movementInProgress = false;
-        controller->setState(ServoState::IDLE);
-        controller->currentMovementType = MovementType::NONE;
+// =============================================================================
+// MOTION PLANNING
+// =============================================================================
 
-        unsigned long movementDuration = millis() - controller->movementStartTime;
-        controller->totalMovementTime += movementDuration;
+void ServoController::buildSequentialProfile(ExerciseProfile& profile) {
+    memset(&profile, 0, sizeof(profile));
+    profile.repetitions = totalCycles;
+    profile.shape = TrajectoryShape::MINIMUM_JERK;
 
-        controller->logMovementComplete(controller->currentMovementType, controller->currentCycle);
+    // Flex each servo in turn (servo1 -> servo2 -> servo3), then extend them in the same order
+    for (int pass = 0; pass < 2; pass++) {
+        int angle = (pass == 0) ? maxAngle : minAngle;
 
-        // Notify completion via callback
-        if (controller->movementCompleteCallback) {
-            controller->movementCompleteCallback(controller->currentState, controller->currentCycle);
+        for (int servo = 0; servo < SERVO_COUNT; servo++) {
+            MotionWaypoint& waypoint = profile.waypoints[profile.waypointCount++];
+            waypoint.angles[servo] = angle;
+            waypoint.jointMask = 1 << servo;
+            waypoint.moveMs = movementDelayMs;
+            waypoint.holdMs = movementDelayMs;
         }
     }
 }
 
-void ServoController::performSequentialCycles() {
-    Logger::infof("Executing sequential movement (%d cycles)", totalCycles);
+void ServoController::buildSimultaneousProfile(ExerciseProfile& profile) {
+    memset(&profile, 0, sizeof(profile));
+    profile.repetitions = totalCycles;
+    profile.shape = TrajectoryShape::MINIMUM_JERK;
+    profile.waypointCount = 2;
+
+    for (int i = 0; i < SERVO_COUNT; i++) {
+        profile.waypoints[0].angles[i] = maxAngle;
+        profile.waypoints[1].angles[i] = minAngle;
+    }
+
+    for (int w = 0; w < 2; w++) {
+        profile.waypoints[w].jointMask = HOME_JOINT_MASK;
+        profile.waypoints[w].moveMs = movementDelayMs;
+        profile.waypoints[w].holdMs = 0;
+    }
+}
 
-    for (currentCycle = 1; currentCycle <= totalCycles; currentCycle++) {
-        Logger::infof("Sequential cycle %d/%d", currentCycle, totalCycles);
+void ServoController::buildHomeProfile(ExerciseProfile& profile) {
+    memset(&profile, 0, sizeof(profile));
+    profile.repetitions = 1;
+    profile.shape = TrajectoryShape::MINIMUM_JERK;
+    profile.waypointCount = 1;
 
-        if (!movementInProgress) break;  // Check for stop condition
+    MotionWaypoint& waypoint = profile.waypoints[0];
+    for (int i = 0; i < SERVO_COUNT; i++) {
+        waypoint.angles[i] = minAngle;
+    }
+    waypoint.jointMask = HOME_JOINT_MASK;
+    waypoint.moveMs = movementDelayMs;
+    waypoint.holdMs = 0;
+}
 
-        // Move each servo to max angle sequentially (servo1 -> servo2 -> servo3)
-        for (int servo = 0; servo < SERVO_COUNT; servo++) {
-            if (!movementInProgress) break;
-            moveServoSmoothly(servo, maxAngle, movementDelayMs);
-            delay(movementDelayMs);
+bool ServoController::startMovement(const ExerciseProfile& profile, MovementType type, ServoState state) {
+    if (!MotionPlanner::validateProfile(profile)) {
+        REPORT_WARNING(ErrorCode::INVALID_COMMAND, "Invalid exercise profile");
+        return false;
+    }
+
+    return queueMovement(MotionRequest::PROFILE, &profile, nullptr, type, state);
+}
+
+bool ServoController::queueMovement(MotionRequest request, const ExerciseProfile* profile,
+                                    const ExerciseTable* exercise, MovementType type, ServoState state) {
+    // Published before the servo task can see the request, so isBusy() is true right away
+    bool wasInProgress = movementInProgress;
+    movementInProgress = true;
+    bool queued = false;
+
+    portENTER_CRITICAL(&requestLock);
+    // A pending emergency stop always wins over a new movement
+    if (pendingRequest != MotionRequest::EMERGENCY_STOP) {
+        if (profile) {
+            pendingProfile = *profile;
         }
+        pendingExercise = exercise;
+        pendingMovementType = type;
+        pendingState = state;
+        pendingRequest = request;
+        queued = true;
+    }
+    portEXIT_CRITICAL(&requestLock);
 
-        // Move each servo back to min angle sequentially (servo1 -> servo2 -> servo3)
-        for (int servo = 0; servo < SERVO_COUNT; servo++) {
-            if (!movementInProgress) break;
-            moveServoSmoothly(servo, minAngle, movementDelayMs);
-            delay(movementDelayMs);
+    if (!queued) {
+        movementInProgress = wasInProgress;
+        Logger::warning("Movement rejected - emergency stop pending");
+        return false;
+    }
+
+    movementStartTime = millis();
+    movementCount++;
+
+    // The servo task picks the profile up on its next control tick
+    if (!isServoTask()) {
+        xTaskNotifyGive(servoTaskHandle);
+    }
+    return true;
+}
+
+void ServoController::postRequest(MotionRequest request) {
+    portENTER_CRITICAL(&requestLock);
+    if (pendingRequest != MotionRequest::EMERGENCY_STOP) {
+        pendingRequest = request;
+    }
+    portEXIT_CRITICAL(&requestLock);
+
+    if (servoTaskHandle != nullptr && !isServoTask()) {
+        xTaskNotifyGive(servoTaskHandle);
+    }
+}
+
+bool ServoController::isServoTask() {
+    return servoTaskHandle != nullptr && xTaskGetCurrentTaskHandle() == servoTaskHandle;
+}
+
+// =============================================================================
+// CONTROL LOOP (SERVO TASK)
+// =============================================================================
+
+void ServoController::drainCommandQueue() {
+    // Homing cuts in line - exercises still waiting in front of it are dropped
+    if (homingsQueued.load(std::memory_order_acquire) != homingsTaken) {
+        const ServoCommand* waiting;
+        while ((waiting = commandQueue.front()) != nullptr && waiting->commandCode != 0) {
+            Logger::infof("Queued servo command %d dropped by homing", waiting->commandCode);
+            commandQueue.popFront();
+        }
+    }
+
+    const ServoCommand* command;
+    while ((command = commandQueue.front()) != nullptr) {
+        if (!acceptsCommand(command->commandCode)) {
+            // An exercise behind a running one stays queued and is retried every tick
+            if (movementInProgress) break;
+
+            Logger::warningf("Servo command %d rejected in state %d", command->commandCode, (int)currentState);
+            commandQueue.popFront();
+            continue;
+        }
+
+        if (command->commandCode == 0) {
+            homingsTaken++;
         }
+        if (executeCommand(command->commandCode)) {
+            lastCommandLatencyUs = (uint32_t)(esp_timer_get_time() - command->receivedUs);
+            TaskTracer::record(commandLatencyTraceId, lastCommandLatencyUs);
 
-        if (!movementInProgress) break;  // Movement was stopped
+            // Only a command that actually started is counted as accepted
+            if (commandStartedCallback) {
+                commandStartedCallback(*command);
+            }
+        }
+        commandQueue.popFront();
     }
+}
 
-    Logger::infof("Sequential movement finished (%d cycles completed)", currentCycle - 1);
+void ServoController::controlTick(unsigned long now) {
+    // Envelope first, so a violation stops the joints before anything new is commanded
+    if (motionPlanner.isActive() && !checkSafety(now)) return;
 
-    // Mark movement as complete and reset state
-    movementInProgress = false;
-    setState(ServoState::IDLE);
+    drainCommandQueue();
+
+    ExerciseProfile profile;
+    const ExerciseTable* exercise = nullptr;
+    MovementType type = MovementType::NONE;
+    ServoState state = ServoState::IDLE;
+
+    portENTER_CRITICAL(&requestLock);
+    MotionRequest request = pendingRequest;
+    pendingRequest = MotionRequest::NONE;
+    if (request == MotionRequest::PROFILE) {
+        profile = pendingProfile;
+    }
+    if (request == MotionRequest::PROFILE || request == MotionRequest::EXERCISE) {
+        exercise = pendingExercise;
+        type = pendingMovementType;
+        state = pendingState;
+    }
+    portEXIT_CRITICAL(&requestLock);
+
+    switch (request) {
+        case MotionRequest::EMERGENCY_STOP:
+            motionPlanner.stop(now);
+            recordFinishedSegments();
+            haltAtHome();
+            if (movementInProgress) {
+                finishMovement(ServoState::ERROR);
+            } else {
+                setState(ServoState::ERROR);
+            }
+            return;
+
+        case MotionRequest::STOP:
+            motionPlanner.stop(now);
+            recordFinishedSegments();
+            applySetpoints(now);
+            if (movementInProgress) {
+                finishMovement(ServoState::IDLE);
+            } else {
+                setState(ServoState::IDLE);
+            }
+            return;
+
+        case MotionRequest::PROFILE:
+        case MotionRequest::EXERCISE:
+            // A running exercise is cut short where it is and the new one starts from there
+            if (motionPlanner.isActive()) {
+                Logger::info("Active movement replaced by new command");
+                motionPlanner.stop(now);
+                recordFinishedSegments();
+            }
+
+            if (outputCut) {
+                restoreOutput();
+            }
+
+            currentMovementType = type;
+            setState(state);
+            currentCycle = 0;
+            if (request == MotionRequest::EXERCISE
+                    ? !motionPlanner.startTable(*exercise, totalCycles, minAngle, maxAngle, now)
+                    : !motionPlanner.start(profile, now)) {
+                Logger::warning("Movement could not be started");
+                finishMovement(ServoState::IDLE);
+                return;
+            }
+            break;
 
-    // Sequential movement completed - state reset handled by servo task
+        case MotionRequest::NONE:
+            break;
+    }
+
+    if (!motionPlanner.isActive()) return;
+
+    bool running = motionPlanner.step(now);
+    applySetpoints(now);
+    recordFinishedSegments();
+    currentCycle = motionPlanner.getCompletedRepetitions();
+
+    if (!running) {
+        finishMovement(ServoState::IDLE);
+    }
 }
 
-void ServoController::performSimultaneousCycles() {
-    Logger::infof("Executing simultaneous movement (%d cycles)", totalCycles);
+void ServoController::applySetpoints(unsigned long now) {
+    float setpoints[SERVO_COUNT];
 
-    for (currentCycle = 1; currentCycle <= totalCycles; currentCycle++) {
-        Logger::infof("Simultaneous cycle %d/%d", currentCycle, totalCycles);
+    for (int i = 0; i < SERVO_COUNT; i++) {
+        setpoints[i] = motionPlanner.getPosition(i);
 
-        if (!movementInProgress) break;  // Check for stop condition
+        int angle = (int)lroundf(setpoints[i]);
+        if (angle != commandedAngles[i]) {
+            commandedAngles[i] = angle;
+            servoStatus[i].lastMoveTime = now;
+        }
 
-        // Move all servos together - FreeRTOS style
-        moveAllServosTo(maxAngle, movementDelayMs);
-        vTaskDelay(pdMS_TO_TICKS(movementDelayMs));  // FreeRTOS delay
-        moveAllServosTo(minAngle, movementDelayMs);
-        vTaskDelay(pdMS_TO_TICKS(movementDelayMs));  // FreeRTOS delay
+        servoStatus[i].currentAngle = angle;
+        servoStatus[i].targetAngle = motionPlanner.getTargetAngle(i);
+        servoStatus[i].isMoving = motionPlanner.isJointMoving(i);
     }
 
-    Logger::infof("Simultaneous movement finished (%d cycles completed)", currentCycle - 1);
+    // All joints change together, at sub-degree resolution
+    servoOutput->writeAngles(setpoints);
+    trackSmoothness(setpoints, now);
+}
 
-    // Mark movement as complete and reset state
-    movementInProgress = false;
-    setState(ServoState::IDLE);
+void ServoController::recordFinishedSegments() {
+    drainMotionFeedback();
+
+    uint8_t finished = motionPlanner.takeFinishedJoints();
+
+    for (int i = 0; i < SERVO_COUNT && finished; i++) {
+        if (!(finished & (1 << i))) continue;
+
+        const JointSegmentResult& result = motionPlanner.getSegmentResult(i);
+        previousServoAngles[i] = result.actualAngle;
 
-    // Simultaneous movement completed - state reset handled by servo task
+        // Also closes smoothness tracking for a joint that only held its position
+        float smoothness = calculateMovementSmoothness(i);
+
+        // Joint held its position - nothing to report
+        if (result.reachedTarget && result.startAngle == result.targetAngle) continue;
+
+        // Measured angle where the joint has a motion sensor, otherwise assume it followed its setpoint
+        int actualAngle = result.actualAngle;
+        bool successful = result.reachedTarget;
+        float measured;
+        if (angleFeedbackProvider && angleFeedbackProvider(i, measured)) {
+            actualAngle = (int)lroundf(measured);
+            successful = result.reachedTarget &&
+                         abs(actualAngle - result.targetAngle) <= SERVO_FEEDBACK_TOLERANCE;
+        }
+
+        recordMovementMetrics(i, result.startTime, result.duration, successful,
+                             result.startAngle, result.targetAngle, actualAngle, smoothness);
+    }
 }
 
-void ServoController::moveServoSmoothly(int servoIndex, int targetAngle, int delayMs) {
-    if (!isValidServoIndex(servoIndex) || !validateAngle(targetAngle)) {
-        return;
+void ServoController::trackSmoothness(const float* setpoints, unsigned long now) {
+    for (int i = 0; i < SERVO_COUNT; i++) {
+        if (smoothnessTracking[i]) {
+            commandedSmoothness[i].addPosition(setpoints[i], now);
+        } else if (motionPlanner.isJointMoving(i)) {
+            // Segment started since the last tick - the previous setpoint is its start
+            beginSmoothnessTracking(i, lastSetpointTime);
+            commandedSmoothness[i].addPosition(lastSetpoints[i], lastSetpointTime);
+            commandedSmoothness[i].addPosition(setpoints[i], now);
+        }
+        lastSetpoints[i] = setpoints[i];
     }
+    lastSetpointTime = now;
+}
 
-    // Record movement start time and previous angle for analytics
-    unsigned long startTime = millis();
-    int startAngle = previousServoAngles[servoIndex];
-    individualServoStartTimes[servoIndex] = startTime;
+void ServoController::beginSmoothnessTracking(int servoIndex, unsigned long now) {
+    commandedSmoothness[servoIndex].reset();
+    if (servoIndex == MOTION_SENSOR_JOINT) {
+        measuredSmoothness.reset();
+    }
+    smoothnessTracking[servoIndex] = true;
+    smoothnessStartTimes[servoIndex] = now;
+}
 
-    servos[servoIndex].write(targetAngle);
-    updateServoStatus(servoIndex, targetAngle, true);
+void ServoController::drainMotionFeedback() {
+    if (!motionFeedbackStream) return;
 
-    Logger::debugf("Servo %d moving to %d degrees", servoIndex, targetAngle);
+    // Samples arrive one FIFO batch late; the tail of a finished segment
+    // still in the sensor is left out of its score
+    MotionRawSample sample;
+    while (motionFeedbackStream->pop(sample)) {
+        if (!smoothnessTracking[MOTION_SENSOR_JOINT]) continue;
+        if ((long)(sample.timestamp - smoothnessStartTimes[MOTION_SENSOR_JOINT]) < 0) continue;
 
-    // Wait for movement to complete - FreeRTOS style
-    vTaskDelay(pdMS_TO_TICKS(delayMs));
+        measuredSmoothness.addVelocity(MOTION_JOINT_AXIS_SIGN * sample.gyro[1], sample.timestamp);
+    }
+}
+
+void ServoController::finishMovement(ServoState endState) {
+    MovementType finishedType = currentMovementType;
+    currentCycle = motionPlanner.getCompletedRepetitions();
 
-    // Calculate movement metrics
-    unsigned long duration = millis() - startTime;
-    int actualAngle = targetAngle; // Assume successful movement (no feedback sensor)
-    bool successful = (actualAngle == targetAngle);
-    float smoothness = calculateMovementSmoothness(servoIndex, duration);
+    LOG_DEBUG("Servo movement cycles completed");
 
-    // Record the movement metrics
-    recordMovementMetrics(servoIndex, startTime, duration, successful,
-                         startAngle, targetAngle, actualAngle, smoothness);
+    // Feed watchdog to indicate task is healthy
+    FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
 
-    // Update previous angle for next movement
-    previousServoAngles[servoIndex] = targetAngle;
+    movementInProgress = false;
+    setState(endState);
+    currentMovementType = MovementType::NONE;
+
+    unsigned long movementDuration = millis() - movementStartTime;
+    totalMovementTime += movementDuration;
+
+    logMovementComplete(finishedType, currentCycle);
+
+    // Notify completion via callback
+    if (movementCompleteCallback) {
+        movementCompleteCallback(currentState, currentCycle);
+    }
+}
+
+bool ServoController::checkSafety(unsigned long now) {
+    if (angleFeedbackProvider) {
+        float angle;
+        for (int i = 0; i < SERVO_COUNT; i++) {
+            if (angleFeedbackProvider(i, angle)) {
+                safetySupervisor.reportJointAngle(i, angle, now);
+            }
+        }
+    }
+
+    SafetyFault fault = safetySupervisor.check(lastSetpoints, now);
+    if (fault == SafetyFault::NONE) return true;
+
+    tripSafety(fault, now);
+    return false;
 }
 
-void ServoController::moveAllServosTo(int angle, int delayMs) {
-    if (!validateAngle(angle)) return;
+void ServoController::tripSafety(SafetyFault fault, unsigned long now) {
+    // Unpowered servos go limp - the hand is never driven back against whatever tripped
+    servoOutput->cutOutput();
+    outputCut = true;
 
+    motionPlanner.stop(now);
+    recordFinishedSegments();
     for (int i = 0; i < SERVO_COUNT; i++) {
-        servos[i].write(angle);
-        updateServoStatus(i, angle, true);
+        servoStatus[i].isMoving = false;
     }
+    finishMovement(ServoState::ERROR);
 
-    Logger::debugf("All servos moving to %d degrees", angle);
+    Logger::errorf("SAFETY STOP: %s (channel %d, value %ld) - servo output cut, home to resume",
+                   SafetySupervisor::getFaultName(fault), safetySupervisor.getLastFaultChannel(),
+                   (long)safetySupervisor.getLastFaultValue());
+    REPORT_ERROR(ErrorCode::SAFETY_LIMIT_EXCEEDED,
+                 String("Safety envelope violated: ") + SafetySupervisor::getFaultName(fault));
+}
+
+void ServoController::restoreOutput() {
+    for (int i = 0; i < SERVO_COUNT; i++) {
+        if (!servoOutput->attach(i, SERVO_PINS[i])) {
+            Logger::errorf("Failed to re-attach servo %d to pin %d", i, SERVO_PINS[i]);
+        }
+    }
+    outputCut = false;
+    Logger::info("Servo output restored after safety stop");
+}
+
+void ServoController::haltAtHome() {
+    // Move all servos to safe position (home) without a trajectory
+    float home[SERVO_COUNT];
+    for (int i = 0; i < SERVO_COUNT; i++) {
+        home[i] = (float)minAngle;
+        updateServoStatus(i, minAngle, false);
+        commandedAngles[i] = minAngle;
+        previousServoAngles[i] = minAngle;
+        lastSetpoints[i] = home[i];
+        smoothnessTracking[i] = false;
+    }
+    if (servoOutput != nullptr) {
+        servoOutput->writeAngles(home);
+    }
+    motionPlanner.setPositions(commandedAngles);
 }
 
 void ServoController::setState(ServoState newState) {
@@ -550,7 +944,7 @@ bool ServoController::validateCommand(const String& command) {
     if (command.length() == 0) return false;
 
     int commandCode = command.toInt();
-    return (commandCode >= 0 && commandCode <= 2);
+    return (commandCode >= 0 && commandCode <= MOVEMENT_COMMAND_MAX);
 }
 
 bool ServoController::validateAngle(int angle) {
@@ -572,6 +966,12 @@ void ServoController::logMovementStart(MovementType type) {
         case MovementType::HOME:
             Logger::info("Movement started: Homing");
             break;
+        case MovementType::PROFILE:
+            Logger::info("Movement started: Exercise profile");
+            break;
+        case MovementType::EXERCISE:
+            Logger::info("Movement started: Exercise table");
+            break;
         default:
             break;
     }
@@ -588,6 +988,12 @@ void ServoController::logMovementComplete(MovementType type, int cycles) {
         case MovementType::HOME:
             Logger::info("Movement complete: Homing");
             break;
+        case MovementType::PROFILE:
+            Logger::infof("Movement complete: Exercise profile (%d repetitions)", cycles);
+            break;
+        case MovementType::EXERCISE:
+            Logger::infof("Movement complete: Exercise table (%d repetitions)", cycles);
+            break;
         default:
             break;
     }
@@ -598,8 +1004,12 @@ void ServoController::logStateChange(ServoState oldState, ServoState newState) {
 }
 
 // Enhanced analytics methods implementation
-ServoController::MovementMetrics ServoController::getLastMovementMetrics() {
-    return lastMovementMetrics;
+bool ServoController::popMovementMetrics(MovementMetrics& metrics) {
+    return finishedMovements.pop(metrics);
+}
+
+uint32_t ServoController::getDroppedMetricsCount() {
+    return finishedMovements.getDroppedCount();
 }
 
 ServoController::ServoPerformance ServoController::getServoPerformance(int servoIndex) {
@@ -611,29 +1021,32 @@ ServoController::ServoPerformance ServoController::getServoPerformance(int servo
 
 void ServoController::recordMovementMetrics(int servoIndex, unsigned long startTime, unsigned long duration,
                                           bool successful, int startAngle, int targetAngle, int actualAngle,
-                                          float smoothness, const String& sessionId) {
+                                          float smoothness) {
     if (!isValidServoIndex(servoIndex)) return;
 
-    // Update last movement metrics
-    lastMovementMetrics.startTime = startTime;
-    lastMovementMetrics.duration = duration;
-    lastMovementMetrics.successful = successful;
-    lastMovementMetrics.servoIndex = servoIndex;
-    lastMovementMetrics.startAngle = startAngle;
-    lastMovementMetrics.targetAngle = targetAngle;
-    lastMovementMetrics.actualAngle = actualAngle;
-    lastMovementMetrics.smoothness = smoothness;
-    lastMovementMetrics.sessionId = sessionId;
+    MovementMetrics metrics;
+    metrics.startTime = startTime;
+    metrics.duration = duration;
+    metrics.successful = successful;
+    metrics.servoIndex = servoIndex;
+    metrics.startAngle = startAngle;
+    metrics.targetAngle = targetAngle;
+    metrics.actualAngle = actualAngle;
+    metrics.smoothness = smoothness;
 
     // Determine movement type
     if (currentMovementType == MovementType::SEQUENTIAL) {
-        lastMovementMetrics.movementType = "sequential";
+        metrics.movementType = "sequential";
     } else if (currentMovementType == MovementType::SIMULTANEOUS) {
-        lastMovementMetrics.movementType = "simultaneous";
+        metrics.movementType = "simultaneous";
     } else if (currentMovementType == MovementType::HOME) {
-        lastMovementMetrics.movementType = "home";
+        metrics.movementType = "home";
+    } else if (currentMovementType == MovementType::PROFILE) {
+        metrics.movementType = "profile";
+    } else if (currentMovementType == MovementType::EXERCISE) {
+        metrics.movementType = "exercise";
     } else {
-        lastMovementMetrics.movementType = "unknown";
+        metrics.movementType = "unknown";
     }
 
     // Update servo performance metrics
@@ -648,38 +1061,55 @@ void ServoController::recordMovementMetrics(int servoIndex, unsigned long startT
     perf.averageSmoothness = (perf.averageSmoothness * (perf.totalMovements - 1) + smoothness) / perf.totalMovements;
     perf.lastMovementTime = startTime + duration;
 
-    Logger::debugf("Movement metrics recorded: Servo %d, Duration %lu ms, Success: %s, Smoothness: %.2f",
+    LOG_DEBUGF("Movement metrics recorded: Servo %d, Duration %lu ms, Success: %s, Smoothness: %.2f",
                    servoIndex, duration, successful ? "Yes" : "No", smoothness);
 
     // Publish analytics data
-    publishMovementAnalytics(lastMovementMetrics);
+    publishMovementAnalytics(metrics);
 }
 
 void ServoController::publishMovementAnalytics(const MovementMetrics& metrics) {
     // Log the analytics data
     Logger::infof("Analytics: Servo %d, Type: %s, Duration: %lu ms, Success: %s, Smoothness: %.2f",
-                  metrics.servoIndex, metrics.movementType.c_str(), metrics.duration,
+                  metrics.servoIndex, metrics.movementType, metrics.duration,
                   metrics.successful ? "Yes" : "No", metrics.smoothness);
 
-    // Store metrics for DeviceManager to publish
-    // DeviceManager will call getLastMovementMetrics() to get this data
-    lastMovementMetrics = metrics;
-    hasNewMetrics = true;
+    // Queued for DeviceManager, which drains it with popMovementMetrics() -
+    // joints finishing in the same tick each get their own entry
+    if (!finishedMovements.push(metrics)) {
+        Logger::warningf("Movement metrics queue full - servo %d segment not published", metrics.servoIndex);
+    }
+
+    if (analyticsCallback) {
+        analyticsCallback();
+    }
 }
 
-float ServoController::calculateMovementSmoothness(int servoIndex, unsigned long duration) {
-    if (!isValidServoIndex(servoIndex) || duration == 0) {
+float ServoController::calculateMovementSmoothness(int servoIndex) {
+    if (!isValidServoIndex(servoIndex)) {
         return 0.0f;
     }
 
-    // Simple smoothness calculation based on movement duration
-    // Longer duration for same angle change = smoother movement
-    // This is a basic implementation - can be enhanced with actual acceleration data
-    float expectedDuration = 1000.0f; // Expected duration for smooth movement (1 second)
-    float smoothness = (duration >= expectedDuration) ? 100.0f : (duration / expectedDuration) * 100.0f;
+    // The next segment of this joint starts tracking afresh
+    bool stillMoving = motionPlanner.isJointMoving(servoIndex);
+    smoothnessTracking[servoIndex] = false;
+
+    // Measured motion where the joint carries the sensor, the commanded trajectory otherwise
+    bool measured = servoIndex == MOTION_SENSOR_JOINT && measuredSmoothness.hasResult();
+    const SmoothnessEstimator& estimator = measured ? measuredSmoothness : commandedSmoothness[servoIndex];
+    float smoothness = estimator.getScore();  // 0 if the segment was too short to score
 
-    // Cap at 100%
-    return (smoothness > 100.0f) ? 100.0f : smoothness;
+    LOG_DEBUGF("Servo %d smoothness %.1f (LDLJ %.2f, %u samples, %s)", servoIndex, smoothness,
+               estimator.getLogDimensionlessJerk(), (unsigned)estimator.getSampleCount(),
+               measured ? "measured" : "commanded");
+
+    // A new segment that began this tick continues from the current setpoint
+    if (stillMoving) {
+        beginSmoothnessTracking(servoIndex, lastSetpointTime);
+        commandedSmoothness[servoIndex].addPosition(lastSetpoints[servoIndex], lastSetpointTime);
+    }
+
+    return smoothness;
 }
 
 void ServoController::resetPerformanceMetrics() {
@@ -690,17 +1120,6 @@ void ServoController::resetPerformanceMetrics() {
         previousServoAngles[i] = 0;
     }
 
-    // Reset last movement metrics
-    lastMovementMetrics = {};
-    hasNewMetrics = false;
-
     Logger::info("Performance metrics reset");
 }
 
-bool ServoController::hasNewAnalytics() {
-    return hasNewMetrics;
-}
-
-void ServoController::clearNewAnalytics() {
-    hasNewMetrics = false;
-}
@@ -2,22 +2,43 @@
 #define SERVO_CONTROLLER_H
 
 #include <Arduino.h>
-#include <ESP32Servo.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
 #include "../config/Config.h"
+#include "../memory/SPSCRingBuffer.h"
+#include "../sensors/MotionSensorManager.h"
+#include "ExerciseLibrary.h"
+#include "MotionPlanner.h"
+#include "SafetySupervisor.h"
+#include "ServoOutput.h"
+#include "SmoothnessEstimator.h"
+#include "TaskTracer.h"
 
 enum class ServoState {
     IDLE = 0,
     SEQUENTIAL_MOVEMENT = 1,
     SIMULTANEOUS_MOVEMENT = 2,
     HOMING = 3,
-    ERROR = 4
+    ERROR = 4,
+    PROFILE_MOVEMENT = 5,
+    EXERCISE_MOVEMENT = 6
 };
 
 enum class MovementType {
     NONE,
     SEQUENTIAL,
     SIMULTANEOUS,
-    HOME
+    HOME,
+    PROFILE,
+    EXERCISE
+};
+
+// Movement command handed straight to the servo task (see submitCommand)
+struct ServoCommand {
+    int64_t receivedUs;   // esp_timer_get_time() when the command arrived
+    uint8_t commandCode;  // 0 = home, 1 = sequential, 2 = simultaneous, 3-5 = exercise table
+    uint8_t sequence;     // Client sequence number
 };
 
 struct ServoStatus {
@@ -37,13 +58,27 @@ public:
     // Command execution
     bool executeCommand(const String& command);
     bool executeCommand(int commandCode);
+    bool acceptsCommand(int commandCode);  // Homing may interrupt a running exercise
+
+    // Lock-free fast path: queues the command and wakes the servo task, which
+    // starts it on its next tick. Exercises wait in the queue while another
+    // one runs; homing drops whatever is still waiting. Single producer only
+    // (the BLE host task).
+    bool submitCommand(const ServoCommand& command);
+    uint32_t getLastCommandLatencyUs();
     void stopAllMovement();
     void emergencyStop();
 
+    // Safety interlock (checked by the servo task on every control tick)
+    SafetySupervisor& getSafetySupervisor();  // Sensor tasks report into it
+    bool isOutputCut();                       // Tripped - homing restores output
+
     // Movement patterns
-    void executeSequentialMovement();
-    void executeSimultaneousMovement();
-    void returnToHome();
+    bool executeSequentialMovement();
+    bool executeSimultaneousMovement();
+    bool returnToHome();
+    bool executeProfile(const ExerciseProfile& profile);  // Arbitrary multi-joint exercise
+    bool executeExercise(const ExerciseTable& exercise);  // Precomputed table, getTotalCycles() repetitions
 
     // Status queries
     bool isBusy();
@@ -66,13 +101,18 @@ public:
     // Callbacks
     void setMovementCompleteCallback(void (*callback)(ServoState state, int cycles));
     void setStateChangeCallback(void (*callback)(ServoState oldState, ServoState newState));
+    void setAnalyticsCallback(void (*callback)());  // Metrics queued, from the servo task
+    void setCommandStartedCallback(void (*callback)(const ServoCommand& command));  // Fast-path command started, from the servo task
+    void setAngleFeedbackProvider(bool (*provider)(int servoIndex, float& angle));  // Measured joint angle, false if unavailable
+    void setMotionFeedbackStream(MotionRawStream* stream);  // Gyro samples of MOTION_SENSOR_JOINT, drained by the servo task
 
     // Statistics
     unsigned long getMovementStartTime();
     unsigned long getTotalMovementTime();
     int getMovementCount();
 
-    // Enhanced analytics structures
+    // Enhanced analytics structures - one per finished joint segment, copied
+    // between tasks, so no owning members
     struct MovementMetrics {
         unsigned long startTime;
         unsigned long duration;
@@ -82,8 +122,7 @@ public:
         int targetAngle;
         int actualAngle;
         float smoothness;
-        String movementType;
-        String sessionId;
+        const char* movementType;  // String literal
     };
 
     struct ServoPerformance {
@@ -97,21 +136,21 @@ public:
     };
 
     // Enhanced analytics methods
-    MovementMetrics getLastMovementMetrics();
+    bool popMovementMetrics(MovementMetrics& metrics);  // Oldest finished segment - single consumer
+    uint32_t getDroppedMetricsCount();
     ServoPerformance getServoPerformance(int servoIndex);
     void recordMovementMetrics(int servoIndex, unsigned long startTime, unsigned long duration,
                               bool successful, int startAngle, int targetAngle, int actualAngle,
-                              float smoothness, const String& sessionId = "");
+                              float smoothness);
     void publishMovementAnalytics(const MovementMetrics& metrics);
-    float calculateMovementSmoothness(int servoIndex, unsigned long duration);
+    float calculateMovementSmoothness(int servoIndex);  // Of the segment just finished
     void resetPerformanceMetrics();
 
-    // Check for new analytics data
-    bool hasNewAnalytics();
-    void clearNewAnalytics();
-
 private:
-    Servo servos[3];
+    // PWM output (backend chosen by SERVO_MCPWM_OUTPUT_ENABLED)
+    ESP32ServoOutput libraryOutput;
+    MCPWMServoOutput mcpwmOutput;
+    ServoOutput* servoOutput;
     ServoStatus servoStatus[3];
 
     ServoState currentState;
@@ -129,11 +168,51 @@ private:
     int movementCount;
 
     // Enhanced analytics data
-    MovementMetrics lastMovementMetrics;
+    SPSCRingBuffer<MovementMetrics, MOVEMENT_METRICS_QUEUE_SIZE> finishedMovements;  // Servo task -> DeviceManager
     ServoPerformance servoPerformance[3];
     unsigned long individualServoStartTimes[3];
     int previousServoAngles[3];
-    bool hasNewMetrics;
+
+    // Motion planning (planner state is only touched by the servo task)
+    enum class MotionRequest : uint8_t {
+        NONE,
+        PROFILE,
+        EXERCISE,
+        STOP,
+        EMERGENCY_STOP
+    };
+
+    MotionPlanner motionPlanner;
+    int commandedAngles[3];
+
+    // Movement smoothness (servo task only). Every joint is scored from its
+    // commanded trajectory; the sensor joint from measured angular velocity
+    // when motion feedback is available.
+    SafetySupervisor safetySupervisor;
+    bool outputCut;
+
+    SmoothnessEstimator commandedSmoothness[3];
+    SmoothnessEstimator measuredSmoothness;
+    bool smoothnessTracking[3];
+    unsigned long smoothnessStartTimes[3];
+    float lastSetpoints[3];
+    unsigned long lastSetpointTime;
+    MotionRawStream* motionFeedbackStream;
+
+    // Fast-path commands (BLE host task -> servo task)
+    SPSCRingBuffer<ServoCommand, SERVO_COMMAND_QUEUE_SIZE> commandQueue;
+    std::atomic<uint32_t> homingsQueued{0};  // Written by the producer after each homing push
+    uint32_t homingsTaken;                   // Servo task only
+    volatile uint32_t lastCommandLatencyUs;
+    TraceId commandLatencyTraceId;
+
+    // Requests handed from command callers to the servo task (all guarded by requestLock)
+    portMUX_TYPE requestLock = portMUX_INITIALIZER_UNLOCKED;
+    MotionRequest pendingRequest;
+    ExerciseProfile pendingProfile;
+    const ExerciseTable* pendingExercise;
+    MovementType pendingMovementType;
+    ServoState pendingState;
 
     // Task management (now integrated with FreeRTOS Manager)
     TaskHandle_t servoTaskHandle;  // Will be set by FreeRTOS Manager
@@ -146,12 +225,34 @@ private:
     // Callbacks
     void (*movementCompleteCallback)(ServoState state, int cycles);
     void (*stateChangeCallback)(ServoState oldState, ServoState newState);
+    void (*analyticsCallback)();
+    void (*commandStartedCallback)(const ServoCommand& command);
+    bool (*angleFeedbackProvider)(int servoIndex, float& angle);
 
     // Movement execution
-    void performSequentialCycles();
-    void performSimultaneousCycles();
-    void moveServoSmoothly(int servoIndex, int targetAngle, int delayMs);
-    void moveAllServosTo(int angle, int delayMs);
+    void buildSequentialProfile(ExerciseProfile& profile);
+    void buildSimultaneousProfile(ExerciseProfile& profile);
+    void buildHomeProfile(ExerciseProfile& profile);
+    bool startMovement(const ExerciseProfile& profile, MovementType type, ServoState state);
+    bool queueMovement(MotionRequest request, const ExerciseProfile* profile, const ExerciseTable* exercise,
+                       MovementType type, ServoState state);
+    void postRequest(MotionRequest request);
+    bool isServoTask();
+
+    // Control loop (servo task only)
+    void drainCommandQueue();
+    void controlTick(unsigned long now);
+    void applyRequest(MotionRequest request, unsigned long now);
+    void applySetpoints(unsigned long now);
+    void recordFinishedSegments();
+    void trackSmoothness(const float* setpoints, unsigned long now);
+    void beginSmoothnessTracking(int servoIndex, unsigned long now);
+    void drainMotionFeedback();
+    bool checkSafety(unsigned long now);
+    void tripSafety(SafetyFault fault, unsigned long now);
+    void restoreOutput();
+    void finishMovement(ServoState endState);
+    void haltAtHome();
 
     // State management
     void setState(ServoState newState);
@@ -174,6 +275,7 @@ private:
     static const int DEFAULT_MAX_ANGLE = 90;
     static const int DEFAULT_MOVEMENT_DELAY = 1000;
     static const int DEFAULT_CYCLES = 3;
+    static const uint8_t HOME_JOINT_MASK = 0x07;  // All three joints
 
     // Use hardcoded values for now (FreeRTOS config temporarily disabled)
     static const uint32_t TASK_STACK_SIZE = 4096;
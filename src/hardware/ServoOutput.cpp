@@ -0,0 +1,184 @@
+#include "ServoOutput.h"
+#include <driver/mcpwm.h>
+#include <soc/mcpwm_struct.h>
+
+// =============================================================================
+// COMMON OUTPUT STAGE
+// =============================================================================
+
+ServoOutput::ServoOutput() : outputValid(false) {
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        pulseWidths[i] = 0;
+    }
+}
+
+void ServoOutput::writeAngles(const float* angles) {
+    uint16_t widths[SERVO_OUTPUT_CHANNELS];
+    bool changed = !outputValid;
+
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        widths[i] = angleToPulseWidth(angles[i]);
+        if (widths[i] != pulseWidths[i]) {
+            changed = true;
+        }
+    }
+
+    // Holding still costs nothing - the PWM hardware keeps the last frame going
+    if (!changed) return;
+
+    latchPulseWidths(widths);
+
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        pulseWidths[i] = widths[i];
+    }
+    outputValid = true;
+}
+
+void ServoOutput::cutOutput() {
+    // No width is live any more - a backend that skips unchanged channels
+    // must still write every one after re-attach, or a joint that tripped
+    // at its next target would stay unpowered
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        detach(i);
+        pulseWidths[i] = 0;
+    }
+    outputValid = false;
+}
+
+uint16_t ServoOutput::getPulseWidth(int channel) {
+    if (channel < 0 || channel >= SERVO_OUTPUT_CHANNELS) return 0;
+    return pulseWidths[channel];
+}
+
+uint16_t ServoOutput::angleToPulseWidth(float angle) {
+    if (angle < 0.0f) angle = 0.0f;
+    if (angle > 180.0f) angle = 180.0f;
+
+    // Same 0-180 degree mapping as ESP32Servo::write()
+    float span = (float)(SERVO_PULSE_MAX_US - SERVO_PULSE_MIN_US);
+    return (uint16_t)(SERVO_PULSE_MIN_US + angle * span / 180.0f + 0.5f);
+}
+
+// =============================================================================
+// ESP32SERVO (LEDC) BACKEND
+// =============================================================================
+
+bool ESP32ServoOutput::attach(int channel, int pin) {
+    if (channel < 0 || channel >= SERVO_OUTPUT_CHANNELS) return false;
+
+    servos[channel].setPeriodHertz(SERVO_PWM_FREQUENCY);
+    return servos[channel].attach(pin, SERVO_PULSE_MIN_US, SERVO_PULSE_MAX_US) >= 0;
+}
+
+void ESP32ServoOutput::detach(int channel) {
+    if (isAttached(channel)) {
+        servos[channel].detach();
+    }
+}
+
+bool ESP32ServoOutput::isAttached(int channel) {
+    if (channel < 0 || channel >= SERVO_OUTPUT_CHANNELS) return false;
+    return servos[channel].attached();
+}
+
+const char* ESP32ServoOutput::getName() {
+    return "ESP32Servo";
+}
+
+void ESP32ServoOutput::latchPulseWidths(const uint16_t* widths) {
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        if (servos[i].attached() && widths[i] != pulseWidths[i]) {
+            servos[i].writeMicroseconds(widths[i]);
+        }
+    }
+}
+
+// =============================================================================
+// MCPWM BACKEND
+// =============================================================================
+
+static const mcpwm_timer_t MCPWM_CHANNEL_TIMERS[SERVO_OUTPUT_CHANNELS] = {
+    MCPWM_TIMER_0, MCPWM_TIMER_1, MCPWM_TIMER_2
+};
+
+static const mcpwm_io_signals_t MCPWM_CHANNEL_SIGNALS[SERVO_OUTPUT_CHANNELS] = {
+    MCPWM0A, MCPWM1A, MCPWM2A
+};
+
+MCPWMServoOutput::MCPWMServoOutput() {
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        attached[i] = false;
+    }
+}
+
+bool MCPWMServoOutput::attach(int channel, int pin) {
+    if (channel < 0 || channel >= SERVO_OUTPUT_CHANNELS) return false;
+
+    mcpwm_timer_t timer = MCPWM_CHANNEL_TIMERS[channel];
+
+    if (mcpwm_gpio_init(MCPWM_UNIT_0, MCPWM_CHANNEL_SIGNALS[channel], pin) != ESP_OK) {
+        return false;
+    }
+
+    // Output stays low until the first latch
+    mcpwm_config_t config = {};
+    config.frequency = SERVO_PWM_FREQUENCY;
+    config.cmpr_a = 0.0f;
+    config.cmpr_b = 0.0f;
+    config.duty_mode = MCPWM_DUTY_MODE_0;
+    config.counter_mode = MCPWM_UP_COUNTER;
+
+    if (mcpwm_init(MCPWM_UNIT_0, timer, &config) != ESP_OK) {
+        return false;
+    }
+
+    // Timer 0 is the frame reference, the others restart on its zero
+    if (channel == 0) {
+        mcpwm_set_timer_sync_output(MCPWM_UNIT_0, MCPWM_TIMER_0, MCPWM_SWSYNC_SOURCE_TEZ);
+    } else {
+        mcpwm_sync_config_t sync = {};
+        sync.sync_sig = MCPWM_SELECT_TIMER0_SYNC;
+        sync.timer_val = 0;
+        sync.count_direction = MCPWM_TIMER_DIRECTION_UP;
+        mcpwm_sync_configure(MCPWM_UNIT_0, timer, &sync);
+    }
+
+    attached[channel] = true;
+    return true;
+}
+
+void MCPWMServoOutput::detach(int channel) {
+    if (!isAttached(channel)) return;
+
+    mcpwm_set_signal_low(MCPWM_UNIT_0, MCPWM_CHANNEL_TIMERS[channel], MCPWM_GEN_A);
+    mcpwm_stop(MCPWM_UNIT_0, MCPWM_CHANNEL_TIMERS[channel]);
+    attached[channel] = false;
+}
+
+bool MCPWMServoOutput::isAttached(int channel) {
+    if (channel < 0 || channel >= SERVO_OUTPUT_CHANNELS) return false;
+    return attached[channel];
+}
+
+const char* MCPWMServoOutput::getName() {
+    return "MCPWM";
+}
+
+void MCPWMServoOutput::latchPulseWidths(const uint16_t* widths) {
+    portENTER_CRITICAL(&latchLock);
+
+    // Compare values go to shadow registers and are copied to the active ones
+    // on the timer zero. Blocking that copy while writing means all three
+    // channels switch on the same frame even if a zero falls in between.
+    MCPWM0.update_cfg.global_up_en = 0;
+
+    for (int i = 0; i < SERVO_OUTPUT_CHANNELS; i++) {
+        if (attached[i]) {
+            mcpwm_set_duty_in_us(MCPWM_UNIT_0, MCPWM_CHANNEL_TIMERS[i], MCPWM_GEN_A, widths[i]);
+        }
+    }
+
+    MCPWM0.update_cfg.global_up_en = 1;
+
+    portEXIT_CRITICAL(&latchLock);
+}
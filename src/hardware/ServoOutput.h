@@ -0,0 +1,100 @@
+#ifndef SERVO_OUTPUT_H
+#define SERVO_OUTPUT_H
+
+#include <Arduino.h>
+#include <ESP32Servo.h>
+#include <freertos/FreeRTOS.h>
+#include "../config/Config.h"
+
+const int SERVO_OUTPUT_CHANNELS = 3;
+
+// =============================================================================
+// SERVO OUTPUT BACKEND
+// =============================================================================
+
+/**
+ * PWM output stage for the finger servos.
+ *
+ * Angles are converted to pulse widths in microseconds (about 0.1 degree per
+ * step) and handed to the backend as one set, so a backend that can latch
+ * every channel at once gives truly simultaneous joint motion. Only called
+ * from the servo task.
+ */
+class ServoOutput {
+public:
+    ServoOutput();
+    virtual ~ServoOutput() = default;
+
+    virtual bool attach(int channel, int pin) = 0;
+    virtual void detach(int channel) = 0;
+    virtual bool isAttached(int channel) = 0;
+    virtual const char* getName() = 0;
+
+    // Updates every channel in one go (fractional degrees; skipped if nothing changed)
+    void writeAngles(const float* angles);
+
+    // Stops the pulses on every channel and forgets their widths, so re-attached
+    // channels all get written on the next write
+    void cutOutput();
+    uint16_t getPulseWidth(int channel);
+
+    static uint16_t angleToPulseWidth(float angle);
+
+protected:
+    // Backend hook: make all channels output their new pulse width together
+    virtual void latchPulseWidths(const uint16_t* widths) = 0;
+
+    uint16_t pulseWidths[SERVO_OUTPUT_CHANNELS];
+    bool outputValid;
+};
+
+// =============================================================================
+// ESP32SERVO (LEDC) BACKEND
+// =============================================================================
+
+/**
+ * ESP32Servo library output. Channels are written one after another, so a
+ * simultaneous move can start up to one PWM frame apart between joints.
+ */
+class ESP32ServoOutput : public ServoOutput {
+public:
+    bool attach(int channel, int pin) override;
+    void detach(int channel) override;
+    bool isAttached(int channel) override;
+    const char* getName() override;
+
+protected:
+    void latchPulseWidths(const uint16_t* widths) override;
+
+private:
+    Servo servos[SERVO_OUTPUT_CHANNELS];
+};
+
+// =============================================================================
+// MCPWM BACKEND
+// =============================================================================
+
+/**
+ * MCPWM unit 0 output, one timer per channel. Timers 1 and 2 are synced to
+ * timer 0 so every period starts together, and compare updates are held
+ * until all channels are written, so new pulse widths always take effect on
+ * the same PWM frame.
+ */
+class MCPWMServoOutput : public ServoOutput {
+public:
+    MCPWMServoOutput();
+
+    bool attach(int channel, int pin) override;
+    void detach(int channel) override;
+    bool isAttached(int channel) override;
+    const char* getName() override;
+
+protected:
+    void latchPulseWidths(const uint16_t* widths) override;
+
+private:
+    bool attached[SERVO_OUTPUT_CHANNELS];
+    portMUX_TYPE latchLock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#include "SmoothnessEstimator.h"
+#include <math.h>
+
+SmoothnessEstimator::SmoothnessEstimator() {
+    reset();
+}
+
+void SmoothnessEstimator::reset() {
+    hasPosition = false;
+    lastAngle = 0.0f;
+    lastPositionTime = 0;
+    velocityCount = 0;
+    lastVelocity = 0.0f;
+    lastAcceleration = 0.0f;
+    firstVelocityTime = 0;
+    lastVelocityTime = 0;
+    lastInterval = 0;
+    filterInput[0] = filterInput[1] = 0.0f;
+    filterOutput[0] = filterOutput[1] = 0.0f;
+    filterB0 = filterB1 = filterA1 = filterA2 = 0.0f;
+    filterInterval = 0;
+    jerkIntegral = 0.0f;
+    peakSpeed = 0.0f;
+}
+
+// =============================================================================
+// SAMPLES
+// =============================================================================
+
+void SmoothnessEstimator::addPosition(float angle, unsigned long timestamp) {
+    if (hasPosition) {
+        unsigned long interval = timestamp - lastPositionTime;
+        if (interval == 0) return;
+
+        addVelocity((angle - lastAngle) * 1000.0f / interval, timestamp);
+    }
+
+    hasPosition = true;
+    lastAngle = angle;
+    lastPositionTime = timestamp;
+}
+
+void SmoothnessEstimator::addVelocity(float velocity, unsigned long timestamp) {
+    if (velocityCount == 0) {
+        lastVelocity = velocity;
+        firstVelocityTime = timestamp;
+        lastVelocityTime = timestamp;
+        peakSpeed = fabsf(velocity);
+        velocityCount = 1;
+
+        // Start the filter settled on the first sample
+        filterInput[0] = filterInput[1] = velocity;
+        filterOutput[0] = filterOutput[1] = velocity;
+        return;
+    }
+
+    unsigned long interval = timestamp - lastVelocityTime;
+    if (interval == 0) return;
+
+    // Jerk amplifies noise by f^2, so a first-order roll-off still leaves the
+    // double difference of gyro noise dominating slow movements
+    float dt = interval / 1000.0f;
+    float filtered = filterVelocity(velocity, interval);
+    float acceleration = (filtered - lastVelocity) / dt;
+
+    if (velocityCount >= 2) {
+        // Accelerations sit at interval midpoints, so jerk spans the mean interval
+        float span = (interval + lastInterval) / 2000.0f;
+        float jerk = (acceleration - lastAcceleration) / span;
+        jerkIntegral += jerk * jerk * span;
+    }
+
+    lastVelocity = filtered;
+    lastAcceleration = acceleration;
+    lastVelocityTime = timestamp;
+    lastInterval = interval;
+    peakSpeed = fmaxf(peakSpeed, fabsf(filtered));
+    if (velocityCount < UINT16_MAX) velocityCount++;
+}
+
+// Second-order Butterworth, by the bilinear transform at the sample interval
+float SmoothnessEstimator::filterVelocity(float velocity, unsigned long interval) {
+    if (interval != filterInterval) {
+        float k = tanf((float)M_PI * VELOCITY_CUTOFF_HZ * interval / 1000.0f);
+        float norm = 1.0f / (1.0f + (float)M_SQRT2 * k + k * k);
+        filterB0 = k * k * norm;
+        filterB1 = 2.0f * filterB0;
+        filterA1 = 2.0f * (k * k - 1.0f) * norm;
+        filterA2 = (1.0f - (float)M_SQRT2 * k + k * k) * norm;
+        filterInterval = interval;
+    }
+
+    float filtered = filterB0 * (velocity + filterInput[1]) + filterB1 * filterInput[0] -
+                     filterA1 * filterOutput[0] - filterA2 * filterOutput[1];
+    filterInput[1] = filterInput[0];
+    filterInput[0] = velocity;
+    filterOutput[1] = filterOutput[0];
+    filterOutput[0] = filtered;
+    return filtered;
+}
+
+// =============================================================================
+// RESULT
+// =============================================================================
+
+bool SmoothnessEstimator::hasResult() const {
+    return velocityCount >= MIN_VELOCITY_SAMPLES && peakSpeed >= MIN_PEAK_SPEED &&
+           lastVelocityTime != firstVelocityTime;
+}
+
+float SmoothnessEstimator::getLogDimensionlessJerk() const {
+    if (!hasResult()) return 0.0f;
+
+    float duration = (lastVelocityTime - firstVelocityTime) / 1000.0f;
+    float dimensionlessJerk = duration * duration * duration / (peakSpeed * peakSpeed) * jerkIntegral;
+
+    // Sampled and filtered, a clean profile can come out below the continuous minimum
+    return -logf(fmaxf(dimensionlessJerk, MINIMUM_JERK_DLJ));
+}
+
+float SmoothnessEstimator::getScore() const {
+    if (!hasResult()) return 0.0f;
+
+    float excess = -getLogDimensionlessJerk() - logf(MINIMUM_JERK_DLJ);
+    return constrain(100.0f - SCORE_PER_LOG_UNIT * excess, 0.0f, 100.0f);
+}
+
+uint16_t SmoothnessEstimator::getSampleCount() const {
+    return velocityCount;
+}
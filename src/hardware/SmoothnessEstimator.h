@@ -0,0 +1,73 @@
+#ifndef SMOOTHNESS_ESTIMATOR_H
+#define SMOOTHNESS_ESTIMATOR_H
+
+#include <Arduino.h>
+
+// =============================================================================
+// SMOOTHNESS ESTIMATOR
+// =============================================================================
+
+/**
+ * Streaming jerk-based smoothness of one joint movement.
+ *
+ * Samples (joint angle or angular velocity) are low-pass filtered and
+ * differentiated on arrival; only the squared-jerk integral, the peak speed
+ * and the last few values are kept, so memory is fixed however long the
+ * movement runs. The result is the dimensionless jerk
+ *
+ *     DLJ = T^3 / v_peak^2 * integral(jerk^2 dt)
+ *
+ * which is independent of amplitude and duration. A minimum-jerk movement
+ * scores 100; every factor e above its DLJ costs SCORE_PER_LOG_UNIT points.
+ * Not thread-safe - one task feeds it.
+ */
+class SmoothnessEstimator {
+public:
+    SmoothnessEstimator();
+
+    void reset();
+
+    // Samples in time order; timestamps in ms
+    void addPosition(float angle, unsigned long timestamp);      // degrees
+    void addVelocity(float velocity, unsigned long timestamp);   // deg/s
+
+    // Result of the samples so far
+    bool hasResult() const;  // Enough samples and actual motion
+    float getScore() const;  // 0-100, 100 = minimum-jerk
+    float getLogDimensionlessJerk() const;
+    uint16_t getSampleCount() const;
+
+private:
+    float filterVelocity(float velocity, unsigned long interval);
+
+    // Position differencing
+    bool hasPosition;
+    float lastAngle;
+    unsigned long lastPositionTime;
+
+    // Velocity -> acceleration -> jerk
+    uint16_t velocityCount;
+    float lastVelocity;
+    float lastAcceleration;
+    unsigned long firstVelocityTime;
+    unsigned long lastVelocityTime;
+    unsigned long lastInterval;
+
+    // Second-order low-pass - recent inputs and outputs, coefficients for filterInterval
+    float filterInput[2];
+    float filterOutput[2];
+    float filterB0, filterB1, filterA1, filterA2;  // b2 == b0
+    unsigned long filterInterval;
+
+    // Accumulators
+    float jerkIntegral;  // deg^2/s^5
+    float peakSpeed;     // deg/s
+
+    static constexpr float VELOCITY_CUTOFF_HZ = 4.0f;     // Above a 500 ms minimum-jerk movement, below sensor noise
+    static constexpr float MIN_PEAK_SPEED = 1.0f;         // deg/s - slower is holding still
+    static constexpr float MINIMUM_JERK_DLJ = 204.8f;     // 720 / 1.875^2 for a minimum-jerk profile
+    static constexpr float SCORE_PER_LOG_UNIT = 20.0f;
+    static const uint16_t MIN_VELOCITY_SAMPLES = 4;       // Two jerk values
+};
+
+#endif
@@ -3,6 +3,11 @@
 #include "../utils/Logger.h"
 #include "../utils/ErrorHandler.h"
 #include "../utils/TimeManager.h"
+#include "ResourceProfiler.h"
+#if !SYSTEM_MONITOR_RUN_TIME_STATS
+#include <esp_freertos_hooks.h>
+#include <esp_timer.h>
+#endif
 
 void SystemMonitor::initialize() {
     if (initialized) return;
@@ -23,6 +28,31 @@ void SystemMonitor::initialize() {
     loopCount = 0;
     maxLoopTimeRecorded = 0;
     minFreeHeapRecorded = ESP.getFreeHeap();
+
+    // Initialize CPU accounting
+    lastCpuSampleTime = 0;
+    cpuWindow = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        coreLoad[core] = -1.0f;
+    }
+    taskUsageCount = 0;
+    minStackHeadroom = 0;
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+    previousCount = 0;
+    previousTotalRunTime = 0;
+#else
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        idleTaskHandles[core] = xTaskGetIdleTaskHandleForCPU(core);
+        previousIdleMicros[core] = 0;
+    }
+    idleHooksRegistered = esp_register_freertos_idle_hook_for_cpu(idleHookCore0, 0) == ESP_OK &&
+                          esp_register_freertos_idle_hook_for_cpu(idleHookCore1, 1) == ESP_OK &&
+                          esp_register_freertos_tick_hook_for_cpu(tickHookCore0, 0) == ESP_OK &&
+                          esp_register_freertos_tick_hook_for_cpu(tickHookCore1, 1) == ESP_OK;
+    if (!idleHooksRegistered) {
+        Logger::warning("CPU load: idle hooks not registered, core load unavailable");
+    }
+#endif
     
     // Initialize network status
     wifiConnected = false;
@@ -235,7 +265,7 @@ void SystemMonitor::publishStatusUpdate() {
         statusCallback(currentMetrics);
     }
     
-    Logger::debugf("System Status - Health: %s, Memory: %.1f%%, Uptime: %s", 
+    LOG_DEBUGF("System Status - Health: %s, Memory: %.1f%%, Uptime: %s", 
                   getHealthMessage().c_str(), 
                   getMemoryUsagePercent(), 
                   getUptimeString().c_str());
@@ -266,6 +296,15 @@ void SystemMonitor::checkSystemAlerts() {
     if (currentMetrics.averageLoopTime > loopTimeThreshold) {
         logPerformanceWarning();
     }
+
+    // Headroom is logged, not escalated - a busy core is still a working one
+    bool coreSaturated = false;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (coreLoad[core] > CPU_LOAD_WARNING_PERCENT) coreSaturated = true;
+    }
+    if (coreSaturated || (taskUsageCount > 0 && minStackHeadroom < TASK_STACK_HEADROOM_WARNING)) {
+        logCpuHeadroomWarning();
+    }
 }
 
 void SystemMonitor::setAlertCallback(void (*callback)(SystemHealth health, const String& message)) {
@@ -311,6 +350,229 @@ void SystemMonitor::updatePerformanceMetrics() {
     currentMetrics.loopCount = loopCount;
     currentMetrics.averageLoopTime = getAverageLoopTime();
     currentMetrics.maxLoopTime = maxLoopTimeRecorded;
+
+    sampleCpuUsage();
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        currentMetrics.coreLoad[core] = coreLoad[core];
+    }
+    currentMetrics.taskCount = taskUsageCount;
+    currentMetrics.minStackHeadroom = minStackHeadroom;
+}
+
+// =============================================================================
+// CPU AND TASK MONITORING
+// =============================================================================
+
+#if !SYSTEM_MONITOR_RUN_TIME_STATS
+std::atomic<uint32_t> SystemMonitor::idleMicros[portNUM_PROCESSORS];
+int64_t SystemMonitor::idleSince[portNUM_PROCESSORS];
+TaskHandle_t SystemMonitor::idleTaskHandles[portNUM_PROCESSORS];
+portMUX_TYPE SystemMonitor::idleLock = portMUX_INITIALIZER_UNLOCKED;
+
+// The idle task calls its hook once per pass, then waits for an interrupt
+// (returning true lets it). Without a tickless idle the tick interrupt ends
+// every wait, so an idle stretch runs from one hook call to the next unless
+// a tick finds another task running first - tick-driven work, which is most
+// of it, is never counted as idle. Work woken by another interrupt and done
+// before the next tick is the one thing counted as idle.
+bool SystemMonitor::idleHookCore0() {
+    markIdle(0);
+    return true;
+}
+
+bool SystemMonitor::idleHookCore1() {
+    markIdle(1);
+    return true;
+}
+
+void IRAM_ATTR SystemMonitor::tickHookCore0() {
+    markTick(0);
+}
+
+void IRAM_ATTR SystemMonitor::tickHookCore1() {
+    markTick(1);
+}
+
+void SystemMonitor::markIdle(int core) {
+    portENTER_CRITICAL(&idleLock);
+    int64_t now = esp_timer_get_time();
+    if (idleSince[core] != 0) {
+        idleMicros[core].fetch_add((uint32_t)(now - idleSince[core]), std::memory_order_relaxed);
+    }
+    idleSince[core] = now;
+    portEXIT_CRITICAL(&idleLock);
+}
+
+// From the tick interrupt on that core, before any task it woke runs
+void IRAM_ATTR SystemMonitor::markTick(int core) {
+    portENTER_CRITICAL_ISR(&idleLock);
+    if (idleSince[core] != 0) {
+        if (xTaskGetCurrentTaskHandleForCPU(core) == idleTaskHandles[core]) {
+            int64_t now = esp_timer_get_time();
+            idleMicros[core].fetch_add((uint32_t)(now - idleSince[core]), std::memory_order_relaxed);
+        }
+        // The next stretch starts at the idle task's next pass
+        idleSince[core] = 0;
+    }
+    portEXIT_CRITICAL_ISR(&idleLock);
+}
+
+void SystemMonitor::updateCoreLoadFromIdleHooks(unsigned long elapsed) {
+    if (!idleHooksRegistered) return;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        uint32_t micros = idleMicros[core].load(std::memory_order_relaxed);
+        float idle = (float)(micros - previousIdleMicros[core]) / (elapsed * 1000.0f);
+        previousIdleMicros[core] = micros;
+        coreLoad[core] = constrain(100.0f * (1.0f - idle), 0.0f, 100.0f);
+    }
+}
+#endif
+
+void SystemMonitor::sampleCpuUsage() {
+    unsigned long now = millis();
+    unsigned long elapsed = now - lastCpuSampleTime;
+    if (lastCpuSampleTime != 0 && elapsed < CPU_MONITOR_WINDOW_MS) return;
+
+#if !SYSTEM_MONITOR_RUN_TIME_STATS
+    bool firstSample = lastCpuSampleTime == 0;
+#endif
+    lastCpuSampleTime = now;
+
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+    uint32_t totalRunTime = 0;
+#endif
+    UBaseType_t count = 0;
+#if configUSE_TRACE_FACILITY
+    // Fails (returns 0) if more tasks exist than the array holds
+    uint32_t runTime = 0;
+    count = uxTaskGetSystemState(taskStatus, CPU_MONITOR_MAX_TASKS, &runTime);
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+    totalRunTime = runTime;
+#endif
+    if (count == 0) {
+        Logger::warningf("CPU load: %u tasks exceed CPU_MONITOR_MAX_TASKS (%u)",
+                         (unsigned)uxTaskGetNumberOfTasks(), (unsigned)CPU_MONITOR_MAX_TASKS);
+    }
+#endif
+
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+    // Run-time counters tick on the same clock as the total (esp_timer or
+    // CPU cycles), so a task's share of one core is its delta over the total's.
+    // The first window runs from boot.
+    uint32_t window = totalRunTime - previousTotalRunTime;
+    previousTotalRunTime = totalRunTime;
+    cpuWindow = elapsed;
+#else
+    if (firstSample) {
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            previousIdleMicros[core] = idleMicros[core].load();
+        }
+    } else {
+        updateCoreLoadFromIdleHooks(elapsed);
+        cpuWindow = elapsed;
+    }
+#endif
+
+    TaskHandle_t idleTasks[portNUM_PROCESSORS];
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        idleTasks[core] = xTaskGetIdleTaskHandleForCPU(core);
+    }
+
+    taskUsageCount = 0;
+    minStackHeadroom = UINT32_MAX;
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t& status = taskStatus[i];
+
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+        uint32_t previous = 0;  // A task created during the window started at 0
+        for (uint8_t j = 0; j < previousCount; j++) {
+            if (previousHandles[j] == status.xHandle) {
+                previous = previousRunTime[j];
+                break;
+            }
+        }
+        float cpuPercent = window > 0 ? 100.0f * (float)(status.ulRunTimeCounter - previous) / window : 0.0f;
+#else
+        float cpuPercent = -1.0f;
+#endif
+
+        // Idle tasks are reported as their core's load, not as task rows
+        bool idleTask = false;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            if (status.xHandle != idleTasks[core]) continue;
+            idleTask = true;
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+            coreLoad[core] = constrain(100.0f - cpuPercent, 0.0f, 100.0f);
+#endif
+        }
+        if (idleTask) continue;
+
+        TaskCpuUsage& usage = taskUsage[taskUsageCount++];
+        strncpy(usage.name, status.pcTaskName, sizeof(usage.name) - 1);
+        usage.name[sizeof(usage.name) - 1] = '\0';
+        BaseType_t affinity = xTaskGetAffinity(status.xHandle);
+        usage.core = affinity == tskNO_AFFINITY ? -1 : (int8_t)affinity;
+        usage.priority = (uint8_t)status.uxCurrentPriority;
+        usage.cpuPercent = cpuPercent;
+        usage.stackHeadroom = status.usStackHighWaterMark;  // Bytes - ESP32 stacks are byte-addressed
+        ResourceProfiler::recordTaskHeadroom(usage.name, usage.stackHeadroom);
+
+        if (usage.stackHeadroom < minStackHeadroom) minStackHeadroom = usage.stackHeadroom;
+    }
+
+    if (taskUsageCount == 0) minStackHeadroom = 0;
+
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+    previousCount = (uint8_t)count;
+    for (UBaseType_t i = 0; i < count; i++) {
+        previousHandles[i] = taskStatus[i].xHandle;
+        previousRunTime[i] = taskStatus[i].ulRunTimeCounter;
+    }
+#endif
+
+    sortTaskUsage();
+}
+
+void SystemMonitor::sortTaskUsage() {
+    // Insertion sort - a few dozen rows, already mostly in order between windows
+    for (uint8_t i = 1; i < taskUsageCount; i++) {
+        TaskCpuUsage row = taskUsage[i];
+        int j = i - 1;
+        while (j >= 0 && (taskUsage[j].cpuPercent < row.cpuPercent ||
+                          (taskUsage[j].cpuPercent == row.cpuPercent &&
+                           taskUsage[j].stackHeadroom > row.stackHeadroom))) {
+            taskUsage[j + 1] = taskUsage[j];
+            j--;
+        }
+        taskUsage[j + 1] = row;
+    }
+}
+
+float SystemMonitor::getCoreLoad(int core) {
+    if (core < 0 || core >= portNUM_PROCESSORS) return -1.0f;
+    return coreLoad[core];
+}
+
+unsigned long SystemMonitor::getCpuWindow() {
+    return cpuWindow;
+}
+
+bool SystemMonitor::hasPerTaskCpu() {
+    return SYSTEM_MONITOR_RUN_TIME_STATS;
+}
+
+const TaskCpuUsage* SystemMonitor::getTaskUsage() {
+    return taskUsage;
+}
+
+uint8_t SystemMonitor::getTaskUsageCount() {
+    return taskUsageCount;
+}
+
+uint32_t SystemMonitor::getMinStackHeadroom() {
+    return minStackHeadroom;
 }
 
 void SystemMonitor::logSystemStatus() {
@@ -319,6 +581,8 @@ void SystemMonitor::logSystemStatus() {
     Logger::infof("  CPU: %d MHz", getCpuFrequency());
     Logger::infof("  Memory: %d bytes free (%.1f%% used)", 
                  currentMetrics.freeHeap, getMemoryUsagePercent());
+    Logger::infof("  CPU Load: core 0 %.1f%%, core 1 %.1f%% (%u tasks, min stack headroom %u bytes)",
+                 coreLoad[0], coreLoad[1], taskUsageCount, minStackHeadroom);
     Logger::infof("  Uptime: %s", getUptimeString().c_str());
     Logger::infof("  Health: %s", getHealthMessage().c_str());
 }
@@ -349,6 +613,25 @@ void SystemMonitor::logPerformanceWarning() {
     }
 }
 
+void SystemMonitor::logCpuHeadroomWarning() {
+    static unsigned long lastWarning = 0;
+    unsigned long now = millis();
+    
+    // Limit warning frequency to once per minute
+    if (now - lastWarning > 60000) {
+        const char* tightestTask = "";
+        for (uint8_t i = 0; i < taskUsageCount; i++) {
+            if (taskUsage[i].stackHeadroom == minStackHeadroom) {
+                tightestTask = taskUsage[i].name;
+                break;
+            }
+        }
+        Logger::warningf("CPU headroom low: core 0 %.1f%%, core 1 %.1f%%, tightest stack %s (%u bytes free)",
+                        coreLoad[0], coreLoad[1], tightestTask, minStackHeadroom);
+        lastWarning = now;
+    }
+}
+
 void SystemMonitor::notifyAlert(SystemHealth health, const String& message) {
     if (alertCallback) {
         alertCallback(health, message);
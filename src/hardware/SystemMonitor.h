@@ -2,6 +2,18 @@
 #define SYSTEM_MONITOR_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config/Config.h"
+
+// Per-task CPU share needs FreeRTOS run-time stats; without them core load
+// comes from idle-hook timing and tasks report stack headroom only
+#if defined(configGENERATE_RUN_TIME_STATS) && configGENERATE_RUN_TIME_STATS == 1
+#define SYSTEM_MONITOR_RUN_TIME_STATS 1
+#else
+#define SYSTEM_MONITOR_RUN_TIME_STATS 0
+#endif
 
 enum class SystemHealth {
     EXCELLENT,
@@ -35,11 +47,25 @@ struct SystemMetrics {
     unsigned long averageLoopTime;
     unsigned long maxLoopTime;
 
+    // CPU metrics (over the last sample window)
+    float coreLoad[portNUM_PROCESSORS];  // Percent busy, -1 until measured
+    uint8_t taskCount;
+    uint32_t minStackHeadroom;           // Bytes, tightest task
+
     // Health assessment
     SystemHealth overallHealth;
     String healthMessage;
 };
 
+// One FreeRTOS task over the last sample window
+struct TaskCpuUsage {
+    char name[configMAX_TASK_NAME_LEN];
+    int8_t core;             // Pinned core, -1 if it runs on either
+    uint8_t priority;
+    float cpuPercent;        // Of one core; -1 without run-time stats
+    uint32_t stackHeadroom;  // Bytes of stack never used (high-water mark)
+};
+
 class SystemMonitor {
 public:
     // Initialization and lifecycle
@@ -67,6 +93,15 @@ public:
     unsigned long getMaxLoopTime();
     unsigned long getLoopCount();
 
+    // CPU and task monitoring - a new window at most every CPU_MONITOR_WINDOW_MS
+    void sampleCpuUsage();
+    float getCoreLoad(int core);
+    unsigned long getCpuWindow();                // ms covered by the current figures
+    bool hasPerTaskCpu();                        // False without run-time stats
+    const TaskCpuUsage* getTaskUsage();          // Sorted by CPU share, then stack headroom
+    uint8_t getTaskUsageCount();
+    uint32_t getMinStackHeadroom();
+
     // System information
     unsigned long getUptime();
     String getUptimeString();
@@ -107,6 +142,39 @@ private:
     unsigned long loopCount;
     unsigned long maxLoopTimeRecorded;
 
+    // CPU accounting
+    unsigned long lastCpuSampleTime;
+    unsigned long cpuWindow;
+    float coreLoad[portNUM_PROCESSORS];
+    TaskCpuUsage taskUsage[CPU_MONITOR_MAX_TASKS];
+    uint8_t taskUsageCount;
+    uint32_t minStackHeadroom;
+    TaskStatus_t taskStatus[CPU_MONITOR_MAX_TASKS];  // uxTaskGetSystemState output
+
+#if SYSTEM_MONITOR_RUN_TIME_STATS
+    // Run-time counters at the previous sample, matched by handle
+    TaskHandle_t previousHandles[CPU_MONITOR_MAX_TASKS];
+    uint32_t previousRunTime[CPU_MONITOR_MAX_TASKS];
+    uint8_t previousCount;
+    uint32_t previousTotalRunTime;
+#else
+    // Idle and tick hooks time each core's idle stretches in microseconds
+    static std::atomic<uint32_t> idleMicros[portNUM_PROCESSORS];
+    static int64_t idleSince[portNUM_PROCESSORS];  // 0 = idle task not known to be idle
+    static TaskHandle_t idleTaskHandles[portNUM_PROCESSORS];
+    static portMUX_TYPE idleLock;
+    uint32_t previousIdleMicros[portNUM_PROCESSORS];
+    bool idleHooksRegistered;
+
+    static bool idleHookCore0();
+    static bool idleHookCore1();
+    static void tickHookCore0();
+    static void tickHookCore1();
+    static void markIdle(int core);
+    static void markTick(int core);
+    void updateCoreLoadFromIdleHooks(unsigned long elapsed);
+#endif
+
     // Network status
     bool wifiConnected;
     bool mqttConnected;
@@ -125,11 +193,13 @@ private:
     void assessMemoryHealth();
     void assessPerformanceHealth();
     void assessNetworkHealth();
+    void sortTaskUsage();
 
     // Logging and notifications
     void logSystemStatus();
     void logMemoryWarning();
     void logPerformanceWarning();
+    void logCpuHeadroomWarning();
     void notifyAlert(SystemHealth health, const String& message);
 
     // Configuration constants
@@ -0,0 +1,277 @@
+#include "TaskTracer.h"
+#include "../utils/Logger.h"
+
+// Static member definitions
+TaskTracer::TaskSlot TaskTracer::slots[TASK_TRACE_MAX_TASKS];
+uint8_t TaskTracer::slotCount = 0;
+portMUX_TYPE TaskTracer::registerLock = portMUX_INITIALIZER_UNLOCKED;
+unsigned long TaskTracer::windowStartTime = 0;
+
+// =============================================================================
+// REGISTRATION
+// =============================================================================
+
+TraceId TaskTracer::registerTask(const char* name, uint32_t periodUs) {
+    if (!TASK_TRACE_ENABLED || !name) return TRACE_ID_NONE;
+
+    TraceId id = TRACE_ID_NONE;
+
+    portENTER_CRITICAL(&registerLock);
+    for (uint8_t i = 0; i < slotCount; i++) {
+        if (strncmp(slots[i].name, name, sizeof(slots[i].name) - 1) == 0) {
+            id = i;
+            break;
+        }
+    }
+
+    if (id == TRACE_ID_NONE && slotCount < TASK_TRACE_MAX_TASKS) {
+        TaskSlot& slot = slots[slotCount];
+        memset(&slot, 0, sizeof(slot));
+        strncpy(slot.name, name, sizeof(slot.name) - 1);
+        slot.periodUs = periodUs;
+        slot.lateThresholdUs = periodUs + (periodUs / 100) * TASK_TRACE_DEADLINE_TOLERANCE_PERCENT;
+        id = slotCount++;
+    }
+    portEXIT_CRITICAL(&registerLock);
+
+    if (id == TRACE_ID_NONE) {
+        Logger::warningf("Task tracer full - %s is not traced", name);
+    } else {
+        slots[id].lastActivationUs = 0;  // Restarted tasks must not count the gap
+        LOG_DEBUGF("Tracing task %s (period %lu us)", name, periodUs);
+    }
+
+    return id;
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+int64_t TaskTracer::begin(TraceId id) {
+    int64_t now = esp_timer_get_time();
+    if (!isValid(id)) return now;
+
+    TaskSlot& slot = slots[id];
+    if (slot.periodUs > 0 && slot.lastActivationUs > 0) {
+        uint32_t interval = (uint32_t)(now - slot.lastActivationUs);
+        if (interval > slot.lateThresholdUs) {
+            slot.deadlineMisses++;
+
+            uint32_t lateness = interval - slot.periodUs;
+            if (lateness > slot.maxLatenessUs) {
+                slot.maxLatenessUs = lateness;
+            }
+        }
+    }
+    slot.lastActivationUs = now;
+
+    return now;
+}
+
+void TaskTracer::end(TraceId id, int64_t startUs) {
+    if (!isValid(id)) return;
+    record(id, (uint32_t)(esp_timer_get_time() - startUs));
+}
+
+void TaskTracer::record(TraceId id, uint32_t durationUs) {
+    if (!isValid(id)) return;
+
+    TaskSlot& slot = slots[id];
+    slot.buckets[bucketIndex(durationUs)]++;
+    slot.executions++;
+
+    if (durationUs > slot.maxUs) {
+        slot.maxUs = durationUs;
+    }
+}
+
+void TaskTracer::resetPeriod(TraceId id) {
+    if (!isValid(id)) return;
+    slots[id].lastActivationUs = 0;
+}
+
+// =============================================================================
+// REPORTING
+// =============================================================================
+
+uint8_t TaskTracer::getTaskCount() {
+    return slotCount;
+}
+
+bool TaskTracer::getSummary(TraceId id, TaskSummary& summary) {
+    if (!isValid(id)) return false;
+
+    const TaskSlot& slot = slots[id];
+    summary.name = slot.name;
+    summary.periodUs = slot.periodUs;
+    summary.executions = slot.executions;
+    summary.deadlineMisses = slot.deadlineMisses;
+    summary.p50Us = percentile(slot, 50);
+    summary.p99Us = percentile(slot, 99);
+    summary.maxUs = slot.maxUs;
+    summary.maxLatenessUs = slot.maxLatenessUs;
+    return true;
+}
+
+uint32_t TaskTracer::getTotalDeadlineMisses() {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < slotCount; i++) {
+        total += slots[i].deadlineMisses;
+    }
+    return total;
+}
+
+void TaskTracer::logStatistics() {
+    if (slotCount == 0) return;
+
+    Logger::infof("Task trace (%lu s window):", (millis() - windowStartTime) / 1000);
+
+    TaskSummary summary;
+    for (uint8_t i = 0; i < slotCount; i++) {
+        if (!getSummary(i, summary) || summary.executions == 0) continue;
+
+        Logger::infof("  %-12s n=%lu p50=%lu p99=%lu max=%lu us, missed=%lu (worst +%lu us)",
+                     summary.name, summary.executions, summary.p50Us, summary.p99Us,
+                     summary.maxUs, summary.deadlineMisses, summary.maxLatenessUs);
+    }
+}
+
+void TaskTracer::reset() {
+    // Owners may be recording concurrently - at worst one sample survives the reset
+    for (uint8_t i = 0; i < slotCount; i++) {
+        TaskSlot& slot = slots[i];
+        slot.executions = 0;
+        slot.deadlineMisses = 0;
+        slot.maxUs = 0;
+        slot.maxLatenessUs = 0;
+        memset(slot.buckets, 0, sizeof(slot.buckets));
+    }
+    windowStartTime = millis();
+}
+
+// =============================================================================
+// BINARY DUMP
+// =============================================================================
+
+size_t TaskTracer::serialize(uint8_t* buffer, size_t size) {
+    if (!buffer || size < sizeof(TaskTraceFrameHeader)) return 0;
+
+    TaskTraceFrameHeader header = {};
+    header.magic[0] = TASK_TRACE_FRAME_MAGIC_0;
+    header.magic[1] = TASK_TRACE_FRAME_MAGIC_1;
+    header.version = TASK_TRACE_FRAME_VERSION;
+    header.uptimeMs = millis();
+    header.windowMs = header.uptimeMs - windowStartTime;
+
+    size_t length = sizeof(header);
+
+    for (uint8_t i = 0; i < slotCount; i++) {
+        const TaskSlot& slot = slots[i];
+
+        // Snapshot the buckets first so the record and its pairs agree
+        uint32_t buckets[TASK_TRACE_BUCKET_COUNT];
+        memcpy(buckets, slot.buckets, sizeof(buckets));
+
+        uint8_t bucketCount = 0;
+        for (uint8_t b = 0; b < TASK_TRACE_BUCKET_COUNT; b++) {
+            if (buckets[b] > 0) bucketCount++;
+        }
+
+        size_t entrySize = sizeof(TaskTraceRecord) + bucketCount * sizeof(TaskTraceBucket);
+        if (length + entrySize > size) break;  // Frame full - remaining tasks are left out
+
+        TaskTraceRecord record = {};
+        strncpy(record.name, slot.name, sizeof(record.name));
+        record.periodUs = slot.periodUs;
+        record.executions = slot.executions;
+        record.deadlineMisses = slot.deadlineMisses;
+        record.p50Us = percentile(slot, 50);
+        record.p99Us = percentile(slot, 99);
+        record.maxUs = slot.maxUs;
+        record.maxLatenessUs = slot.maxLatenessUs;
+        record.bucketCount = bucketCount;
+        memcpy(buffer + length, &record, sizeof(record));
+        length += sizeof(record);
+
+        for (uint8_t b = 0; b < TASK_TRACE_BUCKET_COUNT; b++) {
+            if (buckets[b] == 0) continue;
+
+            TaskTraceBucket pair;
+            pair.index = b;
+            pair.count = buckets[b];
+            memcpy(buffer + length, &pair, sizeof(pair));
+            length += sizeof(pair);
+        }
+
+        header.taskCount++;
+    }
+
+    memcpy(buffer, &header, sizeof(header));
+    return length;
+}
+
+void TaskTracer::dumpToSerial() {
+    static uint8_t frame[MAX_MQTT_MESSAGE_SIZE];
+
+    size_t length = serialize(frame, sizeof(frame));
+    if (length == 0) return;
+
+    // Hex lines between markers, so the dump can be cut out of a console log
+    Serial.printf("TRACE BEGIN %u\n", (unsigned)length);
+    for (size_t offset = 0; offset < length; offset += SERIAL_BYTES_PER_LINE) {
+        Serial.print("TRACE ");
+        size_t lineEnd = min(length, offset + SERIAL_BYTES_PER_LINE);
+        for (size_t i = offset; i < lineEnd; i++) {
+            Serial.printf("%02x", frame[i]);
+        }
+        Serial.print("\n");
+    }
+    Serial.print("TRACE END\n");
+}
+
+// =============================================================================
+// HISTOGRAM HELPERS
+// =============================================================================
+
+uint8_t TaskTracer::bucketIndex(uint32_t us) {
+    if (us < 2) return us;
+
+    // Two buckets per power of two: [2^e, 1.5 * 2^e) and [1.5 * 2^e, 2^(e+1))
+    uint8_t exponent = 31 - __builtin_clz(us);
+    uint8_t index = exponent * 2 + ((us >> (exponent - 1)) & 1);
+    return index < TASK_TRACE_BUCKET_COUNT ? index : TASK_TRACE_BUCKET_COUNT - 1;
+}
+
+uint32_t TaskTracer::bucketLowerBound(uint8_t index) {
+    if (index < 2) return index;
+
+    uint8_t exponent = index / 2;
+    return (1UL << exponent) + (index & 1) * (1UL << (exponent - 1));
+}
+
+bool TaskTracer::isValid(TraceId id) {
+    return TASK_TRACE_ENABLED && id >= 0 && id < slotCount;
+}
+
+uint32_t TaskTracer::percentile(const TaskSlot& slot, uint8_t percent) {
+    uint32_t total = 0;
+    for (uint8_t b = 0; b < TASK_TRACE_BUCKET_COUNT; b++) {
+        total += slot.buckets[b];
+    }
+    if (total == 0) return 0;
+
+    // Smallest bucket holding the requested rank, reported by its upper edge
+    uint32_t rank = (uint32_t)(((uint64_t)total * percent + 99) / 100);
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < TASK_TRACE_BUCKET_COUNT; b++) {
+        seen += slot.buckets[b];
+        if (seen >= rank) {
+            if (b + 1 >= TASK_TRACE_BUCKET_COUNT) return slot.maxUs;
+            uint32_t upper = bucketLowerBound(b + 1) - 1;
+            return upper < slot.maxUs ? upper : slot.maxUs;
+        }
+    }
+
+    return slot.maxUs;
+}
@@ -0,0 +1,154 @@
+#ifndef TASK_TRACER_H
+#define TASK_TRACER_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include "../config/Config.h"
+
+// =============================================================================
+// TASK TRACE FRAME LAYOUT
+// =============================================================================
+
+/**
+ * Compact binary dump published on TOPIC_PERFORMANCE_TRACE and printed as
+ * hex lines on serial by TaskTracer::dumpToSerial() (the 'trace' serial
+ * debug command).
+ *
+ * A frame is a TaskTraceFrameHeader followed by taskCount variable-length
+ * task entries: a TaskTraceRecord and then bucketCount TaskTraceBucket
+ * pairs for the non-empty histogram buckets. All fields are little-endian.
+ * Bucket index i covers TaskTracer::bucketLowerBound(i) up to the next
+ * bucket's lower bound, in microseconds.
+ */
+
+const uint8_t TASK_TRACE_FRAME_MAGIC_0 = 'T';
+const uint8_t TASK_TRACE_FRAME_MAGIC_1 = 'T';
+const uint8_t TASK_TRACE_FRAME_VERSION = 1;
+
+struct __attribute__((packed)) TaskTraceFrameHeader {
+    uint8_t magic[2];        // 'T', 'T'
+    uint8_t version;         // TASK_TRACE_FRAME_VERSION
+    uint8_t taskCount;       // Task entries that follow (may be fewer than traced if the buffer is full)
+    uint32_t uptimeMs;       // millis() when the frame was built
+    uint32_t windowMs;       // Time covered since the histograms were last reset
+};
+
+struct __attribute__((packed)) TaskTraceRecord {
+    char name[12];           // Zero padded
+    uint32_t periodUs;       // Intended activation period, 0 if not periodic
+    uint32_t executions;
+    uint32_t deadlineMisses;
+    uint32_t p50Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+    uint32_t maxLatenessUs;  // Worst activation delay past the period
+    uint8_t bucketCount;     // TaskTraceBucket entries that follow
+};
+
+struct __attribute__((packed)) TaskTraceBucket {
+    uint8_t index;
+    uint32_t count;
+};
+
+typedef int8_t TraceId;
+const TraceId TRACE_ID_NONE = -1;
+
+// =============================================================================
+// TASK TRACER
+// =============================================================================
+
+/**
+ * Hot-path execution tracing for the FreeRTOS task loops.
+ *
+ * A task registers once and gets a TraceId, then wraps each loop iteration
+ * in a ScopedTimer. Execution times go into a per-task histogram with two
+ * buckets per power of two (1us resolution from esp_timer_get_time), from
+ * which p50/p99 are read. For periodic tasks every activation is checked
+ * against the intended period and counted as a deadline miss when it comes
+ * later than TASK_TRACE_DEADLINE_TOLERANCE_PERCENT past it.
+ *
+ * Recording is lock-free: each slot is written only by its own task and
+ * readers take unsynchronised snapshots, so a report may be off by the
+ * sample being recorded at that instant.
+ */
+class TaskTracer {
+public:
+    struct TaskSummary {
+        const char* name;
+        uint32_t periodUs;
+        uint32_t executions;
+        uint32_t deadlineMisses;
+        uint32_t p50Us;
+        uint32_t p99Us;
+        uint32_t maxUs;
+        uint32_t maxLatenessUs;
+    };
+
+    /**
+     * Times one loop iteration of a registered task. Construct it at the
+     * top of the iteration; the destructor records the execution time.
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(TraceId id) : id(id), startUs(TaskTracer::begin(id)) {}
+        ~ScopedTimer() { TaskTracer::end(id, startUs); }
+
+    private:
+        ScopedTimer(const ScopedTimer&);
+        ScopedTimer& operator=(const ScopedTimer&);
+
+        TraceId id;
+        int64_t startUs;
+    };
+
+    // Registration - call once from the task. A name that is already
+    // registered gets its existing slot back (e.g. a restarted task).
+    static TraceId registerTask(const char* name, uint32_t periodUs = 0);
+
+    // Recording (from the owning task only)
+    static int64_t begin(TraceId id);
+    static void end(TraceId id, int64_t startUs);
+    static void record(TraceId id, uint32_t durationUs);  // Timed elsewhere, no deadline check
+    static void resetPeriod(TraceId id);                  // Call after an intentional idle wait
+
+    // Reporting
+    static uint8_t getTaskCount();
+    static bool getSummary(TraceId id, TaskSummary& summary);
+    static uint32_t getTotalDeadlineMisses();
+    static void logStatistics();
+    static void reset();
+
+    // Binary dump (TaskTraceFrameHeader layout), returns bytes written
+    static size_t serialize(uint8_t* buffer, size_t size);
+    static void dumpToSerial();
+
+    // Histogram bucket helpers
+    static uint8_t bucketIndex(uint32_t us);
+    static uint32_t bucketLowerBound(uint8_t index);
+
+private:
+    struct TaskSlot {
+        char name[12];
+        uint32_t periodUs;
+        uint32_t lateThresholdUs;
+        int64_t lastActivationUs;  // 0 until the first activation after a reset
+        uint32_t executions;
+        uint32_t deadlineMisses;
+        uint32_t maxUs;
+        uint32_t maxLatenessUs;
+        uint32_t buckets[TASK_TRACE_BUCKET_COUNT];
+    };
+
+    static TaskSlot slots[TASK_TRACE_MAX_TASKS];
+    static uint8_t slotCount;
+    static portMUX_TYPE registerLock;
+    static unsigned long windowStartTime;
+
+    static bool isValid(TraceId id);
+    static uint32_t percentile(const TaskSlot& slot, uint8_t percent);
+
+    static const uint8_t SERIAL_BYTES_PER_LINE = 48;
+};
+
+#endif
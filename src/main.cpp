@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "app/DeviceManager.h"
 #include "utils/Logger.h"
+#include "hardware/ResourceProfiler.h"
 #include "config/Config.h"
 
 // Global device manager instance
@@ -12,10 +13,13 @@ unsigned long lastLoopTime = 0;
 void setup() {
     // Initialize serial communication
     Serial.begin(SERIAL_BAUD_RATE);
-    while (!Serial && millis() < 3000) {
+    while (!Serial && millis() < SERIAL_HOST_WAIT_MS) {
         vTaskDelay(pdMS_TO_TICKS(10));  // FreeRTOS delay
     }
 
+    // Stack and queue sizes for this boot - before the logger starts the first task
+    ResourceProfiler::initialize();
+
     // Initialize logger first
     Logger::initialize(LogLevel::INFO);
 
@@ -32,19 +36,24 @@ void setup() {
         Logger::info("=== System Ready ===");
         Logger::info("Device is ready to accept commands");
         Logger::info("Available interfaces: BLE, WiFi/MQTT");
-        Logger::info("Send commands: 0 (home), 1 (sequential), 2 (simultaneous)");
+        Logger::info("Send commands: 0 (home), 1 (sequential), 2 (simultaneous), 3-5 (tapping, grasp, wave)");
     } else {
         Logger::error("=== System Initialization Failed ===");
         Logger::error("Check configuration and hardware connections");
     }
 
+    // Serial debug commands are read on the DeviceManager task when bytes arrive
+    Serial.onReceive([]() {
+        deviceManager.onSerialReceive();
+    });
+
     lastLoopTime = millis();
 }
 
 void loop() {
     // ✅ PURE FREERTOS ARCHITECTURE
-    // Main loop is now minimal - all work done by FreeRTOS tasks:
-    // - DeviceManager Task (Core 1, Priority 3) - System coordination
+    // Main loop has nothing left to do - all work done by FreeRTOS tasks:
+    // - DeviceManager Task (Core 1, Priority 3) - Event-driven coordination, serial commands
     // - WiFiManager Task (Core 0, Priority 5) - Network connectivity
     // - MQTTManager Tasks (Core 0, Priority 4) - Data publishing
     // - BLEManager Task (Core 0, Priority 3) - Mobile connectivity
@@ -53,30 +62,6 @@ void loop() {
     // - PulseMonitor Task (Core 1, Priority 4) - Health monitoring
     // - SessionAnalytics Task (Core 1, Priority 2) - Data processing
 
-    // Handle serial debugging only (minimal for development)
-    if (Serial.available()) {
-        String command = Serial.readStringUntil('\n');
-        command.trim();
-
-        if (command.length() > 0) {
-            Logger::infof("Serial debug: %s", command.c_str());
-
-            // Debug commands - real work done by tasks
-            if (command == "status") {
-                deviceManager.logComponentStatus();
-            } else if (command == "freertos") {
-                deviceManager.logFreeRTOSStatus();
-            } else if (command == "tasks") {
-                Logger::infof("FreeRTOS Tasks: %u", uxTaskGetNumberOfTasks());
-                Logger::infof("Free Heap: %u bytes", ESP.getFreeHeap());
-                Logger::infof("Min Free Heap: %u bytes", ESP.getMinFreeHeap());
-            } else {
-                // Pass to DeviceManager task for processing
-                deviceManager.handleCommand(command, CommandSource::SERIAL_PORT);
-            }
-        }
-    }
-
-    // FreeRTOS scheduler handles everything - main loop just sleeps
-    vTaskDelay(pdMS_TO_TICKS(1000));  // 1 second - FreeRTOS delay
+    // Serial input wakes the DeviceManager task (see setup), so the loop task can go
+    vTaskDelete(nullptr);
 }
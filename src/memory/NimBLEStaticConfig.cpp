@@ -325,7 +325,7 @@ namespace NimBLEMemoryHooks {
     
     void track_allocation(void* ptr, size_t size, const char* component) {
         if (ptr) {
-            Logger::debugf("BLE %s: allocated %d bytes at %p", component, size, ptr);
+            LOG_DEBUGF("BLE %s: allocated %d bytes at %p", component, size, ptr);
         } else {
             handle_allocation_failure(size, component);
         }
@@ -333,7 +333,7 @@ namespace NimBLEMemoryHooks {
     
     void track_deallocation(void* ptr, const char* component) {
         if (ptr) {
-            Logger::debugf("BLE %s: deallocated %p", component, ptr);
+            LOG_DEBUGF("BLE %s: deallocated %p", component, ptr);
         }
     }
     
@@ -396,7 +396,7 @@ NimBLEMemoryUsage getNimBLEMemoryUsage() {
     usage.totalAllocated = stats.usedSize;
     usage.peakUsage = stats.peakUsage;
     usage.allocationCount = stats.allocationCount;
-    usage.failureCount = 0; // Would need to track this
+    usage.failureCount = stats.failedAllocations;
     usage.isHealthy = stats.isHealthy;
     usage.efficiency = stats.freeSize > 0 ? (float)stats.usedSize / (float)stats.totalSize : 0.0f;
     
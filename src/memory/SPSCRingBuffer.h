@@ -0,0 +1,136 @@
+#ifndef SPSC_RING_BUFFER_H
+#define SPSC_RING_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// ESP32 cache line size (flash/PSRAM cache). Keeping the producer and
+// consumer indices on separate lines stops the two cores from bouncing
+// the same line when the buffer lives in cached memory.
+const size_t SPSC_CACHE_LINE_SIZE = 32;
+
+// =============================================================================
+// SINGLE-PRODUCER / SINGLE-CONSUMER RING BUFFER
+// =============================================================================
+
+/**
+ * Lock-free ring buffer for handing data from exactly one producer task to
+ * exactly one consumer task, with no critical sections or kernel calls.
+ *
+ * The producer only writes head, the consumer only writes tail; each side
+ * publishes its slot with a release store and observes the other with an
+ * acquire load. Indices run freely and wrap at 2^32, so Capacity must be a
+ * power of two and all Capacity slots are usable. When the buffer is full
+ * push() drops the new item and counts it - the producer never blocks.
+ *
+ * beginWrite()/commitWrite() and front()/popFront() let either side work on
+ * the slot in place instead of copying through a temporary.
+ */
+template <typename T, size_t Capacity>
+class SPSCRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SPSCRingBuffer capacity must be a power of two");
+
+public:
+    SPSCRingBuffer() : head(0), droppedCount(0), tail(0) {}
+
+    // -------------------------------------------------------------------------
+    // Producer side
+    // -------------------------------------------------------------------------
+
+    bool push(const T& item) {
+        T* slot = beginWrite();
+        if (!slot) return false;
+
+        *slot = item;
+        commitWrite();
+        return true;
+    }
+
+    // Returns the next free slot, or nullptr (and counts a drop) if full
+    T* beginWrite() {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - tail.load(std::memory_order_acquire) >= Capacity) {
+            droppedCount.store(droppedCount.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &slots[currentHead & MASK];
+    }
+
+    // Publishes the slot returned by beginWrite()
+    void commitWrite() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // -------------------------------------------------------------------------
+    // Consumer side
+    // -------------------------------------------------------------------------
+
+    bool pop(T& item) {
+        const T* slot = front();
+        if (!slot) return false;
+
+        item = *slot;
+        popFront();
+        return true;
+    }
+
+    // Returns the oldest item without removing it, or nullptr if empty
+    const T* front() const {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == currentTail) {
+            return nullptr;
+        }
+        return &slots[currentTail & MASK];
+    }
+
+    // Releases the slot returned by front()
+    void popFront() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Discards everything currently queued
+    void clear() {
+        tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // -------------------------------------------------------------------------
+    // Status (exact from the owning side, a snapshot from anywhere else)
+    // -------------------------------------------------------------------------
+
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const {
+        return size() == 0;
+    }
+
+    bool isFull() const {
+        return size() >= Capacity;
+    }
+
+    uint32_t getDroppedCount() const {
+        return droppedCount.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+private:
+    static const uint32_t MASK = Capacity - 1;
+
+    // Producer-owned
+    alignas(SPSC_CACHE_LINE_SIZE) std::atomic<uint32_t> head;
+    std::atomic<uint32_t> droppedCount;
+
+    // Consumer-owned
+    alignas(SPSC_CACHE_LINE_SIZE) std::atomic<uint32_t> tail;
+
+    alignas(SPSC_CACHE_LINE_SIZE) T slots[Capacity];
+};
+
+#endif
@@ -0,0 +1,272 @@
+#include "SensorDataPool.h"
+#include "../hardware/I2CManager.h"
+#include "../analytics/SessionAnalyticsManager.h"
+#include "../utils/Logger.h"
+
+// =============================================================================
+// LAYOUT CHECKS
+// =============================================================================
+
+static constexpr size_t sumBlockCounts(size_t i) {
+    return i == 0 ? 0 : SENSOR_POOL_BLOCK_COUNTS[i - 1] + sumBlockCounts(i - 1);
+}
+
+static constexpr size_t sumClassBytes(size_t i) {
+    return i == 0 ? 0 : SENSOR_POOL_BLOCK_SIZES[i - 1] * SENSOR_POOL_BLOCK_COUNTS[i - 1] + sumClassBytes(i - 1);
+}
+
+static constexpr bool classSizesValid(size_t i) {
+    return i == 0 ||
+           ((SENSOR_POOL_BLOCK_SIZES[i - 1] & (SENSOR_POOL_BLOCK_SIZES[i - 1] - 1)) == 0 &&
+            SENSOR_POOL_BLOCK_SIZES[i - 1] >= SensorDataPool::BLOCK_ALIGNMENT &&
+            (i == 1 || SENSOR_POOL_BLOCK_SIZES[i - 2] < SENSOR_POOL_BLOCK_SIZES[i - 1]) &&
+            classSizesValid(i - 1));
+}
+
+static_assert(sumBlockCounts(SENSOR_POOL_CLASS_COUNT) == SENSOR_POOL_TOTAL_BLOCKS,
+              "SENSOR_POOL_TOTAL_BLOCKS must match SENSOR_POOL_BLOCK_COUNTS");
+static_assert(sumClassBytes(SENSOR_POOL_CLASS_COUNT) <= SENSOR_DATA_POOL_SIZE,
+              "Sensor pool size classes exceed SENSOR_DATA_POOL_SIZE");
+static_assert(SENSOR_POOL_TOTAL_BLOCKS < 0xFFFE, "Block indices must fit the free-list encoding");
+static_assert(classSizesValid(SENSOR_POOL_CLASS_COUNT),
+              "Sensor pool block sizes must be ascending powers of two");
+
+// Payloads the pool is meant to carry
+static_assert(sizeof(PulseReading) <= SensorDataPool::MAX_BLOCK_SIZE, "PulseReading does not fit the sensor pool");
+static_assert(sizeof(MotionReading) <= SensorDataPool::MAX_BLOCK_SIZE, "MotionReading does not fit the sensor pool");
+static_assert(sizeof(FusedSensorData) <= SensorDataPool::MAX_BLOCK_SIZE, "FusedSensorData does not fit the sensor pool");
+static_assert(sizeof(MovementAnalytics) <= SensorDataPool::MAX_BLOCK_SIZE, "MovementAnalytics does not fit the sensor pool");
+static_assert(sizeof(SessionQualityMetrics) <= SensorDataPool::MAX_BLOCK_SIZE, "SessionQualityMetrics does not fit the sensor pool");
+static_assert(sizeof(ClinicalProgressData) <= SensorDataPool::MAX_BLOCK_SIZE, "ClinicalProgressData does not fit the sensor pool");
+
+// =============================================================================
+// STATIC MEMBER INITIALIZATION
+// =============================================================================
+
+alignas(SensorDataPool::BLOCK_ALIGNMENT) uint8_t SensorDataPool::storage[SENSOR_DATA_POOL_SIZE];
+SensorDataPool::SizeClass SensorDataPool::classes[SENSOR_POOL_CLASS_COUNT];
+std::atomic<uint32_t> SensorDataPool::links[SENSOR_POOL_TOTAL_BLOCKS];
+std::atomic<uint32_t> SensorDataPool::failedAllocations(0);
+std::atomic<uint32_t> SensorDataPool::invalidFrees(0);
+bool SensorDataPool::initialized = false;
+
+// Free-list head encoding: the tag changes on every push and pop, so a
+// head that was popped and pushed back between a reader's load and its
+// compare-exchange no longer compares equal
+static inline uint32_t packHead(uint32_t tag, uint32_t index) {
+    return (tag << 16) | (index & 0xFFFF);
+}
+
+static inline uint32_t headIndex(uint32_t head) {
+    return head & 0xFFFF;
+}
+
+static inline uint32_t nextTag(uint32_t head) {
+    return (head >> 16) + 1;
+}
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+void SensorDataPool::initialize() {
+    if (initialized) return;
+
+    memset(storage, 0, sizeof(storage));
+
+    uint8_t* base = storage;
+    uint16_t firstBlock = 0;
+
+    for (size_t c = 0; c < SENSOR_POOL_CLASS_COUNT; c++) {
+        SizeClass& sizeClass = classes[c];
+        sizeClass.base = base;
+        sizeClass.firstBlock = firstBlock;
+        sizeClass.blockCount = SENSOR_POOL_BLOCK_COUNTS[c];
+        sizeClass.blockShift = 0;
+        while (((size_t)1 << sizeClass.blockShift) < SENSOR_POOL_BLOCK_SIZES[c]) {
+            sizeClass.blockShift++;
+        }
+
+        // Thread every block onto the free list in address order
+        for (uint16_t i = 0; i < sizeClass.blockCount; i++) {
+            uint32_t next = (i + 1 < sizeClass.blockCount) ? (uint32_t)(firstBlock + i + 1) : NO_BLOCK;
+            links[firstBlock + i].store(next, std::memory_order_relaxed);
+        }
+
+        sizeClass.freeHead.store(packHead(0, sizeClass.blockCount ? firstBlock : NO_BLOCK),
+                                 std::memory_order_release);
+        sizeClass.inUse.store(0, std::memory_order_relaxed);
+        sizeClass.highWaterMark.store(0, std::memory_order_relaxed);
+        sizeClass.allocations.store(0, std::memory_order_relaxed);
+        sizeClass.exhaustedCount.store(0, std::memory_order_relaxed);
+
+        base += SENSOR_POOL_BLOCK_SIZES[c] * SENSOR_POOL_BLOCK_COUNTS[c];
+        firstBlock += sizeClass.blockCount;
+    }
+
+    failedAllocations.store(0, std::memory_order_relaxed);
+    invalidFrees.store(0, std::memory_order_relaxed);
+    initialized = true;
+
+    Logger::infof("Sensor data pool ready: %u blocks in %u size classes (%u bytes)",
+                  (unsigned)SENSOR_POOL_TOTAL_BLOCKS, (unsigned)SENSOR_POOL_CLASS_COUNT,
+                  (unsigned)sumClassBytes(SENSOR_POOL_CLASS_COUNT));
+}
+
+// =============================================================================
+// ALLOCATION
+// =============================================================================
+
+void* SensorDataPool::allocate(size_t size) {
+    if (!initialized || size == 0) return nullptr;
+
+    for (size_t c = 0; c < SENSOR_POOL_CLASS_COUNT; c++) {
+        if (size > SENSOR_POOL_BLOCK_SIZES[c]) continue;
+
+        // Smallest class that fits first, spilling upwards when it is empty
+        void* block = popBlock(classes[c]);
+        if (block) return block;
+    }
+
+    failedAllocations.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void SensorDataPool::free(void* ptr) {
+    if (!ptr) return;
+
+    int c = findClass(ptr);
+    if (c < 0) {
+        invalidFrees.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    SizeClass& sizeClass = classes[c];
+    size_t offset = (uint8_t*)ptr - sizeClass.base;
+    if (offset & (((size_t)1 << sizeClass.blockShift) - 1)) {
+        invalidFrees.fetch_add(1, std::memory_order_relaxed);  // Not the start of a block
+        return;
+    }
+
+    uint32_t index = sizeClass.firstBlock + (uint32_t)(offset >> sizeClass.blockShift);
+
+    // Claim the block back from the owner; a second free finds it already released
+    uint32_t expected = BLOCK_IN_USE;
+    if (!links[index].compare_exchange_strong(expected, NO_BLOCK, std::memory_order_acq_rel)) {
+        invalidFrees.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    pushBlock(sizeClass, index);
+}
+
+bool SensorDataPool::owns(const void* ptr) {
+    return findClass(ptr) >= 0;
+}
+
+// =============================================================================
+// FREE LISTS
+// =============================================================================
+
+void* SensorDataPool::popBlock(SizeClass& sizeClass) {
+    uint32_t head = sizeClass.freeHead.load(std::memory_order_acquire);
+
+    while (true) {
+        uint32_t index = headIndex(head);
+        if (index == NO_BLOCK) {
+            sizeClass.exhaustedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        // May be stale if another core pops this block first - the tag
+        // check in the exchange throws the value away in that case
+        uint32_t next = links[index].load(std::memory_order_acquire);
+        if (sizeClass.freeHead.compare_exchange_weak(head, packHead(nextTag(head), next),
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+            links[index].store(BLOCK_IN_USE, std::memory_order_release);
+            break;
+        }
+    }
+
+    uint32_t inUse = sizeClass.inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint32_t highWater = sizeClass.highWaterMark.load(std::memory_order_relaxed);
+    while (inUse > highWater &&
+           !sizeClass.highWaterMark.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed)) {
+    }
+    sizeClass.allocations.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t block = headIndex(head) - sizeClass.firstBlock;
+    return sizeClass.base + ((size_t)block << sizeClass.blockShift);
+}
+
+void SensorDataPool::pushBlock(SizeClass& sizeClass, uint32_t index) {
+    uint32_t head = sizeClass.freeHead.load(std::memory_order_acquire);
+
+    do {
+        links[index].store(headIndex(head), std::memory_order_relaxed);
+    } while (!sizeClass.freeHead.compare_exchange_weak(head, packHead(nextTag(head), index),
+                                                        std::memory_order_acq_rel,
+                                                        std::memory_order_acquire));
+
+    sizeClass.inUse.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int SensorDataPool::findClass(const void* ptr) {
+    const uint8_t* address = (const uint8_t*)ptr;
+    if (!initialized || address < storage || address >= storage + sizeof(storage)) return -1;
+
+    for (size_t c = 0; c < SENSOR_POOL_CLASS_COUNT; c++) {
+        const SizeClass& sizeClass = classes[c];
+        size_t classBytes = (size_t)sizeClass.blockCount << sizeClass.blockShift;
+        if (address >= sizeClass.base && address < sizeClass.base + classBytes) {
+            return (int)c;
+        }
+    }
+
+    return -1;  // Inside the unused tail of the storage
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+SensorDataPool::ClassStats SensorDataPool::getClassStats(size_t sizeClass) {
+    ClassStats stats = {};
+    if (sizeClass >= SENSOR_POOL_CLASS_COUNT) return stats;
+
+    const SizeClass& source = classes[sizeClass];
+    stats.blockSize = SENSOR_POOL_BLOCK_SIZES[sizeClass];
+    stats.blockCount = source.blockCount;
+    stats.inUse = source.inUse.load(std::memory_order_relaxed);
+    stats.highWaterMark = source.highWaterMark.load(std::memory_order_relaxed);
+    stats.allocations = source.allocations.load(std::memory_order_relaxed);
+    stats.exhaustedCount = source.exhaustedCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint32_t SensorDataPool::getFailedAllocationCount() {
+    return failedAllocations.load(std::memory_order_relaxed);
+}
+
+uint32_t SensorDataPool::getInvalidFreeCount() {
+    return invalidFrees.load(std::memory_order_relaxed);
+}
+
+void SensorDataPool::logStatistics() {
+    if (!initialized) return;
+
+    for (size_t c = 0; c < SENSOR_POOL_CLASS_COUNT; c++) {
+        ClassStats stats = getClassStats(c);
+        Logger::infof("Pool %u B: In use=%u/%u, Peak=%u, Allocs=%lu, Exhausted=%lu",
+                      stats.blockSize, stats.inUse, stats.blockCount, stats.highWaterMark,
+                      (unsigned long)stats.allocations, (unsigned long)stats.exhaustedCount);
+    }
+
+    uint32_t failed = getFailedAllocationCount();
+    uint32_t invalid = getInvalidFreeCount();
+    if (failed > 0 || invalid > 0) {
+        Logger::warningf("Sensor pool: %lu failed allocations, %lu invalid frees",
+                         (unsigned long)failed, (unsigned long)invalid);
+    }
+}
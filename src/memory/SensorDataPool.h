@@ -0,0 +1,102 @@
+#ifndef SENSOR_DATA_POOL_H
+#define SENSOR_DATA_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <new>
+#include <utility>
+#include "../config/Config.h"
+
+// =============================================================================
+// SENSOR DATA BLOCK POOL
+// =============================================================================
+
+/**
+ * Fixed-block allocator for sensor and analytics payloads.
+ *
+ * SENSOR_DATA_POOL_SIZE bytes of static storage are split into size classes
+ * (SENSOR_POOL_BLOCK_SIZES / SENSOR_POOL_BLOCK_COUNTS). Each class keeps a
+ * lock-free free list whose head carries a 16-bit tag against ABA, so
+ * allocate() and free() are O(1), never block and are safe from ISRs and
+ * from both cores. A request is served from the smallest class that fits
+ * and spills into larger classes when that one is exhausted.
+ */
+class SensorDataPool {
+public:
+    struct ClassStats {
+        uint16_t blockSize;
+        uint16_t blockCount;
+        uint16_t inUse;
+        uint16_t highWaterMark;   // Most blocks ever in use at once
+        uint32_t allocations;
+        uint32_t exhaustedCount;  // Requests that found this class empty
+    };
+
+    static void initialize();
+
+    // Safe from tasks on either core and from ISRs
+    static void* allocate(size_t size);
+    static void free(void* ptr);
+    static bool owns(const void* ptr);
+
+    // Typed helpers - construct in place and destroy back into the pool
+    template <typename T, typename... Args>
+    static T* create(Args&&... args) {
+        static_assert(sizeof(T) <= MAX_BLOCK_SIZE, "Type does not fit the largest pool block");
+        static_assert(alignof(T) <= BLOCK_ALIGNMENT, "Type needs stronger alignment than pool blocks");
+
+        void* block = allocate(sizeof(T));
+        return block ? new (block) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    template <typename T>
+    static void destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        free(object);
+    }
+
+    // Statistics
+    static ClassStats getClassStats(size_t sizeClass);
+    static uint32_t getFailedAllocationCount();
+    static uint32_t getInvalidFreeCount();
+    static void logStatistics();
+
+    static const size_t MAX_BLOCK_SIZE = SENSOR_POOL_BLOCK_SIZES[SENSOR_POOL_CLASS_COUNT - 1];
+    static const size_t BLOCK_ALIGNMENT = 8;
+
+private:
+    struct SizeClass {
+        uint8_t* base;
+        uint16_t firstBlock;   // This class's first entry in the shared link table
+        uint16_t blockCount;
+        uint8_t blockShift;    // log2(block size)
+        std::atomic<uint32_t> freeHead;  // (tag << 16) | block index
+        std::atomic<uint32_t> inUse;
+        std::atomic<uint32_t> highWaterMark;
+        std::atomic<uint32_t> allocations;
+        std::atomic<uint32_t> exhaustedCount;
+    };
+
+    alignas(BLOCK_ALIGNMENT) static uint8_t storage[SENSOR_DATA_POOL_SIZE];
+    static SizeClass classes[SENSOR_POOL_CLASS_COUNT];
+
+    // Free-list links kept outside the blocks, so a stale reader racing a
+    // pop never reads user data. Allocated blocks hold BLOCK_IN_USE, which
+    // is what lets free() reject double and foreign frees.
+    static std::atomic<uint32_t> links[SENSOR_POOL_TOTAL_BLOCKS];
+
+    static std::atomic<uint32_t> failedAllocations;
+    static std::atomic<uint32_t> invalidFrees;
+    static bool initialized;
+
+    static void* popBlock(SizeClass& sizeClass);
+    static void pushBlock(SizeClass& sizeClass, uint32_t index);
+    static int findClass(const void* ptr);
+
+    static const uint32_t NO_BLOCK = 0xFFFF;
+    static const uint32_t BLOCK_IN_USE = 0xFFFE;
+};
+
+#endif
@@ -4,37 +4,39 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <freertos/FreeRTOS.h>
+#include "TLSFHeap.h"
 
 // =============================================================================
 // STATIC BLE MEMORY POOL CONFIGURATION
 // =============================================================================
 
-// Memory pool sizes (carefully calculated for NimBLE requirements)
+// Heap size (carefully calculated for NimBLE requirements)
 #define BLE_STATIC_POOL_SIZE        8192    // 8KB total pool
-#define BLE_CONNECTION_POOL_SIZE    2048    // 2KB for connection contexts
-#define BLE_CHARACTERISTIC_POOL_SIZE 1024   // 1KB for characteristic buffers
-#define BLE_CALLBACK_POOL_SIZE      512     // 512B for callback structures
-#define BLE_EVENT_POOL_SIZE         1024    // 1KB for event queues
-#define BLE_GENERAL_POOL_SIZE       3584    // Remaining for general BLE use
 
-// Pool alignment requirements
-#define BLE_MEMORY_ALIGNMENT        4       // 4-byte alignment for ESP32
-#define BLE_MAX_ALLOCATIONS         64      // Maximum number of allocations
+// Alignment of returned blocks (TLSF payloads are 8-byte aligned)
+#define BLE_MEMORY_ALIGNMENT        TLSF_ALIGN_SIZE
 
-// Memory block header for tracking
-struct BLEMemoryBlock {
-    size_t size;
-    bool allocated;
-    uint32_t magic;     // For corruption detection
-    void* next;         // For free list management
-};
-
-#define BLE_MEMORY_MAGIC 0xBEEFCAFE
+// Trailing guard word per allocation, checked on free and realloc
+#ifndef BLE_MEMORY_GUARD_WORDS
+#define BLE_MEMORY_GUARD_WORDS      1
+#endif
 
 // =============================================================================
 // STATIC BLE MEMORY MANAGER CLASS
 // =============================================================================
 
+/**
+ * Statically allocated heap for the BLE stack, managed by a TLSF allocator
+ * (see TLSFHeap.h). Allocation and free take constant time whatever the
+ * heap state, so allocation bursts during connection setup cost the same as
+ * steady-state traffic, and freed blocks merge with their neighbours at once.
+ *
+ * Every operation runs inside a short critical section, so the functions may
+ * be called from any task. Corruption is detected per call through guard
+ * words and neighbour checks; validateIntegrity() walks the whole heap and is
+ * meant for diagnostics.
+ */
 class StaticBLEMemory {
 public:
     // Initialization and lifecycle
@@ -45,9 +47,10 @@ public:
     // Memory allocation interface
     static void* allocate(size_t size);
     static void deallocate(void* ptr);
-    static bool reallocate(void* ptr, size_t new_size);
+    static void* reallocate(void* ptr, size_t newSize);
     
-    // Pool-specific allocation (for optimization)
+    // Purpose-specific allocation, kept for callers of the former per-purpose
+    // pools. Size classes segregate blocks now, so these share the one heap.
     static void* allocateConnection(size_t size);
     static void* allocateCharacteristic(size_t size);
     static void* allocateCallback(size_t size);
@@ -57,81 +60,36 @@ public:
     static size_t getTotalSize();
     static size_t getUsedSize();
     static size_t getFreeSize();
-    static float getFragmentationRatio();
+    static size_t getLargestFreeBlock();
+    static float getFragmentationRatio();  // 0 = all free memory in one block
     static uint32_t getAllocationCount();
     static uint32_t getDeallocationCount();
+    static uint32_t getFailedAllocationCount();
+    static uint32_t getCorruptionCount();
+    static size_t getPeakUsage();
     
     // Health monitoring
     static bool isHealthy();
     static void logMemoryStatus();
     static bool validateIntegrity();
     
-    // Emergency operations
+    // Emergency operations - drops every allocation
     static void emergencyReset();
-    static bool compactMemory();
     
 private:
-    // Static memory pools (allocated at compile time)
-    static uint8_t connectionPool[BLE_CONNECTION_POOL_SIZE] __attribute__((aligned(BLE_MEMORY_ALIGNMENT)));
-    static uint8_t characteristicPool[BLE_CHARACTERISTIC_POOL_SIZE] __attribute__((aligned(BLE_MEMORY_ALIGNMENT)));
-    static uint8_t callbackPool[BLE_CALLBACK_POOL_SIZE] __attribute__((aligned(BLE_MEMORY_ALIGNMENT)));
-    static uint8_t eventPool[BLE_EVENT_POOL_SIZE] __attribute__((aligned(BLE_MEMORY_ALIGNMENT)));
-    static uint8_t generalPool[BLE_GENERAL_POOL_SIZE] __attribute__((aligned(BLE_MEMORY_ALIGNMENT)));
-    
-    // Pool management structures
-    struct PoolManager {
-        uint8_t* pool;
-        size_t size;
-        size_t used;
-        BLEMemoryBlock* freeList;
-        uint32_t allocationCount;
-        bool initialized;
-    };
-    
-    static PoolManager pools[5];  // One for each pool type
+    // Static heap region (allocated at compile time)
+    static uint8_t heapMemory[BLE_STATIC_POOL_SIZE] __attribute__((aligned(BLE_MEMORY_ALIGNMENT)));
+    static TLSFHeap heap;
+    static portMUX_TYPE heapLock;
     
     // Global state
     static bool initialized;
     static uint32_t totalAllocations;
     static uint32_t totalDeallocations;
-    static uint32_t peakUsage;
-    
-    // Internal allocation methods
-    static void* allocateFromPool(PoolManager* pool, size_t size);
-    static bool deallocateFromPool(PoolManager* pool, void* ptr);
-    static PoolManager* findPoolForPointer(void* ptr);
-    
-    // Pool initialization
-    static bool initializePool(PoolManager* pool, uint8_t* memory, size_t size);
-    static void resetPool(PoolManager* pool);
-    
-    // Memory management utilities
-    static void* alignPointer(void* ptr);
-    static size_t alignSize(size_t size);
-    static bool isValidPointer(void* ptr);
-    static bool isPointerInPool(PoolManager* pool, void* ptr);
-    
-    // Free list management
-    static void addToFreeList(PoolManager* pool, BLEMemoryBlock* block);
-    static BLEMemoryBlock* removeFromFreeList(PoolManager* pool, size_t size);
-    static void coalesceFreeBlocks(PoolManager* pool);
-    
-    // Integrity checking
-    static bool validatePool(PoolManager* pool);
-    static bool validateBlock(BLEMemoryBlock* block);
-    static void corruptionDetected(PoolManager* pool, void* ptr);
-    
-    // Pool type identification
-    enum PoolType {
-        POOL_CONNECTION = 0,
-        POOL_CHARACTERISTIC = 1,
-        POOL_CALLBACK = 2,
-        POOL_EVENT = 3,
-        POOL_GENERAL = 4
-    };
+    static uint32_t failedAllocations;
+    static size_t peakUsage;
     
-    static PoolType getOptimalPool(size_t size);
-    static const char* getPoolName(PoolType type);
+    static void recordAllocation(void* ptr, size_t size);
 };
 
 // =============================================================================
@@ -155,9 +113,11 @@ struct BLEMemoryStats {
     size_t totalSize;
     size_t usedSize;
     size_t freeSize;
+    size_t largestFreeBlock;
     float fragmentationRatio;
     uint32_t allocationCount;
     uint32_t deallocationCount;
+    uint32_t failedAllocations;
     uint32_t peakUsage;
     bool isHealthy;
     uint32_t corruptionCount;
@@ -0,0 +1,104 @@
+#include "StaticJsonAllocator.h"
+#include <string.h>
+
+// Keep blocks aligned for the 32-bit slots ArduinoJson stores in them
+static const size_t JSON_ARENA_ALIGNMENT = 4;
+
+StaticJsonAllocator::StaticJsonAllocator(uint8_t* buffer, size_t capacity)
+    : buffer(buffer), capacity(capacity), used(0), peakUsage(0),
+      lastBlock(nullptr), failureCount(0) {
+}
+
+// =============================================================================
+// ARDUINOJSON ALLOCATOR INTERFACE
+// =============================================================================
+
+void* StaticJsonAllocator::allocate(size_t size) {
+    size_t blockSize = sizeof(BlockHeader) + alignSize(size);
+
+    if (!buffer || used + blockSize > capacity) {
+        failureCount++;
+        return nullptr;  // ArduinoJson marks the document as overflowed
+    }
+
+    BlockHeader* header = (BlockHeader*)(buffer + used);
+    header->size = size;
+    lastBlock = (uint8_t*)header;
+
+    used += blockSize;
+    if (used > peakUsage) {
+        peakUsage = used;
+    }
+
+    return (uint8_t*)header + sizeof(BlockHeader);
+}
+
+void StaticJsonAllocator::deallocate(void* ptr) {
+    // Memory is reclaimed in bulk by reset()
+    (void)ptr;
+}
+
+void* StaticJsonAllocator::reallocate(void* ptr, size_t newSize) {
+    if (!ptr) {
+        return allocate(newSize);
+    }
+
+    BlockHeader* header = headerFor(ptr);
+
+    // The most recent block can grow or shrink in place
+    if ((uint8_t*)header == lastBlock) {
+        size_t blockStart = lastBlock - buffer;
+        size_t blockSize = sizeof(BlockHeader) + alignSize(newSize);
+
+        if (blockStart + blockSize > capacity) {
+            failureCount++;
+            return nullptr;
+        }
+
+        header->size = newSize;
+        used = blockStart + blockSize;
+        if (used > peakUsage) {
+            peakUsage = used;
+        }
+        return ptr;
+    }
+
+    void* newPtr = allocate(newSize);
+    if (newPtr) {
+        memcpy(newPtr, ptr, header->size < newSize ? header->size : newSize);
+    }
+    return newPtr;
+}
+
+// =============================================================================
+// ARENA MANAGEMENT
+// =============================================================================
+
+void StaticJsonAllocator::reset() {
+    used = 0;
+    lastBlock = nullptr;
+}
+
+size_t StaticJsonAllocator::getCapacity() const {
+    return capacity;
+}
+
+size_t StaticJsonAllocator::getUsedSize() const {
+    return used;
+}
+
+size_t StaticJsonAllocator::getPeakUsage() const {
+    return peakUsage;
+}
+
+uint32_t StaticJsonAllocator::getFailureCount() const {
+    return failureCount;
+}
+
+size_t StaticJsonAllocator::alignSize(size_t size) {
+    return (size + JSON_ARENA_ALIGNMENT - 1) & ~(JSON_ARENA_ALIGNMENT - 1);
+}
+
+StaticJsonAllocator::BlockHeader* StaticJsonAllocator::headerFor(void* ptr) {
+    return (BlockHeader*)((uint8_t*)ptr - sizeof(BlockHeader));
+}
@@ -0,0 +1,53 @@
+#ifndef STATIC_JSON_ALLOCATOR_H
+#define STATIC_JSON_ALLOCATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ArduinoJson.h>
+
+// =============================================================================
+// STATIC JSON ARENA ALLOCATOR
+// =============================================================================
+
+/**
+ * Bump allocator for ArduinoJson documents backed by a caller-owned buffer.
+ *
+ * A document built with this allocator never touches the heap. Memory is
+ * reclaimed all at once with reset() before the next document is built,
+ * so deallocate() is a no-op and the arena must not be shared between
+ * documents that are alive at the same time.
+ */
+class StaticJsonAllocator : public ArduinoJson::Allocator {
+public:
+    StaticJsonAllocator(uint8_t* buffer, size_t capacity);
+
+    // ArduinoJson::Allocator interface
+    void* allocate(size_t size) override;
+    void deallocate(void* ptr) override;
+    void* reallocate(void* ptr, size_t newSize) override;
+
+    // Arena management
+    void reset();
+    size_t getCapacity() const;
+    size_t getUsedSize() const;
+    size_t getPeakUsage() const;
+    uint32_t getFailureCount() const;
+
+private:
+    // Each block is preceded by its size so reallocate() can copy it
+    struct BlockHeader {
+        size_t size;
+    };
+
+    uint8_t* buffer;
+    size_t capacity;
+    size_t used;
+    size_t peakUsage;
+    uint8_t* lastBlock;    // Most recent block - can be grown in place
+    uint32_t failureCount;
+
+    static size_t alignSize(size_t size);
+    static BlockHeader* headerFor(void* ptr);
+};
+
+#endif // STATIC_JSON_ALLOCATOR_H
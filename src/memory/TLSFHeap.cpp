@@ -0,0 +1,411 @@
+#include "TLSFHeap.h"
+#include <string.h>
+
+const size_t TLSFHeap::HEADER_SIZE = offsetof(TLSFHeap::Block, nextFree);
+
+static inline int findFirstSet(uint32_t word) {
+    return __builtin_ctz(word);
+}
+
+static inline int findLastSet(uint32_t word) {
+    return 31 - __builtin_clz(word);
+}
+
+TLSFHeap::TLSFHeap()
+    : region(nullptr),
+      regionSize(0),
+      guardWords(false),
+      firstBlock(nullptr),
+      flBitmap(0),
+      capacity(0),
+      usedBytes(0),
+      freeBlockCount(0),
+      corruptionCount(0) {
+    memset(slBitmap, 0, sizeof(slBitmap));
+    memset(freeLists, 0, sizeof(freeLists));
+}
+
+// =============================================================================
+// REGION SETUP
+// =============================================================================
+
+bool TLSFHeap::initialize(void* memory, size_t size, bool guardWords) {
+    if (!memory || ((uintptr_t)memory & (TLSF_ALIGN_SIZE - 1)) != 0) return false;
+
+    // One free block and a zero-size sentinel that stops merging at the end
+    size &= ~(size_t)(TLSF_ALIGN_SIZE - 1);
+    if (size < 2 * HEADER_SIZE + MIN_PAYLOAD) return false;
+    if (size - 2 * HEADER_SIZE >= ((size_t)1 << TLSF_FL_INDEX_MAX)) return false;
+
+    region = (uint8_t*)memory;
+    regionSize = size;
+    this->guardWords = guardWords;
+    reset();
+    return true;
+}
+
+void TLSFHeap::reset() {
+    if (!region) return;
+
+    flBitmap = 0;
+    memset(slBitmap, 0, sizeof(slBitmap));
+    memset(freeLists, 0, sizeof(freeLists));
+    usedBytes = 0;
+    freeBlockCount = 0;
+    corruptionCount = 0;
+
+    capacity = regionSize - 2 * HEADER_SIZE;
+
+    firstBlock = (Block*)region;
+    firstBlock->prevPhys = nullptr;
+    firstBlock->size = (uint32_t)capacity | FLAG_FREE;
+
+    Block* sentinel = nextPhys(firstBlock);
+    sentinel->prevPhys = firstBlock;
+    sentinel->size = 0;
+
+    insertFree(firstBlock);
+}
+
+// =============================================================================
+// ALLOCATION
+// =============================================================================
+
+void* TLSFHeap::allocate(size_t size) {
+    if (!region || size == 0) return nullptr;
+
+    size_t adjusted = adjustSize(size);
+    if (adjusted > capacity) return nullptr;
+
+    int fl, sl;
+    mappingSearch(adjusted, fl, sl);
+    if (fl >= TLSF_FL_INDEX_COUNT) return nullptr;
+
+    Block* block = findSuitable(fl, sl);
+    if (!block) return nullptr;
+
+    removeFree(block);
+    split(block, adjusted);
+
+    block->size &= ~FLAG_FREE;
+    usedBytes += blockSize(block) + HEADER_SIZE;
+    writeGuard(block);
+
+    return ptrFromBlock(block);
+}
+
+bool TLSFHeap::deallocate(void* ptr) {
+    if (!ptr || !owns(ptr)) return false;
+
+    Block* block = blockFromPtr(ptr);
+    if (isFree(block) || !checkBlock(block)) {
+        corruptionCount++;
+        return false;
+    }
+
+    usedBytes -= blockSize(block) + HEADER_SIZE;
+    block->size |= FLAG_FREE;
+
+    block = mergePrev(block);
+    mergeNext(block);
+    insertFree(block);
+    return true;
+}
+
+void* TLSFHeap::reallocate(void* ptr, size_t size) {
+    if (!ptr) return allocate(size);
+    if (size == 0) {
+        deallocate(ptr);
+        return nullptr;
+    }
+    if (!owns(ptr)) return nullptr;
+
+    Block* block = blockFromPtr(ptr);
+    if (isFree(block) || !checkBlock(block)) {
+        corruptionCount++;
+        return nullptr;
+    }
+
+    size_t adjusted = adjustSize(size);
+    size_t current = blockSize(block);
+
+    // Grow in place into a free successor when it is large enough
+    Block* next = nextPhys(block);
+    if (adjusted > current && isFree(next) && current + HEADER_SIZE + blockSize(next) >= adjusted) {
+        removeFree(next);
+        block->size += (uint32_t)(HEADER_SIZE + blockSize(next));
+        nextPhys(block)->prevPhys = block;
+        usedBytes += HEADER_SIZE + blockSize(next);
+        current = blockSize(block);
+    }
+
+    if (adjusted <= current) {
+        // Give the tail back if it is worth a block of its own
+        usedBytes -= current;
+        split(block, adjusted);
+        usedBytes += blockSize(block);
+        writeGuard(block);
+        return ptr;
+    }
+
+    void* moved = allocate(size);
+    if (!moved) return nullptr;
+
+    memcpy(moved, ptr, usableSize(ptr));
+    deallocate(ptr);
+    return moved;
+}
+
+// =============================================================================
+// INSPECTION
+// =============================================================================
+
+bool TLSFHeap::owns(const void* ptr) const {
+    uintptr_t address = (uintptr_t)ptr;
+    uintptr_t start = (uintptr_t)region + HEADER_SIZE;
+    uintptr_t end = (uintptr_t)region + regionSize - HEADER_SIZE;
+    return region && address >= start && address < end &&
+           ((address - (uintptr_t)region) & (TLSF_ALIGN_SIZE - 1)) == 0;
+}
+
+size_t TLSFHeap::usableSize(const void* ptr) const {
+    if (!owns(ptr)) return 0;
+    size_t size = blockSize(blockFromPtr(ptr));
+    return guardWords ? size - GUARD_SIZE : size;
+}
+
+size_t TLSFHeap::getCapacity() const {
+    return capacity;
+}
+
+size_t TLSFHeap::getUsedBytes() const {
+    return usedBytes;
+}
+
+size_t TLSFHeap::getFreeBytes() const {
+    return capacity + HEADER_SIZE - usedBytes;
+}
+
+size_t TLSFHeap::getLargestFreeBlock() const {
+    if (flBitmap == 0) return 0;
+
+    // Only the highest non-empty class can hold the largest block
+    int fl = findLastSet(flBitmap);
+    int sl = findLastSet(slBitmap[fl]);
+
+    size_t largest = 0;
+    for (const Block* block = freeLists[fl][sl]; block; block = block->nextFree) {
+        if (blockSize(block) > largest) largest = blockSize(block);
+    }
+    return largest;
+}
+
+uint32_t TLSFHeap::getFreeBlockCount() const {
+    return freeBlockCount;
+}
+
+uint32_t TLSFHeap::getCorruptionCount() const {
+    return corruptionCount;
+}
+
+bool TLSFHeap::validate() const {
+    if (!region) return false;
+
+    size_t freeSeen = 0;
+    uint32_t freeBlocks = 0;
+    const Block* prev = nullptr;
+
+    for (const Block* block = firstBlock; ; block = nextPhys(block)) {
+        if ((const uint8_t*)block + HEADER_SIZE > region + regionSize) return false;
+        if (block->prevPhys != prev) return false;
+
+        if (blockSize(block) == 0) {
+            // Sentinel must sit exactly at the end of the region
+            return (const uint8_t*)block + HEADER_SIZE == region + regionSize &&
+                   freeBlocks == freeBlockCount &&
+                   freeSeen + usedBytes == capacity + HEADER_SIZE;
+        }
+
+        if (isFree(block)) {
+            if (prev && isFree(prev)) return false;  // Should have been merged
+            freeSeen += blockSize(block) + HEADER_SIZE;
+            freeBlocks++;
+        } else if (!checkBlock(block)) {
+            return false;
+        }
+
+        prev = block;
+    }
+}
+
+// =============================================================================
+// SIZE CLASS MAPPING
+// =============================================================================
+
+void TLSFHeap::mappingInsert(size_t size, int& fl, int& sl) {
+    if (size < TLSF_SMALL_BLOCK_SIZE) {
+        // Small sizes share first level 0 in linear steps
+        fl = 0;
+        sl = (int)size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+    } else {
+        int bit = findLastSet((uint32_t)size);
+        sl = (int)(size >> (bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ (1 << TLSF_SL_INDEX_COUNT_LOG2);
+        fl = bit - (TLSF_FL_INDEX_SHIFT - 1);
+    }
+}
+
+void TLSFHeap::mappingSearch(size_t size, int& fl, int& sl) {
+    // Round up to the next class so any block found there is big enough
+    if (size >= TLSF_SMALL_BLOCK_SIZE) {
+        size += ((size_t)1 << (findLastSet((uint32_t)size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mappingInsert(size, fl, sl);
+}
+
+TLSFHeap::Block* TLSFHeap::findSuitable(int& fl, int& sl) const {
+    uint32_t slMap = slBitmap[fl] & (~0U << sl);
+    if (!slMap) {
+        uint32_t flMap = (fl + 1 < 32) ? flBitmap & (~0U << (fl + 1)) : 0;
+        if (!flMap) return nullptr;
+
+        fl = findFirstSet(flMap);
+        slMap = slBitmap[fl];
+    }
+
+    sl = findFirstSet(slMap);
+    return freeLists[fl][sl];
+}
+
+// =============================================================================
+// FREE LISTS
+// =============================================================================
+
+void TLSFHeap::insertFree(Block* block) {
+    int fl, sl;
+    mappingInsert(blockSize(block), fl, sl);
+
+    Block* head = freeLists[fl][sl];
+    block->nextFree = head;
+    block->prevFree = nullptr;
+    if (head) head->prevFree = block;
+
+    freeLists[fl][sl] = block;
+    flBitmap |= 1U << fl;
+    slBitmap[fl] |= 1U << sl;
+    freeBlockCount++;
+}
+
+void TLSFHeap::removeFree(Block* block) {
+    int fl, sl;
+    mappingInsert(blockSize(block), fl, sl);
+
+    if (block->prevFree) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        freeLists[fl][sl] = block->nextFree;
+    }
+    if (block->nextFree) {
+        block->nextFree->prevFree = block->prevFree;
+    }
+
+    if (!freeLists[fl][sl]) {
+        slBitmap[fl] &= ~(1U << sl);
+        if (!slBitmap[fl]) {
+            flBitmap &= ~(1U << fl);
+        }
+    }
+    freeBlockCount--;
+}
+
+// =============================================================================
+// PHYSICAL NEIGHBOURS AND SPLITTING
+// =============================================================================
+
+TLSFHeap::Block* TLSFHeap::nextPhys(const Block* block) const {
+    return (Block*)((uint8_t*)block + HEADER_SIZE + blockSize(block));
+}
+
+void TLSFHeap::split(Block* block, size_t size) {
+    size_t current = blockSize(block);
+    if (current < size + HEADER_SIZE + MIN_PAYLOAD) return;
+
+    Block* remainder = (Block*)((uint8_t*)block + HEADER_SIZE + size);
+    remainder->prevPhys = block;
+    remainder->size = (uint32_t)(current - size - HEADER_SIZE) | FLAG_FREE;
+    block->size = (uint32_t)size | (block->size & FLAG_MASK);
+
+    // The successor may be free already (shrinking realloc) - keep it merged
+    mergeNext(remainder);
+    nextPhys(remainder)->prevPhys = remainder;
+    insertFree(remainder);
+}
+
+TLSFHeap::Block* TLSFHeap::mergePrev(Block* block) {
+    Block* prev = block->prevPhys;
+    if (!prev || !isFree(prev)) return block;
+
+    removeFree(prev);
+    prev->size += (uint32_t)(HEADER_SIZE + blockSize(block));
+    nextPhys(prev)->prevPhys = prev;
+    return prev;
+}
+
+void TLSFHeap::mergeNext(Block* block) {
+    Block* next = nextPhys(block);
+    if (!isFree(next)) return;
+
+    removeFree(next);
+    block->size += (uint32_t)(HEADER_SIZE + blockSize(next));
+    nextPhys(block)->prevPhys = block;
+}
+
+// =============================================================================
+// HEADERS AND GUARDS
+// =============================================================================
+
+size_t TLSFHeap::adjustSize(size_t size) const {
+    if (guardWords) size += GUARD_SIZE;
+    size = (size + TLSF_ALIGN_SIZE - 1) & ~(size_t)(TLSF_ALIGN_SIZE - 1);
+    return size < MIN_PAYLOAD ? MIN_PAYLOAD : size;
+}
+
+TLSFHeap::Block* TLSFHeap::blockFromPtr(const void* ptr) {
+    return (Block*)((const uint8_t*)ptr - HEADER_SIZE);
+}
+
+void* TLSFHeap::ptrFromBlock(const Block* block) {
+    return (uint8_t*)block + HEADER_SIZE;
+}
+
+size_t TLSFHeap::blockSize(const Block* block) {
+    return block->size & ~FLAG_MASK;
+}
+
+bool TLSFHeap::isFree(const Block* block) {
+    return (block->size & FLAG_FREE) != 0;
+}
+
+void TLSFHeap::writeGuard(Block* block) {
+    if (!guardWords) return;
+
+    uint32_t guard = TLSF_GUARD_MAGIC ^ (uint32_t)(uintptr_t)block;
+    memcpy((uint8_t*)ptrFromBlock(block) + blockSize(block) - sizeof(guard), &guard, sizeof(guard));
+}
+
+bool TLSFHeap::checkBlock(const Block* block) const {
+    // Header sanity: the size stays inside the region and both neighbours agree
+    size_t size = blockSize(block);
+    if (size < MIN_PAYLOAD || (const uint8_t*)block + 2 * HEADER_SIZE + size > region + regionSize) {
+        return false;
+    }
+    if (nextPhys(block)->prevPhys != block) return false;
+    if (block->prevPhys && nextPhys(block->prevPhys) != block) return false;
+
+    if (guardWords) {
+        uint32_t guard;
+        memcpy(&guard, (const uint8_t*)ptrFromBlock(block) + size - sizeof(guard), sizeof(guard));
+        if (guard != (TLSF_GUARD_MAGIC ^ (uint32_t)(uintptr_t)block)) return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,126 @@
+#ifndef TLSF_HEAP_H
+#define TLSF_HEAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// TLSF HEAP CONFIGURATION
+// =============================================================================
+
+// Second-level subdivisions per power of two (2^3 = 8 size classes)
+#define TLSF_SL_INDEX_COUNT_LOG2    3
+#define TLSF_ALIGN_SIZE_LOG2        3       // 8-byte aligned payloads
+#define TLSF_FL_INDEX_MAX           14      // Blocks below 2^14 = 16 KB
+
+#define TLSF_ALIGN_SIZE             (1 << TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_SL_INDEX_COUNT         (1 << TLSF_SL_INDEX_COUNT_LOG2)
+#define TLSF_FL_INDEX_SHIFT         (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_FL_INDEX_COUNT         (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+#define TLSF_SMALL_BLOCK_SIZE       (1 << TLSF_FL_INDEX_SHIFT)
+
+#define TLSF_GUARD_MAGIC            0xBEEFCAFE
+
+// =============================================================================
+// TLSF HEAP
+// =============================================================================
+
+/**
+ * Two-level segregated-fit allocator over one caller-supplied region.
+ *
+ * Free blocks are kept in TLSF_FL_INDEX_COUNT x TLSF_SL_INDEX_COUNT
+ * size-class lists. A first-level bitmap marks the non-empty powers of two
+ * and one second-level bitmap per power marks its non-empty classes, so
+ * allocate() and deallocate() find a block with two bit scans and never
+ * walk a list. Freed blocks merge with free physical neighbours at once,
+ * which keeps fragmentation bounded without a compaction pass.
+ *
+ * With guard words enabled each allocation carries a trailing guard that is
+ * checked when the block is freed or resized, and every free also checks
+ * that the neighbouring headers still agree, so overruns are caught at the
+ * offending call instead of by a heap walk. validate() still walks every
+ * block, for diagnostics only.
+ *
+ * Not thread-safe - the owner serialises access.
+ */
+class TLSFHeap {
+public:
+    TLSFHeap();
+
+    // Region setup - the region must outlive the heap
+    bool initialize(void* memory, size_t size, bool guardWords);
+    void reset();
+
+    // Allocation (all O(1) except a moving reallocate, which copies)
+    void* allocate(size_t size);
+    bool deallocate(void* ptr);   // false on an invalid or corrupted block
+    void* reallocate(void* ptr, size_t size);
+
+    // Inspection
+    bool owns(const void* ptr) const;
+    size_t usableSize(const void* ptr) const;
+    size_t getCapacity() const;   // Payload bytes when empty
+    size_t getUsedBytes() const;  // Payload and headers of allocated blocks
+    size_t getFreeBytes() const;
+    size_t getLargestFreeBlock() const;
+    uint32_t getFreeBlockCount() const;
+    uint32_t getCorruptionCount() const;
+
+    // Full heap walk - diagnostics only
+    bool validate() const;
+
+private:
+    struct Block {
+        Block* prevPhys;     // Previous block in address order, nullptr for the first
+        uint32_t size;       // Payload bytes | FLAG_* bits
+        // Free blocks only - overlays the payload
+        Block* nextFree;
+        Block* prevFree;
+    };
+
+    uint8_t* region;
+    size_t regionSize;
+    bool guardWords;
+    Block* firstBlock;
+
+    uint32_t flBitmap;
+    uint32_t slBitmap[TLSF_FL_INDEX_COUNT];
+    Block* freeLists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+    size_t capacity;
+    size_t usedBytes;
+    uint32_t freeBlockCount;
+    uint32_t corruptionCount;
+
+    // Size class mapping
+    static void mappingInsert(size_t size, int& fl, int& sl);
+    static void mappingSearch(size_t size, int& fl, int& sl);
+    Block* findSuitable(int& fl, int& sl) const;
+
+    // Free lists
+    void insertFree(Block* block);
+    void removeFree(Block* block);
+
+    // Physical neighbours and splitting
+    Block* nextPhys(const Block* block) const;
+    void split(Block* block, size_t size);
+    Block* mergePrev(Block* block);
+    void mergeNext(Block* block);
+
+    // Headers and guards
+    size_t adjustSize(size_t size) const;
+    static Block* blockFromPtr(const void* ptr);
+    static void* ptrFromBlock(const Block* block);
+    static size_t blockSize(const Block* block);
+    static bool isFree(const Block* block);
+    void writeGuard(Block* block);
+    bool checkBlock(const Block* block) const;
+
+    static const uint32_t FLAG_FREE = 0x1;
+    static const uint32_t FLAG_MASK = TLSF_ALIGN_SIZE - 1;
+    static const size_t HEADER_SIZE;       // Block up to the free list links, 8 bytes on the ESP32
+    static const size_t MIN_PAYLOAD = 2 * sizeof(void*);  // Room for the free list links
+    static const size_t GUARD_SIZE = TLSF_ALIGN_SIZE;
+};
+
+#endif // TLSF_HEAP_H
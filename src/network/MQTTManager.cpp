@@ -4,6 +4,58 @@
 #include "../utils/ErrorHandler.h"
 #include "../utils/TimeManager.h"
 #include "../hardware/FreeRTOSManager.h"
+#include "../hardware/I2CManager.h"
+#include "../hardware/ResourceProfiler.h"
+#include <lwip/sockets.h>
+#include <lwip/netdb.h>
+#include <lwip/dns.h>
+#include <lwip/tcpip.h>
+
+// Deadbands and heartbeats of the report-by-exception status topics.
+// Field order is the index passed to TelemetryDeadband::offer().
+enum SystemStatusField : uint8_t {
+    STATUS_TEXT, STATUS_FIRMWARE, STATUS_UPTIME, STATUS_FREE_HEAP, STATUS_WIFI,
+    STATUS_BLE, STATUS_STATE, STATUS_RSSI, STATUS_IP, STATUS_FIELD_COUNT
+};
+static const DeadbandField SYSTEM_STATUS_FIELDS[STATUS_FIELD_COUNT] = {
+    {"status", 0, TELEMETRY_MAX_SILENCE},
+    {"firmware_version", 0, TELEMETRY_MAX_SILENCE},
+    {"uptime_seconds", 1e9f, TELEMETRY_MAX_SILENCE},  // Always moving - heartbeat only
+    {"free_heap", 4096, TELEMETRY_MAX_SILENCE},
+    {"wifi_connected", 0, TELEMETRY_MAX_SILENCE},
+    {"ble_connected", 0, TELEMETRY_MAX_SILENCE},
+    {"current_state", 0, TELEMETRY_MAX_SILENCE},
+    {"wifi_rssi", 5, TELEMETRY_MAX_SILENCE},           // dBm
+    {"ip_address", 0, TELEMETRY_MAX_SILENCE}
+};
+
+enum TimingField : uint8_t {
+    TIMING_CURRENT, TIMING_AVERAGE, TIMING_MAX, TIMING_CORE0_LOAD, TIMING_CORE1_LOAD, TIMING_FIELD_COUNT
+};
+static const DeadbandField TIMING_FIELDS[TIMING_FIELD_COUNT] = {
+    {"current_loop_time", 2, TELEMETRY_MAX_SILENCE},   // ms
+    {"average_loop_time", 2, TELEMETRY_MAX_SILENCE},
+    {"max_loop_time", 0, TELEMETRY_MAX_SILENCE},       // A new maximum is always news
+    {"core0_load", 2.0f, TELEMETRY_MAX_SILENCE},       // Percent busy
+    {"core1_load", 2.0f, TELEMETRY_MAX_SILENCE}
+};
+
+enum MemoryField : uint8_t { MEMORY_FREE, MEMORY_MIN_FREE, MEMORY_USAGE, MEMORY_FIELD_COUNT };
+static const DeadbandField MEMORY_FIELDS[MEMORY_FIELD_COUNT] = {
+    {"free_heap", 4096, TELEMETRY_MAX_SILENCE},        // bytes
+    {"min_free_heap", 0, TELEMETRY_MAX_SILENCE},       // Low-water mark only moves on a new low
+    {"memory_usage_percent", 1.0f, TELEMETRY_MAX_SILENCE}
+};
+
+MQTTManager::MQTTManager()
+    : jsonAllocator(jsonArena, sizeof(jsonArena)),
+      stagingDoc(&jsonAllocator),
+      heartRateBatch(TelemetryFrameType::HEART_RATE),
+      movementBatch(TelemetryFrameType::MOVEMENT),
+      systemStatusDeadband(SYSTEM_STATUS_FIELDS, STATUS_FIELD_COUNT),
+      timingDeadband(TIMING_FIELDS, TIMING_FIELD_COUNT),
+      memoryDeadband(MEMORY_FIELDS, MEMORY_FIELD_COUNT) {
+}
 
 void MQTTManager::initialize() {
     if (initialized) return;
@@ -12,6 +64,20 @@ void MQTTManager::initialize() {
 
     currentStatus = MQTTStatus::DISCONNECTED;
     lastReconnectAttempt = 0;
+    connectRequested.store(false);
+    brokerSocket = -1;
+    brokerResolved = false;
+    brokerLookup.store(LOOKUP_IDLE);
+    lookupAddress.store(0);
+    nextAttemptTime = 0;
+    retryDelay = 0;
+    consecutiveFailures = 0;
+    lastTcpConnectLatency = 0;
+    lastConnectLatency = 0;
+    maxConnectLatency = 0;
+    connectLatencyTotal = 0;
+    connectSuccessCount = 0;
+    connectFailureCount = 0;
     connectionStartTime = 0;
     connectedTime = 0;
     reconnectionCount = 0;
@@ -19,16 +85,27 @@ void MQTTManager::initialize() {
     publishCount = 0;
     failedPublishCount = 0;
     lastPublishTime = 0;
+    droppedMessageCount = 0;
+    telemetryBatching = TELEMETRY_BATCH_ENABLED;
     connectionCallback = nullptr;
     publisherTaskHandle = nullptr;
     subscriberTaskHandle = nullptr;
     tasksRunning = false;
 
+    stagingMutex = xSemaphoreCreateMutex();
+    if (!stagingMutex) {
+        Logger::error("Failed to create MQTT staging mutex - publishing will be synchronous");
+    }
+
     mqttClient.setClient(wifiClient);
     mqttClient.setServer(MQTT_SERVER, MQTT_PORT);
     mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
     mqttClient.setKeepAlive(60);  // 60 second keep-alive
-    mqttClient.setSocketTimeout(30);  // 30 second socket timeout
+    mqttClient.setSocketTimeout(MQTT_SOCKET_TIMEOUT);  // Bounds the CONNACK wait and packet reads
+
+    // Suffix from the factory MAC keeps boards sharing a DEVICE_ID apart
+    uint64_t mac = ESP.getEfuseMac();
+    snprintf(clientId, sizeof(clientId), "%s_%06X", DEVICE_ID, (unsigned int)((mac >> 24) & 0xFFFFFF));
 
     initialized = true;
 
@@ -47,19 +124,8 @@ void MQTTManager::update() {
         mqttClient.loop();
     }
 
+    runConnectionStateMachine();
     handleConnectionEvents();
-    updateConnectionStatus();
-
-    // Handle reconnection logic
-    if ((currentStatus == MQTTStatus::DISCONNECTED ||
-         currentStatus == MQTTStatus::CONNECTION_FAILED) &&
-        WiFi.status() == WL_CONNECTED) {
-
-        unsigned long now = millis();
-        if (now - lastReconnectAttempt >= MQTT_RECONNECT_INTERVAL) {
-            attemptConnection();
-        }
-    }
 }
 
 bool MQTTManager::isConnected() {
@@ -77,33 +143,35 @@ void MQTTManager::disconnect() {
     notifyConnectionChange(false);
 }
 
+void MQTTManager::requestConnection() {
+    connectRequested.store(true);
+}
+
 void MQTTManager::reconnect() {
     Logger::info("Manual MQTT reconnection requested");
     disconnect();
-    delay(1000);
-    attemptConnection();
+    requestConnection();
 }
 
-bool MQTTManager::publishMovementCommand(const String& command, unsigned long responseTime, bool bleConnected, const String& sessionId) {
+bool MQTTManager::publishMovementCommand(const char* command, unsigned long responseTime, bool bleConnected, const char* sessionId) {
     if (!isConnected()) {
         REPORT_WARNING(ErrorCode::MQTT_CONNECTION_FAILED, "Cannot publish - MQTT not connected");
         return false;
     }
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "movement_command";
+    if (!beginMessage("movement_command")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["command"] = command;
     data["response_time_ms"] = responseTime;
     data["ble_connected"] = bleConnected;
-    if (sessionId.length() > 0) {
+    if (sessionId && sessionId[0]) {
         data["session_id"] = sessionId;
     }
 
-    bool success = publishJSON(TOPIC_MOVEMENT_COMMAND, doc);
+    bool success = commitMessage(TOPIC_MOVEMENT_COMMAND, false, MQTT_PRIORITY_HIGH);
     if (success) {
-        Logger::infof("Published movement command: %s (Session: %s)", command.c_str(), sessionId.c_str());
+        Logger::infof("Published movement command: %s (Session: %s)", command, sessionId ? sessionId : "");
     }
 
     return success;
@@ -117,23 +185,24 @@ bool MQTTManager::publishSystemStatus(const String& status, const String& firmwa
         return false;  // Don't log warning for system status - too frequent
     }
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "system_status";
-
-    JsonObject data = doc["data"].to<JsonObject>();
-    data["status"] = status;
-    data["firmware_version"] = firmwareVersion;
-    data["uptime_seconds"] = uptime;
-    data["free_heap"] = freeHeap;
-    data["wifi_connected"] = wifiConnected;
-    data["ble_connected"] = bleConnected;
-    data["current_state"] = currentState;
-    data["wifi_rssi"] = wifiRssi;
-    data["ip_address"] = ipAddress;
-
-    bool success = publishJSON(TOPIC_SYSTEM_STATUS, doc);
+    if (!beginMessage("system_status")) return false;
+    beginDeltaReport(systemStatusDeadband);
+
+    TelemetryDeadband& report = systemStatusDeadband;
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    if (report.offerText(STATUS_TEXT, status.c_str())) data["status"] = status;
+    if (report.offerText(STATUS_FIRMWARE, firmwareVersion.c_str())) data["firmware_version"] = firmwareVersion;
+    if (report.offer(STATUS_UPTIME, uptime)) data["uptime_seconds"] = uptime;
+    if (report.offer(STATUS_FREE_HEAP, freeHeap)) data["free_heap"] = freeHeap;
+    if (report.offer(STATUS_WIFI, wifiConnected)) data["wifi_connected"] = wifiConnected;
+    if (report.offer(STATUS_BLE, bleConnected)) data["ble_connected"] = bleConnected;
+    if (report.offer(STATUS_STATE, currentState)) data["current_state"] = currentState;
+    if (report.offer(STATUS_RSSI, wifiRssi)) data["wifi_rssi"] = wifiRssi;
+    if (report.offerText(STATUS_IP, ipAddress.c_str())) data["ip_address"] = ipAddress;
+
+    bool success = commitDeltaReport(report, TOPIC_SYSTEM_STATUS);
     if (success) {
-        Logger::debug("Published system status");
+        LOG_DEBUG("Published system status");
     }
 
     return success;
@@ -142,13 +211,12 @@ bool MQTTManager::publishSystemStatus(const String& status, const String& firmwa
 bool MQTTManager::publishWiFiStatus(const String& status) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "wifi_status";
+    if (!beginMessage("wifi_status")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["status"] = status;
 
-    bool success = publishJSON(TOPIC_CONNECTION_WIFI, doc);
+    bool success = commitMessage(TOPIC_CONNECTION_WIFI);
     if (success) {
         Logger::infof("Published WiFi status: %s", status.c_str());
     }
@@ -159,13 +227,12 @@ bool MQTTManager::publishWiFiStatus(const String& status) {
 bool MQTTManager::publishBLEStatus(const String& status) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "ble_status";
+    if (!beginMessage("ble_status")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["status"] = status;
 
-    bool success = publishJSON(TOPIC_CONNECTION_BLE, doc);
+    bool success = commitMessage(TOPIC_CONNECTION_BLE);
     if (success) {
         Logger::infof("Published BLE status: %s", status.c_str());
     }
@@ -174,22 +241,22 @@ bool MQTTManager::publishBLEStatus(const String& status) {
 }
 
 // Session management publishing methods
-bool MQTTManager::publishSessionStart(const String& sessionId, const String& sessionType, bool bleConnected) {
+bool MQTTManager::publishSessionStart(const String& sessionId, const String& sessionType, bool bleConnected,
+                                      bool autoStarted) {
     if (!isConnected()) {
         REPORT_WARNING(ErrorCode::MQTT_CONNECTION_FAILED, "Cannot publish session start - MQTT not connected");
         return false;
     }
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "session_start";
+    if (!beginMessage("session_start")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["session_id"] = sessionId;
     data["session_type"] = sessionType;
     data["ble_connected"] = bleConnected;
-    data["auto_started"] = true;
+    data["auto_started"] = autoStarted;
 
-    bool success = publishJSON(TOPIC_SESSION_START, doc);
+    bool success = commitMessage(TOPIC_SESSION_START, false, MQTT_PRIORITY_HIGH);
     if (success) {
         Logger::infof("Published session start: %s", sessionId.c_str());
     } else {
@@ -206,10 +273,9 @@ bool MQTTManager::publishSessionEnd(const String& sessionId, const String& sessi
         return false;
     }
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "session_end";
+    if (!beginMessage("session_end")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["session_id"] = sessionId;
     data["session_type"] = sessionType;
     data["end_reason"] = endReason;
@@ -218,7 +284,7 @@ bool MQTTManager::publishSessionEnd(const String& sessionId, const String& sessi
     data["successful_movements"] = successfulMovements;
     data["cycles_completed"] = cycles;
 
-    bool success = publishJSON(TOPIC_SESSION_END, doc);
+    bool success = commitMessage(TOPIC_SESSION_END, false, MQTT_PRIORITY_HIGH);
     if (success) {
         Logger::infof("Published session end: %s (Duration: %lu ms)", sessionId.c_str(), duration);
     } else {
@@ -234,32 +300,37 @@ bool MQTTManager::publishSessionProgress(const String& sessionId, int completedC
         return false; // Don't log warnings for progress updates
     }
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "session_progress";
+    if (!beginMessage("session_progress")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["session_id"] = sessionId;
     data["completed_cycles"] = completedCycles;
     data["total_cycles"] = totalCycles;
     data["progress_percent"] = progressPercent;
     data["movements_completed"] = movementsCompleted;
 
-    bool success = publishJSON(TOPIC_SESSION_PROGRESS, doc);
+    bool success = commitMessage(TOPIC_SESSION_PROGRESS);
     if (success) {
-        Logger::debugf("Published session progress: %s (%.1f%%)", sessionId.c_str(), progressPercent);
+        LOG_DEBUGF("Published session progress: %s (%.1f%%)", sessionId.c_str(), progressPercent);
     }
 
     return success;
 }
 
 bool MQTTManager::publish(const char* topic, const String& payload, bool retain) {
-    return publishWithRetry(topic, payload, retain);
+    return queueMessage(topic, payload, retain);
 }
 
-bool MQTTManager::publishJSON(const char* topic, const JsonDocument& doc, bool retain) {
-    String payload;
-    serializeJson(doc, payload);
-    return publishWithRetry(topic, payload, retain);
+bool MQTTManager::publishJSON(const char* topic, const JsonDocument& doc, bool retain, uint8_t priority) {
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    bool success = serializeToStaging(doc, topic) && submitStagedMessage(topic, retain, priority);
+    xSemaphoreGive(stagingMutex);
+
+    return success;
 }
 
 void MQTTManager::setConnectionCallback(void (*callback)(bool connected)) {
@@ -277,6 +348,30 @@ int MQTTManager::getReconnectionCount() {
     return reconnectionCount;
 }
 
+unsigned long MQTTManager::getLastConnectLatency() {
+    return lastConnectLatency;
+}
+
+unsigned long MQTTManager::getLastTcpConnectLatency() {
+    return lastTcpConnectLatency;
+}
+
+unsigned long MQTTManager::getAverageConnectLatency() {
+    return connectSuccessCount > 0 ? connectLatencyTotal / connectSuccessCount : 0;
+}
+
+unsigned long MQTTManager::getMaxConnectLatency() {
+    return maxConnectLatency;
+}
+
+uint32_t MQTTManager::getConnectFailureCount() {
+    return connectFailureCount;
+}
+
+unsigned long MQTTManager::getRetryDelay() {
+    return currentStatus == MQTTStatus::CONNECTED ? 0 : retryDelay;
+}
+
 int MQTTManager::getPublishCount() {
     return publishCount;
 }
@@ -289,92 +384,424 @@ unsigned long MQTTManager::getLastPublishTime() {
     return lastPublishTime;
 }
 
-void MQTTManager::attemptConnection() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Logger::warning("Cannot connect MQTT - WiFi not connected");
-        return;
+int MQTTManager::getDroppedMessageCount() {
+    return droppedMessageCount;
+}
+
+uint32_t MQTTManager::getTelemetryFrameCount() {
+    return heartRateBatch.getFramesBuilt() + movementBatch.getFramesBuilt();
+}
+
+uint32_t MQTTManager::getBatchedRecordCount() {
+    return heartRateBatch.getRecordsBatched() + movementBatch.getRecordsBatched();
+}
+
+uint32_t MQTTManager::getSuppressedStatusCount() {
+    return systemStatusDeadband.getSuppressedCount() + timingDeadband.getSuppressedCount() +
+           memoryDeadband.getSuppressedCount();
+}
+
+int MQTTManager::getQueuedMessageCount() {
+    QueueHandle_t publishQueue = FreeRTOSManager::getMQTTPublishQueue();
+    QueueHandle_t priorityQueue = FreeRTOSManager::getMQTTPriorityQueue();
+
+    int queued = 0;
+    if (publishQueue) queued += uxQueueMessagesWaiting(publishQueue);
+    if (priorityQueue) queued += uxQueueMessagesWaiting(priorityQueue);
+    return queued;
+}
+
+void MQTTManager::handleConnectionEvents() {
+    static MQTTStatus lastStatus = MQTTStatus::DISCONNECTED;
+
+    if (currentStatus != lastStatus) {
+        logConnectionStatus();
+        lastStatus = currentStatus;
     }
+}
+
+// =============================================================================
+// CONNECTION STATE MACHINE
+// =============================================================================
 
-    if (currentStatus == MQTTStatus::CONNECTING) {
-        return;  // Already attempting connection
+void MQTTManager::runConnectionStateMachine() {
+    unsigned long now = millis();
+
+    if (connectRequested.exchange(false)) {
+        // New network path (WiFi just came up or a manual reconnect) - no reason to wait
+        consecutiveFailures = 0;
+        nextAttemptTime = now;
     }
 
-    Logger::info("Attempting MQTT connection...");
+    switch (currentStatus) {
+        case MQTTStatus::CONNECTED:
+            if (!mqttClient.connected()) {
+                Logger::warningf("MQTT connection lost, rc=%d", mqttClient.state());
+
+                // Only a connection that held clears the backoff - a flapping broker keeps it growing
+                if (now - connectedTime >= MQTT_STABLE_CONNECTION_TIME) {
+                    consecutiveFailures = 0;
+                }
+                currentStatus = MQTTStatus::DISCONNECTED;
+                scheduleRetry(now);
+                notifyConnectionChange(false);
+            }
+            break;
+
+        case MQTTStatus::CONNECTING:
+            if (brokerLookup.load() != LOOKUP_IDLE) {
+                pollBrokerLookup(now);
+            } else {
+                pollTcpConnect(now);
+            }
+            break;
+
+        default:
+            if (WiFi.status() == WL_CONNECTED && (long)(now - nextAttemptTime) >= 0) {
+                beginTcpConnect(now);
+            }
+            break;
+    }
+}
 
+void MQTTManager::beginTcpConnect(unsigned long now) {
+    closeBrokerSocket();  // Left over if disconnect() interrupted the last attempt
+    brokerLookup.store(LOOKUP_IDLE);
     currentStatus = MQTTStatus::CONNECTING;
-    connectionStartTime = millis();
-    lastReconnectAttempt = millis();
+    connectionStartTime = now;
+    lastReconnectAttempt = now;
     connectionAttempts++;
 
-    String clientId = String(DEVICE_ID) + "_" + String(random(0xffff), HEX);
+    if (!brokerResolved && !startBrokerLookup()) {
+        failConnectionAttempt("broker address lookup failed");
+        return;
+    }
 
-    if (mqttClient.connect(clientId.c_str(), MQTT_USER, MQTT_PASSWORD)) {
-        Logger::info("MQTT connection successful!");
-        currentStatus = MQTTStatus::CONNECTED;
-        connectedTime = millis();
-        connectionAttempts = 0;  // Reset on successful connection
+    // Otherwise the name is still being looked up and pollBrokerLookup() opens the socket
+    if (brokerResolved) {
+        openBrokerSocket();
+    }
+}
 
-        notifyConnectionChange(true);
-    } else {
-        Logger::errorf("MQTT connection failed, rc=%d", mqttClient.state());
-        currentStatus = MQTTStatus::CONNECTION_FAILED;
+void MQTTManager::openBrokerSocket() {
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) {
+        failConnectionAttempt("no socket available");
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(MQTT_PORT);
+    address.sin_addr.s_addr = (uint32_t)brokerAddress;
+
+    // Returns at once - the handshake is polled on later ticks so an unreachable broker blocks nothing
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0 && errno != EINPROGRESS) {
+        close(fd);
+        failConnectionAttempt("TCP connect rejected");
+        return;
+    }
+
+    brokerSocket = fd;
+    Logger::infof("Attempting MQTT connection to %s:%d...", MQTT_SERVER, MQTT_PORT);
+}
 
-        if (connectionAttempts >= MAX_CONNECTION_ATTEMPTS) {
-            REPORT_ERROR(ErrorCode::MQTT_CONNECTION_FAILED,
-                        "Max MQTT connection attempts reached");
-            connectionAttempts = 0;  // Reset for next cycle
+void MQTTManager::pollBrokerLookup(unsigned long now) {
+    uint8_t state = brokerLookup.load();
+    if (state == LOOKUP_PENDING) {
+        if (now - connectionStartTime > MQTT_DNS_LOOKUP_TIMEOUT) {
+            failConnectionAttempt("broker address lookup timeout");
         }
+        return;
     }
+
+    brokerLookup.store(LOOKUP_IDLE);
+    if (state != LOOKUP_FOUND) {
+        failConnectionAttempt("broker address lookup failed");
+        return;
+    }
+
+    brokerAddress = IPAddress(lookupAddress.load());
+    brokerResolved = true;
+    LOG_DEBUGF("MQTT broker %s resolved in %lu ms", MQTT_SERVER, now - connectionStartTime);
+    openBrokerSocket();
 }
 
-void MQTTManager::handleConnectionEvents() {
-    static MQTTStatus lastStatus = MQTTStatus::DISCONNECTED;
+void MQTTManager::pollTcpConnect(unsigned long now) {
+    if (brokerSocket < 0) {
+        failConnectionAttempt("TCP connect not started");
+        return;
+    }
 
-    if (currentStatus != lastStatus) {
-        logConnectionStatus();
-        lastStatus = currentStatus;
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(brokerSocket, &writeSet);
+    struct timeval noWait = {0, 0};
+
+    int ready = select(brokerSocket + 1, nullptr, &writeSet, nullptr, &noWait);
+    if (ready == 0) {
+        if (now - connectionStartTime > MQTT_TCP_CONNECT_TIMEOUT) {
+            failConnectionAttempt("TCP connect timeout");
+        }
+        return;
     }
+
+    int socketError = 0;
+    socklen_t length = sizeof(socketError);
+    if (ready < 0 || getsockopt(brokerSocket, SOL_SOCKET, SO_ERROR, &socketError, &length) < 0 || socketError != 0) {
+        LOG_DEBUGF("MQTT TCP connect error %d", socketError);
+        failConnectionAttempt("TCP connect failed");
+        return;
+    }
+
+    lastTcpConnectLatency = now - connectionStartTime;
+    completeMqttHandshake();
 }
 
-void MQTTManager::updateConnectionStatus() {
-    if (currentStatus == MQTTStatus::CONNECTED && !mqttClient.connected()) {
-        Logger::warning("MQTT connection lost");
-        currentStatus = MQTTStatus::DISCONNECTED;
-        notifyConnectionChange(false);
+void MQTTManager::completeMqttHandshake() {
+    // WiFiClient expects a blocking socket and owns (and closes) it from here
+    int fd = brokerSocket;
+    brokerSocket = -1;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) & ~O_NONBLOCK);
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    wifiClient = WiFiClient(fd);
+
+    // PubSubClient skips its own TCP connect on a connected client, so this only
+    // exchanges CONNECT/CONNACK, bounded by MQTT_SOCKET_TIMEOUT. Clean session off:
+    // the broker keeps QoS1 subscriptions and queued messages for this client ID.
+    bool connected = false;
+    SemaphoreHandle_t clientMutex = FreeRTOSManager::getMQTTClientMutex();
+    if (!clientMutex || xSemaphoreTake(clientMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        connected = mqttClient.connect(clientId, MQTT_USER, MQTT_PASSWORD, nullptr, 0, false, nullptr, false);
+        if (clientMutex) xSemaphoreGive(clientMutex);
     }
 
-    if (currentStatus == MQTTStatus::CONNECTING) {
-        // Check for connection timeout
-        if (millis() - connectionStartTime > CONNECTION_TIMEOUT) {
-            Logger::error("MQTT connection timeout");
-            currentStatus = MQTTStatus::CONNECTION_FAILED;
-        }
+    if (!connected) {
+        Logger::errorf("MQTT handshake failed, rc=%d", mqttClient.state());
+        wifiClient.stop();
+        failConnectionAttempt("MQTT handshake failed");
+        return;
+    }
+
+    unsigned long now = millis();
+    lastConnectLatency = now - connectionStartTime;
+    if (lastConnectLatency > maxConnectLatency) maxConnectLatency = lastConnectLatency;
+    connectLatencyTotal += lastConnectLatency;
+    connectSuccessCount++;
+
+    Logger::infof("MQTT connection successful in %lu ms (TCP %lu ms)", lastConnectLatency, lastTcpConnectLatency);
+
+    // The bridge may have restarted or missed deltas while we were away
+    systemStatusDeadband.invalidate();
+    timingDeadband.invalidate();
+    memoryDeadband.invalidate();
+    currentStatus = MQTTStatus::CONNECTED;
+    connectedTime = now;
+    connectionAttempts = 0;  // Reset on successful connection
+
+    notifyConnectionChange(true);
+}
+
+void MQTTManager::failConnectionAttempt(const char* reason) {
+    closeBrokerSocket();
+    brokerLookup.store(LOOKUP_IDLE);  // A late DNS answer finds no lookup pending and is ignored
+
+    // A failed lookup retries by itself; a resolved address is kept across TCP
+    // failures and only looked up again once they persist, in case the broker moved
+    consecutiveFailures++;
+    if (consecutiveFailures % MQTT_RERESOLVE_FAILURES == 0) {
+        brokerResolved = false;
+    }
+    connectFailureCount++;
+    currentStatus = MQTTStatus::CONNECTION_FAILED;
+    scheduleRetry(millis());
+
+    Logger::warningf("MQTT connection failed: %s (retry in %lu ms)", reason, retryDelay);
+
+    if (connectionAttempts >= MAX_CONNECTION_ATTEMPTS) {
+        REPORT_ERROR(ErrorCode::MQTT_CONNECTION_FAILED,
+                    "Max MQTT connection attempts reached");
+        connectionAttempts = 0;  // Reset for next cycle
+    }
+}
+
+void MQTTManager::scheduleRetry(unsigned long now) {
+    int exponent = consecutiveFailures < MAX_BACKOFF_EXPONENT ? consecutiveFailures : MAX_BACKOFF_EXPONENT;
+    unsigned long backoff = MQTT_RECONNECT_INTERVAL << exponent;
+    if (backoff > MQTT_RECONNECT_MAX_INTERVAL) backoff = MQTT_RECONNECT_MAX_INTERVAL;
+
+    // Equal jitter: half fixed, half random, so devices dropped together do not retry together
+    retryDelay = backoff / 2 + random(backoff / 2 + 1);
+    nextAttemptTime = now + retryDelay;
+}
+
+void MQTTManager::closeBrokerSocket() {
+    if (brokerSocket >= 0) {
+        close(brokerSocket);
+        brokerSocket = -1;
+    }
+}
+
+// dns_gethostbyname() must run on the lwIP tcpip thread; it only queues the query there
+struct BrokerLookupCall {
+    struct tcpip_api_call_data call;  // First member: tcpip_api_call() hands this pointer back
+    const char* hostname;
+    ip_addr_t address;
+    dns_found_callback found;
+    void* arg;
+};
+
+static err_t brokerLookupOnTcpip(struct tcpip_api_call_data* data) {
+    BrokerLookupCall* lookup = reinterpret_cast<BrokerLookupCall*>(data);
+    return dns_gethostbyname(lookup->hostname, &lookup->address, lookup->found, lookup->arg);
+}
+
+bool MQTTManager::startBrokerLookup() {
+    // Numeric addresses need no lookup; a name is resolved once and kept (see failConnectionAttempt)
+    if (brokerAddress.fromString(MQTT_SERVER)) {
+        brokerResolved = true;
+        return true;
+    }
+
+    brokerLookup.store(LOOKUP_PENDING);
+
+    BrokerLookupCall lookup;
+    memset(&lookup, 0, sizeof(lookup));
+    lookup.hostname = MQTT_SERVER;
+    lookup.found = &MQTTManager::onBrokerLookup;
+    lookup.arg = this;
+
+    err_t result = tcpip_api_call(brokerLookupOnTcpip, &lookup.call);
+    if (result == ERR_OK) {
+        // Answered from the lwIP DNS cache - no callback follows
+        brokerLookup.store(LOOKUP_IDLE);
+        brokerAddress = IPAddress(ip4_addr_get_u32(ip_2_ip4(&lookup.address)));
+        brokerResolved = true;
+        return true;
+    }
+    if (result != ERR_INPROGRESS) {
+        brokerLookup.store(LOOKUP_IDLE);
+        return false;
+    }
+    return true;
+}
+
+void MQTTManager::onBrokerLookup(const char* name, const ip_addr_t* address, void* arg) {
+    MQTTManager* manager = static_cast<MQTTManager*>(arg);
+    if (address) {
+        manager->lookupAddress.store(ip4_addr_get_u32(ip_2_ip4(address)));
+    }
+
+    // Only completes the lookup still waited on - one abandoned after a timeout stays ignored
+    uint8_t expected = LOOKUP_PENDING;
+    manager->brokerLookup.compare_exchange_strong(expected, address ? LOOKUP_FOUND : LOOKUP_FAILED);
+}
+
+// =============================================================================
+// ZERO-ALLOCATION MESSAGE BUILDING
+// =============================================================================
+
+bool MQTTManager::beginMessage(const char* eventType, unsigned long timestamp) {
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    // Recycle the arena used by the previous message - no heap involved
+    stagingDoc.clear();
+    jsonAllocator.reset();
+
+    if (eventType) {
+        stagingDoc["device_id"] = DEVICE_ID;
+        stagingDoc["timestamp"] = timestamp ? timestamp : TimeManager::getCurrentTimestamp();
+        stagingDoc["event_type"] = eventType;
+    }
+
+    return true;
+}
+
+bool MQTTManager::commitMessage(const char* topic, bool retain, uint8_t priority) {
+    // stagingMutex is held since beginMessage()
+    bool success = false;
+
+    if (stagingDoc.overflowed()) {
+        Logger::warningf("MQTT message for %s exceeds JSON arena (%u bytes)",
+                        topic, jsonAllocator.getCapacity());
+        failedPublishCount++;
+    } else if (serializeToStaging(stagingDoc, topic)) {
+        success = submitStagedMessage(topic, retain, priority);
+    }
+
+    xSemaphoreGive(stagingMutex);
+    return success;
+}
+
+void MQTTManager::beginDeltaReport(TelemetryDeadband& report) {
+    if (!TELEMETRY_DELTA_ENABLED) report.invalidate();  // Every report full, as before
+    report.beginReport(millis());
+}
+
+bool MQTTManager::commitDeltaReport(TelemetryDeadband& report, const char* topic) {
+    // stagingMutex is held since beginMessage()
+    if (report.getChangedCount() == 0) {
+        // Nothing outside its deadband and no heartbeat due - nothing to send
+        report.commit();
+        xSemaphoreGive(stagingMutex);
+        return true;
     }
+
+    // The bridge merges deltas into the last full state of this topic
+    if (!report.isFullReport()) {
+        stagingDoc["delta"] = true;
+    }
+
+    bool success = commitMessage(topic, false, MQTT_PRIORITY_LOW);
+    if (success) report.commit();
+    return success;
 }
 
-JsonDocument MQTTManager::createBaseDocument() {
-    JsonDocument doc;
-    doc["device_id"] = DEVICE_ID;
-    doc["timestamp"] = TimeManager::getCurrentTimestamp();
-    doc["data"] = JsonObject();
-    return doc;
+bool MQTTManager::serializeToStaging(const JsonDocument& doc, const char* topic) {
+    // Serialize straight into the queue slot - no intermediate String
+    size_t length = serializeJson(doc, stagingMessage.payload, sizeof(stagingMessage.payload));
+
+    if (length == 0 || length >= sizeof(stagingMessage.payload) - 1) {
+        Logger::warningf("MQTT payload too large to queue for %s", topic);
+        failedPublishCount++;
+        return false;
+    }
+
+    stagingMessage.payloadLength = length;
+    return true;
 }
 
-bool MQTTManager::publishWithRetry(const char* topic, const String& payload, bool retain) {
+bool MQTTManager::publishWithRetry(const char* topic, const uint8_t* payload, size_t length, bool retain) {
     if (!isConnected()) {
         failedPublishCount++;
         return false;
     }
 
+    SemaphoreHandle_t clientMutex = FreeRTOSManager::getMQTTClientMutex();
+
     for (int attempt = 0; attempt < PUBLISH_RETRY_COUNT; attempt++) {
-        if (mqttClient.publish(topic, payload.c_str(), retain)) {
+        bool published = false;
+
+        // PubSubClient is not thread-safe - serialize with the subscriber task's loop()
+        if (!clientMutex || xSemaphoreTake(clientMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            published = mqttClient.publish(topic, payload, length, retain);
+            if (clientMutex) xSemaphoreGive(clientMutex);
+        }
+
+        if (published) {
             publishCount++;
             lastPublishTime = millis();
             return true;
         }
 
         Logger::warningf("MQTT publish attempt %d failed", attempt + 1);
-        delay(100);  // Brief delay between retries
+        vTaskDelay(pdMS_TO_TICKS(100));  // Brief delay between retries
     }
 
     failedPublishCount++;
@@ -409,6 +836,11 @@ void MQTTManager::notifyConnectionChange(bool connected) {
 
     if (connected) {
         reconnectionCount++;
+
+        // Wake the publisher so any backlog queued while offline goes out now
+        if (publisherTaskHandle) {
+            xTaskNotifyGive(publisherTaskHandle);
+        }
     }
 }
 
@@ -421,10 +853,14 @@ bool MQTTManager::publishMovementIndividual(int servoIndex, unsigned long startT
         return false;
     }
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "movement_individual";
+    if (telemetryBatching) {
+        return batchMovement(servoIndex, startTime, duration, successful, startAngle,
+                             targetAngle, actualAngle, smoothness, movementType, sessionId);
+    }
+
+    if (!beginMessage("movement_individual")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["servo_index"] = servoIndex;
     data["start_time"] = startTime;
     data["duration_ms"] = duration;
@@ -438,9 +874,9 @@ bool MQTTManager::publishMovementIndividual(int servoIndex, unsigned long startT
         data["session_id"] = sessionId;
     }
 
-    bool success = publishJSON(TOPIC_MOVEMENT_INDIVIDUAL, doc);
+    bool success = commitMessage(TOPIC_MOVEMENT_INDIVIDUAL);
     if (success) {
-        Logger::debugf("Published individual movement: Servo %d, Duration %lu ms", servoIndex, duration);
+        LOG_DEBUGF("Published individual movement: Servo %d, Duration %lu ms", servoIndex, duration);
     }
 
     return success;
@@ -450,38 +886,118 @@ bool MQTTManager::publishMovementQuality(const String& sessionId, float overallQ
                                         float averageSmoothness, float successRate) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "movement_quality";
+    if (!beginMessage("movement_quality")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["session_id"] = sessionId;
     data["overall_quality"] = overallQuality;
     data["average_smoothness"] = averageSmoothness;
     data["success_rate"] = successRate;
 
-    bool success = publishJSON(TOPIC_MOVEMENT_QUALITY, doc);
+    bool success = commitMessage(TOPIC_MOVEMENT_QUALITY);
     if (success) {
-        Logger::debugf("Published movement quality: Session %s, Quality %.2f", sessionId.c_str(), overallQuality);
+        LOG_DEBUGF("Published movement quality: Session %s, Quality %.2f", sessionId.c_str(), overallQuality);
     }
 
     return success;
 }
 
 bool MQTTManager::publishPerformanceTiming(unsigned long loopTime, unsigned long averageLoopTime,
-                                          unsigned long maxLoopTime) {
+                                          unsigned long maxLoopTime, float core0Load, float core1Load) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "performance_timing";
+    if (!beginMessage("performance_timing")) return false;
+    beginDeltaReport(timingDeadband);
 
-    JsonObject data = doc["data"].to<JsonObject>();
-    data["current_loop_time"] = loopTime;
-    data["average_loop_time"] = averageLoopTime;
-    data["max_loop_time"] = maxLoopTime;
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    if (timingDeadband.offer(TIMING_CURRENT, loopTime)) data["current_loop_time"] = loopTime;
+    if (timingDeadband.offer(TIMING_AVERAGE, averageLoopTime)) data["average_loop_time"] = averageLoopTime;
+    if (timingDeadband.offer(TIMING_MAX, maxLoopTime)) data["max_loop_time"] = maxLoopTime;
+    // Negative until the first CPU window has been measured
+    if (core0Load >= 0 && timingDeadband.offer(TIMING_CORE0_LOAD, core0Load)) data["core0_load"] = roundf(core0Load * 10) / 10;
+    if (core1Load >= 0 && timingDeadband.offer(TIMING_CORE1_LOAD, core1Load)) data["core1_load"] = roundf(core1Load * 10) / 10;
 
-    bool success = publishJSON(TOPIC_PERFORMANCE_TIMING, doc);
+    bool success = commitDeltaReport(timingDeadband, TOPIC_PERFORMANCE_TIMING);
     if (success) {
-        Logger::debugf("Published performance timing: Current %lu ms, Avg %lu ms", loopTime, averageLoopTime);
+        LOG_DEBUGF("Published performance timing: Current %lu ms, Avg %lu ms", loopTime, averageLoopTime);
+    }
+
+    return success;
+}
+
+bool MQTTManager::publishTaskUsage(const TaskCpuUsage* tasks, uint8_t count, unsigned long windowMs,
+                                   bool perTaskCpu) {
+    if (!isConnected() || count == 0) return false;
+
+    if (!beginMessage("performance_tasks")) return false;
+
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    data["window_ms"] = windowMs;
+    data["per_task_cpu"] = perTaskCpu;
+
+    JsonArray columns = data["columns"].to<JsonArray>();
+    columns.add("name");
+    columns.add("core");
+    columns.add("priority");
+    columns.add("cpu_percent");
+    columns.add("stack_free");
+
+    // Compact rows, busiest first; cpu_percent is -1 without run-time stats
+    JsonArray rows = data["tasks"].to<JsonArray>();
+    uint8_t rowCount = count < CPU_TASK_USAGE_MAX_ROWS ? count : CPU_TASK_USAGE_MAX_ROWS;
+    for (uint8_t i = 0; i < rowCount; i++) {
+        JsonArray row = rows.add<JsonArray>();
+        row.add(tasks[i].name);
+        row.add(tasks[i].core);
+        row.add(tasks[i].priority);
+        row.add(tasks[i].cpuPercent < 0 ? -1.0f : roundf(tasks[i].cpuPercent * 10) / 10);
+        row.add(tasks[i].stackHeadroom);
+    }
+
+    // Long task names can still overflow a queue slot - drop the least busy rows
+    while (rows.size() > 1 && measureJson(stagingDoc) >= sizeof(stagingMessage.payload) - 1) {
+        rows.remove(rows.size() - 1);
+    }
+    data["omitted"] = count - rows.size();
+
+    bool success = commitMessage(TOPIC_PERFORMANCE_TIMING, false, MQTT_PRIORITY_LOW);
+    if (success) {
+        LOG_DEBUGF("Published task usage: %u of %u tasks", (unsigned)rows.size(), (unsigned)count);
+    }
+
+    return success;
+}
+
+bool MQTTManager::publishBootTiming(BootScheduler& boot, uint32_t readyUs) {
+    if (!isConnected()) return false;
+
+    if (!beginMessage("boot_timing")) return false;
+
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    data["ready_ms"] = roundf(readyUs / 100.0f) / 10;
+    data["complete_ms"] = roundf(boot.getFinishUs() / 100.0f) / 10;
+
+    JsonArray columns = data["columns"].to<JsonArray>();
+    columns.add("name");
+    columns.add("core");
+    columns.add("start_ms");
+    columns.add("duration_ms");
+    columns.add("result");
+
+    JsonArray rows = data["stages"].to<JsonArray>();
+    for (int i = 0; i < boot.getStageCount(); i++) {
+        const BootStageTiming& timing = boot.getTiming(i);
+        JsonArray row = rows.add<JsonArray>();
+        row.add(timing.name);
+        row.add(timing.core);
+        row.add(roundf(timing.startUs / 100.0f) / 10);
+        row.add(roundf(timing.durationUs / 100.0f) / 10);
+        row.add(BootScheduler::getResultName(timing.result));
+    }
+
+    bool success = commitMessage(TOPIC_PERFORMANCE_TIMING, false, MQTT_PRIORITY_NORMAL);
+    if (success) {
+        LOG_DEBUG("Published boot timing");
     }
 
     return success;
@@ -490,17 +1006,63 @@ bool MQTTManager::publishPerformanceTiming(unsigned long loopTime, unsigned long
 bool MQTTManager::publishPerformanceMemory(size_t freeHeap, size_t minFreeHeap, float memoryUsagePercent) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "performance_memory";
+    if (!beginMessage("performance_memory")) return false;
+    beginDeltaReport(memoryDeadband);
+
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    if (memoryDeadband.offer(MEMORY_FREE, freeHeap)) data["free_heap"] = freeHeap;
+    if (memoryDeadband.offer(MEMORY_MIN_FREE, minFreeHeap)) data["min_free_heap"] = minFreeHeap;
+    if (memoryDeadband.offer(MEMORY_USAGE, memoryUsagePercent)) data["memory_usage_percent"] = memoryUsagePercent;
+
+    bool success = commitDeltaReport(memoryDeadband, TOPIC_PERFORMANCE_MEMORY);
+    if (success) {
+        LOG_DEBUGF("Published memory performance: Free %zu bytes, Usage %.1f%%", freeHeap, memoryUsagePercent);
+    }
+
+    return success;
+}
+
+bool MQTTManager::publishPerformanceBLE(const BLELinkStats& stats) {
+    if (!isConnected()) return false;
+
+    if (!beginMessage("performance_ble")) return false;
+
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    data["connected"] = stats.connected;
+    data["profile"] = stats.profile == BLELinkProfile::ACTIVE ? "active" : "idle";
+    data["interval_ms"] = stats.intervalMs;
+    data["peripheral_latency"] = stats.peripheralLatency;
+    data["supervision_timeout_ms"] = stats.supervisionTimeoutMs;
+    data["worst_delivery_ms"] = stats.worstDeliveryMs;
+    data["notify_bytes_per_second"] = stats.notifyBytesPerSecond;
+    data["ack_latency_avg_us"] = stats.ackLatencyAvgUs;
+    data["ack_latency_max_us"] = stats.ackLatencyMaxUs;
+    data["parameter_updates"] = stats.parameterUpdates;
+    data["advertising_slow"] = stats.advertisingSlow;
+
+    return commitMessage(TOPIC_PERFORMANCE_BLE, false, MQTT_PRIORITY_LOW);
+}
 
-    JsonObject data = doc["data"].to<JsonObject>();
-    data["free_heap"] = freeHeap;
-    data["min_free_heap"] = minFreeHeap;
-    data["memory_usage_percent"] = memoryUsagePercent;
+bool MQTTManager::publishTaskTrace() {
+    if (!isConnected() || TaskTracer::getTaskCount() == 0) return false;
+
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    // Serialized straight into the queue slot, like telemetry frames
+    size_t length = TaskTracer::serialize((uint8_t*)stagingMessage.payload, sizeof(stagingMessage.payload));
+    bool success = false;
+    if (length > 0) {
+        stagingMessage.payloadLength = length;
+        success = submitStagedMessage(TOPIC_PERFORMANCE_TRACE, false, MQTT_PRIORITY_LOW);
+    }
+
+    xSemaphoreGive(stagingMutex);
 
-    bool success = publishJSON(TOPIC_PERFORMANCE_MEMORY, doc);
     if (success) {
-        Logger::debugf("Published memory performance: Free %zu bytes, Usage %.1f%%", freeHeap, memoryUsagePercent);
+        LOG_DEBUGF("Queued task trace frame: %u bytes", length);
     }
 
     return success;
@@ -510,17 +1072,16 @@ bool MQTTManager::publishClinicalProgress(const String& sessionId, float progres
                                          const String& progressIndicators) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "clinical_progress";
+    if (!beginMessage("clinical_progress")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["session_id"] = sessionId;
     data["progress_score"] = progressScore;
     data["progress_indicators"] = progressIndicators;
 
-    bool success = publishJSON(TOPIC_CLINICAL_PROGRESS, doc);
+    bool success = commitMessage(TOPIC_CLINICAL_PROGRESS);
     if (success) {
-        Logger::debugf("Published clinical progress: Session %s, Score %.2f", sessionId.c_str(), progressScore);
+        LOG_DEBUGF("Published clinical progress: Session %s, Score %.2f", sessionId.c_str(), progressScore);
     }
 
     return success;
@@ -530,17 +1091,16 @@ bool MQTTManager::publishClinicalQuality(const String& sessionId, float sessionQ
                                         const String& qualityMetrics) {
     if (!isConnected()) return false;
 
-    JsonDocument doc = createBaseDocument();
-    doc["event_type"] = "clinical_quality";
+    if (!beginMessage("clinical_quality")) return false;
 
-    JsonObject data = doc["data"].to<JsonObject>();
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
     data["session_id"] = sessionId;
     data["session_quality"] = sessionQuality;
     data["quality_metrics"] = qualityMetrics;
 
-    bool success = publishJSON(TOPIC_CLINICAL_QUALITY, doc);
+    bool success = commitMessage(TOPIC_CLINICAL_QUALITY);
     if (success) {
-        Logger::debugf("Published clinical quality: Session %s, Quality %.2f", sessionId.c_str(), sessionQuality);
+        LOG_DEBUGF("Published clinical quality: Session %s, Quality %.2f", sessionId.c_str(), sessionQuality);
     }
 
     return success;
@@ -552,6 +1112,7 @@ void MQTTManager::shutdown() {
     Logger::info("Shutting down MQTT Manager...");
 
     stopTasks();
+    closeBrokerSocket();
     disconnect();
 
     initialized = false;
@@ -569,7 +1130,7 @@ void MQTTManager::startTasks() {
     BaseType_t publisherResult = xTaskCreatePinnedToCore(
         mqttPublisherTask,
         "MQTTPublisher",
-        TASK_STACK_MQTT_PUBLISHER,
+        ResourceProfiler::getStackSize(ProfiledTask::MQTT_PUBLISHER),
         this,
         PRIORITY_MQTT_PUBLISHER,
         &publisherTaskHandle,
@@ -580,7 +1141,7 @@ void MQTTManager::startTasks() {
     BaseType_t subscriberResult = xTaskCreatePinnedToCore(
         mqttSubscriberTask,
         "MQTTSubscriber",
-        TASK_STACK_MQTT_SUBSCRIBER,
+        ResourceProfiler::getStackSize(ProfiledTask::MQTT_SUBSCRIBER),
         this,
         PRIORITY_MQTT_SUBSCRIBER,
         &subscriberTaskHandle,
@@ -620,9 +1181,97 @@ bool MQTTManager::areTasksRunning() {
 
 // Queue-based publishing for thread-safe operations
 bool MQTTManager::queueMessage(const char* topic, const String& payload, bool retain, uint8_t priority) {
-    // For now, fall back to direct publishing since FreeRTOS Manager is disabled
-    // TODO: Implement proper queue-based publishing when FreeRTOS Manager is re-enabled
-    return publishWithRetry(topic, payload, retain);
+    if (!stagingMutex) {
+        // No staging buffer - publish directly on the calling task
+        return publishWithRetry(topic, (const uint8_t*)payload.c_str(), payload.length(), retain);
+    }
+
+    if (payload.length() >= sizeof(stagingMessage.payload)) {
+        Logger::warningf("MQTT payload too large to queue (%u bytes) for %s", payload.length(), topic);
+        failedPublishCount++;
+        return false;
+    }
+
+    if (xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    memcpy(stagingMessage.payload, payload.c_str(), payload.length() + 1);
+    stagingMessage.payloadLength = payload.length();
+    bool success = submitStagedMessage(topic, retain, priority);
+    xSemaphoreGive(stagingMutex);
+
+    return success;
+}
+
+bool MQTTManager::submitStagedMessage(const char* topic, bool retain, uint8_t priority) {
+    // stagingMutex must be held by the caller and stagingMessage.payload filled in
+    strncpy(stagingMessage.topic, topic, sizeof(stagingMessage.topic) - 1);
+    stagingMessage.topic[sizeof(stagingMessage.topic) - 1] = '\0';
+    stagingMessage.retain = retain;
+    stagingMessage.qos = 0;
+    stagingMessage.timestamp = millis();
+    stagingMessage.priority = priority;
+
+    QueueHandle_t queue = (priority >= MQTT_PRIORITY_HIGH) ?
+        FreeRTOSManager::getMQTTPriorityQueue() : FreeRTOSManager::getMQTTPublishQueue();
+
+    if (!queue || !tasksRunning) {
+        // No publisher task to hand off to. Publishing inline would hold
+        // stagingMutex through network I/O and retry delays, stalling every
+        // other producer - count it instead, callers fall back to the recorder
+        droppedMessageCount++;
+        return false;
+    }
+
+    // Low priority telemetry leaves the last slots to normal priority messages
+    if (priority < MQTT_PRIORITY_NORMAL && uxQueueSpacesAvailable(queue) <= MQTT_LOW_PRIORITY_RESERVE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    // Never block the producer - a full queue means the network is behind
+    bool sent = xQueueSendToBack(queue, &stagingMessage, 0) == pdTRUE;
+    ResourceProfiler::recordQueueSend(priority >= MQTT_PRIORITY_HIGH ? ProfiledQueue::MQTT_PRIORITY
+                                                                     : ProfiledQueue::MQTT_PUBLISH, sent);
+    if (!sent) {
+        droppedMessageCount++;
+
+        static unsigned long lastWarning = 0;
+        unsigned long now = millis();
+        if (now - lastWarning > 5000) {
+            Logger::warningf("MQTT publish queue full - dropping messages (%d dropped)", droppedMessageCount);
+            lastWarning = now;
+        }
+        return false;
+    }
+
+    if (publisherTaskHandle) {
+        xTaskNotifyGive(publisherTaskHandle);
+    }
+
+    return true;
+}
+
+bool MQTTManager::dequeueMessage(MQTTMessage* message) {
+    QueueHandle_t priorityQueue = FreeRTOSManager::getMQTTPriorityQueue();
+    QueueHandle_t publishQueue = FreeRTOSManager::getMQTTPublishQueue();
+
+    // High priority lane always drains first
+    if (priorityQueue && xQueueReceive(priorityQueue, message, 0) == pdTRUE) {
+        return true;
+    }
+
+    return publishQueue && xQueueReceive(publishQueue, message, 0) == pdTRUE;
+}
+
+void MQTTManager::processPublishQueue() {
+    // Messages stay queued while disconnected and go out after reconnection
+    while (tasksRunning && isConnected() && dequeueMessage(&outgoingMessage)) {
+        publishWithRetry(outgoingMessage.topic, (const uint8_t*)outgoingMessage.payload,
+                         outgoingMessage.payloadLength, outgoingMessage.retain);
+    }
 }
 
 // =============================================================================
@@ -633,20 +1282,22 @@ void MQTTManager::mqttPublisherTask(void* parameter) {
     MQTTManager* manager = (MQTTManager*)parameter;
     Logger::info("MQTT Publisher task started");
 
+    // Woken on demand - only the time spent publishing is traced
+    TraceId traceId = TaskTracer::registerTask("MQTTPublish");
+
     while (manager->tasksRunning) {
-        // TODO: Process messages from publish queue when FreeRTOS Manager is re-enabled
-        // For now, just maintain connection and handle basic operations
+        // Sleep until a producer queues a message (or the connection comes back)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PUBLISHER_IDLE_TIMEOUT));
+        TaskTracer::ScopedTimer timer(traceId);
 
-        if (manager->isConnected()) {
-            // Publisher task is ready for queue-based publishing
-            // Currently using direct publishing through existing methods
-        }
+        // Partially filled telemetry frames go out once they are old enough
+        manager->flushDueTelemetryBatches();
+
+        // Drain high priority messages first, then normal/low priority
+        manager->processPublishQueue();
 
         // Feed watchdog - now that FreeRTOS Manager is re-enabled
         FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
-
-        // Publisher runs at 100Hz for responsive publishing
-        vTaskDelay(pdMS_TO_TICKS(10));
     }
 
     Logger::info("MQTT Publisher task ended");
@@ -657,29 +1308,27 @@ void MQTTManager::mqttSubscriberTask(void* parameter) {
     MQTTManager* manager = (MQTTManager*)parameter;
     Logger::info("MQTT Subscriber task started");
 
+    TraceId traceId = TaskTracer::registerTask("MQTTSubscribe", 50 * 1000);
+
     while (manager->tasksRunning) {
+        int64_t traceStart = TaskTracer::begin(traceId);
+
         // Handle MQTT client loop and connection management
-        if (manager->mqttClient.connected()) {
-            manager->mqttClient.loop();  // Process incoming messages
+        SemaphoreHandle_t clientMutex = FreeRTOSManager::getMQTTClientMutex();
+        if (!clientMutex || xSemaphoreTake(clientMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
+            if (manager->mqttClient.connected()) {
+                manager->mqttClient.loop();  // Process incoming messages
+            }
+            if (clientMutex) xSemaphoreGive(clientMutex);
         }
 
-        // Handle connection events and status updates
+        // Connection state machine - never blocks beyond the CONNACK wait
+        manager->runConnectionStateMachine();
         manager->handleConnectionEvents();
-        manager->updateConnectionStatus();
-
-        // Handle reconnection logic
-        if ((manager->currentStatus == MQTTStatus::DISCONNECTED ||
-             manager->currentStatus == MQTTStatus::CONNECTION_FAILED) &&
-            WiFi.status() == WL_CONNECTED) {
-
-            unsigned long now = millis();
-            if (now - manager->lastReconnectAttempt >= MQTT_RECONNECT_INTERVAL) {
-                manager->attemptConnection();
-            }
-        }
 
         // Feed watchdog - now that FreeRTOS Manager is re-enabled
         FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
+        TaskTracer::end(traceId, traceStart);
 
         // Subscriber runs at 20Hz for connection management
         vTaskDelay(pdMS_TO_TICKS(50));
@@ -697,19 +1346,21 @@ bool MQTTManager::publishHeartRate(float heartRate, float spO2, const String& qu
                                   bool fingerDetected, const String& sessionId) {
     if (!isConnected()) return false;
 
-    JsonDocument doc;
-    doc["device_id"] = DEVICE_ID;
-    doc["timestamp"] = millis();
-    doc["heart_rate"] = heartRate;
-    doc["spo2"] = spO2;
-    doc["signal_quality"] = quality;
-    doc["finger_detected"] = fingerDetected;
-    doc["session_id"] = sessionId;
+    if (telemetryBatching) {
+        return batchHeartRate(heartRate, spO2, quality, fingerDetected, sessionId);
+    }
+
+    if (!beginMessage(nullptr)) return false;
 
-    String payload;
-    serializeJson(doc, payload);
+    stagingDoc["device_id"] = DEVICE_ID;
+    stagingDoc["timestamp"] = millis();
+    stagingDoc["heart_rate"] = heartRate;
+    stagingDoc["spo2"] = spO2;
+    stagingDoc["signal_quality"] = quality;
+    stagingDoc["finger_detected"] = fingerDetected;
+    stagingDoc["session_id"] = sessionId;
 
-    bool success = publish(TOPIC_SENSOR_HEART_RATE, payload);
+    bool success = commitMessage(TOPIC_SENSOR_HEART_RATE);
 
     if (success) {
         Logger::infof("Published heart rate: %.1f BPM, SpO2: %.1f%%, Quality: %s",
@@ -726,24 +1377,276 @@ bool MQTTManager::publishPulseMetrics(const String& sessionId, float avgHeartRat
                                      float maxHeartRate, float avgSpO2, float dataQuality) {
     if (!isConnected()) return false;
 
-    JsonDocument doc;
-    doc["device_id"] = DEVICE_ID;
-    doc["timestamp"] = millis();
-    doc["session_id"] = sessionId;
-    doc["avg_heart_rate"] = avgHeartRate;
-    doc["min_heart_rate"] = minHeartRate;
-    doc["max_heart_rate"] = maxHeartRate;
-    doc["avg_spo2"] = avgSpO2;
-    doc["data_quality"] = dataQuality;
+    if (!beginMessage(nullptr)) return false;
 
-    String payload;
-    serializeJson(doc, payload);
+    stagingDoc["device_id"] = DEVICE_ID;
+    stagingDoc["timestamp"] = millis();
+    stagingDoc["session_id"] = sessionId;
+    stagingDoc["avg_heart_rate"] = avgHeartRate;
+    stagingDoc["min_heart_rate"] = minHeartRate;
+    stagingDoc["max_heart_rate"] = maxHeartRate;
+    stagingDoc["avg_spo2"] = avgSpO2;
+    stagingDoc["data_quality"] = dataQuality;
 
-    bool success = publish("rehab_exo/pulse_metrics", payload);
+    bool success = commitMessage("rehab_exo/pulse_metrics");
 
     if (success) {
-        Logger::debugf("Published pulse metrics for session: %s", sessionId.c_str());
+        LOG_DEBUGF("Published pulse metrics for session: %s", sessionId.c_str());
     }
 
     return success;
-}
\ No newline at end of file
+}
+
+bool MQTTManager::publishFusedData(const FusedSensorData& frame, const String& sessionId) {
+    if (!isConnected()) return false;
+
+    if (!beginMessage("sensor_fusion")) return false;
+
+    stagingDoc["session_id"] = sessionId;
+
+    JsonObject data = stagingDoc["data"].to<JsonObject>();
+    data["sample_time"] = frame.timestamp;
+    data["overall_quality"] = frame.overallQuality;
+    data["all_sensors_valid"] = frame.allSensorsValid;
+    data["active_sensors"] = frame.activeSensorCount;
+
+    if (frame.pulse.valid) {
+        JsonObject pulse = data["pulse"].to<JsonObject>();
+        pulse["heart_rate"] = frame.pulse.heartRate;
+        pulse["spo2"] = frame.pulse.spO2;
+        pulse["quality"] = frame.pulse.quality;
+    }
+
+    if (frame.motion.valid) {
+        JsonObject motion = data["motion"].to<JsonObject>();
+        motion["accel_x"] = frame.motion.accelX;
+        motion["accel_y"] = frame.motion.accelY;
+        motion["accel_z"] = frame.motion.accelZ;
+        motion["gyro_x"] = frame.motion.gyroX;
+        motion["gyro_y"] = frame.motion.gyroY;
+        motion["gyro_z"] = frame.motion.gyroZ;
+        motion["intensity"] = frame.motion.movementIntensity;
+        motion["detected"] = frame.motion.motionDetected;
+    }
+
+    JsonArray pressure = data["pressure"].to<JsonArray>();
+    for (int i = 0; i < SENSOR_FUSION_PRESSURE_CHANNELS; i++) {
+        if (!frame.pressure[i].valid) continue;
+
+        JsonObject channel = pressure.add<JsonObject>();
+        channel["index"] = frame.pressure[i].sensorIndex;
+        channel["force"] = frame.pressure[i].force;
+        channel["pressure"] = frame.pressure[i].pressure;
+        channel["contact"] = frame.pressure[i].contact;
+    }
+
+    return commitMessage(TOPIC_SENSOR_FUSED, false, MQTT_PRIORITY_NORMAL);
+}
+// =============================================================================
+// RECORDED EVENT REPLAY
+// =============================================================================
+
+bool MQTTManager::publishRecordedEvent(const RecordedEvent& event) {
+    if (!isConnected()) return false;
+
+    // Session IDs are zero padded, not terminated, on flash
+    char sessionId[sizeof(event.sessionId) + 1];
+    memcpy(sessionId, event.sessionId, sizeof(event.sessionId));
+    sessionId[sizeof(event.sessionId)] = '\0';
+
+    const char* topic = nullptr;
+
+    switch ((RecordedEventType)event.type) {
+        case RecordedEventType::SESSION_START: {
+            if (!beginMessage("session_start", event.timestamp)) return false;
+
+            JsonObject data = stagingDoc["data"].to<JsonObject>();
+            data["session_id"] = sessionId;
+            data["session_type"] = SessionRecorder::sessionTypeName(event.data.sessionStart.sessionType);
+            data["ble_connected"] = (event.flags & RECORD_FLAG_BLE_CONNECTED) != 0;
+            data["auto_started"] = (event.flags & RECORD_FLAG_AUTO_STARTED) != 0;
+            topic = TOPIC_SESSION_START;
+            break;
+        }
+
+        case RecordedEventType::SESSION_END: {
+            if (!beginMessage("session_end", event.timestamp)) return false;
+
+            const RecordedSessionEnd& end = event.data.sessionEnd;
+            char endReason[sizeof(end.endReason) + 1];
+            memcpy(endReason, end.endReason, sizeof(end.endReason));
+            endReason[sizeof(end.endReason)] = '\0';
+
+            JsonObject data = stagingDoc["data"].to<JsonObject>();
+            data["session_id"] = sessionId;
+            data["session_type"] = SessionRecorder::sessionTypeName(end.sessionType);
+            data["end_reason"] = endReason;
+            data["total_duration"] = end.durationMs;
+            data["movements_completed"] = end.totalMovements;
+            data["successful_movements"] = end.successfulMovements;
+            data["cycles_completed"] = end.cycles;
+            topic = TOPIC_SESSION_END;
+            break;
+        }
+
+        case RecordedEventType::MOVEMENT: {
+            if (!beginMessage("movement_individual", event.timestamp)) return false;
+
+            const RecordedMovement& movement = event.data.movement;
+            JsonObject data = stagingDoc["data"].to<JsonObject>();
+            data["servo_index"] = movement.servoIndex;
+            data["start_time"] = movement.startTime;
+            data["duration_ms"] = movement.durationMs;
+            data["successful"] = (event.flags & RECORD_FLAG_SUCCESSFUL) != 0;
+            data["start_angle"] = movement.startAngle;
+            data["target_angle"] = movement.targetAngle;
+            data["actual_angle"] = movement.actualAngle;
+            data["smoothness"] = movement.smoothness;
+            data["movement_type"] = SessionRecorder::movementTypeName(movement.movementType);
+            if (sessionId[0] != '\0') {
+                data["session_id"] = sessionId;
+            }
+            topic = TOPIC_MOVEMENT_INDIVIDUAL;
+            break;
+        }
+
+        case RecordedEventType::HEART_RATE: {
+            if (!beginMessage(nullptr)) return false;
+
+            // Heart rate messages carry a millisecond timestamp
+            const RecordedHeartRate& reading = event.data.heartRate;
+            stagingDoc["device_id"] = DEVICE_ID;
+            stagingDoc["timestamp"] = (uint64_t)event.timestamp * 1000 + event.timestampMs;
+            stagingDoc["heart_rate"] = reading.heartRate;
+            stagingDoc["spo2"] = reading.spO2;
+            stagingDoc["signal_quality"] = SessionRecorder::qualityName(reading.quality);
+            stagingDoc["finger_detected"] = (event.flags & RECORD_FLAG_FINGER_DETECTED) != 0;
+            stagingDoc["session_id"] = sessionId;
+            topic = TOPIC_SENSOR_HEART_RATE;
+            break;
+        }
+
+        default:
+            return true;  // Unknown record type - nothing to send
+    }
+
+    stagingDoc["replayed"] = true;
+
+    // Low priority keeps the backlog behind live traffic, and in order
+    return commitMessage(topic, false, MQTT_PRIORITY_LOW);
+}
+
+// =============================================================================
+// BATCHED TELEMETRY
+// =============================================================================
+
+void MQTTManager::setTelemetryBatching(bool enabled) {
+    if (telemetryBatching == enabled) return;
+
+    // Don't strand readings collected in the old mode
+    if (!enabled) {
+        flushTelemetryBatches();
+    }
+
+    telemetryBatching = enabled;
+    Logger::infof("MQTT telemetry batching %s", enabled ? "enabled" : "disabled");
+}
+
+bool MQTTManager::isTelemetryBatchingEnabled() {
+    return telemetryBatching;
+}
+
+void MQTTManager::flushTelemetryBatches() {
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        return;
+    }
+
+    submitTelemetryFrame(heartRateBatch);
+    submitTelemetryFrame(movementBatch);
+
+    xSemaphoreGive(stagingMutex);
+}
+
+bool MQTTManager::batchHeartRate(float heartRate, float spO2, const String& quality,
+                                 bool fingerDetected, const String& sessionId) {
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    unsigned long now = millis();
+    uint8_t qualityCode = TelemetryBatch::qualityCode(quality);
+
+    // Close the current frame if this reading can't join it (full, too old, new session)
+    if (!heartRateBatch.acceptsRecord(now, sessionId)) {
+        submitTelemetryFrame(heartRateBatch);
+    }
+
+    bool success = heartRateBatch.addHeartRate(now, heartRate, spO2, qualityCode, fingerDetected, sessionId);
+
+    if (heartRateBatch.isFull()) {
+        submitTelemetryFrame(heartRateBatch);
+    }
+
+    xSemaphoreGive(stagingMutex);
+    return success;
+}
+
+bool MQTTManager::batchMovement(int servoIndex, unsigned long startTime, unsigned long duration,
+                                bool successful, int startAngle, int targetAngle, int actualAngle,
+                                float smoothness, const String& movementType, const String& sessionId) {
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        droppedMessageCount++;
+        return false;
+    }
+
+    // Movements are stamped with their end time so offsets stay monotonic
+    unsigned long endTime = startTime + duration;
+    uint8_t movementCode = TelemetryBatch::movementCode(movementType);
+
+    if (!movementBatch.acceptsRecord(endTime, sessionId)) {
+        submitTelemetryFrame(movementBatch);
+    }
+
+    bool success = movementBatch.addMovement(endTime, duration, servoIndex, successful, startAngle,
+                                             targetAngle, actualAngle, smoothness, movementCode, sessionId);
+
+    if (movementBatch.isFull()) {
+        submitTelemetryFrame(movementBatch);
+    }
+
+    xSemaphoreGive(stagingMutex);
+    return success;
+}
+
+bool MQTTManager::submitTelemetryFrame(TelemetryBatch& batch) {
+    // stagingMutex must be held by the caller
+    size_t length = batch.writeFrame((uint8_t*)stagingMessage.payload, sizeof(stagingMessage.payload));
+    if (length == 0) return false;
+
+    stagingMessage.payloadLength = length;
+    bool success = submitStagedMessage(TOPIC_TELEMETRY_BATCH, false, MQTT_PRIORITY_NORMAL);
+
+    // A frame that could not be queued stays in the batch and goes with the
+    // next flush; until then new records that do not fit are refused
+    if (success) {
+        batch.commitFrame();
+        LOG_DEBUGF("Queued telemetry frame: %u bytes", length);
+    }
+
+    return success;
+}
+
+void MQTTManager::flushDueTelemetryBatches() {
+    unsigned long now = millis();
+    if (!heartRateBatch.isDue(now) && !movementBatch.isDue(now)) return;
+
+    if (!stagingMutex || xSemaphoreTake(stagingMutex, pdMS_TO_TICKS(STAGING_LOCK_TIMEOUT)) != pdTRUE) {
+        return;  // Try again on the next publisher wake-up
+    }
+
+    if (heartRateBatch.isDue(now)) submitTelemetryFrame(heartRateBatch);
+    if (movementBatch.isDue(now)) submitTelemetryFrame(movementBatch);
+
+    xSemaphoreGive(stagingMutex);
+}
@@ -2,14 +2,25 @@
 #define MQTT_MANAGER_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <WiFi.h>
 #include <PubSubClient.h>
+#include <lwip/ip_addr.h>
 #include <ArduinoJson.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/queue.h>
 #include <freertos/semphr.h>
 #include "../config/Config.h"
+#include "../hardware/FreeRTOSManager.h"
+#include "../hardware/TaskTracer.h"
+#include "../memory/StaticJsonAllocator.h"
+#include "TelemetryBatch.h"
+#include "TelemetryDeadband.h"
+#include "../storage/SessionRecorder.h"
+#include "../bluetooth/BLELinkManager.h"
+#include "../hardware/SystemMonitor.h"
+#include "../utils/BootScheduler.h"
 
 enum class MQTTStatus {
     DISCONNECTED,
@@ -19,8 +30,12 @@ enum class MQTTStatus {
     RECONNECTING
 };
 
+struct FusedSensorData;
+
 class MQTTManager {
 public:
+    MQTTManager();
+
     // Initialization and lifecycle
     void initialize();
     void update();  // Legacy method - will be deprecated
@@ -36,9 +51,10 @@ public:
     MQTTStatus getStatus();
     void disconnect();
     void reconnect();
+    void requestConnection();  // Connect on the next subscriber tick with the backoff reset
 
     // Publishing methods
-    bool publishMovementCommand(const String& command, unsigned long responseTime, bool bleConnected, const String& sessionId = "");
+    bool publishMovementCommand(const char* command, unsigned long responseTime, bool bleConnected, const char* sessionId = "");
     bool publishSystemStatus(const String& status, const String& firmwareVersion,
                            unsigned long uptime, size_t freeHeap, bool wifiConnected,
                            bool bleConnected, int currentState, int wifiRssi,
@@ -47,7 +63,7 @@ public:
     bool publishBLEStatus(const String& status);
 
     // Session management publishing
-    bool publishSessionStart(const String& sessionId, const String& sessionType, bool bleConnected);
+    bool publishSessionStart(const String& sessionId, const String& sessionType, bool bleConnected, bool autoStarted);
     bool publishSessionEnd(const String& sessionId, const String& sessionType, const String& endReason,
                           unsigned long duration, int totalMovements, int successfulMovements, int cycles);
     bool publishSessionProgress(const String& sessionId, int completedCycles, int totalCycles,
@@ -60,8 +76,13 @@ public:
     bool publishMovementQuality(const String& sessionId, float overallQuality,
                                float averageSmoothness, float successRate);
     bool publishPerformanceTiming(unsigned long loopTime, unsigned long averageLoopTime,
-                                 unsigned long maxLoopTime);
+                                 unsigned long maxLoopTime, float core0Load, float core1Load);
+    bool publishTaskUsage(const TaskCpuUsage* tasks, uint8_t count, unsigned long windowMs,
+                          bool perTaskCpu);  // Per-task table on TOPIC_PERFORMANCE_TIMING
+    bool publishBootTiming(BootScheduler& boot, uint32_t readyUs);  // Once per boot, same topic
     bool publishPerformanceMemory(size_t freeHeap, size_t minFreeHeap, float memoryUsagePercent);
+    bool publishTaskTrace();  // Binary TaskTracer frame on TOPIC_PERFORMANCE_TRACE
+    bool publishPerformanceBLE(const BLELinkStats& stats);
     bool publishClinicalProgress(const String& sessionId, float progressScore,
                                const String& progressIndicators);
     bool publishClinicalQuality(const String& sessionId, float sessionQuality,
@@ -72,13 +93,24 @@ public:
                          bool fingerDetected, const String& sessionId = "");
     bool publishPulseMetrics(const String& sessionId, float avgHeartRate, float minHeartRate,
                            float maxHeartRate, float avgSpO2, float dataQuality);
+    bool publishFusedData(const FusedSensorData& frame, const String& sessionId = "");
 
     // Generic publishing
     bool publish(const char* topic, const String& payload, bool retain = false);
-    bool publishJSON(const char* topic, const JsonDocument& doc, bool retain = false);
+    bool publishJSON(const char* topic, const JsonDocument& doc, bool retain = false,
+                     uint8_t priority = MQTT_PRIORITY_NORMAL);
+
+    // Queue-based publishing (thread-safe, returns once the message is queued)
+    bool queueMessage(const char* topic, const String& payload, bool retain = false,
+                      uint8_t priority = MQTT_PRIORITY_NORMAL);
+
+    // Replay of a record kept on flash while offline (original timestamp, low priority)
+    bool publishRecordedEvent(const RecordedEvent& event);
 
-    // Queue-based publishing (thread-safe)
-    bool queueMessage(const char* topic, const String& payload, bool retain = false, uint8_t priority = 128);
+    // Batched telemetry (heart rate and movement readings go out as binary frames)
+    void setTelemetryBatching(bool enabled);
+    bool isTelemetryBatchingEnabled();
+    void flushTelemetryBatches();
 
     // Connection callbacks
     void setConnectionCallback(void (*callback)(bool connected));
@@ -86,9 +118,20 @@ public:
     // Statistics
     unsigned long getConnectionTime();
     int getReconnectionCount();
+    unsigned long getLastConnectLatency();     // ms from TCP SYN to CONNACK
+    unsigned long getLastTcpConnectLatency();  // ms from TCP SYN to established
+    unsigned long getAverageConnectLatency();
+    unsigned long getMaxConnectLatency();
+    uint32_t getConnectFailureCount();
+    unsigned long getRetryDelay();             // Backoff before the next attempt, 0 when connected
     int getPublishCount();
     int getFailedPublishCount();
     unsigned long getLastPublishTime();
+    int getDroppedMessageCount();
+    int getQueuedMessageCount();
+    uint32_t getTelemetryFrameCount();
+    uint32_t getBatchedRecordCount();
+    uint32_t getSuppressedStatusCount();  // Status/performance reports with nothing outside its deadband
 
 private:
     WiFiClient wifiClient;
@@ -97,6 +140,27 @@ private:
     MQTTStatus currentStatus;
     bool initialized;
     unsigned long lastReconnectAttempt;
+    std::atomic<bool> connectRequested;
+
+    // Connection state machine (subscriber task)
+    int brokerSocket;                // Non-blocking TCP connect in progress, -1 when none
+    IPAddress brokerAddress;
+    bool brokerResolved;
+    enum BrokerLookupState : uint8_t { LOOKUP_IDLE, LOOKUP_PENDING, LOOKUP_FOUND, LOOKUP_FAILED };
+    std::atomic<uint8_t> brokerLookup;   // Completed by the lwIP DNS callback on the tcpip thread
+    std::atomic<uint32_t> lookupAddress;
+    unsigned long nextAttemptTime;
+    unsigned long retryDelay;
+    int consecutiveFailures;
+    char clientId[32];               // Stable across reconnects so the broker resumes the session
+
+    // Connect latency
+    unsigned long lastTcpConnectLatency;
+    unsigned long lastConnectLatency;
+    unsigned long maxConnectLatency;
+    uint32_t connectLatencyTotal;
+    uint32_t connectSuccessCount;
+    uint32_t connectFailureCount;
     unsigned long connectionStartTime;
     unsigned long connectedTime;
     int reconnectionCount;
@@ -104,9 +168,31 @@ private:
     int publishCount;
     int failedPublishCount;
     unsigned long lastPublishTime;
+    int droppedMessageCount;
 
     void (*connectionCallback)(bool connected);
 
+    // Publish queue staging (producers build messages here before queueing,
+    // the publisher task dequeues into its own buffer)
+    SemaphoreHandle_t stagingMutex;
+    MQTTMessage stagingMessage;
+    MQTTMessage outgoingMessage;
+
+    // Heap-free JSON document shared by all producers (guarded by stagingMutex)
+    uint8_t jsonArena[MQTT_JSON_ARENA_SIZE];
+    StaticJsonAllocator jsonAllocator;
+    JsonDocument stagingDoc;
+
+    // Batched telemetry frames (guarded by stagingMutex)
+    bool telemetryBatching;
+    TelemetryBatch heartRateBatch;
+    TelemetryBatch movementBatch;
+
+    // Report-by-exception for the periodic status topics (DeviceManager task)
+    TelemetryDeadband systemStatusDeadband;
+    TelemetryDeadband timingDeadband;
+    TelemetryDeadband memoryDeadband;
+
     // FreeRTOS task management
     TaskHandle_t publisherTaskHandle;
     TaskHandle_t subscriberTaskHandle;
@@ -115,22 +201,53 @@ private:
     static void mqttSubscriberTask(void* parameter);
 
     // Connection management
-    void attemptConnection();
+    void runConnectionStateMachine();
+    void beginTcpConnect(unsigned long now);
+    void openBrokerSocket();
+    void pollBrokerLookup(unsigned long now);
+    void pollTcpConnect(unsigned long now);
+    void completeMqttHandshake();
+    void failConnectionAttempt(const char* reason);
+    void scheduleRetry(unsigned long now);
+    void closeBrokerSocket();
+    bool startBrokerLookup();
+    static void onBrokerLookup(const char* name, const ip_addr_t* address, void* arg);
     void handleConnectionEvents();
-    void updateConnectionStatus();
 
     // Publishing helpers
-    JsonDocument createBaseDocument();
-    bool publishWithRetry(const char* topic, const String& payload, bool retain = false);
+    bool beginMessage(const char* eventType, unsigned long timestamp = 0);  // 0 = now
+    bool commitMessage(const char* topic, bool retain = false, uint8_t priority = MQTT_PRIORITY_NORMAL);
+    bool serializeToStaging(const JsonDocument& doc, const char* topic);
+    bool submitStagedMessage(const char* topic, bool retain, uint8_t priority);
+    bool publishWithRetry(const char* topic, const uint8_t* payload, size_t length, bool retain = false);
+
+    // Batched telemetry helpers
+    bool batchHeartRate(float heartRate, float spO2, const String& quality,
+                        bool fingerDetected, const String& sessionId);
+    bool batchMovement(int servoIndex, unsigned long startTime, unsigned long duration,
+                       bool successful, int startAngle, int targetAngle, int actualAngle,
+                       float smoothness, const String& movementType, const String& sessionId);
+    bool submitTelemetryFrame(TelemetryBatch& batch);
+    void flushDueTelemetryBatches();
+
+    // Delta status helpers (stagingMutex held since beginMessage)
+    void beginDeltaReport(TelemetryDeadband& report);
+    bool commitDeltaReport(TelemetryDeadband& report, const char* topic);
+
+    // Publish queue processing (publisher task only)
+    bool dequeueMessage(MQTTMessage* message);
+    void processPublishQueue();
 
     // Logging and notifications
     void logConnectionStatus();
     void notifyConnectionChange(bool connected);
 
     // Configuration
-    static const int MAX_CONNECTION_ATTEMPTS = 3;
-    static const unsigned long CONNECTION_TIMEOUT = 10000;  // 10 seconds
+    static const int MAX_CONNECTION_ATTEMPTS = 3;           // Consecutive failures before an error is reported
+    static const int MAX_BACKOFF_EXPONENT = 10;
     static const int PUBLISH_RETRY_COUNT = 2;
+    static const unsigned long PUBLISHER_IDLE_TIMEOUT = 1000;  // Backlog check while idle
+    static const unsigned long STAGING_LOCK_TIMEOUT = 10;      // Max wait for the staging buffer
 };
 
 #endif
@@ -0,0 +1,169 @@
+#include "TelemetryBatch.h"
+#include "../utils/TimeManager.h"
+#include <string.h>
+
+TelemetryBatch::TelemetryBatch(TelemetryFrameType type)
+    : recordSize(type == TelemetryFrameType::MOVEMENT ? sizeof(MovementRecord) : sizeof(HeartRateRecord)),
+      nextSequence(0), framesBuilt(0), recordsBatched(0) {
+    memset(&header, 0, sizeof(header));
+    header.magic[0] = TELEMETRY_FRAME_MAGIC_0;
+    header.magic[1] = TELEMETRY_FRAME_MAGIC_1;
+    header.version = TELEMETRY_FRAME_VERSION;
+    header.frameType = (uint8_t)type;
+    header.recordSize = (uint8_t)recordSize;
+}
+
+// =============================================================================
+// RECORD ACCUMULATION
+// =============================================================================
+
+bool TelemetryBatch::addHeartRate(unsigned long timeMs, float heartRate, float spO2,
+                                  uint8_t quality, bool fingerDetected, const String& sessionId) {
+    if (header.frameType != (uint8_t)TelemetryFrameType::HEART_RATE) return false;
+
+    HeartRateRecord* record = (HeartRateRecord*)reserveRecord(timeMs, sessionId);
+    if (!record) return false;
+
+    record->offsetMs = (uint16_t)(timeMs - header.baseMillis);
+    record->heartRateX10 = clampU16(heartRate * 10.0f);
+    record->spO2X10 = clampU16(spO2 * 10.0f);
+    record->quality = quality;
+    record->flags = fingerDetected ? TELEMETRY_FLAG_FINGER_DETECTED : 0;
+
+    return true;
+}
+
+bool TelemetryBatch::addMovement(unsigned long endTimeMs, unsigned long duration, int servoIndex,
+                                 bool successful, int startAngle, int targetAngle, int actualAngle,
+                                 float smoothness, uint8_t movementType, const String& sessionId) {
+    if (header.frameType != (uint8_t)TelemetryFrameType::MOVEMENT) return false;
+
+    MovementRecord* record = (MovementRecord*)reserveRecord(endTimeMs, sessionId);
+    if (!record) return false;
+
+    record->endOffsetMs = (uint16_t)(endTimeMs - header.baseMillis);
+    record->durationMs = (duration > 0xFFFF) ? 0xFFFF : (uint16_t)duration;
+    record->servoIndex = clampU8(servoIndex);
+    record->flags = successful ? TELEMETRY_FLAG_SUCCESSFUL : 0;
+    record->startAngle = clampU8(startAngle);
+    record->targetAngle = clampU8(targetAngle);
+    record->actualAngle = clampU8(actualAngle);
+    record->movementType = movementType;
+    record->smoothnessX100 = clampU16(smoothness * 100.0f);
+
+    return true;
+}
+
+void* TelemetryBatch::reserveRecord(unsigned long timeMs, const String& sessionId) {
+    if (!acceptsRecord(timeMs, sessionId)) return nullptr;
+
+    if (header.recordCount == 0) {
+        startFrame(timeMs, sessionId);
+    }
+
+    void* slot = records + header.recordCount * recordSize;
+    header.recordCount++;
+    recordsBatched++;
+    return slot;
+}
+
+void TelemetryBatch::startFrame(unsigned long timeMs, const String& sessionId) {
+    header.baseMillis = timeMs;
+    header.baseTimestamp = TimeManager::getCurrentTimestamp() - (millis() - timeMs) / 1000;
+
+    // Zero padded, not terminated - a full-length ID fills the field
+    size_t length = sessionId.length();
+    if (length > sizeof(header.sessionId)) length = sizeof(header.sessionId);
+    memset(header.sessionId, 0, sizeof(header.sessionId));
+    memcpy(header.sessionId, sessionId.c_str(), length);
+}
+
+// =============================================================================
+// FLUSH DECISIONS
+// =============================================================================
+
+bool TelemetryBatch::isEmpty() const {
+    return header.recordCount == 0;
+}
+
+bool TelemetryBatch::isFull() const {
+    return header.recordCount >= TELEMETRY_BATCH_MAX_RECORDS;
+}
+
+bool TelemetryBatch::isDue(unsigned long now) const {
+    return !isEmpty() && (now - header.baseMillis >= TELEMETRY_BATCH_FLUSH_INTERVAL);
+}
+
+bool TelemetryBatch::acceptsRecord(unsigned long timeMs, const String& sessionId) const {
+    if (isEmpty()) return true;
+    if (isFull()) return false;
+
+    // Offsets are 16-bit and must not go backwards
+    if (timeMs - header.baseMillis > MAX_RECORD_OFFSET) return false;
+
+    // A frame belongs to exactly one session (an ID too long for the field matches nothing)
+    return sessionId.length() <= sizeof(header.sessionId) &&
+           strncmp(header.sessionId, sessionId.c_str(), sizeof(header.sessionId)) == 0;
+}
+
+size_t TelemetryBatch::writeFrame(uint8_t* buffer, size_t capacity) {
+    if (isEmpty()) return 0;
+
+    size_t length = sizeof(header) + header.recordCount * recordSize;
+    if (length > capacity) return 0;
+
+    header.sequence = nextSequence;
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(buffer + sizeof(header), records, header.recordCount * recordSize);
+
+    return length;
+}
+
+void TelemetryBatch::commitFrame() {
+    if (isEmpty()) return;
+
+    nextSequence++;
+    header.recordCount = 0;
+    framesBuilt++;
+}
+
+// =============================================================================
+// STATISTICS AND ENCODING HELPERS
+// =============================================================================
+
+uint32_t TelemetryBatch::getFramesBuilt() const {
+    return framesBuilt;
+}
+
+uint32_t TelemetryBatch::getRecordsBatched() const {
+    return recordsBatched;
+}
+
+uint8_t TelemetryBatch::qualityCode(const String& quality) {
+    if (quality == "good") return TELEMETRY_QUALITY_GOOD;
+    if (quality == "fair") return TELEMETRY_QUALITY_FAIR;
+    if (quality == "poor") return TELEMETRY_QUALITY_POOR;
+    if (quality == "no_signal") return TELEMETRY_QUALITY_NO_SIGNAL;
+    return TELEMETRY_QUALITY_UNKNOWN;
+}
+
+uint8_t TelemetryBatch::movementCode(const String& movementType) {
+    if (movementType == "sequential") return TELEMETRY_MOVEMENT_SEQUENTIAL;
+    if (movementType == "simultaneous") return TELEMETRY_MOVEMENT_SIMULTANEOUS;
+    if (movementType == "home") return TELEMETRY_MOVEMENT_HOME;
+    if (movementType == "profile") return TELEMETRY_MOVEMENT_PROFILE;
+    if (movementType == "exercise") return TELEMETRY_MOVEMENT_EXERCISE;
+    return TELEMETRY_MOVEMENT_UNKNOWN;
+}
+
+uint16_t TelemetryBatch::clampU16(float value) {
+    if (value <= 0.0f) return 0;
+    if (value >= 65535.0f) return 65535;
+    return (uint16_t)(value + 0.5f);
+}
+
+uint8_t TelemetryBatch::clampU8(int value) {
+    if (value < 0) return 0;
+    if (value > 255) return 255;
+    return (uint8_t)value;
+}
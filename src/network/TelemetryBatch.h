@@ -0,0 +1,147 @@
+#ifndef TELEMETRY_BATCH_H
+#define TELEMETRY_BATCH_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+
+// =============================================================================
+// BATCHED TELEMETRY FRAME LAYOUT
+// =============================================================================
+
+/**
+ * Compact binary frames published on TOPIC_TELEMETRY_BATCH.
+ *
+ * A frame is a fixed 36 byte header followed by recordCount fixed-size
+ * records of one type. All fields are little-endian (native ESP32 order).
+ * Record times are millisecond offsets from the header's baseMillis, which
+ * corresponds to baseTimestamp (Unix seconds) on the device clock.
+ * The decoder lives in mqtt-bridge/mqtt_to_db.js (decodeTelemetryFrame).
+ */
+
+const uint8_t TELEMETRY_FRAME_MAGIC_0 = 'R';
+const uint8_t TELEMETRY_FRAME_MAGIC_1 = 'T';
+const uint8_t TELEMETRY_FRAME_VERSION = 2;  // 1 had a 16 byte session ID
+
+enum class TelemetryFrameType : uint8_t {
+    HEART_RATE = 1,
+    MOVEMENT = 2
+};
+
+struct __attribute__((packed)) TelemetryFrameHeader {
+    uint8_t magic[2];        // 'R', 'T'
+    uint8_t version;         // TELEMETRY_FRAME_VERSION
+    uint8_t frameType;       // TelemetryFrameType
+    uint8_t recordCount;
+    uint8_t recordSize;      // Lets the decoder skip records it does not know
+    uint16_t sequence;       // Per frame type, wraps at 65535
+    uint32_t baseTimestamp;  // Unix seconds at baseMillis
+    uint32_t baseMillis;     // millis() when the first record was added
+    char sessionId[ANALYTICS_SESSION_ID_SIZE];  // Zero padded, empty outside sessions
+};
+
+struct __attribute__((packed)) HeartRateRecord {
+    uint16_t offsetMs;       // Reading time - baseMillis
+    uint16_t heartRateX10;   // BPM * 10
+    uint16_t spO2X10;        // % * 10
+    uint8_t quality;         // TelemetryQualityCode
+    uint8_t flags;           // TELEMETRY_FLAG_FINGER_DETECTED
+};
+
+struct __attribute__((packed)) MovementRecord {
+    uint16_t endOffsetMs;    // Movement end time - baseMillis
+    uint16_t durationMs;     // Start time = end - duration
+    uint8_t servoIndex;
+    uint8_t flags;           // TELEMETRY_FLAG_SUCCESSFUL
+    uint8_t startAngle;
+    uint8_t targetAngle;
+    uint8_t actualAngle;
+    uint8_t movementType;    // TelemetryMovementCode
+    uint16_t smoothnessX100; // % * 100
+};
+
+static_assert(sizeof(TelemetryFrameHeader) == 36, "Telemetry frame header layout changed");
+static_assert(sizeof(HeartRateRecord) == 8, "Heart rate record layout changed");
+static_assert(sizeof(MovementRecord) == 12, "Movement record layout changed");
+static_assert(sizeof(TelemetryFrameHeader) + TELEMETRY_BATCH_MAX_RECORDS * sizeof(MovementRecord) <= MAX_MQTT_MESSAGE_SIZE,
+              "Telemetry frame does not fit in an MQTT queue slot");
+
+// Signal quality codes (matches the JSON signal_quality strings)
+enum TelemetryQualityCode : uint8_t {
+    TELEMETRY_QUALITY_UNKNOWN = 0,
+    TELEMETRY_QUALITY_GOOD = 1,
+    TELEMETRY_QUALITY_FAIR = 2,
+    TELEMETRY_QUALITY_POOR = 3,
+    TELEMETRY_QUALITY_NO_SIGNAL = 4
+};
+
+// Movement type codes (matches the JSON movement_type strings)
+enum TelemetryMovementCode : uint8_t {
+    TELEMETRY_MOVEMENT_UNKNOWN = 0,
+    TELEMETRY_MOVEMENT_SEQUENTIAL = 1,
+    TELEMETRY_MOVEMENT_SIMULTANEOUS = 2,
+    TELEMETRY_MOVEMENT_HOME = 3,
+    TELEMETRY_MOVEMENT_PROFILE = 4,
+    TELEMETRY_MOVEMENT_EXERCISE = 5
+};
+
+const uint8_t TELEMETRY_FLAG_FINGER_DETECTED = 0x01;
+const uint8_t TELEMETRY_FLAG_SUCCESSFUL = 0x01;
+
+// =============================================================================
+// TELEMETRY BATCH BUILDER
+// =============================================================================
+
+/**
+ * Accumulates records of one type into a frame until it is full, too old
+ * or the session changes. Not thread-safe - MQTTManager guards its batches
+ * with the publish staging mutex.
+ */
+class TelemetryBatch {
+public:
+    explicit TelemetryBatch(TelemetryFrameType type);
+
+    // Record accumulation (returns false if the frame must be flushed first)
+    bool addHeartRate(unsigned long timeMs, float heartRate, float spO2,
+                      uint8_t quality, bool fingerDetected, const String& sessionId);
+    bool addMovement(unsigned long endTimeMs, unsigned long duration, int servoIndex,
+                     bool successful, int startAngle, int targetAngle, int actualAngle,
+                     float smoothness, uint8_t movementType, const String& sessionId);
+
+    // Flush decisions
+    bool isEmpty() const;
+    bool isFull() const;
+    bool isDue(unsigned long now) const;
+    bool acceptsRecord(unsigned long timeMs, const String& sessionId) const;
+
+    // Writes the frame to buffer and returns its length, or 0 if it is empty
+    // or does not fit. The frame is kept until commitFrame() - call that once
+    // the copy was handed off, so a failed submit can be retried.
+    size_t writeFrame(uint8_t* buffer, size_t capacity);
+    void commitFrame();
+
+    // Statistics
+    uint32_t getFramesBuilt() const;
+    uint32_t getRecordsBatched() const;
+
+    // Encoding helpers for the string fields used by the JSON API
+    static uint8_t qualityCode(const String& quality);
+    static uint8_t movementCode(const String& movementType);
+
+private:
+    TelemetryFrameHeader header;
+    uint8_t records[TELEMETRY_BATCH_MAX_RECORDS * sizeof(MovementRecord)];
+    size_t recordSize;
+    uint16_t nextSequence;
+    uint32_t framesBuilt;
+    uint32_t recordsBatched;
+
+    void* reserveRecord(unsigned long timeMs, const String& sessionId);
+    void startFrame(unsigned long timeMs, const String& sessionId);
+
+    static uint16_t clampU16(float value);
+    static uint8_t clampU8(int value);
+
+    static const unsigned long MAX_RECORD_OFFSET = 65535;  // uint16 millisecond offsets
+};
+
+#endif
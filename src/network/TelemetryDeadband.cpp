@@ -0,0 +1,113 @@
+#include "TelemetryDeadband.h"
+#include <math.h>
+
+TelemetryDeadband::TelemetryDeadband(const DeadbandField* fields, uint8_t fieldCount)
+    : fields(fields), fieldCount(fieldCount < MAX_FIELDS ? fieldCount : MAX_FIELDS),
+      stagedMask(0), reportTime(0), fullReport(true), fullPending(true), fullRequested(false),
+      reportCount(0), suppressedCount(0) {
+    for (uint8_t i = 0; i < MAX_FIELDS; i++) {
+        sentValue[i] = 0.0f;
+        sentHash[i] = 0;
+        sentTime[i] = 0;
+        stagedValue[i] = 0.0f;
+        stagedHash[i] = 0;
+    }
+}
+
+// =============================================================================
+// REPORTING
+// =============================================================================
+
+void TelemetryDeadband::beginReport(unsigned long now) {
+    reportTime = now;
+    stagedMask = 0;
+
+    // Kept until a full report is actually committed
+    if (fullRequested.exchange(false)) fullPending = true;
+    fullReport = fullPending;
+}
+
+bool TelemetryDeadband::offer(uint8_t field, float value) {
+    if (field >= fieldCount) return false;
+
+    bool include = fullReport || isDue(field);
+    if (!include) {
+        // Against the last value sent, so slow drift still crosses the deadband eventually
+        float change = fabsf(value - sentValue[field]);
+        include = fields[field].deadband > 0.0f ? change > fields[field].deadband : change != 0.0f;
+    }
+    if (!include) return false;
+
+    stagedValue[field] = value;
+    stagedHash[field] = sentHash[field];
+    stagedMask |= (1 << field);
+    return true;
+}
+
+bool TelemetryDeadband::offerText(uint8_t field, const char* text) {
+    if (field >= fieldCount) return false;
+
+    uint32_t hash = hashText(text);
+    if (!fullReport && !isDue(field) && hash == sentHash[field]) return false;
+
+    stagedValue[field] = sentValue[field];
+    stagedHash[field] = hash;
+    stagedMask |= (1 << field);
+    return true;
+}
+
+bool TelemetryDeadband::isFullReport() const {
+    return fullReport;
+}
+
+uint8_t TelemetryDeadband::getChangedCount() const {
+    return __builtin_popcount(stagedMask);
+}
+
+void TelemetryDeadband::commit() {
+    reportCount++;
+    if (stagedMask == 0) {
+        suppressedCount++;
+        return;
+    }
+
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        if (!(stagedMask & (1 << i))) continue;
+        sentValue[i] = stagedValue[i];
+        sentHash[i] = stagedHash[i];
+        sentTime[i] = reportTime;
+    }
+
+    if (fullReport) fullPending = false;
+    stagedMask = 0;
+}
+
+void TelemetryDeadband::invalidate() {
+    fullRequested.store(true);
+}
+
+bool TelemetryDeadband::isDue(uint8_t field) const {
+    return reportTime - sentTime[field] >= fields[field].maxSilence;
+}
+
+uint32_t TelemetryDeadband::hashText(const char* text) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const char* c = text ? text : ""; *c; c++) {
+        hash ^= (uint8_t)*c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+uint32_t TelemetryDeadband::getReportCount() {
+    return reportCount;
+}
+
+uint32_t TelemetryDeadband::getSuppressedCount() {
+    return suppressedCount;
+}
@@ -0,0 +1,80 @@
+#ifndef TELEMETRY_DEADBAND_H
+#define TELEMETRY_DEADBAND_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../config/Config.h"
+
+// =============================================================================
+// REPORT-BY-EXCEPTION FILTER
+// =============================================================================
+
+/**
+ * Per-field deadband and heartbeat for a periodic JSON status message.
+ *
+ * Each report offers every field's current value. A field goes out when it
+ * moved more than its deadband from the last value sent, or when it has
+ * been silent for its max silence (the heartbeat that lets a receiver that
+ * missed a delta converge). Text fields are compared by hash. The first
+ * report, and the one after invalidate(), is full; later ones are deltas
+ * of the changed fields only, merged into the last known state by the
+ * bridge (mqtt-bridge/mqtt_to_db.js, mergeStatusDelta).
+ *
+ * A report is staged until commit(), so a message that could not be queued
+ * is offered again on the next report. One task reports; invalidate() is
+ * safe from any task.
+ */
+
+struct DeadbandField {
+    const char* name;
+    float deadband;            // Absolute change that counts, 0 = any change
+    unsigned long maxSilence;  // Heartbeat, ms
+};
+
+class TelemetryDeadband {
+public:
+    TelemetryDeadband(const DeadbandField* fields, uint8_t fieldCount);
+
+    // Reporting task
+    void beginReport(unsigned long now);
+    bool offer(uint8_t field, float value);        // true -> include in this report
+    bool offerText(uint8_t field, const char* text);
+    bool isFullReport() const;
+    uint8_t getChangedCount() const;
+    void commit();                                 // The report was queued
+
+    // Any task - next report carries every field (reconnect, new subscriber)
+    void invalidate();
+
+    // Statistics
+    uint32_t getReportCount();
+    uint32_t getSuppressedCount();  // Reports with nothing to send
+
+    static const uint8_t MAX_FIELDS = 12;
+
+private:
+    const DeadbandField* fields;
+    uint8_t fieldCount;
+
+    // Last value sent, per field
+    float sentValue[MAX_FIELDS];
+    uint32_t sentHash[MAX_FIELDS];
+    unsigned long sentTime[MAX_FIELDS];
+
+    // Report being built
+    float stagedValue[MAX_FIELDS];
+    uint32_t stagedHash[MAX_FIELDS];
+    uint16_t stagedMask;
+    unsigned long reportTime;
+    bool fullReport;
+    bool fullPending;
+
+    std::atomic<bool> fullRequested;
+    uint32_t reportCount;
+    uint32_t suppressedCount;
+
+    bool isDue(uint8_t field) const;
+    static uint32_t hashText(const char* text);
+};
+
+#endif
@@ -4,6 +4,9 @@
 #include "../utils/ErrorHandler.h"
 #include "../utils/TimeManager.h"
 #include "../hardware/FreeRTOSManager.h"
+#include "../hardware/ResourceProfiler.h"
+
+const char* WiFiManager::CACHE_NAMESPACE = "wifi";
 
 void WiFiManager::initialize() {
     if (initialized) return;
@@ -16,6 +19,10 @@ void WiFiManager::initialize() {
     connectedTime = 0;
     reconnectionCount = 0;
     connectionAttempts = 0;
+    phaseStartTime = 0;
+    lastConnectDuration = 0;
+    fastConnectCount = 0;
+    fastConnectAttempt = false;
     connectionCallback = nullptr;
     taskHandle = nullptr;
     taskRunning = false;
@@ -25,8 +32,12 @@ void WiFiManager::initialize() {
 
     initialized = true;
 
-    // Start initial connection attempt
-    scanNetworks();
+    loadConnectionCache();
+
+    // The blocking scan is only worth it when there is no known access point to go to directly
+    if (!cache.valid) {
+        scanNetworks();
+    }
     attemptConnection();
 
     // Start the WiFi management task
@@ -164,18 +175,64 @@ unsigned long WiFiManager::getLastReconnectAttempt() {
     return lastReconnectAttempt;
 }
 
+unsigned long WiFiManager::getLastConnectDuration() {
+    return lastConnectDuration;
+}
+
+int WiFiManager::getFastConnectCount() {
+    return fastConnectCount;
+}
+
+bool WiFiManager::hasCachedAccessPoint() {
+    return cache.valid;
+}
+
 void WiFiManager::attemptConnection() {
     if (currentStatus == WiFiStatus::CONNECTING) {
         return;  // Already attempting connection
     }
     
-    Logger::infof("Attempting to connect to: %s", WIFI_SSID);
-    
     currentStatus = WiFiStatus::CONNECTING;
     connectionStartTime = millis();
     lastReconnectAttempt = millis();
     connectionAttempts++;
     
+    if (WIFI_FAST_RECONNECT_ENABLED && cache.valid) {
+        beginFastConnection();
+    } else {
+        beginFullConnection();
+    }
+}
+
+void WiFiManager::beginFastConnection() {
+    Logger::infof("Attempting to connect to: %s (cached %02X:%02X:%02X:%02X:%02X:%02X, channel %d)",
+                 WIFI_SSID, cache.bssid[0], cache.bssid[1], cache.bssid[2],
+                 cache.bssid[3], cache.bssid[4], cache.bssid[5], cache.channel);
+    
+    fastConnectAttempt = true;
+    phaseStartTime = millis();
+    
+    if (WIFI_CACHE_STATIC_IP && cache.localIP != 0) {
+        // Skips the DHCP exchange; the lease was valid at the last connection
+        WiFi.config(IPAddress(cache.localIP), IPAddress(cache.gateway),
+                    IPAddress(cache.subnet), IPAddress(cache.dns));
+    }
+    
+    // Channel and BSSID given - the driver associates without scanning
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD, cache.channel, cache.bssid);
+}
+
+void WiFiManager::beginFullConnection() {
+    Logger::infof("Attempting to connect to: %s", WIFI_SSID);
+    
+    fastConnectAttempt = false;
+    phaseStartTime = millis();
+    
+    if (WIFI_CACHE_STATIC_IP) {
+        // Back to DHCP in case the cached lease is what failed
+        WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    }
+    
     WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
 }
 
@@ -191,22 +248,37 @@ void WiFiManager::handleConnectionEvents() {
 void WiFiManager::updateConnectionStatus() {
     wl_status_t wifiStatus = WiFi.status();
     
+    if (currentStatus == WiFiStatus::CONNECTING && fastConnectAttempt && wifiStatus != WL_CONNECTED &&
+        millis() - phaseStartTime > WIFI_FAST_CONNECT_TIMEOUT) {
+        // The access point moved channel or is gone - scan for the SSID instead
+        Logger::warning("Cached access point not reachable - falling back to full connect");
+        WiFi.disconnect();
+        beginFullConnection();
+        return;
+    }
+    
     switch (wifiStatus) {
         case WL_CONNECTED:
             if (currentStatus != WiFiStatus::CONNECTED) {
                 currentStatus = WiFiStatus::CONNECTED;
                 connectedTime = millis();
+                lastConnectDuration = connectedTime - connectionStartTime;
+                connectionAttempts = 0;
+                if (fastConnectAttempt) fastConnectCount++;
                 
-                Logger::info("WiFi connected!");
+                Logger::infof("WiFi connected in %lu ms (%s)", lastConnectDuration,
+                             fastConnectAttempt ? "cached access point" : "full connect");
                 logNetworkInfo();
+                saveConnectionCache();
                 
-                // Initialize time sync now that WiFi is connected
-                TimeManager::syncWithNTP();
+                // NTP completes in the background while the callback brings MQTT up
+                TimeManager::startNTPSync();
                 
                 notifyConnectionChange(true);
             }
             break;
             
+        case WL_NO_SSID_AVAIL:
         case WL_CONNECT_FAILED:
         case WL_CONNECTION_LOST:
         case WL_DISCONNECTED:
@@ -217,7 +289,7 @@ void WiFiManager::updateConnectionStatus() {
             
             if (currentStatus == WiFiStatus::CONNECTING) {
                 // Check for connection timeout
-                if (millis() - connectionStartTime > CONNECTION_TIMEOUT) {
+                if (millis() - phaseStartTime > CONNECTION_TIMEOUT) {
                     Logger::error("WiFi connection timeout");
                     currentStatus = WiFiStatus::CONNECTION_FAILED;
                     
@@ -238,6 +310,85 @@ void WiFiManager::updateConnectionStatus() {
     }
 }
 
+// =============================================================================
+// CONNECTION CACHE
+// =============================================================================
+
+void WiFiManager::loadConnectionCache() {
+    memset(&cache, 0, sizeof(cache));
+    
+    Preferences prefs;
+    if (!prefs.begin(CACHE_NAMESPACE, true)) {
+        LOG_DEBUG("No WiFi connection cache in NVS");
+        return;
+    }
+    
+    // An entry for another network is of no use
+    if (prefs.getString("ssid") == WIFI_SSID &&
+        prefs.getBytes("bssid", cache.bssid, sizeof(cache.bssid)) == sizeof(cache.bssid)) {
+        cache.channel = prefs.getUChar("channel", 0);
+        cache.localIP = prefs.getUInt("ip", 0);
+        cache.gateway = prefs.getUInt("gateway", 0);
+        cache.subnet = prefs.getUInt("subnet", 0);
+        cache.dns = prefs.getUInt("dns", 0);
+        cache.valid = cache.channel != 0;
+    }
+    prefs.end();
+    
+    if (cache.valid) {
+        Logger::infof("WiFi cache: channel %d%s", cache.channel,
+                     (WIFI_CACHE_STATIC_IP && cache.localIP != 0) ? ", static IP" : "");
+    }
+}
+
+void WiFiManager::saveConnectionCache() {
+    WiFiConnectionCache current;
+    memset(&current, 0, sizeof(current));
+    
+    uint8_t* bssid = WiFi.BSSID();
+    if (!bssid) return;
+    
+    memcpy(current.bssid, bssid, sizeof(current.bssid));
+    current.channel = (uint8_t)WiFi.channel();
+    current.localIP = (uint32_t)WiFi.localIP();
+    current.gateway = (uint32_t)WiFi.gatewayIP();
+    current.subnet = (uint32_t)WiFi.subnetMask();
+    current.dns = (uint32_t)WiFi.dnsIP();
+    current.valid = current.channel != 0;
+    
+    if (!current.valid) return;
+    
+    // Reconnects to the same access point leave NVS untouched - no flash wear
+    if (cache.valid && memcmp(&current, &cache, sizeof(current)) == 0) return;
+    
+    Preferences prefs;
+    if (!prefs.begin(CACHE_NAMESPACE, false)) {
+        Logger::warning("Failed to open NVS - WiFi connection not cached");
+        return;
+    }
+    prefs.putString("ssid", WIFI_SSID);
+    prefs.putBytes("bssid", current.bssid, sizeof(current.bssid));
+    prefs.putUChar("channel", current.channel);
+    prefs.putUInt("ip", current.localIP);
+    prefs.putUInt("gateway", current.gateway);
+    prefs.putUInt("subnet", current.subnet);
+    prefs.putUInt("dns", current.dns);
+    prefs.end();
+    
+    cache = current;
+    Logger::infof("WiFi connection cached (channel %d)", cache.channel);
+}
+
+void WiFiManager::clearConnectionCache() {
+    Preferences prefs;
+    if (prefs.begin(CACHE_NAMESPACE, false)) {
+        prefs.clear();
+        prefs.end();
+    }
+    memset(&cache, 0, sizeof(cache));
+    Logger::info("WiFi connection cache cleared");
+}
+
 void WiFiManager::logNetworkInfo() {
     Logger::infof("IP address: %s", getIPAddress().c_str());
     Logger::infof("Signal strength: %d dBm", getSignalStrength());
@@ -297,7 +448,7 @@ void WiFiManager::startTask() {
     BaseType_t result = xTaskCreatePinnedToCore(
         wifiManagerTask,
         "WiFiManager",
-        TASK_STACK_WIFI_MANAGER,
+        ResourceProfiler::getStackSize(ProfiledTask::WIFI_MANAGER),
         this,
         PRIORITY_WIFI_MANAGER,
         &taskHandle,
@@ -348,8 +499,10 @@ void WiFiManager::wifiManagerTask(void* parameter) {
         // Feed watchdog - now that FreeRTOS Manager is re-enabled
         FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
 
-        // Task runs every 1 second instead of continuous polling
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        // Poll quickly while associating so the connection is picked up without delay
+        unsigned long pollInterval = manager->currentStatus == WiFiStatus::CONNECTING ?
+            CONNECTING_POLL_INTERVAL_MS : IDLE_POLL_INTERVAL_MS;
+        vTaskDelay(pdMS_TO_TICKS(pollInterval));
     }
 
     Logger::info("WiFi Manager task ended");
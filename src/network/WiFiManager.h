@@ -3,10 +3,22 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include <Preferences.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include "../config/Config.h"
 
+// Last good association, persisted in NVS for the fast reconnect path
+struct WiFiConnectionCache {
+    bool valid;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t localIP;   // Last DHCP lease, reused when WIFI_CACHE_STATIC_IP is set
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+};
+
 enum class WiFiStatus {
     DISCONNECTED,
     CONNECTING,
@@ -53,6 +65,10 @@ public:
     unsigned long getConnectionTime();
     int getReconnectionCount();
     unsigned long getLastReconnectAttempt();
+    unsigned long getLastConnectDuration();  // ms from the attempt to association + IP
+    int getFastConnectCount();               // Connections made through the cached access point
+    bool hasCachedAccessPoint();
+    void clearConnectionCache();
 
 private:
     WiFiStatus currentStatus;
@@ -62,6 +78,12 @@ private:
     unsigned long connectedTime;
     int reconnectionCount;
     int connectionAttempts;
+    unsigned long phaseStartTime;      // Start of the current WiFi.begin
+    unsigned long lastConnectDuration;
+    int fastConnectCount;
+    bool fastConnectAttempt;           // Current attempt targets the cached BSSID/channel
+
+    WiFiConnectionCache cache;
 
     void (*connectionCallback)(bool connected);
 
@@ -72,9 +94,15 @@ private:
     
     // Connection management
     void attemptConnection();
+    void beginFastConnection();
+    void beginFullConnection();
     void handleConnectionEvents();
     void updateConnectionStatus();
     
+    // Connection cache (NVS)
+    void loadConnectionCache();
+    void saveConnectionCache();
+
     // Logging and notifications
     void logNetworkInfo();
     void logConnectionStatus();
@@ -83,6 +111,9 @@ private:
     // Configuration
     static const int MAX_CONNECTION_ATTEMPTS = 5;
     static const unsigned long CONNECTION_TIMEOUT = 10000;  // 10 seconds
+    static const unsigned long CONNECTING_POLL_INTERVAL_MS = 100;  // Notice the association quickly
+    static const unsigned long IDLE_POLL_INTERVAL_MS = 1000;
+    static const char* CACHE_NAMESPACE;
 };
 
 #endif
@@ -0,0 +1,145 @@
+#include "MPU6050.h"
+#include "../utils/Logger.h"
+
+// MPU6050 registers
+#define MPU6050_REG_SMPLRT_DIV 0x19
+#define MPU6050_REG_CONFIG 0x1A
+#define MPU6050_REG_GYRO_CONFIG 0x1B
+#define MPU6050_REG_ACCEL_CONFIG 0x1C
+#define MPU6050_REG_FIFO_EN 0x23
+#define MPU6050_REG_INT_PIN_CFG 0x37
+#define MPU6050_REG_INT_ENABLE 0x38
+#define MPU6050_REG_TEMP_OUT_H 0x41
+#define MPU6050_REG_USER_CTRL 0x6A
+#define MPU6050_REG_PWR_MGMT_1 0x6B
+#define MPU6050_REG_FIFO_COUNT_H 0x72
+#define MPU6050_REG_FIFO_R_W 0x74
+#define MPU6050_REG_WHO_AM_I 0x75
+
+#define MPU6050_WHO_AM_I_VALUE 0x68
+#define MPU6050_RESET 0x80
+#define MPU6050_SLEEP 0x40
+#define MPU6050_CLOCK_PLL_XGYRO 0x01
+#define MPU6050_DLPF_44HZ 0x03           // Accel 44Hz / gyro 42Hz, below the 50Hz Nyquist limit
+#define MPU6050_GYRO_500DPS 0x08
+#define MPU6050_ACCEL_4G 0x08
+#define MPU6050_FIFO_ACCEL_GYRO 0x78     // XG, YG, ZG and accel into the FIFO
+#define MPU6050_FIFO_ENABLE 0x40
+#define MPU6050_FIFO_RESET 0x04
+#define MPU6050_INT_DATA_READY 0x01
+
+MPU6050::MPU6050() : I2CDevice(I2C_ADDR_MPU6050, "MPU6050"), configured(false) {
+}
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+bool MPU6050::initialize() {
+    if (!performSelfTest()) {
+        Logger::errorf("MPU6050 not found at address 0x%02X", deviceAddress);
+        return false;
+    }
+
+    // Reset, then wake with the gyro PLL as clock (more stable than the internal oscillator)
+    writeRegister(MPU6050_REG_PWR_MGMT_1, MPU6050_RESET);
+    vTaskDelay(pdMS_TO_TICKS(100));
+    writeRegister(MPU6050_REG_PWR_MGMT_1, MPU6050_CLOCK_PLL_XGYRO);
+
+    // With the DLPF on the internal rate is 1kHz: rate = 1kHz / (1 + divider)
+    bool success = writeRegister(MPU6050_REG_CONFIG, MPU6050_DLPF_44HZ);
+    success &= writeRegister(MPU6050_REG_SMPLRT_DIV, (uint8_t)(1000 / MOTION_SAMPLING_RATE_HZ - 1));
+    success &= writeRegister(MPU6050_REG_GYRO_CONFIG, MPU6050_GYRO_500DPS);
+    success &= writeRegister(MPU6050_REG_ACCEL_CONFIG, MPU6050_ACCEL_4G);
+
+    // Active-high 50us pulse on every data-ready, no latch to clear
+    success &= writeRegister(MPU6050_REG_INT_PIN_CFG, 0x00);
+    success &= writeRegister(MPU6050_REG_INT_ENABLE, MPU6050_INT_DATA_READY);
+
+    success &= writeRegister(MPU6050_REG_FIFO_EN, MPU6050_FIFO_ACCEL_GYRO);
+    success &= resetFIFO();
+
+    configured = success;
+    healthy = success;
+
+    if (success) {
+        Logger::infof("MPU6050 configured: %lu Hz, DLPF 44 Hz, +-4 g, +-500 deg/s",
+                     (unsigned long)MOTION_SAMPLING_RATE_HZ);
+    } else {
+        Logger::error("MPU6050 configuration failed");
+    }
+
+    return success;
+}
+
+void MPU6050::shutdown() {
+    if (!configured) return;
+
+    writeRegister(MPU6050_REG_INT_ENABLE, 0x00);
+    writeRegister(MPU6050_REG_USER_CTRL, 0x00);
+    writeRegister(MPU6050_REG_PWR_MGMT_1, MPU6050_SLEEP);
+    configured = false;
+}
+
+bool MPU6050::performSelfTest() {
+    uint8_t whoAmI = 0;
+    return readRegister(MPU6050_REG_WHO_AM_I, &whoAmI) && whoAmI == MPU6050_WHO_AM_I_VALUE;
+}
+
+// =============================================================================
+// FIFO ACCESS
+// =============================================================================
+
+int MPU6050::getFIFOSampleCount() {
+    uint16_t bytes = 0;
+    if (!readRegister16(MPU6050_REG_FIFO_COUNT_H, &bytes)) return 0;
+
+    // A full FIFO has overwritten old data; a partial frame means we lost alignment
+    if (bytes >= FIFO_SIZE || bytes % FIFO_SAMPLE_BYTES != 0) {
+        return -1;
+    }
+
+    return bytes / FIFO_SAMPLE_BYTES;
+}
+
+bool MPU6050::readFIFOSamples(MPU6050Sample* samples, int count) {
+    if (!samples || count <= 0 || count > FIFO_MAX_SAMPLES_PER_READ) return false;
+
+    uint8_t raw[FIFO_MAX_SAMPLES_PER_READ * FIFO_SAMPLE_BYTES];  // Within I2C_MAX_TRANSFER_SIZE
+    if (!readRegisters(MPU6050_REG_FIFO_R_W, raw, count * FIFO_SAMPLE_BYTES)) return false;
+
+    for (int i = 0; i < count; i++) {
+        const uint8_t* bytes = raw + i * FIFO_SAMPLE_BYTES;
+        for (int axis = 0; axis < 3; axis++) {
+            samples[i].accel[axis] = (int16_t)((bytes[axis * 2] << 8) | bytes[axis * 2 + 1]);
+            samples[i].gyro[axis] = (int16_t)((bytes[6 + axis * 2] << 8) | bytes[6 + axis * 2 + 1]);
+        }
+    }
+
+    return true;
+}
+
+bool MPU6050::resetFIFO() {
+    // Reset clears the buffer; FIFO_EN must be set again in the same write
+    return writeRegister(MPU6050_REG_USER_CTRL, MPU6050_FIFO_ENABLE | MPU6050_FIFO_RESET);
+}
+
+bool MPU6050::readTemperature(float& celsius) {
+    uint16_t raw = 0;
+    if (!readRegister16(MPU6050_REG_TEMP_OUT_H, &raw)) return false;
+
+    celsius = (int16_t)raw / 340.0f + 36.53f;
+    return true;
+}
+
+// =============================================================================
+// UNIT CONVERSION
+// =============================================================================
+
+float MPU6050::accelToMs2(int16_t raw) {
+    return raw / ACCEL_LSB_PER_G * GRAVITY;
+}
+
+float MPU6050::gyroToDps(int16_t raw) {
+    return raw / GYRO_LSB_PER_DPS;
+}
@@ -0,0 +1,57 @@
+#ifndef MPU6050_H
+#define MPU6050_H
+
+#include <Arduino.h>
+#include "../config/Config.h"
+#include "../hardware/I2CManager.h"
+
+// One FIFO entry: accelerometer then gyroscope, raw big-endian counts
+struct MPU6050Sample {
+    int16_t accel[3];
+    int16_t gyro[3];
+};
+
+// =============================================================================
+// MPU6050 DRIVER
+// =============================================================================
+
+/**
+ * MPU6050 accelerometer/gyroscope on the shared I2C bus.
+ *
+ * The chip samples at MOTION_SAMPLING_RATE_HZ behind its digital low-pass
+ * filter and queues accel + gyro frames in its 1 KB hardware FIFO, pulsing
+ * INT on every new frame. Callers count pulses, then drain the FIFO in
+ * burst reads - the bus is touched once per batch, not once per sample.
+ */
+class MPU6050 : public I2CDevice {
+public:
+    MPU6050();
+
+    // I2CDevice
+    bool initialize() override;  // Reset, DLPF, sample rate, ranges, FIFO and data-ready interrupt
+    void shutdown() override;    // Sleep mode
+    bool performSelfTest() override;
+
+    // FIFO access
+    int getFIFOSampleCount();  // -1 on overflow or misalignment (FIFO needs a reset)
+    bool readFIFOSamples(MPU6050Sample* samples, int count);  // count <= FIFO_MAX_SAMPLES_PER_READ
+    bool resetFIFO();
+    bool readTemperature(float& celsius);
+
+    // Unit conversion for the configured ranges
+    static float accelToMs2(int16_t raw);
+    static float gyroToDps(int16_t raw);
+
+    static const int FIFO_SAMPLE_BYTES = 12;  // 6 bytes accel + 6 bytes gyro
+    static const int FIFO_MAX_SAMPLES_PER_READ = I2C_MAX_TRANSFER_SIZE / FIFO_SAMPLE_BYTES;  // 10 samples per transaction
+    static const int FIFO_SIZE = 1024;        // Bytes - 85 samples, 850ms at 100Hz
+
+private:
+    bool configured;
+
+    static constexpr float ACCEL_LSB_PER_G = 8192.0f;   // +-4g range
+    static constexpr float GYRO_LSB_PER_DPS = 65.5f;    // +-500 deg/s range
+    static constexpr float GRAVITY = 9.80665f;
+};
+
+#endif
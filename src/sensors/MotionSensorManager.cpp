@@ -0,0 +1,371 @@
+#include "MotionSensorManager.h"
+#include "../utils/Logger.h"
+#include "../hardware/FreeRTOSManager.h"
+#include "../hardware/ResourceProfiler.h"
+#include "../hardware/TaskTracer.h"
+#include <math.h>
+
+MotionSensorManager* MotionSensorManager::interruptInstance = nullptr;
+volatile uint8_t MotionSensorManager::pendingEdges = 0;
+
+MotionSensorManager::MotionSensorManager()
+    : initialized(false), taskRunning(false), sensorReady(false), taskHandle(nullptr),
+      calibrated(false), jointAngle(0.0f), jointAngleTime(0), latestIntensity(0.0f),
+      readingCallback(nullptr), sampleCount(0), fifoBurstCount(0), fifoOverflowCount(0),
+      interruptAttached(false) {
+}
+
+// =============================================================================
+// INITIALIZATION AND LIFECYCLE
+// =============================================================================
+
+void MotionSensorManager::initialize() {
+    if (initialized) {
+        Logger::warning("Motion Sensor Manager already initialized");
+        return;
+    }
+
+    Logger::info("Initializing Motion Sensor Manager...");
+
+    for (int axis = 0; axis < 3; axis++) {
+        gyroBias[axis] = 0.0f;
+        gyroBiasSum[axis] = 0.0f;
+    }
+    calibrationSamples = 0;
+    filterPrimed = false;
+    pitch = 0.0f;
+    referencePitch = 0.0f;
+    intensity = 0.0f;
+    temperature = 0.0f;
+    lastSampleTime = 0;
+    lastTemperatureRead = 0;
+    samplesSinceReport = 0;
+    calibrated.store(false);
+    jointAngle.store(0.0f);
+    jointAngleTime.store(0);
+    latestIntensity.store(0.0f);
+    rawStream.clear();
+    sampleCount = 0;
+    fifoBurstCount = 0;
+    fifoOverflowCount = 0;
+
+    // The I2C Manager owns the bus (initialized in the foundation phase)
+    if (!I2CManager::isInitialized()) {
+        Logger::error("I2C Manager not initialized - cannot start motion sensor");
+        return;
+    }
+
+    sensorReady = sensor.initialize();
+    if (!sensorReady) {
+        Logger::errorf("Expected wiring: MPU6050 SDA->GPIO%d, SCL->GPIO%d, INT->GPIO%d",
+                      I2C_SDA_PIN, I2C_SCL_PIN, I2C_MOTION_INT_PIN);
+        return;
+    }
+
+    initialized = true;
+
+    startTask();
+    attachSensorInterrupt();
+
+    Logger::info("Motion Sensor Manager initialized - hold the hand still for calibration");
+}
+
+void MotionSensorManager::shutdown() {
+    if (!initialized) return;
+
+    Logger::info("Shutting down Motion Sensor Manager...");
+
+    detachSensorInterrupt();
+    stopTask();
+    sensor.shutdown();
+
+    initialized = false;
+    Logger::info("Motion Sensor Manager shutdown complete");
+}
+
+// =============================================================================
+// FREERTOS TASK MANAGEMENT
+// =============================================================================
+
+void MotionSensorManager::startTask() {
+    if (taskRunning || taskHandle) return;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        motionSensorTask,
+        "MotionSensor",
+        ResourceProfiler::getStackSize(ProfiledTask::MOTION_SENSOR),
+        this,
+        PRIORITY_MOTION_SENSOR,
+        &taskHandle,
+        CORE_APPLICATION  // Core 1 for application tasks
+    );
+
+    if (result == pdPASS) {
+        taskRunning = true;
+        FreeRTOSManager::setMotionSensorTask(taskHandle);
+        Logger::info("Motion Sensor task started on Core 1");
+    } else {
+        Logger::error("Failed to create Motion Sensor task");
+    }
+}
+
+void MotionSensorManager::stopTask() {
+    if (!taskRunning || !taskHandle) return;
+
+    taskRunning = false;
+    FreeRTOSManager::setMotionSensorTask(nullptr);
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+
+    Logger::info("Motion Sensor task stopped");
+}
+
+bool MotionSensorManager::isTaskRunning() {
+    return taskRunning && taskHandle != nullptr;
+}
+
+void MotionSensorManager::attachSensorInterrupt() {
+    if (interruptAttached || !taskHandle) return;
+
+    interruptInstance = this;
+    pendingEdges = 0;
+    pinMode(I2C_MOTION_INT_PIN, INPUT_PULLDOWN);
+    attachInterrupt(digitalPinToInterrupt(I2C_MOTION_INT_PIN), dataReadyHandler, RISING);
+    interruptAttached = true;
+
+    Logger::infof("Motion sensor data-ready interrupt attached on GPIO%d (wake every %d samples)",
+                 I2C_MOTION_INT_PIN, MOTION_FIFO_BATCH);
+}
+
+void MotionSensorManager::detachSensorInterrupt() {
+    if (!interruptAttached) return;
+
+    detachInterrupt(digitalPinToInterrupt(I2C_MOTION_INT_PIN));
+    interruptAttached = false;
+    interruptInstance = nullptr;
+}
+
+void IRAM_ATTR MotionSensorManager::dataReadyHandler() {
+    MotionSensorManager* manager = interruptInstance;
+    if (!manager || !manager->taskHandle) return;
+
+    // Samples wait in the FIFO; only every MOTION_FIFO_BATCH-th one wakes the task
+    if (++pendingEdges < MOTION_FIFO_BATCH) return;
+    pendingEdges = 0;
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(manager->taskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+void MotionSensorManager::motionSensorTask(void* parameter) {
+    MotionSensorManager* manager = static_cast<MotionSensorManager*>(parameter);
+    Logger::info("Motion Sensor task started");
+
+    TraceId traceId = TaskTracer::registerTask("MotionSensor",
+                                               MOTION_FIFO_BATCH * SAMPLE_PERIOD_MS * 1000);
+
+    while (manager->taskRunning) {
+        // Sleep until a batch is in the FIFO; the timeout keeps the FIFO
+        // from overflowing if INT is not wired
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FIFO_POLL_TIMEOUT));
+        TaskTracer::ScopedTimer timer(traceId);
+
+        manager->updateSensor();
+    }
+
+    Logger::info("Motion Sensor task ended");
+    vTaskDelete(nullptr);  // Delete self
+}
+
+// =============================================================================
+// SENSOR STATUS AND DATA ACCESS
+// =============================================================================
+
+bool MotionSensorManager::isSensorConnected() {
+    return sensorReady && I2CManager::probeDevice(I2C_ADDR_MPU6050);
+}
+
+bool MotionSensorManager::isCalibrated() {
+    return calibrated.load();
+}
+
+bool MotionSensorManager::getJointAngle(int servoIndex, float& angle) {
+    if (servoIndex != MOTION_SENSOR_JOINT || !calibrated.load()) return false;
+
+    // Feedback from a stalled sensor is worse than none
+    if ((int32_t)(millis() - jointAngleTime.load()) > (int32_t)MOTION_FEEDBACK_MAX_AGE) return false;
+
+    angle = jointAngle.load();
+    return true;
+}
+
+float MotionSensorManager::getMovementIntensity() {
+    return latestIntensity.load();
+}
+
+MotionRawStream& MotionSensorManager::getRawStream() {
+    return rawStream;
+}
+
+void MotionSensorManager::setReadingCallback(void (*callback)(const MotionReading& reading)) {
+    readingCallback = callback;
+}
+
+uint32_t MotionSensorManager::getSampleCount() {
+    return sampleCount;
+}
+
+uint32_t MotionSensorManager::getFIFOBurstCount() {
+    return fifoBurstCount;
+}
+
+uint32_t MotionSensorManager::getFIFOOverflowCount() {
+    return fifoOverflowCount;
+}
+
+// =============================================================================
+// SENSOR PROCESSING
+// =============================================================================
+
+void MotionSensorManager::updateSensor() {
+    if (!initialized) return;
+
+    int pending = sensor.getFIFOSampleCount();
+    if (pending < 0) {
+        // Overflowed while the task was starved - drop the backlog and re-seed the filter
+        fifoOverflowCount++;
+        filterPrimed = false;
+        sensor.resetFIFO();
+        Logger::warning("MPU6050 FIFO overflow - samples dropped");
+        return;
+    }
+    if (pending == 0) return;
+
+    // Samples were taken at the sensor rate - the newest one is "now"
+    uint32_t now = millis();
+    int processed = 0;
+
+    while (processed < pending) {
+        int chunk = pending - processed;
+        if (chunk > MPU6050::FIFO_MAX_SAMPLES_PER_READ) chunk = MPU6050::FIFO_MAX_SAMPLES_PER_READ;
+
+        if (!sensor.readFIFOSamples(fifoSamples, chunk)) break;
+
+        for (int i = 0; i < chunk; i++) {
+            uint32_t sampleTime = now - (pending - 1 - processed - i) * SAMPLE_PERIOD_MS;
+            processSample(fifoSamples[i], sampleTime);
+        }
+        processed += chunk;
+    }
+
+    fifoBurstCount++;
+
+    if (now - lastTemperatureRead >= TEMPERATURE_INTERVAL) {
+        sensor.readTemperature(temperature);
+        lastTemperatureRead = now;
+    }
+}
+
+void MotionSensorManager::processSample(const MPU6050Sample& raw, uint32_t timestamp) {
+    float accel[3];
+    float gyro[3];
+    for (int axis = 0; axis < 3; axis++) {
+        accel[axis] = MPU6050::accelToMs2(raw.accel[axis]);
+        gyro[axis] = MPU6050::gyroToDps(raw.gyro[axis]);
+    }
+    sampleCount++;
+
+    if (!calibrated.load()) {
+        calibrate(gyro, accel);
+        return;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        gyro[axis] -= gyroBias[axis];
+    }
+
+    MotionRawSample* slot = rawStream.beginWrite();
+    if (slot) {
+        slot->timestamp = timestamp;
+        memcpy(slot->accel, accel, sizeof(accel));
+        memcpy(slot->gyro, gyro, sizeof(gyro));
+        rawStream.commitWrite();
+    }
+
+    // Complementary filter: the gyro tracks fast rotation, gravity removes its drift
+    uint32_t gap = timestamp - lastSampleTime;
+    if (!filterPrimed || gap > MAX_FILTER_GAP) {
+        pitch = accelPitch(accel);
+        filterPrimed = true;
+    } else {
+        float dt = gap / 1000.0f;
+        pitch = COMPLEMENTARY_ALPHA * (pitch + gyro[1] * dt) + (1.0f - COMPLEMENTARY_ALPHA) * accelPitch(accel);
+    }
+    lastSampleTime = timestamp;
+
+    float angularSpeed = sqrtf(gyro[0] * gyro[0] + gyro[1] * gyro[1] + gyro[2] * gyro[2]);
+    intensity += INTENSITY_ALPHA * (angularSpeed - intensity);
+
+    // Joint angle relative to the resting pose the servos start from
+    jointAngle.store(SERVO_MIN_ANGLE + MOTION_JOINT_AXIS_SIGN * (pitch - referencePitch));
+    jointAngleTime.store(timestamp);
+    latestIntensity.store(intensity);
+
+    if (++samplesSinceReport >= SAMPLES_PER_REPORT) {
+        samplesSinceReport = 0;
+        reportReading(accel, gyro, timestamp);
+    }
+}
+
+void MotionSensorManager::calibrate(const float* gyro, const float* accel) {
+    // Any real rotation invalidates the bias estimate
+    for (int axis = 0; axis < 3; axis++) {
+        if (fabsf(gyro[axis]) > CALIBRATION_MAX_RATE) {
+            calibrationSamples = 0;
+            gyroBiasSum[0] = gyroBiasSum[1] = gyroBiasSum[2] = 0.0f;
+            return;
+        }
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        gyroBiasSum[axis] += gyro[axis];
+    }
+
+    if (++calibrationSamples < CALIBRATION_SAMPLES) return;
+
+    for (int axis = 0; axis < 3; axis++) {
+        gyroBias[axis] = gyroBiasSum[axis] / calibrationSamples;
+    }
+    referencePitch = accelPitch(accel);
+    filterPrimed = false;
+    calibrated.store(true);
+
+    Logger::infof("Motion sensor calibrated: gyro bias %.2f/%.2f/%.2f deg/s, reference pitch %.1f deg",
+                 gyroBias[0], gyroBias[1], gyroBias[2], referencePitch);
+}
+
+void MotionSensorManager::reportReading(const float* accel, const float* gyro, uint32_t timestamp) {
+    if (!readingCallback) return;
+
+    MotionReading reading;
+    reading.timestamp = timestamp;
+    reading.quality = 1.0f;
+    reading.valid = true;
+    reading.sensorId = I2C_ADDR_MPU6050;
+    reading.accelX = accel[0];
+    reading.accelY = accel[1];
+    reading.accelZ = accel[2];
+    reading.gyroX = gyro[0];
+    reading.gyroY = gyro[1];
+    reading.gyroZ = gyro[2];
+    reading.temperature = temperature;
+    reading.motionDetected = intensity > MOTION_DETECT_THRESHOLD;
+    reading.movementIntensity = intensity;
+
+    readingCallback(reading);
+}
+
+float MotionSensorManager::accelPitch(const float* accel) {
+    return atan2f(-accel[0], sqrtf(accel[1] * accel[1] + accel[2] * accel[2])) * RAD_TO_DEG;
+}
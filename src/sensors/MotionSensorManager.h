@@ -0,0 +1,136 @@
+#ifndef MOTION_SENSOR_MANAGER_H
+#define MOTION_SENSOR_MANAGER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config/Config.h"
+#include "../hardware/I2CManager.h"
+#include "../memory/SPSCRingBuffer.h"
+#include "MPU6050.h"
+
+// Bias-corrected sample as drained from the sensor FIFO
+struct MotionRawSample {
+    uint32_t timestamp;
+    float accel[3];  // m/s^2
+    float gyro[3];   // deg/s
+};
+
+// Every FIFO sample, for one raw-data consumer
+typedef SPSCRingBuffer<MotionRawSample, STREAM_SIZE_MOTION_RAW> MotionRawStream;
+
+/**
+ * Hand motion from the MPU6050 on joint MOTION_SENSOR_JOINT.
+ *
+ * The sensor's data-ready interrupt only counts edges; every
+ * MOTION_FIFO_BATCH samples the task wakes and drains the FIFO in burst
+ * reads, so 100Hz sampling costs about 25 short wake-ups per second on
+ * core 1. Each sample runs through a complementary filter (gyro integration
+ * corrected by the accelerometer's gravity direction) giving the segment's
+ * pitch, which relative to the resting pose at boot is the joint angle.
+ *
+ * movementIntensity is the smoothed angular speed in deg/s. Readings are
+ * handed out at MOTION_REPORTING_RATE_HZ through the reading callback.
+ */
+class MotionSensorManager {
+public:
+    MotionSensorManager();
+
+    // Initialization and lifecycle
+    void initialize();
+    void shutdown();
+
+    // FreeRTOS task management
+    void startTask();
+    void stopTask();
+    bool isTaskRunning();
+
+    // Sensor status
+    bool isSensorConnected();
+    bool isCalibrated();
+
+    // Joint feedback - safe from any task
+    bool getJointAngle(int servoIndex, float& angle);  // false for other joints or stale data
+    float getMovementIntensity();
+
+    // Data access
+    MotionRawStream& getRawStream();
+    void setReadingCallback(void (*callback)(const MotionReading& reading));  // Called on the motion task
+
+    // Statistics
+    uint32_t getSampleCount();
+    uint32_t getFIFOBurstCount();
+    uint32_t getFIFOOverflowCount();
+
+private:
+    MPU6050 sensor;
+    bool initialized;
+    bool taskRunning;
+    bool sensorReady;
+    TaskHandle_t taskHandle;
+
+    // Burst buffer (one I2C transaction)
+    MPU6050Sample fifoSamples[MPU6050::FIFO_MAX_SAMPLES_PER_READ];
+
+    // Filter state (motion task only)
+    float gyroBias[3];
+    float gyroBiasSum[3];
+    int calibrationSamples;
+    bool filterPrimed;
+    float pitch;           // Segment flexion, degrees about the sensor Y axis
+    float referencePitch;
+    float intensity;
+    float temperature;
+    uint32_t lastSampleTime;
+    unsigned long lastTemperatureRead;
+    int samplesSinceReport;
+
+    // Published for other tasks
+    std::atomic<bool> calibrated;
+    std::atomic<float> jointAngle;
+    std::atomic<uint32_t> jointAngleTime;
+    std::atomic<float> latestIntensity;
+
+    // Output
+    MotionRawStream rawStream;
+    void (*readingCallback)(const MotionReading& reading);
+
+    // Statistics
+    uint32_t sampleCount;
+    uint32_t fifoBurstCount;
+    uint32_t fifoOverflowCount;
+
+    // Task function
+    static void motionSensorTask(void* parameter);
+
+    // Sensor interrupt (MPU6050 INT pin, data ready)
+    static MotionSensorManager* interruptInstance;
+    static volatile uint8_t pendingEdges;
+    static void dataReadyHandler();
+    bool interruptAttached;
+    void attachSensorInterrupt();
+    void detachSensorInterrupt();
+
+    // Processing
+    void updateSensor();
+    void processSample(const MPU6050Sample& raw, uint32_t timestamp);
+    void calibrate(const float* gyro, const float* accel);
+    void reportReading(const float* accel, const float* gyro, uint32_t timestamp);
+
+    static float accelPitch(const float* accel);
+
+    // Configuration constants
+    static const unsigned long SAMPLE_PERIOD_MS = 1000 / MOTION_SAMPLING_RATE_HZ;
+    static const int SAMPLES_PER_REPORT = MOTION_SAMPLING_RATE_HZ / MOTION_REPORTING_RATE_HZ;
+    static const unsigned long FIFO_POLL_TIMEOUT = 200;          // Fallback poll if INT is not wired (< 850ms FIFO)
+    static const unsigned long MAX_FILTER_GAP = 100;             // Re-seed the filter from the accelerometer after a gap
+    static const unsigned long TEMPERATURE_INTERVAL = 1000;      // ms between die temperature reads
+    static const int CALIBRATION_SAMPLES = 100;                  // 1 second at rest for gyro bias and reference pose
+    static constexpr float CALIBRATION_MAX_RATE = 20.0f;         // deg/s - faster means the hand moved, start over
+    static constexpr float COMPLEMENTARY_ALPHA = 0.98f;          // Gyro weight, ~0.5s accelerometer time constant
+    static constexpr float INTENSITY_ALPHA = 0.1f;               // EWMA weight of the newest angular speed
+    static constexpr float MOTION_DETECT_THRESHOLD = 15.0f;      // deg/s
+};
+
+#endif
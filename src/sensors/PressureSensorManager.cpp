@@ -0,0 +1,354 @@
+#include "PressureSensorManager.h"
+#include "../utils/Logger.h"
+#include "../hardware/FreeRTOSManager.h"
+#include "../hardware/ResourceProfiler.h"
+#include "../hardware/TaskTracer.h"
+
+PressureSensorManager::PressureSensorManager()
+    : initialized(false), taskRunning(false), adcRunning(false), taskHandle(nullptr),
+      tareReadings{}, calibrated(false), contactMask(0), readingCallback(nullptr),
+      readingCount(0), frameCount(0), overrunCount(0), contactCount(0) {
+}
+
+// =============================================================================
+// INITIALIZATION AND LIFECYCLE
+// =============================================================================
+
+void PressureSensorManager::initialize() {
+    if (initialized) {
+        Logger::warning("Pressure Sensor Manager already initialized");
+        return;
+    }
+
+    Logger::info("Initializing Pressure Sensor Manager...");
+
+    memset(channelIndex, 0xFF, sizeof(channelIndex));
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        channelIndex[PRESSURE_ADC_CHANNELS[i]] = i;
+        rawSum[i] = 0;
+        rawCount[i] = 0;
+        tareSum[i] = 0.0f;
+        tareConductance[i] = 0.0f;
+        tareReadings[i] = 0;
+        contactState[i] = false;
+        forces[i].store(0.0f);
+    }
+    calibrated.store(false);
+    contactMask.store(0);
+    readingCount = 0;
+    frameCount = 0;
+    overrunCount = 0;
+    contactCount = 0;
+
+    // Per-chip ADC curve from eFuse (falls back to the nominal reference)
+    esp_adc_cal_value_t source = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                                          ADC_DEFAULT_VREF_MV, &adcCharacteristics);
+    LOG_DEBUGF("ADC calibration source: %s", source == ESP_ADC_CAL_VAL_EFUSE_TP ? "eFuse two-point" :
+               source == ESP_ADC_CAL_VAL_EFUSE_VREF ? "eFuse Vref" : "default Vref");
+
+    if (!startADC()) {
+        Logger::error("Pressure sensor ADC failed to start");
+        return;
+    }
+
+    initialized = true;
+    startTask();
+
+    Logger::infof("Pressure Sensor Manager initialized - %d sensors at %lu Hz (%lu conversions/s by DMA)",
+                 PRESSURE_SENSOR_COUNT, (unsigned long)PRESSURE_SAMPLING_RATE_HZ,
+                 (unsigned long)PRESSURE_ADC_SAMPLE_RATE_HZ);
+}
+
+void PressureSensorManager::shutdown() {
+    if (!initialized) return;
+
+    Logger::info("Shutting down Pressure Sensor Manager...");
+
+    stopTask();
+    stopADC();
+
+    initialized = false;
+    Logger::info("Pressure Sensor Manager shutdown complete");
+}
+
+// =============================================================================
+// FREERTOS TASK MANAGEMENT
+// =============================================================================
+
+void PressureSensorManager::startTask() {
+    if (taskRunning || taskHandle) return;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        pressureSensorTask,
+        "PressureSensor",
+        ResourceProfiler::getStackSize(ProfiledTask::PRESSURE_SENSOR),
+        this,
+        PRIORITY_PRESSURE_SENSOR,
+        &taskHandle,
+        CORE_APPLICATION  // Core 1 for application tasks
+    );
+
+    if (result == pdPASS) {
+        taskRunning = true;
+        FreeRTOSManager::setPressureSensorTask(taskHandle);
+        Logger::info("Pressure Sensor task started on Core 1");
+    } else {
+        Logger::error("Failed to create Pressure Sensor task");
+    }
+}
+
+void PressureSensorManager::stopTask() {
+    if (!taskRunning || !taskHandle) return;
+
+    taskRunning = false;
+    FreeRTOSManager::setPressureSensorTask(nullptr);
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+
+    Logger::info("Pressure Sensor task stopped");
+}
+
+bool PressureSensorManager::isTaskRunning() {
+    return taskRunning && taskHandle != nullptr;
+}
+
+void PressureSensorManager::pressureSensorTask(void* parameter) {
+    PressureSensorManager* manager = static_cast<PressureSensorManager*>(parameter);
+    Logger::info("Pressure Sensor task started");
+
+    TraceId traceId = TaskTracer::registerTask("PressureSensor", 1000000 / PRESSURE_SAMPLING_RATE_HZ);
+
+    while (manager->taskRunning) {
+        // Blocks until the DMA has filled a frame - no CPU time per conversion
+        uint32_t length = 0;
+        esp_err_t result = adc_digi_read_bytes(manager->frameBuffer, FRAME_BYTES, &length, READ_TIMEOUT_MS);
+
+        if (result == ESP_ERR_INVALID_STATE) {
+            // Driver pool overflowed; this frame is valid, older ones were lost
+            manager->overrunCount++;
+        } else if (result != ESP_OK) {
+            continue;
+        }
+
+        TaskTracer::ScopedTimer timer(traceId);
+        manager->processFrame(length, millis());
+    }
+
+    Logger::info("Pressure Sensor task ended");
+    vTaskDelete(nullptr);  // Delete self
+}
+
+// =============================================================================
+// ADC CONTINUOUS MODE
+// =============================================================================
+
+bool PressureSensorManager::startADC() {
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = FRAME_BYTES * DMA_FRAMES_BUFFERED;
+    initConfig.conv_num_each_intr = FRAME_BYTES;
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        initConfig.adc1_chan_mask |= 1UL << PRESSURE_ADC_CHANNELS[i];
+    }
+
+    esp_err_t result = adc_digi_initialize(&initConfig);
+    if (result != ESP_OK) {
+        Logger::errorf("ADC DMA init failed: %s", esp_err_to_name(result));
+        return false;
+    }
+
+    // One conversion per sensor per pattern cycle, full 0-3.1V range
+    adc_digi_pattern_config_t pattern[PRESSURE_SENSOR_COUNT] = {};
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        pattern[i].atten = ADC_ATTEN_DB_11;
+        pattern[i].channel = PRESSURE_ADC_CHANNELS[i];
+        pattern[i].unit = 0;  // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = true;
+    config.conv_limit_num = ADC_CONVERSION_LIMIT;
+    config.pattern_num = PRESSURE_SENSOR_COUNT;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = PRESSURE_ADC_SAMPLE_RATE_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+    result = adc_digi_controller_configure(&config);
+    if (result == ESP_OK) {
+        result = adc_digi_start();
+    }
+    if (result != ESP_OK) {
+        Logger::errorf("ADC DMA start failed: %s", esp_err_to_name(result));
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    adcRunning = true;
+    return true;
+}
+
+void PressureSensorManager::stopADC() {
+    if (!adcRunning) return;
+
+    adc_digi_stop();
+    adc_digi_deinitialize();
+    adcRunning = false;
+}
+
+// =============================================================================
+// SENSOR STATUS AND DATA ACCESS
+// =============================================================================
+
+bool PressureSensorManager::isSampling() {
+    return adcRunning && isTaskRunning();
+}
+
+bool PressureSensorManager::isCalibrated() {
+    return calibrated.load();
+}
+
+float PressureSensorManager::getForce(int sensorIndex) {
+    if (sensorIndex < 0 || sensorIndex >= PRESSURE_SENSOR_COUNT) return 0.0f;
+    return forces[sensorIndex].load();
+}
+
+float PressureSensorManager::getGripForce() {
+    float total = 0.0f;
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        total += forces[i].load();
+    }
+    return total;
+}
+
+bool PressureSensorManager::isContact(int sensorIndex) {
+    if (sensorIndex < 0 || sensorIndex >= PRESSURE_SENSOR_COUNT) return false;
+    return (contactMask.load() >> sensorIndex) & 1;
+}
+
+void PressureSensorManager::setReadingCallback(void (*callback)(const PressureReading& reading)) {
+    readingCallback = callback;
+}
+
+uint32_t PressureSensorManager::getReadingCount() {
+    return readingCount;
+}
+
+uint32_t PressureSensorManager::getFrameCount() {
+    return frameCount;
+}
+
+uint32_t PressureSensorManager::getOverrunCount() {
+    return overrunCount;
+}
+
+uint32_t PressureSensorManager::getContactCount() {
+    return contactCount;
+}
+
+// =============================================================================
+// SENSOR PROCESSING
+// =============================================================================
+
+void PressureSensorManager::processFrame(uint32_t length, uint32_t timestamp) {
+    const adc_digi_output_data_t* conversions = reinterpret_cast<const adc_digi_output_data_t*>(frameBuffer);
+    uint32_t count = length / sizeof(adc_digi_output_data_t);
+
+    // Box-filter decimation: every CONVERSIONS_PER_READING conversions of a channel make one reading
+    for (uint32_t n = 0; n < count; n++) {
+        uint8_t channel = conversions[n].type1.channel;
+        if (channel >= sizeof(channelIndex)) continue;
+
+        uint8_t index = channelIndex[channel];
+        if (index == 0xFF) continue;
+
+        rawSum[index] += conversions[n].type1.data;
+        if (++rawCount[index] >= CONVERSIONS_PER_READING) {
+            processReading(index, (uint16_t)(rawSum[index] / rawCount[index]), timestamp);
+            rawSum[index] = 0;
+            rawCount[index] = 0;
+        }
+    }
+
+    frameCount++;
+}
+
+void PressureSensorManager::processReading(int sensorIndex, uint16_t rawValue, uint32_t timestamp) {
+    float conductance = toConductance(rawValue);
+
+    if (!calibrated.load()) {
+        tare(sensorIndex, conductance);
+        return;
+    }
+
+    float force = (conductance - tareConductance[sensorIndex]) * PRESSURE_NEWTONS_PER_MICROSIEMENS;
+    if (force < 0.0f) force = 0.0f;
+
+    // Hysteresis keeps sensor noise around the threshold from toggling contact
+    bool contact = contactState[sensorIndex];
+    if (!contact && force >= PRESSURE_CONTACT_THRESHOLD) {
+        contact = true;
+        contactCount++;
+        LOG_DEBUGF("Pressure sensor %d contact (%.2f N)", sensorIndex, force);
+    } else if (contact && force < PRESSURE_RELEASE_THRESHOLD) {
+        contact = false;
+    }
+    contactState[sensorIndex] = contact;
+
+    forces[sensorIndex].store(force);
+    uint8_t mask = contactMask.load();
+    mask = contact ? (mask | (1 << sensorIndex)) : (mask & ~(1 << sensorIndex));
+    contactMask.store(mask);
+    readingCount++;
+
+    if (!readingCallback) return;
+
+    PressureReading reading;
+    reading.timestamp = timestamp;
+    reading.quality = (rawValue >= ADC_SATURATION) ? 0.5f : 1.0f;
+    reading.valid = true;
+    reading.sensorId = PRESSURE_ADC_CHANNELS[sensorIndex];
+    reading.force = force;
+    reading.pressure = force / PRESSURE_SENSOR_AREA_MM2 * 1000.0f;  // N/mm^2 -> kPa
+    reading.rawValue = rawValue;
+    reading.sensorIndex = sensorIndex;
+    reading.contact = contact;
+
+    readingCallback(reading);
+}
+
+void PressureSensorManager::tare(int sensorIndex, float conductance) {
+    if (tareReadings[sensorIndex] < TARE_READINGS) {
+        tareSum[sensorIndex] += conductance;
+        tareReadings[sensorIndex]++;
+    }
+
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        if (tareReadings[i] < TARE_READINGS) return;
+    }
+
+    // A sensor already pressed at boot would hide real force - tare only what looks unloaded
+    for (int i = 0; i < PRESSURE_SENSOR_COUNT; i++) {
+        float offset = tareSum[i] / TARE_READINGS;
+        if (offset * PRESSURE_NEWTONS_PER_MICROSIEMENS < PRESSURE_CONTACT_THRESHOLD) {
+            tareConductance[i] = offset;
+            LOG_DEBUGF("Pressure sensor %d tared at %.1f uS", i, offset);
+        } else {
+            tareConductance[i] = 0.0f;
+            Logger::warningf("Pressure sensor %d loaded during tare (%.2f N) - not zeroed",
+                            i, offset * PRESSURE_NEWTONS_PER_MICROSIEMENS);
+        }
+    }
+
+    calibrated.store(true);
+    Logger::info("Pressure sensors tared");
+}
+
+float PressureSensorManager::toConductance(uint16_t rawValue) {
+    // Divider: Vout = Vcc * R / (R + Rsensor), so Gsensor = Vout / (R * (Vcc - Vout))
+    float millivolts = (float)esp_adc_cal_raw_to_voltage(rawValue, &adcCharacteristics);
+    float headroom = SUPPLY_MV - millivolts;
+    if (headroom < 1.0f) headroom = 1.0f;
+
+    return millivolts / (PRESSURE_DIVIDER_RESISTOR_OHMS * headroom) * 1e6f;  // uS
+}
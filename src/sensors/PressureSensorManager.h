@@ -0,0 +1,118 @@
+#ifndef PRESSURE_SENSOR_MANAGER_H
+#define PRESSURE_SENSOR_MANAGER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+#include "../config/Config.h"
+#include "../hardware/I2CManager.h"
+
+/**
+ * Fingertip force from PRESSURE_SENSOR_COUNT thin-film sensors on ADC1.
+ *
+ * The ADC runs in continuous (DMA) mode, cycling through every channel at
+ * PRESSURE_ADC_SAMPLE_RATE_HZ without the CPU. The task blocks in
+ * adc_digi_read_bytes until a frame of conversions is ready, then averages
+ * each channel down to PRESSURE_SAMPLING_RATE_HZ, which also removes most
+ * of the ADC noise.
+ *
+ * Each sensor is the upper leg of a divider to PRESSURE_DIVIDER_RESISTOR_OHMS.
+ * Its conductance is close to proportional to force, so the decimated
+ * voltage is turned into conductance, tared against the unloaded sensor at
+ * boot and scaled to Newtons. Contact switches on above
+ * PRESSURE_CONTACT_THRESHOLD and off below PRESSURE_RELEASE_THRESHOLD.
+ */
+class PressureSensorManager {
+public:
+    PressureSensorManager();
+
+    // Initialization and lifecycle
+    void initialize();
+    void shutdown();
+
+    // FreeRTOS task management
+    void startTask();
+    void stopTask();
+    bool isTaskRunning();
+
+    // Sensor status
+    bool isSampling();   // ADC DMA running
+    bool isCalibrated(); // Tare complete
+
+    // Latest values - safe from any task
+    float getForce(int sensorIndex);  // Newtons
+    float getGripForce();             // Sum over all sensors
+    bool isContact(int sensorIndex);
+
+    // Data access
+    void setReadingCallback(void (*callback)(const PressureReading& reading));  // Each channel, on the pressure task
+
+    // Statistics
+    uint32_t getReadingCount();
+    uint32_t getFrameCount();
+    uint32_t getOverrunCount();  // DMA frames lost while the task was starved
+    uint32_t getContactCount();  // Contact onsets over all sensors
+
+private:
+    bool initialized;
+    bool taskRunning;
+    bool adcRunning;
+    TaskHandle_t taskHandle;
+
+    // DMA frame (pressure task only)
+    static const uint32_t CONVERSIONS_PER_READING =
+        PRESSURE_ADC_SAMPLE_RATE_HZ / PRESSURE_SENSOR_COUNT / PRESSURE_SAMPLING_RATE_HZ;  // 50
+    static const uint32_t FRAME_BYTES =
+        CONVERSIONS_PER_READING * PRESSURE_SENSOR_COUNT * sizeof(adc_digi_output_data_t);  // One reading per channel
+    uint8_t frameBuffer[FRAME_BYTES] __attribute__((aligned(4)));
+    esp_adc_cal_characteristics_t adcCharacteristics;
+    uint8_t channelIndex[8];  // ADC1 channel -> sensor index, 0xFF if unused
+
+    // Decimation and calibration (pressure task only)
+    uint32_t rawSum[PRESSURE_SENSOR_COUNT];
+    uint16_t rawCount[PRESSURE_SENSOR_COUNT];
+    float tareSum[PRESSURE_SENSOR_COUNT];
+    float tareConductance[PRESSURE_SENSOR_COUNT];  // uS of the unloaded sensor
+    uint16_t tareReadings[PRESSURE_SENSOR_COUNT];
+    bool contactState[PRESSURE_SENSOR_COUNT];
+
+    // Published for other tasks
+    std::atomic<bool> calibrated;
+    std::atomic<float> forces[PRESSURE_SENSOR_COUNT];
+    std::atomic<uint8_t> contactMask;
+
+    void (*readingCallback)(const PressureReading& reading);
+
+    // Statistics
+    uint32_t readingCount;
+    uint32_t frameCount;
+    uint32_t overrunCount;
+    uint32_t contactCount;
+
+    // Task function
+    static void pressureSensorTask(void* parameter);
+
+    // ADC continuous mode
+    bool startADC();
+    void stopADC();
+
+    // Processing
+    void processFrame(uint32_t length, uint32_t timestamp);
+    void processReading(int sensorIndex, uint16_t rawValue, uint32_t timestamp);
+    void tare(int sensorIndex, float conductance);
+    float toConductance(uint16_t rawValue);
+
+    // Configuration constants
+    static const uint32_t DMA_FRAMES_BUFFERED = 4;      // Driver pool - 40ms of slack for the task
+    static const uint32_t ADC_CONVERSION_LIMIT = 250;   // Required by the ESP32 digital controller
+    static const uint32_t ADC_DEFAULT_VREF_MV = 1100;   // Used when eFuse holds no calibration
+    static const uint32_t READ_TIMEOUT_MS = 100;
+    static const uint16_t TARE_READINGS = PRESSURE_SAMPLING_RATE_HZ / 2;  // 0.5 seconds unloaded at boot
+    static const uint16_t ADC_SATURATION = 4000;        // Near full scale - force is a lower bound
+    static constexpr float SUPPLY_MV = 3300.0f;
+};
+
+#endif
@@ -1,18 +1,29 @@
 #include "PulseMonitorManager.h"
 #include "../utils/Logger.h"
 #include "../utils/ErrorHandler.h"
-#include <Wire.h>
+#include "../hardware/I2CManager.h"
+#include "../hardware/ResourceProfiler.h"
+#include "../hardware/TaskTracer.h"
 
 // MAX30102 I2C address and registers
 #define MAX30102_ADDRESS 0x57
+#define MAX30102_REG_INTR_STATUS_1 0x00
+#define MAX30102_REG_INTR_ENABLE_1 0x02
 #define MAX30102_REG_FIFO_WR_PTR 0x04
+#define MAX30102_REG_OVF_COUNTER 0x05
 #define MAX30102_REG_FIFO_RD_PTR 0x06
 #define MAX30102_REG_FIFO_DATA 0x07
+#define MAX30102_REG_FIFO_CONFIG 0x08
 #define MAX30102_REG_MODE_CONFIG 0x09
 #define MAX30102_REG_SPO2_CONFIG 0x0A
 #define MAX30102_REG_LED1_PA 0x0C
 #define MAX30102_REG_LED2_PA 0x0D
 
+#define MAX30102_INTR_A_FULL 0x80
+#define MAX30102_FIFO_ROLLOVER_EN 0x10
+
+PulseMonitorManager* PulseMonitorManager::interruptInstance = nullptr;
+
 void PulseMonitorManager::initialize() {
     Logger::info("=== PULSE MONITOR INITIALIZATION START ===");
 
@@ -27,8 +38,12 @@ void PulseMonitorManager::initialize() {
     sessionActive = false;
     calibrated = false;
     taskHandle = nullptr;
-    newReadingAvailable = false;
+    lastPublishTime = 0;
+    lastConsumedReading = {};
     newAlertAvailable = false;
+    fifoBurstCount = 0;
+    fifoOverflowCount = 0;
+    interruptAttached = false;
     
     // Initialize sensor (use global instance)
     // sensor = &sensor; // Not needed for MAX30102 library
@@ -52,37 +67,20 @@ void PulseMonitorManager::initialize() {
     // Initialize metrics
     resetMetrics();
     resetBuffer();
+    signalProcessor.reset();
 
-    // Initialize I2C with custom pins
-    Logger::infof("Initializing I2C with SDA=%d, SCL=%d", I2C_SDA_PIN, I2C_SCL_PIN);
-    Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
-
-    // Scan for I2C devices
-    Logger::info("Scanning for I2C devices...");
-    int deviceCount = 0;
-    for (byte address = 1; address < 127; address++) {
-        Wire.beginTransmission(address);
-        byte error = Wire.endTransmission();
-        if (error == 0) {
-            Logger::infof("I2C device found at address 0x%02X", address);
-            deviceCount++;
-        }
-    }
-    if (deviceCount == 0) {
-        Logger::error("No I2C devices found! Check wiring.");
-    } else {
-        Logger::infof("Found %d I2C device(s)", deviceCount);
+    // The I2C Manager owns the bus (initialized in the foundation phase)
+    if (!I2CManager::isInitialized()) {
+        Logger::error("I2C Manager not initialized - cannot start pulse monitor");
+        return;
     }
 
-    // Initialize sensor hardware using raw I2C
+    // Initialize sensor hardware through the I2C Manager
     Logger::info("Attempting to initialize MAX30102 sensor via I2C...");
 
     // Test I2C communication
-    Wire.beginTransmission(MAX30102_ADDRESS);
-    byte error = Wire.endTransmission();
-
-    if (error != 0) {
-        Logger::errorf("Failed to communicate with MAX30102 at address 0x%02X (error: %d)", MAX30102_ADDRESS, error);
+    if (!I2CManager::probeDevice(MAX30102_ADDRESS)) {
+        Logger::errorf("Failed to communicate with MAX30102 at address 0x%02X", MAX30102_ADDRESS);
         Logger::error("Expected wiring: VCC->3.3V, GND->GND, SDA->GPIO18, SCL->GPIO21");
         return;
     }
@@ -90,6 +88,11 @@ void PulseMonitorManager::initialize() {
     Logger::info("MAX30102 sensor communication successful!");
 
     // Configure sensor settings via I2C
+    writeRegister(MAX30102_REG_FIFO_CONFIG, MAX30102_FIFO_ROLLOVER_EN | FIFO_ALMOST_FULL_EMPTY_SLOTS); // No averaging, keep newest samples
+    writeRegister(MAX30102_REG_FIFO_WR_PTR, 0x00); // Start with an empty FIFO
+    writeRegister(MAX30102_REG_OVF_COUNTER, 0x00);
+    writeRegister(MAX30102_REG_FIFO_RD_PTR, 0x00);
+    writeRegister(MAX30102_REG_INTR_ENABLE_1, MAX30102_INTR_A_FULL); // Interrupt when the FIFO is almost full
     writeRegister(MAX30102_REG_MODE_CONFIG, 0x03); // SpO2 mode
     writeRegister(MAX30102_REG_SPO2_CONFIG, 0x27); // SPO2_ADC range = 4096nA, SPO2 sample rate = 100 Hz, LED pulseWidth = 400uS
     writeRegister(MAX30102_REG_LED1_PA, 0x24); // Choose value for ~ 7mA for LED1 (Red)
@@ -101,6 +104,7 @@ void PulseMonitorManager::initialize() {
     
     // Start the pulse monitoring task
     startTask();
+    attachSensorInterrupt();
     
     Logger::info("Pulse Monitor Manager initialized with FreeRTOS task");
     Logger::info("=== PULSE MONITOR INITIALIZATION COMPLETE ===");
@@ -111,11 +115,13 @@ void PulseMonitorManager::shutdown() {
 
     Logger::info("Shutting down Pulse Monitor Manager...");
 
+    detachSensorInterrupt();
     stopTask();
 
     // Turn off LEDs
     writeRegister(MAX30102_REG_LED1_PA, 0x00); // Turn off Red LED
     writeRegister(MAX30102_REG_LED2_PA, 0x00); // Turn off IR LED
+    writeRegister(MAX30102_REG_INTR_ENABLE_1, 0x00);
 
     initialized = false;
     Logger::info("Pulse Monitor Manager shutdown complete");
@@ -131,7 +137,7 @@ void PulseMonitorManager::startTask() {
     BaseType_t result = xTaskCreatePinnedToCore(
         pulseMonitorTask,
         "PulseMonitor",
-        TASK_STACK_PULSE_MONITOR,
+        ResourceProfiler::getStackSize(ProfiledTask::PULSE_MONITOR),
         this,
         PRIORITY_PULSE_MONITOR,
         &taskHandle,
@@ -160,6 +166,38 @@ bool PulseMonitorManager::isTaskRunning() {
     return taskRunning && taskHandle != nullptr;
 }
 
+void PulseMonitorManager::attachSensorInterrupt() {
+    if (interruptAttached || !taskHandle) return;
+
+    // MAX30102 INT is active-low open drain
+    interruptInstance = this;
+    pinMode(I2C_INT_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(I2C_INT_PIN), fifoInterruptHandler, FALLING);
+    interruptAttached = true;
+
+    // Clear anything latched during configuration so the next edge is seen
+    readRegister(MAX30102_REG_INTR_STATUS_1);
+
+    Logger::infof("Pulse sensor FIFO interrupt attached on GPIO%d", I2C_INT_PIN);
+}
+
+void PulseMonitorManager::detachSensorInterrupt() {
+    if (!interruptAttached) return;
+
+    detachInterrupt(digitalPinToInterrupt(I2C_INT_PIN));
+    interruptAttached = false;
+    interruptInstance = nullptr;
+}
+
+void IRAM_ATTR PulseMonitorManager::fifoInterruptHandler() {
+    PulseMonitorManager* manager = interruptInstance;
+    if (!manager || !manager->taskHandle) return;
+
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(manager->taskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
 void PulseMonitorManager::pulseMonitorTask(void* parameter) {
     PulseMonitorManager* manager = (PulseMonitorManager*)parameter;
     Logger::info("Pulse Monitor task started");
@@ -171,12 +209,18 @@ void PulseMonitorManager::pulseMonitorTask(void* parameter) {
         Logger::warning("Pulse sensor is NOT connected at task start");
     }
 
+    // The FIFO must be drained at least every FIFO_POLL_TIMEOUT, which makes
+    // that the deadline rather than the per-sample TASK_DELAY_PULSE_SAMPLING
+    TraceId traceId = TaskTracer::registerTask("PulseMonitor", FIFO_POLL_TIMEOUT * 1000);
+
     while (manager->taskRunning) {
-        // Update sensor readings
-        manager->updateSensor();
+        // Sleep until the sensor reports a nearly full FIFO. The timeout keeps
+        // sampling going (and the FIFO from overflowing) if INT is not wired.
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FIFO_POLL_TIMEOUT));
+        TaskTracer::ScopedTimer timer(traceId);
 
-        // Process new readings
-        manager->processReading();
+        // Drain every pending sample and run each one through the pipeline
+        manager->updateSensor();
 
         // Calculate session metrics
         manager->calculateMetrics();
@@ -191,9 +235,6 @@ void PulseMonitorManager::pulseMonitorTask(void* parameter) {
 
         // Feed watchdog (when FreeRTOS Manager is re-enabled)
         // FreeRTOSManager::feedTaskWatchdog(xTaskGetCurrentTaskHandle());
-
-        // Pulse monitoring runs at 100Hz (10ms cycle)
-        vTaskDelay(pdMS_TO_TICKS(10));
     }
 
     Logger::info("Pulse Monitor task ended");
@@ -208,9 +249,7 @@ bool PulseMonitorManager::isSensorConnected() {
     if (!initialized) return false;
 
     // Test I2C communication
-    Wire.beginTransmission(MAX30102_ADDRESS);
-    byte error = Wire.endTransmission();
-    return (error == 0);
+    return I2CManager::probeDevice(MAX30102_ADDRESS);
 }
 
 bool PulseMonitorManager::isFingerDetected() {
@@ -228,16 +267,31 @@ PulseMetrics PulseMonitorManager::getSessionMetrics() {
     return sessionMetrics;
 }
 
+bool PulseMonitorManager::popReading(HeartRateReading& reading) {
+    if (!readingStream.pop(reading)) return false;
+
+    lastConsumedReading = reading;
+    return true;
+}
+
 bool PulseMonitorManager::hasNewReading() {
-    return newReadingAvailable;
+    return !readingStream.isEmpty();
 }
 
 HeartRateReading PulseMonitorManager::getLatestReading() {
-    return currentReading;
+    // Skip straight to the newest queued reading
+    HeartRateReading reading;
+    while (popReading(reading)) {}
+
+    return lastConsumedReading;
 }
 
 void PulseMonitorManager::clearNewReading() {
-    newReadingAvailable = false;
+    readingStream.clear();
+}
+
+uint32_t PulseMonitorManager::getDroppedReadingCount() {
+    return readingStream.getDroppedCount();
 }
 
 // =============================================================================
@@ -386,6 +440,14 @@ unsigned long PulseMonitorManager::getSessionDuration() {
     return millis() - sessionStartTime;
 }
 
+uint32_t PulseMonitorManager::getFIFOBurstCount() {
+    return fifoBurstCount;
+}
+
+uint32_t PulseMonitorManager::getFIFOOverflowCount() {
+    return fifoOverflowCount;
+}
+
 // =============================================================================
 // CALLBACKS
 // =============================================================================
@@ -412,84 +474,87 @@ void PulseMonitorManager::updateSensor() {
         return;
     }
 
-    // Read raw data from FIFO
-    uint32_t irValue = 0;
-    uint32_t redValue = 0;
+    // Reading the status register releases the INT line for the next edge
+    readRegister(MAX30102_REG_INTR_STATUS_1);
 
-    if (readFIFO(&redValue, &irValue)) {
-        // Debug output every 2 seconds
-        static unsigned long lastDebugTime = 0;
-        if (millis() - lastDebugTime > 2000) {
-            float hr = calculateHeartRate();
-            float spo2 = calculateSpO2();
-
-            // Calculate signal variation for debugging
-            static uint32_t minIR = irValue, maxIR = irValue;
-            if (irValue < minIR) minIR = irValue;
-            if (irValue > maxIR) maxIR = irValue;
-            uint32_t variation = maxIR - minIR;
-
-            // Calculate R ratio for SpO2 debugging
-            float redRatio = (redValue > 0) ? (float)variation / redValue : 0;
-            float irRatio = (irValue > 0) ? (float)variation / irValue : 0;
-            float R = (irRatio > 0) ? redRatio / irRatio : 0;
-
-            Logger::infof("IR: %lu (var: %lu), Red: %lu, R: %.3f, HR: %.1f BPM, SpO2: %.1f%%",
-                         irValue, variation, redValue, R, hr, spo2);
-
-            // Reset min/max for next period
-            minIR = irValue;
-            maxIR = irValue;
-            lastDebugTime = millis();
-        }
+    // Drain all pending samples in burst reads
+    int sampleCount = readFIFO(fifoSamples, FIFO_DEPTH);
+    if (sampleCount == 0) return;
 
-        // Update current reading
-        currentReading.timestamp = millis();
-        currentReading.irValue = irValue;
-        currentReading.redValue = redValue;
-        currentReading.fingerDetected = (irValue > 50000);
-        currentReading.signalStrength = calculateSignalStrength(irValue, redValue);
-        currentReading.quality = assessQuality(irValue, redValue);
+    // Samples were taken at the sensor rate - the newest one is "now"
+    unsigned long now = millis();
+    for (int i = 0; i < sampleCount; i++) {
+        unsigned long sampleTime = now - (sampleCount - 1 - i) * SAMPLE_PERIOD_MS;
+        processSample(fifoSamples[i].red, fifoSamples[i].ir, sampleTime);
+        processReading();
+    }
 
-        // Calculate heart rate and SpO2 (simplified for now)
-        currentReading.heartRate = calculateHeartRate();
-        currentReading.spO2 = calculateSpO2();
+    // Debug output every 2 seconds
+    static unsigned long lastDebugTime = 0;
+    if (now - lastDebugTime > 2000) {
+        LOG_DEBUGF("IR: %lu (AC: %lu), Red: %lu (AC: %lu), R: %.3f, HR: %.1f BPM, SpO2: %.1f%% (%d samples/burst)",
+                     currentReading.irValue, signalProcessor.getIRAC(),
+                     currentReading.redValue, signalProcessor.getRedAC(),
+                     signalProcessor.getRatioQ8() / 256.0f,
+                     currentReading.heartRate, currentReading.spO2, sampleCount);
+        lastDebugTime = now;
+    }
+}
 
-        lastReadingTime = millis();
+void PulseMonitorManager::processSample(uint32_t redValue, uint32_t irValue, unsigned long timestamp) {
+    // Update current reading
+    currentReading.timestamp = timestamp;
+    currentReading.irValue = irValue;
+    currentReading.redValue = redValue;
+    bool wasFingerDetected = currentReading.fingerDetected;
+    currentReading.fingerDetected = (irValue > 50000);
+
+    if (currentReading.fingerDetected) {
+        // Streaming heart rate and SpO2 - O(1) integer work per sample
+        signalProcessor.addSample(redValue, irValue, timestamp);
+        currentReading.heartRate = signalProcessor.getHeartRate();
+        currentReading.spO2 = (redValue >= 20000) ? signalProcessor.getSpO2() : 0.0f;
+    } else {
+        // Don't mix the next placement with stale beat history
+        if (wasFingerDetected) {
+            signalProcessor.reset();
+        }
+        currentReading.heartRate = 0.0f;
+        currentReading.spO2 = 0.0f;
     }
+
+    currentReading.signalStrength = calculateSignalStrength(irValue, redValue);
+    currentReading.quality = assessQuality(irValue, redValue);
+
+    lastReadingTime = timestamp;
 }
 
 void PulseMonitorManager::processReading() {
-    if (!isSensorConnected()) return;
+    // Only called with fresh FIFO data, so the sensor is known to be present
+    if (!initialized) return;
+
+    // Publish a reading once per second (not every 10ms!)
+    if (millis() - lastPublishTime >= 1000) {
+        // Always publish to report sensor status (even without finger)
+        LOG_DEBUGF("Publishing heart rate reading: HR=%.1f, SpO2=%.1f, Finger=%s",
+                     currentReading.heartRate, currentReading.spO2,
+                     currentReading.fingerDetected ? "Yes" : "No");
 
-    // Throttle callback to once per second (not every 10ms!)
-    static unsigned long lastCallbackTime = 0;
-    if (millis() - lastCallbackTime >= 1000) {
-        // Always trigger callback to publish sensor status (even without finger)
+        if (!readingStream.push(currentReading)) {
+            Logger::warning("Heart rate reading dropped - consumer not keeping up");
+        }
         if (readingCallback) {
-            Logger::infof("Triggering heart rate callback: HR=%.1f, SpO2=%.1f, Finger=%s",
-                         currentReading.heartRate, currentReading.spO2,
-                         currentReading.fingerDetected ? "Yes" : "No");
             readingCallback(currentReading);
-        } else {
-            Logger::warning("Heart rate callback not set!");
         }
-        lastCallbackTime = millis();
+        lastPublishTime = millis();
     }
 
     // Only process detailed metrics if finger is detected
     if (!currentReading.fingerDetected) return;
 
-    // Calculate heart rate and SpO2
-    currentReading.heartRate = calculateHeartRate();
-    currentReading.spO2 = calculateSpO2();
-
     // Update buffer with new reading
     updateBuffer(currentReading);
 
-    // Mark new reading available
-    newReadingAvailable = true;
-
     // Update session metrics
     if (sessionActive) {
         sessionMetrics.totalReadings++;
@@ -585,196 +650,6 @@ void PulseMonitorManager::updateBuffer(const HeartRateReading& reading) {
 // SIGNAL PROCESSING
 // =============================================================================
 
-float PulseMonitorManager::calculateHeartRate() {
-    // Improved heart rate calculation with moving average and peak detection
-    static uint32_t irHistory[10] = {0};
-    static int historyIndex = 0;
-    static int historyCount = 0;
-    static unsigned long lastBeatTime = 0;
-    static float heartRate = 0.0f;
-    static int beatCount = 0;
-    static unsigned long beatTimes[5] = {0};
-    static int beatIndex = 0;
-
-    uint32_t currentIr = currentReading.irValue;
-
-    // Only process if finger is detected
-    if (currentIr < 50000) {
-        return 0.0f;
-    }
-
-    // Store current value in history
-    irHistory[historyIndex] = currentIr;
-    historyIndex = (historyIndex + 1) % 10;
-    if (historyCount < 10) historyCount++;
-
-    // Need at least 5 samples for analysis
-    if (historyCount < 5) return heartRate;
-
-    // Calculate moving average
-    uint32_t sum = 0;
-    for (int i = 0; i < historyCount; i++) {
-        sum += irHistory[i];
-    }
-    uint32_t average = sum / historyCount;
-
-    // Find min and max in recent history
-    uint32_t minVal = irHistory[0];
-    uint32_t maxVal = irHistory[0];
-    for (int i = 1; i < historyCount; i++) {
-        if (irHistory[i] < minVal) minVal = irHistory[i];
-        if (irHistory[i] > maxVal) maxVal = irHistory[i];
-    }
-
-    // Calculate signal variation (pulse strength)
-    uint32_t variation = maxVal - minVal;
-
-    // Look for peaks (current value significantly above average)
-    uint32_t threshold = average + (variation / 4); // 25% above average
-
-    static bool inPeak = false;
-    static uint32_t lastPeakValue = 0;
-
-    if (!inPeak && currentIr > threshold && currentIr > lastPeakValue) {
-        // Found a peak
-        inPeak = true;
-        lastPeakValue = currentIr;
-
-        unsigned long currentTime = millis();
-
-        if (lastBeatTime > 0) {
-            unsigned long timeBetweenBeats = currentTime - lastBeatTime;
-
-            // Valid heart rate range (40-180 BPM = 333-1500ms between beats)
-            if (timeBetweenBeats > 333 && timeBetweenBeats < 1500) {
-                // Store beat time
-                beatTimes[beatIndex] = timeBetweenBeats;
-                beatIndex = (beatIndex + 1) % 5;
-                beatCount++;
-
-                // Calculate heart rate from recent beats
-                if (beatCount >= 3) {
-                    unsigned long totalTime = 0;
-                    int validBeats = min(beatCount, 5);
-
-                    for (int i = 0; i < validBeats; i++) {
-                        totalTime += beatTimes[i];
-                    }
-
-                    float avgBeatTime = (float)totalTime / validBeats;
-                    heartRate = 60000.0f / avgBeatTime;
-                }
-            }
-        }
-
-        lastBeatTime = currentTime;
-    } else if (inPeak && currentIr < (threshold - variation/8)) {
-        // End of peak
-        inPeak = false;
-        lastPeakValue = 0;
-    }
-
-    return heartRate;
-}
-
-float PulseMonitorManager::calculateSpO2() {
-    // Real SpO2 calculation based on Red/IR ratio
-    static uint32_t redHistory[20] = {0};
-    static uint32_t irHistory[20] = {0};
-    static int historyIndex = 0;
-    static int historyCount = 0;
-
-    uint32_t currentRed = currentReading.redValue;
-    uint32_t currentIr = currentReading.irValue;
-
-    // Only calculate if finger is detected
-    if (currentIr < 50000 || currentRed < 20000) {
-        return 0.0f;
-    }
-
-    // Store current values in history
-    redHistory[historyIndex] = currentRed;
-    irHistory[historyIndex] = currentIr;
-    historyIndex = (historyIndex + 1) % 20;
-    if (historyCount < 20) historyCount++;
-
-    // Need at least 10 samples for reliable calculation
-    if (historyCount < 10) return 0.0f;
-
-    // Calculate AC and DC components for both Red and IR
-    uint32_t redSum = 0, irSum = 0;
-    uint32_t redMin = redHistory[0], redMax = redHistory[0];
-    uint32_t irMin = irHistory[0], irMax = irHistory[0];
-
-    for (int i = 0; i < historyCount; i++) {
-        redSum += redHistory[i];
-        irSum += irHistory[i];
-
-        if (redHistory[i] < redMin) redMin = redHistory[i];
-        if (redHistory[i] > redMax) redMax = redHistory[i];
-        if (irHistory[i] < irMin) irMin = irHistory[i];
-        if (irHistory[i] > irMax) irMax = irHistory[i];
-    }
-
-    // Calculate DC (average) and AC (variation) components
-    float redDC = (float)redSum / historyCount;
-    float irDC = (float)irSum / historyCount;
-    float redAC = (float)(redMax - redMin);
-    float irAC = (float)(irMax - irMin);
-
-    // Avoid division by zero
-    if (redDC == 0 || irDC == 0 || redAC == 0 || irAC == 0) {
-        return 0.0f;
-    }
-
-    // Calculate R ratio (fundamental SpO2 calculation)
-    // R = (Red_AC/Red_DC) / (IR_AC/IR_DC)
-    float redRatio = redAC / redDC;
-    float irRatio = irAC / irDC;
-
-    if (irRatio == 0) return 0.0f;
-
-    float R = redRatio / irRatio;
-
-    // Convert R ratio to SpO2 using empirical formula
-    // This is a simplified version of the calibration curve
-    // Real pulse oximeters use more complex calibration
-    float spO2;
-
-    if (R < 0.5) {
-        spO2 = 100.0f; // Very high oxygen
-    } else if (R < 1.0) {
-        // Linear approximation for normal range
-        spO2 = 110.0f - (25.0f * R);
-    } else if (R < 2.0) {
-        // Lower oxygen levels
-        spO2 = 100.0f - (15.0f * R);
-    } else {
-        spO2 = 70.0f; // Very low oxygen (minimum realistic value)
-    }
-
-    // Clamp to realistic range
-    if (spO2 > 100.0f) spO2 = 100.0f;
-    if (spO2 < 70.0f) spO2 = 70.0f;
-
-    // Add some realistic variation (±1-2%)
-    static unsigned long lastVariationTime = 0;
-    static float variation = 0.0f;
-
-    if (millis() - lastVariationTime > 5000) {
-        variation = ((float)(random(-200, 200)) / 100.0f); // ±2%
-        lastVariationTime = millis();
-    }
-
-    spO2 += variation;
-
-    // Final clamp
-    if (spO2 > 100.0f) spO2 = 100.0f;
-    if (spO2 < 70.0f) spO2 = 70.0f;
-
-    return spO2;
-}
-
 PulseQuality PulseMonitorManager::assessQuality(uint32_t irValue, uint32_t redValue) {
     // Simplified quality assessment based on heart rate availability
     if (currentReading.heartRate > 0 && currentReading.spO2 > 0) {
@@ -903,51 +778,59 @@ void PulseMonitorManager::updateSessionMetrics() {
 // =============================================================================
 
 void PulseMonitorManager::writeRegister(uint8_t reg, uint8_t value) {
-    Wire.beginTransmission(MAX30102_ADDRESS);
-    Wire.write(reg);
-    Wire.write(value);
-    Wire.endTransmission();
+    I2CManager::writeRegister(MAX30102_ADDRESS, reg, value);
 }
 
 uint8_t PulseMonitorManager::readRegister(uint8_t reg) {
-    Wire.beginTransmission(MAX30102_ADDRESS);
-    Wire.write(reg);
-    Wire.endTransmission(false);
+    uint8_t value = 0;
+    I2CManager::readRegister(MAX30102_ADDRESS, reg, &value);
+    return value;
+}
+
+bool PulseMonitorManager::readRegisters(uint8_t reg, uint8_t* data, size_t length) {
+    // Register write + repeated-start read as one queued I2C transaction
+    return I2CManager::readRegisterData(MAX30102_ADDRESS, reg, data, length);
+}
+
+int PulseMonitorManager::readFIFO(FIFOSample* samples, int maxSamples) {
+    // Pending samples = write pointer - read pointer (5-bit circular pointers)
+    uint8_t pointers[3];  // FIFO_WR_PTR, OVF_COUNTER, FIFO_RD_PTR
+    if (!readRegisters(MAX30102_REG_FIFO_WR_PTR, pointers, sizeof(pointers))) return 0;
+
+    int pending = (pointers[0] - pointers[2]) & (FIFO_DEPTH - 1);
+
+    // Equal pointers with overflow means the FIFO is full and older samples were lost
+    if (pointers[1] > 0) {
+        fifoOverflowCount += pointers[1];
+        pending = FIFO_DEPTH;
+    }
 
-    Wire.requestFrom(MAX30102_ADDRESS, 1);
-    if (Wire.available()) {
-        return Wire.read();
+    if (pending > maxSamples) pending = maxSamples;
+    if (pending == 0) return 0;
+
+    // Burst-read the FIFO data register, which auto-advances the read pointer
+    int sampleCount = 0;
+    uint8_t raw[FIFO_MAX_SAMPLES_PER_READ * FIFO_SAMPLE_BYTES];  // Within I2C_MAX_TRANSFER_SIZE
+
+    while (sampleCount < pending) {
+        int chunk = pending - sampleCount;
+        if (chunk > FIFO_MAX_SAMPLES_PER_READ) chunk = FIFO_MAX_SAMPLES_PER_READ;
+
+        if (!readRegisters(MAX30102_REG_FIFO_DATA, raw, chunk * FIFO_SAMPLE_BYTES)) break;
+
+        for (int i = 0; i < chunk; i++) {
+            const uint8_t* bytes = raw + i * FIFO_SAMPLE_BYTES;
+
+            // Red LED data (first 3 bytes), IR LED data (next 3 bytes), 18-bit each
+            samples[sampleCount].red = (((uint32_t)bytes[0] << 16) | ((uint32_t)bytes[1] << 8) | bytes[2]) & 0x03FFFF;
+            samples[sampleCount].ir = (((uint32_t)bytes[3] << 16) | ((uint32_t)bytes[4] << 8) | bytes[5]) & 0x03FFFF;
+            sampleCount++;
+        }
     }
-    return 0;
-}
-
-bool PulseMonitorManager::readFIFO(uint32_t* redValue, uint32_t* irValue) {
-    // Read FIFO data register
-    Wire.beginTransmission(MAX30102_ADDRESS);
-    Wire.write(MAX30102_REG_FIFO_DATA);
-    Wire.endTransmission(false);
-
-    Wire.requestFrom(MAX30102_ADDRESS, 6); // 3 bytes per LED * 2 LEDs
-
-    if (Wire.available() >= 6) {
-        // Read Red LED data (first 3 bytes)
-        uint32_t red = 0;
-        red |= (uint32_t)Wire.read() << 16;
-        red |= (uint32_t)Wire.read() << 8;
-        red |= (uint32_t)Wire.read();
-        red &= 0x03FFFF; // 18-bit data
-
-        // Read IR LED data (next 3 bytes)
-        uint32_t ir = 0;
-        ir |= (uint32_t)Wire.read() << 16;
-        ir |= (uint32_t)Wire.read() << 8;
-        ir |= (uint32_t)Wire.read();
-        ir &= 0x03FFFF; // 18-bit data
-
-        *redValue = red;
-        *irValue = ir;
-        return true;
+
+    if (sampleCount > 0) {
+        fifoBurstCount++;
     }
 
-    return false;
+    return sampleCount;
 }
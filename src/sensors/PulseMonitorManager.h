@@ -6,6 +6,8 @@
 #include <freertos/task.h>
 #include <freertos/queue.h>
 #include "../config/Config.h"
+#include "PulseSignalProcessor.h"
+#include "../memory/SPSCRingBuffer.h"
 
 // Forward declarations
 class MAX30105;
@@ -29,6 +31,9 @@ struct HeartRateReading {
     float signalStrength;
 };
 
+// Processed reading stream (pulse task produces, one consumer task)
+typedef SPSCRingBuffer<HeartRateReading, STREAM_SIZE_PULSE_PROCESSED> PulseReadingStream;
+
 struct PulseMetrics {
     float averageHeartRate;
     float minHeartRate;
@@ -68,10 +73,12 @@ public:
     HeartRateReading getCurrentReading();
     PulseMetrics getSessionMetrics();
 
-    // Data access
+    // Data access (processed readings, once per second - single consumer)
+    bool popReading(HeartRateReading& reading);
     bool hasNewReading();
     HeartRateReading getLatestReading();
     void clearNewReading();
+    uint32_t getDroppedReadingCount();
     
     // Configuration
     void setSamplingRate(uint16_t rate);
@@ -103,6 +110,8 @@ public:
     uint32_t getValidReadings();
     float getDataQualityPercent();
     unsigned long getSessionDuration();
+    uint32_t getFIFOBurstCount();
+    uint32_t getFIFOOverflowCount();
     
     // Callbacks
     void setReadingCallback(void (*callback)(const HeartRateReading& reading));
@@ -118,10 +127,17 @@ private:
     // Sensor instance (using global instance)
     // MAX30105* sensor; // Not needed, using global sensor
     
+    // Streaming DSP for this sensor instance
+    PulseSignalProcessor signalProcessor;
+
     // Current state
-    HeartRateReading currentReading;
+    HeartRateReading currentReading;  // Pulse task only
     PulseMetrics sessionMetrics;
-    bool newReadingAvailable;
+    unsigned long lastPublishTime;
+
+    // Lock-free handoff to the consumer task
+    PulseReadingStream readingStream;
+    HeartRateReading lastConsumedReading;  // Consumer side of readingStream
     unsigned long sessionStartTime;
     unsigned long lastReadingTime;
     
@@ -157,8 +173,24 @@ private:
     float baselineIR;
     float baselineRed;
     
+    // FIFO burst buffer (one entry per Red/IR sample pair)
+    struct FIFOSample {
+        uint32_t red;
+        uint32_t ir;
+    };
+    FIFOSample fifoSamples[32];  // FIFO_DEPTH
+    uint32_t fifoBurstCount;
+    uint32_t fifoOverflowCount;
+    bool interruptAttached;
+
     // Task function
     static void pulseMonitorTask(void* parameter);
+
+    // Sensor interrupt (MAX30102 INT pin, FIFO almost full)
+    static PulseMonitorManager* interruptInstance;
+    static void fifoInterruptHandler();
+    void attachSensorInterrupt();
+    void detachSensorInterrupt();
     
     // Callbacks
     void (*readingCallback)(const HeartRateReading& reading);
@@ -166,14 +198,13 @@ private:
     
     // Internal methods
     void updateSensor();
+    void processSample(uint32_t redValue, uint32_t irValue, unsigned long timestamp);
     void processReading();
     void calculateMetrics();
     void checkThresholds();
     void updateBuffer(const HeartRateReading& reading);
     
     // Signal processing
-    float calculateHeartRate();
-    float calculateSpO2();
     PulseQuality assessQuality(uint32_t irValue, uint32_t redValue);
     float calculateSignalStrength(uint32_t irValue, uint32_t redValue);
     bool detectFinger(uint32_t irValue);
@@ -197,7 +228,8 @@ private:
     // I2C communication helpers
     void writeRegister(uint8_t reg, uint8_t value);
     uint8_t readRegister(uint8_t reg);
-    bool readFIFO(uint32_t* redValue, uint32_t* irValue);
+    bool readRegisters(uint8_t reg, uint8_t* data, size_t length);
+    int readFIFO(FIFOSample* samples, int maxSamples);
     
     // Configuration constants
     static const uint16_t DEFAULT_SAMPLING_RATE = 100;  // 100Hz
@@ -205,6 +237,12 @@ private:
     static const uint8_t DEFAULT_SAMPLE_AVERAGE = 4;  // 4 samples average
     static const uint8_t DEFAULT_LED_MODE = 2;  // Red + IR mode
     static const unsigned long READING_TIMEOUT = 1000;  // 1 second
+    static const int FIFO_DEPTH = 32;  // MAX30102 FIFO holds 32 samples
+    static const int FIFO_SAMPLE_BYTES = 6;  // 3 bytes Red + 3 bytes IR
+    static const int FIFO_MAX_SAMPLES_PER_READ = I2C_MAX_TRANSFER_SIZE / 6;  // 21 samples per transaction
+    static const uint8_t FIFO_ALMOST_FULL_EMPTY_SLOTS = 15;  // Interrupt at 17 unread samples
+    static const unsigned long FIFO_POLL_TIMEOUT = 200;  // Fallback poll if INT is not wired (< 320ms FIFO)
+    static const unsigned long SAMPLE_PERIOD_MS = 10;  // 100Hz SpO2 sample rate
     static const unsigned long CALIBRATION_TIME = 10000;  // 10 seconds
     static const int MIN_CALIBRATION_READINGS = 50;
     static constexpr float MIN_SIGNAL_THRESHOLD = 50000.0f;
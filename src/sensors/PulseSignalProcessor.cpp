@@ -0,0 +1,284 @@
+#include "PulseSignalProcessor.h"
+#include <string.h>
+
+static const uint16_t WINDOW_MASK = PulseSignalProcessor::WINDOW_SIZE - 1;
+static const uint8_t WINDOW_SHIFT = 7;  // log2(WINDOW_SIZE)
+
+static_assert((PulseSignalProcessor::WINDOW_SIZE & WINDOW_MASK) == 0, "Window size must be a power of two");
+static_assert((1 << WINDOW_SHIFT) == PulseSignalProcessor::WINDOW_SIZE, "WINDOW_SHIFT does not match WINDOW_SIZE");
+
+PulseSignalProcessor::PulseSignalProcessor() {
+    reset();
+}
+
+void PulseSignalProcessor::reset() {
+    memset(&red, 0, sizeof(red));
+    memset(&ir, 0, sizeof(ir));
+    sampleSequence = 0;
+    sampleCount = 0;
+    samplesSinceSpO2 = 0;
+
+    dcEstimate = 0;
+    filtered = 0;
+    previousFiltered = 0;
+    envelope = 0;
+    filterPrimed = false;
+
+    rising = false;
+    beat = false;
+    lastBeatTime = 0;
+    memset(beatIntervals, 0, sizeof(beatIntervals));
+    beatIndex = 0;
+    beatCount = 0;
+    beatIntervalSum = 0;
+
+    heartRateX10 = 0;
+    spO2X10 = 0;
+    ratioQ8 = 0;
+}
+
+// =============================================================================
+// SAMPLE INPUT
+// =============================================================================
+
+void PulseSignalProcessor::addSample(uint32_t redValue, uint32_t irValue, uint32_t timestampMs) {
+    pushSample(red, redValue);
+    pushSample(ir, irValue);
+
+    sampleSequence++;
+    if (sampleCount < WINDOW_SIZE) {
+        sampleCount++;
+    }
+
+    updateHeartRate(irValue, timestampMs);
+
+    if (++samplesSinceSpO2 >= SPO2_UPDATE_INTERVAL) {
+        samplesSinceSpO2 = 0;
+        updateSpO2();
+    }
+}
+
+void PulseSignalProcessor::pushSample(Channel& channel, uint32_t value) {
+    uint16_t slot = sampleSequence & WINDOW_MASK;
+
+    // Drop the sample leaving the window from the sum and both deques
+    if (sampleCount == WINDOW_SIZE) {
+        channel.sum -= channel.samples[slot];
+    }
+    uint16_t oldestSequence = sampleSequence - (WINDOW_SIZE - 1);
+    expireDeque(channel.minDeque, oldestSequence);
+    expireDeque(channel.maxDeque, oldestSequence);
+
+    channel.samples[slot] = value;
+    channel.sum += value;
+
+    pushDeque(channel.minDeque, channel, sampleSequence, value, true);
+    pushDeque(channel.maxDeque, channel, sampleSequence, value, false);
+}
+
+// =============================================================================
+// MONOTONIC DEQUES
+// =============================================================================
+
+void PulseSignalProcessor::pushDeque(MonotonicDeque& deque, const Channel& channel, uint16_t sequence,
+                                     uint32_t value, bool keepMinimum) {
+    // Samples that can never be the window min (max) again leave from the back
+    while (deque.count > 0) {
+        uint16_t back = deque.sequence[(deque.head + deque.count - 1) & WINDOW_MASK];
+        uint32_t backValue = channel.samples[back & WINDOW_MASK];
+
+        if (keepMinimum ? (backValue < value) : (backValue > value)) break;
+        deque.count--;
+    }
+
+    deque.sequence[(deque.head + deque.count) & WINDOW_MASK] = sequence;
+    deque.count++;
+}
+
+void PulseSignalProcessor::expireDeque(MonotonicDeque& deque, uint16_t oldestSequence) {
+    // Sequence numbers wrap, so compare by distance from the oldest valid one
+    while (deque.count > 0 &&
+           (uint16_t)(deque.sequence[deque.head] - oldestSequence) >= WINDOW_SIZE) {
+        deque.head = (deque.head + 1) & WINDOW_MASK;
+        deque.count--;
+    }
+}
+
+uint32_t PulseSignalProcessor::windowMin(const Channel& channel) {
+    if (channel.minDeque.count == 0) return 0;
+    return channel.samples[channel.minDeque.sequence[channel.minDeque.head] & WINDOW_MASK];
+}
+
+uint32_t PulseSignalProcessor::windowMax(const Channel& channel) {
+    if (channel.maxDeque.count == 0) return 0;
+    return channel.samples[channel.maxDeque.sequence[channel.maxDeque.head] & WINDOW_MASK];
+}
+
+// =============================================================================
+// HEART RATE (BAND-PASS + PEAK DETECTOR)
+// =============================================================================
+
+void PulseSignalProcessor::updateHeartRate(uint32_t irValue, uint32_t timestampMs) {
+    int32_t sample = (int32_t)(irValue << SAMPLE_SHIFT);  // 18-bit input, Q4 fits easily
+    beat = false;
+
+    if (!filterPrimed) {
+        dcEstimate = sample;
+        filterPrimed = true;
+    }
+
+    // High-pass by subtracting a slow DC tracker, then a one-pole low-pass
+    dcEstimate += (sample - dcEstimate) >> DC_TRACK_SHIFT;
+    int32_t ac = sample - dcEstimate;
+    filtered += (ac - filtered) >> LOWPASS_SHIFT;
+
+    // Peak envelope drives an adaptive threshold at half the recent amplitude
+    int32_t amplitude = filtered < 0 ? -filtered : filtered;
+    envelope -= envelope >> ENVELOPE_DECAY_SHIFT;
+    if (amplitude > envelope) {
+        envelope = amplitude;
+    }
+    int32_t threshold = envelope >> 1;
+
+    if (sampleCount >= FILTER_SETTLE_SAMPLES) {
+        if (filtered > previousFiltered) {
+            rising = true;
+        } else if (filtered < previousFiltered) {
+            // Local maximum on the previous sample
+            if (rising && previousFiltered > threshold && threshold > MIN_PEAK_AMPLITUDE) {
+                if (lastBeatTime == 0) {
+                    lastBeatTime = timestampMs;
+                } else {
+                    uint32_t interval = timestampMs - lastBeatTime;
+
+                    // Inside the refractory period - same beat, keep the earlier one
+                    if (interval >= MIN_BEAT_INTERVAL) {
+                        if (interval <= MAX_BEAT_INTERVAL) {
+                            recordBeatInterval(interval);
+                            beat = true;
+                        }
+                        lastBeatTime = timestampMs;
+                    }
+                }
+            }
+            rising = false;
+        }
+    }
+    previousFiltered = filtered;
+
+    // Lost the pulse - stop reporting a stale rate
+    if (lastBeatTime != 0 && timestampMs - lastBeatTime > BEAT_TIMEOUT) {
+        heartRateX10 = 0;
+        beatCount = 0;
+        beatIndex = 0;
+        beatIntervalSum = 0;
+        lastBeatTime = 0;
+    }
+}
+
+void PulseSignalProcessor::recordBeatInterval(uint32_t interval) {
+    // Running sum over the last BEAT_AVERAGE_COUNT intervals
+    if (beatCount == BEAT_AVERAGE_COUNT) {
+        beatIntervalSum -= beatIntervals[beatIndex];
+    } else {
+        beatCount++;
+    }
+
+    beatIntervals[beatIndex] = (uint16_t)interval;
+    beatIntervalSum += interval;
+    beatIndex = (beatIndex + 1) % BEAT_AVERAGE_COUNT;
+
+    // One integer division per beat: BPM * 10 = 600000 / average interval
+    if (beatCount >= MIN_BEATS_FOR_RATE && beatIntervalSum > 0) {
+        heartRateX10 = (uint16_t)((600000UL * beatCount) / beatIntervalSum);
+    }
+}
+
+// =============================================================================
+// SPO2 (RATIO OF RATIOS)
+// =============================================================================
+
+void PulseSignalProcessor::updateSpO2() {
+    if (sampleCount < WINDOW_SIZE) {
+        spO2X10 = 0;
+        return;
+    }
+
+    uint32_t redDC = red.sum >> WINDOW_SHIFT;
+    uint32_t irDC = ir.sum >> WINDOW_SHIFT;
+    uint32_t redAC = windowMax(red) - windowMin(red);
+    uint32_t irAC = windowMax(ir) - windowMin(ir);
+
+    if (redDC == 0 || irDC == 0 || redAC == 0 || irAC == 0) {
+        spO2X10 = 0;
+        ratioQ8 = 0;
+        return;
+    }
+
+    // R = (RedAC / RedDC) / (IRAC / IRDC) = (RedAC * IRDC) / (RedDC * IRAC)
+    ratioQ8 = (uint32_t)(((uint64_t)redAC * irDC << 8) / ((uint64_t)redDC * irAC));
+
+    // Same simplified calibration curve as before, in SpO2 * 10 units
+    int32_t spO2;
+    if (ratioQ8 < 128) {             // R < 0.5
+        spO2 = 1000;
+    } else if (ratioQ8 < 256) {      // R < 1.0: 110 - 25R
+        spO2 = 1100 - (int32_t)((250 * ratioQ8) >> 8);
+    } else if (ratioQ8 < 512) {      // R < 2.0: 100 - 15R
+        spO2 = 1000 - (int32_t)((150 * ratioQ8) >> 8);
+    } else {
+        spO2 = 700;
+    }
+
+    if (spO2 > 1000) spO2 = 1000;
+    if (spO2 < 700) spO2 = 700;
+    spO2X10 = (uint16_t)spO2;
+}
+
+// =============================================================================
+// RESULTS
+// =============================================================================
+
+uint16_t PulseSignalProcessor::getHeartRateX10() const {
+    return heartRateX10;
+}
+
+uint16_t PulseSignalProcessor::getSpO2X10() const {
+    return spO2X10;
+}
+
+float PulseSignalProcessor::getHeartRate() const {
+    return heartRateX10 / 10.0f;
+}
+
+float PulseSignalProcessor::getSpO2() const {
+    return spO2X10 / 10.0f;
+}
+
+bool PulseSignalProcessor::isBeat() const {
+    return beat;
+}
+
+uint32_t PulseSignalProcessor::getIRDC() const {
+    return sampleCount ? ir.sum / sampleCount : 0;
+}
+
+uint32_t PulseSignalProcessor::getIRAC() const {
+    return windowMax(ir) - windowMin(ir);
+}
+
+uint32_t PulseSignalProcessor::getRedDC() const {
+    return sampleCount ? red.sum / sampleCount : 0;
+}
+
+uint32_t PulseSignalProcessor::getRedAC() const {
+    return windowMax(red) - windowMin(red);
+}
+
+uint32_t PulseSignalProcessor::getRatioQ8() const {
+    return ratioQ8;
+}
+
+bool PulseSignalProcessor::isWindowFull() const {
+    return sampleCount >= WINDOW_SIZE;
+}
@@ -0,0 +1,116 @@
+#ifndef PULSE_SIGNAL_PROCESSOR_H
+#define PULSE_SIGNAL_PROCESSOR_H
+
+#include <Arduino.h>
+
+// =============================================================================
+// PULSE SIGNAL PROCESSOR
+// =============================================================================
+
+/**
+ * Streaming PPG processing for one Red/IR sensor.
+ *
+ * Every sample costs O(1) integer work:
+ *  - Red/IR DC from running sums over a WINDOW_SIZE sample window
+ *  - Red/IR AC (max - min) from monotonic min/max deques over the same window
+ *  - SpO2 from the AC/DC ratio in Q8 fixed point
+ *  - Heart rate from an IR band-pass (DC tracker + low-pass, ~0.25-4Hz at
+ *    100Hz) feeding an adaptive-threshold peak detector
+ *
+ * All state lives in the instance, so several sensors can run side by side.
+ */
+class PulseSignalProcessor {
+public:
+    PulseSignalProcessor();
+
+    void reset();
+    void addSample(uint32_t redValue, uint32_t irValue, uint32_t timestampMs);
+
+    // Results (0 until enough data has been seen)
+    uint16_t getHeartRateX10() const;
+    uint16_t getSpO2X10() const;
+    float getHeartRate() const;
+    float getSpO2() const;
+    bool isBeat() const;  // True if the last sample completed a beat
+
+    // Window statistics
+    uint32_t getIRDC() const;
+    uint32_t getIRAC() const;
+    uint32_t getRedDC() const;
+    uint32_t getRedAC() const;
+    uint32_t getRatioQ8() const;  // R = (RedAC/RedDC) / (IRAC/IRDC), Q8
+    bool isWindowFull() const;
+
+    // Processing window (power of two, 1.28s at 100Hz - at least one beat above 47 BPM)
+    static const uint16_t WINDOW_SIZE = 128;
+
+private:
+    // Monotonic deque of sample sequence numbers - front is the window min (or max)
+    struct MonotonicDeque {
+        uint16_t sequence[WINDOW_SIZE];
+        uint16_t head;
+        uint16_t count;
+    };
+
+    // One optical channel: sample window, running sum and min/max deques
+    struct Channel {
+        uint32_t samples[WINDOW_SIZE];
+        uint32_t sum;
+        MonotonicDeque minDeque;
+        MonotonicDeque maxDeque;
+    };
+
+    Channel red;
+    Channel ir;
+    uint16_t sampleSequence;
+    uint16_t sampleCount;      // Saturates at WINDOW_SIZE
+    uint8_t samplesSinceSpO2;
+
+    // Band-pass filter state (Q4)
+    int32_t dcEstimate;
+    int32_t filtered;
+    int32_t previousFiltered;
+    int32_t envelope;
+    bool filterPrimed;
+
+    // Peak detector state
+    bool rising;
+    bool beat;
+    uint32_t lastBeatTime;
+    uint16_t beatIntervals[5];
+    uint8_t beatIndex;
+    uint8_t beatCount;
+    uint32_t beatIntervalSum;
+
+    // Outputs
+    uint16_t heartRateX10;
+    uint16_t spO2X10;
+    uint32_t ratioQ8;
+
+    void pushSample(Channel& channel, uint32_t value);
+    static uint32_t windowMin(const Channel& channel);
+    static uint32_t windowMax(const Channel& channel);
+    static void pushDeque(MonotonicDeque& deque, const Channel& channel, uint16_t sequence,
+                          uint32_t value, bool keepMinimum);
+    static void expireDeque(MonotonicDeque& deque, uint16_t oldestSequence);
+
+    void updateHeartRate(uint32_t irValue, uint32_t timestampMs);
+    void recordBeatInterval(uint32_t interval);
+    void updateSpO2();
+
+    // Filter and detector tuning
+    static const uint8_t SAMPLE_SHIFT = 4;        // Q4 fixed point for the filter chain
+    static const uint8_t DC_TRACK_SHIFT = 6;      // High-pass: ~0.25Hz corner at 100Hz
+    static const uint8_t LOWPASS_SHIFT = 2;       // Low-pass: ~4Hz corner at 100Hz
+    static const uint8_t ENVELOPE_DECAY_SHIFT = 7; // Peak envelope decay (~1.3s)
+    static const uint8_t BEAT_AVERAGE_COUNT = 5;
+    static const uint8_t MIN_BEATS_FOR_RATE = 3;
+    static const uint32_t MIN_BEAT_INTERVAL = 333;   // 180 BPM
+    static const uint32_t MAX_BEAT_INTERVAL = 1500;  // 40 BPM
+    static const uint16_t FILTER_SETTLE_SAMPLES = 64;   // Ignore peaks while the DC tracker converges
+    static const int32_t MIN_PEAK_AMPLITUDE = 20 << 4;  // Noise floor (20 counts, Q4)
+    static const uint32_t BEAT_TIMEOUT = 4500;          // No beat for 3 max intervals - rate unknown
+    static const uint8_t SPO2_UPDATE_INTERVAL = 10;     // Samples between SpO2 updates (10Hz)
+};
+
+#endif
@@ -0,0 +1,343 @@
+#include "SensorFusion.h"
+#include "../utils/Logger.h"
+#include "../hardware/FreeRTOSManager.h"
+#include "../hardware/ResourceProfiler.h"
+#include "../hardware/TaskTracer.h"
+
+SensorFusion::SensorFusion()
+    : initialized(false), taskRunning(false), taskHandle(nullptr), seenMask(0),
+      frameCallback(nullptr), frameCount(0), rejectedInputs(0) {
+    pulseWindow.clear();
+    motionWindow.clear();
+    for (uint8_t i = 0; i < SENSOR_FUSION_PRESSURE_CHANNELS; i++) {
+        pressureWindows[i].clear();
+    }
+}
+
+// =============================================================================
+// INITIALIZATION AND LIFECYCLE
+// =============================================================================
+
+void SensorFusion::initialize() {
+    if (initialized) {
+        Logger::warning("Sensor Fusion already initialized");
+        return;
+    }
+
+    Logger::info("Initializing Sensor Fusion...");
+
+    pulseStream.clear();
+    motionStream.clear();
+    pressureStream.clear();
+    fusedStream.clear();
+
+    pulseWindow.clear();
+    motionWindow.clear();
+    for (uint8_t i = 0; i < SENSOR_FUSION_PRESSURE_CHANNELS; i++) {
+        pressureWindows[i].clear();
+    }
+    seenMask = 0;
+    frameCount = 0;
+    rejectedInputs = 0;
+
+    initialized = true;
+    startTask();
+
+    Logger::infof("Sensor Fusion initialized: %lu ms tick, %lu ms latency",
+                 (unsigned long)(TASK_DELAY_DATA_FUSION * portTICK_PERIOD_MS), SENSOR_FUSION_LATENCY);
+}
+
+void SensorFusion::shutdown() {
+    if (!initialized) return;
+
+    Logger::info("Shutting down Sensor Fusion...");
+    stopTask();
+    initialized = false;
+    Logger::info("Sensor Fusion shutdown complete");
+}
+
+// =============================================================================
+// FREERTOS TASK MANAGEMENT
+// =============================================================================
+
+void SensorFusion::startTask() {
+    if (taskRunning || taskHandle) return;
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        dataFusionTask,
+        "DataFusion",
+        ResourceProfiler::getStackSize(ProfiledTask::DATA_FUSION),
+        this,
+        PRIORITY_DATA_FUSION,
+        &taskHandle,
+        CORE_APPLICATION  // Core 1 for application tasks
+    );
+
+    if (result == pdPASS) {
+        taskRunning = true;
+        FreeRTOSManager::setDataFusionTask(taskHandle);
+        Logger::info("Data Fusion task started on Core 1");
+    } else {
+        Logger::error("Failed to create Data Fusion task");
+    }
+}
+
+void SensorFusion::stopTask() {
+    if (!taskRunning || !taskHandle) return;
+
+    taskRunning = false;
+    FreeRTOSManager::setDataFusionTask(nullptr);
+    vTaskDelete(taskHandle);
+    taskHandle = nullptr;
+
+    Logger::info("Data Fusion task stopped");
+}
+
+bool SensorFusion::isTaskRunning() {
+    return taskRunning && taskHandle != nullptr;
+}
+
+void SensorFusion::dataFusionTask(void* parameter) {
+    SensorFusion* fusion = static_cast<SensorFusion*>(parameter);
+    Logger::info("Data Fusion task started");
+
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    TraceId traceId = TaskTracer::registerTask("DataFusion",
+                                               TASK_DELAY_DATA_FUSION * portTICK_PERIOD_MS * 1000);
+
+    while (fusion->taskRunning) {
+        vTaskDelayUntil(&lastWakeTime, TASK_DELAY_DATA_FUSION);
+        TaskTracer::ScopedTimer timer(traceId);
+
+        fusion->drainInputs();
+        if (fusion->seenMask == 0) continue;  // No sensor has reported yet
+
+        // Build the frame in place; a full stream is counted as a drop
+        FusedSensorData* frame = fusion->fusedStream.beginWrite();
+        if (!frame) continue;
+
+        fusion->fuse(millis() - SENSOR_FUSION_LATENCY, *frame);
+        fusion->fusedStream.commitWrite();
+        fusion->frameCount++;
+
+        if (fusion->frameCallback) {
+            fusion->frameCallback();
+        }
+    }
+
+    Logger::info("Data Fusion task ended");
+    vTaskDelete(nullptr);  // Delete self
+}
+
+// =============================================================================
+// PRODUCER AND CONSUMER INTERFACE
+// =============================================================================
+
+bool SensorFusion::pushPulse(const PulseReading& reading) {
+    return pulseStream.push(reading);
+}
+
+bool SensorFusion::pushMotion(const MotionReading& reading) {
+    return motionStream.push(reading);
+}
+
+bool SensorFusion::pushPressure(const PressureReading& reading) {
+    return pressureStream.push(reading);
+}
+
+FusedDataStream& SensorFusion::getFusedStream() {
+    return fusedStream;
+}
+
+void SensorFusion::setFrameCallback(void (*callback)()) {
+    frameCallback = callback;
+}
+
+// =============================================================================
+// FUSION
+// =============================================================================
+
+template <typename T, size_t N>
+bool SensorFusion::Window<T, N>::add(const T& sample) {
+    // Interpolation needs time order; equal timestamps are fine
+    if (count > 0 && (int32_t)(sample.timestamp - newest(0).timestamp) < 0) {
+        return false;
+    }
+
+    samples[next] = sample;
+    next = (next + 1) % N;
+    if (count < N) count++;
+    return true;
+}
+
+void SensorFusion::drainInputs() {
+    PulseReading pulse;
+    while (pulseStream.pop(pulse)) {
+        if (pulseWindow.add(pulse)) {
+            seenMask |= SENSOR_PULSE;
+        } else {
+            rejectedInputs++;
+        }
+    }
+
+    MotionReading motion;
+    while (motionStream.pop(motion)) {
+        if (motionWindow.add(motion)) {
+            seenMask |= SENSOR_MOTION;
+        } else {
+            rejectedInputs++;
+        }
+    }
+
+    PressureReading pressure;
+    while (pressureStream.pop(pressure)) {
+        uint8_t channel = pressure.sensorIndex;
+        if (channel < SENSOR_FUSION_PRESSURE_CHANNELS && pressureWindows[channel].add(pressure)) {
+            seenMask |= SENSOR_PRESSURE_FIRST << channel;
+        } else {
+            rejectedInputs++;
+        }
+    }
+}
+
+void SensorFusion::fuse(uint32_t sampleTime, FusedSensorData& frame) {
+    uint8_t validMask = 0;
+    float qualitySum = 0.0f;
+
+    frame.timestamp = sampleTime;
+
+    if (sampleAt(pulseWindow, sampleTime, SENSOR_FUSION_MAX_AGE_PULSE, frame.pulse)) {
+        validMask |= SENSOR_PULSE;
+        qualitySum += frame.pulse.quality;
+    } else {
+        frame.pulse.valid = false;
+    }
+
+    if (sampleAt(motionWindow, sampleTime, SENSOR_FUSION_MAX_AGE_MOTION, frame.motion)) {
+        validMask |= SENSOR_MOTION;
+        qualitySum += frame.motion.quality;
+    } else {
+        frame.motion.valid = false;
+    }
+
+    for (uint8_t i = 0; i < SENSOR_FUSION_PRESSURE_CHANNELS; i++) {
+        if (sampleAt(pressureWindows[i], sampleTime, SENSOR_FUSION_MAX_AGE_PRESSURE, frame.pressure[i])) {
+            validMask |= SENSOR_PRESSURE_FIRST << i;
+            qualitySum += frame.pressure[i].quality;
+        } else {
+            frame.pressure[i].valid = false;
+            frame.pressure[i].sensorIndex = i;
+        }
+    }
+
+    frame.activeSensorCount = __builtin_popcount(validMask);
+    frame.allSensorsValid = (validMask == seenMask);
+    frame.overallQuality = frame.activeSensorCount > 0 ? qualitySum / frame.activeSensorCount : 0.0f;
+}
+
+template <typename T, size_t N>
+bool SensorFusion::sampleAt(const Window<T, N>& window, uint32_t time, uint32_t maxAge, T& out) {
+    if (window.count == 0) return false;
+
+    // Newest reading at or before the sampling instant, and the one after it
+    const T* before = nullptr;
+    const T* after = nullptr;
+    for (size_t age = 0; age < window.count; age++) {
+        const T& sample = window.newest(age);
+        if ((int32_t)(time - sample.timestamp) >= 0) {
+            before = &sample;
+            break;
+        }
+        after = &sample;
+    }
+
+    // Interpolate between two valid readings that are close enough together
+    if (before && after && before->valid && after->valid) {
+        uint32_t span = after->timestamp - before->timestamp;  // > 0, after is newer than time
+        if (span <= 2 * maxAge) {
+            interpolate(*before, *after, (float)(time - before->timestamp) / span, out);
+            out.timestamp = time;
+            return true;
+        }
+    }
+
+    // Otherwise hold the nearest reading while it is recent enough
+    uint32_t beforeAge = before ? time - before->timestamp : UINT32_MAX;
+    uint32_t afterAge = after ? after->timestamp - time : UINT32_MAX;
+    const T* nearest = beforeAge <= afterAge ? before : after;
+    if (min(beforeAge, afterAge) > maxAge) return false;
+
+    out = *nearest;
+    return out.valid;
+}
+
+float SensorFusion::lerp(float a, float b, float f) {
+    return a + (b - a) * f;
+}
+
+void SensorFusion::interpolate(const PulseReading& a, const PulseReading& b, float f, PulseReading& out) {
+    out.quality = lerp(a.quality, b.quality, f);
+    out.valid = true;
+    out.sensorId = b.sensorId;
+    out.heartRate = (uint16_t)(lerp(a.heartRate, b.heartRate, f) + 0.5f);
+    out.spO2 = (uint8_t)(lerp(a.spO2, b.spO2, f) + 0.5f);
+    out.redValue = (uint32_t)lerp(a.redValue, b.redValue, f);
+    out.irValue = (uint32_t)lerp(a.irValue, b.irValue, f);
+    out.signalStrength = lerp(a.signalStrength, b.signalStrength, f);
+}
+
+void SensorFusion::interpolate(const MotionReading& a, const MotionReading& b, float f, MotionReading& out) {
+    out.quality = lerp(a.quality, b.quality, f);
+    out.valid = true;
+    out.sensorId = b.sensorId;
+    out.accelX = lerp(a.accelX, b.accelX, f);
+    out.accelY = lerp(a.accelY, b.accelY, f);
+    out.accelZ = lerp(a.accelZ, b.accelZ, f);
+    out.gyroX = lerp(a.gyroX, b.gyroX, f);
+    out.gyroY = lerp(a.gyroY, b.gyroY, f);
+    out.gyroZ = lerp(a.gyroZ, b.gyroZ, f);
+    out.temperature = lerp(a.temperature, b.temperature, f);
+    out.motionDetected = a.motionDetected || b.motionDetected;
+    out.movementIntensity = lerp(a.movementIntensity, b.movementIntensity, f);
+}
+
+void SensorFusion::interpolate(const PressureReading& a, const PressureReading& b, float f, PressureReading& out) {
+    out.quality = lerp(a.quality, b.quality, f);
+    out.valid = true;
+    out.sensorId = b.sensorId;
+    out.force = lerp(a.force, b.force, f);
+    out.pressure = lerp(a.pressure, b.pressure, f);
+    out.rawValue = (uint16_t)(lerp(a.rawValue, b.rawValue, f) + 0.5f);
+    out.sensorIndex = b.sensorIndex;
+    out.contact = (f < 0.5f) ? a.contact : b.contact;
+}
+
+// =============================================================================
+// STATISTICS
+// =============================================================================
+
+uint32_t SensorFusion::getFrameCount() {
+    return frameCount;
+}
+
+uint32_t SensorFusion::getDroppedFrameCount() {
+    return fusedStream.getDroppedCount();
+}
+
+uint32_t SensorFusion::getDroppedInputCount() {
+    return pulseStream.getDroppedCount() + motionStream.getDroppedCount() +
+           pressureStream.getDroppedCount();
+}
+
+uint32_t SensorFusion::getRejectedInputCount() {
+    return rejectedInputs;
+}
+
+void SensorFusion::logStatistics() {
+    Logger::info("=== Sensor Fusion Statistics ===");
+    Logger::infof("Task: %s", isTaskRunning() ? "Running" : "Stopped");
+    Logger::infof("Frames: %lu (%lu dropped)", frameCount, getDroppedFrameCount());
+    Logger::infof("Inputs: %lu dropped, %lu rejected", getDroppedInputCount(), rejectedInputs);
+    Logger::infof("Sensors seen: 0x%02X", seenMask);
+    Logger::info("===============================");
+}
@@ -0,0 +1,123 @@
+#ifndef SENSOR_FUSION_H
+#define SENSOR_FUSION_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config/Config.h"
+#include "../hardware/I2CManager.h"
+#include "../memory/SPSCRingBuffer.h"
+
+// Fusion inputs (one producer task each) and output (one consumer task)
+typedef SPSCRingBuffer<PulseReading, STREAM_SIZE_PULSE_PROCESSED> FusionPulseStream;
+typedef SPSCRingBuffer<MotionReading, STREAM_SIZE_MOTION_PROCESSED> FusionMotionStream;
+typedef SPSCRingBuffer<PressureReading, STREAM_SIZE_PRESSURE_RAW> FusionPressureStream;  // All channels
+typedef SPSCRingBuffer<FusedSensorData, STREAM_SIZE_FUSED_DATA> FusedDataStream;
+
+// =============================================================================
+// SENSOR FUSION
+// =============================================================================
+
+/**
+ * Merges pulse, motion and pressure readings into one FusedSensorData frame
+ * per TASK_DELAY_DATA_FUSION tick.
+ *
+ * Producers push timestamped readings into per-sensor SPSC streams. The
+ * DataFusion task moves them into short per-sensor history windows and
+ * samples every sensor at the same instant, now - SENSOR_FUSION_LATENCY:
+ * between two readings the values are interpolated linearly, past the
+ * newest reading the last value is held for the sensor's maximum age, and
+ * beyond that the sensor is reported invalid. The lag lets the fast sensors
+ * deliver the reading after the sampling instant, so motion is interpolated
+ * rather than extrapolated.
+ *
+ * A frame is emitted once any sensor has reported. allSensorsValid means
+ * every sensor seen so far is valid at the sampling instant.
+ */
+class SensorFusion {
+public:
+    SensorFusion();
+
+    // Initialization and lifecycle
+    void initialize();
+    void shutdown();
+
+    // FreeRTOS task management
+    void startTask();
+    void stopTask();
+    bool isTaskRunning();
+
+    // Producers - each stream has exactly one producer task, in time order
+    bool pushPulse(const PulseReading& reading);
+    bool pushMotion(const MotionReading& reading);
+    bool pushPressure(const PressureReading& reading);  // sensorIndex selects the channel
+
+    // Consumer - fused frames for exactly one consumer task
+    FusedDataStream& getFusedStream();
+    void setFrameCallback(void (*callback)());  // Called on the fusion task after each frame
+
+    // Statistics
+    uint32_t getFrameCount();
+    uint32_t getDroppedFrameCount();
+    uint32_t getDroppedInputCount();     // Input streams full
+    uint32_t getRejectedInputCount();    // Out of order or unknown pressure channel
+    void logStatistics();
+
+private:
+    // Recent readings of one sensor, newest last (fusion task only)
+    template <typename T, size_t N>
+    struct Window {
+        T samples[N];
+        uint8_t count;
+        uint8_t next;
+
+        void clear() { count = 0; next = 0; }
+        const T& newest(size_t age) const { return samples[(next + N - 1 - age) % N]; }
+        bool add(const T& sample);
+    };
+
+    bool initialized;
+    bool taskRunning;
+    TaskHandle_t taskHandle;
+
+    // Input streams
+    FusionPulseStream pulseStream;
+    FusionMotionStream motionStream;
+    FusionPressureStream pressureStream;
+
+    // History windows (fusion task only)
+    Window<PulseReading, 4> pulseWindow;
+    Window<MotionReading, 16> motionWindow;
+    Window<PressureReading, 8> pressureWindows[SENSOR_FUSION_PRESSURE_CHANNELS];
+    uint8_t seenMask;  // Bit per sensor that has ever reported
+
+    // Output
+    FusedDataStream fusedStream;
+    void (*frameCallback)();
+
+    // Statistics
+    uint32_t frameCount;
+    uint32_t rejectedInputs;
+
+    // Task function
+    static void dataFusionTask(void* parameter);
+
+    // Fusion
+    void drainInputs();
+    void fuse(uint32_t sampleTime, FusedSensorData& frame);
+
+    template <typename T, size_t N>
+    static bool sampleAt(const Window<T, N>& window, uint32_t time, uint32_t maxAge, T& out);
+
+    static void interpolate(const PulseReading& a, const PulseReading& b, float f, PulseReading& out);
+    static void interpolate(const MotionReading& a, const MotionReading& b, float f, MotionReading& out);
+    static void interpolate(const PressureReading& a, const PressureReading& b, float f, PressureReading& out);
+    static float lerp(float a, float b, float f);
+
+    // Sensor bits in seenMask
+    static const uint8_t SENSOR_PULSE = 1 << 0;
+    static const uint8_t SENSOR_MOTION = 1 << 1;
+    static const uint8_t SENSOR_PRESSURE_FIRST = 1 << 2;  // One bit per channel from here
+};
+
+#endif
@@ -0,0 +1,617 @@
+#include "SessionRecorder.h"
+#include <LittleFS.h>
+#include "../network/MQTTManager.h"
+#include "../network/TelemetryBatch.h"
+#include "../utils/Logger.h"
+#include "../utils/TimeManager.h"
+#include "../hardware/ResourceProfiler.h"
+
+const char* SessionRecorder::PARTITION_LABEL = "recorder";
+const char* SessionRecorder::CURSOR_PATH = "/cursor.bin";
+
+static_assert(SESSION_RECORDER_PAGE_SIZE % sizeof(RecordedEvent) == 0,
+              "Recorder page must hold a whole number of records");
+static_assert(SESSION_RECORDER_SEGMENT_SIZE % SESSION_RECORDER_PAGE_SIZE == 0,
+              "Recorder segment must hold a whole number of pages");
+
+// Replay position, rewritten every CURSOR_SAVE_INTERVAL replayed records
+struct RecorderCursor {
+    uint32_t magic;
+    uint32_t segment;
+    uint32_t offset;
+};
+
+SessionRecorder::SessionRecorder()
+    : mutex(nullptr), available(false), pageFill(0), pageStartTime(0),
+      writeSegment(0), writeSegmentSize(0), readSegment(0), readOffset(0),
+      recordsSinceCursorSave(0), lastReplayTime(0),
+      stagedStart(0), stagedCount(0), stagingDroppedCount(0),
+      backlogRecords(0), recordedCount(0), replayedCount(0), droppedCount(0) {
+    stagingLock = portMUX_INITIALIZER_UNLOCKED;
+}
+
+bool SessionRecorder::initialize() {
+    if (available) return true;
+
+    if (!SESSION_RECORDER_ENABLED) {
+        Logger::info("Session recorder disabled");
+        return false;
+    }
+
+    Logger::info("Initializing Session Recorder...");
+
+    if (!mutex) {
+        mutex = xSemaphoreCreateMutex();
+        if (!mutex) {
+            Logger::error("Failed to create session recorder mutex");
+            return false;
+        }
+    }
+
+    // Formats the partition on first boot
+    if (!LittleFS.begin(true, "/recorder", 2, PARTITION_LABEL)) {
+        Logger::error("Failed to mount recorder partition - offline session data will be lost");
+        return false;
+    }
+
+    scanSegments();
+    loadCursor();
+    available = true;
+
+    Logger::infof("Session recorder ready: %lu records backlog, segments %lu-%lu (%u/%u KB used)",
+                  (unsigned long)backlogRecords, (unsigned long)readSegment, (unsigned long)writeSegment,
+                  LittleFS.usedBytes() / 1024, LittleFS.totalBytes() / 1024);
+    return true;
+}
+
+void SessionRecorder::shutdown() {
+    if (!available) return;
+
+    flush();
+
+    if (lock()) {
+        saveCursor();
+        available = false;
+        unlock();
+    }
+
+    LittleFS.end();
+    Logger::info("Session recorder shutdown complete");
+}
+
+bool SessionRecorder::isAvailable() {
+    return available;
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+bool SessionRecorder::recordSessionStart(const String& sessionId, const String& sessionType, bool bleConnected,
+                                         bool autoStarted) {
+    RecordedEvent record;
+    startRecord(record, RecordedEventType::SESSION_START, sessionId);
+    record.flags = (bleConnected ? RECORD_FLAG_BLE_CONNECTED : 0) | (autoStarted ? RECORD_FLAG_AUTO_STARTED : 0);
+    record.data.sessionStart.sessionType = sessionTypeCode(sessionType);
+
+    return appendRecord(record);
+}
+
+bool SessionRecorder::recordSessionEnd(const String& sessionId, const String& sessionType, const String& endReason,
+                                       unsigned long duration, int totalMovements, int successfulMovements, int cycles) {
+    RecordedEvent record;
+    startRecord(record, RecordedEventType::SESSION_END, sessionId);
+
+    RecordedSessionEnd& end = record.data.sessionEnd;
+    end.durationMs = duration;
+    end.totalMovements = constrain(totalMovements, 0, 65535);
+    end.successfulMovements = constrain(successfulMovements, 0, 65535);
+    end.cycles = constrain(cycles, 0, 65535);
+    end.sessionType = sessionTypeCode(sessionType);
+    copyPadded(end.endReason, sizeof(end.endReason), endReason);
+
+    // Session boundaries go to flash straight away
+    bool recorded = appendRecord(record);
+    flush();
+    return recorded;
+}
+
+bool SessionRecorder::recordMovement(int servoIndex, unsigned long startTime, unsigned long duration,
+                                     bool successful, int startAngle, int targetAngle, int actualAngle,
+                                     float smoothness, const String& movementType, const String& sessionId) {
+    RecordedEvent record;
+    startRecord(record, RecordedEventType::MOVEMENT, sessionId);
+    record.flags = successful ? RECORD_FLAG_SUCCESSFUL : 0;
+
+    RecordedMovement& movement = record.data.movement;
+    movement.startTime = startTime;
+    movement.durationMs = duration;
+    movement.smoothness = smoothness;
+    movement.servoIndex = constrain(servoIndex, 0, 255);
+    movement.startAngle = constrain(startAngle, 0, 255);
+    movement.targetAngle = constrain(targetAngle, 0, 255);
+    movement.actualAngle = constrain(actualAngle, 0, 255);
+    movement.movementType = TelemetryBatch::movementCode(movementType);
+
+    return appendRecord(record);
+}
+
+bool SessionRecorder::recordHeartRate(float heartRate, float spO2, const String& quality,
+                                      bool fingerDetected, const String& sessionId) {
+    RecordedEvent record;
+    startRecord(record, RecordedEventType::HEART_RATE, sessionId);
+    record.flags = fingerDetected ? RECORD_FLAG_FINGER_DETECTED : 0;
+
+    record.data.heartRate.heartRate = heartRate;
+    record.data.heartRate.spO2 = spO2;
+    record.data.heartRate.quality = TelemetryBatch::qualityCode(quality);
+
+    return appendRecord(record);
+}
+
+void SessionRecorder::startRecord(RecordedEvent& record, RecordedEventType type, const String& sessionId) {
+    memset(&record, 0, sizeof(record));
+    record.magic = RECORDED_EVENT_MAGIC;
+    record.type = (uint8_t)type;
+    record.timestamp = TimeManager::getCurrentTimestamp();
+    record.timestampMs = millis() % 1000;
+    copyPadded(record.sessionId, sizeof(record.sessionId), sessionId);
+}
+
+bool SessionRecorder::appendRecord(RecordedEvent& record) {
+    if (!available) return false;
+
+    record.checksum = checksum(record);
+
+    // Replay holds the lock through flash and MQTT work - stage the record
+    // instead of losing it, the next call that gets the lock writes it first
+    if (!lock()) return stageRecord(record);
+
+    storeStagedRecords();
+    bool stored = storeRecord(record);
+    unlock();
+    return stored;
+}
+
+bool SessionRecorder::storeRecord(const RecordedEvent& record) {
+    // mutex must be held
+
+    // Make room - if the page cannot be written the new record is the one lost
+    if (pageFill + RECORD_SIZE > sizeof(pageBuffer) && !flushPage()) {
+        droppedCount++;
+        return false;
+    }
+
+    if (pageFill == 0) {
+        pageStartTime = millis();
+    }
+
+    memcpy(pageBuffer + pageFill, &record, RECORD_SIZE);
+    pageFill += RECORD_SIZE;
+    recordedCount++;
+    backlogRecords++;
+
+    // Full pages go out immediately, partial ones from update()
+    if (pageFill >= sizeof(pageBuffer)) {
+        flushPage();
+    }
+
+    return true;
+}
+
+bool SessionRecorder::stageRecord(const RecordedEvent& record) {
+    portENTER_CRITICAL(&stagingLock);
+    bool staged = stagedCount < SESSION_RECORDER_STAGED_RECORDS;
+    if (staged) {
+        stagedRecords[(stagedStart + stagedCount) % SESSION_RECORDER_STAGED_RECORDS] = record;
+        stagedCount++;
+    } else {
+        stagingDroppedCount++;
+    }
+    portEXIT_CRITICAL(&stagingLock);
+    return staged;
+}
+
+void SessionRecorder::storeStagedRecords() {
+    // mutex must be held; one record at a time keeps the spinlock short
+    while (true) {
+        RecordedEvent record;
+        portENTER_CRITICAL(&stagingLock);
+        bool have = stagedCount > 0;
+        if (have) {
+            record = stagedRecords[stagedStart];
+            stagedStart = (stagedStart + 1) % SESSION_RECORDER_STAGED_RECORDS;
+            stagedCount--;
+        }
+        portEXIT_CRITICAL(&stagingLock);
+
+        if (!have) return;
+        storeRecord(record);
+    }
+}
+
+bool SessionRecorder::flushPage() {
+    if (pageFill == 0) return true;
+
+    if (writeSegmentSize + pageFill > SESSION_RECORDER_SEGMENT_SIZE) {
+        writeSegment++;
+        writeSegmentSize = 0;
+        enforceCapacity();
+    }
+
+    char path[24];
+    segmentPath(writeSegment, path, sizeof(path));
+
+    File file = LittleFS.open(path, FILE_APPEND);
+    if (!file) {
+        Logger::warningf("Session recorder: cannot open %s", path);
+        return false;
+    }
+
+    size_t written = file.write(pageBuffer, pageFill);
+    file.close();
+
+    if (written != pageFill) {
+        // Partial write (flash full or failing): whatever records made it in
+        // are kept, the segment is closed so later records stay aligned
+        uint32_t lost = (pageFill - written + RECORD_SIZE - 1) / RECORD_SIZE;
+        droppedCount += lost;
+        backlogRecords = backlogRecords > lost ? backlogRecords - lost : 0;
+
+        Logger::warningf("Session recorder write failed (%u of %u bytes)", written, pageFill);
+        writeSegment++;
+        writeSegmentSize = 0;
+        pageFill = 0;
+        return false;
+    }
+
+    writeSegmentSize += written;
+    pageFill = 0;
+    return true;
+}
+
+void SessionRecorder::enforceCapacity() {
+    // Oldest data gives way once the ring is full
+    while (writeSegment - readSegment >= SESSION_RECORDER_MAX_SEGMENTS) {
+        uint32_t records = segmentRecords(readSegment);
+        uint32_t consumed = readOffset / RECORD_SIZE;
+        uint32_t lost = records > consumed ? records - consumed : 0;
+
+        char path[24];
+        segmentPath(readSegment, path, sizeof(path));
+        LittleFS.remove(path);
+
+        droppedCount += lost;
+        backlogRecords = backlogRecords > lost ? backlogRecords - lost : 0;
+        readSegment++;
+        readOffset = 0;
+        saveCursor();
+
+        Logger::warningf("Session recorder full - dropped %lu oldest records", (unsigned long)lost);
+    }
+}
+
+void SessionRecorder::flush() {
+    if (!available || !lock()) return;
+
+    storeStagedRecords();
+    flushPage();
+    unlock();
+}
+
+// =============================================================================
+// REPLAY
+// =============================================================================
+
+void SessionRecorder::update(MQTTManager& mqtt) {
+    if (!available || !lock()) return;
+
+    unsigned long now = millis();
+    storeStagedRecords();
+
+    // Bound how much a power cut can lose
+    if (pageFill > 0 && now - pageStartTime >= SESSION_RECORDER_FLUSH_INTERVAL) {
+        flushPage();
+    }
+
+    if (mqtt.isConnected()) {
+        replay(mqtt, now);
+    }
+
+    unlock();
+}
+
+void SessionRecorder::replay(MQTTManager& mqtt, unsigned long now) {
+    if (backlogRecords == 0) return;
+    if (now - lastReplayTime < SESSION_RECORDER_REPLAY_INTERVAL) return;
+    lastReplayTime = now;
+
+    // Live traffic keeps at least half of the publish queue
+    if (mqtt.getQueuedMessageCount() >= (int)(ResourceProfiler::getQueueDepth(ProfiledQueue::MQTT_PUBLISH) / 2)) return;
+
+    RecordedEvent records[SESSION_RECORDER_REPLAY_BATCH];
+    size_t count = readRecords(records, SESSION_RECORDER_REPLAY_BATCH);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!isValid(records[i])) {
+            droppedCount++;  // Torn or corrupted on flash
+            advanceRead();
+            continue;
+        }
+
+        // Not accepted right now - retried from the same record next interval
+        if (!mqtt.publishRecordedEvent(records[i])) break;
+
+        replayedCount++;
+        advanceRead();
+    }
+
+    // Everything replayed: drop the segment and start a fresh one
+    if (readSegment == writeSegment && readOffset >= writeSegmentSize && pageFill == 0) {
+        if (writeSegmentSize > 0) {
+            char path[24];
+            segmentPath(writeSegment, path, sizeof(path));
+            LittleFS.remove(path);
+
+            writeSegment++;
+            writeSegmentSize = 0;
+            readSegment = writeSegment;
+            readOffset = 0;
+            saveCursor();
+        }
+
+        backlogRecords = 0;
+        Logger::infof("Session recorder backlog replayed (%lu records total)", (unsigned long)replayedCount);
+    }
+}
+
+size_t SessionRecorder::readRecords(RecordedEvent* records, size_t maxRecords) {
+    while (true) {
+        char path[24];
+        segmentPath(readSegment, path, sizeof(path));
+
+        File file = LittleFS.open(path, FILE_READ);
+        size_t size = file ? file.size() - (file.size() % RECORD_SIZE) : 0;
+
+        if (readOffset + RECORD_SIZE <= size) {
+            size_t count = min(maxRecords, (size_t)((size - readOffset) / RECORD_SIZE));
+            file.seek(readOffset);
+            size_t bytes = file.read((uint8_t*)records, count * RECORD_SIZE);
+            file.close();
+            return bytes / RECORD_SIZE;
+        }
+
+        if (file) file.close();
+
+        if (readSegment < writeSegment) {
+            finishReadSegment();
+            continue;
+        }
+
+        // Caught up with the writer - records still in RAM go out too
+        if (pageFill > 0 && flushPage()) {
+            continue;
+        }
+
+        return 0;
+    }
+}
+
+void SessionRecorder::advanceRead() {
+    readOffset += RECORD_SIZE;
+    if (backlogRecords > 0) backlogRecords--;
+
+    if (++recordsSinceCursorSave >= CURSOR_SAVE_INTERVAL) {
+        saveCursor();
+    }
+}
+
+void SessionRecorder::finishReadSegment() {
+    char path[24];
+    segmentPath(readSegment, path, sizeof(path));
+    LittleFS.remove(path);
+
+    readSegment++;
+    readOffset = 0;
+    saveCursor();
+}
+
+// =============================================================================
+// SEGMENT BOOKKEEPING
+// =============================================================================
+
+void SessionRecorder::scanSegments() {
+    bool found = false;
+    uint32_t first = 0;
+    uint32_t last = 0;
+
+    File root = LittleFS.open("/");
+    File entry = root ? root.openNextFile() : File();
+    while (entry) {
+        const char* name = entry.name();
+        if (name[0] == '/') name++;
+
+        if (!entry.isDirectory() && strncmp(name, "seg_", 4) == 0) {
+            uint32_t segment = strtoul(name + 4, nullptr, 10);
+            if (!found || segment < first) first = segment;
+            if (!found || segment > last) last = segment;
+            found = true;
+        }
+
+        entry.close();
+        entry = root.openNextFile();
+    }
+    if (root) root.close();
+
+    readOffset = 0;
+    backlogRecords = 0;
+
+    if (!found) {
+        readSegment = writeSegment = 0;
+        writeSegmentSize = 0;
+        return;
+    }
+
+    readSegment = first;
+    for (uint32_t segment = first; segment <= last; segment++) {
+        backlogRecords += segmentRecords(segment);
+    }
+
+    // Keep appending to the newest segment unless it is full or ends in a torn record
+    char path[24];
+    segmentPath(last, path, sizeof(path));
+    File file = LittleFS.open(path, FILE_READ);
+    uint32_t size = file ? file.size() : 0;
+    if (file) file.close();
+
+    if (size % RECORD_SIZE != 0 || size + SESSION_RECORDER_PAGE_SIZE > SESSION_RECORDER_SEGMENT_SIZE) {
+        writeSegment = last + 1;
+        writeSegmentSize = 0;
+    } else {
+        writeSegment = last;
+        writeSegmentSize = size;
+    }
+}
+
+void SessionRecorder::loadCursor() {
+    File file = LittleFS.open(CURSOR_PATH, FILE_READ);
+    if (!file) return;
+
+    RecorderCursor cursor;
+    size_t bytes = file.read((uint8_t*)&cursor, sizeof(cursor));
+    file.close();
+
+    // Only meaningful if it still points into the oldest segment
+    if (bytes != sizeof(cursor) || cursor.magic != CURSOR_MAGIC || cursor.segment != readSegment) return;
+
+    uint32_t records = segmentRecords(readSegment);
+    uint32_t consumed = min(cursor.offset / (uint32_t)RECORD_SIZE, records);
+
+    readOffset = consumed * RECORD_SIZE;
+    backlogRecords = backlogRecords > consumed ? backlogRecords - consumed : 0;
+}
+
+void SessionRecorder::saveCursor() {
+    recordsSinceCursorSave = 0;
+
+    File file = LittleFS.open(CURSOR_PATH, FILE_WRITE);
+    if (!file) return;
+
+    RecorderCursor cursor = { CURSOR_MAGIC, readSegment, readOffset };
+    file.write((const uint8_t*)&cursor, sizeof(cursor));
+    file.close();
+}
+
+uint32_t SessionRecorder::segmentRecords(uint32_t segment) {
+    char path[24];
+    segmentPath(segment, path, sizeof(path));
+
+    File file = LittleFS.open(path, FILE_READ);
+    if (!file) return 0;
+
+    uint32_t records = file.size() / RECORD_SIZE;
+    file.close();
+    return records;
+}
+
+void SessionRecorder::segmentPath(uint32_t segment, char* path, size_t size) {
+    snprintf(path, size, "/seg_%08lu.log", (unsigned long)segment);
+}
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+bool SessionRecorder::lock() {
+    return mutex && xSemaphoreTake(mutex, pdMS_TO_TICKS(LOCK_TIMEOUT)) == pdTRUE;
+}
+
+void SessionRecorder::unlock() {
+    xSemaphoreGive(mutex);
+}
+
+uint8_t SessionRecorder::checksum(const RecordedEvent& record) {
+    const uint8_t* bytes = (const uint8_t*)&record;
+    uint8_t sum = 0;
+
+    for (size_t i = 0; i < sizeof(record); i++) {
+        sum += bytes[i];
+    }
+
+    return sum - record.checksum;
+}
+
+bool SessionRecorder::isValid(const RecordedEvent& record) {
+    return record.magic == RECORDED_EVENT_MAGIC &&
+           record.type >= (uint8_t)RecordedEventType::SESSION_START &&
+           record.type <= (uint8_t)RecordedEventType::HEART_RATE &&
+           record.checksum == checksum(record);
+}
+
+void SessionRecorder::copyPadded(char* destination, size_t size, const String& source) {
+    memset(destination, 0, size);
+    strncpy(destination, source.c_str(), size);
+}
+
+bool SessionRecorder::hasBacklog() {
+    return available && (backlogRecords > 0 || stagedCount > 0);
+}
+
+bool SessionRecorder::needsService(MQTTManager& mqtt) {
+    return available && (pageFill > 0 || stagedCount > 0 || (backlogRecords > 0 && mqtt.isConnected()));
+}
+
+uint32_t SessionRecorder::getBacklogRecords() {
+    return backlogRecords;
+}
+
+uint32_t SessionRecorder::getRecordedCount() {
+    return recordedCount;
+}
+
+uint32_t SessionRecorder::getReplayedCount() {
+    return replayedCount;
+}
+
+uint32_t SessionRecorder::getDroppedCount() {
+    return droppedCount + stagingDroppedCount;
+}
+
+uint8_t SessionRecorder::sessionTypeCode(const String& sessionType) {
+    if (sessionType == "sequential") return 1;
+    if (sessionType == "simultaneous") return 2;
+    if (sessionType == "mixed") return 3;
+    if (sessionType == "test") return 4;
+    return 0;
+}
+
+const char* SessionRecorder::sessionTypeName(uint8_t code) {
+    switch (code) {
+        case 1: return "sequential";
+        case 2: return "simultaneous";
+        case 3: return "mixed";
+        case 4: return "test";
+        default: return "unknown";
+    }
+}
+
+const char* SessionRecorder::movementTypeName(uint8_t code) {
+    switch (code) {
+        case TELEMETRY_MOVEMENT_SEQUENTIAL: return "sequential";
+        case TELEMETRY_MOVEMENT_SIMULTANEOUS: return "simultaneous";
+        case TELEMETRY_MOVEMENT_HOME: return "home";
+        case TELEMETRY_MOVEMENT_PROFILE: return "profile";
+        case TELEMETRY_MOVEMENT_EXERCISE: return "exercise";
+        default: return "unknown";
+    }
+}
+
+const char* SessionRecorder::qualityName(uint8_t code) {
+    switch (code) {
+        case TELEMETRY_QUALITY_GOOD: return "good";
+        case TELEMETRY_QUALITY_FAIR: return "fair";
+        case TELEMETRY_QUALITY_POOR: return "poor";
+        case TELEMETRY_QUALITY_NO_SIGNAL: return "no_signal";
+        default: return "unknown";
+    }
+}
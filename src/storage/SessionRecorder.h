@@ -0,0 +1,211 @@
+#ifndef SESSION_RECORDER_H
+#define SESSION_RECORDER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "../config/Config.h"
+
+class MQTTManager;
+
+// =============================================================================
+// RECORDED EVENT LAYOUT
+// =============================================================================
+
+/**
+ * Fixed-size record as stored on flash. Four records fill one 256 byte flash
+ * page, and a record that was only partly written when power was lost fails
+ * its checksum and is skipped on replay. All fields are little-endian.
+ */
+
+const uint8_t RECORDED_EVENT_MAGIC = 0xA6;  // 0xA5 records had a 16 byte session ID
+
+enum class RecordedEventType : uint8_t {
+    SESSION_START = 1,
+    SESSION_END = 2,
+    MOVEMENT = 3,
+    HEART_RATE = 4
+};
+
+const uint8_t RECORD_FLAG_BLE_CONNECTED = 0x01;   // SESSION_START
+const uint8_t RECORD_FLAG_AUTO_STARTED = 0x02;    // SESSION_START
+const uint8_t RECORD_FLAG_SUCCESSFUL = 0x01;      // MOVEMENT
+const uint8_t RECORD_FLAG_FINGER_DETECTED = 0x01; // HEART_RATE
+
+struct __attribute__((packed)) RecordedSessionStart {
+    uint8_t sessionType;     // SessionRecorder::sessionTypeCode()
+};
+
+struct __attribute__((packed)) RecordedSessionEnd {
+    uint32_t durationMs;
+    uint16_t totalMovements;
+    uint16_t successfulMovements;
+    uint16_t cycles;
+    uint8_t sessionType;
+    char endReason[18];      // Zero padded
+};
+
+struct __attribute__((packed)) RecordedMovement {
+    uint32_t startTime;      // millis() on the recording boot
+    uint32_t durationMs;
+    float smoothness;
+    uint8_t servoIndex;
+    uint8_t startAngle;
+    uint8_t targetAngle;
+    uint8_t actualAngle;
+    uint8_t movementType;    // TelemetryMovementCode
+};
+
+struct __attribute__((packed)) RecordedHeartRate {
+    float heartRate;
+    float spO2;
+    uint8_t quality;         // TelemetryQualityCode
+};
+
+struct __attribute__((packed)) RecordedEvent {
+    uint8_t magic;           // RECORDED_EVENT_MAGIC
+    uint8_t type;            // RecordedEventType
+    uint8_t checksum;        // Sum of every other byte
+    uint8_t flags;           // RECORD_FLAG_*
+    uint32_t timestamp;      // Unix seconds when recorded
+    uint16_t timestampMs;    // Millisecond part of the timestamp
+    uint16_t reserved;
+    char sessionId[ANALYTICS_SESSION_ID_SIZE];  // Zero padded, empty outside sessions
+
+    union {
+        RecordedSessionStart sessionStart;
+        RecordedSessionEnd sessionEnd;
+        RecordedMovement movement;
+        RecordedHeartRate heartRate;
+        uint8_t raw[32];
+    } data;
+};
+
+static_assert(sizeof(RecordedEvent) == 64, "Recorded event layout changed");
+
+// =============================================================================
+// SESSION RECORDER
+// =============================================================================
+
+/**
+ * Flash backlog for session telemetry that could not be published.
+ *
+ * Records go into a page buffer in RAM and are appended to the newest
+ * segment file one flash page at a time. Segments form a ring on the
+ * "recorder" LittleFS partition. When the ring is full the oldest segment is
+ * dropped. Once MQTT is connected, update() streams the backlog in order
+ * with the original timestamps, a few records per interval and only while
+ * the publish queue has room. Fully replayed segments are deleted. The
+ * replay position is saved periodically, so a reboot re-sends at most a
+ * few records. Thread-safe.
+ */
+class SessionRecorder {
+public:
+    SessionRecorder();
+
+    // Initialization and lifecycle
+    bool initialize();
+    void shutdown();
+    bool isAvailable();
+
+    // Recording
+    bool recordSessionStart(const String& sessionId, const String& sessionType, bool bleConnected, bool autoStarted);
+    bool recordSessionEnd(const String& sessionId, const String& sessionType, const String& endReason,
+                          unsigned long duration, int totalMovements, int successfulMovements, int cycles);
+    bool recordMovement(int servoIndex, unsigned long startTime, unsigned long duration,
+                        bool successful, int startAngle, int targetAngle, int actualAngle,
+                        float smoothness, const String& movementType, const String& sessionId);
+    bool recordHeartRate(float heartRate, float spO2, const String& quality,
+                         bool fingerDetected, const String& sessionId);
+
+    // Periodic work: writes out an aged page and replays while MQTT is up
+    void update(MQTTManager& mqtt);
+    void flush();
+
+    // New data should be recorded (not published) while this is true, so it
+    // reaches the server after the backlog
+    bool hasBacklog();
+
+    // True while update() has work to do - an unwritten page or a backlog
+    bool needsService(MQTTManager& mqtt);
+
+    // Statistics
+    uint32_t getBacklogRecords();
+    uint32_t getRecordedCount();
+    uint32_t getReplayedCount();
+    uint32_t getDroppedCount();
+
+    // Decoding helpers for the string fields used by the JSON API
+    static uint8_t sessionTypeCode(const String& sessionType);
+    static const char* sessionTypeName(uint8_t code);
+    static const char* movementTypeName(uint8_t code);
+    static const char* qualityName(uint8_t code);
+    static bool isValid(const RecordedEvent& record);
+
+private:
+    SemaphoreHandle_t mutex;
+    bool available;
+
+    // Write side: page buffer and the segment it goes to
+    uint8_t pageBuffer[SESSION_RECORDER_PAGE_SIZE];
+    size_t pageFill;
+    unsigned long pageStartTime;
+    uint32_t writeSegment;
+    uint32_t writeSegmentSize;
+
+    // Read side: replay position
+    uint32_t readSegment;
+    uint32_t readOffset;
+    uint32_t recordsSinceCursorSave;
+    unsigned long lastReplayTime;
+
+    // Records that arrived while the mutex was held elsewhere (FIFO, under stagingLock)
+    RecordedEvent stagedRecords[SESSION_RECORDER_STAGED_RECORDS];
+    uint8_t stagedStart;
+    uint8_t stagedCount;
+    uint32_t stagingDroppedCount;
+    portMUX_TYPE stagingLock;
+
+    // Statistics
+    uint32_t backlogRecords;
+    uint32_t recordedCount;
+    uint32_t replayedCount;
+    uint32_t droppedCount;
+
+    // Recording helpers
+    bool lock();
+    void unlock();
+    void startRecord(RecordedEvent& record, RecordedEventType type, const String& sessionId);
+    bool appendRecord(RecordedEvent& record);
+    bool storeRecord(const RecordedEvent& record);
+    bool stageRecord(const RecordedEvent& record);
+    void storeStagedRecords();
+    bool flushPage();
+    void enforceCapacity();
+
+    // Replay helpers
+    void replay(MQTTManager& mqtt, unsigned long now);
+    size_t readRecords(RecordedEvent* records, size_t maxRecords);
+    void advanceRead();
+    void finishReadSegment();
+
+    // Segment bookkeeping
+    void scanSegments();
+    void loadCursor();
+    void saveCursor();
+    uint32_t segmentRecords(uint32_t segment);
+
+    static void segmentPath(uint32_t segment, char* path, size_t size);
+    static uint8_t checksum(const RecordedEvent& record);
+    static void copyPadded(char* destination, size_t size, const String& source);
+
+    // Configuration
+    static const char* PARTITION_LABEL;
+    static const char* CURSOR_PATH;
+    static const size_t RECORD_SIZE = sizeof(RecordedEvent);
+    static const uint32_t CURSOR_MAGIC = 0x52435552;           // "RCUR"
+    static const uint32_t CURSOR_SAVE_INTERVAL = 32;           // Replayed records between cursor saves
+    static const unsigned long LOCK_TIMEOUT = 20;              // ms
+};
+
+#endif
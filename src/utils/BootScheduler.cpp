@@ -0,0 +1,211 @@
+#include "BootScheduler.h"
+#include <esp_timer.h>
+#include "Logger.h"
+#include "../hardware/ResourceProfiler.h"
+
+BootScheduler::BootScheduler()
+    : stageCount(0), allStages(0), finished(nullptr), failedMask(0), workersRunning(0),
+      startUs(0), endUs(0), completionCallback(nullptr), completionContext(nullptr) {
+}
+
+// =============================================================================
+// SETUP
+// =============================================================================
+
+int BootScheduler::addStage(const char* name, BootStageFunction function, void* context,
+                            BootStageMask dependencies, BaseType_t core) {
+    if (finished || stageCount >= BOOT_MAX_STAGES || !function) {
+        Logger::warningf("Boot stage %s not added", name ? name : "?");
+        return -1;
+    }
+
+    // Dependencies on later stages could deadlock a worker
+    if (dependencies & ~allStages) {
+        Logger::warningf("Boot stage %s depends on a stage added after it", name);
+        return -1;
+    }
+
+    int index = stageCount++;
+    Stage& stage = stages[index];
+    stage.function = function;
+    stage.context = context;
+    stage.dependencies = dependencies;
+    stage.timing.name = name;
+    stage.timing.core = (int8_t)(core < portNUM_PROCESSORS ? core : CORE_APPLICATION);
+    stage.timing.result = BootStageResult::PENDING;
+    stage.timing.startUs = 0;
+    stage.timing.durationUs = 0;
+    allStages |= maskOf(index);
+
+    return index;
+}
+
+void BootScheduler::setCompletionCallback(void (*callback)(void* context), void* context) {
+    completionCallback = callback;
+    completionContext = context;
+}
+
+// =============================================================================
+// RUN
+// =============================================================================
+
+bool BootScheduler::start() {
+    if (finished) return false;
+
+    finished = xEventGroupCreateStatic(&finishedStorage);
+    if (!finished) return false;
+
+    startUs = (uint32_t)esp_timer_get_time();
+
+    // Count every worker before any can finish and see the count reach zero
+    uint8_t needed = 0;
+    bool coreUsed[portNUM_PROCESSORS] = {};
+    for (int i = 0; i < stageCount; i++) {
+        coreUsed[stages[i].timing.core] = true;
+    }
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (coreUsed[core]) needed++;
+    }
+    workersRunning.store(needed);
+
+    bool runInline[portNUM_PROCESSORS] = {};
+    bool allStarted = true;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (!coreUsed[core]) continue;
+
+        workers[core] = {this, (BaseType_t)core};
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "Boot%d", core);
+
+        if (xTaskCreatePinnedToCore(workerTask, name, ResourceProfiler::getStackSize(ProfiledTask::BOOT_WORKER),
+                                    &workers[core], PRIORITY_BOOT_WORKER, nullptr, core) != pdPASS) {
+            Logger::warningf("Boot worker for core %d not created - running its stages inline", core);
+            runInline[core] = true;
+            allStarted = false;
+        }
+    }
+
+    // Only once every other worker exists, or a cross-core dependency would never finish
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (runInline[core]) runStagesFor(core);
+    }
+
+    return allStarted;
+}
+
+void BootScheduler::workerTask(void* parameter) {
+    Worker* worker = static_cast<Worker*>(parameter);
+    worker->scheduler->runStagesFor(worker->core);
+
+    // Gone before SystemMonitor's next scan - its stack use is recorded here
+    ResourceProfiler::recordTaskHeadroom(ProfiledTask::BOOT_WORKER, uxTaskGetStackHighWaterMark(nullptr));
+    vTaskDelete(nullptr);
+}
+
+void BootScheduler::runStagesFor(BaseType_t core) {
+    for (int i = 0; i < stageCount; i++) {
+        if (stages[i].timing.core == core) {
+            runStage(i);
+        }
+    }
+
+    // Last worker out reports the end of the boot
+    if (workersRunning.fetch_sub(1) == 1) {
+        endUs = (uint32_t)esp_timer_get_time();
+        if (completionCallback) {
+            completionCallback(completionContext);
+        }
+    }
+}
+
+void BootScheduler::runStage(int index) {
+    Stage& stage = stages[index];
+
+    if (stage.dependencies) {
+        xEventGroupWaitBits(finished, stage.dependencies, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+
+    stage.timing.startUs = (uint32_t)esp_timer_get_time();
+
+    if (failedMask.load() & stage.dependencies) {
+        stage.timing.result = BootStageResult::SKIPPED;
+        Logger::warningf("Boot stage %s skipped - a dependency failed", stage.timing.name);
+    } else {
+        bool success = stage.function(stage.context);
+        stage.timing.result = success ? BootStageResult::SUCCEEDED : BootStageResult::FAILED;
+        if (!success) {
+            Logger::errorf("Boot stage %s failed", stage.timing.name);
+        }
+    }
+
+    stage.timing.durationUs = (uint32_t)esp_timer_get_time() - stage.timing.startUs;
+
+    // Result and failure bit are in place before waiters see the stage finish
+    if (stage.timing.result != BootStageResult::SUCCEEDED) {
+        failedMask.fetch_or(maskOf(index));
+    }
+    xEventGroupSetBits(finished, maskOf(index));
+}
+
+bool BootScheduler::waitFor(BootStageMask stages, TickType_t timeout) {
+    if (!finished) return false;
+
+    stages &= allStages;
+    EventBits_t bits = xEventGroupWaitBits(finished, stages, pdFALSE, pdTRUE, timeout);
+    return (bits & stages) == stages;
+}
+
+bool BootScheduler::succeeded(BootStageMask stages) {
+    if (!finished) return false;
+
+    stages &= allStages;
+    EventBits_t bits = xEventGroupGetBits(finished);
+    return (bits & stages) == stages && (failedMask.load() & stages) == 0;
+}
+
+bool BootScheduler::isComplete() {
+    return finished && allStages != 0 && workersRunning.load() == 0;
+}
+
+// =============================================================================
+// TIMINGS
+// =============================================================================
+
+uint8_t BootScheduler::getStageCount() {
+    return stageCount;
+}
+
+const BootStageTiming& BootScheduler::getTiming(int stage) {
+    if (stage < 0 || stage >= stageCount) stage = 0;
+    return stages[stage].timing;
+}
+
+uint32_t BootScheduler::getTotalUs() {
+    return isComplete() ? endUs - startUs : (uint32_t)esp_timer_get_time() - startUs;
+}
+
+uint32_t BootScheduler::getFinishUs() {
+    return isComplete() ? endUs : 0;
+}
+
+void BootScheduler::logTimings() {
+    Logger::infof("Boot stages (%u ms total):", (unsigned)(getTotalUs() / 1000));
+
+    for (int i = 0; i < stageCount; i++) {
+        const BootStageTiming& timing = stages[i].timing;
+        Logger::infof("  %-12s core %d  start %5u ms  took %5u ms  %s",
+                      timing.name, timing.core,
+                      (unsigned)(timing.startUs / 1000), (unsigned)(timing.durationUs / 1000),
+                      getResultName(timing.result));
+    }
+}
+
+const char* BootScheduler::getResultName(BootStageResult result) {
+    switch (result) {
+        case BootStageResult::PENDING: return "pending";
+        case BootStageResult::SUCCEEDED: return "ok";
+        case BootStageResult::FAILED: return "failed";
+        case BootStageResult::SKIPPED: return "skipped";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef BOOT_SCHEDULER_H
+#define BOOT_SCHEDULER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include "../config/Config.h"
+
+// =============================================================================
+// BOOT STAGE RECORD
+// =============================================================================
+
+enum class BootStageResult : uint8_t {
+    PENDING,
+    SUCCEEDED,
+    FAILED,
+    SKIPPED   // A dependency failed, so the stage never ran
+};
+
+struct BootStageTiming {
+    const char* name;
+    int8_t core;
+    BootStageResult result;
+    uint32_t startUs;     // esp_timer time, i.e. since the application started
+    uint32_t durationUs;
+};
+
+typedef bool (*BootStageFunction)(void* context);
+typedef uint16_t BootStageMask;
+
+// =============================================================================
+// BOOT SCHEDULER
+// =============================================================================
+
+/**
+ * Dependency-aware subsystem bring-up on both cores.
+ *
+ * Stages are added in dependency order (a stage may only depend on stages
+ * added before it) and pinned to a core. start() spawns one short-lived
+ * worker per core that runs that core's stages in the order they were
+ * added, each one as soon as its dependencies have finished. Stages on
+ * different cores overlap, so the blocking waits inside driver bring-up
+ * (radio start, bus scans, sensor resets) hide behind one another.
+ *
+ * A stage whose dependency failed or was skipped is skipped. Finishing in
+ * any way sets the stage's bit in an event group, so callers can wait for
+ * exactly the stages they need and carry on while the rest complete.
+ */
+class BootScheduler {
+public:
+    BootScheduler();
+
+    // Setup - before start(); returns the stage index, -1 if it can't be added
+    int addStage(const char* name, BootStageFunction function, void* context,
+                 BootStageMask dependencies, BaseType_t core);
+    void setCompletionCallback(void (*callback)(void* context), void* context);
+
+    // Run
+    bool start();
+    bool waitFor(BootStageMask stages, TickType_t timeout);  // True once all have finished
+    bool succeeded(BootStageMask stages);
+    bool isComplete();
+
+    // Timings
+    uint8_t getStageCount();
+    const BootStageTiming& getTiming(int stage);
+    uint32_t getTotalUs();   // Start of the first stage to end of the last
+    uint32_t getFinishUs();  // esp_timer time the last stage ended, 0 until complete
+    void logTimings();
+
+    static BootStageMask maskOf(int stage) { return stage < 0 ? 0 : (BootStageMask)(1u << stage); }
+    static const char* getResultName(BootStageResult result);
+
+private:
+    struct Stage {
+        BootStageFunction function;
+        void* context;
+        BootStageMask dependencies;
+        BootStageTiming timing;
+    };
+
+    struct Worker {
+        BootScheduler* scheduler;
+        BaseType_t core;
+    };
+
+    Stage stages[BOOT_MAX_STAGES];
+    Worker workers[portNUM_PROCESSORS];
+    uint8_t stageCount;
+    BootStageMask allStages;
+    StaticEventGroup_t finishedStorage;
+    EventGroupHandle_t finished;
+    std::atomic<BootStageMask> failedMask;
+    std::atomic<uint8_t> workersRunning;
+    uint32_t startUs;
+    uint32_t endUs;
+    void (*completionCallback)(void* context);
+    void* completionContext;
+
+    static void workerTask(void* parameter);
+    void runStagesFor(BaseType_t core);
+    void runStage(int index);
+};
+
+#endif
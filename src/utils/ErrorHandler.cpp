@@ -83,6 +83,7 @@ bool ErrorHandler::attemptRecovery(ErrorCode code) {
 
 void ErrorHandler::resetSystem() {
     Logger::error("System reset requested due to critical errors");
+    Logger::flush();
     delay(1000);  // Allow log message to be sent
     ESP.restart();
 }
@@ -137,6 +138,7 @@ const char* ErrorHandler::getErrorCodeString(ErrorCode code) {
         case ErrorCode::INVALID_COMMAND: return "INVALID_COMMAND";
         case ErrorCode::SYSTEM_OVERLOAD: return "SYSTEM_OVERLOAD";
         case ErrorCode::HARDWARE_FAULT: return "HARDWARE_FAULT";
+        case ErrorCode::SAFETY_LIMIT_EXCEEDED: return "SAFETY_LIMIT_EXCEEDED";
         default: return "UNKNOWN";
     }
 }
@@ -176,7 +178,7 @@ void ErrorHandler::performRecoveryAction(ErrorCode code) {
             break;
 
         default:
-            Logger::debugf("No specific recovery action for error code: %d", (int)code);
+            LOG_DEBUGF("No specific recovery action for error code: %d", (int)code);
             break;
     }
 }
@@ -13,7 +13,8 @@ enum class ErrorCode {
     NTP_SYNC_FAILED = 6,
     INVALID_COMMAND = 7,
     SYSTEM_OVERLOAD = 8,
-    HARDWARE_FAULT = 9
+    HARDWARE_FAULT = 9,
+    SAFETY_LIMIT_EXCEEDED = 10
 };
 
 enum class ErrorSeverity {
@@ -1,18 +1,30 @@
 #include "Logger.h"
+#include "../hardware/ResourceProfiler.h"
 #include <stdarg.h>
 
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE must be a power of two");
+static_assert(LOG_RECORD_TEXT_SIZE <= 255, "Log record length is stored in a byte");
+
 // Static member initialization
 LogLevel Logger::currentLevel = LogLevel::INFO;
 bool Logger::initialized = false;
+bool Logger::asyncEnabled = LOG_ASYNC_ENABLED;
+
+Logger::LogRecord Logger::ring[LOG_RING_SIZE];
+std::atomic<uint32_t> Logger::enqueuePosition(0);
+uint32_t Logger::dequeuePosition = 0;
+std::atomic<uint32_t> Logger::droppedCount(0);
+uint32_t Logger::reportedDropCount = 0;
+SemaphoreHandle_t Logger::drainMutex = nullptr;
+TaskHandle_t Logger::drainTaskHandle = nullptr;
 
 void Logger::initialize(LogLevel level) {
     if (!initialized) {
+        // No wait for a host - setup() decides how long boot may hold for one
         Serial.begin(115200);
-        while (!Serial) {
-            delay(10);
-        }
         currentLevel = level;
         initialized = true;
+        startDrainTask();
         
         info("Logger initialized");
         logSystemInfo();
@@ -72,6 +84,25 @@ LogLevel Logger::getLevel() {
     return currentLevel;
 }
 
+void Logger::setAsync(bool enabled) {
+    if (!enabled) {
+        flush();  // Keep ordering - queued messages go out before direct ones
+    }
+    asyncEnabled = enabled;
+}
+
+bool Logger::isAsync() {
+    return isDeferred();
+}
+
+void Logger::flush() {
+    drain();
+}
+
+uint32_t Logger::getDroppedCount() {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
 void Logger::logSystemInfo() {
     infof("ESP32 Chip Model: %s", ESP.getChipModel());
     infof("Chip Revision: %d", ESP.getChipRevision());
@@ -87,23 +118,38 @@ void Logger::logMemoryUsage() {
 }
 
 void Logger::log(LogLevel level, const String& message) {
-    if (level >= currentLevel && initialized) {
-        String timestamp = getTimestamp();
-        String levelStr = getLevelString(level);
-        
-        Serial.printf("[%s] %s: %s\n", 
-                     timestamp.c_str(), 
-                     levelStr, 
-                     message.c_str());
+    if (level < currentLevel || !initialized) return;
+
+    if (!isDeferred()) {
+        write((uint8_t)level, millis(), message.c_str(), message.length());
+        return;
     }
+
+    LogRecord* record = claimRecord(level);
+    if (!record) return;
+
+    size_t length = min((size_t)message.length(), sizeof(record->text) - 1);
+    memcpy(record->text, message.c_str(), length);
+    commitRecord(record, length);
 }
 
 void Logger::logf(LogLevel level, const char* format, va_list args) {
-    if (level >= currentLevel && initialized) {
+    if (level < currentLevel || !initialized) return;
+
+    if (!isDeferred()) {
         char buffer[256];
-        vsnprintf(buffer, sizeof(buffer), format, args);
-        log(level, String(buffer));
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        if (length < 0) return;
+        write((uint8_t)level, millis(), buffer, min((size_t)length, sizeof(buffer) - 1));
+        return;
     }
+
+    // Format straight into the ring slot - no intermediate buffer or String
+    LogRecord* record = claimRecord(level);
+    if (!record) return;
+
+    int length = vsnprintf(record->text, sizeof(record->text), format, args);
+    commitRecord(record, length);
 }
 
 const char* Logger::getLevelString(LogLevel level) {
@@ -116,8 +162,7 @@ const char* Logger::getLevelString(LogLevel level) {
     }
 }
 
-String Logger::getTimestamp() {
-    unsigned long ms = millis();
+void Logger::formatTimestamp(unsigned long ms, char* buffer, size_t size) {
     unsigned long seconds = ms / 1000;
     unsigned long minutes = seconds / 60;
     unsigned long hours = minutes / 60;
@@ -127,9 +172,119 @@ String Logger::getTimestamp() {
     minutes %= 60;
     hours %= 24;
     
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "%02lu:%02lu:%02lu.%03lu", 
+    snprintf(buffer, size, "%02lu:%02lu:%02lu.%03lu", 
              hours, minutes, seconds, ms);
-    
-    return String(buffer);
+}
+
+// =============================================================================
+// DEFERRED OUTPUT
+// =============================================================================
+
+bool Logger::isDeferred() {
+    return asyncEnabled && drainTaskHandle != nullptr;
+}
+
+Logger::LogRecord* Logger::claimRecord(LogLevel level) {
+    // Bounded multi-producer ring: a producer owns slot (position & mask)
+    // once it wins the CAS on enqueuePosition for a slot whose turn it is
+    uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+    while (true) {
+        LogRecord* record = &ring[position & RING_MASK];
+        int32_t turn = (int32_t)(record->sequence.load(std::memory_order_acquire) - position);
+
+        if (turn == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                record->timestamp = millis();
+                record->level = (uint8_t)level;
+                return record;
+            }
+        } else if (turn < 0) {
+            // Slot still holds an unprinted message from the previous lap
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::commitRecord(LogRecord* record, int length) {
+    if (length < 0) length = 0;
+    record->length = min((size_t)length, sizeof(record->text) - 1);
+
+    // Hand the slot to the drain task
+    record->sequence.store(record->sequence.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_release);
+
+    if (drainTaskHandle) {
+        xTaskNotifyGive(drainTaskHandle);
+    }
+}
+
+void Logger::write(uint8_t level, unsigned long timestamp, const char* text, size_t length) {
+    char prefix[32];
+    char time[16];
+    formatTimestamp(timestamp, time, sizeof(time));
+    int prefixLength = snprintf(prefix, sizeof(prefix), "[%s] %s: ", time, getLevelString((LogLevel)level));
+
+    Serial.write((const uint8_t*)prefix, prefixLength);
+    Serial.write((const uint8_t*)text, length);
+    Serial.write('\n');
+}
+
+void Logger::startDrainTask() {
+    if (drainTaskHandle) return;
+
+    drainMutex = xSemaphoreCreateMutex();
+    if (!drainMutex) return;  // Stay synchronous
+
+    for (uint32_t i = 0; i < LOG_RING_SIZE; i++) {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    xTaskCreatePinnedToCore(
+        logDrainTask,
+        "LogDrain",
+        ResourceProfiler::getStackSize(ProfiledTask::LOG_DRAIN),
+        nullptr,
+        PRIORITY_LOG_DRAIN,
+        &drainTaskHandle,
+        CORE_PROTOCOL  // Keeps UART writes off the control core
+    );
+}
+
+void Logger::drain() {
+    if (!drainMutex || xSemaphoreTake(drainMutex, portMAX_DELAY) != pdTRUE) return;
+
+    while (true) {
+        LogRecord* record = &ring[dequeuePosition & RING_MASK];
+        if (record->sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            break;  // Empty, or the next producer is still formatting
+        }
+
+        write(record->level, record->timestamp, record->text, record->length);
+
+        // Slot is free for the producer one lap ahead
+        record->sequence.store(dequeuePosition + LOG_RING_SIZE, std::memory_order_release);
+        dequeuePosition++;
+    }
+
+    uint32_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != reportedDropCount) {
+        char message[48];
+        int length = snprintf(message, sizeof(message), "%lu log messages dropped (ring full)",
+                              (unsigned long)(dropped - reportedDropCount));
+        write((uint8_t)LogLevel::WARNING, millis(), message, length);
+        reportedDropCount = dropped;
+    }
+
+    xSemaphoreGive(drainMutex);
+}
+
+void Logger::logDrainTask(void* parameter) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_DRAIN_IDLE_TIMEOUT));
+        drain();
+    }
 }
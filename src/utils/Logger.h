@@ -2,6 +2,11 @@
 #define LOGGER_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include "../config/Config.h"
 
 enum class LogLevel {
     DEBUG = 0,
@@ -10,6 +15,16 @@ enum class LogLevel {
     ERROR = 3
 };
 
+/**
+ * Serial logger.
+ *
+ * In async mode (LOG_ASYNC_ENABLED) callers only format their message into
+ * a slot of a lock-free multi-producer ring and return; the low-priority
+ * log drain task adds the timestamp and writes it to Serial. Logging never
+ * allocates or waits for the UART. When the ring is full the message is
+ * dropped and counted, and the drain task reports the drop count. Output
+ * is synchronous before initialize() has started the drain task.
+ */
 class Logger {
 public:
     static void initialize(LogLevel level = LogLevel::INFO);
@@ -29,30 +44,83 @@ public:
     // Configuration
     static void setLevel(LogLevel level);
     static LogLevel getLevel();
+    static bool isEnabled(LogLevel level) { return initialized && level >= currentLevel; }
+    static void setAsync(bool enabled);
+    static bool isAsync();
+
+    // Writes out everything still queued (call before a restart)
+    static void flush();
+    static uint32_t getDroppedCount();
     
     // System info logging
     static void logSystemInfo();
     static void logMemoryUsage();
 
 private:
+    // One queued message. The sequence number says whose turn the slot is:
+    // position for the next producer, position + 1 once the text is ready.
+    struct LogRecord {
+        std::atomic<uint32_t> sequence;
+        uint32_t timestamp;
+        uint8_t level;
+        uint8_t length;
+        char text[LOG_RECORD_TEXT_SIZE];
+    };
+
     static LogLevel currentLevel;
     static bool initialized;
-    
+    static bool asyncEnabled;
+
+    // Deferred output
+    static LogRecord ring[LOG_RING_SIZE];
+    static std::atomic<uint32_t> enqueuePosition;
+    static uint32_t dequeuePosition;  // Guarded by drainMutex
+    static std::atomic<uint32_t> droppedCount;
+    static uint32_t reportedDropCount;
+    static SemaphoreHandle_t drainMutex;
+    static TaskHandle_t drainTaskHandle;
+
     static void log(LogLevel level, const String& message);
     static void logf(LogLevel level, const char* format, va_list args);
     static const char* getLevelString(LogLevel level);
-    static String getTimestamp();
+    static void formatTimestamp(unsigned long ms, char* buffer, size_t size);
+
+    static bool isDeferred();
+    static LogRecord* claimRecord(LogLevel level);
+    static void commitRecord(LogRecord* record, int length);
+    static void write(uint8_t level, unsigned long timestamp, const char* text, size_t length);
+    static void startDrainTask();
+    static void drain();
+    static void logDrainTask(void* parameter);
+
+    static const uint32_t RING_MASK = LOG_RING_SIZE - 1;
 };
 
-// Convenience macros
-#define LOG_DEBUG(msg) Logger::debug(msg)
-#define LOG_INFO(msg) Logger::info(msg)
-#define LOG_WARNING(msg) Logger::warning(msg)
-#define LOG_ERROR(msg) Logger::error(msg)
+// =============================================================================
+// LEVEL-FILTERED LOGGING MACROS
+// =============================================================================
+
+// Messages below LOG_COMPILE_LEVEL are compiled out entirely. Set it from
+// platformio.ini build_flags (0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR,
+// 4 = nothing); the default keeps every level.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+#endif
+
+// Arguments are only evaluated when the level is enabled at runtime too, so
+// String building and getter calls in a filtered statement cost nothing.
+// Compiled-out statements stay inside if (false) to keep them type-checked.
+#define LOG_AT_LEVEL(level, compiled, call) \
+    do { if ((compiled) && Logger::isEnabled(level)) { call; } } while (0)
+
+#define LOG_DEBUG(msg) LOG_AT_LEVEL(LogLevel::DEBUG, LOG_COMPILE_LEVEL <= 0, Logger::debug(msg))
+#define LOG_INFO(msg) LOG_AT_LEVEL(LogLevel::INFO, LOG_COMPILE_LEVEL <= 1, Logger::info(msg))
+#define LOG_WARNING(msg) LOG_AT_LEVEL(LogLevel::WARNING, LOG_COMPILE_LEVEL <= 2, Logger::warning(msg))
+#define LOG_ERROR(msg) LOG_AT_LEVEL(LogLevel::ERROR, LOG_COMPILE_LEVEL <= 3, Logger::error(msg))
 
-#define LOG_DEBUGF(fmt, ...) Logger::debugf(fmt, ##__VA_ARGS__)
-#define LOG_INFOF(fmt, ...) Logger::infof(fmt, ##__VA_ARGS__)
-#define LOG_WARNINGF(fmt, ...) Logger::warningf(fmt, ##__VA_ARGS__)
-#define LOG_ERRORF(fmt, ...) Logger::errorf(fmt, ##__VA_ARGS__)
+#define LOG_DEBUGF(fmt, ...) LOG_AT_LEVEL(LogLevel::DEBUG, LOG_COMPILE_LEVEL <= 0, Logger::debugf(fmt, ##__VA_ARGS__))
+#define LOG_INFOF(fmt, ...) LOG_AT_LEVEL(LogLevel::INFO, LOG_COMPILE_LEVEL <= 1, Logger::infof(fmt, ##__VA_ARGS__))
+#define LOG_WARNINGF(fmt, ...) LOG_AT_LEVEL(LogLevel::WARNING, LOG_COMPILE_LEVEL <= 2, Logger::warningf(fmt, ##__VA_ARGS__))
+#define LOG_ERRORF(fmt, ...) LOG_AT_LEVEL(LogLevel::ERROR, LOG_COMPILE_LEVEL <= 3, Logger::errorf(fmt, ##__VA_ARGS__))
 
 #endif
@@ -1,11 +1,12 @@
 #include "TimeManager.h"
 #include "Logger.h"
+#include <esp_sntp.h>
 
 // Static member initialization
 bool TimeManager::initialized = false;
-bool TimeManager::ntpSynced = false;
+volatile bool TimeManager::ntpSynced = false;
 unsigned long TimeManager::bootTime = 0;
-unsigned long TimeManager::lastSyncTime = 0;
+volatile unsigned long TimeManager::lastSyncTime = 0;
 
 const char* TimeManager::NTP_SERVER1 = "pool.ntp.org";
 const char* TimeManager::NTP_SERVER2 = "time.nist.gov";
@@ -31,9 +32,7 @@ void TimeManager::syncWithNTP() {
         return;
     }
     
-    Logger::info("Attempting NTP time synchronization...");
-    
-    configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER1, NTP_SERVER2);
+    startNTPSync();
     
     if (attemptNTPSync()) {
         ntpSynced = true;
@@ -45,6 +44,25 @@ void TimeManager::syncWithNTP() {
     }
 }
 
+void TimeManager::startNTPSync() {
+    if (!WiFi.isConnected()) {
+        Logger::warning("Cannot sync NTP - WiFi not connected");
+        return;
+    }
+    
+    Logger::info("Starting NTP time synchronization...");
+    
+    // SNTP runs in the lwIP task; the callback marks the sync once the first reply sets the clock
+    sntp_set_time_sync_notification_cb(onTimeSynced);
+    configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER1, NTP_SERVER2);
+}
+
+void TimeManager::onTimeSynced(struct timeval* tv) {
+    // lwIP task context - no logging here
+    ntpSynced = true;
+    lastSyncTime = millis();
+}
+
 unsigned long TimeManager::getCurrentTimestamp() {
     time_t now = time(nullptr);
     
@@ -115,7 +133,7 @@ bool TimeManager::attemptNTPSync() {
         vTaskDelay(pdMS_TO_TICKS(delayMs));  // FreeRTOS delay
         
         if (attempt % 5 == 0) {
-            Logger::debugf("NTP sync attempt %d/%d", attempt + 1, maxAttempts);
+            LOG_DEBUGF("NTP sync attempt %d/%d", attempt + 1, maxAttempts);
         }
     }
     
@@ -9,7 +9,8 @@ class TimeManager {
 public:
     // Initialization
     static void initialize();
-    static void syncWithNTP();
+    static void syncWithNTP();   // Blocks until the time is set or the attempts run out
+    static void startNTPSync();  // Returns at once - SNTP completes in the background
     
     // Time queries
     static unsigned long getCurrentTimestamp();
@@ -23,9 +24,9 @@ public:
     
 private:
     static bool initialized;
-    static bool ntpSynced;
+    static volatile bool ntpSynced;        // Also written by the SNTP callback
     static unsigned long bootTime;
-    static unsigned long lastSyncTime;
+    static volatile unsigned long lastSyncTime;
     
     static const char* NTP_SERVER1;
     static const char* NTP_SERVER2;
@@ -33,6 +34,7 @@ private:
     static const int DAYLIGHT_OFFSET_SEC;
     
     static bool attemptNTPSync();
+    static void onTimeSynced(struct timeval* tv);
     static void logTimeStatus();
 };
 